@@ -23,6 +23,8 @@ ListBox::ListBox(Window* pWindow, Layout* pLayout) :
     m_pCompareFunc(nullptr),
     m_pCompareContext(nullptr)
 {
+    //列表的子项通常包含大量相似的小图标，默认批量绘制
+    SetAtlasBatchPaint(true);
 }
 
 DString ListBox::GetType() const { return _T("ListBox"); }
@@ -1,6 +1,7 @@
 #include "ScrollBox.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Render/AutoClip.h"
+#include "duilib/Render/AutoAtlasBatch.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Core/Keyboard.h"
 #include "duilib/Core/GlobalManager.h"
@@ -13,15 +14,17 @@ ScrollBox::ScrollBox(Window* pWindow, Layout* pLayout) :
     Box(pWindow, pLayout),
     m_pVScrollBar(),
     m_pHScrollBar(),
+    m_nVScrollUnitPixels(0),
+    m_nHScrollUnitPixels(0),
     m_bScrollProcess(false),
+    m_bHoldEnd(false),
     m_bScrollBarFloat(true),
     m_bVScrollBarAtLeft(false),
-    m_bHoldEnd(false),
+    m_bEnableScrollBlit(true),
+    m_bAtlasBatchPaint(false),
     m_rcScrollBarPadding(),
     m_pScrollAnimation(nullptr),
-    m_pRenderOffsetYAnimation(nullptr),
-    m_nVScrollUnitPixels(0),
-    m_nHScrollUnitPixels(0)
+    m_pRenderOffsetYAnimation(nullptr)
 {
     SetVerScrollUnitPixels(30, true);
     SetHorScrollUnitPixels(30, true);
@@ -83,6 +86,12 @@ void ScrollBox::SetAttribute(const DString& pstrName, const DString& pstrValue)
     else if ((pstrName == _T("hold_end")) || (pstrName == _T("holdend"))) {
         SetHoldEnd(pstrValue == _T("true"));
     }
+    else if (pstrName == _T("scroll_blit")) {
+        SetEnableScrollBlit(pstrValue == _T("true"));
+    }
+    else if (pstrName == _T("atlas_batch_paint")) {
+        SetAtlasBatchPaint(pstrValue == _T("true"));
+    }
     else {
         Box::SetAttribute(pstrName, pstrValue);
     }
@@ -364,28 +373,32 @@ void ScrollBox::PaintChild(IRender* pRender, const UiRect& rcPaint)
     }
 
     std::vector<Control*> delayItems;
-    for (Control* pControl : m_items) {
-        if (pControl == nullptr) {
-            continue;
-        }
-        if (!pControl->IsVisible()) {
-            continue;
-        }
-        if (pControl->GetPaintOrder() != 0) {
-            //设置了绘制顺序， 放入延迟绘制列表
-            delayItems.push_back(pControl);
-            continue;
-        }
-        UiSize scrollPos = GetScrollOffset();
-        UiRect rcNewPaint = GetPosWithoutPadding();
-        AutoClip alphaClip(pRender, rcNewPaint, IsClip());
-        rcNewPaint.Offset(scrollPos.cx, scrollPos.cy);
-        rcNewPaint.Offset(GetRenderOffset().x, GetRenderOffset().y);
+    {
+        //子项中的小图片通过图集批量绘制（在本作用域结束时绘制）
+        AutoAtlasBatch atlasBatch(pRender, IsAtlasBatchPaint());
+        for (Control* pControl : m_items) {
+            if (pControl == nullptr) {
+                continue;
+            }
+            if (!pControl->IsVisible()) {
+                continue;
+            }
+            if (pControl->GetPaintOrder() != 0) {
+                //设置了绘制顺序， 放入延迟绘制列表
+                delayItems.push_back(pControl);
+                continue;
+            }
+            UiSize scrollPos = GetScrollOffset();
+            UiRect rcNewPaint = GetPosWithoutPadding();
+            AutoClip alphaClip(pRender, rcNewPaint, IsClip());
+            rcNewPaint.Offset(scrollPos.cx, scrollPos.cy);
+            rcNewPaint.Offset(GetRenderOffset().x, GetRenderOffset().y);
 
-        UiPoint ptOffset(scrollPos.cx, scrollPos.cy);
-        UiPoint ptOldOrg = pRender->OffsetWindowOrg(ptOffset);
-        pControl->AlphaPaint(pRender, rcNewPaint);
-        pRender->SetWindowOrg(ptOldOrg);
+            UiPoint ptOffset(scrollPos.cx, scrollPos.cy);
+            UiPoint ptOldOrg = pRender->OffsetWindowOrg(ptOffset);
+            pControl->AlphaPaint(pRender, rcNewPaint);
+            pRender->SetWindowOrg(ptOldOrg);
+        }
     }
 
     if (!delayItems.empty()) {
@@ -565,12 +578,17 @@ void ScrollBox::SetScrollPos(UiSize64 szPos)
     if (cx == 0 && cy == 0) {
         return;
     }
+    if (GetWindow() != nullptr) {
+        GetWindow()->InvalidateHitTestCache();
+    }
     UiSize newScrollOffset = GetScrollOffset();
     if (newScrollOffset != oldScrollOffset) {
         OnScrollOffsetChanged(oldScrollOffset, newScrollOffset);
     }
 
-    Invalidate();
+    if (!InvalidateScrollBlit(oldScrollOffset, newScrollOffset)) {
+        Invalidate();
+    }
     SendEvent(kEventScrollChange, (cy == 0) ? 0 : 1, (cx == 0) ? 0 : 1);
 }
 
@@ -1085,6 +1103,187 @@ void ScrollBox::SetHoldEnd(bool bHoldEnd)
     m_bHoldEnd = bHoldEnd;
 }
 
+void ScrollBox::SetEnableScrollBlit(bool bEnable)
+{
+    m_bEnableScrollBlit = bEnable;
+}
+
+void ScrollBox::SetAtlasBatchPaint(bool bAtlasBatchPaint)
+{
+    m_bAtlasBatchPaint = bAtlasBatchPaint;
+}
+
+bool ScrollBox::IsAtlasBatchPaint() const
+{
+    return m_bAtlasBatchPaint;
+}
+
+bool ScrollBox::IsEnableScrollBlit() const
+{
+    return m_bEnableScrollBlit;
+}
+
+/** 控件在窗口客户区中的位置（去掉外层容器的滚动偏移）
+*/
+static UiRect GetControlClientRect(const Control* pControl, const UiRect& rc)
+{
+    UiRect rcClient = rc;
+    UiPoint scrollOffset = pControl->GetScrollOffsetInScrollBox();
+    rcClient.Offset(-scrollOffset.x, -scrollOffset.y);
+    return rcClient;
+}
+
+/** 控件是否设置了不透明的背景颜色
+*/
+static bool IsOpaqueBkColor(const Control* pControl)
+{
+    const DString bkColor = pControl->GetBkColor();
+    return !bkColor.empty() && (pControl->GetUiColor(bkColor).GetA() == 255);
+}
+
+UiRect ScrollBox::GetScrollBlitRect() const
+{
+    //子控件绘制时裁剪到内边距以内
+    UiRect rcScroll = GetRectWithoutPadding();
+    UiRect rcInner = GetRect();
+    const UiRect& rcBorderSize = GetBorderSize();
+    rcInner.Deflate(rcBorderSize.left, rcBorderSize.top, rcBorderSize.right, rcBorderSize.bottom);
+    rcScroll.Intersect(rcInner);
+
+    //滚动条绘制在子控件之上，不随内容移动
+    ScrollBar* pVScrollBar = GetVScrollBar();
+    if ((pVScrollBar != nullptr) && pVScrollBar->IsValid() && pVScrollBar->IsVisible()) {
+        const UiRect& rcBar = pVScrollBar->GetRect();
+        if (IsVScrollBarAtLeft()) {
+            rcScroll.left = std::max(rcScroll.left, rcBar.right);
+        }
+        else {
+            rcScroll.right = std::min(rcScroll.right, rcBar.left);
+        }
+    }
+    ScrollBar* pHScrollBar = GetHScrollBar();
+    if ((pHScrollBar != nullptr) && pHScrollBar->IsValid() && pHScrollBar->IsVisible()) {
+        rcScroll.bottom = std::min(rcScroll.bottom, pHScrollBar->GetRect().top);
+    }
+    return rcScroll;
+}
+
+bool ScrollBox::CanScrollBlit(std::vector<UiRect>& fixedRects) const
+{
+    if (!IsEnableScrollBlit() || !IsVisible() || !IsClip() || IsUseCache() || HasChildOverlay()) {
+        return false;
+    }
+    if ((GetRenderOffset().x != 0) || (GetRenderOffset().y != 0) || !IsPaintSolidColorOnly(false)) {
+        return false;
+    }
+    UiRect rcScroll = GetControlClientRect(this, GetScrollBlitRect());
+    if (rcScroll.IsEmpty()) {
+        return false;
+    }
+    //浮动的子控件不随内容滚动
+    const size_t nChildCount = GetItemCount();
+    for (size_t nIndex = 0; nIndex < nChildCount; ++nIndex) {
+        const Control* pItem = GetItemAt(nIndex);
+        if ((pItem != nullptr) && pItem->IsVisible() && pItem->IsFloat()) {
+            fixedRects.push_back(pItem->GetRect());
+        }
+    }
+
+    //逐级向上检查：
+    //1. 在滚动区域之上绘制的控件（后绘制的兄弟控件、上层容器的滚动条等），都不能与滚动区域重叠
+    //2. 找到背景颜色不透明的控件之前，各级控件都只能绘制纯色背景，并且先绘制的兄弟控件也不能与滚动区域重叠（会随内容一起被复制）
+    bool bOpaque = IsOpaqueBkColor(this);
+    const Control* pChild = this;
+    const Box* pParent = GetParent();
+    while (pParent != nullptr) {
+        if (!pParent->IsVisible() || pParent->HasChildOverlay() || pParent->IsAlpha() ||
+            (pParent->GetRenderOffset().x != 0) || (pParent->GetRenderOffset().y != 0)) {
+            return false;
+        }
+        //上层容器的裁剪区域
+        if (!rcScroll.Intersect(GetControlClientRect(pParent, pParent->GetRect()))) {
+            return false;
+        }
+        const size_t nItemCount = pParent->GetItemCount();
+        bool bPaintAfter = false;
+        for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+            const Control* pItem = pParent->GetItemAt(nIndex);
+            if (pItem == pChild) {
+                bPaintAfter = true;
+                continue;
+            }
+            if ((pItem == nullptr) || !pItem->IsVisible()) {
+                continue;
+            }
+            const bool bPaintOrderChanged = (pItem->GetPaintOrder() != 0) || (pChild->GetPaintOrder() != 0);
+            if (bOpaque && !bPaintAfter && !bPaintOrderChanged) {
+                //在下层绘制，已经被不透明的背景覆盖
+                continue;
+            }
+            UiRect rcItem = GetControlClientRect(pItem, pItem->GetRect());
+            if (rcItem.Intersect(rcScroll)) {
+                return false;
+            }
+        }
+        const ScrollBox* pScrollBox = dynamic_cast<const ScrollBox*>(pParent);
+        if (pScrollBox != nullptr) {
+            ScrollBar* pScrollBars[] = { pScrollBox->GetVScrollBar(), pScrollBox->GetHScrollBar() };
+            for (ScrollBar* pScrollBar : pScrollBars) {
+                if ((pScrollBar != nullptr) && pScrollBar->IsValid() && pScrollBar->IsVisible()) {
+                    UiRect rcBar = GetControlClientRect(pParent, pScrollBar->GetRect());
+                    if (rcBar.Intersect(rcScroll)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        if (!bOpaque) {
+            if (!pParent->IsPaintSolidColorOnly(true)) {
+                return false;
+            }
+            bOpaque = IsOpaqueBkColor(pParent);
+        }
+        pChild = pParent;
+        pParent = pParent->GetParent();
+    }
+    return bOpaque;
+}
+
+bool ScrollBox::InvalidateScrollBlit(const UiSize& oldScrollOffset, const UiSize& newScrollOffset)
+{
+    Window* pWindow = GetWindow();
+    if (pWindow == nullptr) {
+        return false;
+    }
+    std::vector<UiRect> fixedRects;
+    if (!CanScrollBlit(fixedRects)) {
+        return false;
+    }
+    //内容的移动方向与滚动方向相反
+    const int32_t dx = oldScrollOffset.cx - newScrollOffset.cx;
+    const int32_t dy = oldScrollOffset.cy - newScrollOffset.cy;
+    const UiRect rcScroll = GetControlClientRect(this, GetScrollBlitRect());
+    if (!pWindow->InvalidateScroll(rcScroll, dx, dy)) {
+        return false;
+    }
+
+    //不随内容移动的区域：其内容也被复制到了新的位置，两个位置都需要重绘
+    for (const UiRect& rcFixed : fixedRects) {
+        UiRect rcFixedClient = GetControlClientRect(this, rcFixed);
+        pWindow->Invalidate(rcFixedClient);
+        rcFixedClient.Offset(dx, dy);
+        pWindow->Invalidate(rcFixedClient);
+    }
+    //滚动条的位置已经变化
+    ScrollBar* pScrollBars[] = { GetVScrollBar(), GetHScrollBar() };
+    for (ScrollBar* pScrollBar : pScrollBars) {
+        if ((pScrollBar != nullptr) && pScrollBar->IsValid() && pScrollBar->IsVisible()) {
+            pWindow->Invalidate(GetControlClientRect(this, pScrollBar->GetRect()));
+        }
+    }
+    return true;
+}
+
 int32_t ScrollBox::GetVerScrollUnitPixels() const
 {
     return m_nVScrollUnitPixels;
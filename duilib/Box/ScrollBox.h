@@ -193,6 +193,24 @@ public:
      * @param[in] bHoldEnd 设置 true 表示锁定，false 为不锁定
      */
     void SetHoldEnd(bool bHoldEnd);
+
+    /** 设置滚动时是否直接复制已经绘制的内容，只重绘新露出的部分（默认启用，不满足条件时自动重绘整个区域）
+     * @param[in] bEnable 设置 true 表示启用，false 为不启用
+     */
+    void SetEnableScrollBlit(bool bEnable);
+
+    /** 设置绘制子控件时是否批量绘制小图片（图标等通过图集合并绘制，适用于包含大量相似子项的列表）
+     * @param[in] bAtlasBatchPaint 设置 true 表示启用，false 为不启用
+     */
+    void SetAtlasBatchPaint(bool bAtlasBatchPaint);
+
+    /** 绘制子控件时是否批量绘制小图片
+     */
+    bool IsAtlasBatchPaint() const;
+
+    /** 滚动时是否直接复制已经绘制的内容
+     */
+    bool IsEnableScrollBlit() const;
     
     /** 获取垂直滚动条滚动步长
      */
@@ -272,6 +290,11 @@ public:
     void SetScrollVirtualOffsetX(int64_t xOffset);
 
 protected:
+    /** 判断当前状态下，滚动时能否直接复制已经绘制的内容（控件及其上层的容器只有纯色背景，并且没有其他控件遮挡）
+     * @param[out] fixedRects 返回位于滚动区域内、但不随滚动而移动的区域（比如置顶显示的表头），坐标与GetRect()相同
+     */
+    virtual bool CanScrollBlit(std::vector<UiRect>& fixedRects) const;
+
     /** 计算所需的尺寸
      * @param[in] rc 当前位置信息, 外部调用时，不需要剪去内边距
      * @return 返回所需尺寸大小, 包含ScrollBox自身的内边距，不包含外边距
@@ -283,6 +306,17 @@ private:
      */
     void SetPosInternally(const UiRect& rc);
 
+    /** 滚动后，以直接复制已绘制内容的方式刷新界面
+     * @param[in] oldScrollOffset 滚动前的偏移量
+     * @param[in] newScrollOffset 滚动后的偏移量
+     * @return 成功返回true；不满足条件时返回false，需要重绘整个控件
+     */
+    bool InvalidateScrollBlit(const UiSize& oldScrollOffset, const UiSize& newScrollOffset);
+
+    /** 获取滚动区域（去掉边框、内边距和滚动条），坐标与GetRect()相同
+     */
+    UiRect GetScrollBlitRect() const;
+
 private:
     //垂直滚动条接口
     std::unique_ptr<ScrollBar> m_pVScrollBar;
@@ -312,6 +346,12 @@ private:
     //容器的滚动条是否在左侧显示
     bool m_bVScrollBarAtLeft;
 
+    //滚动时是否直接复制已经绘制的内容
+    bool m_bEnableScrollBlit;
+
+    //绘制子控件时是否批量绘制小图片
+    bool m_bAtlasBatchPaint;
+
     //滚动条的外边距
     UiPadding m_rcScrollBarPadding;
 
@@ -680,14 +680,14 @@ void CheckBoxTemplate<InheritType>::PaintText(IRender* pRender)
             DString clrStateColor = GetSelectedStateTextColor(kControlStateNormal);
             if (!clrStateColor.empty()) {
                 UiColor dwWinColor = this->GetUiColor(clrStateColor);
-                pRender->DrawString(rc, textValue, dwWinColor, this->GetIFontById(this->GetFontId()), this->GetTextStyle());
+                pRender->DrawString(rc, textValue, dwWinColor, this->GetIFont(), this->GetTextStyle());
             }
 
             if (this->GetHotAlpha() > 0) {
                 DString textColor = GetSelectedStateTextColor(kControlStateHot);
                 if (!textColor.empty()) {
                     UiColor dwTextColor = this->GetUiColor(textColor);
-                    pRender->DrawString(rc, textValue, dwTextColor, this->GetIFontById(this->GetFontId()), this->GetTextStyle(), (uint8_t)this->GetHotAlpha());
+                    pRender->DrawString(rc, textValue, dwTextColor, this->GetIFont(), this->GetTextStyle(), (uint8_t)this->GetHotAlpha());
                 }
             }
 
@@ -695,7 +695,7 @@ void CheckBoxTemplate<InheritType>::PaintText(IRender* pRender)
         }
     }
 
-    pRender->DrawString(rc, textValue, dwClrColor, this->GetIFontById(this->GetFontId()), this->GetTextStyle());
+    pRender->DrawString(rc, textValue, dwClrColor, this->GetIFont(), this->GetTextStyle());
 }
 
 template<typename InheritType>
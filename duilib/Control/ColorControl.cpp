@@ -2,6 +2,7 @@
 #include "ColorConvert.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Core/GlobalManager.h"
+#include "duilib/Utils/ParallelTaskRunner.h"
 
 namespace ui
 {
@@ -141,17 +142,29 @@ IBitmap* ColorControl::GetColorBitmap(const UiRect& rect)
         m_spBitmap->Init(nWidth, nHeight, true, nullptr, kOpaque_SkAlphaType);
         void* pPixelBits = m_spBitmap->LockPixelBits();
         if (pPixelBits != nullptr) {
+            //第一行是饱和度为1.0的色相行，其余各行由第一行按饱和度计算得到（饱和度从1.0递减到0.0）
             uint32_t* pData = (uint32_t*)pPixelBits;
-            double satStep = 1.0 / (nHeight - 1); //每增加一行，sat的增量值
-            double sat = 1.0;//第一个数值是1.0
-            for (int32_t nRow = 0; nRow < nHeight; ++nRow) {                    
-                ColorConvert::HSV_HUE(pData, nWidth, sat, 1.0);
-                pData += nWidth;
-                sat -= satStep;
-                if ((sat < 0.0) || (nRow == (nHeight - 2))){
-                    //最后一个数值是0.0
-                    sat = 0.0;
-                }
+            ColorConvert::HSV_HUE(pData, nWidth, 1.0, 1.0);
+            const int32_t nSatSteps = (nHeight > 1) ? (nHeight - 1) : 1;
+            auto FillRows = [pData, nWidth, nHeight, nSatSteps](int32_t nStartRow, int32_t nEndRow) {
+                    for (int32_t nRow = std::max(nStartRow, 1); nRow < nEndRow; ++nRow) {
+                        const double sat = (nRow >= nHeight - 1) ? 0.0 : (1.0 - (double)nRow / nSatSteps);
+                        ColorConvert::HSV_HUE_SAT(pData + (size_t)nRow * nWidth, pData, nWidth, sat);
+                    }
+                };
+            //位图较大时（比如高DPI下的大尺寸取色板），按行分块并行生成
+            constexpr const int32_t nParallelPixels = 256 * 1024;
+            constexpr const int32_t nRowsPerTask = 64;
+            ParallelTaskRunner& taskRunner = ParallelTaskRunner::Instance();
+            if (((int64_t)nWidth * nHeight >= nParallelPixels) && (nHeight > nRowsPerTask) && (taskRunner.GetConcurrency() > 1)) {
+                const size_t nTaskCount = (size_t)((nHeight + nRowsPerTask - 1) / nRowsPerTask);
+                taskRunner.ParallelFor(nTaskCount, [&FillRows, nHeight](size_t nIndex) {
+                        const int32_t nStartRow = (int32_t)nIndex * nRowsPerTask;
+                        FillRows(nStartRow, std::min(nStartRow + nRowsPerTask, nHeight));
+                    });
+            }
+            else {
+                FillRows(0, nHeight);
             }
             m_spBitmap->UnLockPixelBits();
         }
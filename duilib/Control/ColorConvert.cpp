@@ -2,6 +2,11 @@
 #include <cassert>
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define DUILIB_COLOR_CONVERT_SSE2 1
+#endif
+
 namespace ui
 {
 
@@ -628,4 +633,64 @@ void ColorConvert::HSL_LIG(uint32_t* buffer, int samples, double hue, double sat
     }
 }
 
+void ColorConvert::HSV_HUE_SAT(uint32_t* buffer, const uint32_t* hueRow, int samples, double sat)
+{
+    if ((buffer == nullptr) || (hueRow == nullptr) || (samples < 1)) {
+        return;
+    }
+    in_range(sat, 0.0, 1.0);
+    //饱和度转换为[0, 256]的定点数，乘法结果最大为255 * 256，可用16位无符号整数表示
+    const uint32_t scale = (uint32_t)(sat * 256 + 0.5);
+    int i = 0;
+#ifdef DUILIB_COLOR_CONVERT_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max8 = _mm_set1_epi16(255);
+    const __m128i scale16 = _mm_set1_epi16((short)scale);
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000);
+    for (; i + 4 <= samples; i += 4) {
+        const __m128i src = _mm_loadu_si128((const __m128i*)(hueRow + i));
+        //每次处理4个像素：拆分为两组，每组2个像素、8个16位的颜色分量
+        __m128i lo = _mm_sub_epi16(max8, _mm_unpacklo_epi8(src, zero));
+        __m128i hi = _mm_sub_epi16(max8, _mm_unpackhi_epi8(src, zero));
+        lo = _mm_sub_epi16(max8, _mm_srli_epi16(_mm_mullo_epi16(lo, scale16), 8));
+        hi = _mm_sub_epi16(max8, _mm_srli_epi16(_mm_mullo_epi16(hi, scale16), 8));
+        __m128i dst = _mm_packus_epi16(lo, hi);
+        dst = _mm_or_si128(_mm_andnot_si128(alphaMask, dst), _mm_and_si128(alphaMask, src));
+        _mm_storeu_si128((__m128i*)(buffer + i), dst);
+    }
+#endif
+    for (; i < samples; ++i) {
+        const uint32_t src = hueRow[i];
+        uint32_t dst = src & 0xFF000000;
+        for (uint32_t shift = 0; shift < 24; shift += 8) {
+            const uint32_t c = 255 - ((((255 - ((src >> shift) & 0xFF)) * scale) >> 8));
+            dst |= (c << shift);
+        }
+        buffer[i] = dst;
+    }
+}
+
+void ColorConvert::GetARGB(uint32_t* buffer, int samples, uint32_t startARGB, uint32_t endARGB)
+{
+    if ((buffer == nullptr) || (samples <= 1)) {
+        return;
+    }
+    int32_t channel[4] = { 0, };
+    int32_t channel_adv[4] = { 0, };
+    for (int32_t nIndex = 0; nIndex < 4; ++nIndex) {
+        const uint32_t shift = (uint32_t)nIndex * 8;
+        channel[nIndex] = (int32_t)((startARGB >> shift) & 0xFF) << int_extend;
+        channel_adv[nIndex] = (((int32_t)((endARGB >> shift) & 0xFF) << int_extend) - channel[nIndex]) / (samples - 1);
+    }
+    while (samples--) {
+        *buffer++ = ((uint32_t)(uint8_t)(channel[3] >> int_extend) << 24) |
+                    ((uint32_t)(uint8_t)(channel[2] >> int_extend) << 16) |
+                    ((uint32_t)(uint8_t)(channel[1] >> int_extend) << 8)  |
+                    ((uint32_t)(uint8_t)(channel[0] >> int_extend));
+        for (int32_t nIndex = 0; nIndex < 4; ++nIndex) {
+            channel[nIndex] += channel_adv[nIndex];
+        }
+    }
+}
+
 } //namespace ui
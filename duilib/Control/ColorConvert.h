@@ -57,6 +57,24 @@ public:
 
     // hsl lightness.
     static void HSL_LIG(uint32_t* buffer, int samples, double hue, double sat);
+
+    /** 由饱和度为1.0的色相行（HSV_HUE(hueRow, samples, 1.0, 1.0)的结果）生成饱和度为sat的色相行
+    *   当V为1.0时，每个颜色分量满足：c = 255 - (255 - c0) * sat，可按行批量计算
+    *   支持SSE2时每次处理4个像素，否则使用逐像素的计算方式；Alpha分量保持不变
+    * @param [out] buffer 输出的像素数据
+    * @param [in] hueRow 饱和度为1.0的色相行
+    * @param [in] samples 像素个数
+    * @param [in] sat 饱和度，取值范围：[0, 1]
+    */
+    static void HSV_HUE_SAT(uint32_t* buffer, const uint32_t* hueRow, int samples, double sat);
+
+    /** 生成ARGB渐变行（包括Alpha分量的渐变），像素格式与UiColor::GetARGB()相同
+    * @param [out] buffer 输出的像素数据
+    * @param [in] samples 像素个数，必须大于1
+    * @param [in] startARGB 起始颜色
+    * @param [in] endARGB 结束颜色
+    */
+    static void GetARGB(uint32_t* buffer, int samples, uint32_t startARGB, uint32_t endARGB);
 };
 
 } //namespace ui
@@ -115,6 +115,7 @@ IBitmap* ColorSlider::GetColorBitmap(const UiRect& rect)
         m_spBitmap->Init(nWidth, nHeight, true, nullptr, alphaType);
         void* pPixelBits = m_spBitmap->LockPixelBits();
         if (pPixelBits != nullptr) {
+            //每一行的颜色都相同：只计算第一行，其余各行直接复制
             uint32_t* pData = (uint32_t*)pPixelBits;
             if (m_colorMode == ColorMode::kMode_ARGB) {
                 uint8_t A = m_argbColor.GetA();
@@ -126,39 +127,20 @@ IBitmap* ColorSlider::GetColorBitmap(const UiRect& rect)
                 if (m_adjustMode == ColorAdjustMode::kMode_ARGB_A) {
                     colorStart = UiColor(0, R, G, B);
                     colorEnd = UiColor(255, R, G, B);
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight );
-                        GetARGB(pData, nWidth, colorStart, colorEnd);
-                        pData += nWidth;
-                    }
                 }
                 else if (m_adjustMode == ColorAdjustMode::kMode_ARGB_R) {
                     colorStart = UiColor(A, 0, G, B);
-                    colorEnd = UiColor(A, 255, G, B);                        
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        GetARGB(pData, nWidth, colorStart, colorEnd);
-                        pData += nWidth;
-                    }
+                    colorEnd = UiColor(A, 255, G, B);
                 }
                 else if (m_adjustMode == ColorAdjustMode::kMode_ARGB_G) {
                     colorStart = UiColor(A, R, 0, B);
                     colorEnd = UiColor(A, R, 255, B);
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        GetARGB(pData, nWidth, colorStart, colorEnd);
-                        pData += nWidth;
-                    }
                 }
                 else if (m_adjustMode == ColorAdjustMode::kMode_ARGB_B) {
                     colorStart = UiColor(A, R, G, 0);
                     colorEnd = UiColor(A, R, G, 255);
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        GetARGB(pData, nWidth, colorStart, colorEnd);
-                        pData += nWidth;
-                    }
                 }
+                GetARGB(pData, nWidth, colorStart, colorEnd);
             }
             else if (m_colorMode == ColorMode::kMode_HSV) {
                 double H = m_hsvColor.H * 1.0;
@@ -166,27 +148,15 @@ IBitmap* ColorSlider::GetColorBitmap(const UiRect& rect)
                 double V = m_hsvColor.V / 100.0;
                 if (m_adjustMode == ColorAdjustMode::kMode_HSV_H) {
                     //H
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        ColorConvert::HSV_HUE(pData, nWidth, S, V);
-                        pData += nWidth;
-                    }
+                    ColorConvert::HSV_HUE(pData, nWidth, S, V);
                 }
                 else if (m_adjustMode == ColorAdjustMode::kMode_HSV_S) {
                     //S
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        ColorConvert::HSV_SAT(pData, nWidth, H, V);
-                        pData += nWidth;
-                    }
+                    ColorConvert::HSV_SAT(pData, nWidth, H, V);
                 }
                 else {
                     //V
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        ColorConvert::HSV_VAL(pData, nWidth, H, S);
-                        pData += nWidth;
-                    }
+                    ColorConvert::HSV_VAL(pData, nWidth, H, S);
                 }
             }
             else if (m_colorMode == ColorMode::kMode_HSL) {
@@ -195,29 +165,20 @@ IBitmap* ColorSlider::GetColorBitmap(const UiRect& rect)
                 double L = m_hslColor.L / 100.0;
                 if (m_adjustMode == ColorAdjustMode::kMode_HSL_H) {
                     //H
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        ColorConvert::HSL_HUE(pData, nWidth, S, L);
-                        pData += nWidth;
-                    }
+                    ColorConvert::HSL_HUE(pData, nWidth, S, L);
                 }
                 else if (m_adjustMode == ColorAdjustMode::kMode_HSL_S) {
                     //S
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        ColorConvert::HSL_SAT(pData, nWidth, H, L);
-                        pData += nWidth;
-                    }
+                    ColorConvert::HSL_SAT(pData, nWidth, H, L);
                 }
                 else {
                     //L
-                    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
-                        ASSERT((pData - (uint32_t*)pPixelBits) < nWidth * nHeight);
-                        ColorConvert::HSL_LIG(pData, nWidth, H, S);
-                        pData += nWidth;
-                    }
+                    ColorConvert::HSL_LIG(pData, nWidth, H, S);
                 }
-            }                
+            }
+            for (int32_t nRow = 1; nRow < nHeight; ++nRow) {
+                ::memcpy(pData + (size_t)nRow * nWidth, pData, sizeof(uint32_t) * nWidth);
+            }
             m_spBitmap->UnLockPixelBits();
         }
     }
@@ -236,29 +197,7 @@ void ColorSlider::GetARGB(uint32_t* buffer, int32_t samples,
     if (samples <= 1) {
         return;
     }
-    constexpr const int32_t int_extend = 20;
-
-    int32_t alpha = (int32_t)start.GetA() << int_extend;
-    int32_t red   = (int32_t)start.GetR() << int_extend;
-    int32_t green = (int32_t)start.GetG() << int_extend;
-    int32_t blue  = (int32_t)start.GetB() << int_extend;
-    int32_t alpha_adv = (((int32_t)end.GetA() << int_extend) - alpha) / (samples - 1);
-    int32_t red_adv   = (((int32_t)end.GetR() << int_extend) - red) / (samples - 1);
-    int32_t green_adv = (((int32_t)end.GetG() << int_extend) - green) / (samples - 1);
-    int32_t blue_adv  = (((int32_t)end.GetB() << int_extend) - blue) / (samples - 1);
-
-    for(int32_t i = 0; i < samples; ++i) {
-        // set current pixel (in DIB bitmap format is BGR, not RGB!)
-        *(buffer + i) = UiColor( (uint8_t)(alpha >> int_extend),
-                                 (uint8_t)(red   >> int_extend),
-                                 (uint8_t)(green >> int_extend),
-                                 (uint8_t)(blue  >> int_extend) ).GetARGB();
-        // advance color values to the next pixel
-        alpha += alpha_adv;
-        red += red_adv;
-        green += green_adv;
-        blue += blue_adv;
-    }
+    ColorConvert::GetARGB(buffer, samples, start.GetARGB(), end.GetARGB());
 }
 
 }//namespace ui
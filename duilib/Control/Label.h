@@ -38,6 +38,7 @@ public:
     virtual bool HasHotState() override;
     virtual void SetAttribute(const DString& strName, const DString& strValue) override;
     virtual void PaintText(IRender* pRender) override;
+    virtual bool IsPaintSolidColorOnly(bool bCheckBorder) const override;
     virtual void SetPos(UiRect rc) override;
     virtual DString GetToolTipText() const override;
 
@@ -53,6 +54,10 @@ public:
     */
     virtual void ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale) override;
 
+    /** 语言发生变化（重新加载了语言文件），如果使用了多语言文本ID，更新文本
+    */
+    virtual void ChangeLanguage() override;
+
     /** 恢复默认的文本样式
     */
     void SetDefaultTextStyle(bool bRedraw);
@@ -93,6 +98,23 @@ public:
      */
     DString GetPaintStateTextColor(ControlStateType buttonStateType, ControlStateType& stateType);
 
+    /** 获取指定状态下的实际被渲染文本颜色值（使用预解析的颜色，绘制时不做颜色名称查找）
+     * @param[in] buttonStateType 要获取何种状态下的颜色
+     * @param[out] stateType 实际被渲染的状态
+     * @return 返回颜色值
+     */
+    UiColor GetPaintStateTextUiColor(ControlStateType buttonStateType, ControlStateType& stateType) const;
+
+    /** 是否设置了指定状态下的文本颜色（包括默认文本颜色）
+     * @param[in] stateType 要获取的状态标志
+     */
+    bool HasStateTextColor(ControlStateType stateType) const;
+
+    /** 获取指定状态下的文本颜色值（使用预解析的颜色，绘制时不做颜色名称查找）
+     * @param[in] stateType 要获取的状态标志
+     */
+    UiColor GetStateTextUiColor(ControlStateType stateType) const;
+
     /** 获取当前字体ID
      * @return 返回字体ID，该字体ID在 global.xml 中标识
      */
@@ -103,6 +125,10 @@ public:
      */
     void SetFontId(const DString& strFontId);
 
+    /** 获取当前字体ID对应的字体接口（按控件缓存，绘制时不做字体查找）
+     */
+    IFont* GetIFont() const;
+
     /** 获取文字内边距
      * @return 返回文字的内边距信息
      */
@@ -308,12 +334,22 @@ void LabelTemplate<InheritType>::ChangeDpiScale(uint32_t nOldDpiScale, uint32_t
     BaseClass::ChangeDpiScale(nOldDpiScale, nNewDpiScale);
 }
 
+template<typename InheritType>
+void LabelTemplate<InheritType>::ChangeLanguage()
+{
+    BaseClass::ChangeLanguage();
+    if (!m_sTextId.empty() && m_sText.empty()) {
+        //文本在绘制时通过ID获取，只需要重新评估大小并重绘
+        this->RelayoutOrRedraw();
+    }
+}
+
 template<typename InheritType>
 DString LabelTemplate<InheritType>::GetText() const
 {
     DString strText = m_sText.c_str();
     if (strText.empty() && !m_sTextId.empty()) {
-        strText = GlobalManager::Instance().Lang().GetStringViaID(m_sTextId.c_str());
+        strText = GlobalManager::Instance().Lang().GetStringViewViaID(m_sTextId.c_str());
     }
 
     return strText;
@@ -387,7 +423,7 @@ void LabelTemplate<InheritType>::CheckShowToolTip()
         width = rc.Width();
     }
 
-    UiRect rcMessure = pRender->MeasureString(sText, this->GetIFontById(this->GetFontId()), m_uTextStyle, width);
+    UiRect rcMessure = pRender->MeasureString(sText, this->GetIFont(), m_uTextStyle, width);
     if (rc.Width() < rcMessure.Width() || rc.Height() < rcMessure.Height()) {
         m_sAutoShowTooltipCache = sText;
     }
@@ -485,7 +521,7 @@ UiSize LabelTemplate<InheritType>::EstimateText(UiSize szAvailable)
     if (!textValue.empty() && (this->GetWindow() != nullptr)) {
         auto pRender = this->GetWindow()->GetRender();
         if (pRender != nullptr) {
-            UiRect rect = pRender->MeasureString(textValue, this->GetIFontById(GetFontId()), m_uTextStyle, nWidth);
+            UiRect rect = pRender->MeasureString(textValue, this->GetIFont(), m_uTextStyle, nWidth);
             fixedSize.cx = rect.Width();
             if (fixedSize.cx > 0) {
                 fixedSize.cx += (rcTextPadding.left + rcTextPadding.right);
@@ -511,6 +547,15 @@ void LabelTemplate<InheritType>::PaintText(IRender* pRender)
     DoPaintText(rc, pRender);
 }
 
+template<typename InheritType>
+bool LabelTemplate<InheritType>::IsPaintSolidColorOnly(bool bCheckBorder) const
+{
+    if (!GetText().empty()) {
+        return false;
+    }
+    return BaseClass::IsPaintSolidColorOnly(bCheckBorder);
+}
+
 template<typename InheritType>
 void LabelTemplate<InheritType>::DoPaintText(const UiRect & rc, IRender * pRender)
 {
@@ -520,7 +565,7 @@ void LabelTemplate<InheritType>::DoPaintText(const UiRect & rc, IRender * pRende
     }
 
     ControlStateType stateType = this->GetState();
-    UiColor dwClrColor = this->GetUiColor(GetPaintStateTextColor(this->GetState(), stateType));
+    UiColor dwClrColor = GetPaintStateTextUiColor(this->GetState(), stateType);
 
     if (m_bSingleLine) {
         m_uTextStyle |= TEXT_SINGLELINE;
@@ -528,29 +573,25 @@ void LabelTemplate<InheritType>::DoPaintText(const UiRect & rc, IRender * pRende
     else {
         m_uTextStyle &= ~TEXT_SINGLELINE;
     }
-    DString fontId = GetFontId();
+    IFont* pFont = this->GetIFont();
     if (this->GetAnimationManager().GetAnimationPlayer(AnimationType::kAnimationHot)) {
         if ((stateType == kControlStateNormal || stateType == kControlStateHot) && 
-            !GetStateTextColor(kControlStateHot).empty()) {
-            DString clrColor = GetStateTextColor(kControlStateNormal);
-            if (!clrColor.empty()) {
-                UiColor dwTextColor = this->GetUiColor(clrColor);
-                pRender->DrawString(rc, textValue, dwTextColor, this->GetIFontById(fontId), m_uTextStyle);
+            HasStateTextColor(kControlStateHot)) {
+            if (HasStateTextColor(kControlStateNormal)) {
+                UiColor dwTextColor = GetStateTextUiColor(kControlStateNormal);
+                pRender->DrawString(rc, textValue, dwTextColor, pFont, m_uTextStyle);
             }
 
             if (this->GetHotAlpha() > 0) {
-                DString textColor = GetStateTextColor(kControlStateHot);
-                if (!textColor.empty()) {
-                    UiColor dwTextColor = this->GetUiColor(textColor);
-                    pRender->DrawString(rc, textValue, dwTextColor, this->GetIFontById(fontId), m_uTextStyle, (uint8_t)this->GetHotAlpha());
-                }
+                UiColor dwTextColor = GetStateTextUiColor(kControlStateHot);
+                pRender->DrawString(rc, textValue, dwTextColor, pFont, m_uTextStyle, (uint8_t)this->GetHotAlpha());
             }
 
             return;
         }
     }
 
-    pRender->DrawString(rc, textValue, dwClrColor, this->GetIFontById(fontId), m_uTextStyle);
+    pRender->DrawString(rc, textValue, dwClrColor, pFont, m_uTextStyle);
 }
 
 template<typename InheritType>
@@ -626,6 +667,52 @@ DString ui::LabelTemplate<InheritType>::GetPaintStateTextColor(ControlStateType
     return GetStateTextColor(stateType);
 }
 
+template<typename InheritType>
+bool LabelTemplate<InheritType>::HasStateTextColor(ControlStateType stateType) const
+{
+    if ((m_pTextColorMap != nullptr) && m_pTextColorMap->HasStateColor(stateType)) {
+        return true;
+    }
+    if (stateType == kControlStateNormal) {
+        return !GlobalManager::Instance().Color().GetDefaultTextColorToken().empty();
+    }
+    if (stateType == kControlStateDisabled) {
+        return !GlobalManager::Instance().Color().GetDefaultDisabledTextColorToken().empty();
+    }
+    return false;
+}
+
+template<typename InheritType>
+UiColor LabelTemplate<InheritType>::GetStateTextUiColor(ControlStateType stateType) const
+{
+    if ((m_pTextColorMap != nullptr) && m_pTextColorMap->HasStateColor(stateType)) {
+        return m_pTextColorMap->GetStateUiColor(stateType);
+    }
+    if (stateType == kControlStateNormal) {
+        return this->GetUiColor(GlobalManager::Instance().Color().GetDefaultTextColorToken());
+    }
+    if (stateType == kControlStateDisabled) {
+        return this->GetUiColor(GlobalManager::Instance().Color().GetDefaultDisabledTextColorToken());
+    }
+    return UiColor();
+}
+
+template<typename InheritType>
+UiColor LabelTemplate<InheritType>::GetPaintStateTextUiColor(ControlStateType buttonStateType, ControlStateType& stateType) const
+{
+    stateType = buttonStateType;
+    if (stateType == kControlStatePushed && !HasStateTextColor(kControlStatePushed)) {
+        stateType = kControlStateHot;
+    }
+    if (stateType == kControlStateHot && !HasStateTextColor(kControlStateHot)) {
+        stateType = kControlStateNormal;
+    }
+    if (stateType == kControlStateDisabled && !HasStateTextColor(kControlStateDisabled)) {
+        stateType = kControlStateNormal;
+    }
+    return GetStateTextUiColor(stateType);
+}
+
 template<typename InheritType>
 DString LabelTemplate<InheritType>::GetFontId() const
 {
@@ -639,6 +726,12 @@ void LabelTemplate<InheritType>::SetFontId(const DString& strFontId)
     this->Invalidate();
 }
 
+template<typename InheritType>
+IFont* LabelTemplate<InheritType>::GetIFont() const
+{
+    return this->GetCachedIFont(m_sFontId.c_str());
+}
+
 template<typename InheritType>
 UiPadding LabelTemplate<InheritType>::GetTextPadding() const
 {
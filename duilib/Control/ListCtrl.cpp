@@ -19,6 +19,8 @@ ListCtrl::ListCtrl(Window* pWindow):
     m_bEnableRefresh(true),
     m_bMultiSelect(true),
     m_bEnableColumnWidthAuto(true),
+    m_columnAutoFitMode(ListCtrlAutoFitMode::kAllRows),
+    m_nAutoFitSampleCount(1000),
     m_bAutoCheckSelect(false),
     m_bHeaderShowCheckBox(false),
     m_bDataItemShowCheckBox(false),
@@ -107,6 +109,10 @@ void ListCtrl::SetImageList(ListCtrlType type, ImageList* pImageList)
         delete pOldImageList;
         pOldImageList = nullptr;
     }
+    //图标大小可能发生变化，子项的宽度缓存失效
+    if (m_pData != nullptr) {
+        m_pData->ClearColumnWidthCache();
+    }
 }
 
 ImageList* ListCtrl::GetImageList(ListCtrlType type)
@@ -197,6 +203,17 @@ void ListCtrl::SetAttribute(const DString& strName, const DString& strValue)
     else if (strName == _T("enable_column_width_auto")) {
         SetEnableColumnWidthAuto(strValue == _T("true"));
     }
+    else if (strName == _T("column_auto_fit_mode")) {
+        if (strValue == _T("all")) {
+            SetColumnAutoFitMode(ListCtrlAutoFitMode::kAllRows);
+        }
+        else if (strValue == _T("sampled")) {
+            SetColumnAutoFitMode(ListCtrlAutoFitMode::kSampledRows, m_nAutoFitSampleCount);
+        }
+        else if (strValue == _T("visible")) {
+            SetColumnAutoFitMode(ListCtrlAutoFitMode::kVisibleRows);
+        }
+    }
     else if (strName == _T("auto_check_select")) {
         SetAutoCheckSelect(strValue == _T("true"));
     }
@@ -678,6 +695,9 @@ DString ListCtrl::GetReportViewClass() const
 void ListCtrl::SetDataItemClass(const DString& className)
 {
     m_dataItemClass = className;
+    if (m_pData != nullptr) {
+        m_pData->ClearColumnWidthCache();
+    }
 }
 
 DString ListCtrl::GetDataItemClass() const
@@ -688,6 +708,9 @@ DString ListCtrl::GetDataItemClass() const
 void ListCtrl::SetDataSubItemClass(const DString& className)
 {
     m_dataSubItemClass = className;
+    if (m_pData != nullptr) {
+        m_pData->ClearColumnWidthCache();
+    }
     if (IsInited() && !className.empty()) {
         ListCtrlSubItem defaultSubItem(GetWindow());
         defaultSubItem.SetClass(className);
@@ -866,6 +889,19 @@ bool ListCtrl::IsEnableColumnWidthAuto() const
     return m_bEnableColumnWidthAuto;
 }
 
+void ListCtrl::SetColumnAutoFitMode(ListCtrlAutoFitMode autoFitMode, size_t nSampleCount)
+{
+    m_columnAutoFitMode = autoFitMode;
+    if (nSampleCount > 0) {
+        m_nAutoFitSampleCount = nSampleCount;
+    }
+}
+
+ListCtrlAutoFitMode ListCtrl::GetColumnAutoFitMode() const
+{
+    return m_columnAutoFitMode;
+}
+
 ListCtrlHeaderItem* ListCtrl::InsertColumn(int32_t columnIndex, const ListCtrlColumn& columnInfo)
 {
     ASSERT(m_pHeaderCtrl != nullptr);
@@ -920,8 +956,28 @@ bool ListCtrl::SetColumnWidthAuto(size_t columnIndex)
         return bRet;
     }
     //计算该列的宽度
-    int32_t nMaxWidth = m_pData->GetMaxColumnWidth(nColumnId);
+    int32_t nMaxWidth = -1;
+    const size_t nItemCount = m_pData->GetDataItemCount();
+    if ((m_columnAutoFitMode == ListCtrlAutoFitMode::kVisibleRows) && (m_pReportView != nullptr)) {
+        std::vector<size_t> itemIndexs;
+        m_pReportView->GetDisplayElements(itemIndexs);
+        nMaxWidth = m_pData->GetMaxColumnWidth(nColumnId, itemIndexs);
+    }
+    else if ((m_columnAutoFitMode == ListCtrlAutoFitMode::kSampledRows) && (nItemCount > m_nAutoFitSampleCount)) {
+        //按固定间隔抽样
+        std::vector<size_t> itemIndexs;
+        itemIndexs.reserve(m_nAutoFitSampleCount);
+        for (size_t nIndex = 0; nIndex < m_nAutoFitSampleCount; ++nIndex) {
+            itemIndexs.push_back(nIndex * nItemCount / m_nAutoFitSampleCount);
+        }
+        nMaxWidth = m_pData->GetMaxColumnWidth(nColumnId, itemIndexs);
+    }
+    else {
+        nMaxWidth = m_pData->GetMaxColumnWidth(nColumnId);
+    }
     if (nMaxWidth > 0) {
+        //增加一点余量
+        nMaxWidth += Dpi().GetScaleInt(4);
         bRet = SetColumnWidth(columnIndex, nMaxWidth, false);
     }
     return bRet;
@@ -633,6 +633,13 @@ public:
     void SetEnableColumnWidthAuto(bool bEnable);
     bool IsEnableColumnWidthAuto() const;
 
+    /** 设置自动调整列宽时，计算列宽所统计的数据行（默认统计所有行）
+    * @param [in] autoFitMode 统计方式
+    * @param [in] nSampleCount 抽样统计时，最多统计的行数（仅kSampledRows方式有效）
+    */
+    void SetColumnAutoFitMode(ListCtrlAutoFitMode autoFitMode, size_t nSampleCount = 1000);
+    ListCtrlAutoFitMode GetColumnAutoFitMode() const;
+
 public:
     /** 监听选择子项的事件
      * @param[in] callback 选择子项时的回调函数
@@ -1021,6 +1028,14 @@ private:
     */
     bool m_bEnableColumnWidthAuto;
 
+    /** 自动调整列宽时，计算列宽所统计的数据行
+    */
+    ListCtrlAutoFitMode m_columnAutoFitMode;
+
+    /** 抽样统计时，最多统计的行数
+    */
+    size_t m_nAutoFitSampleCount;
+
     /** 是否自动勾选选择的数据项（与Windows下ListCtrl的LVS_EX_AUTOCHECKSELECT属性相似）
     */
     bool m_bAutoCheckSelect;
@@ -17,7 +17,8 @@ ListCtrlData::ListCtrlData() :
     m_nSelectedIndex(Box::InvalidIndex),
     m_nDefaultTextStyle(0),
     m_nDefaultItemHeight(-1),
-    m_bAutoCheckSelect(false)
+    m_bAutoCheckSelect(false),
+    m_nWidthFontGeneration(0)
 {
 }
 
@@ -57,30 +58,110 @@ bool ListCtrlData::FillElement(Control* pControl, size_t nElementIndex)
     return bRet;
 }
 
-int32_t ListCtrlData::GetMaxColumnWidth(size_t columnId) const
+int32_t ListCtrlData::GetMaxColumnWidth(size_t columnId)
 {
-    int32_t nMaxWidth = -1;
-    std::vector<ListCtrlSubItemData2Ptr> subItemList;
     auto iter = m_dataMap.find(columnId);
     ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
-        const StoragePtrList& storageList = iter->second;
-        const size_t nCount = storageList.size();
-        for (size_t index = 0; index < nCount; ++index) {
-            if (storageList[index] != nullptr) {
-                subItemList.push_back(storageList[index]);
+    if (iter == m_dataMap.end()) {
+        return -1;
+    }
+    const StoragePtrList& storageList = iter->second;
+
+    //只计算新增或者修改过的子项，已缓存的子项不需要重新计算（新计算的宽度已计入最大宽度）
+    CalcSubItemWidths(columnId, storageList);
+    ColumnWidthStat& widthStat = m_columnWidthStats[columnId];
+    if (!widthStat.bMaxValid) {
+        //最宽的子项被修改或者删除过，从缓存中重新统计
+        int32_t nMaxWidth = -1;
+        for (const StoragePtr& pStorage : storageList) {
+            if (pStorage != nullptr) {
+                nMaxWidth = std::max(nMaxWidth, pStorage->nItemWidth);
             }
         }
+        widthStat.nMaxWidth = nMaxWidth;
+        widthStat.bMaxValid = true;
+    }
+    return (widthStat.nMaxWidth > 0) ? widthStat.nMaxWidth : -1;
+}
+
+int32_t ListCtrlData::GetMaxColumnWidth(size_t columnId, const std::vector<size_t>& itemIndexs)
+{
+    auto iter = m_dataMap.find(columnId);
+    ASSERT(iter != m_dataMap.end());
+    if (iter == m_dataMap.end()) {
+        return -1;
+    }
+    const StoragePtrList& columnStorageList = iter->second;
+    StoragePtrList storageList;
+    storageList.reserve(itemIndexs.size());
+    for (size_t itemIndex : itemIndexs) {
+        if ((itemIndex < columnStorageList.size()) && (columnStorageList[itemIndex] != nullptr)) {
+            storageList.push_back(columnStorageList[itemIndex]);
+        }
+    }
+    CalcSubItemWidths(columnId, storageList);
+    int32_t nMaxWidth = -1;
+    for (const StoragePtr& pStorage : storageList) {
+        nMaxWidth = std::max(nMaxWidth, pStorage->nItemWidth);
+    }
+    return (nMaxWidth > 0) ? nMaxWidth : -1;
+}
+
+int32_t ListCtrlData::CalcSubItemWidths(size_t columnId, const StoragePtrList& storageList)
+{
+    //字体发生变化后，已经缓存的宽度全部失效
+    const uint32_t nFontGeneration = GlobalManager::Instance().Font().GetFontGeneration();
+    if (nFontGeneration != m_nWidthFontGeneration) {
+        ClearColumnWidthCache();
+        m_nWidthFontGeneration = nFontGeneration;
     }
+
+    std::vector<ListCtrlSubItemData2Ptr> subItemList;
+    for (const StoragePtr& pStorage : storageList) {
+        if ((pStorage != nullptr) && (pStorage->nItemWidth < 0)) {
+            subItemList.push_back(pStorage);
+        }
+    }
+    int32_t nMaxWidth = -1;
     if (!subItemList.empty()) {
         ASSERT(m_pListView != nullptr);
         if (m_pListView != nullptr) {
             nMaxWidth = m_pListView->GetMaxDataItemWidth(subItemList);
         }
-    }    
+        //计入该列的最大宽度，否则之后统计整列的最大宽度时，这些已缓存宽度的子项会被遗漏
+        auto iter = m_columnWidthStats.find(columnId);
+        if ((iter != m_columnWidthStats.end()) && iter->second.bMaxValid) {
+            iter->second.nMaxWidth = std::max(iter->second.nMaxWidth, nMaxWidth);
+        }
+    }
     return nMaxWidth;
 }
 
+void ListCtrlData::ClearColumnWidthCache()
+{
+    for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
+        for (const StoragePtr& pStorage : iter->second) {
+            if (pStorage != nullptr) {
+                pStorage->nItemWidth = -1;
+            }
+        }
+    }
+    m_columnWidthStats.clear();
+}
+
+void ListCtrlData::ResetSubItemWidth(size_t columnId, Storage& storage)
+{
+    if (storage.nItemWidth < 0) {
+        return;
+    }
+    auto iter = m_columnWidthStats.find(columnId);
+    if ((iter != m_columnWidthStats.end()) && (storage.nItemWidth >= iter->second.nMaxWidth)) {
+        //最宽的子项发生变化，最大宽度需要重新统计
+        iter->second.bMaxValid = false;
+    }
+    storage.nItemWidth = -1;
+}
+
 size_t ListCtrlData::GetElementCount() const
 {
     return GetDataItemCount();
@@ -213,6 +294,7 @@ void ListCtrlData::ChangeDpiScale(const DpiManager& dpiManager, uint32_t nOldDpi
             data.nItemHeight = ui::TruncateToUInt16(dpiManager.GetScaleInt((int32_t)data.nItemHeight, nOldDpiScale));
         }
     }
+    ClearColumnWidthCache();
 }
 
 void ListCtrlData::SubItemToStorage(const ListCtrlSubItemData& item, Storage& storage) const
@@ -277,6 +359,7 @@ bool ListCtrlData::RemoveColumn(size_t columnId)
     auto iter = m_dataMap.find(columnId);
     if (iter != m_dataMap.end()) {
         m_dataMap.erase(iter);
+        m_columnWidthStats.erase(columnId);
         if (m_dataMap.empty()) {
             //如果所有列都删除了，行也清空为0
             m_rowDataList.clear();
@@ -415,7 +498,10 @@ bool ListCtrlData::SetDataItemCount(size_t itemCount)
         iter->second.resize(itemCount);
     }
     if (itemCount < nOldCount) {
-        //行数变少了
+        //行数变少了，各列的最大宽度需要重新统计
+        for (auto iter = m_columnWidthStats.begin(); iter != m_columnWidthStats.end(); ++iter) {
+            iter->second.bMaxValid = false;
+        }
         if ((m_hideRowCount != 0) || (m_heightRowCount != 0) || (m_atTopRowCount != 0)) {
             UpdateNormalMode();
         }
@@ -522,6 +608,9 @@ bool ListCtrlData::DeleteDataItem(size_t itemIndex)
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
         StoragePtrList& storageList = iter->second;
         if (itemIndex < storageList.size()) {
+            if (storageList[itemIndex] != nullptr) {
+                ResetSubItemWidth(iter->first, *storageList[itemIndex]);
+            }
             storageList.erase(storageList.begin() + itemIndex);
         }
     }
@@ -566,6 +655,7 @@ bool ListCtrlData::DeleteAllDataItems()
         StoragePtrList emptyList;
         storageList.swap(emptyList);
     }
+    m_columnWidthStats.clear();
     //清空行数据
     if (!m_rowDataList.empty()) {
         bDeleted = true;
@@ -1118,6 +1208,7 @@ bool ListCtrlData::SetSubItemData(size_t itemIndex, size_t columnId,
                 if (storage.bChecked != pStorage->bChecked) {
                     bCheckChanged = true;
                 }
+                ResetSubItemWidth(columnId, *pStorage);
                 *pStorage = storage;
             }
             bRet = true;
@@ -1161,6 +1252,7 @@ bool ListCtrlData::SetSubItemText(size_t itemIndex, size_t columnId, const DStri
     }
     if (pStorage->text != text) {
         pStorage->text = text;
+        ResetSubItemWidth(columnId, *pStorage);
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1249,6 +1341,7 @@ bool ListCtrlData::SetSubItemTextFormat(size_t itemIndex, size_t columnId, int32
 
     if (pStorage->nTextFormat != nValidTextFormat) {
         pStorage->nTextFormat = ui::TruncateToUInt16(nValidTextFormat);
+        ResetSubItemWidth(columnId, *pStorage);
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1317,6 +1410,7 @@ bool ListCtrlData::SetSubItemShowCheckBox(size_t itemIndex, size_t columnId, boo
     }
     if (pStorage->bShowCheckBox != bShowCheckBox) {
         pStorage->bShowCheckBox = bShowCheckBox;
+        ResetSubItemWidth(columnId, *pStorage);
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1373,6 +1467,7 @@ bool ListCtrlData::SetSubItemImageId(size_t itemIndex, size_t columnId, int32_t
     }
     if (pStorage->nImageId != imageId) {
         pStorage->nImageId = imageId;
+        ResetSubItemWidth(columnId, *pStorage);
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
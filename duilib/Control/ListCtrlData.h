@@ -104,10 +104,22 @@ public:
     */
     bool RemoveColumn(size_t columnId);
 
-    /** 获取某列的宽度最大值
+    /** 获取某列的宽度最大值（统计所有行）
+    *   各个子项的宽度计算后会缓存起来，只有新增或者修改过的子项需要重新计算
     * @return 返回该列宽度的最大值，返回的是DPI自适应后的值； 如果失败返回-1
     */
-    int32_t GetMaxColumnWidth(size_t columnId) const;
+    int32_t GetMaxColumnWidth(size_t columnId);
+
+    /** 获取某列中指定行的宽度最大值（用于抽样统计或者只统计显示的行）
+    * @param [in] columnId 列的ID
+    * @param [in] itemIndexs 数据项的索引号列表, 有效范围：[0, GetDataItemCount())
+    * @return 返回宽度的最大值，返回的是DPI自适应后的值； 如果失败返回-1
+    */
+    int32_t GetMaxColumnWidth(size_t columnId, const std::vector<size_t>& itemIndexs);
+
+    /** 清除所有子项的宽度缓存（影响显示宽度的设置，比如DPI、样式、图标等发生变化时调用）
+    */
+    void ClearColumnWidthCache();
 
     /** 设置一列的勾选状态（Checked或者UnChecked）
     * @param [in] columnId 列的ID
@@ -476,6 +488,19 @@ private:
     */
     void SubItemToStorage(const ListCtrlSubItemData& item, Storage& storage) const;
 
+    /** 子项的显示内容发生变化：清除该子项的宽度缓存，并更新列的宽度统计信息
+    * @param [in] columnId 列的ID
+    * @param [in] storage 子项的数据
+    */
+    void ResetSubItemWidth(size_t columnId, Storage& storage);
+
+    /** 计算子项列表中未缓存宽度的子项的宽度，并计入该列的最大宽度
+    * @param [in] columnId 列的ID
+    * @param [in] storageList 子项列表（属于该列）
+    * @return 返回新计算的子项中宽度的最大值，如果没有需要计算的子项，返回-1
+    */
+    int32_t CalcSubItemWidths(size_t columnId, const StoragePtrList& storageList);
+
     /** 存储数据转换为结构数据
     */
     void StorageToSubItem(const Storage& storage, ListCtrlSubItemData& item) const;
@@ -603,6 +628,22 @@ private:
     /** 当前默认的行高
     */
     int32_t m_nDefaultItemHeight;
+
+    /** 列的宽度统计信息
+    */
+    struct ColumnWidthStat
+    {
+        int32_t nMaxWidth = -1;     //已缓存宽度的子项中，宽度的最大值
+        bool bMaxValid = false;     //nMaxWidth是否有效（最宽的子项被修改或者删除后，需要重新统计）
+    };
+
+    /** 各列的宽度统计信息，Key是列的ID
+    */
+    std::unordered_map<size_t, ColumnWidthStat> m_columnWidthStats;
+
+    /** 宽度缓存对应的字体版本号，字体变化后宽度缓存失效
+    */
+    uint32_t m_nWidthFontGeneration;
 };
 
 }//namespace ui
@@ -73,6 +73,7 @@ struct ListCtrlSubItemData2
     bool bShowCheckBox = true;      //是否显示CheckBox  
     bool bChecked = false;          //是否处于勾选状态（CheckBox勾选状态）
     bool bEditable = false;         //是否可编辑
+    int32_t nItemWidth = -1;        //显示宽度的缓存（DPI自适应后的值，用于自动调整列宽），-1表示需要重新计算
 };
 
 //列数据的智能指针
@@ -125,13 +126,22 @@ public:
                               const std::vector<ListCtrlSubItemData2Pair>& subItemList) = 0;
 
 
-    /** 获取某列的宽度最大值
+    /** 计算数据子项的显示宽度，计算结果同时保存在各个子项的宽度缓存中（nItemWidth）
     * @param [in] subItemList 数据子项（代表每一列的数据）
-    * @return 返回该列宽度的最大值，返回的是DPI自适应后的值； 如果失败返回-1
+    * @return 返回这些子项宽度的最大值，返回的是DPI自适应后的值； 如果失败返回-1
     */
     virtual int32_t GetMaxDataItemWidth(const std::vector<ListCtrlSubItemData2Ptr>& subItemList) = 0;
 };
 
+/** 自动调整列宽（比如双击表头的分割线）时，计算列宽所统计的数据行
+*/
+enum class ListCtrlAutoFitMode
+{
+    kAllRows,       //统计所有行（结果精确，默认方式）
+    kSampledRows,   //数据量较大时，按固定间隔抽样统计部分行（速度快，结果可能偏小）
+    kVisibleRows    //只统计当前界面中显示的行
+};
+
 /** 列表中使用的Label控件，用于显示文本，并提供文本编辑功能
 */
 class ListCtrlLabel: public LabelTemplate<HBox>
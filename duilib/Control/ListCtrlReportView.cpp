@@ -1,6 +1,9 @@
 #include "ListCtrlReportView.h" 
 #include "ListCtrl.h"
 #include "duilib/Render/AutoClip.h"
+#include "duilib/Render/AutoAtlasBatch.h"
+#include "duilib/Core/GlobalManager.h"
+#include "duilib/Utils/ParallelTaskRunner.h"
 
 //包含类：ListCtrlReportView / ListCtrlReportLayout
 
@@ -605,39 +608,42 @@ void ListCtrlReportView::PaintChild(IRender* pRender, const UiRect& rcPaint)
         }
     }
 
-    //绘制列表项子控件
-    for (Control* pControl : items) {
-        if (pControl == nullptr) {
-            continue;
-        }
-        if (!pControl->IsVisible()) {
-            continue;
-        }
+    //绘制列表项子控件（子项中的小图片通过图集批量绘制）
+    {
+        AutoAtlasBatch atlasBatch(pRender, IsAtlasBatchPaint());
+        for (Control* pControl : items) {
+            if (pControl == nullptr) {
+                continue;
+            }
+            if (!pControl->IsVisible()) {
+                continue;
+            }
 
-        UiSize scrollPos = GetScrollOffset();
-        UiRect rcNewPaint = GetPosWithoutPadding();
-        AutoClip alphaClip(pRender, rcNewPaint, IsClip());
-        rcNewPaint.Offset(scrollPos.cx, scrollPos.cy);
-        rcNewPaint.Offset(GetRenderOffset().x, GetRenderOffset().y);
-
-        bool bHasClip = false;
-        if (!atTopItems.empty() &&
-            (std::find(atTopItems.begin(), atTopItems.end(), pControl) == atTopItems.end())) {            
-            UiRect rcControlRect = pControl->GetRect();
-            UiRect rUnion;
-            if (UiRect::Intersect(rUnion, rcTopControls, rcControlRect)) {
-                //有交集，需要设置裁剪，避免绘制置顶元素与其他元素重叠的区域
-                pRender->SetClip(rUnion, false);
-                bHasClip = true;
+            UiSize scrollPos = GetScrollOffset();
+            UiRect rcNewPaint = GetPosWithoutPadding();
+            AutoClip alphaClip(pRender, rcNewPaint, IsClip());
+            rcNewPaint.Offset(scrollPos.cx, scrollPos.cy);
+            rcNewPaint.Offset(GetRenderOffset().x, GetRenderOffset().y);
+
+            bool bHasClip = false;
+            if (!atTopItems.empty() &&
+                (std::find(atTopItems.begin(), atTopItems.end(), pControl) == atTopItems.end())) {            
+                UiRect rcControlRect = pControl->GetRect();
+                UiRect rUnion;
+                if (UiRect::Intersect(rUnion, rcTopControls, rcControlRect)) {
+                    //有交集，需要设置裁剪，避免绘制置顶元素与其他元素重叠的区域
+                    pRender->SetClip(rUnion, false);
+                    bHasClip = true;
+                }
             }
-        }
 
-        UiPoint ptOffset(scrollPos.cx, scrollPos.cy);
-        UiPoint ptOldOrg = pRender->OffsetWindowOrg(ptOffset);
-        pControl->AlphaPaint(pRender, rcNewPaint);
-        pRender->SetWindowOrg(ptOldOrg);
-        if (bHasClip) {
-            pRender->ClearClip();
+            UiPoint ptOffset(scrollPos.cx, scrollPos.cy);
+            UiPoint ptOldOrg = pRender->OffsetWindowOrg(ptOffset);
+            pControl->AlphaPaint(pRender, rcNewPaint);
+            pRender->SetWindowOrg(ptOldOrg);
+            if (bHasClip) {
+                pRender->ClearClip();
+            }
         }
     }
 
@@ -1032,33 +1038,70 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
 int32_t ListCtrlReportView::GetMaxDataItemWidth(const std::vector<ListCtrlSubItemData2Ptr>& subItemList)
 {
     int32_t nMaxWidth = -1;
-    if (m_pListCtrl == nullptr) {
+    if ((m_pListCtrl == nullptr) || subItemList.empty()) {
+        return nMaxWidth;
+    }
+    Window* pWindow = m_pListCtrl->GetWindow();
+    IRender* pRender = (pWindow != nullptr) ? pWindow->GetRender() : nullptr;
+    if (pRender == nullptr) {
         return nMaxWidth;
     }
 
     //默认属性
-    ListCtrlItem defaultItem(m_pListCtrl->GetWindow());
+    ListCtrlItem defaultItem(pWindow);
     defaultItem.SetListCtrl(m_pListCtrl);
     defaultItem.SetClass(m_pListCtrl->GetDataItemClass());
 
     DString defaultSubItemClass = m_pListCtrl->GetDataSubItemClass();
-    ListCtrlSubItem defaultSubItem(m_pListCtrl->GetWindow());
+    ListCtrlSubItem defaultSubItem(pWindow);
     defaultSubItem.SetClass(defaultSubItemClass);
     defaultSubItem.SetListCtrlItem(&defaultItem);
 
-    ListCtrlSubItem subItem(m_pListCtrl->GetWindow());
+    ListCtrlSubItem subItem(pWindow);
     subItem.SetClass(defaultSubItemClass);
     subItem.SetListCtrlItem(&defaultItem);
 
-    for (const ListCtrlSubItemData2Ptr& pStorage : subItemList) {
+    IFont* pFont = subItem.GetIFont();
+    if (pFont == nullptr) {
+        return nMaxWidth;
+    }
+
+    //子项的宽度 = 文本宽度 + 附加宽度（内边距、CheckBox、图标等），附加宽度只与文本格式、CheckBox和图标有关：
+    //按这几个属性分组，每组只通过控件计算一次附加宽度，每个子项只需要测量文本宽度，无需设置控件属性
+    struct SubItemLayout
+    {
+        uint16_t nTextFormat = 0;
+        bool bShowCheckBox = false;
+        int32_t nImageId = -1;
+        uint32_t uTextStyle = 0;    //测量文本使用的文本格式
+        int32_t nExtraWidth = 0;    //附加宽度
+    };
+    std::vector<SubItemLayout> layoutList;
+    std::vector<size_t> layoutIndexs(subItemList.size(), Box::InvalidIndex);
+    const DString measureText = _T("0");
+    for (size_t nIndex = 0; nIndex < subItemList.size(); ++nIndex) {
+        const ListCtrlSubItemData2Ptr& pStorage = subItemList[nIndex];
         if (pStorage == nullptr) {
             continue;
         }
         if (pStorage->text.empty()) {
+            pStorage->nItemWidth = 0;
+            continue;
+        }
+        for (size_t nLayout = 0; nLayout < layoutList.size(); ++nLayout) {
+            const SubItemLayout& layout = layoutList[nLayout];
+            if ((layout.nTextFormat == pStorage->nTextFormat) &&
+                (layout.bShowCheckBox == pStorage->bShowCheckBox) &&
+                (layout.nImageId == pStorage->nImageId)) {
+                layoutIndexs[nIndex] = nLayout;
+                break;
+            }
+        }
+        if (layoutIndexs[nIndex] != Box::InvalidIndex) {
             continue;
         }
 
-        subItem.SetText(pStorage->text.c_str());
+        subItem.SetText(measureText);
         if (pStorage->nTextFormat != 0) {
             subItem.SetTextStyle(pStorage->nTextFormat, false);
         }
@@ -1072,16 +1115,84 @@ int32_t ListCtrlReportView::GetMaxDataItemWidth(const std::vector<ListCtrlSubIte
         subItem.SetFixedHeight(UiFixedInt::MakeAuto(), false, false);
         subItem.SetReEstimateSize(true);
         UiEstSize sz = subItem.EstimateSize(UiSize(0, 0));
-        nMaxWidth = std::max(nMaxWidth, sz.cx.GetInt32());
+
+        SubItemLayout layout;
+        layout.nTextFormat = pStorage->nTextFormat;
+        layout.bShowCheckBox = pStorage->bShowCheckBox;
+        layout.nImageId = pStorage->nImageId;
+        layout.uTextStyle = subItem.GetTextStyle();
+        layout.nExtraWidth = sz.cx.GetInt32() - pRender->MeasureString(measureText, pFont, layout.uTextStyle, INT_MAX).Width();
+        layoutIndexs[nIndex] = layoutList.size();
+        layoutList.push_back(layout);
+    }
+
+    //测量文本宽度
+    auto MeasureSubItems = [&subItemList, &layoutIndexs, &layoutList](IRender* pMeasureRender, IFont* pMeasureFont,
+                                                                      size_t nStartIndex, size_t nEndIndex) {
+            for (size_t nIndex = nStartIndex; nIndex < nEndIndex; ++nIndex) {
+                const size_t nLayout = layoutIndexs[nIndex];
+                if (nLayout >= layoutList.size()) {
+                    continue;
+                }
+                const SubItemLayout& layout = layoutList[nLayout];
+                const ListCtrlSubItemData2Ptr& pStorage = subItemList[nIndex];
+                int32_t nWidth = pMeasureRender->MeasureString(pStorage->text.c_str(), pMeasureFont, layout.uTextStyle, INT_MAX).Width();
+                if (nWidth > 0) {
+                    nWidth += layout.nExtraWidth;
+                }
+                pStorage->nItemWidth = std::max(nWidth, 0);
+            }
+        };
+
+    //数据量较大时，分块并行测量：每个任务使用独立的Render和字体对象（在UI线程中创建好），避免多线程共享
+    constexpr const size_t nMinItemsPerTask = 2048;
+    const size_t nItemCount = subItemList.size();
+    ParallelTaskRunner& taskRunner = ParallelTaskRunner::Instance();
+    size_t nTaskCount = std::min(taskRunner.GetConcurrency(), nItemCount / nMinItemsPerTask);
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    std::vector<std::unique_ptr<IRender>> renderList;
+    std::vector<std::unique_ptr<IFont>> fontList;
+    if ((nTaskCount > 1) && (pRenderFactory != nullptr)) {
+        UiFont fontInfo;
+        fontInfo.m_fontName = pFont->FontName();
+        fontInfo.m_fontSize = pFont->FontSize();
+        fontInfo.m_bBold = pFont->IsBold();
+        fontInfo.m_bUnderline = pFont->IsUnderline();
+        fontInfo.m_bItalic = pFont->IsItalic();
+        fontInfo.m_bStrikeOut = pFont->IsStrikeOut();
+        for (size_t nTask = 0; nTask < nTaskCount; ++nTask) {
+            std::unique_ptr<IRender> spRender(pRenderFactory->CreateRender(pWindow->GetRenderDpi()));
+            std::unique_ptr<IFont> spFont(pRenderFactory->CreateIFont());
+            if ((spRender == nullptr) || !spRender->Resize(1, 1) ||
+                (spFont == nullptr) || !spFont->InitFont(fontInfo)) {
+                break;
+            }
+            //预先测量一次，在UI线程中完成字体句柄的创建
+            spRender->MeasureString(measureText, spFont.get(), TEXT_SINGLELINE, INT_MAX);
+            renderList.push_back(std::move(spRender));
+            fontList.push_back(std::move(spFont));
+        }
+    }
+    if ((nTaskCount > 1) && (renderList.size() == nTaskCount)) {
+        const size_t nItemsPerTask = (nItemCount + nTaskCount - 1) / nTaskCount;
+        taskRunner.ParallelFor(nTaskCount, [&](size_t nTask) {
+                const size_t nStartIndex = nTask * nItemsPerTask;
+                const size_t nEndIndex = std::min(nStartIndex + nItemsPerTask, nItemCount);
+                MeasureSubItems(renderList[nTask].get(), fontList[nTask].get(), nStartIndex, nEndIndex);
+            });
+    }
+    else {
+        MeasureSubItems(pRender, pFont, 0, nItemCount);
     }
 
+    for (const ListCtrlSubItemData2Ptr& pStorage : subItemList) {
+        if (pStorage != nullptr) {
+            nMaxWidth = std::max(nMaxWidth, pStorage->nItemWidth);
+        }
+    }
     if (nMaxWidth <= 0) {
         nMaxWidth = -1;
     }
-    else {
-        //增加一点余量
-        nMaxWidth += Dpi().GetScaleInt(4);
-    }
     return nMaxWidth;
 }
 
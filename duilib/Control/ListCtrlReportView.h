@@ -189,9 +189,9 @@ protected:
                               const std::vector<ListCtrlSubItemData2Pair>& subItemList) override;
 
 
-    /** 获取某列的宽度最大值
+    /** 计算数据子项的显示宽度，计算结果同时保存在各个子项的宽度缓存中（nItemWidth）
     * @param [in] subItemList 数据子项（代表每一列的数据）
-    * @return 返回该列宽度的最大值，返回的是DPI自适应后的值； 如果失败返回-1
+    * @return 返回这些子项宽度的最大值，返回的是DPI自适应后的值； 如果失败返回-1
     */
     virtual int32_t GetMaxDataItemWidth(const std::vector<ListCtrlSubItemData2Ptr>& subItemList) override;
 
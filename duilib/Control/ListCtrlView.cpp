@@ -142,6 +142,22 @@ void ListCtrlView::PaintChild(IRender* pRender, const UiRect& rcPaint)
     PaintFrameSelection(pRender);
 }
 
+bool ListCtrlView::CanScrollBlit(std::vector<UiRect>& fixedRects) const
+{
+    if (m_bInMouseMove) {
+        //正在框选，框选的边框绘制在子控件之上
+        return false;
+    }
+    if (!BaseClass::CanScrollBlit(fixedRects)) {
+        return false;
+    }
+    if (m_nNormalItemTop > 0) {
+        const UiRect& rect = GetRect();
+        fixedRects.push_back(UiRect(rect.left, rect.top, rect.right, m_nNormalItemTop));
+    }
+    return true;
+}
+
 void ListCtrlView::AttachMouseEvents(Control* pListBoxItem)
 {
     ASSERT(pListBoxItem != nullptr);
@@ -118,6 +118,10 @@ protected:
     */
     void PaintFrameSelection(IRender* pRender);
 
+    /** 滚动时能否直接复制已经绘制的内容（表头和置顶的元素不随内容滚动）
+    */
+    virtual bool CanScrollBlit(std::vector<UiRect>& fixedRects) const override;
+
 protected:
     //鼠标消息（返回true：表示消息已处理；返回false：则表示消息未处理，需转发给父控件）
     virtual bool ButtonDown(const EventArgs& msg) override;
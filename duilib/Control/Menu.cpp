@@ -2,6 +2,7 @@
 #include "duilib/Core/Keyboard.h"
 #include "duilib/Utils/FilePathUtil.h"
 #include "duilib/Core/WindowCreateParam.h"
+#include "duilib/Core/GlobalManager.h"
 
 namespace ui {
 
@@ -65,7 +66,9 @@ Menu::Menu(Window* pParentWindow) :
     m_popupPosType(MenuPopupPosType::RIGHT_TOP),
     m_noFocus(false),
     m_pOwner(nullptr),
-    m_pListBox(nullptr)
+    m_pListBox(nullptr),
+    m_bPoolable(false),
+    m_bRecycling(false)
 {
     m_skinFolder = DString(_T("public/menu/"));
     m_submenuXml = DString(_T("submenu.xml"));
@@ -90,16 +93,27 @@ void Menu::ShowMenu(const DString& xml, const UiPoint& point, MenuPopupPosType p
 
     m_xml = xml;
     m_noFocus = noFocus;
+    if (pOwner != nullptr) {
+        //多级菜单的子菜单：菜单项由父菜单项管理，窗口不复用（复用的菜单窗口已按一级菜单初始化，不能用作子菜单）
+        ASSERT(!IsWindow());
+        m_bPoolable = false;
+    }
     m_pOwner = pOwner;
 
     Menu::GetMenuObserver().AddReceiver(this);
-    WindowCreateParam createWndParam;
-    createWndParam.m_dwStyle = kWS_POPUP;
-    createWndParam.m_dwExStyle = kWS_EX_TOPMOST | kWS_EX_LAYERED;
-    //设置初始位置，避免菜单初次显示时出现黑屏现象
-    createWndParam.m_nX = point.x;
-    createWndParam.m_nY = point.y;
-    CreateWnd(m_pParentWindow, createWndParam);
+    if (IsWindow()) {
+        //从窗口池中复用的菜单，窗口和控件已经创建
+        ASSERT(m_bPoolable);
+    }
+    else {
+        WindowCreateParam createWndParam;
+        createWndParam.m_dwStyle = kWS_POPUP;
+        createWndParam.m_dwExStyle = kWS_EX_TOPMOST | kWS_EX_LAYERED;
+        //设置初始位置，避免菜单初次显示时出现黑屏现象
+        createWndParam.m_nX = point.x;
+        createWndParam.m_nY = point.y;
+        CreateWnd(m_pParentWindow, createWndParam);
+    }
     
     bool bShown = false;
     if (m_pOwner) {
@@ -156,10 +170,124 @@ void Menu::ShowMenu(const DString& xml, const UiPoint& point, MenuPopupPosType p
 
 void Menu::CloseMenu()
 {
+    if (m_bPoolable && (m_pOwner == nullptr) && IsWindow() && !IsClosingWnd()) {
+        //可复用的菜单：立即隐藏，避免连续操作时相互干扰；当前可能正在广播关闭消息，所以延迟放入窗口池
+        if (!m_bRecycling) {
+            m_bRecycling = true;
+            ShowWindow(kSW_HIDE);
+            GlobalManager::Instance().Thread().PostTask(kThreadUI, ToWeakCallback([this]() {
+                    RecycleMenu();
+                }));
+        }
+        return;
+    }
     //立即关闭，避免连续操作时相互干扰
     CloseWnd();
 }
 
+void Menu::SetPoolable(bool bPoolable)
+{
+    m_bPoolable = bPoolable;
+}
+
+bool Menu::IsPoolable() const
+{
+    return m_bPoolable;
+}
+
+DString Menu::GetPoolKey(const DString& skinFolder, const DString& xml)
+{
+    return _T("Menu:") + skinFolder + _T("|") + xml;
+}
+
+Menu* Menu::CreatePoolableMenu(Window* pParentWindow, const DString& skinFolder, const DString& xml)
+{
+    Window* pWindow = GlobalManager::Instance().Pool().TakeWindow(GetPoolKey(skinFolder, xml), pParentWindow);
+    Menu* pMenu = dynamic_cast<Menu*>(pWindow);
+    if (pMenu == nullptr) {
+        if (pWindow != nullptr) {
+            pWindow->CloseWnd();
+        }
+        pMenu = new Menu(pParentWindow);
+        pMenu->SetSkinFolder(skinFolder);
+        pMenu->SetPoolable(true);
+    }
+    return pMenu;
+}
+
+bool Menu::PrewarmMenu(Window* pParentWindow, const DString& skinFolder, const DString& xml)
+{
+    Menu* pMenu = new Menu(pParentWindow);
+    pMenu->SetSkinFolder(skinFolder);
+    pMenu->SetPoolable(true);
+    pMenu->m_xml = xml;
+    WindowCreateParam createWndParam;
+    createWndParam.m_dwStyle = kWS_POPUP;
+    createWndParam.m_dwExStyle = kWS_EX_TOPMOST | kWS_EX_LAYERED;
+    if (!pMenu->CreateWnd(pParentWindow, createWndParam)) {
+        delete pMenu;
+        return false;
+    }
+    if (!GlobalManager::Instance().Pool().AddWindow(GetPoolKey(skinFolder, xml), pMenu)) {
+        pMenu->CloseWnd();
+        return false;
+    }
+    return true;
+}
+
+void Menu::RecycleMenu()
+{
+    m_bRecycling = false;
+    RemoveObserver();
+    if (IsWindowVisible() || IsClosingWnd()) {
+        //期间又被显示或者关闭了
+        return;
+    }
+    ListBox* pLayoutListBox = Menu::GetLayoutListBox();
+    if (pLayoutListBox != nullptr) {
+        pLayoutListBox->SelectItem(Box::InvalidIndex, false, false);
+    }
+    ResetControls();
+    if (!GlobalManager::Instance().Pool().AddWindow(GetPoolKey(m_skinFolder.c_str(), m_xml.c_str()), this)) {
+        CloseWnd();
+    }
+}
+
+void Menu::SaveEventBaseline(Control* pControl)
+{
+    if (pControl == nullptr) {
+        return;
+    }
+    EventBaseline baseline;
+    baseline.m_pControl = pControl;
+    baseline.m_controlFlag = pControl->GetWeakFlag();
+    pControl->GetEventCallbackCounts(baseline.m_callbackCounts);
+    m_eventBaselines.push_back(std::move(baseline));
+
+    Box* pBox = dynamic_cast<Box*>(pControl);
+    if (pBox != nullptr) {
+        const size_t nItemCount = pBox->GetItemCount();
+        for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+            SaveEventBaseline(pBox->GetItemAt(nIndex));
+        }
+    }
+}
+
+void Menu::ResetControls()
+{
+    //只移除菜单弹出后通过Attach系列函数挂载的事件，布局和控件初始化时挂载的事件保留
+    for (const EventBaseline& baseline : m_eventBaselines) {
+        if (baseline.m_controlFlag.expired()) {
+            continue;
+        }
+        Control* pControl = baseline.m_pControl;
+        pControl->RestoreEventCallbackCounts(baseline.m_callbackCounts);
+        if (pControl->IsEnabled()) {
+            pControl->SetState(kControlStateNormal);
+        }
+    }
+}
+
 void Menu::DetachOwner()
 {
     if (m_pOwner != nullptr) {
@@ -518,6 +646,12 @@ void Menu::PostInitWindow()
 
     //需要在最后才调用基类的实现函数
     BaseClass::PostInitWindow();
+
+    if (m_bPoolable && (m_pOwner == nullptr)) {
+        //记录初始化完成时各控件的事件，放入窗口池前据此移除运行时挂载的事件
+        m_eventBaselines.clear();
+        SaveEventBaseline(GetRoot());
+    }
 }
 
 ListBox* Menu::GetLayoutListBox() const
@@ -532,6 +666,14 @@ void Menu::OnCloseWindow()
     BaseClass::OnCloseWindow();
 }
 
+void Menu::OnFinalMessage()
+{
+    if (m_bPoolable) {
+        GlobalManager::Instance().Pool().RemoveWindow(this);
+    }
+    BaseClass::OnFinalMessage();
+}
+
 bool Menu::AddMenuItem(MenuItem* pMenuItem)
 {
     //目前只有一级菜单可以访问这个接口
@@ -88,10 +88,40 @@ public:
                   bool noFocus = false,
                   MenuItem* pOwner = nullptr);
 
-    /** 关闭菜单
+    /** 关闭菜单（可复用的菜单只隐藏窗口，然后放入窗口池）
     */
     void CloseMenu();
 
+public:
+    /** 设置菜单窗口是否可以复用：关闭时不销毁窗口，而是隐藏后放入窗口池（GlobalManager::Pool()），
+    *   下次通过CreatePoolableMenu弹出相同的菜单时直接复用，不再创建窗口和解析XML
+    *   复用前，会移除窗口初始化完成后通过Attach系列函数挂载的事件，并恢复菜单项的状态；但动态添加的菜单项（含其事件）和修改过的属性会保留
+    *   多级菜单的子菜单不能复用
+    * @param [in] bPoolable true表示可以复用
+    */
+    void SetPoolable(bool bPoolable);
+
+    /** 菜单窗口是否可以复用
+    */
+    bool IsPoolable() const;
+
+    /** 创建可复用的菜单：如果窗口池中有相同的菜单，直接返回该菜单，否则创建新的菜单
+    *   返回后，按常规方式调用ShowMenu显示菜单
+    * @param [in] pParentWindow 菜单的父窗口
+    * @param [in] skinFolder 资源加载的文件夹名称，参见SetSkinFolder
+    * @param [in] xml 菜单XML资源文件名，与调用ShowMenu时的参数相同
+    */
+    static Menu* CreatePoolableMenu(Window* pParentWindow, const DString& skinFolder, const DString& xml);
+
+    /** 预先创建可复用的菜单（创建窗口和控件，但不显示），放入窗口池，以缩短菜单首次弹出的时间
+    *   可在程序启动后空闲时调用
+    * @param [in] pParentWindow 菜单的父窗口
+    * @param [in] skinFolder 资源加载的文件夹名称，参见SetSkinFolder
+    * @param [in] xml 菜单XML资源文件名
+    * @return 成功放入窗口池返回true
+    */
+    static bool PrewarmMenu(Window* pParentWindow, const DString& skinFolder, const DString& xml);
+
 public:
     //添加子菜单项
     bool AddMenuItem(MenuItem* pMenuItem);
@@ -128,6 +158,22 @@ private:
     */
     ListBox* GetLayoutListBox() const;
 
+    /** 获取菜单在窗口池中的标识
+    */
+    static DString GetPoolKey(const DString& skinFolder, const DString& xml);
+
+    /** 可复用的菜单隐藏后，恢复状态并放入窗口池
+    */
+    void RecycleMenu();
+
+    /** 记录控件（含子控件）当前的事件回调函数个数
+    */
+    void SaveEventBaseline(Control* pControl);
+
+    /** 放入窗口池前，移除窗口初始化完成后挂载的事件，并恢复控件的状态
+    */
+    void ResetControls();
+
 private:
 
     virtual bool Receive(ContextMenuParam param) override;
@@ -137,6 +183,7 @@ private:
     virtual DString GetSkinFile() override;
     virtual void PostInitWindow() override;
     virtual void OnCloseWindow() override;
+    virtual void OnFinalMessage() override;
 
     /** 窗口失去焦点(WM_KILLFOCUS)
     * @param [in] pSetFocusWindow 接收键盘焦点的窗口（可以为nullptr）
@@ -193,6 +240,21 @@ private:
     ListBox* m_pListBox;
     std::weak_ptr<WeakFlag> m_listBoxFlag;
 
+    //菜单窗口是否可以复用
+    bool m_bPoolable;
+
+    //菜单已经隐藏，等待放入窗口池
+    bool m_bRecycling;
+
+    //窗口初始化完成时控件的事件回调函数个数
+    struct EventBaseline
+    {
+        Control* m_pControl = nullptr;
+        std::weak_ptr<WeakFlag> m_controlFlag;
+        EventHandlerTable::CallbackCounts m_callbackCounts;
+    };
+    std::vector<EventBaseline> m_eventBaselines;
+
 };
 
 /** 菜单项
@@ -354,6 +354,10 @@ protected:
     */
     void PaintGridLines(IRender* pRender);
 
+    /** 网格线绘制在子控件之上
+    */
+    virtual bool HasChildOverlay() const override { return true; }
+
     /** 拖动列表头改变列宽的事件响应函数
     */
     void OnHeaderColumnResized();
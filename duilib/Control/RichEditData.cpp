@@ -1,9 +1,20 @@
 #include "RichEditData.h"
+#include "duilib/Core/GlobalManager.h"
 #include "duilib/Utils/PerformanceUtil.h"
 #include <unordered_set>
+#include <chrono>
 
 namespace ui
 {
+//物理行数达到该值时，启用延迟计算：只同步计算可见区域附近的行，其余的行在空闲时分批计算
+constexpr const size_t kLazyLayoutMinLines = 5000;
+//延迟计算时，每批计算的物理行数
+constexpr const size_t kLazyLayoutChunkLines = 500;
+//与已计算区域的距离（物理行数）超过该值时，不再逐批扩展，而是在目标位置附近重新计算
+constexpr const size_t kLazyLayoutRelocateLines = 2000;
+//空闲时每次连续计算的时间上限（毫秒）
+constexpr const int64_t kLazyLayoutSliceMs = 8;
+
 RichEditData::RichEditData(IRichTextData* pRichTextData):
     m_pRichText(pRichTextData),
     m_hAlignType(HorAlignType::kHorAlignLeft),
@@ -12,6 +23,14 @@ RichEditData::RichEditData(IRichTextData* pRichTextData):
     m_pRender(nullptr),
     m_pRenderFactory(nullptr),
     m_bCacheDirty(true),
+    m_bLazyLayout(false),
+    m_nLayoutStartLine(0),
+    m_nLayoutEndLine(0),
+    m_nLayoutTopOffset(0),
+    m_fLayoutLineHeight(0),
+    m_nLayoutAnchorLine((size_t)-1),
+    m_nLayoutAnchorTop(0),
+    m_bInLazyLayoutUpdate(false),
     m_nUndoLimit(64),
     m_bTextRectYOffsetUpdated(false),
     m_bTextRectXOffsetUpdated(false)
@@ -172,8 +191,8 @@ UiRect RichEditData::EstimateTextDisplayBounds(const UiRect& rcAvailable)
     }
 
     UiRect rcDrawRect = m_pRichText->GetRichTextDrawRect();
-    if (rcAvailable.Width() == rcDrawRect.Width()) {
-        //检查并计算字符位置
+    if ((rcAvailable.Width() == rcDrawRect.Width()) || IsLazyLayoutEnabled()) {
+        //检查并计算字符位置（行数较多时，不再完整计算，使用延迟计算的估算值）
         CheckCalcTextRects();
         rect = GetTextRect();
     }
@@ -310,6 +329,10 @@ void RichEditData::UpdateRowTextOffsetX(RichTextLineInfoList& lineTextInfo, HorA
 
 int32_t RichEditData::GetTextRectOfssetY() const
 {
+    if (m_bLazyLayout) {
+        //延迟计算时，绘制缓存从已计算区域的起始位置开始
+        return m_nLayoutTopOffset;
+    }
     int32_t yOffset = 0;
     if (m_rcTextRect.Height() < m_rcTextDrawRect.Height()) {
         VerAlignType vAlignType = GetVAlignType();
@@ -344,12 +367,31 @@ void RichEditData::CheckCalcTextRects()
         CalcTextRects();
         SetCacheDirty(false);
         m_pRichText->OnTextRectsChanged();
+        ScheduleLazyLayout();
+    }
+    else if (m_bLazyLayout && !m_bInLazyLayoutUpdate) {
+        //延迟计算：检查可见区域内的行是否已经计算
+        int32_t nOffsetY = 0;
+        if (EnsureViewportLayout(nOffsetY)) {
+            OnLazyLayoutUpdated(nOffsetY);
+        }
     }
 }
 
 void RichEditData::CalcTextRects()
 {
-    PerformanceStat statPerformance(_T("RichEditData::CalcTextRects"));
+    static const PerformanceStatId s_statId(_T("RichEditData::CalcTextRects"));
+    PerformanceStat statPerformance(s_statId);
+    if (m_bLazyLayout && (m_nLayoutAnchorLine == (size_t)-1) && (m_nLayoutEndLine <= m_lineTextInfo.size())) {
+        //延迟计算时，记录可见区域的起始行，使重新计算后可见区域的内容保持不变
+        m_nLayoutAnchorLine = EstimateLineFromY(m_szScrollOffset.cy);
+        m_nLayoutAnchorTop = EstimateLineTop(m_nLayoutAnchorLine);
+    }
+    const size_t nAnchorLine = m_nLayoutAnchorLine;
+    const int32_t nAnchorTop = m_nLayoutAnchorTop;
+    m_nLayoutAnchorLine = (size_t)-1;
+    ResetLazyLayout();
+
     //清空所有行的缓存数据
     for (RichTextLineInfoPtr& pLineInfo : m_lineTextInfo) {
         ASSERT(pLineInfo != nullptr);
@@ -392,6 +434,27 @@ void RichEditData::CalcTextRects()
         m_bTextRectYOffsetUpdated = false;
         return;
     }
+    if (IsLazyLayoutEnabled()) {
+        //行数较多：只计算可见区域附近的行，其余的行按平均行高估算，在空闲时分批计算
+        m_spDrawRichTextCache.reset();
+        SetTextDrawRect(rcDrawText, false);
+        m_bLazyLayout = true;
+        m_bTextRectYOffsetUpdated = false;
+        if (m_fLayoutLineHeight < 1.0f) {
+            m_fLayoutLineHeight = (float)std::max(m_pRichText->GetTextRowHeight(), 1);
+        }
+        if (nAnchorLine < m_lineTextInfo.size()) {
+            RelayoutAroundLine(nAnchorLine, std::max(nAnchorTop, 0));
+        }
+        else {
+            const size_t nLine = std::min((size_t)(std::max(m_szScrollOffset.cy, 0) / m_fLayoutLineHeight), m_lineTextInfo.size() - 1);
+            RelayoutAroundLine(nLine, (int32_t)(nLine * m_fLayoutLineHeight));
+        }
+        int32_t nOffsetY = 0;
+        EnsureViewportLayout(nOffsetY);
+        UpdateLazyTextRect();
+        return;
+    }
     //估算的时候，滚动条位置始终为(0,0)
     UiSize szScrollOffset;
     RichTextLineInfoParam lineInfoParam;
@@ -438,12 +501,523 @@ void RichEditData::CalcTextRects()
     UpdateRowTextOffsetX(m_lineTextInfo, GetHAlignType(), m_rowXOffset, m_bTextRectXOffsetUpdated);
 }
 
+void RichEditData::GetTextViewForDraw(std::vector<std::wstring_view>& textView) const
+{
+    if (!m_bLazyLayout) {
+        GetTextView(textView);
+        return;
+    }
+    ASSERT(m_nLayoutEndLine <= m_lineTextInfo.size());
+    const size_t nEndLine = std::min(m_nLayoutEndLine, m_lineTextInfo.size());
+    textView.reserve(textView.size() + (nEndLine - std::min(m_nLayoutStartLine, nEndLine)));
+    for (size_t nIndex = m_nLayoutStartLine; nIndex < nEndLine; ++nIndex) {
+        const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
+        ASSERT(lineText.m_nLineTextLen > 0);
+        if (lineText.m_nLineTextLen > 0) {
+            textView.push_back(std::wstring_view(lineText.m_lineText.data(), lineText.m_nLineTextLen));
+        }
+    }
+}
+
+bool RichEditData::IsLazyLayoutPending() const
+{
+    return m_bLazyLayout;
+}
+
+bool RichEditData::IsLazyLayoutEnabled() const
+{
+    return !m_bSingleLineMode && !m_pRichText->IsTextPasswordMode() && (m_lineTextInfo.size() >= kLazyLayoutMinLines);
+}
+
+void RichEditData::ResetLazyLayout()
+{
+    m_layoutTaskFlag.Cancel();
+    m_bLazyLayout = false;
+    m_nLayoutStartLine = 0;
+    m_nLayoutEndLine = 0;
+    m_nLayoutTopOffset = 0;
+}
+
+void RichEditData::CompleteLayout()
+{
+    CheckCalcTextRects();
+    if (!m_bLazyLayout) {
+        return;
+    }
+    static const PerformanceStatId s_statId(_T("RichEditData::CompleteLayout"));
+    PerformanceStat statPerformance(s_statId);
+    int32_t nOffsetY = 0;
+    bool bChanged = ExtendLayoutDown(m_lineTextInfo.size() - m_nLayoutEndLine);
+    if (ExtendLayoutUp(m_nLayoutStartLine, nOffsetY)) {
+        bChanged = true;
+    }
+    if (bChanged) {
+        OnLazyLayoutUpdated(nOffsetY);
+    }
+}
+
+bool RichEditData::MeasureLayoutLines(size_t nStartLine, size_t nEndLine, size_t nStartRowIndex,
+                                      std::shared_ptr<DrawRichTextCache>& spDrawRichTextCache)
+{
+    ASSERT((nStartLine < nEndLine) && (nEndLine <= m_lineTextInfo.size()));
+    if ((nStartLine >= nEndLine) || (nEndLine > m_lineTextInfo.size())) {
+        return false;
+    }
+    if ((m_pRender == nullptr) || (m_pRenderFactory == nullptr)) {
+        return false;
+    }
+    //只生成这些行的绘制数据，每行一条数据
+    std::vector<std::wstring_view> textView;
+    textView.reserve(nEndLine - nStartLine);
+    for (size_t nIndex = nStartLine; nIndex < nEndLine; ++nIndex) {
+        RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
+        lineText.m_rowInfo.clear();
+        textView.push_back(std::wstring_view(lineText.m_lineText.data(), lineText.m_nLineTextLen));
+    }
+    std::vector<RichTextData> richTextDataList;
+    m_pRichText->GetRichTextForDraw(textView, richTextDataList);
+    if (richTextDataList.empty()) {
+        return false;
+    }
+    //估算的时候，滚动条位置始终为(0,0)
+    UiSize szScrollOffset;
+    RichTextLineInfoParam lineInfoParam;
+    lineInfoParam.m_nStartLineIndex = (uint32_t)nStartLine;
+    lineInfoParam.m_nStartRowIndex = (uint32_t)nStartRowIndex;
+    lineInfoParam.m_pLineInfoList = &m_lineTextInfo;
+    m_pRender->MeasureRichText3(m_pRichText->GetRichTextDrawRect(), szScrollOffset, m_pRenderFactory, richTextDataList, &lineInfoParam, spDrawRichTextCache, nullptr);
+    return true;
+}
+
+float RichEditData::PlaceLayoutRows(size_t nStartLine, size_t nEndLine, float fTop)
+{
+    for (size_t nLine = nStartLine; nLine < nEndLine; ++nLine) {
+        for (RichTextRowInfoPtr& spRowInfo : m_lineTextInfo[nLine]->m_rowInfo) {
+            UiRectF& rowRect = spRowInfo->m_rowRect;
+            const float fRowHeight = rowRect.Height();
+            rowRect.top = fTop;
+            rowRect.bottom = rowRect.top + fRowHeight;
+            fTop = rowRect.bottom;
+        }
+    }
+    return fTop;
+}
+
+size_t RichEditData::GetLayoutRowCount(size_t nStartLine, size_t nEndLine) const
+{
+    size_t nRowCount = 0;
+    for (size_t nLine = nStartLine; nLine < nEndLine; ++nLine) {
+        nRowCount += m_lineTextInfo[nLine]->m_rowInfo.size();
+    }
+    return nRowCount;
+}
+
+float RichEditData::GetLayoutBottom() const
+{
+    for (size_t nLine = m_nLayoutEndLine; nLine > m_nLayoutStartLine; --nLine) {
+        const RichTextLineInfo& lineInfo = *m_lineTextInfo[nLine - 1];
+        if (!lineInfo.m_rowInfo.empty()) {
+            return lineInfo.m_rowInfo.back()->m_rowRect.bottom;
+        }
+    }
+    return (float)m_nLayoutTopOffset;
+}
+
+void RichEditData::UpdateLayoutLineHeight()
+{
+    if (m_nLayoutEndLine > m_nLayoutStartLine) {
+        const float fHeight = GetLayoutBottom() - (float)m_nLayoutTopOffset;
+        if (fHeight > 0) {
+            m_fLayoutLineHeight = fHeight / (m_nLayoutEndLine - m_nLayoutStartLine);
+        }
+    }
+    if (m_fLayoutLineHeight < 1.0f) {
+        m_fLayoutLineHeight = 1.0f;
+    }
+}
+
+void RichEditData::MergeLayoutCache(size_t nStartLine, size_t nEndLine, size_t nRowCount,
+                                    const std::shared_ptr<DrawRichTextCache>& spLinesCache)
+{
+    if (m_spDrawRichTextCache == nullptr) {
+        //绘制时按已计算区域重新生成
+        return;
+    }
+    std::vector<std::wstring_view> textView;
+    GetTextViewForDraw(textView);
+    std::vector<RichTextData> richTextDataList;
+    m_pRichText->GetRichTextForDraw(textView, richTextDataList);
+
+    //绘制缓存中的坐标，相对于已计算区域的起始位置
+    std::vector<int32_t> rowRectTopList;
+    rowRectTopList.reserve(GetLayoutRowCount(m_nLayoutStartLine, m_nLayoutEndLine));
+    for (size_t nLine = m_nLayoutStartLine; nLine < m_nLayoutEndLine; ++nLine) {
+        for (const RichTextRowInfoPtr& spRowInfo : m_lineTextInfo[nLine]->m_rowInfo) {
+            rowRectTopList.push_back((int32_t)spRowInfo->m_rowRect.top - m_nLayoutTopOffset);
+        }
+    }
+    //新计算的行在原缓存中没有数据：同时作为修改的行和删除的行传入，物理行号保持不变，只更新逻辑行号和目标区域
+    std::vector<size_t> lines;
+    lines.reserve(nEndLine - nStartLine);
+    for (size_t nLine = nStartLine; nLine < nEndLine; ++nLine) {
+        lines.push_back(nLine);
+    }
+    if (!m_pRender->UpdateDrawRichTextCache(m_spDrawRichTextCache, spLinesCache, richTextDataList,
+                                            nStartLine, lines, nRowCount, lines, 0, rowRectTopList)) {
+        m_spDrawRichTextCache.reset();
+    }
+}
+
+int32_t RichEditData::RelayoutAroundLine(size_t nAnchorLine, int32_t nAnchorTop)
+{
+    const size_t nLineCount = m_lineTextInfo.size();
+    ASSERT(nAnchorLine < nLineCount);
+    if (nAnchorLine >= nLineCount) {
+        return 0;
+    }
+    //放弃当前已计算的区域
+    const size_t nOldEndLine = std::min(m_nLayoutEndLine, nLineCount);
+    for (size_t nLine = m_nLayoutStartLine; nLine < nOldEndLine; ++nLine) {
+        m_lineTextInfo[nLine]->m_rowInfo.clear();
+    }
+    m_spDrawRichTextCache.reset();
+
+    //定位行的上方保留少量的行，向上滚动时可以直接显示
+    const size_t nStartLine = (nAnchorLine > (kLazyLayoutChunkLines / 4)) ? (nAnchorLine - kLazyLayoutChunkLines / 4) : 0;
+    const size_t nEndLine = std::min(nLineCount, nStartLine + kLazyLayoutChunkLines);
+    m_nLayoutStartLine = nStartLine;
+    m_nLayoutEndLine = nStartLine;
+    m_nLayoutTopOffset = nAnchorTop;
+    std::shared_ptr<DrawRichTextCache> spDrawRichTextCache;
+    if (!MeasureLayoutLines(nStartLine, nEndLine, 0, spDrawRichTextCache)) {
+        return 0;
+    }
+    m_nLayoutEndLine = nEndLine;
+
+    const float fAnchorOffset = PlaceLayoutRows(nStartLine, nAnchorLine, 0.0f);
+    int32_t nTopOffset = nAnchorTop - (int32_t)fAnchorOffset;
+    int32_t nOffsetY = 0;
+    if ((nStartLine == 0) || (nTopOffset < 0)) {
+        //首行的纵坐标必须为0，且已计算区域不能超出文本区域的顶部
+        nOffsetY = -nTopOffset;
+        nTopOffset = 0;
+    }
+    m_nLayoutTopOffset = nTopOffset;
+    PlaceLayoutRows(nStartLine, nEndLine, (float)nTopOffset);
+    m_spDrawRichTextCache = spDrawRichTextCache;
+    UpdateLayoutLineHeight();
+    return nOffsetY;
+}
+
+bool RichEditData::ExtendLayoutDown(size_t nLineCount)
+{
+    const size_t nStartLine = m_nLayoutEndLine;
+    const size_t nEndLine = std::min(m_lineTextInfo.size(), nStartLine + nLineCount);
+    if (nStartLine >= nEndLine) {
+        return false;
+    }
+    const size_t nStartRowIndex = GetLayoutRowCount(m_nLayoutStartLine, m_nLayoutEndLine);
+    const float fTop = GetLayoutBottom();
+    std::shared_ptr<DrawRichTextCache> spLinesCache;
+    if (!MeasureLayoutLines(nStartLine, nEndLine, nStartRowIndex, spLinesCache)) {
+        return false;
+    }
+    PlaceLayoutRows(nStartLine, nEndLine, fTop);
+    m_nLayoutEndLine = nEndLine;
+    MergeLayoutCache(nStartLine, nEndLine, GetLayoutRowCount(nStartLine, nEndLine), spLinesCache);
+    UpdateLayoutLineHeight();
+    return true;
+}
+
+bool RichEditData::ExtendLayoutUp(size_t nLineCount, int32_t& nOffsetY)
+{
+    const size_t nEndLine = m_nLayoutStartLine;
+    const size_t nStartLine = (nEndLine > nLineCount) ? (nEndLine - nLineCount) : 0;
+    if (nStartLine >= nEndLine) {
+        return false;
+    }
+    std::shared_ptr<DrawRichTextCache> spLinesCache;
+    if (!MeasureLayoutLines(nStartLine, nEndLine, 0, spLinesCache)) {
+        return false;
+    }
+    //新计算的行放在已计算区域的上方，已计算区域的位置保持不变
+    const float fHeight = PlaceLayoutRows(nStartLine, nEndLine, 0.0f);
+    const int32_t nNewTopOffset = m_nLayoutTopOffset - (int32_t)ui::CEILF(fHeight);
+    int32_t nTopOffset = nNewTopOffset;
+    if (nStartLine == 0) {
+        nTopOffset = 0;
+    }
+    else if (nTopOffset < 0) {
+        nTopOffset = (int32_t)(nStartLine * m_fLayoutLineHeight);
+    }
+    if (nTopOffset != nNewTopOffset) {
+        //估算的高度有偏差，整体平移已计算区域
+        const float fOffsetY = (float)(nTopOffset - nNewTopOffset);
+        for (size_t nLine = nEndLine; nLine < m_nLayoutEndLine; ++nLine) {
+            for (RichTextRowInfoPtr& spRowInfo : m_lineTextInfo[nLine]->m_rowInfo) {
+                spRowInfo->m_rowRect.Offset(0.0f, fOffsetY);
+            }
+        }
+        nOffsetY += nTopOffset - nNewTopOffset;
+    }
+    PlaceLayoutRows(nStartLine, nEndLine, (float)nTopOffset);
+    m_nLayoutStartLine = nStartLine;
+    m_nLayoutTopOffset = nTopOffset;
+    MergeLayoutCache(nStartLine, nEndLine, GetLayoutRowCount(nStartLine, nEndLine), spLinesCache);
+    UpdateLayoutLineHeight();
+    return true;
+}
+
+bool RichEditData::EnsureLineLayout(size_t nLineNumber, int32_t& nOffsetY)
+{
+    const size_t nLineCount = m_lineTextInfo.size();
+    if (!m_bLazyLayout || (nLineNumber >= nLineCount)) {
+        return false;
+    }
+    //相邻的行也需要计算（光标上下移动时使用）
+    const size_t nFirstLine = (nLineNumber > 0) ? (nLineNumber - 1) : 0;
+    const size_t nLastLine = std::min(nLineNumber + 2, nLineCount);
+    if ((nFirstLine >= m_nLayoutStartLine) && (nLastLine <= m_nLayoutEndLine)) {
+        return false;
+    }
+    if ((nFirstLine >= m_nLayoutStartLine) && ((nLastLine - m_nLayoutEndLine) <= kLazyLayoutRelocateLines)) {
+        return ExtendLayoutDown(std::max(nLastLine - m_nLayoutEndLine, kLazyLayoutChunkLines / 4));
+    }
+    if ((nLastLine <= m_nLayoutEndLine) && ((m_nLayoutStartLine - nFirstLine) <= kLazyLayoutRelocateLines)) {
+        return ExtendLayoutUp(std::max(m_nLayoutStartLine - nFirstLine, kLazyLayoutChunkLines / 4), nOffsetY);
+    }
+    //距离较远，使用估算值（滚动到该位置时再计算）
+    return false;
+}
+
+bool RichEditData::EnsureViewportLayout(int32_t& nOffsetY)
+{
+    const size_t nLineCount = m_lineTextInfo.size();
+    const int32_t nViewHeight = m_rcTextDrawRect.Height();
+    bool bChanged = false;
+    //估算的行高有偏差时，一次扩展后可能仍未覆盖可见区域
+    for (int32_t nRetry = 0; (nRetry < 4) && m_bLazyLayout; ++nRetry) {
+        //已计算区域有调整时，滚动条位置会同步调整
+        const int32_t nViewTop = std::max(m_szScrollOffset.cy + nOffsetY, 0);
+        const int32_t nViewBottom = nViewTop + nViewHeight;
+        const float fLayoutBottom = GetLayoutBottom();
+        if ((nViewBottom > fLayoutBottom) && (m_nLayoutEndLine < nLineCount)) {
+            const size_t nTopLine = EstimateLineFromY(nViewTop);
+            if ((nViewTop < fLayoutBottom) || ((nTopLine - m_nLayoutEndLine) <= kLazyLayoutRelocateLines)) {
+                const size_t nBottomLine = EstimateLineFromY(nViewBottom);
+                if (!ExtendLayoutDown(std::max(nBottomLine + 1 - m_nLayoutEndLine, kLazyLayoutChunkLines))) {
+                    break;
+                }
+            }
+            else {
+                nOffsetY += RelayoutAroundLine(nTopLine, EstimateLineTop(nTopLine));
+            }
+        }
+        else if ((nViewTop < m_nLayoutTopOffset) && (m_nLayoutStartLine > 0)) {
+            const size_t nTopLine = EstimateLineFromY(nViewTop);
+            const size_t nBottomLine = EstimateLineFromY(nViewBottom);
+            if ((nViewBottom > m_nLayoutTopOffset) || ((m_nLayoutStartLine - nBottomLine) <= kLazyLayoutRelocateLines)) {
+                if (!ExtendLayoutUp(std::max(m_nLayoutStartLine - nTopLine, kLazyLayoutChunkLines), nOffsetY)) {
+                    break;
+                }
+            }
+            else {
+                nOffsetY += RelayoutAroundLine(nTopLine, EstimateLineTop(nTopLine));
+            }
+        }
+        else {
+            break;
+        }
+        bChanged = true;
+    }
+    return bChanged;
+}
+
+int32_t RichEditData::EstimateLineTop(size_t nLineNumber) const
+{
+    if (nLineNumber < m_nLayoutStartLine) {
+        //上方未计算的行，按比例分配已计算区域上方的高度
+        return (int32_t)((int64_t)m_nLayoutTopOffset * (int64_t)nLineNumber / (int64_t)m_nLayoutStartLine);
+    }
+    if (nLineNumber < m_nLayoutEndLine) {
+        const RichTextLineInfo& lineInfo = *m_lineTextInfo[nLineNumber];
+        if (!lineInfo.m_rowInfo.empty()) {
+            return (int32_t)lineInfo.m_rowInfo.front()->m_rowRect.top;
+        }
+    }
+    const size_t nEndLine = std::max(m_nLayoutEndLine, m_nLayoutStartLine);
+    const size_t nBelowLines = (nLineNumber > nEndLine) ? (nLineNumber - nEndLine) : 0;
+    return (int32_t)(GetLayoutBottom() + nBelowLines * m_fLayoutLineHeight);
+}
+
+size_t RichEditData::EstimateLineFromY(int32_t y) const
+{
+    const size_t nLineCount = m_lineTextInfo.size();
+    if (nLineCount == 0) {
+        return 0;
+    }
+    if (y < m_nLayoutTopOffset) {
+        if ((y <= 0) || (m_nLayoutTopOffset <= 0)) {
+            return 0;
+        }
+        return (size_t)((int64_t)y * (int64_t)m_nLayoutStartLine / (int64_t)m_nLayoutTopOffset);
+    }
+    const float fLayoutBottom = GetLayoutBottom();
+    if (y < fLayoutBottom) {
+        for (size_t nLine = m_nLayoutStartLine; nLine < m_nLayoutEndLine; ++nLine) {
+            const RichTextLineInfo& lineInfo = *m_lineTextInfo[nLine];
+            if (!lineInfo.m_rowInfo.empty() && (y < lineInfo.m_rowInfo.back()->m_rowRect.bottom)) {
+                return nLine;
+            }
+        }
+    }
+    const size_t nLine = m_nLayoutEndLine + (size_t)((y - fLayoutBottom) / m_fLayoutLineHeight);
+    return std::min(nLine, nLineCount - 1);
+}
+
+bool RichEditData::EstimateCharPos(int32_t nCharIndex, UiPoint& pt) const
+{
+    if (!m_bLazyLayout || (nCharIndex < 0)) {
+        return false;
+    }
+    const size_t nLineNumber = GetCharLineNumber(nCharIndex);
+    if ((nLineNumber >= m_nLayoutStartLine) && (nLineNumber < m_nLayoutEndLine)) {
+        return false;
+    }
+    pt.x = 0;
+    pt.y = EstimateLineTop(nLineNumber);
+    return true;
+}
+
+size_t RichEditData::GetCharLineNumber(int32_t nCharIndex) const
+{
+    size_t nTextLen = 0;
+    const size_t nLineCount = m_lineTextInfo.size();
+    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+        nTextLen += m_lineTextInfo[nIndex]->m_nLineTextLen;
+        if ((size_t)nCharIndex < nTextLen) {
+            return nIndex;
+        }
+    }
+    return (nLineCount > 0) ? (nLineCount - 1) : 0;
+}
+
+size_t RichEditData::GetLineStartCharIndex(size_t nLineNumber) const
+{
+    size_t nTextLen = 0;
+    const size_t nLineCount = std::min(nLineNumber, m_lineTextInfo.size());
+    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+        nTextLen += m_lineTextInfo[nIndex]->m_nLineTextLen;
+    }
+    return nTextLen;
+}
+
+void RichEditData::CheckCalcCharRects(int32_t nCharIndex)
+{
+    CheckCalcTextRects();
+    if (m_bLazyLayout && !m_bInLazyLayoutUpdate && (nCharIndex >= 0)) {
+        int32_t nOffsetY = 0;
+        if (EnsureLineLayout(GetCharLineNumber(nCharIndex), nOffsetY)) {
+            OnLazyLayoutUpdated(nOffsetY);
+        }
+    }
+}
+
+void RichEditData::UpdateLazyTextRect()
+{
+    if (!m_bLazyLayout) {
+        return;
+    }
+    const size_t nLineCount = m_lineTextInfo.size();
+    if ((m_nLayoutStartLine == 0) && (m_nLayoutEndLine >= nLineCount)) {
+        //所有行都已经计算完成，退出延迟计算模式
+        ResetLazyLayout();
+        CalcCacheTextRects(m_rcTextRect);
+        m_bTextRectYOffsetUpdated = false;
+        const int32_t nOffsetY = GetTextRectOfssetY();
+        if (nOffsetY > 0) {
+            UpdateRowTextOffsetY(m_lineTextInfo, nOffsetY);
+            m_bTextRectYOffsetUpdated = true;
+        }
+    }
+    else {
+        //未计算的行按平均行高估算
+        CalcCacheTextRects(m_rcTextRect);
+        m_rcTextRect.top = 0;
+        const size_t nBelowLines = nLineCount - m_nLayoutEndLine;
+        m_rcTextRect.bottom = (int32_t)ui::CEILF(GetLayoutBottom() + nBelowLines * m_fLayoutLineHeight);
+    }
+    UpdateRowTextOffsetX(m_lineTextInfo, GetHAlignType(), m_rowXOffset, m_bTextRectXOffsetUpdated);
+}
+
+void RichEditData::OnLazyLayoutUpdated(int32_t nOffsetY)
+{
+    UpdateLazyTextRect();
+    m_bInLazyLayoutUpdate = true;
+    m_pRichText->OnTextRectsUpdated(nOffsetY);
+    m_bInLazyLayoutUpdate = false;
+    ScheduleLazyLayout();
+}
+
+void RichEditData::ScheduleLazyLayout()
+{
+    if (!m_bLazyLayout || m_layoutTaskFlag.HasUsed()) {
+        return;
+    }
+    GlobalManager::Instance().Thread().PostTask(kThreadUI, m_layoutTaskFlag.ToWeakCallback([this]() {
+            m_layoutTaskFlag.Cancel();
+            OnLazyLayoutTask();
+        }));
+}
+
+void RichEditData::OnLazyLayoutTask()
+{
+    SetTextDrawRect(m_pRichText->GetRichTextDrawRect(), true);
+    if (!m_bLazyLayout || m_bCacheDirty) {
+        //需要全部重新计算时，由下次检查时处理
+        return;
+    }
+    static const PerformanceStatId s_statId(_T("RichEditData::OnLazyLayoutTask"));
+    PerformanceStat statPerformance(s_statId);
+    //每次只连续计算一小段时间，避免阻塞界面：先向下计算到文本结尾，再向上计算到文本开头
+    const auto startTime = std::chrono::steady_clock::now();
+    int32_t nOffsetY = 0;
+    bool bChanged = false;
+    bool bFailed = false;
+    while (!bFailed) {
+        if (m_nLayoutEndLine < m_lineTextInfo.size()) {
+            bFailed = !ExtendLayoutDown(kLazyLayoutChunkLines);
+        }
+        else if (m_nLayoutStartLine > 0) {
+            bFailed = !ExtendLayoutUp(kLazyLayoutChunkLines, nOffsetY);
+        }
+        else {
+            break;
+        }
+        if (!bFailed) {
+            bChanged = true;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        if (elapsed.count() >= kLazyLayoutSliceMs) {
+            break;
+        }
+    }
+    if (bChanged) {
+        OnLazyLayoutUpdated(nOffsetY);
+        if (bFailed) {
+            //计算失败时不再继续
+            m_layoutTaskFlag.Cancel();
+        }
+    }
+}
+
 void RichEditData::CalcTextRects(size_t nStartLine,
                                  const std::vector<size_t>& modifiedLines,
                                  const std::vector<size_t>& deletedLines,
                                  size_t nDeletedRows)
 {
-    PerformanceStat statPerformance(_T("RichEditData::CalcTextRects2"));
+    static const PerformanceStatId s_statId(_T("RichEditData::CalcTextRects2"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT(!m_pRichText->IsTextPasswordMode());//密码模式下，不应使用该函数
     if (nStartLine != (size_t)-1) {
         ASSERT(!modifiedLines.empty() || !deletedLines.empty());
@@ -672,7 +1246,8 @@ void RichEditData::CalcTextRects(size_t nStartLine,
 
 bool RichEditData::SetText(const DStringW& text)
 {
-    PerformanceStat statPerformance(_T("RichEditData::SetText"));
+    static const PerformanceStatId s_statId(_T("RichEditData::SetText"));
+    PerformanceStat statPerformance(s_statId);
     if (text.empty()) {
         Clear();
         return true;
@@ -740,6 +1315,7 @@ bool RichEditData::SetText(const DStringW& text)
                 ASSERT(lineText->m_nLineTextLen > 0);
             }
         }
+        ResetLazyLayout();
         m_lineTextInfo.swap(lineTextInfo);
         SetCacheDirty(true);
         ClearUndoList();
@@ -937,7 +1513,8 @@ bool RichEditData::FindLineTextPos(int32_t nStartChar, int32_t nEndChar,
 
 bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStringW& text, bool bCanUndo, bool bClearRedo)
 {
-    PerformanceStat statPerformance(_T("RichEditData::ReplaceText"));
+    static const PerformanceStatId s_statId(_T("RichEditData::ReplaceText"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT((nStartChar >= 0) && (nEndChar >= 0) && (nEndChar >= nStartChar));
     if ((nStartChar < 0) || (nEndChar < 0) || (nStartChar > nEndChar)) {
         return false;
@@ -965,6 +1542,15 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
     if (!FindLineTextPos(nStartChar, nEndChar, nStartLine, nEndLine, nStartCharLineOffset, nEndCharLineOffset)) {
         return false;
     }
+    const size_t nOldLineCount = m_lineTextInfo.size();
+    if (m_bLazyLayout) {
+        //延迟计算时，增量计算缺少完整的行数据：改为重新计算（只同步计算可见区域附近的行），并记录可见区域的起始行
+        m_nLayoutAnchorLine = EstimateLineFromY(m_szScrollOffset.cy);
+        m_nLayoutAnchorTop = EstimateLineTop(m_nLayoutAnchorLine);
+        ResetLazyLayout();
+        SetCacheDirty(true);
+    }
+    const size_t nEditStartLine = nStartLine;
 
     DStringW oldText; //旧文本内容
 
@@ -1053,6 +1639,17 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
         }
     }
 
+    if ((m_nLayoutAnchorLine != (size_t)-1) && (m_nLayoutAnchorLine > nEditStartLine)) {
+        //修改点在可见区域的上方，按增减的行数修正定位行
+        const size_t nLineCount = m_lineTextInfo.size();
+        if (nLineCount >= nOldLineCount) {
+            m_nLayoutAnchorLine += nLineCount - nOldLineCount;
+        }
+        else {
+            m_nLayoutAnchorLine -= std::min(nOldLineCount - nLineCount, m_nLayoutAnchorLine - nEditStartLine);
+        }
+    }
+
     //文本有变化的行
     std::vector<size_t> modifiedLines;
     for (size_t nIndex = 0; nIndex < nNewLineCount; ++nIndex) {
@@ -1277,7 +1874,16 @@ RichTextRowInfoPtr RichEditData::GetFirstRowInfo() const
     ASSERT(!m_bCacheDirty);
     RichTextRowInfoPtr spRowInfo;
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
-    if (!lineTextInfoList.empty()) {
+    if (m_bLazyLayout) {
+        //延迟计算时，返回已计算区域的首行
+        if (m_nLayoutStartLine < m_nLayoutEndLine) {
+            const RichTextLineInfo& lineTextInfo = *lineTextInfoList[m_nLayoutStartLine];
+            if (!lineTextInfo.m_rowInfo.empty()) {
+                spRowInfo = lineTextInfo.m_rowInfo.front();
+            }
+        }
+    }
+    else if (!lineTextInfoList.empty()) {
         const RichTextLineInfo& lineTextInfo = *lineTextInfoList[0];
         ASSERT(!lineTextInfo.m_rowInfo.empty());
         if (!lineTextInfo.m_rowInfo.empty()) {
@@ -1293,7 +1899,16 @@ RichTextRowInfoPtr RichEditData::GetLastRowInfo() const
     RichTextRowInfoPtr spRowInfo;
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
     const size_t nLineCount = lineTextInfoList.size();
-    if (nLineCount != 0) {
+    if (m_bLazyLayout) {
+        //延迟计算时，返回已计算区域的尾行
+        if (m_nLayoutStartLine < m_nLayoutEndLine) {
+            const RichTextLineInfo& lineTextInfo = *lineTextInfoList[m_nLayoutEndLine - 1];
+            if (!lineTextInfo.m_rowInfo.empty()) {
+                spRowInfo = lineTextInfo.m_rowInfo.back();
+            }
+        }
+    }
+    else if (nLineCount != 0) {
         const RichTextLineInfo& lineTextInfo = *lineTextInfoList[nLineCount - 1];
         ASSERT(!lineTextInfo.m_rowInfo.empty());
         const size_t nRowCount = lineTextInfo.m_rowInfo.size();
@@ -1430,7 +2045,7 @@ UiPoint RichEditData::PosForEmptyText() const
 UiPoint RichEditData::CaretPosFromChar(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharRects(nCharIndex);
 
     if (m_rcTextDrawRect.IsEmpty()) {
         //绘制区域为空
@@ -1450,6 +2065,9 @@ UiPoint RichEditData::CaretPosFromChar(int32_t nCharIndex)
         cursorPos.x = 0;
         cursorPos.y = 0;
     }
+    else if (EstimateCharPos(nCharIndex, cursorPos)) {
+        //该字符所在的行尚未计算，使用估算的位置
+    }
     else {
         size_t nStartCharRowOffset = 0;
         RichTextRowInfoPtr spRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
@@ -1489,7 +2107,7 @@ UiPoint RichEditData::CaretPosFromChar(int32_t nCharIndex)
 UiRect RichEditData::GetCharRowRect(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharRects(nCharIndex);
 
     UiRect rowRect;
     if (m_lineTextInfo.empty()) {
@@ -1516,6 +2134,16 @@ UiRect RichEditData::GetCharRowRect(int32_t nCharIndex)
             rowRect.top = (int32_t)rowRectF.top;
             rowRect.bottom = (int32_t)ui::CEILF(rowRectF.bottom);
         }
+        else {
+            UiPoint pt;
+            if (EstimateCharPos(nCharIndex, pt)) {
+                //该字符所在的行尚未计算，使用估算的位置
+                rowRect.left = 0;
+                rowRect.right = m_pRichText->GetRichTextDrawRect().Width();
+                rowRect.top = pt.y;
+                rowRect.bottom = rowRect.top + m_pRichText->GetTextRowHeight();
+            }
+        }
     }
 
     //转换为外部坐标
@@ -1526,7 +2154,7 @@ UiRect RichEditData::GetCharRowRect(int32_t nCharIndex)
 UiPoint RichEditData::PosFromChar(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharRects(nCharIndex);
 
     UiPoint pt;
     if (m_lineTextInfo.empty()) {
@@ -1538,6 +2166,9 @@ UiPoint RichEditData::PosFromChar(int32_t nCharIndex)
         pt.x = 0;
         pt.y = 0;
     }
+    else if (EstimateCharPos(nCharIndex, pt)) {
+        //该字符所在的行尚未计算，使用估算的位置
+    }
     else {     
         size_t nStartCharRowOffset = 0;
         RichTextRowInfoPtr spRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
@@ -1594,6 +2225,23 @@ int32_t RichEditData::CharFromPos(UiPoint pt)
     //转换为内部坐标
     ConvertToInternal(pt);
 
+    if (m_bLazyLayout) {
+        //延迟计算：确保该点所在的行已经计算，距离较远时返回估算行的行首字符
+        const size_t nLineNumber = EstimateLineFromY(pt.y);
+        if (!m_bInLazyLayoutUpdate) {
+            int32_t nOffsetY = 0;
+            if (EnsureLineLayout(nLineNumber, nOffsetY)) {
+                OnLazyLayoutUpdated(nOffsetY);
+                if (nOffsetY != 0) {
+                    pt.y += nOffsetY;
+                }
+            }
+        }
+        if (m_bLazyLayout && ((nLineNumber < m_nLayoutStartLine) || (nLineNumber >= m_nLayoutEndLine))) {
+            return (int32_t)std::min(GetLineStartCharIndex(nLineNumber), (size_t)nTextLength);
+        }
+    }
+
     //横向按字符边界对齐，纵向按行高对齐
     int32_t nCharPosIndex = -1;
     RichTextRowInfoPtr spDestRow;
@@ -2228,7 +2876,7 @@ int32_t RichEditData::GetRowEndCharIndex(int32_t nCharIndex)
 int32_t RichEditData::GetCharWidthValue(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharRects(nCharIndex);
 
     int32_t nCharWidth = 0;
     size_t nStartCharRowOffset = 0;
@@ -2564,6 +3212,9 @@ bool RichEditData::Redo(int32_t& nEndCharIndex)
 
 void RichEditData::Clear()
 {
+    ResetLazyLayout();
+    m_fLayoutLineHeight = 0;
+    m_nLayoutAnchorLine = (size_t)-1;
     RichTextLineInfoList lineTextInfo;
     m_lineTextInfo.swap(lineTextInfo);
     m_spDrawRichTextCache.reset();
@@ -2580,8 +3231,8 @@ void RichEditData::Clear()
 
 int32_t RichEditData::GetRowCount()
 {
-    //检查并计算字符位置
-    CheckCalcTextRects();
+    //检查并计算字符位置（逻辑行号需要完整的行数据，延迟计算时先完成所有行的计算）
+    CompleteLayout();
 
     int32_t nRowIndex = 0; //行号
     const size_t nLineCount = m_lineTextInfo.size();
@@ -2595,8 +3246,8 @@ int32_t RichEditData::GetRowCount()
 
 DStringW RichEditData::GetRowText(int32_t nRowIndex)
 {
-    //检查并计算字符位置
-    CheckCalcTextRects();
+    //检查并计算字符位置（逻辑行号需要完整的行数据，延迟计算时先完成所有行的计算）
+    CompleteLayout();
 
     DStringW rowText;
     bool bFound = false;
@@ -2633,8 +3284,8 @@ DStringW RichEditData::GetRowText(int32_t nRowIndex)
 
 int32_t RichEditData::RowIndex(int32_t nRowIndex)
 {
-    //检查并计算字符位置
-    CheckCalcTextRects();
+    //检查并计算字符位置（逻辑行号需要完整的行数据，延迟计算时先完成所有行的计算）
+    CompleteLayout();
 
     int32_t nRowStartIndex = -1;
     bool bFound = false;
@@ -2666,8 +3317,8 @@ int32_t RichEditData::RowIndex(int32_t nRowIndex)
 
 int32_t RichEditData::RowLength(int32_t nRowIndex)
 {
-    //检查并计算字符位置
-    CheckCalcTextRects();
+    //检查并计算字符位置（逻辑行号需要完整的行数据，延迟计算时先完成所有行的计算）
+    CompleteLayout();
 
     int32_t nRowLength = 0;
     bool bFound = false;
@@ -2703,8 +3354,8 @@ int32_t RichEditData::RowFromChar(int32_t nCharIndex)
     if (nTextLength < 1) {
         return 0;
     }
-    //检查并计算字符位置
-    CheckCalcTextRects();
+    //检查并计算字符位置（逻辑行号需要完整的行数据，延迟计算时先完成所有行的计算）
+    CompleteLayout();
 
     int32_t nRowIndex = 0; //逻辑行号
     size_t nTextLen = 0;   //文本总长度
@@ -4,6 +4,7 @@
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Core/SharePtr.h"
 #include "duilib/Render/IRender.h"
+#include "duilib/Core/Callback.h"
 #include <unordered_map>
 #include <map>
 #include <list>
@@ -39,6 +40,11 @@ public:
     */
     virtual void OnTextRectsChanged() = 0;
 
+    /** 文字区域有部分更新的事件（文本行数较多时，未计算的行在空闲时分批计算，每批计算完成后触发）
+    * @param [in] nOffsetY 已计算区域在纵向的调整量，需要同步调整滚动条的位置，以保持可见区域的内容不变
+    */
+    virtual void OnTextRectsUpdated(int32_t nOffsetY) = 0;
+
     /** 获取行高值
     */
     virtual int32_t GetTextRowHeight() const = 0;
@@ -351,6 +357,18 @@ public:
     */
     void CheckCalcTextRects();
 
+    /** 获取用于绘制的文本视图，与绘制缓存对应（延迟计算时，只包含已经计算过的行）
+    */
+    void GetTextViewForDraw(std::vector<std::wstring_view>& textView) const;
+
+    /** 是否有尚未计算的行（文本行数较多时，只同步计算可见区域附近的行，其余的行在空闲时分批计算）
+    */
+    bool IsLazyLayoutPending() const;
+
+    /** 同步计算所有尚未计算的行
+    */
+    void CompleteLayout();
+
     /** 按字符数限制，截断文本
     */
     void TruncateLimitText(DStringW& text, int32_t nLimitLen) const;
@@ -411,6 +429,108 @@ private:
                        const std::vector<size_t>& deletedLines,
                        size_t nDeletedRows);
 
+    /** 检查并按需重新计算文本区域，并确保字符所在的行已经计算（延迟计算时，距离较远的行不计算，使用估算值）
+    */
+    void CheckCalcCharRects(int32_t nCharIndex);
+
+    /** 延迟计算：文本是否满足延迟计算的条件（多行模式，非密码模式，行数较多）
+    */
+    bool IsLazyLayoutEnabled() const;
+
+    /** 延迟计算：重置状态，取消空闲时的计算任务
+    */
+    void ResetLazyLayout();
+
+    /** 延迟计算：计算[nStartLine, nEndLine)范围内的行
+    * @param [in] nStartRowIndex 起始行在已计算区域中的逻辑行号
+    * @param [out] spDrawRichTextCache 返回这些行的绘制缓存
+    */
+    bool MeasureLayoutLines(size_t nStartLine, size_t nEndLine, size_t nStartRowIndex,
+                            std::shared_ptr<DrawRichTextCache>& spDrawRichTextCache);
+
+    /** 延迟计算：从fTop开始依次排列[nStartLine, nEndLine)范围内各行的纵坐标，返回最后一行的bottom值
+    */
+    float PlaceLayoutRows(size_t nStartLine, size_t nEndLine, float fTop);
+
+    /** 延迟计算：将新计算的行[nStartLine, nEndLine)合并到绘制缓存中
+    * @param [in] nRowCount 新计算的行，切分为几行（逻辑行）
+    * @param [in] spLinesCache 新计算的行的绘制缓存
+    */
+    void MergeLayoutCache(size_t nStartLine, size_t nEndLine, size_t nRowCount,
+                          const std::shared_ptr<DrawRichTextCache>& spLinesCache);
+
+    /** 延迟计算：获取[nStartLine, nEndLine)范围内的逻辑行数
+    */
+    size_t GetLayoutRowCount(size_t nStartLine, size_t nEndLine) const;
+
+    /** 延迟计算：获取已计算区域的底部坐标
+    */
+    float GetLayoutBottom() const;
+
+    /** 延迟计算：按已计算区域更新物理行的平均行高
+    */
+    void UpdateLayoutLineHeight();
+
+    /** 延迟计算：放弃当前已计算的区域，在nAnchorLine附近重新计算，并将该行放在nAnchorTop的位置
+    * @return 返回已计算区域在纵向的调整量
+    */
+    int32_t RelayoutAroundLine(size_t nAnchorLine, int32_t nAnchorTop);
+
+    /** 延迟计算：已计算区域向下扩展nLineCount行
+    */
+    bool ExtendLayoutDown(size_t nLineCount);
+
+    /** 延迟计算：已计算区域向上扩展nLineCount行
+    * @param [in,out] nOffsetY 累加已计算区域在纵向的调整量
+    */
+    bool ExtendLayoutUp(size_t nLineCount, int32_t& nOffsetY);
+
+    /** 延迟计算：确保指定的行及其相邻行已经计算（只在距离已计算区域较近时扩展）
+    * @param [in,out] nOffsetY 累加已计算区域在纵向的调整量
+    * @return 已计算区域有变化时返回true
+    */
+    bool EnsureLineLayout(size_t nLineNumber, int32_t& nOffsetY);
+
+    /** 延迟计算：确保可见区域内的行已经计算
+    * @param [in,out] nOffsetY 累加已计算区域在纵向的调整量
+    * @return 已计算区域有变化时返回true
+    */
+    bool EnsureViewportLayout(int32_t& nOffsetY);
+
+    /** 延迟计算：估算行的纵坐标（已计算的行返回实际值）
+    */
+    int32_t EstimateLineTop(size_t nLineNumber) const;
+
+    /** 延迟计算：按纵坐标估算所在的行（已计算的行返回实际值）
+    */
+    size_t EstimateLineFromY(int32_t y) const;
+
+    /** 延迟计算：如果字符所在的行尚未计算，返回估算的位置（内部坐标）
+    */
+    bool EstimateCharPos(int32_t nCharIndex, UiPoint& pt) const;
+
+    /** 获取字符所在的物理行号
+    */
+    size_t GetCharLineNumber(int32_t nCharIndex) const;
+
+    /** 获取物理行的起始字符下标值
+    */
+    size_t GetLineStartCharIndex(size_t nLineNumber) const;
+
+    /** 延迟计算：已计算区域有变化，更新文本区域并通知
+    * @param [in] nOffsetY 已计算区域在纵向的调整量
+    */
+    void OnLazyLayoutUpdated(int32_t nOffsetY);
+
+    /** 延迟计算：更新文本区域（未计算的行按平均行高估算），全部计算完成时退出延迟计算模式
+    */
+    void UpdateLazyTextRect();
+
+    /** 延迟计算：投递空闲时的计算任务 / 执行一批计算任务
+    */
+    void ScheduleLazyLayout();
+    void OnLazyLayoutTask();
+
     /** 定位字符范围所属的行和行文本偏移量
     * @param [in] nStartChar 起始下标值
     * @param [in] nEndChar 结束下标值， nEndChar >= nStartChar
@@ -536,6 +656,38 @@ private:
     */
     bool m_bCacheDirty;
 
+private:
+    /** 是否处于延迟计算模式：只有[m_nLayoutStartLine, m_nLayoutEndLine)范围内的物理行已经计算，
+    *   其余的行按平均行高估算，在空闲时分批计算
+    */
+    bool m_bLazyLayout;
+
+    /** 已计算区域的起始物理行号和结束物理行号
+    */
+    size_t m_nLayoutStartLine;
+    size_t m_nLayoutEndLine;
+
+    /** 已计算区域的起始纵坐标（上方未计算的行所占的估算高度）
+    */
+    int32_t m_nLayoutTopOffset;
+
+    /** 物理行的平均行高，用于估算未计算的行
+    */
+    float m_fLayoutLineHeight;
+
+    /** 重新计算时的定位行（编辑文本前记录，使重新计算后可见区域的内容保持不变）
+    */
+    size_t m_nLayoutAnchorLine;
+    int32_t m_nLayoutAnchorTop;
+
+    /** 是否正在通知已计算区域的变化（避免重入）
+    */
+    bool m_bInLazyLayoutUpdate;
+
+    /** 空闲时计算任务的取消标志
+    */
+    WeakCallbackFlag m_layoutTaskFlag;
+
 private:
     /** Undo的数据
     */
@@ -2912,7 +2912,7 @@ uint16_t RichEdit::GetTextStyle() const
 bool RichEdit::GetRichTextForDraw(std::vector<RichTextData>& richTextDataList) const
 {
     std::vector<std::wstring_view> textView;
-    m_pTextData->GetTextView(textView);
+    m_pTextData->GetTextViewForDraw(textView);
     GetRichTextForDraw(textView, richTextDataList);
     return !richTextDataList.empty();
 }
@@ -3023,6 +3023,26 @@ void RichEdit::OnTextRectsChanged()
     UpdateScrollRange();
 }
 
+void RichEdit::OnTextRectsUpdated(int32_t nOffsetY)
+{
+    //更新滚动条的范围，并同步调整滚动条位置，保持可见区域的内容不变
+    UpdateScrollRange();
+    if (nOffsetY != 0) {
+        UiSize64 scrollPos = GetScrollPos();
+        scrollPos.cy += nOffsetY;
+        SetScrollPos(scrollPos);
+    }
+
+    //更新光标的位置
+    int32_t nSelStartChar = -1;
+    int32_t nSelEndChar = -1;
+    GetSel(nSelStartChar, nSelEndChar);
+    if (nSelStartChar == nSelEndChar) {
+        SetCaretPos(nSelStartChar);
+    }
+    Invalidate();
+}
+
 int32_t RichEdit::GetTextRowHeight() const
 {
     return m_nRowHeight;
@@ -757,6 +757,10 @@ protected:
 
     //一些基类的虚函数
     virtual bool CanPlaceCaptionBar() const override;
+
+    /** 文本由控件自身绘制，不能直接复制已绘制的内容
+    */
+    virtual bool CanScrollBlit(std::vector<UiRect>& /*fixedRects*/) const override { return false; }
     virtual void OnInit() override;
     virtual uint32_t GetControlFlags() const override;
 
@@ -809,6 +813,10 @@ protected:
     */
     virtual void OnTextRectsChanged() override;
 
+    /** 文字区域有部分更新的事件（未计算的行在空闲时分批计算完成）
+    */
+    virtual void OnTextRectsUpdated(int32_t nOffsetY) override;
+
     /** 获取行高值
     */
     virtual int32_t GetTextRowHeight() const override;
@@ -901,6 +901,14 @@ protected:
     virtual void Paint(IRender* pRender, const UiRect& rcPaint) override;
     virtual void PaintChild(IRender* pRender, const UiRect& rcPaint) override;
 
+    /** 文本通过GDI绘制到画布的DC上，无法录制
+    */
+    virtual bool IsPaintRecordable() const override { return false; }
+
+    /** 文本由控件自身绘制，不能直接复制已绘制的内容
+    */
+    virtual bool CanScrollBlit(std::vector<UiRect>& /*fixedRects*/) const override { return false; }
+
     /** 调整内部所有子控件的位置信息
      * @param[in] items 控件列表
      */
@@ -135,6 +135,17 @@ void RichText::ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale)
     BaseClass::ChangeDpiScale(nOldDpiScale, nNewDpiScale);
 }
 
+void RichText::ChangeLanguage()
+{
+    BaseClass::ChangeLanguage();
+    if (!m_richTextId.empty()) {
+        //语言文件名可能未变化（重新加载了同一个语言文件），所以直接更新文本内容
+        DoSetText(GlobalManager::Instance().Lang().GetStringViaID(m_richTextId.c_str()));
+        m_langFileName = GlobalManager::Instance().GetLanguageFileName();
+        RelayoutOrRedraw();
+    }
+}
+
 void RichText::Redraw()
 {
     //重新绘制
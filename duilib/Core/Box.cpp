@@ -73,6 +73,16 @@ void Box::ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale)
     }
 }
 
+void Box::ChangeLanguage()
+{
+    BaseClass::ChangeLanguage();
+    for (auto pControl : m_items) {
+        if (pControl != nullptr) {
+            pControl->ChangeLanguage();
+        }
+    }
+}
+
 void Box::SetParent(Box* pParent)
 {
     Control::SetParent(pParent);
@@ -457,6 +467,7 @@ bool Box::DoAddItemAt(Control* pControl, size_t iIndex)
     Window* pWindow = GetWindow();
     if (pWindow != nullptr) {
         pWindow->InitControls(pControl);
+        pWindow->InvalidatePaintRecordable();
     }
     pControl->SetParent(this);
 
@@ -494,6 +505,9 @@ bool Box::DoRemoveItem(Control* pControl)
             if (m_bAutoDestroyChild) {
                 delete pControl;
             }
+            if (GetWindow() != nullptr) {
+                GetWindow()->InvalidatePaintRecordable();
+            }
             Arrange();
             return true;
         }
@@ -511,6 +525,9 @@ void Box::RemoveAllItems()
         }
     }
     if (!items.empty()) {
+        if (GetWindow() != nullptr) {
+            GetWindow()->InvalidatePaintRecordable();
+        }
         Arrange();
     }    
 }
@@ -58,6 +58,11 @@ public:
     */
     UiRect GetRectWithoutPadding() const;
 
+    /** PaintChild是否在子控件之上绘制了其他内容（比如网格线），子类如有此行为需要重写此函数，返回true
+    *   子控件所在的容器滚动时，据此判断能否直接复制已经绘制的像素（参见ScrollBox::CanScrollBlit）
+    */
+    virtual bool HasChildOverlay() const { return false; }
+
     /** 计算控件大小(宽和高)
         如果设置了图片并设置 width 或 height 任意一项为 auto，将根据图片大小和文本大小来计算最终大小
      *  @param [in] szAvailable 可用大小，不包含内边距，不包含外边距
@@ -71,6 +76,10 @@ public:
     */
     virtual void ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale) override;
 
+    /** 语言发生变化（重新加载了语言文件），更新所有子控件的文本
+    */
+    virtual void ChangeLanguage() override;
+
 public:
     /** @name 操作子控件(item)相关的方法
     * @{
@@ -5,6 +5,27 @@
 
 namespace ui 
 {
+std::atomic<uint32_t> ColorMap::s_nNextVersion = 1;
+
+ColorMap::ColorMap():
+    m_nVersion(0)
+{
+    UpdateVersion();
+}
+
+void ColorMap::UpdateVersion()
+{
+    uint32_t nVersion = s_nNextVersion.fetch_add(1, std::memory_order_relaxed);
+    if ((nVersion == 0) || (nVersion == UINT32_MAX)) {
+        //0和UINT32_MAX为保留值
+        nVersion = s_nNextVersion.fetch_add(2, std::memory_order_relaxed);
+        if ((nVersion == 0) || (nVersion == UINT32_MAX)) {
+            nVersion = 1;
+        }
+    }
+    m_nVersion = nVersion;
+}
+
 void ColorMap::AddColor(const DString& strName, const DString& strValue)
 {
     ASSERT(!strName.empty() && !strValue.empty());
@@ -21,28 +42,55 @@ void ColorMap::AddColor(const DString& strName, UiColor argb)
     if (strName.empty() || (argb.GetARGB() == 0)) {
         return;
     }
-#ifdef _DEBUG
-    //检查：避免误修改
-    auto iter = m_colorMap.find(strName);
-    if (iter != m_colorMap.end()) {
-        ASSERT(iter->second == argb);
+    auto iter = m_colorSlotMap.find(strName);
+    if (iter != m_colorSlotMap.end()) {
+        //检查：避免误修改
+        ASSERT(m_colors[iter->second] == argb);
+        //已有的颜色名称，槽位不变，已解析的颜色无需重新解析
+        m_colors[iter->second] = argb;
+    }
+    else {
+        m_colorSlotMap[strName] = (uint32_t)m_colors.size();
+        m_colors.push_back(argb);
+        UpdateVersion();
     }
-#endif
-    m_colorMap[strName] = argb;
 }
 
 UiColor ColorMap::GetColor(const DString& strName) const
 {
-    auto it = m_colorMap.find(strName);
-    if (it != m_colorMap.end()) {
-        return it->second;
+    auto it = m_colorSlotMap.find(strName);
+    if (it != m_colorSlotMap.end()) {
+        return m_colors[it->second];
     }
     return UiColor();
 }
 
 void ColorMap::RemoveAllColors()
 {
-    m_colorMap.clear();
+    if (!m_colorSlotMap.empty()) {
+        m_colorSlotMap.clear();
+        m_colors.clear();
+        UpdateVersion();
+    }
+}
+
+bool ColorMap::FindColorSlot(const DString& strName, uint32_t& nSlot) const
+{
+    auto it = m_colorSlotMap.find(strName);
+    if (it != m_colorSlotMap.end()) {
+        nSlot = it->second;
+        return true;
+    }
+    return false;
+}
+
+UiColor ColorMap::GetColorAt(uint32_t nSlot) const
+{
+    ASSERT(nSlot < m_colors.size());
+    if (nSlot < m_colors.size()) {
+        return m_colors[nSlot];
+    }
+    return UiColor();
 }
 
 ColorManager::ColorManager()
@@ -124,6 +172,8 @@ void ColorManager::RemoveAllColors()
     m_colorMap.RemoveAllColors();
     m_defaultDisabledTextColor.clear();
     m_defaultTextColor.clear();
+    m_defaultDisabledTextColorToken.clear();
+    m_defaultTextColorToken.clear();
 }
 
 void ColorManager::Clear()
@@ -140,6 +190,7 @@ const DString& ColorManager::GetDefaultDisabledTextColor()
 void ColorManager::SetDefaultDisabledTextColor(const DString& strColor)
 {
     m_defaultDisabledTextColor = strColor;
+    m_defaultDisabledTextColorToken = strColor;
 }
 
 const DString& ColorManager::GetDefaultTextColor()
@@ -150,6 +201,17 @@ const DString& ColorManager::GetDefaultTextColor()
 void ColorManager::SetDefaultTextColor(const DString& strColor)
 {
     m_defaultTextColor = strColor;
+    m_defaultTextColorToken = strColor;
+}
+
+const UiColorToken& ColorManager::GetDefaultDisabledTextColorToken() const
+{
+    return m_defaultDisabledTextColorToken;
+}
+
+const UiColorToken& ColorManager::GetDefaultTextColorToken() const
+{
+    return m_defaultTextColorToken;
 }
 
 } // namespace ui
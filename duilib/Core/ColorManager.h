@@ -2,16 +2,21 @@
 #define UI_CORE_COLOR_MANAGER_H_
 
 #include "duilib/Core/UiColor.h"
+#include "duilib/Core/UiColorToken.h"
 #include <unordered_map>
+#include <vector>
 #include <string>
+#include <atomic>
 
 namespace ui 
 {
-/** 颜色值的管理容器
+/** 颜色值的管理容器（颜色表）：每个颜色名称对应一个固定的槽位，已解析的颜色（UiColorToken）记录槽位序号，
+*   修改已有颜色的值时槽位不变，无需重新解析；添加新的颜色名称或者清空颜色表时，颜色表的版本号变化
 */
 class UILIB_API ColorMap
 {
 public:
+    ColorMap();
     /** 添加一个颜色值
     * @param[in] strName 颜色名称（如 white）
     * @param[in] strValue 颜色具体数值（如 #FFFFFFFF）
@@ -34,10 +39,44 @@ public:
     */
     void RemoveAllColors();
 
+public:
+    /** 根据名称查找颜色所在的槽位
+    * @param[in] strName 要查找的颜色名称
+    * @param[out] nSlot 返回颜色所在的槽位序号
+    * @return 如果找到返回true，否则返回false
+    */
+    bool FindColorSlot(const DString& strName, uint32_t& nSlot) const;
+
+    /** 根据槽位序号获取颜色的具体数值
+    * @param[in] nSlot 槽位序号（由FindColorSlot函数返回）
+    */
+    UiColor GetColorAt(uint32_t nSlot) const;
+
+    /** 获取颜色表的版本号（添加新的颜色名称或者清空颜色表时变化，每个颜色表的版本号均不相同）
+    */
+    uint32_t GetVersion() const { return m_nVersion; }
+
 private:
-    /** 颜色名称与颜色值的映射关系
+    /** 颜色表结构发生变化时，更新颜色表的版本号
+    */
+    void UpdateVersion();
+
+private:
+    /** 颜色名称与槽位序号的映射关系
+    */
+    std::unordered_map<DString, uint32_t> m_colorSlotMap;
+
+    /** 各个槽位的颜色值
+    */
+    std::vector<UiColor> m_colors;
+
+    /** 颜色表的版本号
     */
-    std::unordered_map<DString, UiColor> m_colorMap;
+    uint32_t m_nVersion;
+
+    /** 用于分配颜色表版本号的全局计数器（保证不同颜色表的版本号不同）
+    */
+    static std::atomic<uint32_t> s_nNextVersion;
 };
 
 /** 颜色值的管理类
@@ -79,6 +118,14 @@ public:
      */
     UiColor GetStandardColor(const DString& strName) const;
 
+    /** 获取全局颜色表
+    */
+    const ColorMap& GetColorMap() const { return m_colorMap; }
+
+    /** 获取标准颜色表（颜色名称为小写）
+    */
+    const ColorMap& GetStandardColorMap() const { return m_standardColorMap; }
+
     /** 删除所有颜色属性
      */
     void RemoveAllColors();
@@ -105,6 +152,14 @@ public:
      */
     void SetDefaultTextColor(const DString& strColor);
 
+    /** 获取默认禁用状态下字体颜色（预解析的颜色）
+     */
+    const UiColorToken& GetDefaultDisabledTextColorToken() const;
+
+    /** 获取默认字体颜色（预解析的颜色）
+     */
+    const UiColorToken& GetDefaultTextColorToken() const;
+
 private:
     /** 颜色名称与颜色值的映射关系
     */
@@ -121,6 +176,14 @@ private:
     /** 默认正常状态的字体颜色
     */
     DString m_defaultTextColor;
+
+    /** 默认禁用状态下的字体颜色（预解析的颜色）
+    */
+    UiColorToken m_defaultDisabledTextColorToken;
+
+    /** 默认正常状态的字体颜色（预解析的颜色）
+    */
+    UiColorToken m_defaultTextColorToken;
 };
 
 } // namespace ui
@@ -0,0 +1,760 @@
+#include "CompiledLayout.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/third_party/xml/pugixml.hpp"
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <cstring>
+
+namespace ui
+{
+/** 二进制数据的文件头标识："DULC"
+*/
+static constexpr uint32_t kCompiledLayoutMagic = 0x434C5544;
+
+/** 二进制数据的格式版本号，格式有变化时需要增加
+*/
+static constexpr uint32_t kCompiledLayoutVersion = 2;
+
+/** 二进制数据的文件头
+*/
+struct CompiledLayoutHeader
+{
+    uint32_t m_nMagic;          //文件头标识
+    uint32_t m_nVersion;        //格式版本号
+    uint32_t m_nCharSize;       //字符的大小：sizeof(DString::value_type)
+    uint32_t m_nStringCount;    //字符串个数
+    uint32_t m_nNodeCount;      //节点个数
+    uint32_t m_nAttrCount;      //属性个数
+    uint32_t m_nClassNameCount; //Class名称个数
+    uint32_t m_nIncludeCount;   //Include节点个数
+    uint64_t m_nSourceHash;     //XML源文件数据的哈希值
+    uint64_t m_nSourceSize;     //XML源文件数据的大小
+    int64_t m_nSourceTime;      //XML源文件的最后修改时间
+};
+
+/** 二进制数据中的节点（不含运行时解析的字段）
+*/
+struct CompiledLayoutNodeData
+{
+    uint32_t m_nName;
+    uint32_t m_nFirstAttr;
+    uint32_t m_nAttrCount;
+    uint32_t m_nFirstChild;
+    uint32_t m_nChildCount;
+    uint32_t m_nRichText;
+    uint32_t m_nFirstClass;
+    uint32_t m_nClassCount;
+    uint32_t m_nInclude;
+    uint32_t m_nNodeType;
+};
+
+/** 二进制数据中的属性
+*/
+struct CompiledLayoutAttrData
+{
+    uint32_t m_nName;
+    uint32_t m_nValue;
+    uint32_t m_nValueType;
+    int32_t m_values[4];
+};
+
+/** 二进制数据中的Include节点
+*/
+struct CompiledLayoutIncludeData
+{
+    uint32_t m_nSource;
+    int32_t m_nCount;
+};
+
+/** 写入RichText节点XML文本的辅助类
+*/
+class CompiledLayoutXmlWriter: public pugi::xml_writer
+{
+public:
+    virtual void write(const void* data, size_t size) override
+    {
+        m_buffer.append((const char*)data, size);
+    }
+    std::string m_buffer;
+};
+
+template<typename T>
+static void AppendData(std::vector<uint8_t>& data, const T& value)
+{
+    const uint8_t* p = (const uint8_t*)&value;
+    data.insert(data.end(), p, p + sizeof(T));
+}
+
+template<typename T>
+static bool ReadData(const uint8_t*& pData, const uint8_t* pDataEnd, T& value)
+{
+    if ((size_t)(pDataEnd - pData) < sizeof(T)) {
+        return false;
+    }
+    ::memcpy(&value, pData, sizeof(T));
+    pData += sizeof(T);
+    return true;
+}
+
+CompiledLayout::CompiledLayout():
+    m_nSourceHash(0),
+    m_nSourceSize(0),
+    m_nSourceTime(0)
+{
+}
+
+CompiledLayout::~CompiledLayout()
+{
+}
+
+void CompiledLayout::Clear()
+{
+    m_strings.clear();
+    m_nodes.clear();
+    m_attrs.clear();
+    m_classNames.clear();
+    m_includes.clear();
+    m_includePaths.clear();
+    m_stringIndexMap.clear();
+    m_nSourceHash = 0;
+    m_nSourceSize = 0;
+    m_nSourceTime = 0;
+}
+
+uint64_t CompiledLayout::HashSourceData(const uint8_t* pData, size_t nDataSize)
+{
+    uint64_t nHash = 14695981039346656037ULL;
+    for (size_t i = 0; i < nDataSize; ++i) {
+        nHash ^= pData[i];
+        nHash *= 1099511628211ULL;
+    }
+    return nHash;
+}
+
+uint32_t CompiledLayout::AddString(const DString& str)
+{
+    auto iter = m_stringIndexMap.find(str);
+    if (iter != m_stringIndexMap.end()) {
+        return iter->second;
+    }
+    const uint32_t nIndex = (uint32_t)m_strings.size();
+    m_strings.push_back(str);
+    m_stringIndexMap[str] = nIndex;
+    return nIndex;
+}
+
+void CompiledLayout::ParseTypedValue(const DString& strValue, CompiledLayoutValue& value)
+{
+    value = CompiledLayoutValue();
+    if (strValue.empty()) {
+        return;
+    }
+    if ((strValue == _T("true")) || (strValue == _T("false"))) {
+        value.m_type = CompiledLayoutValueType::kBool;
+        value.m_values[0] = (strValue == _T("true")) ? 1 : 0;
+        return;
+    }
+    if (strValue.front() == _T('#')) {
+        //颜色值，格式如：#FFFFFFFF 或者 #FFFFFF（自动补上Alpha值）
+        if ((strValue.size() != 9) && (strValue.size() != 7)) {
+            return;
+        }
+        uint32_t argb = 0;
+        for (size_t i = 1; i < strValue.size(); ++i) {
+            const DString::value_type ch = strValue[i];
+            uint32_t nDigit = 0;
+            if ((ch >= _T('0')) && (ch <= _T('9'))) {
+                nDigit = (uint32_t)(ch - _T('0'));
+            }
+            else if ((ch >= _T('a')) && (ch <= _T('f'))) {
+                nDigit = (uint32_t)(ch - _T('a')) + 10;
+            }
+            else if ((ch >= _T('A')) && (ch <= _T('F'))) {
+                nDigit = (uint32_t)(ch - _T('A')) + 10;
+            }
+            else {
+                return;
+            }
+            argb = (argb << 4) | nDigit;
+        }
+        if (strValue.size() == 7) {
+            argb |= 0xFF000000;
+        }
+        value.m_type = CompiledLayoutValueType::kColor;
+        value.m_values[0] = (int32_t)argb;
+        return;
+    }
+
+    //以逗号分隔的1个、2个或者4个整数，不允许空格等其他字符
+    int32_t values[4] = { 0, 0, 0, 0 };
+    size_t nCount = 0;
+    size_t nPos = 0;
+    const size_t nSize = strValue.size();
+    while (true) {
+        bool bNegative = false;
+        if ((nPos < nSize) && (strValue[nPos] == _T('-'))) {
+            bNegative = true;
+            ++nPos;
+        }
+        int64_t nNumber = 0;
+        size_t nDigits = 0;
+        while ((nPos < nSize) && (strValue[nPos] >= _T('0')) && (strValue[nPos] <= _T('9'))) {
+            nNumber = nNumber * 10 + (strValue[nPos] - _T('0'));
+            ++nDigits;
+            ++nPos;
+            if (nDigits > 9) {
+                //超出范围，按字符串处理
+                return;
+            }
+        }
+        if (nDigits == 0) {
+            return;
+        }
+        values[nCount++] = (int32_t)(bNegative ? -nNumber : nNumber);
+        if (nPos == nSize) {
+            break;
+        }
+        if ((strValue[nPos] != _T(',')) || (nCount == 4)) {
+            return;
+        }
+        ++nPos;
+    }
+    if (nCount == 1) {
+        value.m_type = CompiledLayoutValueType::kInt;
+    }
+    else if (nCount == 2) {
+        value.m_type = CompiledLayoutValueType::kSize;
+    }
+    else if (nCount == 4) {
+        value.m_type = CompiledLayoutValueType::kRect;
+    }
+    else {
+        return;
+    }
+    for (size_t i = 0; i < nCount; ++i) {
+        value.m_values[i] = values[i];
+    }
+}
+
+void CompiledLayout::CompileXmlNodeAttributes(const pugi::xml_node& xmlNode, CompiledLayoutNode& node)
+{
+    node.m_nFirstAttr = (uint32_t)m_attrs.size();
+    node.m_nAttrCount = 0;
+    for (pugi::xml_attribute attr : xmlNode.attributes()) {
+        CompiledLayoutAttr layoutAttr;
+        const DString strValue = attr.value();
+        layoutAttr.m_nName = AddString(attr.name());
+        layoutAttr.m_nValue = AddString(strValue);
+        ParseTypedValue(strValue, layoutAttr.m_value);
+        m_attrs.push_back(layoutAttr);
+        ++node.m_nAttrCount;
+    }
+
+    //"class"属性（必须是第一个属性）：预先拆分为Class名称列表
+    node.m_nFirstClass = (uint32_t)m_classNames.size();
+    node.m_nClassCount = 0;
+    if ((node.m_nodeType == CompiledLayoutNodeType::kControl) ||
+        (node.m_nodeType == CompiledLayoutNodeType::kTreeNode) ||
+        (node.m_nodeType == CompiledLayoutNodeType::kRichText)) {
+        if ((node.m_nAttrCount > 0) && (m_strings[m_attrs[node.m_nFirstAttr].m_nName] == _T("class"))) {
+            const DString strClass = m_strings[m_attrs[node.m_nFirstAttr].m_nValue];
+            std::list<DString> classNames = StringUtil::Split(strClass, _T(" "));
+            for (const DString& className : classNames) {
+                if (!className.empty()) {
+                    m_classNames.push_back(AddString(className));
+                    ++node.m_nClassCount;
+                }
+            }
+        }
+    }
+
+    //Include节点：预先读取被包含的文件和包含次数
+    node.m_nInclude = kInvalidIndex;
+    if (node.m_nodeType == CompiledLayoutNodeType::kInclude) {
+        DString sourceValue = xmlNode.attribute(_T("src")).as_string();
+        if (sourceValue.empty()) {
+            sourceValue = xmlNode.attribute(_T("source")).as_string();
+        }
+        CompiledLayoutInclude include;
+        include.m_nSource = AddString(sourceValue);
+        include.m_nCount = StringUtil::StringToInt32(DString(xmlNode.attribute(_T("count")).as_string()));
+        if (include.m_nCount <= 0) {
+            //默认值设置为1，count这个属性参数为可选
+            include.m_nCount = 1;
+        }
+        node.m_nInclude = (uint32_t)m_includes.size();
+        m_includes.push_back(include);
+    }
+}
+
+bool CompiledLayout::CompileXml(const pugi::xml_document& xmlDoc, uint64_t nSourceHash, uint64_t nSourceSize, int64_t nSourceTime)
+{
+    Clear();
+    pugi::xml_node root = xmlDoc.root().first_child();
+    while (!root.empty() && (root.type() != pugi::node_element)) {
+        root = root.next_sibling();
+    }
+    if (root.empty()) {
+        return false;
+    }
+    m_nSourceHash = nSourceHash;
+    m_nSourceSize = nSourceSize;
+    m_nSourceTime = nSourceTime;
+
+    //空串固定为下标0
+    AddString(DString());
+
+    CompiledLayoutNode rootNode;
+    rootNode.m_nName = AddString(root.name());
+    CompileXmlNodeAttributes(root, rootNode);
+    rootNode.m_nRichText = kInvalidIndex;
+    m_nodes.push_back(rootNode);
+
+    //按层次遍历，保证同一节点的子节点连续存储
+    std::deque<std::pair<pugi::xml_node, uint32_t>> pendingNodes;
+    pendingNodes.push_back({ root, 0 });
+    while (!pendingNodes.empty()) {
+        pugi::xml_node xmlNode = pendingNodes.front().first;
+        uint32_t nNodeIndex = pendingNodes.front().second;
+        pendingNodes.pop_front();
+        CompileXmlNodeChildren(xmlNode, nNodeIndex);
+
+        const CompiledLayoutNode& node = m_nodes[nNodeIndex];
+        uint32_t nChildIndex = node.m_nFirstChild;
+        for (pugi::xml_node xmlChild : xmlNode.children()) {
+            if (xmlChild.type() != pugi::node_element) {
+                continue;
+            }
+            if (m_nodes[nChildIndex].m_nodeType != CompiledLayoutNodeType::kRichText) {
+                pendingNodes.push_back({ xmlChild, nChildIndex });
+            }
+            ++nChildIndex;
+        }
+    }
+    m_stringIndexMap.clear();
+    return true;
+}
+
+void CompiledLayout::CompileXmlNodeChildren(const pugi::xml_node& xmlNode, uint32_t nNodeIndex)
+{
+    const uint32_t nFirstChild = (uint32_t)m_nodes.size();
+    uint32_t nChildCount = 0;
+    for (pugi::xml_node xmlChild : xmlNode.children()) {
+        if (xmlChild.type() != pugi::node_element) {
+            //忽略文本、注释等非元素节点
+            continue;
+        }
+        CompiledLayoutNode node;
+        const DString nodeName = xmlChild.name();
+        node.m_nName = AddString(nodeName);
+        node.m_nRichText = kInvalidIndex;
+        if (nodeName == _T("Include")) {
+            node.m_nodeType = CompiledLayoutNodeType::kInclude;
+        }
+        else if (nodeName == _T("Event")) {
+            node.m_nodeType = CompiledLayoutNodeType::kEvent;
+        }
+        else if (nodeName == _T("BubbledEvent")) {
+            node.m_nodeType = CompiledLayoutNodeType::kBubbledEvent;
+        }
+        else if ((nodeName == _T("DefaultFontFamilyNames")) ||
+                 (nodeName == _T("Font")) ||
+                 (nodeName == _T("FontFile")) ||
+                 (nodeName == _T("FontResource")) ||
+                 (nodeName == _T("Image")) ||
+                 (nodeName == _T("Class")) ||
+                 (nodeName == _T("TextColor"))) {
+            node.m_nodeType = CompiledLayoutNodeType::kResource;
+        }
+        else if (nodeName == DUI_CTR_TREENODE) {
+            node.m_nodeType = CompiledLayoutNodeType::kTreeNode;
+        }
+        else if (nodeName == DUI_CTR_RICHTEXT) {
+            //RichText的子节点是带格式的文本，保存为XML文本，创建控件时再解析
+            node.m_nodeType = CompiledLayoutNodeType::kRichText;
+            CompiledLayoutXmlWriter writer;
+#ifdef DUILIB_UNICODE
+            xmlChild.print(writer, _T(""), pugi::format_raw, pugi::xml_encoding::encoding_utf16);
+            DString richText((const DString::value_type*)writer.m_buffer.data(), writer.m_buffer.size() / sizeof(DString::value_type));
+#else
+            xmlChild.print(writer, _T(""), pugi::format_raw, pugi::xml_encoding::encoding_utf8);
+            DString richText(writer.m_buffer);
+#endif
+            node.m_nRichText = AddString(richText);
+        }
+        CompileXmlNodeAttributes(xmlChild, node);
+        m_nodes.push_back(node);
+        ++nChildCount;
+    }
+    CompiledLayoutNode& parentNode = m_nodes[nNodeIndex];
+    parentNode.m_nFirstChild = nFirstChild;
+    parentNode.m_nChildCount = nChildCount;
+}
+
+bool CompiledLayout::SaveToData(std::vector<uint8_t>& data) const
+{
+    data.clear();
+    if (m_nodes.empty()) {
+        return false;
+    }
+    CompiledLayoutHeader header;
+    header.m_nMagic = kCompiledLayoutMagic;
+    header.m_nVersion = kCompiledLayoutVersion;
+    header.m_nCharSize = (uint32_t)sizeof(DString::value_type);
+    header.m_nStringCount = (uint32_t)m_strings.size();
+    header.m_nNodeCount = (uint32_t)m_nodes.size();
+    header.m_nAttrCount = (uint32_t)m_attrs.size();
+    header.m_nClassNameCount = (uint32_t)m_classNames.size();
+    header.m_nIncludeCount = (uint32_t)m_includes.size();
+    header.m_nSourceHash = m_nSourceHash;
+    header.m_nSourceSize = m_nSourceSize;
+    header.m_nSourceTime = m_nSourceTime;
+    AppendData(data, header);
+
+    for (const DString& str : m_strings) {
+        AppendData(data, (uint32_t)str.size());
+        const uint8_t* p = (const uint8_t*)str.c_str();
+        data.insert(data.end(), p, p + str.size() * sizeof(DString::value_type));
+    }
+    for (const CompiledLayoutNode& node : m_nodes) {
+        CompiledLayoutNodeData nodeData;
+        nodeData.m_nName = node.m_nName;
+        nodeData.m_nFirstAttr = node.m_nFirstAttr;
+        nodeData.m_nAttrCount = node.m_nAttrCount;
+        nodeData.m_nFirstChild = node.m_nFirstChild;
+        nodeData.m_nChildCount = node.m_nChildCount;
+        nodeData.m_nRichText = node.m_nRichText;
+        nodeData.m_nFirstClass = node.m_nFirstClass;
+        nodeData.m_nClassCount = node.m_nClassCount;
+        nodeData.m_nInclude = node.m_nInclude;
+        nodeData.m_nNodeType = (uint32_t)node.m_nodeType;
+        AppendData(data, nodeData);
+    }
+    for (const CompiledLayoutAttr& attr : m_attrs) {
+        CompiledLayoutAttrData attrData;
+        attrData.m_nName = attr.m_nName;
+        attrData.m_nValue = attr.m_nValue;
+        attrData.m_nValueType = (uint32_t)attr.m_value.m_type;
+        for (size_t i = 0; i < 4; ++i) {
+            attrData.m_values[i] = attr.m_value.m_values[i];
+        }
+        AppendData(data, attrData);
+    }
+    for (uint32_t nClassName : m_classNames) {
+        AppendData(data, nClassName);
+    }
+    for (const CompiledLayoutInclude& include : m_includes) {
+        CompiledLayoutIncludeData includeData;
+        includeData.m_nSource = include.m_nSource;
+        includeData.m_nCount = include.m_nCount;
+        AppendData(data, includeData);
+    }
+    return true;
+}
+
+bool CompiledLayout::LoadFromData(const uint8_t* pData, size_t nDataSize)
+{
+    Clear();
+    if ((pData == nullptr) || (nDataSize == 0)) {
+        return false;
+    }
+    const uint8_t* pDataEnd = pData + nDataSize;
+    CompiledLayoutHeader header;
+    if (!ReadData(pData, pDataEnd, header)) {
+        return false;
+    }
+    if ((header.m_nMagic != kCompiledLayoutMagic) ||
+        (header.m_nVersion != kCompiledLayoutVersion) ||
+        (header.m_nCharSize != (uint32_t)sizeof(DString::value_type))) {
+        return false;
+    }
+    if ((header.m_nStringCount == 0) || (header.m_nNodeCount == 0)) {
+        return false;
+    }
+    //各个表的数量必须与剩余的数据长度相符（每个字符串至少包含长度字段），避免损坏的数据导致分配过大的内存
+    const uint64_t nMinDataSize = (uint64_t)header.m_nStringCount * sizeof(uint32_t) +
+                                  (uint64_t)header.m_nNodeCount * sizeof(CompiledLayoutNodeData) +
+                                  (uint64_t)header.m_nAttrCount * sizeof(CompiledLayoutAttrData) +
+                                  (uint64_t)header.m_nClassNameCount * sizeof(uint32_t) +
+                                  (uint64_t)header.m_nIncludeCount * sizeof(CompiledLayoutIncludeData);
+    if (nMinDataSize > (uint64_t)(pDataEnd - pData)) {
+        ASSERT(!"CompiledLayout::LoadFromData: invalid data!");
+        return false;
+    }
+
+    bool bValid = true;
+    m_strings.resize(header.m_nStringCount);
+    for (DString& str : m_strings) {
+        uint32_t nLength = 0;
+        if (!ReadData(pData, pDataEnd, nLength) ||
+            ((size_t)(pDataEnd - pData) / sizeof(DString::value_type) < nLength)) {
+            bValid = false;
+            break;
+        }
+        str.assign((const DString::value_type*)pData, nLength);
+        pData += nLength * sizeof(DString::value_type);
+    }
+    if (bValid) {
+        m_nodes.resize(header.m_nNodeCount);
+        for (uint32_t nNodeIndex = 0; nNodeIndex < header.m_nNodeCount; ++nNodeIndex) {
+            CompiledLayoutNode& node = m_nodes[nNodeIndex];
+            CompiledLayoutNodeData nodeData;
+            //子节点必须位于父节点之后（编译时按此顺序存储），避免损坏的数据形成环，创建控件时无限递归
+            if (!ReadData(pData, pDataEnd, nodeData) ||
+                ((nodeData.m_nChildCount > 0) && (nodeData.m_nFirstChild <= nNodeIndex)) ||
+                (nodeData.m_nName >= header.m_nStringCount) ||
+                (nodeData.m_nNodeType > (uint32_t)CompiledLayoutNodeType::kRichText) ||
+                ((uint64_t)nodeData.m_nFirstAttr + nodeData.m_nAttrCount > header.m_nAttrCount) ||
+                ((uint64_t)nodeData.m_nFirstChild + nodeData.m_nChildCount > header.m_nNodeCount) ||
+                ((uint64_t)nodeData.m_nFirstClass + nodeData.m_nClassCount > header.m_nClassNameCount) ||
+                ((nodeData.m_nInclude != kInvalidIndex) && (nodeData.m_nInclude >= header.m_nIncludeCount)) ||
+                ((nodeData.m_nRichText != kInvalidIndex) && (nodeData.m_nRichText >= header.m_nStringCount))) {
+                bValid = false;
+                break;
+            }
+            node.m_nName = nodeData.m_nName;
+            node.m_nFirstAttr = nodeData.m_nFirstAttr;
+            node.m_nAttrCount = nodeData.m_nAttrCount;
+            node.m_nFirstChild = nodeData.m_nFirstChild;
+            node.m_nChildCount = nodeData.m_nChildCount;
+            node.m_nRichText = nodeData.m_nRichText;
+            node.m_nFirstClass = nodeData.m_nFirstClass;
+            node.m_nClassCount = nodeData.m_nClassCount;
+            node.m_nInclude = nodeData.m_nInclude;
+            node.m_nodeType = (CompiledLayoutNodeType)nodeData.m_nNodeType;
+        }
+    }
+    if (bValid) {
+        m_attrs.resize(header.m_nAttrCount);
+        for (CompiledLayoutAttr& attr : m_attrs) {
+            CompiledLayoutAttrData attrData;
+            if (!ReadData(pData, pDataEnd, attrData) ||
+                (attrData.m_nName >= header.m_nStringCount) ||
+                (attrData.m_nValue >= header.m_nStringCount) ||
+                (attrData.m_nValueType > (uint32_t)CompiledLayoutValueType::kColor)) {
+                bValid = false;
+                break;
+            }
+            attr.m_nName = attrData.m_nName;
+            attr.m_nValue = attrData.m_nValue;
+            attr.m_value.m_type = (CompiledLayoutValueType)attrData.m_nValueType;
+            for (size_t i = 0; i < 4; ++i) {
+                attr.m_value.m_values[i] = attrData.m_values[i];
+            }
+        }
+    }
+    if (bValid) {
+        m_classNames.resize(header.m_nClassNameCount);
+        for (uint32_t& nClassName : m_classNames) {
+            if (!ReadData(pData, pDataEnd, nClassName) || (nClassName >= header.m_nStringCount)) {
+                bValid = false;
+                break;
+            }
+        }
+    }
+    if (bValid) {
+        m_includes.resize(header.m_nIncludeCount);
+        for (CompiledLayoutInclude& include : m_includes) {
+            CompiledLayoutIncludeData includeData;
+            if (!ReadData(pData, pDataEnd, includeData) || (includeData.m_nSource >= header.m_nStringCount)) {
+                bValid = false;
+                break;
+            }
+            include.m_nSource = includeData.m_nSource;
+            include.m_nCount = includeData.m_nCount;
+        }
+    }
+    if (!bValid) {
+        ASSERT(!"CompiledLayout::LoadFromData: invalid data!");
+        Clear();
+        return false;
+    }
+    m_nSourceHash = header.m_nSourceHash;
+    m_nSourceSize = header.m_nSourceSize;
+    m_nSourceTime = header.m_nSourceTime;
+    return true;
+}
+
+void CompiledLayout::ResolveClassIndex(const std::function<int32_t(const DString&)>& getClassIndex)
+{
+    if (getClassIndex == nullptr) {
+        return;
+    }
+    for (CompiledLayoutNode& node : m_nodes) {
+        if ((node.m_nodeType == CompiledLayoutNodeType::kControl) ||
+            (node.m_nodeType == CompiledLayoutNodeType::kTreeNode) ||
+            (node.m_nodeType == CompiledLayoutNodeType::kRichText)) {
+            node.m_nClassIndex = getClassIndex(m_strings[node.m_nName]);
+        }
+        else {
+            node.m_nClassIndex = -1;
+        }
+    }
+}
+
+void CompiledLayout::ResolveIncludePath(const std::function<FilePath(const DString&)>& getIncludePath)
+{
+    m_includePaths.clear();
+    if (getIncludePath == nullptr) {
+        return;
+    }
+    m_includePaths.reserve(m_includes.size());
+    for (const CompiledLayoutInclude& include : m_includes) {
+        const DString& sourceValue = m_strings[include.m_nSource];
+        m_includePaths.push_back(sourceValue.empty() ? FilePath() : getIncludePath(sourceValue));
+    }
+}
+
+const CompiledLayoutNode* CompiledLayout::GetRootNode() const
+{
+    if (m_nodes.empty()) {
+        return nullptr;
+    }
+    return &m_nodes.front();
+}
+
+const CompiledLayoutNode& CompiledLayout::GetChildNode(const CompiledLayoutNode& node, uint32_t nIndex) const
+{
+    ASSERT(nIndex < node.m_nChildCount);
+    return m_nodes[node.m_nFirstChild + nIndex];
+}
+
+const DString& CompiledLayout::GetNodeName(const CompiledLayoutNode& node) const
+{
+    return m_strings[node.m_nName];
+}
+
+const DString& CompiledLayout::GetAttrName(const CompiledLayoutNode& node, uint32_t nIndex) const
+{
+    ASSERT(nIndex < node.m_nAttrCount);
+    return m_strings[m_attrs[node.m_nFirstAttr + nIndex].m_nName];
+}
+
+const DString& CompiledLayout::GetAttrValue(const CompiledLayoutNode& node, uint32_t nIndex) const
+{
+    ASSERT(nIndex < node.m_nAttrCount);
+    return m_strings[m_attrs[node.m_nFirstAttr + nIndex].m_nValue];
+}
+
+const CompiledLayoutValue& CompiledLayout::GetAttrTypedValue(const CompiledLayoutNode& node, uint32_t nIndex) const
+{
+    ASSERT(nIndex < node.m_nAttrCount);
+    return m_attrs[node.m_nFirstAttr + nIndex].m_value;
+}
+
+const DString& CompiledLayout::FindAttrValue(const CompiledLayoutNode& node, const DString& attrName) const
+{
+    for (uint32_t i = 0; i < node.m_nAttrCount; ++i) {
+        const CompiledLayoutAttr& attr = m_attrs[node.m_nFirstAttr + i];
+        if (m_strings[attr.m_nName] == attrName) {
+            return m_strings[attr.m_nValue];
+        }
+    }
+    return m_strings.front();
+}
+
+const DString& CompiledLayout::GetNodeClassName(const CompiledLayoutNode& node, uint32_t nIndex) const
+{
+    ASSERT(nIndex < node.m_nClassCount);
+    return m_strings[m_classNames[node.m_nFirstClass + nIndex]];
+}
+
+int32_t CompiledLayout::GetIncludeCount(const CompiledLayoutNode& node) const
+{
+    if (node.m_nInclude < m_includes.size()) {
+        return m_includes[node.m_nInclude].m_nCount;
+    }
+    return 0;
+}
+
+const FilePath& CompiledLayout::GetIncludePath(const CompiledLayoutNode& node) const
+{
+    if (node.m_nInclude < m_includePaths.size()) {
+        return m_includePaths[node.m_nInclude];
+    }
+    static const FilePath emptyPath;
+    return emptyPath;
+}
+
+const DString& CompiledLayout::GetString(uint32_t nIndex) const
+{
+    ASSERT(nIndex < m_strings.size());
+    return m_strings[nIndex];
+}
+
+/** 布局数据的缓存
+*/
+class CompiledLayoutCache
+{
+public:
+    static CompiledLayoutCache& Instance()
+    {
+        static CompiledLayoutCache self;
+        return self;
+    }
+
+    std::shared_ptr<const CompiledLayout> Find(const DString& cacheKey, uint64_t nFileSize, int64_t nFileTime)
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        auto iter = m_layoutMap.find(cacheKey);
+        if (iter == m_layoutMap.end()) {
+            return nullptr;
+        }
+        const CacheItem& cacheItem = iter->second;
+        if ((cacheItem.m_nFileSize != nFileSize) || (cacheItem.m_nFileTime != nFileTime)) {
+            //XML源文件已经修改，缓存过期
+            m_layoutMap.erase(iter);
+            return nullptr;
+        }
+        return cacheItem.m_spLayout;
+    }
+
+    void Add(const DString& cacheKey, uint64_t nFileSize, int64_t nFileTime, const std::shared_ptr<const CompiledLayout>& spLayout)
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        CacheItem& cacheItem = m_layoutMap[cacheKey];
+        cacheItem.m_spLayout = spLayout;
+        cacheItem.m_nFileSize = nFileSize;
+        cacheItem.m_nFileTime = nFileTime;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        m_layoutMap.clear();
+    }
+
+private:
+    /** 缓存项：布局数据及添加缓存时XML文件的大小和最后修改时间（命中缓存时不需要读取XML文件）
+    */
+    struct CacheItem
+    {
+        std::shared_ptr<const CompiledLayout> m_spLayout;
+        uint64_t m_nFileSize = 0;
+        int64_t m_nFileTime = 0;
+    };
+    std::mutex m_mutex;
+    std::unordered_map<DString, CacheItem> m_layoutMap;
+};
+
+std::shared_ptr<const CompiledLayout> CompiledLayout::FindCache(const DString& cacheKey, uint64_t nFileSize, int64_t nFileTime)
+{
+    return CompiledLayoutCache::Instance().Find(cacheKey, nFileSize, nFileTime);
+}
+
+void CompiledLayout::AddCache(const DString& cacheKey, uint64_t nFileSize, int64_t nFileTime,
+                              const std::shared_ptr<const CompiledLayout>& spLayout)
+{
+    ASSERT(spLayout != nullptr);
+    if (spLayout != nullptr) {
+        CompiledLayoutCache::Instance().Add(cacheKey, nFileSize, nFileTime, spLayout);
+    }
+}
+
+void CompiledLayout::ClearCache()
+{
+    CompiledLayoutCache::Instance().Clear();
+}
+
+} // namespace ui
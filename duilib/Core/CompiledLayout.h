@@ -0,0 +1,297 @@
+#ifndef UI_CORE_COMPILED_LAYOUT_H_
+#define UI_CORE_COMPILED_LAYOUT_H_
+
+#include "duilib/duilib_defs.h"
+#include "duilib/Utils/FilePath.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+
+namespace pugi
+{
+    //XML 解析器相关定义
+    class xml_document;
+    class xml_node;
+}
+
+namespace ui
+{
+/** 预编译布局的节点类型（编译时根据节点名称预先确定，创建控件时不再需要比较节点名称）
+*/
+enum class CompiledLayoutNodeType: uint8_t
+{
+    kControl        = 0,    //普通节点（控件、容器，或者根节点"Window"/"Global"）
+    kInclude        = 1,    //<Include>节点
+    kEvent          = 2,    //<Event>节点
+    kBubbledEvent   = 3,    //<BubbledEvent>节点
+    kResource       = 4,    //资源定义节点（Font/FontFile/Class/TextColor等），创建控件时忽略
+    kTreeNode       = 5,    //<TreeNode>节点（需要先添加到父节点，再设置属性）
+    kRichText       = 6     //<RichText>节点（子节点为带格式的文本）
+};
+
+/** 预解析的属性值类型（编译时根据属性值的格式确定，与属性名称无关）
+*/
+enum class CompiledLayoutValueType: uint8_t
+{
+    kString = 0,    //字符串（不是以下任何一种格式）
+    kBool   = 1,    //布尔值："true"或者"false"
+    kInt    = 2,    //整数，比如："12"
+    kSize   = 3,    //两个整数，比如："4,4"
+    kRect   = 4,    //四个整数，比如："1,2,3,4"
+    kColor  = 5     //颜色值，比如："#FF0000FF"或者"#0000FF"
+};
+
+/** 预解析的属性值
+*/
+struct CompiledLayoutValue
+{
+    CompiledLayoutValueType m_type = CompiledLayoutValueType::kString;  //属性值的类型
+    int32_t m_values[4] = { 0, 0, 0, 0 };   //属性值：kBool/kInt为m_values[0]，kSize为前两个值，kRect为四个值，kColor为ARGB值
+};
+
+/** 预编译布局中的XML节点
+*/
+struct CompiledLayoutNode
+{
+    uint32_t m_nName = 0;           //节点名称（字符串表中的下标）
+    uint32_t m_nFirstAttr = 0;      //第一个属性在属性表中的下标
+    uint32_t m_nAttrCount = 0;      //属性个数
+    uint32_t m_nFirstChild = 0;     //第一个子节点在节点表中的下标（同一节点的子节点连续存储）
+    uint32_t m_nChildCount = 0;     //子节点个数
+    uint32_t m_nRichText = 0;       //RichText节点的XML文本（字符串表中的下标），其他节点为kInvalidIndex
+    uint32_t m_nFirstClass = 0;     //第一个Class名称在Class名称表中的下标（"class"属性拆分后的各个名称）
+    uint32_t m_nClassCount = 0;     //Class名称的个数（仅当第一个属性为"class"时不为0）
+    uint32_t m_nInclude = 0;        //Include节点在包含表中的下标，其他节点为kInvalidIndex
+    CompiledLayoutNodeType m_nodeType = CompiledLayoutNodeType::kControl; //节点类型
+    int32_t m_nClassIndex = -1;     //内置控件的类型索引（加载后解析，不保存到二进制数据中），-1表示非内置控件
+};
+
+/** 预编译布局中的XML属性
+*/
+struct CompiledLayoutAttr
+{
+    uint32_t m_nName = 0;           //属性名称（字符串表中的下标）
+    uint32_t m_nValue = 0;          //属性值（字符串表中的下标）
+    CompiledLayoutValue m_value;    //预解析的属性值
+};
+
+/** 预编译布局中的<Include>节点
+*/
+struct CompiledLayoutInclude
+{
+    uint32_t m_nSource = 0;         //被包含的XML文件（"src"或者"source"属性，字符串表中的下标）
+    int32_t m_nCount = 1;           //重复包含的次数（"count"属性）
+};
+
+/** 预编译的布局数据：将XML文件的节点树转换为紧凑的二进制形式（字符串去重，节点和属性连续存储）
+*   1. 创建控件时，直接遍历节点表，不再需要解析XML；数值、矩形、颜色等属性值在编译时预先解析
+*   2. "class"属性在编译时拆分为Class名称列表，Include节点的包含次数和文件路径在加载后解析一次
+*   3. 二进制数据中记录了XML源文件的大小、修改时间和哈希值，源文件修改后，二进制数据自动失效（需要重新解析XML）
+*   4. 二进制数据与字符集相关（DUILIB_UNICODE），并且使用本机字节序，只能在同平台同配置的程序间共享
+*/
+class UILIB_API CompiledLayout
+{
+public:
+    CompiledLayout();
+    ~CompiledLayout();
+
+    CompiledLayout(const CompiledLayout&) = delete;
+    CompiledLayout& operator = (const CompiledLayout&) = delete;
+
+    /** 无效的下标值
+    */
+    static constexpr uint32_t kInvalidIndex = (uint32_t)-1;
+
+public:
+    /** 从XML文档编译布局数据
+    * @param [in] xmlDoc 已经解析完成的XML文档
+    * @param [in] nSourceHash XML源文件数据的哈希值（由HashSourceData计算）
+    * @param [in] nSourceSize XML源文件数据的大小
+    * @param [in] nSourceTime XML源文件的最后修改时间（由FilePath::GetFileInfo获取，未知时为0）
+    */
+    bool CompileXml(const pugi::xml_document& xmlDoc, uint64_t nSourceHash, uint64_t nSourceSize, int64_t nSourceTime);
+
+    /** 将布局数据保存为二进制数据
+    */
+    bool SaveToData(std::vector<uint8_t>& data) const;
+
+    /** 从二进制数据加载布局数据（加载后，由调用方比较XML源文件的大小、修改时间或者哈希值，判断数据是否过期）
+    * @param [in] pData 二进制数据
+    * @param [in] nDataSize 二进制数据的长度
+    */
+    bool LoadFromData(const uint8_t* pData, size_t nDataSize);
+
+    /** 解析内置控件的类型索引（加载或编译完成后调用一次）
+    * @param [in] getClassIndex 根据节点名称获取内置控件类型索引的函数，返回-1表示不是内置控件
+    */
+    void ResolveClassIndex(const std::function<int32_t(const DString&)>& getClassIndex);
+
+    /** 解析Include节点的文件路径（加载或编译完成后调用一次）
+    * @param [in] getIncludePath 根据"src"属性值获取被包含XML文件路径的函数
+    */
+    void ResolveIncludePath(const std::function<FilePath(const DString&)>& getIncludePath);
+
+    /** 计算XML源文件数据的哈希值（FNV-1a 64位）
+    */
+    static uint64_t HashSourceData(const uint8_t* pData, size_t nDataSize);
+
+    /** 获取XML源文件数据的哈希值
+    */
+    uint64_t GetSourceHash() const { return m_nSourceHash; }
+
+    /** 获取XML源文件数据的大小
+    */
+    uint64_t GetSourceSize() const { return m_nSourceSize; }
+
+    /** 获取XML源文件的最后修改时间
+    */
+    int64_t GetSourceTime() const { return m_nSourceTime; }
+
+    /** 设置XML源文件的最后修改时间（按哈希值校验通过后，更新为当前的修改时间）
+    */
+    void SetSourceTime(int64_t nSourceTime) { m_nSourceTime = nSourceTime; }
+
+public:
+    /** 获取根节点（XML文档的第一个节点），如果布局数据为空返回nullptr
+    */
+    const CompiledLayoutNode* GetRootNode() const;
+
+    /** 获取子节点
+    * @param [in] node 父节点
+    * @param [in] nIndex 子节点的序号，有效范围：[0, node.m_nChildCount)
+    */
+    const CompiledLayoutNode& GetChildNode(const CompiledLayoutNode& node, uint32_t nIndex) const;
+
+    /** 获取节点的名称
+    */
+    const DString& GetNodeName(const CompiledLayoutNode& node) const;
+
+    /** 获取属性的名称
+    * @param [in] node 节点
+    * @param [in] nIndex 属性的序号，有效范围：[0, node.m_nAttrCount)
+    */
+    const DString& GetAttrName(const CompiledLayoutNode& node, uint32_t nIndex) const;
+
+    /** 获取属性的值
+    * @param [in] node 节点
+    * @param [in] nIndex 属性的序号，有效范围：[0, node.m_nAttrCount)
+    */
+    const DString& GetAttrValue(const CompiledLayoutNode& node, uint32_t nIndex) const;
+
+    /** 获取预解析的属性值
+    * @param [in] node 节点
+    * @param [in] nIndex 属性的序号，有效范围：[0, node.m_nAttrCount)
+    */
+    const CompiledLayoutValue& GetAttrTypedValue(const CompiledLayoutNode& node, uint32_t nIndex) const;
+
+    /** 根据属性名称查找属性的值，如果不存在该属性，返回空串
+    */
+    const DString& FindAttrValue(const CompiledLayoutNode& node, const DString& attrName) const;
+
+    /** 获取节点的Class名称（"class"属性拆分后的名称）
+    * @param [in] node 节点
+    * @param [in] nIndex Class名称的序号，有效范围：[0, node.m_nClassCount)
+    */
+    const DString& GetNodeClassName(const CompiledLayoutNode& node, uint32_t nIndex) const;
+
+    /** 获取Include节点的包含次数
+    */
+    int32_t GetIncludeCount(const CompiledLayoutNode& node) const;
+
+    /** 获取Include节点的被包含XML文件路径（由ResolveIncludePath解析）
+    */
+    const FilePath& GetIncludePath(const CompiledLayoutNode& node) const;
+
+    /** 获取字符串表中的字符串
+    */
+    const DString& GetString(uint32_t nIndex) const;
+
+public:
+    /** 从缓存中查找布局数据（线程安全）
+    * @param [in] cacheKey 缓存的关键字（XML文件的完整路径）
+    * @param [in] nFileSize 当前XML文件的大小，与添加缓存时的不一致时，返回nullptr
+    * @param [in] nFileTime 当前XML文件的最后修改时间，与添加缓存时的不一致时，返回nullptr
+    */
+    static std::shared_ptr<const CompiledLayout> FindCache(const DString& cacheKey, uint64_t nFileSize, int64_t nFileTime);
+
+    /** 添加布局数据到缓存（线程安全），如果已经存在，则替换
+    * @param [in] cacheKey 缓存的关键字（XML文件的完整路径）
+    * @param [in] nFileSize 当前XML文件的大小
+    * @param [in] nFileTime 当前XML文件的最后修改时间
+    * @param [in] spLayout 布局数据
+    */
+    static void AddCache(const DString& cacheKey, uint64_t nFileSize, int64_t nFileTime,
+                         const std::shared_ptr<const CompiledLayout>& spLayout);
+
+    /** 清空缓存（线程安全）
+    */
+    static void ClearCache();
+
+private:
+    /** 添加字符串到字符串表，返回下标（相同的字符串只保存一份）
+    */
+    uint32_t AddString(const DString& str);
+
+    /** 编译XML节点的属性
+    */
+    void CompileXmlNodeAttributes(const pugi::xml_node& xmlNode, CompiledLayoutNode& node);
+
+    /** 编译XML节点的子节点
+    */
+    void CompileXmlNodeChildren(const pugi::xml_node& xmlNode, uint32_t nNodeIndex);
+
+    /** 按属性值的格式预解析属性值
+    */
+    static void ParseTypedValue(const DString& strValue, CompiledLayoutValue& value);
+
+    /** 清空数据
+    */
+    void Clear();
+
+private:
+    /** 字符串表
+    */
+    std::vector<DString> m_strings;
+
+    /** 节点表（第一个节点为根节点）
+    */
+    std::vector<CompiledLayoutNode> m_nodes;
+
+    /** 属性表
+    */
+    std::vector<CompiledLayoutAttr> m_attrs;
+
+    /** Class名称表（字符串表中的下标）
+    */
+    std::vector<uint32_t> m_classNames;
+
+    /** 包含表
+    */
+    std::vector<CompiledLayoutInclude> m_includes;
+
+    /** 被包含XML文件的路径（与包含表一一对应，加载后解析，不保存到二进制数据中）
+    */
+    std::vector<FilePath> m_includePaths;
+
+    /** 字符串在字符串表中的下标（仅编译过程中使用，用于字符串去重）
+    */
+    std::unordered_map<DString, uint32_t> m_stringIndexMap;
+
+    /** XML源文件数据的哈希值
+    */
+    uint64_t m_nSourceHash;
+
+    /** XML源文件数据的大小
+    */
+    uint64_t m_nSourceSize;
+
+    /** XML源文件的最后修改时间
+    */
+    int64_t m_nSourceTime;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_COMPILED_LAYOUT_H_
@@ -0,0 +1,334 @@
+#include "CompiledStringTable.h"
+#include "duilib/Core/CompiledLayout.h"
+#include "duilib/Utils/FileMapping.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+
+namespace ui
+{
+/** 二进制数据的文件头标识："DULS"
+*/
+static constexpr uint32_t kCompiledStringTableMagic = 0x534C5544;
+
+/** 二进制数据的格式版本号，格式有变化时需要增加
+*/
+static constexpr uint32_t kCompiledStringTableVersion = 1;
+
+/** 二进制数据的文件头
+*/
+struct CompiledStringTableHeader
+{
+    uint32_t m_nMagic;          //文件头标识
+    uint32_t m_nVersion;        //格式版本号
+    uint32_t m_nCharSize;       //字符的大小：sizeof(DString::value_type)
+    uint32_t m_nEntryCount;     //索引表中的项数
+    uint64_t m_nSourceHash;     //语言源文件数据的哈希值
+    uint64_t m_nSourceSize;     //语言源文件数据的大小
+    uint32_t m_nStringLength;   //字符串区的字符个数
+    uint32_t m_nReserved;       //保留，为0
+};
+
+/** 索引表中的项（按ID的哈希值排序，哈希值相同时按ID排序）
+*   ID和文本在字符串区中以'\0'结尾，长度不含结尾的'\0'
+*/
+struct CompiledStringEntry
+{
+    uint32_t m_nIdHash;         //ID的哈希值
+    uint32_t m_nIdOffset;       //ID在字符串区中的位置（字符）
+    uint32_t m_nIdLength;       //ID的长度（字符）
+    uint32_t m_nValueOffset;    //文本在字符串区中的位置（字符）
+    uint32_t m_nValueLength;    //文本的长度（字符）
+};
+
+//索引表和字符串区紧跟在文件头之后，按4字节对齐即可直接访问
+static_assert((sizeof(CompiledStringTableHeader) % 4) == 0, "CompiledStringTableHeader size");
+static_assert((sizeof(CompiledStringEntry) % 4) == 0, "CompiledStringEntry size");
+static_assert(sizeof(DString::value_type) <= 4, "DString::value_type size");
+
+/** 计算ID的哈希值（FNV-1a 32位）
+*/
+static uint32_t HashStringId(DStringView id)
+{
+    uint32_t nHash = 2166136261U;
+    for (DString::value_type ch : id) {
+        nHash ^= (uint32_t)ch;
+        nHash *= 16777619U;
+    }
+    return nHash;
+}
+
+CompiledStringTable::CompiledStringTable():
+    m_pEntryData(nullptr),
+    m_nEntryCount(0),
+    m_pStrings(nullptr),
+    m_nStringLength(0),
+    m_nDataSize(0)
+{
+}
+
+CompiledStringTable::~CompiledStringTable()
+{
+    Clear();
+}
+
+void CompiledStringTable::Clear()
+{
+    m_pEntryData = nullptr;
+    m_nEntryCount = 0;
+    m_pStrings = nullptr;
+    m_nStringLength = 0;
+    m_nDataSize = 0;
+    m_data.clear();
+    m_pFileMapping.reset();
+}
+
+bool CompiledStringTable::CompileText(const uint8_t* pData, size_t nDataSize)
+{
+    Clear();
+    if ((pData == nullptr) || (nDataSize == 0)) {
+        return false;
+    }
+    size_t bomSize = 0;
+    if ((nDataSize >= 3) && (pData[0] == 0xEF) && (pData[1] == 0xBB) && (pData[2] == 0xBF)) {
+        //跳过UTF8的BOM头
+        bomSize = 3;
+    }
+
+    //逐行解析，每行的格式为："ID=文本"，以";"开头的行为注释，ID重复时使用后面的文本
+    std::vector<std::pair<DString, DString>> items;
+    std::unordered_map<DString, size_t> itemIndexMap;
+    const char* p = (const char*)pData + bomSize;
+    const char* pEnd = (const char*)pData + nDataSize;
+    while (p < pEnd) {
+        const char* pLineEnd = p;
+        while ((pLineEnd < pEnd) && (*pLineEnd != '\r') && (*pLineEnd != '\n') && (*pLineEnd != '\0')) {
+            ++pLineEnd;
+        }
+        if (pLineEnd > p) {
+            DString line = StringConvert::UTF8ToT(p, (size_t)(pLineEnd - p));
+            StringUtil::Trim(line);
+            const size_t pos = line.find(_T('='));
+            if (!line.empty() && (line.at(0) != _T(';')) && (pos != DString::npos)) {
+                DString id = line.substr(0, pos);
+                StringUtil::Trim(id);
+                DString value;
+                if ((pos + 1) < line.size()) {
+                    value = line.substr(pos + 1);
+                    StringUtil::Trim(value);
+                    //将\n和\r替换为真实的换行符、回车符
+                    StringUtil::ReplaceAll(_T("\\r"), _T("\r"), value);
+                    StringUtil::ReplaceAll(_T("\\n"), _T("\n"), value);
+                }
+                if (!id.empty()) {
+                    auto iter = itemIndexMap.find(id);
+                    if (iter != itemIndexMap.end()) {
+                        items[iter->second].second.swap(value);
+                    }
+                    else {
+                        itemIndexMap[id] = items.size();
+                        items.emplace_back(std::move(id), std::move(value));
+                    }
+                }
+            }
+        }
+        p = pLineEnd + 1;
+    }
+    itemIndexMap.clear();
+
+    //生成索引表：按ID的哈希值排序
+    std::vector<std::pair<uint32_t, size_t>> sortedItems; //ID的哈希值，items中的下标
+    sortedItems.reserve(items.size());
+    size_t nStringLength = 0;
+    for (size_t nIndex = 0; nIndex < items.size(); ++nIndex) {
+        sortedItems.emplace_back(HashStringId(items[nIndex].first), nIndex);
+        nStringLength += items[nIndex].first.size() + items[nIndex].second.size() + 2;
+    }
+    ASSERT(nStringLength < UINT32_MAX);
+    if (nStringLength >= UINT32_MAX) {
+        return false;
+    }
+    std::sort(sortedItems.begin(), sortedItems.end(), [&items](const std::pair<uint32_t, size_t>& a,
+                                                               const std::pair<uint32_t, size_t>& b) {
+            if (a.first != b.first) {
+                return a.first < b.first;
+            }
+            return items[a.second].first < items[b.second].first;
+        });
+
+    CompiledStringTableHeader header;
+    ::memset(&header, 0, sizeof(header));
+    header.m_nMagic = kCompiledStringTableMagic;
+    header.m_nVersion = kCompiledStringTableVersion;
+    header.m_nCharSize = (uint32_t)sizeof(DString::value_type);
+    header.m_nEntryCount = (uint32_t)items.size();
+    header.m_nSourceHash = CompiledLayout::HashSourceData(pData, nDataSize);
+    header.m_nSourceSize = nDataSize;
+    header.m_nStringLength = (uint32_t)nStringLength;
+
+    const size_t nEntryBytes = sortedItems.size() * sizeof(CompiledStringEntry);
+    const size_t nStringBytes = nStringLength * sizeof(DString::value_type);
+    std::vector<uint8_t> data;
+    data.resize(sizeof(header) + nEntryBytes + nStringBytes);
+    ::memcpy(data.data(), &header, sizeof(header));
+    uint8_t* pEntryData = data.data() + sizeof(header);
+    DString::value_type* pStrings = (DString::value_type*)(pEntryData + nEntryBytes);
+    uint32_t nOffset = 0;
+    for (size_t nIndex = 0; nIndex < sortedItems.size(); ++nIndex) {
+        const DString& id = items[sortedItems[nIndex].second].first;
+        const DString& value = items[sortedItems[nIndex].second].second;
+        CompiledStringEntry entry;
+        entry.m_nIdHash = sortedItems[nIndex].first;
+        entry.m_nIdOffset = nOffset;
+        entry.m_nIdLength = (uint32_t)id.size();
+        ::memcpy(pStrings + nOffset, id.c_str(), (id.size() + 1) * sizeof(DString::value_type));
+        nOffset += entry.m_nIdLength + 1;
+        entry.m_nValueOffset = nOffset;
+        entry.m_nValueLength = (uint32_t)value.size();
+        ::memcpy(pStrings + nOffset, value.c_str(), (value.size() + 1) * sizeof(DString::value_type));
+        nOffset += entry.m_nValueLength + 1;
+        ::memcpy(pEntryData + nIndex * sizeof(CompiledStringEntry), &entry, sizeof(entry));
+    }
+    ASSERT(nOffset == nStringLength);
+
+    m_data.swap(data);
+    if (!AttachData(m_data.data(), m_data.size(), 0, 0)) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool CompiledStringTable::LoadFromData(const uint8_t* pData, size_t nDataSize, uint64_t nSourceHash, uint64_t nSourceSize)
+{
+    Clear();
+    if ((pData == nullptr) || (nDataSize == 0)) {
+        return false;
+    }
+    //复制数据（同时保证数据的对齐）
+    m_data.assign(pData, pData + nDataSize);
+    if (!AttachData(m_data.data(), m_data.size(), nSourceHash, nSourceSize)) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool CompiledStringTable::LoadFromFile(const FilePath& filePath, uint64_t nSourceHash, uint64_t nSourceSize)
+{
+    Clear();
+    std::unique_ptr<FileMapping> pFileMapping = std::make_unique<FileMapping>();
+    if (!pFileMapping->Open(filePath)) {
+        return false;
+    }
+    //映射内存按页对齐，可直接访问索引表和字符串区
+    if (!AttachData(pFileMapping->GetData(), pFileMapping->GetSize(), nSourceHash, nSourceSize)) {
+        Clear();
+        return false;
+    }
+    m_pFileMapping = std::move(pFileMapping);
+    return true;
+}
+
+bool CompiledStringTable::IsCompiledData(const uint8_t* pData, size_t nDataSize)
+{
+    uint32_t nMagic = 0;
+    if ((pData == nullptr) || (nDataSize < sizeof(CompiledStringTableHeader))) {
+        return false;
+    }
+    ::memcpy(&nMagic, pData, sizeof(nMagic));
+    return nMagic == kCompiledStringTableMagic;
+}
+
+bool CompiledStringTable::AttachData(const uint8_t* pData, size_t nDataSize, uint64_t nSourceHash, uint64_t nSourceSize)
+{
+    if ((pData == nullptr) || (nDataSize < sizeof(CompiledStringTableHeader)) || (((uintptr_t)pData % 4) != 0)) {
+        return false;
+    }
+    CompiledStringTableHeader header;
+    ::memcpy(&header, pData, sizeof(header));
+    if ((header.m_nMagic != kCompiledStringTableMagic) ||
+        (header.m_nVersion != kCompiledStringTableVersion) ||
+        (header.m_nCharSize != (uint32_t)sizeof(DString::value_type))) {
+        return false;
+    }
+    if ((nSourceSize != 0) && ((header.m_nSourceHash != nSourceHash) || (header.m_nSourceSize != nSourceSize))) {
+        //源文件已经修改，数据已过期
+        return false;
+    }
+    const size_t nEntryBytes = (size_t)header.m_nEntryCount * sizeof(CompiledStringEntry);
+    const size_t nStringBytes = (size_t)header.m_nStringLength * sizeof(DString::value_type);
+    if (nDataSize != (sizeof(header) + nEntryBytes + nStringBytes)) {
+        return false;
+    }
+    const CompiledStringEntry* pEntries = (const CompiledStringEntry*)(pData + sizeof(header));
+    for (uint32_t nIndex = 0; nIndex < header.m_nEntryCount; ++nIndex) {
+        const CompiledStringEntry& entry = pEntries[nIndex];
+        if (((uint64_t)entry.m_nIdOffset + entry.m_nIdLength >= header.m_nStringLength) ||
+            ((uint64_t)entry.m_nValueOffset + entry.m_nValueLength >= header.m_nStringLength)) {
+            return false;
+        }
+    }
+    m_pEntryData = pData + sizeof(header);
+    m_nEntryCount = header.m_nEntryCount;
+    m_pStrings = (const DString::value_type*)(pData + sizeof(header) + nEntryBytes);
+    m_nStringLength = header.m_nStringLength;
+    m_nDataSize = nDataSize;
+    return true;
+}
+
+bool CompiledStringTable::SaveToData(std::vector<uint8_t>& data) const
+{
+    data.clear();
+    if (m_nDataSize == 0) {
+        return false;
+    }
+    const uint8_t* pData = m_pEntryData - sizeof(CompiledStringTableHeader);
+    data.assign(pData, pData + m_nDataSize);
+    return true;
+}
+
+DStringView CompiledStringTable::GetString(uint32_t nOffset, uint32_t nLength) const
+{
+    return DStringView(m_pStrings + nOffset, nLength);
+}
+
+bool CompiledStringTable::Find(DStringView id, DStringView& value) const
+{
+    if (m_nEntryCount == 0) {
+        return false;
+    }
+    const uint32_t nHash = HashStringId(id);
+    const CompiledStringEntry* pBegin = (const CompiledStringEntry*)m_pEntryData;
+    const CompiledStringEntry* pEnd = pBegin + m_nEntryCount;
+    const CompiledStringEntry* pEntry = std::lower_bound(pBegin, pEnd, nHash,
+        [](const CompiledStringEntry& entry, uint32_t nIdHash) {
+            return entry.m_nIdHash < nIdHash;
+        });
+    for (; (pEntry != pEnd) && (pEntry->m_nIdHash == nHash); ++pEntry) {
+        if (GetString(pEntry->m_nIdOffset, pEntry->m_nIdLength) == id) {
+            value = GetString(pEntry->m_nValueOffset, pEntry->m_nValueLength);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t CompiledStringTable::GetCount() const
+{
+    return m_nEntryCount;
+}
+
+size_t CompiledStringTable::GetDataSize() const
+{
+    return m_nDataSize;
+}
+
+bool CompiledStringTable::IsMapped() const
+{
+    return m_pFileMapping != nullptr;
+}
+
+} // namespace ui
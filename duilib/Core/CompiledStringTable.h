@@ -0,0 +1,123 @@
+#ifndef UI_CORE_COMPILED_STRING_TABLE_H_
+#define UI_CORE_COMPILED_STRING_TABLE_H_
+
+#include "duilib/Utils/FilePath.h"
+#include <vector>
+#include <memory>
+
+namespace ui
+{
+class FileMapping;
+
+/** 预编译的语言字符串表：将语言文件（每行格式为"ID=文本"）转换为紧凑的二进制形式
+*   1. 数据由文件头、按ID哈希值排序的索引表、字符串区（所有ID和文本连续存储）组成，整个表只占用一块内存
+*   2. 预编译文件可以直接映射到内存使用（见LoadFromFile），无需解析，也不需要为每个字符串分配内存
+*   3. 查询时在索引表中二分查找，返回指向字符串区的字符串视图，不分配内存
+*   4. 二进制数据中记录了语言源文件的大小和哈希值，源文件修改后，二进制数据自动失效（需要重新解析语言文件）
+*   5. 二进制数据与字符集相关（DUILIB_UNICODE），并且使用本机字节序，只能在同平台同配置的程序间共享
+*/
+class UILIB_API CompiledStringTable
+{
+public:
+    CompiledStringTable();
+    ~CompiledStringTable();
+
+    CompiledStringTable(const CompiledStringTable&) = delete;
+    CompiledStringTable& operator = (const CompiledStringTable&) = delete;
+
+public:
+    /** 解析语言文件的内容，编译为字符串表（可在工作线程中调用）
+    * @param [in] pData 语言文件的数据（UTF8编码，可以含BOM头）
+    * @param [in] nDataSize 语言文件数据的长度
+    */
+    bool CompileText(const uint8_t* pData, size_t nDataSize);
+
+    /** 从二进制数据加载字符串表（复制数据）
+    * @param [in] pData 二进制数据
+    * @param [in] nDataSize 二进制数据的长度
+    * @param [in] nSourceHash 当前语言源文件数据的哈希值，与二进制数据中记录的值不同时，认为数据已过期，加载失败
+    * @param [in] nSourceSize 当前语言源文件数据的大小，如果为0表示源文件不存在，此时不校验哈希值和大小
+    */
+    bool LoadFromData(const uint8_t* pData, size_t nDataSize, uint64_t nSourceHash, uint64_t nSourceSize);
+
+    /** 将预编译文件映射到内存，加载字符串表（不复制数据）
+    * @param [in] filePath 预编译文件的路径（本地绝对路径）
+    * @param [in] nSourceHash 当前语言源文件数据的哈希值，含义同LoadFromData
+    * @param [in] nSourceSize 当前语言源文件数据的大小，含义同LoadFromData
+    */
+    bool LoadFromFile(const FilePath& filePath, uint64_t nSourceHash, uint64_t nSourceSize);
+
+    /** 获取字符串表的二进制数据（可保存为预编译文件）
+    */
+    bool SaveToData(std::vector<uint8_t>& data) const;
+
+    /** 判断数据是否为预编译的字符串表（检查文件头标识）
+    */
+    static bool IsCompiledData(const uint8_t* pData, size_t nDataSize);
+
+    /** 清空字符串表
+    */
+    void Clear();
+
+public:
+    /** 根据ID查找文本（不分配内存）
+    * @param [in] id 字符串ID
+    * @param [out] value 返回ID对应的文本，在字符串表清空或者销毁前有效（以'\0'结尾）
+    * @return 找到返回true，否则返回false
+    */
+    bool Find(DStringView id, DStringView& value) const;
+
+    /** 获取字符串的个数
+    */
+    uint32_t GetCount() const;
+
+    /** 获取字符串表数据的大小（字节）
+    */
+    size_t GetDataSize() const;
+
+    /** 是否为内存映射的数据
+    */
+    bool IsMapped() const;
+
+private:
+    /** 校验二进制数据，并初始化索引表和字符串区的指针
+    */
+    bool AttachData(const uint8_t* pData, size_t nDataSize, uint64_t nSourceHash, uint64_t nSourceSize);
+
+    /** 获取字符串区中的字符串
+    */
+    DStringView GetString(uint32_t nOffset, uint32_t nLength) const;
+
+private:
+    /** 字符串表的数据（编译生成或者从内存中复制的数据）
+    */
+    std::vector<uint8_t> m_data;
+
+    /** 预编译文件的内存映射
+    */
+    std::unique_ptr<FileMapping> m_pFileMapping;
+
+    /** 索引表的起始地址（指向m_data或者映射内存）
+    */
+    const uint8_t* m_pEntryData;
+
+    /** 索引表中的项数
+    */
+    uint32_t m_nEntryCount;
+
+    /** 字符串区的起始地址
+    */
+    const DString::value_type* m_pStrings;
+
+    /** 字符串区的字符个数
+    */
+    uint32_t m_nStringLength;
+
+    /** 数据的大小（字节）
+    */
+    size_t m_nDataSize;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_COMPILED_STRING_TABLE_H_
@@ -4,8 +4,10 @@
 #include "duilib/Core/Box.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/ColorManager.h"
+#include "duilib/Core/CompiledLayout.h"
 #include "duilib/Core/StateColorMap.h"
 #include "duilib/Image/Image.h"
+#include "duilib/Image/SvgDocument.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Render/AutoClip.h"
 #include "duilib/Animation/AnimationPlayer.h"
@@ -16,84 +18,172 @@
 
 namespace ui 
 {
+/** 不常用的控件数据
+*/
+struct Control::ControlExtData
+{
+    //查找过的字体（按字体ID和DPI缩放比例缓存）
+    struct FontCacheEntry
+    {
+        UiString m_fontId;              //字体ID
+        uint32_t m_nDpiScale = 0;       //DPI缩放百分比
+        uint32_t m_nFontGeneration = 0; //字体版本号
+        IFont* m_pFont = nullptr;       //字体接口
+    };
+
+    //字体缓存的槽位数（控件一般只在几种状态字体之间切换）
+    static constexpr size_t kFontCacheSlots = 4;
+
+    //ToolTip宽度和用户数据ID的默认值
+    static constexpr uint16_t kDefaultTooltipWidth = 300;
+    static constexpr size_t kDefaultUserDataID = (size_t)-1;
+
+    //ToolTip的宽度
+    uint16_t m_nTooltipWidth = kDefaultTooltipWidth;
+
+    //ToolTip的文本内容
+    UiString m_sToolTipText;
+
+    //ToolTip的文本ID
+    UiString m_sToolTipTextId;
+
+    //用户数据ID(字符串)
+    UiString m_sUserDataID;
+
+    //用户数据ID(整型值)
+    size_t m_uUserDataID = kDefaultUserDataID;
+
+    //焦点状态下的边框颜色
+    UiColorToken m_focusBorderColor;
+
+    //焦点状态虚线矩形的颜色
+    UiColorToken m_focusRectColor;
+
+    //控件的第二背景色(实现渐变背景色)
+    UiColorToken m_strBkColor2;
+
+    //控件的第二背景色方向：："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
+    UiString m_strBkColor2Direction;
+
+    //控件"加载中"逻辑的实现接口
+    std::unique_ptr<ControlLoading> m_pLoading;
+
+    //控件阴影，其圆角大小通过m_cxyBorderRound变量控制
+    std::unique_ptr<BoxShadow> m_pBoxShadow;
+
+    //控件动画播放管理器
+    std::unique_ptr<AnimationManager> m_animationManager;
+
+    //绘制渲染引擎接口（位图形式的绘制缓存）
+    std::unique_ptr<IRender> m_render;
+
+    //显示列表形式的绘制缓存
+    std::unique_ptr<IPicture> m_pCachePicture;
+
+    //通过AttachXXX接口，添加的监听事件
+    std::unique_ptr<EventHandlerTable> m_pOnEvent;
+
+    //通过XML中，配置<Event标签添加的响应事件，最终由Control::OnApplyAttributeList函数响应具体操作
+    std::unique_ptr<EventHandlerTable> m_pOnXmlEvent;
+
+    //通过AttachBubbledEvent接口添加的事件
+    std::unique_ptr<EventHandlerTable> m_pOnBubbledEvent;
+
+    //通过XML中，配置<BubbledEvent标签添加的响应事件，最终由Control::OnApplyAttributeList函数响应具体操作
+    std::unique_ptr<EventHandlerTable> m_pOnXmlBubbledEvent;
+
+    //字体缓存
+    FontCacheEntry m_fontCache[kFontCacheSlots];
+
+    //字体缓存满时，下一个被替换的槽位
+    uint8_t m_nNextFontCacheSlot = 0;
+};
+
 Control::Control(Window* pWindow) :
     PlaceHolder(pWindow),
-    m_bContextMenuUsed(false),
+    m_cxyBorderRound(),
+    m_rcBorderSize(),
+    m_strBkColor(),
+    m_renderOffset(),
+    m_rcPaint(),
+    m_controlState(kControlStateNormal),
+    m_cursorType(CursorType::kCursorArrow),
+    m_nAlpha(255),
+    m_nHotAlpha(0),
+    m_nPaintOrder(0),
     m_bEnabled(true),
     m_bMouseEnabled(true),
     m_bKeyboardEnabled(true),
     m_bMouseFocused(false),
+    m_bContextMenuUsed(false),
     m_bNoFocus(false),
-    m_bClip(true),
     m_bAllowTabstop(true),
-    m_renderOffset(),
-    m_cxyBorderRound(),
-    m_rcPaint(),
-    m_rcBorderSize(),
-    m_cursorType(CursorType::kCursorArrow),
-    m_controlState(kControlStateNormal),
-    m_nTooltipWidth(300),
-    m_nAlpha(255),
-    m_nHotAlpha(0),
-    m_sToolTipText(),
-    m_sToolTipTextId(),
-    m_sUserDataID(),
-    m_strBkColor(),
-    m_pBoxShadow(nullptr),
-    m_isBoxShadowPainted(false),
-    m_uUserDataID((size_t)-1),
-    m_pOnEvent(nullptr),
-    m_pOnXmlEvent(nullptr),
-    m_pOnBubbledEvent(nullptr),
-    m_pOnXmlBubbledEvent(nullptr),
-    m_pLoading(nullptr),
     m_bShowFocusRect(false),
-    m_nPaintOrder(0)
+    m_bClip(true),
+    m_bPaintRecordable(true),
+    m_bPictureCacheFailed(false),
+    m_isBoxShadowPainted(false)
 {
 }
 
 Control::~Control()
 {
-    //清理动画相关资源，避免定时器再产生回调，引发错误
-    if (m_animationManager != nullptr) {
-        m_animationManager->Clear(this);
-    }    
-    m_animationManager.reset();
+    if (m_pExtData != nullptr) {
+        //清理动画相关资源，避免定时器再产生回调，引发错误
+        if (m_pExtData->m_animationManager != nullptr) {
+            m_pExtData->m_animationManager->Clear(this);
+        }
+        m_pExtData->m_animationManager.reset();
+    }
 
     Window* pWindow = GetWindow();
     if (pWindow) {
         pWindow->ReapObjects(this);
     }
 
-    if (m_pLoading != nullptr) {
-        delete m_pLoading;
-        m_pLoading = nullptr;
+    if (m_pExtData != nullptr) {
+        m_pExtData->m_pLoading.reset();
+        m_pExtData.reset();
     }
+}
 
-    if (m_pBoxShadow != nullptr) {
-        delete m_pBoxShadow;
-        m_pBoxShadow = nullptr;
-    }
-    if (m_pOnEvent != nullptr) {
-        delete m_pOnEvent;
-        m_pOnEvent = nullptr;
-    }
-    if (m_pOnXmlEvent != nullptr) {
-        delete m_pOnXmlEvent;
-        m_pOnXmlEvent = nullptr;
-    }
-    if (m_pOnBubbledEvent != nullptr) {
-        delete m_pOnBubbledEvent;
-        m_pOnBubbledEvent = nullptr;
-    }
-    if (m_pOnXmlBubbledEvent != nullptr) {
-        delete m_pOnXmlBubbledEvent;
-        m_pOnXmlBubbledEvent = nullptr;
+Control::ControlExtData& Control::GetExtData()
+{
+    if (m_pExtData == nullptr) {
+        m_pExtData = std::make_unique<ControlExtData>();
     }
+    return *m_pExtData;
+}
+
+ControlLoading* Control::GetLoading() const
+{
+    return (m_pExtData != nullptr) ? m_pExtData->m_pLoading.get() : nullptr;
 }
 
 DString Control::GetType() const { return DUI_CTR_CONTROL; }
 
+/** 正在设置的属性值及其预解析的值（由SetParsedAttribute设置，在调用SetAttribute期间有效）
+*/
+struct ParsedAttributeValue
+{
+    const DString* m_pValue = nullptr;
+    const CompiledLayoutValue* m_pParsedValue = nullptr;
+};
+static thread_local ParsedAttributeValue t_parsedAttributeValue;
+
+/** 获取属性值的预解析值：只有属性值是SetParsedAttribute传入的同一个字符串对象，并且类型匹配时才返回，否则返回nullptr
+*   （派生类在SetAttribute中以其他属性值调用基类时，仍然按字符串解析）
+*/
+static const CompiledLayoutValue* GetParsedAttributeValue(const DString& strValue, CompiledLayoutValueType valueType)
+{
+    const ParsedAttributeValue& parsedValue = t_parsedAttributeValue;
+    if ((parsedValue.m_pValue == &strValue) && (parsedValue.m_pParsedValue != nullptr) &&
+        (parsedValue.m_pParsedValue->m_type == valueType)) {
+        return parsedValue.m_pParsedValue;
+    }
+    return nullptr;
+}
+
 void Control::SetAttribute(const DString& strName, const DString& strValue)
 {
     ASSERT(GetWindow() != nullptr);//由于需要做DPI感知功能，所以必须先设置关联窗口
@@ -130,12 +220,30 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
     }
     else if (strName == _T("margin")) {
         UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+        const CompiledLayoutValue* pParsedValue = GetParsedAttributeValue(strValue, CompiledLayoutValueType::kRect);
+        if (pParsedValue != nullptr) {
+            const int32_t* v = pParsedValue->m_values;
+            ASSERT((v[0] >= 0) && (v[1] >= 0) && (v[2] >= 0) && (v[3] >= 0));
+            rcMargin = UiMargin(v[0], v[1], v[2], v[3]);
+            rcMargin.Validate();
+        }
+        else {
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+        }
         SetMargin(rcMargin, true);
     }
     else if (strName == _T("padding")) {
         UiPadding rcPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
+        const CompiledLayoutValue* pParsedValue = GetParsedAttributeValue(strValue, CompiledLayoutValueType::kRect);
+        if (pParsedValue != nullptr) {
+            const int32_t* v = pParsedValue->m_values;
+            ASSERT((v[0] >= 0) && (v[1] >= 0) && (v[2] >= 0) && (v[3] >= 0));
+            rcPadding = UiPadding(v[0], v[1], v[2], v[3]);
+            rcPadding.Validate();
+        }
+        else {
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
+        }
         SetPadding(rcPadding, true);
     }
     else if (strName == _T("control_padding")) {
@@ -172,14 +280,25 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
     }
     else if ((strName == _T("border_round")) || (strName == _T("borderround"))) {
         UiSize cxyRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
+        const CompiledLayoutValue* pParsedValue = GetParsedAttributeValue(strValue, CompiledLayoutValueType::kSize);
+        if (pParsedValue != nullptr) {
+            cxyRound = UiSize(pParsedValue->m_values[0], pParsedValue->m_values[1]);
+        }
+        else {
+            AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
+        }
         SetBorderRound(cxyRound, true);
     }
     else if ((strName == _T("box_shadow")) || (strName == _T("boxshadow"))) {
         SetBoxShadow(strValue);
     }
     else if (strName == _T("width")) {
-        if (strValue == _T("stretch")) {
+        const CompiledLayoutValue* pParsedValue = GetParsedAttributeValue(strValue, CompiledLayoutValueType::kInt);
+        if ((pParsedValue != nullptr) && (pParsedValue->m_values[0] >= 0)) {
+            //宽度为固定值（预编译布局中已经解析）
+            SetFixedWidth(UiFixedInt(pParsedValue->m_values[0]), true, true);
+        }
+        else if (strValue == _T("stretch")) {
             //宽度为拉伸：由父容器负责分配宽度
             SetFixedWidth(UiFixedInt::MakeStretch(), true, true);
         }
@@ -207,7 +326,12 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
         }
     }
     else if (strName == _T("height")) {
-        if (strValue == _T("stretch")) {
+        const CompiledLayoutValue* pParsedValue = GetParsedAttributeValue(strValue, CompiledLayoutValueType::kInt);
+        if ((pParsedValue != nullptr) && (pParsedValue->m_values[0] >= 0)) {
+            //高度为固定值（预编译布局中已经解析）
+            SetFixedHeight(UiFixedInt(pParsedValue->m_values[0]), true, true);
+        }
+        else if (strValue == _T("stretch")) {
             //高度为拉伸：由父容器负责分配高度
             SetFixedHeight(UiFixedInt::MakeStretch(), true, true);
         }
@@ -391,6 +515,20 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
     else if (strName == _T("cache")) {
         SetUseCache(strValue == _T("true"));
     }
+    else if (strName == _T("cache_mode")) {
+        if (strValue == _T("bitmap")) {
+            SetCacheMode(ControlCacheMode::kCacheModeBitmap);
+        }
+        else if (strValue == _T("picture")) {
+            SetCacheMode(ControlCacheMode::kCacheModePicture);
+        }
+        else {
+            SetCacheMode(ControlCacheMode::kCacheModeAuto);
+        }
+    }
+    else if (strName == _T("paint_recordable")) {
+        SetPaintRecordable(strValue == _T("true"));
+    }
     else if ((strName == _T("no_focus")) || (strName == _T("nofocus"))) {
         SetNoFocus();
     }
@@ -555,6 +693,21 @@ void Control::ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale)
     SetReEstimateSize(true);
 }
 
+void Control::ChangeLanguage()
+{
+    //提示文本在显示时获取，不需要更新
+}
+
+void Control::SetPaintRecordable(bool bRecordable)
+{
+    if (m_bPaintRecordable != bRecordable) {
+        m_bPaintRecordable = bRecordable;
+        if (GetWindow() != nullptr) {
+            GetWindow()->InvalidatePaintRecordable();
+        }
+    }
+}
+
 void Control::SetClass(const DString& strClass)
 {
     if (strClass.empty()) {
@@ -562,15 +715,32 @@ void Control::SetClass(const DString& strClass)
     }
     std::list<DString> splitList = StringUtil::Split(strClass, _T(" "));
     for (auto it = splitList.begin(); it != splitList.end(); it++) {
-        DString pDefaultAttributes = GlobalManager::Instance().GetClassAttributes((*it));
-        Window* pWindow = GetWindow();
-        if (pDefaultAttributes.empty() && (pWindow != nullptr)) {
-            pDefaultAttributes = pWindow->GetClassAttributes(*it);
-        }
+        ApplyClass(*it);
+    }
+}
+
+void Control::SetParsedAttribute(const DString& strName, const DString& strValue, const CompiledLayoutValue& parsedValue)
+{
+    //仍然通过虚函数SetAttribute设置属性，派生类的重载可以处理该属性；基类在处理该属性值时直接使用预解析的值
+    const ParsedAttributeValue oldValue = t_parsedAttributeValue;
+    t_parsedAttributeValue.m_pValue = &strValue;
+    t_parsedAttributeValue.m_pParsedValue = &parsedValue;
+    SetAttribute(strName, strValue);
+    t_parsedAttributeValue = oldValue;
+}
 
-        ASSERT(!pDefaultAttributes.empty());
-        if (!pDefaultAttributes.empty()) {
-            ApplyAttributeList(pDefaultAttributes);
+void Control::ApplyClass(const DString& strClassName)
+{
+    //Class的属性列表在添加Class时已经解析，这里直接应用
+    const UiClassAttributes* pClassAttributes = GlobalManager::Instance().FindClassAttributes(strClassName);
+    Window* pWindow = GetWindow();
+    if ((pClassAttributes == nullptr) && (pWindow != nullptr)) {
+        pClassAttributes = pWindow->FindClassAttributes(strClassName);
+    }
+    ASSERT(pClassAttributes != nullptr);
+    if (pClassAttributes != nullptr) {
+        for (const auto& attribute : pClassAttributes->m_attrs) {
+            SetAttribute(attribute.first, attribute.second);
         }
     }
 }
@@ -582,12 +752,7 @@ void Control::ApplyAttributeList(const DString& strList)
         return;
     }
     std::vector<std::pair<DString, DString>> attributeList;
-    if (strList.find(_T('\"')) != DString::npos) {
-        AttributeUtil::ParseAttributeList(strList, _T('\"'), attributeList);
-    }    
-    else if (strList.find(_T('\'')) != DString::npos) {
-        AttributeUtil::ParseAttributeList(strList, _T('\''), attributeList);
-    }
+    AttributeUtil::ParseAttributeList(strList, attributeList);
     for (const auto& attribute : attributeList) {
         SetAttribute(attribute.first, attribute.second);
     }
@@ -633,11 +798,20 @@ bool Control::OnApplyAttributeList(const DString& strReceiver, const DString& st
 
 AnimationManager& Control::GetAnimationManager()
 {
-    if (m_animationManager == nullptr) {
-        m_animationManager = std::make_unique<AnimationManager>(),
-        m_animationManager->Init(this);
+    ControlExtData& extData = GetExtData();
+    if (extData.m_animationManager == nullptr) {
+        extData.m_animationManager = std::make_unique<AnimationManager>(),
+        extData.m_animationManager->Init(this);
     }
-    return *m_animationManager;
+    return *extData.m_animationManager;
+}
+
+AnimationPlayer* Control::GetAnimationPlayer(AnimationType animationType) const
+{
+    if ((m_pExtData == nullptr) || (m_pExtData->m_animationManager == nullptr)) {
+        return nullptr;
+    }
+    return m_pExtData->m_animationManager->GetAnimationPlayer(animationType);
 }
 
 void Control::SetBkColor(const DString& strColor)
@@ -663,30 +837,36 @@ void Control::SetBkColor(const UiColor& color)
 void Control::SetBkColor2(const DString& strColor)
 {
     ASSERT(strColor.empty() || HasUiColor(strColor));
-    if (m_strBkColor2 == strColor) {
+    if (GetBkColor2() == strColor) {
         return;
     }
-    m_strBkColor2 = strColor;
+    GetExtData().m_strBkColor2 = strColor;
     Invalidate();
 }
 
 DString Control::GetBkColor2() const
 {
-    return m_strBkColor2.c_str();
+    if (m_pExtData == nullptr) {
+        return DString();
+    }
+    return m_pExtData->m_strBkColor2.c_str();
 }
 
 void Control::SetBkColor2Direction(const DString& direction)
 {
-    if (m_strBkColor2Direction == direction) {
+    if (GetBkColor2Direction() == direction) {
         return;
     }
-    m_strBkColor2Direction = direction;
+    GetExtData().m_strBkColor2Direction = direction;
     Invalidate();
 }
 
 DString Control::GetBkColor2Direction() const
 {
-    return m_strBkColor2Direction.c_str();
+    if (m_pExtData == nullptr) {
+        return DString();
+    }
+    return m_pExtData->m_strBkColor2Direction.c_str();
 }
 
 int8_t Control::GetColor2Direction(const UiString& bkColor2Direction) const
@@ -770,12 +950,14 @@ void Control::SetUTF8BkImage(const std::string& strImage)
 void Control::SetLoadingImage(const DString& strImage) 
 {
     if (!strImage.empty()) {
-        if (m_pLoading == nullptr) {
-            m_pLoading = new ControlLoading(this);
+        ControlExtData& extData = GetExtData();
+        if (extData.m_pLoading == nullptr) {
+            extData.m_pLoading = std::make_unique<ControlLoading>(this);
         }
     }
-    if (m_pLoading != nullptr) {
-        if (m_pLoading->SetLoadingImage(strImage)) {
+    ControlLoading* pLoading = GetLoading();
+    if (pLoading != nullptr) {
+        if (pLoading->SetLoadingImage(strImage)) {
             Invalidate();
         }
     }
@@ -783,8 +965,9 @@ void Control::SetLoadingImage(const DString& strImage)
 
 void Control::SetLoadingBkColor(const DString& strColor) 
 {
-    if (m_pLoading != nullptr) {
-        if (m_pLoading->SetLoadingBkColor(strColor)) {
+    ControlLoading* pLoading = GetLoading();
+    if (pLoading != nullptr) {
+        if (pLoading->SetLoadingBkColor(strColor)) {
             Invalidate();
         }
     }    
@@ -792,15 +975,17 @@ void Control::SetLoadingBkColor(const DString& strColor)
 
 void Control::StartLoading(int32_t fStartAngle)
 {
-    if ((m_pLoading != nullptr) && m_pLoading->StartLoading(fStartAngle)) {
+    ControlLoading* pLoading = GetLoading();
+    if ((pLoading != nullptr) && pLoading->StartLoading(fStartAngle)) {
         SetEnabled(false);
     }
 }
 
 void Control::StopLoading(GifFrameType frame)
 {
-    if (m_pLoading != nullptr) {
-        m_pLoading->StopLoading(frame);
+    ControlLoading* pLoading = GetLoading();
+    if (pLoading != nullptr) {
+        pLoading->StopLoading(frame);
     }
     SetEnabled(true);
 }
@@ -1064,15 +1249,18 @@ void Control::SetBorderColor(ControlStateType stateType, const DString& strBorde
 
 void Control::SetFocusBorderColor(const DString& strBorderColor)
 {
-    if (m_focusBorderColor != strBorderColor) {
-        m_focusBorderColor = strBorderColor;
+    if (GetFocusBorderColor() != strBorderColor) {
+        GetExtData().m_focusBorderColor = strBorderColor;
         Invalidate();
     }
 }
 
 DString Control::GetFocusBorderColor() const
 {
-    return m_focusBorderColor.c_str();
+    if (m_pExtData == nullptr) {
+        return DString();
+    }
+    return m_pExtData->m_focusBorderColor.c_str();
 }
 
 void Control::SetBorderSize(UiRect rc, bool bNeedDpiScale)
@@ -1199,10 +1387,11 @@ void Control::SetBoxShadow(const DString& strShadow)
     if (strShadow.empty()) {
         return;
     }
-    if (m_pBoxShadow == nullptr) {
-        m_pBoxShadow = new BoxShadow(this);
+    ControlExtData& extData = GetExtData();
+    if (extData.m_pBoxShadow == nullptr) {
+        extData.m_pBoxShadow = std::make_unique<BoxShadow>(this);
     }
-    m_pBoxShadow->SetBoxShadowString(strShadow);
+    extData.m_pBoxShadow->SetBoxShadowString(strShadow);
 }
 
 CursorType Control::GetCursorType() const
@@ -1217,9 +1406,12 @@ void Control::SetCursorType(CursorType cursorType)
 
 DString Control::GetToolTipText() const
 {
-    DString strText = m_sToolTipText.c_str();
-    if (strText.empty() && !m_sToolTipTextId.empty()) {
-        strText = GlobalManager::Instance().Lang().GetStringViaID(m_sToolTipTextId.c_str());
+    if (m_pExtData == nullptr) {
+        return DString();
+    }
+    DString strText = m_pExtData->m_sToolTipText.c_str();
+    if (strText.empty() && !m_pExtData->m_sToolTipTextId.empty()) {
+        strText = GlobalManager::Instance().Lang().GetStringViewViaID(m_pExtData->m_sToolTipTextId.c_str());
     }
     return strText;
 }
@@ -1232,10 +1424,11 @@ std::string Control::GetUTF8ToolTipText() const
 
 void Control::SetToolTipText(const DString& strText)
 {
-    if (strText != m_sToolTipText) {
+    const bool bChanged = (m_pExtData != nullptr) ? (strText != m_pExtData->m_sToolTipText) : !strText.empty();
+    if (bChanged) {
         DString strTemp(strText);
         StringUtil::ReplaceAll(_T("<n>"), _T("\r\n"), strTemp);
-        m_sToolTipText = strTemp;
+        GetExtData().m_sToolTipText = strTemp;
         Invalidate();
 
         if (GetWindow() != nullptr) {
@@ -1252,22 +1445,21 @@ void Control::SetUTF8ToolTipText(const std::string& strText)
 {
     DString strOut = StringConvert::UTF8ToT(strText);
     if (strOut.empty()) {
-        m_sToolTipText.clear();
+        if (m_pExtData != nullptr) {
+            m_pExtData->m_sToolTipText.clear();
+        }
         Invalidate();
         return ;
     }
-
-    if (m_sToolTipText != strOut) {
-        SetToolTipText(strOut);
-    }
+    SetToolTipText(strOut);
 }
 
 void Control::SetToolTipTextId(const DString& strTextId)
 {
-    if (m_sToolTipTextId == strTextId) {
+    if ((m_pExtData != nullptr) ? (m_pExtData->m_sToolTipTextId == strTextId) : strTextId.empty()) {
         return;
     }
-    m_sToolTipTextId = strTextId;
+    GetExtData().m_sToolTipTextId = strTextId;
     Invalidate();
 }
 
@@ -1285,12 +1477,15 @@ void Control::SetToolTipWidth( int32_t nWidth, bool bNeedDpiScale)
     if (bNeedDpiScale) {
         Dpi().ScaleInt(nWidth);
     }
-    m_nTooltipWidth = TruncateToUInt16(nWidth);
+    GetExtData().m_nTooltipWidth = TruncateToUInt16(nWidth);
 }
 
 int32_t Control::GetToolTipWidth(void) const
 {
-    return m_nTooltipWidth;
+    if (m_pExtData == nullptr) {
+        return ControlExtData::kDefaultTooltipWidth;
+    }
+    return m_pExtData->m_nTooltipWidth;
 }
 
 void Control::SetContextMenuUsed(bool bMenuUsed)
@@ -1300,7 +1495,10 @@ void Control::SetContextMenuUsed(bool bMenuUsed)
 
 DString Control::GetDataID() const
 {
-    return m_sUserDataID.c_str();
+    if (m_pExtData == nullptr) {
+        return DString();
+    }
+    return m_pExtData->m_sUserDataID.c_str();
 }
 
 std::string Control::GetUTF8DataID() const
@@ -1311,22 +1509,27 @@ std::string Control::GetUTF8DataID() const
 
 void Control::SetDataID(const DString& strText)
 {
-    m_sUserDataID = strText;
+    if ((m_pExtData != nullptr) || !strText.empty()) {
+        GetExtData().m_sUserDataID = strText;
+    }
 }
 
 void Control::SetUTF8DataID(const std::string& strText)
 {
-    m_sUserDataID = StringConvert::UTF8ToT(strText);
+    SetDataID(StringConvert::UTF8ToT(strText));
 }
 
 void Control::SetUserDataID(size_t dataID)
 {
-    m_uUserDataID = dataID;
+    GetExtData().m_uUserDataID = dataID;
 }
 
 size_t Control::GetUserDataID() const
 {
-    return m_uUserDataID;
+    if (m_pExtData == nullptr) {
+        return ControlExtData::kDefaultUserDataID;
+    }
+    return m_pExtData->m_uUserDataID;
 }
 
 void Control::SetFadeVisible(bool bVisible)
@@ -1353,6 +1556,10 @@ void Control::SetVisible(bool bVisible)
 
     if (IsVisible() != v) {
         ArrangeAncestor();
+        if (GetWindow() != nullptr) {
+            GetWindow()->InvalidateHitTestCache();
+            GetWindow()->InvalidatePaintRecordable();
+        }
     }
 
     if (!IsVisible()) {
@@ -1433,12 +1640,17 @@ bool Control::IsShowFocusRect() const
 
 void Control::SetFocusRectColor(const DString& focusRectColor)
 {
-    m_focusRectColor = focusRectColor;
+    if ((m_pExtData != nullptr) || !focusRectColor.empty()) {
+        GetExtData().m_focusRectColor = focusRectColor;
+    }
 }
 
 DString Control::GetFocusRectColor() const
 {
-    return m_focusRectColor.c_str();
+    if (m_pExtData == nullptr) {
+        return DString();
+    }
+    return m_pExtData->m_focusRectColor.c_str();
 }
 
 void Control::Activate(const EventArgs* /*pMsg*/)
@@ -1503,6 +1715,9 @@ void Control::SetPos(UiRect rc)
     if (GetWindow() == nullptr) {
         return;
     }
+    if (isPosChanged) {
+        GetWindow()->InvalidateHitTestCache();
+    }
     invalidateRc.Union(GetRect());
     bool needInvalidate = true;
     UiRect rcTemp;
@@ -1941,7 +2156,7 @@ bool Control::ButtonUp(const EventArgs& msg)
     }
     if( IsMouseFocused() ) {
         SetMouseFocused(false);
-        auto player = GetAnimationManager().GetAnimationPlayer(AnimationType::kAnimationHot);
+        auto player = GetAnimationPlayer(AnimationType::kAnimationHot);
         if (player != nullptr) {
             player->Stop();
         }
@@ -2083,7 +2298,7 @@ bool Control::OnKillFocus(const EventArgs& msg)
     else if (GetState() == kControlStatePushed) {
         //失去焦点时，修复控件状态（如果鼠标按下时，窗口失去焦点，鼠标弹起事件这个控件就收不到了）
         SetMouseFocused(false);
-        auto player = GetAnimationManager().GetAnimationPlayer(AnimationType::kAnimationHot);
+        auto player = GetAnimationPlayer(AnimationType::kAnimationHot);
         if (player != nullptr) {
             player->Stop();
         }
@@ -2137,12 +2352,15 @@ bool Control::PaintImage(IRender* pRender, Image* pImage,
         return false;
     }
 
-    LoadImageData(duiImage);
+    LoadImageData(duiImage, true);
     std::shared_ptr<ImageInfo> imageInfo = duiImage.GetImageCache();
     ASSERT(imageInfo != nullptr);
     if (imageInfo == nullptr) {
         return false;
     }
+    //图片是否为原DPI下加载的（新DPI下的图片正在后台加载）
+    const uint32_t nLoadDpiScale = imageInfo->GetLoadDpiScale();
+    const bool bStaleDpiImage = (nLoadDpiScale != 0) && (nLoadDpiScale != Dpi().GetScale());
 
     IBitmap* pBitmap = duiImage.GetCurrentBitmap();
     ASSERT(pBitmap != nullptr);
@@ -2175,19 +2393,37 @@ bool Control::PaintImage(IRender* pRender, Image* pImage,
     UiRect rcDestCorners;
     UiRect rcSource = newImageAttribute.GetImageSourceRect();
     UiRect rcSourceCorners = newImageAttribute.GetImageCorner();
-    ImageAttribute::ScaleImageRect(pBitmap->GetWidth(), pBitmap->GetHeight(), 
-                                   Dpi(), imageInfo->IsBitmapSizeDpiScaled(),
-                                   rcDestCorners,
-                                   rcSource,
-                                   rcSourceCorners);
+    if (bStaleDpiImage) {
+        //原DPI下的图片：源区域按原DPI计算，目标边角按新DPI缩放
+        DpiManager loadDpi;
+        loadDpi.SetDPI((uint32_t)DpiManager::MulDiv((int32_t)nLoadDpiScale, 96, 100));
+        ImageAttribute::ScaleImageRect(pBitmap->GetWidth(), pBitmap->GetHeight(),
+                                       loadDpi, imageInfo->IsBitmapSizeDpiScaled(),
+                                       rcDestCorners,
+                                       rcSource,
+                                       rcSourceCorners);
+        rcDestCorners = Dpi().GetScaleRect(rcDestCorners, nLoadDpiScale);
+    }
+    else {
+        ImageAttribute::ScaleImageRect(pBitmap->GetWidth(), pBitmap->GetHeight(), 
+                                       Dpi(), imageInfo->IsBitmapSizeDpiScaled(),
+                                       rcDestCorners,
+                                       rcSource,
+                                       rcSourceCorners);
+    }
     
     if (!hasDestAttr) {
         //运用rcPadding、hAlign、vAlign 三个图片属性
         rcDest.Deflate(newImageAttribute.GetImagePadding(Dpi()));
         rcDest.Validate();
         rcSource.Validate();
-        const int32_t imageWidth = rcSource.Width();
-        const int32_t imageHeight = rcSource.Height();
+        int32_t imageWidth = rcSource.Width();
+        int32_t imageHeight = rcSource.Height();
+        if (bStaleDpiImage && imageInfo->IsBitmapSizeDpiScaled()) {
+            //原DPI下的图片：显示大小按新DPI缩放
+            imageWidth = Dpi().GetScaleInt(imageWidth, nLoadDpiScale);
+            imageHeight = Dpi().GetScaleInt(imageHeight, nLoadDpiScale);
+        }
 
         //应用对齐方式后，图片将不再拉伸，而是按原大小展示
         if (!newImageAttribute.hAlign.empty()) {
@@ -2237,6 +2473,32 @@ bool Control::PaintImage(IRender* pRender, Image* pImage,
 
     //图片透明度属性
     uint8_t iFade = (nFade == DUI_NOSET_VALUE) ? newImageAttribute.bFade : static_cast<uint8_t>(nFade);
+
+    //SVG图片：矢量绘制，或者按目标区域的大小重新光栅化（避免位图拉伸导致的模糊）
+    std::shared_ptr<SvgDocument> spSvgDocument = imageInfo->GetSvgDocument();
+    if ((spSvgDocument != nullptr) && (pMatrix == nullptr) && !rcDest.IsEmpty() &&
+        rcSourceCorners.IsEmpty() && !newImageAttribute.bTiledX && !newImageAttribute.bTiledY &&
+        (rcSource == UiRect(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight()))) {
+        if (newImageAttribute.bSvgVectorMode && spSvgDocument->IsVectorSupported()) {
+            pRender->DrawVectorShapes(m_rcPaint, spSvgDocument->GetVectorShapes(), rcDest,
+                                      rcDest.Width() / spSvgDocument->GetWidth(),
+                                      rcDest.Height() / spSvgDocument->GetHeight(),
+                                      iFade);
+            return true;
+        }
+        //仅当目标区域与图片的纵横比一致时（误差在1个像素以内），才按目标区域的大小光栅化
+        const float fDestHeight = rcDest.Width() * spSvgDocument->GetHeight() / spSvgDocument->GetWidth();
+        if (((rcDest.Width() != rcSource.Width()) || (rcDest.Height() != rcSource.Height())) &&
+            (std::fabs(fDestHeight - rcDest.Height()) <= 1.0f)) {
+            IBitmap* pSizedBitmap = duiImage.GetSvgSizedBitmap(UiSize(rcDest.Width(), rcDest.Height()));
+            if (pSizedBitmap != nullptr) {
+                //已生成目标大小的位图，按原大小绘制；尚未生成时，先拉伸绘制原位图
+                pBitmap = pSizedBitmap;
+                rcSource = UiRect(0, 0, rcDest.Width(), rcDest.Height());
+            }
+        }
+    }
+
     if (pMatrix != nullptr) {
         //矩阵绘制: 对不支持的属性，增加断言，避免出错
         ASSERT(newImageAttribute.GetImageCorner().IsEmpty());
@@ -2244,6 +2506,22 @@ bool Control::PaintImage(IRender* pRender, Image* pImage,
         ASSERT(!newImageAttribute.bTiledY);
         pRender->DrawImageRect(m_rcPaint, pBitmap, rcDest, rcSource, iFade, pMatrix);
     }
+    else if (bStaleDpiImage) {
+        //原DPI下的图片：临时使用高质量的插值算法缩放绘制，新DPI下的图片加载完成后会重绘
+        const bool bHighQuality = pRender->IsImageHighQualitySampling();
+        pRender->SetImageHighQualitySampling(true);
+        pRender->DrawImage(m_rcPaint, pBitmap, rcDest, rcDestCorners, rcSource, rcSourceCorners,
+                           iFade, newImageAttribute.bTiledX, newImageAttribute.bTiledY,
+                           newImageAttribute.bFullTiledX, newImageAttribute.bFullTiledY,
+                           newImageAttribute.nTiledMargin);
+        pRender->SetImageHighQualitySampling(bHighQuality);
+    }
+    else if (pRender->IsAtlasBatchActive() &&
+             rcSourceCorners.IsEmpty() && !newImageAttribute.bTiledX && !newImageAttribute.bTiledY &&
+             (rcDest.Width() == rcSource.Width()) && (rcDest.Height() == rcSource.Height()) &&
+             !imageInfo->IsMultiFrameImage() && PaintAtlasImage(pRender, pBitmap, imageInfo->GetLoadDpiScale(), rcDest, rcSource, iFade)) {
+        //小图片：已通过图集批量绘制
+    }
     else{
         pRender->DrawImage(m_rcPaint, pBitmap, rcDest, rcDestCorners, rcSource, rcSourceCorners,
                            iFade, newImageAttribute.bTiledX, newImageAttribute.bTiledY, 
@@ -2255,9 +2533,30 @@ bool Control::PaintImage(IRender* pRender, Image* pImage,
     return true;
 }
 
+bool Control::PaintAtlasImage(IRender* pRender, IBitmap* pBitmap, uint32_t nDpiScale,
+                              const UiRect& rcDest, const UiRect& rcSource, uint8_t uFade) const
+{
+    ImageAtlas& imageAtlas = GlobalManager::Instance().Image().GetImageAtlas();
+    if (!imageAtlas.IsAtlasImageSize(pBitmap) ||
+        (rcSource.left < 0) || (rcSource.top < 0) ||
+        (rcSource.right > (int32_t)pBitmap->GetWidth()) || (rcSource.bottom > (int32_t)pBitmap->GetHeight())) {
+        return false;
+    }
+    std::shared_ptr<IBitmap> spAtlasBitmap;
+    UiRect rcAtlasRect;
+    if (!imageAtlas.GetAtlasImage(pBitmap, nDpiScale, spAtlasBitmap, rcAtlasRect)) {
+        return false;
+    }
+    UiRect rcAtlasSource = rcSource;
+    rcAtlasSource.Offset(rcAtlasRect.left, rcAtlasRect.top);
+    pRender->DrawAtlasImage(m_rcPaint, spAtlasBitmap, rcDest, rcAtlasSource, uFade);
+    return true;
+}
+
 IRender* Control::GetRender()
 {
-    if (m_render == nullptr) {
+    std::unique_ptr<IRender>& spRender = GetExtData().m_render;
+    if (spRender == nullptr) {
         IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
         ASSERT(pRenderFactory != nullptr);
         if (pRenderFactory != nullptr) {
@@ -2266,17 +2565,107 @@ IRender* Control::GetRender()
             if (GetWindow() != nullptr) {
                 spRenderDpi = GetWindow()->GetRenderDpi();
             }
-            m_render.reset(pRenderFactory->CreateRender(spRenderDpi));
+            spRender.reset(pRenderFactory->CreateRender(spRenderDpi));
         }
     }
-    return m_render.get();
+    return spRender.get();
 }
 
 void Control::ClearRender()
 {
-    if (m_render) {
-        m_render.reset();
+    if (m_pExtData != nullptr) {
+        m_pExtData->m_render.reset();
+        m_pExtData->m_pCachePicture.reset();
+    }
+}
+
+bool Control::IsPaintSolidColorOnly(bool bCheckBorder) const
+{
+    if (IsAlpha() || ShouldBeRoundRectFill() || !GetBkColor2().empty() ||
+        !GetBkImage().empty() || HasStateImages() || (GetLoading() != nullptr)) {
+        return false;
+    }
+    if (IsShowFocusRect() && IsFocused()) {
+        return false;
+    }
+    if (bCheckBorder) {
+        const UiRect& rcBorderSize = GetBorderSize();
+        if ((rcBorderSize.left > 0) || (rcBorderSize.top > 0) ||
+            (rcBorderSize.right > 0) || (rcBorderSize.bottom > 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Control::IsUsePictureCache() const
+{
+    if (m_bPictureCacheFailed) {
+        return false;
+    }
+    switch (GetCacheMode()) {
+    case ControlCacheMode::kCacheModeBitmap:
+        return false;
+    case ControlCacheMode::kCacheModePicture:
+        return true;
+    default:
+        //以图片为主的控件，回放显示列表时需要重新缩放和绘制图片，使用位图缓存
+        return GetBkImage().empty() && !HasStateImages();
+    }
+}
+
+bool Control::AlphaPaintPicture(IRender* pRender, bool isAlpha, bool bRoundClip)
+{
+    const UiRect rcRect = GetRect();
+    if (rcRect.IsEmpty()) {
+        return true;
+    }
+    ControlExtData& extData = GetExtData();
+    std::unique_ptr<IPicture>& spCachePicture = extData.m_pCachePicture;
+    if ((spCachePicture != nullptr) &&
+        ((spCachePicture->GetWidth() != rcRect.Width()) || (spCachePicture->GetHeight() != rcRect.Height()))) {
+        //大小发生变化，需要设置缓存脏标记
+        SetCacheDirty(true);
+    }
+    if (IsCacheDirty() || (spCachePicture == nullptr)) {
+        spCachePicture.reset();
+        //显示列表的原点对应控件矩形的左上角
+        const UiPoint ptOffset(rcRect.left + m_renderOffset.x, rcRect.top + m_renderOffset.y);
+        UiRect rcClip = { 0, 0, rcRect.Width(), rcRect.Height() };
+        rcClip.Offset(ptOffset.x, ptOffset.y);
+        IPicture* pPicture = pRender->RecordPicture(rcRect.Width(), rcRect.Height(), [&](IRender* pRecordRender) {
+                UiPoint ptOldOrg = pRecordRender->OffsetWindowOrg(ptOffset);
+                {
+                    AutoClip alphaClip(pRecordRender, rcClip, IsClip());
+                    AutoClip roundAlphaClip(pRecordRender, rcClip, m_cxyBorderRound.cx, m_cxyBorderRound.cy, bRoundClip);
+                    Paint(pRecordRender, rcRect);
+                    if (isAlpha) {
+                        PaintChild(pRecordRender, rcRect);
+                    }
+                }
+                pRecordRender->SetWindowOrg(ptOldOrg);
+            });
+        if (pPicture == nullptr) {
+            m_bPictureCacheFailed = true;
+            return false;
+        }
+        spCachePicture.reset(pPicture);
+        SetCacheDirty(false);
+        //不再需要位图缓存
+        extData.m_render.reset();
+    }
+
+    pRender->DrawPicture(rcRect, spCachePicture.get(), static_cast<uint8_t>(m_nAlpha));
+    if (!isAlpha) {
+        //没有设置透明度，后绘制子控件（直接绘制到pRender上面）
+        PaintChild(pRender, rcRect);
+    }
+    else {
+        //子控件的变化不会设置本控件的缓存脏标记，所以每次都需要重新录制
+        SetCacheDirty(true);
+        spCachePicture.reset();
     }
+    return true;
 }
 
 void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
@@ -2305,7 +2694,10 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
     //是否使用绘制缓存(如果存在box-shadow，就不能使用绘制缓存，因为box-shadow绘制的时候是超出GetRect来绘制外部阴影的)
     const bool isUseCache = IsUseCache() && !HasBoxShadow();
 
-    if (isAlpha || isUseCache) {
+    if (isUseCache && IsUsePictureCache() && AlphaPaintPicture(pRender, isAlpha, bRoundClip)) {
+        //已经使用显示列表缓存完成绘制
+    }
+    else if (isAlpha || isUseCache) {
         //绘制区域（局部绘制）
         UiRect rcUnionRect = rcUnion;
         if (isUseCache) {
@@ -2329,6 +2721,7 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
             SetCacheDirty(true);
         }            
         if (IsCacheDirty()) {
+            m_pExtData->m_pCachePicture.reset();
             //重新绘制，首先清楚原内容
             pCacheRender->Clear(UiColor());
 
@@ -2378,7 +2771,7 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
         }
         if (isAlpha) {
             SetCacheDirty(true);
-            m_render.reset();
+            m_pExtData->m_render.reset();
         }
     }
     else {
@@ -2435,8 +2828,8 @@ void Control::PaintShadow(IRender* pRender)
         return;
     }
     BoxShadow boxShadow(this);
-    if (m_pBoxShadow != nullptr) {
-        boxShadow = *m_pBoxShadow;
+    if ((m_pExtData != nullptr) && (m_pExtData->m_pBoxShadow != nullptr)) {
+        boxShadow = *m_pExtData->m_pBoxShadow;
     }
 
     ASSERT(pRender != nullptr);
@@ -2460,7 +2853,7 @@ void Control::PaintBkColor(IRender* pRender)
         return;
     }
 
-    UiColor dwBackColor = GetUiColor(m_strBkColor.c_str());
+    UiColor dwBackColor = GetUiColor(m_strBkColor);
     if(dwBackColor.GetARGB() != 0) {
         int32_t nBorderSize = 0;
         if ((m_rcBorderSize.left > 0) &&
@@ -2485,12 +2878,12 @@ void Control::PaintBkColor(IRender* pRender)
         }
         else {            
             UiColor dwBackColor2;
-            if (!m_strBkColor2.empty()) {
-                dwBackColor2 = GetUiColor(m_strBkColor2.c_str());
+            if ((m_pExtData != nullptr) && !m_pExtData->m_strBkColor2.empty()) {
+                dwBackColor2 = GetUiColor(m_pExtData->m_strBkColor2);
             }
             if (!dwBackColor2.IsEmpty()) {
                 //渐变背景色
-                int8_t nColor2Direction = GetColor2Direction(m_strBkColor2Direction);
+                int8_t nColor2Direction = GetColor2Direction(m_pExtData->m_strBkColor2Direction);
                 pRender->FillRect(fillRect, dwBackColor, dwBackColor2, nColor2Direction);
             }
             else {
@@ -2660,9 +3053,8 @@ void Control::DoPaintFocusRect(IRender* pRender)
     }
     int32_t nWidth =  Dpi().GetScaleInt(1); //画笔宽度
     UiColor dwBorderColor;//画笔颜色
-    DString focusRectColor = GetFocusRectColor();
-    if (!focusRectColor.empty()) {
-        dwBorderColor = GetUiColor(focusRectColor);
+    if ((m_pExtData != nullptr) && !m_pExtData->m_focusRectColor.empty()) {
+        dwBorderColor = GetUiColor(m_pExtData->m_focusRectColor);
     }
     if(dwBorderColor.IsEmpty()) {
         dwBorderColor = UiColor(UiColors::Gray);
@@ -2814,12 +3206,12 @@ void Control::FillRoundRect(IRender* pRender, const UiRect& rc, const UiSize& ro
                 //这种画法的圆角形状，与CreateRoundRectRgn产生的圆角形状，基本一致的
                 AddRoundRectPath(path.get(), rc, roundSize);
                 UiColor dwBackColor2;
-                if (!m_strBkColor2.empty()) {
-                    dwBackColor2 = GetUiColor(m_strBkColor2.c_str());
+                if ((m_pExtData != nullptr) && !m_pExtData->m_strBkColor2.empty()) {
+                    dwBackColor2 = GetUiColor(m_pExtData->m_strBkColor2);
                 }
                 if (!dwBackColor2.IsEmpty()) {
                     //渐变背景色
-                    int8_t nColor2Direction = GetColor2Direction(m_strBkColor2Direction);
+                    int8_t nColor2Direction = GetColor2Direction(m_pExtData->m_strBkColor2Direction);
                     pRender->FillPath(path.get(), rc, dwColor, dwBackColor2, nColor2Direction);
                 }
                 else {
@@ -2831,12 +3223,12 @@ void Control::FillRoundRect(IRender* pRender, const UiRect& rc, const UiSize& ro
     }
     if (!isDrawOk) {
         UiColor dwBackColor2;
-        if (!m_strBkColor2.empty()) {
-            dwBackColor2 = GetUiColor(m_strBkColor2.c_str());
+        if ((m_pExtData != nullptr) && !m_pExtData->m_strBkColor2.empty()) {
+            dwBackColor2 = GetUiColor(m_pExtData->m_strBkColor2);
         }
         if (!dwBackColor2.IsEmpty()) {
             //渐变背景色
-            int8_t nColor2Direction = GetColor2Direction(m_strBkColor2Direction);
+            int8_t nColor2Direction = GetColor2Direction(m_pExtData->m_strBkColor2Direction);
             pRender->FillRoundRect(rc, roundSize, dwColor, dwBackColor2, nColor2Direction);
         }
         else {
@@ -2881,8 +3273,9 @@ void Control::PaintText(IRender* /*pRender*/)
 
 void Control::PaintLoading(IRender* pRender)
 {
-    if (m_pLoading != nullptr) {
-        m_pLoading->PaintLoading(pRender);
+    ControlLoading* pLoading = GetLoading();
+    if (pLoading != nullptr) {
+        pLoading->PaintLoading(pRender);
     }
 }
 
@@ -2975,13 +3368,17 @@ void Control::AttachGifPlayStop(const EventCallback& callback)
     m_pBkImage->AttachGifPlayStop(callback);
 }
 
-bool Control::LoadImageData(Image& duiImage) const
+bool Control::LoadImageData(Image& duiImage, bool bAsyncReload) const
 {
     if (duiImage.GetImageCache() != nullptr) {
         //如果图片缓存存在，并且DPI缩放百分比没变化，则不再加载（当图片变化的时候，会清空这个缓存）
         if (duiImage.GetImageCache()->GetLoadDpiScale() == Dpi().GetScale()) {
             return true;
-        }        
+        }
+        if (bAsyncReload && duiImage.IsImageCacheLoading()) {
+            //新DPI下的图片正在后台加载，继续使用原图片
+            return true;
+        }
     }
     Window* pWindow = GetWindow();
     ASSERT(pWindow != nullptr);
@@ -3015,6 +3412,12 @@ bool Control::LoadImageData(Image& duiImage) const
     std::shared_ptr<ImageInfo> imageCache = duiImage.GetImageCache();
     if ((imageCache == nullptr) || 
         (imageCache->GetLoadKey() != imageLoadAttr.GetCacheKey(Dpi().GetScale()))) {
+        if (bAsyncReload && (imageCache != nullptr)) {
+            //DPI变化：在后台加载新DPI下的图片，加载完成前继续使用原图片（绘制时按新DPI缩放），避免阻塞界面
+            //只有需要绘制的（可见的）控件才会发起加载，因此可见区域的图片优先加载
+            duiImage.ReloadImageCacheAsync(pWindow, imageLoadAttr);
+            return duiImage.GetImageCache() != nullptr;
+        }
         //如果图片没有加载则执行加载图片；如果图片发生变化，则重新加载该图片
         imageCache = GlobalManager::Instance().Image().GetImage(GetWindow(), imageLoadAttr);
         duiImage.SetImageCache(imageCache);
@@ -3034,10 +3437,11 @@ void Control::ClearImageCache()
 
 void Control::AttachEvent(EventType type, const EventCallback& callback)
 {
-    if (m_pOnEvent == nullptr) {
-        m_pOnEvent = new EventMap;
+    std::unique_ptr<EventHandlerTable>& pOnEvent = GetExtData().m_pOnEvent;
+    if (pOnEvent == nullptr) {
+        pOnEvent = std::make_unique<EventHandlerTable>();
     }
-    (*m_pOnEvent)[type] += callback;
+    pOnEvent->AddCallback(type, callback);
     if ((type == kEventContextMenu) || (type == kEventAll)) {
         SetContextMenuUsed(true);
     }
@@ -3045,159 +3449,178 @@ void Control::AttachEvent(EventType type, const EventCallback& callback)
 
 void Control::DetachEvent(EventType type)
 {
-    if (m_pOnEvent == nullptr) {
+    EventHandlerTable* pOnEvent = (m_pExtData != nullptr) ? m_pExtData->m_pOnEvent.get() : nullptr;
+    if (pOnEvent == nullptr) {
         return;
     }
-    auto event = m_pOnEvent->find(type);
-    if (event != m_pOnEvent->end()) {
-        m_pOnEvent->erase(event);
-    }
+    pOnEvent->RemoveCallbacks(type);
     if ((type == kEventContextMenu) || (type == kEventAll)) {
-        if ((m_pOnEvent->find(kEventAll) == m_pOnEvent->end()) &&
-            (m_pOnEvent->find(kEventContextMenu) == m_pOnEvent->end())) {
+        if (!pOnEvent->HasEventType(kEventAll) && !pOnEvent->HasEventType(kEventContextMenu)) {
             SetContextMenuUsed(false);
         }
     }
 }
 
+void Control::DetachAllEvents()
+{
+    EventHandlerTable* pOnEvent = (m_pExtData != nullptr) ? m_pExtData->m_pOnEvent.get() : nullptr;
+    if (pOnEvent == nullptr) {
+        return;
+    }
+    const bool bContextMenuEvent = pOnEvent->IsListening(kEventContextMenu);
+    pOnEvent->Clear();
+    if (bContextMenuEvent) {
+        SetContextMenuUsed(false);
+    }
+}
+
+void Control::GetEventCallbackCounts(EventHandlerTable::CallbackCounts& callbackCounts) const
+{
+    callbackCounts.clear();
+    EventHandlerTable* pOnEvent = (m_pExtData != nullptr) ? m_pExtData->m_pOnEvent.get() : nullptr;
+    if (pOnEvent != nullptr) {
+        pOnEvent->GetCallbackCounts(callbackCounts);
+    }
+}
+
+void Control::RestoreEventCallbackCounts(const EventHandlerTable::CallbackCounts& callbackCounts)
+{
+    EventHandlerTable* pOnEvent = (m_pExtData != nullptr) ? m_pExtData->m_pOnEvent.get() : nullptr;
+    if (pOnEvent == nullptr) {
+        return;
+    }
+    const bool bContextMenuEvent = pOnEvent->IsListening(kEventContextMenu);
+    pOnEvent->RestoreCallbackCounts(callbackCounts);
+    if (bContextMenuEvent && !pOnEvent->IsListening(kEventContextMenu)) {
+        SetContextMenuUsed(false);
+    }
+}
+
 void Control::AttachXmlEvent(EventType eventType, const EventCallback& callback)
 {
-    if (m_pOnXmlEvent == nullptr) {
-        m_pOnXmlEvent = new EventMap;
+    std::unique_ptr<EventHandlerTable>& pEventTable = GetExtData().m_pOnXmlEvent;
+    if (pEventTable == nullptr) {
+        pEventTable = std::make_unique<EventHandlerTable>();
     }
-    (*m_pOnXmlEvent)[eventType] += callback; 
+    pEventTable->AddCallback(eventType, callback);
 }
 
 void Control::DetachXmlEvent(EventType type)
 {
-    if (m_pOnXmlEvent == nullptr) {
+    if ((m_pExtData == nullptr) || (m_pExtData->m_pOnXmlEvent == nullptr)) {
         return;
     }
-    auto event = m_pOnXmlEvent->find(type);
-    if (event != m_pOnXmlEvent->end()) {
-        m_pOnXmlEvent->erase(event);
-    }
+    m_pExtData->m_pOnXmlEvent->RemoveCallbacks(type);
 }
 
 void Control::AttachBubbledEvent(EventType eventType, const EventCallback& callback)
 {
-    if (m_pOnBubbledEvent == nullptr) {
-        m_pOnBubbledEvent = new EventMap;
+    std::unique_ptr<EventHandlerTable>& pEventTable = GetExtData().m_pOnBubbledEvent;
+    if (pEventTable == nullptr) {
+        pEventTable = std::make_unique<EventHandlerTable>();
     }
-    (*m_pOnBubbledEvent)[eventType] += callback;
+    pEventTable->AddCallback(eventType, callback);
 }
 
 void Control::DetachBubbledEvent(EventType eventType)
 {
-    if (m_pOnBubbledEvent == nullptr) {
+    if ((m_pExtData == nullptr) || (m_pExtData->m_pOnBubbledEvent == nullptr)) {
         return;
     }
-    auto event = m_pOnBubbledEvent->find(eventType);
-    if (event != m_pOnBubbledEvent->end()) {
-        m_pOnBubbledEvent->erase(eventType);
-    }
+    m_pExtData->m_pOnBubbledEvent->RemoveCallbacks(eventType);
 }
 
 void Control::AttachXmlBubbledEvent(EventType eventType, const EventCallback& callback)
 {
-    if (m_pOnXmlBubbledEvent == nullptr) {
-        m_pOnXmlBubbledEvent = new EventMap;
+    std::unique_ptr<EventHandlerTable>& pEventTable = GetExtData().m_pOnXmlBubbledEvent;
+    if (pEventTable == nullptr) {
+        pEventTable = std::make_unique<EventHandlerTable>();
     }
-    (*m_pOnXmlBubbledEvent)[eventType] += callback;
+    pEventTable->AddCallback(eventType, callback);
 }
 
 void Control::DetachXmlBubbledEvent(EventType eventType)
 {
-    if (m_pOnXmlBubbledEvent == nullptr) {
+    if ((m_pExtData == nullptr) || (m_pExtData->m_pOnXmlBubbledEvent == nullptr)) {
         return;
     }
-    auto event = m_pOnXmlBubbledEvent->find(eventType);
-    if (event != m_pOnXmlBubbledEvent->end())    {
-        m_pOnXmlBubbledEvent->erase(eventType);
-    }
+    m_pExtData->m_pOnXmlBubbledEvent->RemoveCallbacks(eventType);
 }
 
-bool Control::FireAllEvents(const EventArgs& msg)
+bool Control::HasEventListener(const EventArgs& msg) const
 {
-    if (msg.IsSenderExpired()) {
+    if (m_pExtData == nullptr) {
         return false;
     }
-    std::weak_ptr<WeakFlag> weakflag = GetWeakFlag();
-    bool bRet = true;//当值为false时，就不再调用回调函数和处理函数
-
+    const ControlExtData& extData = *m_pExtData;
+    const EventType eventType = msg.eventType;
     if (msg.GetSender() == this) {
-        if (bRet && (m_pOnEvent != nullptr) && !m_pOnEvent->empty()) {
-            auto callback = m_pOnEvent->find(msg.eventType);
-            if (callback != m_pOnEvent->end()) {
-                bRet = callback->second(msg);
-            }
-            if (weakflag.expired() || msg.IsSenderExpired()) {
-                return false;
-            }
-
-            callback = m_pOnEvent->find(kEventAll);
-            if (callback != m_pOnEvent->end()) {
-                bRet = callback->second(msg);
-            }
-            if (weakflag.expired() || msg.IsSenderExpired()) {
-                return false;
-            }
+        if ((extData.m_pOnEvent != nullptr) && extData.m_pOnEvent->IsListening(eventType)) {
+            return true;
         }
-
-        if (bRet && (m_pOnXmlEvent != nullptr) && !m_pOnXmlEvent->empty()) {
-            auto callback = m_pOnXmlEvent->find(msg.eventType);
-            if (callback != m_pOnXmlEvent->end()) {
-                bRet = callback->second(msg);
-            }
-            if (weakflag.expired() || msg.IsSenderExpired()) {
-                return false;
-            }
-
-            callback = m_pOnXmlEvent->find(kEventAll);
-            if (callback != m_pOnXmlEvent->end()) {
-                bRet = callback->second(msg);
-            }
-            if (weakflag.expired() || msg.IsSenderExpired()) {
-                return false;
-            }
+        if ((extData.m_pOnXmlEvent != nullptr) && extData.m_pOnXmlEvent->IsListening(eventType)) {
+            return true;
         }
     }
+    if ((extData.m_pOnBubbledEvent != nullptr) && extData.m_pOnBubbledEvent->IsListening(eventType)) {
+        return true;
+    }
+    if ((extData.m_pOnXmlBubbledEvent != nullptr) && extData.m_pOnXmlBubbledEvent->IsListening(eventType)) {
+        return true;
+    }
+    return false;
+}
 
-    if (bRet && (m_pOnBubbledEvent != nullptr) && !m_pOnBubbledEvent->empty()) {
-        auto callback = m_pOnBubbledEvent->find(msg.eventType);
-        if (callback != m_pOnBubbledEvent->end()) {
-            bRet = callback->second(msg);
-        }
+bool Control::FireTableEvents(const EventHandlerTable* pEventTable, const EventArgs& msg,
+                              const std::weak_ptr<WeakFlag>& weakflag, bool& bRet) const
+{
+    if ((pEventTable == nullptr) || !pEventTable->IsListening(msg.eventType)) {
+        return true;
+    }
+    if (pEventTable->HasEventType(msg.eventType)) {
+        bRet = pEventTable->FireEvent(msg.eventType, msg);
         if (weakflag.expired() || msg.IsSenderExpired()) {
             return false;
         }
-
-        callback = m_pOnBubbledEvent->find(kEventAll);
-        if (callback != m_pOnBubbledEvent->end()) {
-            bRet = callback->second(msg);
-        }
+    }
+    //回调函数中可能已经移除了kEventAll的回调函数，所以需要重新判断
+    if (pEventTable->HasEventType(kEventAll)) {
+        bRet = pEventTable->FireEvent(kEventAll, msg);
         if (weakflag.expired() || msg.IsSenderExpired()) {
             return false;
         }
     }
+    return true;
+}
 
-    if (bRet && (m_pOnXmlBubbledEvent != nullptr) && !m_pOnXmlBubbledEvent->empty()) {
-        auto callback = m_pOnXmlBubbledEvent->find(msg.eventType);
-        if (callback != m_pOnXmlBubbledEvent->end()) {
-            bRet = callback->second(msg);
-        }
-        if (weakflag.expired() || msg.IsSenderExpired()) {
-            return false;
-        }
+bool Control::FireAllEvents(const EventArgs& msg)
+{
+    if (msg.IsSenderExpired()) {
+        return false;
+    }
+    if (!HasEventListener(msg)) {
+        //没有监听该事件的回调函数（大部分控件、大部分事件是这种情况），直接返回
+        return true;
+    }
+    std::weak_ptr<WeakFlag> weakflag = GetWeakFlag();
+    bool bRet = true;//当值为false时，就不再调用回调函数和处理函数
 
-        callback = m_pOnXmlBubbledEvent->find(kEventAll);
-        if (callback != m_pOnXmlBubbledEvent->end()) {
-            bRet = callback->second(msg);
+    //注意：回调函数中可能销毁本控件，每次调用后，需要先判断控件是否有效，再访问成员变量
+    //（有监听者时，m_pExtData一定存在，且在控件销毁前不会释放）
+    if (msg.GetSender() == this) {
+        if (bRet && !FireTableEvents(m_pExtData->m_pOnEvent.get(), msg, weakflag, bRet)) {
+            return false;
         }
-        if (weakflag.expired() || msg.IsSenderExpired()) {
+        if (bRet && !FireTableEvents(m_pExtData->m_pOnXmlEvent.get(), msg, weakflag, bRet)) {
             return false;
         }
     }
+    if (bRet && !FireTableEvents(m_pExtData->m_pOnBubbledEvent.get(), msg, weakflag, bRet)) {
+        return false;
+    }
+    if (bRet && !FireTableEvents(m_pExtData->m_pOnXmlBubbledEvent.get(), msg, weakflag, bRet)) {
+        return false;
+    }
     return bRet && !weakflag.expired();
 }
 
@@ -3220,6 +3643,48 @@ UiColor Control::GetUiColor(const DString& colorName) const
     return color;
 }
 
+UiColor Control::GetUiColor(const UiColorToken& colorToken) const
+{
+    if (colorToken.empty()) {
+        return UiColor();
+    }
+    if (colorToken.IsDirectColor()) {
+        return colorToken.GetDirectColor();
+    }
+    //颜色名称：按缓存的颜色表槽位读取，颜色表结构或者所属窗口变化时重新解析
+    const Window* pWindow = GetWindow();
+    const ColorMap* pWindowColorMap = (pWindow != nullptr) ? &pWindow->GetColorMap() : nullptr;
+    const ColorManager& colorManager = GlobalManager::Instance().Color();
+    const uint32_t nWindowVersion = (pWindowColorMap != nullptr) ? pWindowColorMap->GetVersion() : 0;
+    const uint32_t nGlobalVersion = colorManager.GetColorMap().GetVersion();
+    UiColor color;
+    if (colorToken.GetCachedColor(pWindow, nWindowVersion, nGlobalVersion, color)) {
+        return color;
+    }
+    //按优先级查找颜色所在的颜色表：窗口颜色表、全局颜色表、标准颜色表（与GetUiColorByName的顺序一致）
+    const DString colorName = colorToken.c_str();
+    const ColorMap* pPalette = nullptr;
+    uint32_t nSlot = 0;
+    if ((pWindowColorMap != nullptr) && pWindowColorMap->FindColorSlot(colorName, nSlot)) {
+        pPalette = pWindowColorMap;
+    }
+    else if (colorManager.GetColorMap().FindColorSlot(colorName, nSlot)) {
+        pPalette = &colorManager.GetColorMap();
+    }
+    else if (colorManager.GetStandardColorMap().FindColorSlot(StringUtil::MakeLowerString(colorName), nSlot)) {
+        pPalette = &colorManager.GetStandardColorMap();
+    }
+    if (pPalette != nullptr) {
+        colorToken.SetCachedSlot(pWindow, nWindowVersion, nGlobalVersion, pPalette, nSlot);
+        color = pPalette->GetColorAt(nSlot);
+    }
+    else {
+        color = GetUiColorByName(colorName);
+    }
+    ASSERT(!color.IsEmpty());
+    return color;
+}
+
 UiColor Control::GetUiColorByName(const DString& colorName) const
 {
     UiColor color;
@@ -3261,8 +3726,8 @@ DString Control::GetColorString(const UiColor& color) const
 
 bool Control::HasBoxShadow() const
 {
-    if (m_pBoxShadow != nullptr) {
-        return m_pBoxShadow->HasShadow();
+    if ((m_pExtData != nullptr) && (m_pExtData->m_pBoxShadow != nullptr)) {
+        return m_pExtData->m_pBoxShadow->HasShadow();
     }
     return false;
 }
@@ -3356,7 +3821,53 @@ uint8_t Control::GetPaintOrder() const
 
 IFont* Control::GetIFontById(const DString& strFontId) const
 {
-    return GlobalManager::Instance().Font().GetIFont(strFontId, this->Dpi());
+    return GetCachedIFont(strFontId.c_str());
+}
+
+IFont* Control::GetCachedIFont(const DString::value_type* szFontId) const
+{
+    if (szFontId == nullptr) {
+        szFontId = _T("");
+    }
+    FontManager& fontManager = GlobalManager::Instance().Font();
+    const uint32_t nDpiScale = Dpi().GetScale();
+    const uint32_t nFontGeneration = fontManager.GetFontGeneration();
+    //缓存不影响控件的状态，所以在const函数中也可以分配扩展数据
+    ControlExtData& extData = const_cast<Control*>(this)->GetExtData();
+    for (const ControlExtData::FontCacheEntry& entry : extData.m_fontCache) {
+        if ((entry.m_pFont != nullptr) &&
+            (entry.m_nDpiScale == nDpiScale) &&
+            (entry.m_nFontGeneration == nFontGeneration) &&
+            entry.m_fontId.equals(szFontId)) {
+            return entry.m_pFont;
+        }
+    }
+    IFont* pFont = fontManager.GetIFont(szFontId, nDpiScale);
+    if (pFont == nullptr) {
+        return nullptr;
+    }
+
+    //选择槽位：优先选已失效的槽位，其次替换最早放入的槽位
+    ControlExtData::FontCacheEntry* pEntry = nullptr;
+    for (ControlExtData::FontCacheEntry& entry : extData.m_fontCache) {
+        if ((entry.m_pFont == nullptr) || (entry.m_nFontGeneration != nFontGeneration)) {
+            pEntry = &entry;
+            break;
+        }
+    }
+    if (pEntry == nullptr) {
+        pEntry = &extData.m_fontCache[extData.m_nNextFontCacheSlot];
+        extData.m_nNextFontCacheSlot = (uint8_t)((extData.m_nNextFontCacheSlot + 1) % ControlExtData::kFontCacheSlots);
+    }
+    if (!pEntry->m_fontId.equals(szFontId)) {
+        //字体ID相同时（比如版本号变化），不重新分配字符串
+        pEntry->m_fontId = szFontId;
+    }
+    pEntry->m_nDpiScale = nDpiScale;
+    //GetIFont可能创建字体，但不改变版本号，所以版本号在查找前获取即可
+    pEntry->m_nFontGeneration = nFontGeneration;
+    pEntry->m_pFont = pFont;
+    return pFont;
 }
 
 } // namespace ui
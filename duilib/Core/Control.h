@@ -3,6 +3,7 @@
 
 #include "duilib/Core/PlaceHolder.h"
 #include "duilib/Core/BoxShadow.h"
+#include "duilib/Core/UiColorToken.h"
 #include "duilib/Utils/Delegate.h"
 #include "duilib/Core/Keyboard.h"
 #include <map>
@@ -17,9 +18,13 @@ namespace ui
     class StateColorMap;
     class StateImageMap;
     class AnimationManager;
+    class AnimationPlayer;
     class IRender;
+    class IBitmap;
+    class IPicture;
     class IPath;
     class IFont;
+    struct CompiledLayoutValue;
 
     typedef Control* (CALLBACK* FINDCONTROLPROC)(Control*, void*);
 
@@ -588,6 +593,23 @@ public:
      */
     void SetClass(const DString& strClass);
 
+    /**
+     * @brief 应用一个 class 全局属性（先查找全局的 class，再查找窗口的 class）
+     * @param[in] strClassName 一个 class 名称（不含空格）
+     * @return 无
+     */
+    void ApplyClass(const DString& strClassName);
+
+    /**
+     * @brief 使用预编译布局中预先解析的属性值设置属性
+     *        仍然通过虚函数 SetAttribute 设置（派生类的重载照常处理该属性），
+     *        基类处理尺寸类属性（width/height/margin/padding/border_round）时直接使用预先解析的值，不再解析字符串
+     * @param[in] strName 要设置的属性名称（如 width）
+     * @param[in] strValue 要设置的属性值（字符串形式）
+     * @param[in] parsedValue 预先解析的属性值（数值、矩形等）
+     */
+    void SetParsedAttribute(const DString& strName, const DString& strValue, const CompiledLayoutValue& parsedValue);
+
     /**
      * @brief 应用一套属性列表
      * @param[in] strList 属性列表的字符串表示，如 `width="100" height="30"`
@@ -670,6 +692,21 @@ public:
     */
     bool IsClip() const { return m_bClip; }
 
+    /** 设置控件的绘制操作是否可以被录制后并行回放（参见Window::SetEnableParallelPaint）
+    * @param [in] bRecordable true表示可以录制；如果控件绘制时需要直接读写画布的像素数据，应设置为false
+    */
+    void SetPaintRecordable(bool bRecordable);
+
+    /** 判断控件的绘制操作是否可以被录制后并行回放
+    */
+    virtual bool IsPaintRecordable() const { return m_bPaintRecordable; }
+
+    /** 判断控件自身绘制的内容是否只有纯色（背景颜色、状态颜色），没有图片、文本、边框等其他内容
+    *   容器滚动时，据此判断能否直接复制已经绘制的像素（参见ScrollBox::CanScrollBlit）
+    * @param [in] bCheckBorder 是否检查边框
+    */
+    virtual bool IsPaintSolidColorOnly(bool bCheckBorder) const;
+
     /**
      * @brief 设置控件透明度
      * @param[in] alpha 0 ~ 255 的透明度值，255 为不透明
@@ -759,12 +796,18 @@ public:
      */
     AnimationManager& GetAnimationManager();
 
+    /** @brief 获取指定类型的动画播放器（不创建动画管理器）
+     * @return 如果该类型的动画不存在，返回nullptr
+     */
+    AnimationPlayer* GetAnimationPlayer(AnimationType animationType) const;
+
     /// 图片缓存
     /**@brief 根据图片路径, 加载图片信息到缓存中。
      *        加载策略：如果图片没有加载则执行加载图片；如果图片路径发生变化，则重新加载该图片。
      * @param[in，out] duiImage 传入时标注图片的路径信息，如果成功则会缓存图片并记录到该参数的成员中
+     * @param[in] bAsyncReload 如果图片已加载但DPI缩放百分比发生变化，是否在后台异步加载新DPI下的图片（加载完成前继续使用原图片）
      */
-    bool LoadImageData(Image& duiImage) const;
+    bool LoadImageData(Image& duiImage, bool bAsyncReload = false) const;
 
     /**@brief 清理图片缓存
      */
@@ -784,6 +827,10 @@ public:
     */
     virtual void ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale);
 
+    /** 语言发生变化（重新加载了语言文件），更新使用多语言文本ID的控件文本
+    */
+    virtual void ChangeLanguage();
+
 public:
     /** 监听控件所有事件
      * @param[in] callback 事件处理的回调函数，请参考 EventCallback 声明
@@ -900,6 +947,12 @@ public:
     */
     UiColor GetUiColor(const DString& colorName) const;
 
+    /** 获取预解析颜色对应的值（颜色值缓存在colorToken中，颜色表或者所属窗口变化时自动重新解析）
+    * @param [in] colorToken 预解析的颜色，颜色名称的规则同GetUiColor(const DString&)函数
+    * @return ARGB颜色值
+    */
+    UiColor GetUiColor(const UiColorToken& colorToken) const;
+
     /** 获取颜色值对应的字符串, 返回该颜色对应的字符串
     * @param [in] color 颜色值
     * @return 返回颜色值对应的字符串，比如"#FF123456"
@@ -949,6 +1002,20 @@ public:
      */
     void DetachEvent(EventType type);
 
+    /**@brief (m_pOnEvent)取消监听所有事件（不影响XML中配置的事件）
+     */
+    void DetachAllEvents();
+
+    /**@brief (m_pOnEvent)获取每个事件类型的回调函数个数，可用于RestoreEventCallbackCounts恢复
+     * @param[out] callbackCounts 返回每个事件类型的回调函数个数
+     */
+    void GetEventCallbackCounts(EventHandlerTable::CallbackCounts& callbackCounts) const;
+
+    /**@brief (m_pOnEvent)移除GetEventCallbackCounts之后添加的回调函数（不影响XML中配置的事件）
+     * @param[in] callbackCounts 由GetEventCallbackCounts返回的每个事件类型的回调函数个数
+     */
+    void RestoreEventCallbackCounts(const EventHandlerTable::CallbackCounts& callbackCounts);
+
     /**@brief (m_pOnXmlEvent)通过XML中，配置<Event标签添加的响应事件，最终由Control::OnApplyAttributeList函数响应具体操作
      * @param[in] type 事件类型，见 EventType 枚举
      * @param[in] callback 事件处理的回调函数，请参考 EventCallback 声明
@@ -990,6 +1057,22 @@ public:
 
     /** @} */
 
+private:
+    /** 是否有监听该事件的回调函数（根据各个回调函数表的事件类型掩码判断，无需查找）
+    * @param [in] msg 消息内容
+    */
+    bool HasEventListener(const EventArgs& msg) const;
+
+    /** 调用一个回调函数表中监听该事件的回调函数（包括监听kEventAll的回调函数）
+    * @param [in] pEventTable 回调函数表
+    * @param [in] msg 消息内容
+    * @param [in] weakflag 本控件的有效期标志
+    * @param [out] bRet 返回回调函数的返回值
+    * @return 如果本控件或者消息的发送者已经销毁，返回false；否则返回true
+    */
+    bool FireTableEvents(const EventHandlerTable* pEventTable, const EventArgs& msg,
+                         const std::weak_ptr<WeakFlag>& weakflag, bool& bRet) const;
+
 protected:
 
     //处理放弃控件焦点相关逻辑 
@@ -1201,6 +1284,13 @@ public:
     */
     IFont* GetIFontById(const DString& strFontId) const;
 
+protected:
+    /** 获取一个字体ID对应的字体数据接口：结果按控件缓存，字体ID、DPI和字体版本号不变时，不再查找字体
+    * @param[in] szFontId 字体ID
+    * @return 成功返回字体接口，外部调用不需要释放资源；如果失败则返回nullptr
+    */
+    IFont* GetCachedIFont(const DString::value_type* szFontId) const;
+
 private:
 
     /** 获取颜色名称对应的颜色值
@@ -1211,6 +1301,18 @@ private:
     */
     bool HasBoxShadow() const;
 
+    /** 绘制缓存是否使用显示列表（参见SetCacheMode）
+    */
+    bool IsUsePictureCache() const;
+
+    /** 使用显示列表缓存绘制控件
+    * @param [in] pRender 渲染接口
+    * @param [in] isAlpha 控件是否设置了透明度（设置了透明度时，子控件也录制到缓存中）
+    * @param [in] bRoundClip 是否为圆角矩形区域裁剪
+    * @return 如果完成了绘制返回true；如果录制失败返回false，需要改用位图缓存绘制
+    */
+    bool AlphaPaintPicture(IRender* pRender, bool isAlpha, bool bRoundClip);
+
     /** 设置控件状态的值，并触发状态变化事件
      * @param[in] controlState 要设置的控件状态，请参考 `ControlStateType` 枚举
      */
@@ -1220,19 +1322,19 @@ private:
     */
     int8_t GetColor2Direction(const UiString& bkColor2Direction) const;
 
+    /** 通过图集绘制小图片（仅在批量绘制图集图片时使用，不缩放）
+    * @param [in] nDpiScale 图片加载时的DPI缩放比
+    * @return 如果图片不能放入图集，返回false，需要按原方式绘制
+    */
+    bool PaintAtlasImage(IRender* pRender, IBitmap* pBitmap, uint32_t nDpiScale,
+                         const UiRect& rcDest, const UiRect& rcSource, uint8_t uFade) const;
+
 private:
     /** 边框圆角大小(与m_rcBorderSize联合应用)或者阴影的圆角大小(与m_boxShadow联合应用)
         仅当 m_rcBorderSize 四个边框值都有效, 并且都相同时
     */
     UiSize m_cxyBorderRound;
 
-    //控件阴影，其圆角大小通过m_cxyBorderRound变量控制
-    BoxShadow* m_pBoxShadow;
-
-    /** 焦点状态下的边框颜色
-    */
-    UiString m_focusBorderColor;
-
     /** 边框颜色, 每个状态可以指定不同的边框颜色
     */
     std::unique_ptr<StateColorMap> m_pBorderColorMap;
@@ -1242,22 +1344,12 @@ private:
 
 private:
     //控件的背景颜色
-    UiString m_strBkColor;
-
-    //控件的第二背景色(实现渐变背景色)
-    UiString m_strBkColor2;
-
-    //控件的第二背景色方向：："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
-    UiString m_strBkColor2Direction;
+    UiColorToken m_strBkColor;
 
     //控件的背景图片
     std::shared_ptr<Image> m_pBkImage;
 
 private:
-    /** 控件状态(ControlStateType)
-    */
-    int8_t m_controlState;
-
     /** 状态与颜色值MAP，每个状态可以指定不同的颜色
     */
     std::unique_ptr<StateColorMap> m_pColorMap;
@@ -1267,99 +1359,78 @@ private:
     std::unique_ptr<StateImageMap> m_pImageMap;
 
 private:
-    /** 控件"加载中"逻辑的实现接口
-    */
-    ControlLoading* m_pLoading;
-
-private:
-    //控件动画播放管理器
-    std::unique_ptr<AnimationManager> m_animationManager;
-
     //控件播放动画时的渲染偏移(X坐标偏移和Y坐标偏移)
     UiPoint m_renderOffset;
-    
-    //控件的透明度（0 - 255，0为完全透明，255为不透明）
-    uint8_t m_nAlpha;
-
-    //控件为Hot状态时的透明度（0 - 255，0为完全透明，255为不透明）
-    uint8_t m_nHotAlpha;
-
-    //是否对绘制范围做剪裁限制
-    bool m_bClip;
 
     //控件的绘制区域
     UiRect m_rcPaint;
 
-    //绘制渲染引擎接口
-    std::unique_ptr<IRender> m_render;
-
-    //box-shadow是否已经绘制（由于box-shadow绘制会超过GetRect()范围，所以需要特殊处理）
-    bool m_isBoxShadowPainted;
-
 private:
-    //ToolTip的宽度
-    uint16_t m_nTooltipWidth;
+    /** 不常用的控件数据（ToolTip、用户数据、事件监听表、动画、绘制缓存、阴影等），首次使用时分配
+    *   大部分控件不使用这些数据，集中存放可以减少每个控件的内存占用
+    */
+    struct ControlExtData;
+    std::unique_ptr<ControlExtData> m_pExtData;
 
-    //ToolTip的文本内容
-    UiString m_sToolTipText;
+    /** 获取不常用的控件数据，如果不存在则创建
+    */
+    ControlExtData& GetExtData();
 
-    //ToolTip的文本ID
-    UiString m_sToolTipTextId;
+    /** 获取控件"加载中"逻辑的实现接口（未设置时返回nullptr）
+    */
+    ControlLoading* GetLoading() const;
 
 private:
-    
-    //用户数据ID(字符串)
-    UiString m_sUserDataID;
-
-    //用户数据ID(整型值)
-    size_t m_uUserDataID;
+    //控件状态(ControlStateType)
+    int8_t m_controlState;
 
-private:
-    //通过AttachXXX接口，添加的监听事件
-    EventMap* m_pOnEvent;
+    //控件的光标类型(CursorType)
+    CursorType m_cursorType;
 
-    //通过XML中，配置<Event标签添加的响应事件，最终由Control::OnApplyAttributeList函数响应具体操作
-    EventMap* m_pOnXmlEvent;
+    //控件的透明度（0 - 255，0为完全透明，255为不透明）
+    uint8_t m_nAlpha;
 
-    //通过AttachBubbledEvent接口添加的事件
-    EventMap* m_pOnBubbledEvent;
+    //控件为Hot状态时的透明度（0 - 255，0为完全透明，255为不透明）
+    uint8_t m_nHotAlpha;
 
-    //通过XML中，配置<BubbledEvent标签添加的响应事件，最终由Control::OnApplyAttributeList函数响应具体操作
-    EventMap* m_pOnXmlBubbledEvent;
+    //绘制顺序: 0 表示常规绘制，非0表示指定绘制顺序，值越大表示绘制越晚绘制
+    uint8_t m_nPaintOrder;
 
-private:
     //控件的Enable状态（当为false的时候，不响应鼠标、键盘等输入消息）
-    bool m_bEnabled;
+    bool m_bEnabled : 1;
 
     //鼠标消息的Enable状态（当为false的时候，不响应鼠标消息）
-    bool m_bMouseEnabled;
+    bool m_bMouseEnabled : 1;
 
     //键盘消息的Enable状态（当为false的时候，不响应键盘消息）
-    bool m_bKeyboardEnabled;
+    bool m_bKeyboardEnabled : 1;
 
     //鼠标焦点是否在控件上
-    bool m_bMouseFocused;
+    bool m_bMouseFocused : 1;
 
     //控件是否响应上下文菜单
-    bool m_bContextMenuUsed;
+    bool m_bContextMenuUsed : 1;
 
     //控件不需要焦点（如果为true，则控件不会获得焦点）
-    bool m_bNoFocus;
+    bool m_bNoFocus : 1;
 
     //是否允许TAB切换焦点
-    bool m_bAllowTabstop;
-
-    //控件的光标类型(CursorType)
-    CursorType m_cursorType;
+    bool m_bAllowTabstop : 1;
 
     //是否显示焦点状态(一个虚线构成的矩形)
-    bool m_bShowFocusRect;
+    bool m_bShowFocusRect : 1;
 
-    //焦点状态虚线矩形的颜色
-    UiString m_focusRectColor;
+    //是否对绘制范围做剪裁限制
+    bool m_bClip : 1;
 
-    //绘制顺序: 0 表示常规绘制，非0表示指定绘制顺序，值越大表示绘制越晚绘制
-    uint8_t m_nPaintOrder;
+    //控件的绘制操作是否可以被录制后并行回放
+    bool m_bPaintRecordable : 1;
+
+    //录制显示列表失败（控件绘制时需要读写像素数据），不再使用显示列表缓存
+    bool m_bPictureCacheFailed : 1;
+
+    //box-shadow是否已经绘制（由于box-shadow绘制会超过GetRect()范围，所以需要特殊处理）
+    bool m_isBoxShadowPainted : 1;
 };
 
 } // namespace ui
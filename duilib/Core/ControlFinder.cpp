@@ -1,12 +1,15 @@
 #include "ControlFinder.h"
 #include "duilib/Core/Box.h"
 #include "duilib/Core/Control.h"
+#include "duilib/Box/ScrollBox.h"
+#include <algorithm>
 
 namespace ui
 {
 
 ControlFinder::ControlFinder():
-    m_pRoot(nullptr)
+    m_pRoot(nullptr),
+    m_pHitControl(nullptr)
 {
 }
 
@@ -17,24 +20,129 @@ ControlFinder::~ControlFinder()
 void ControlFinder::SetRoot(Box* pRoot)
 {
     m_pRoot = pRoot;
+    InvalidateHitTestCache();
 }
 
 void ControlFinder::Clear()
 {
     m_pRoot = nullptr;
     m_mNameHash.clear();
+    InvalidateHitTestCache();
+}
+
+void ControlFinder::InvalidateHitTestCache()
+{
+    m_pHitControl = nullptr;
+    m_hitParents.clear();
+    m_rcHitTest.Clear();
 }
 
 Control* ControlFinder::FindControl(const UiPoint& pt) const
 {
     ASSERT(m_pRoot != nullptr);
     if (m_pRoot != nullptr) {
+        //鼠标仍在上次查找到的控件的独占区域内，直接返回该控件
+        if ((m_pHitControl != nullptr) && m_rcHitTest.ContainsPt(pt) && IsHitTestCacheValid()) {
+            return m_pHitControl;
+        }
         UiPoint ptLocal = pt;
-        return m_pRoot->FindControl(__FindControlFromPoint, &ptLocal, UIFIND_VISIBLE | UIFIND_HITTEST | UIFIND_TOP_FIRST, pt);
+        Control* pControl = m_pRoot->FindControl(__FindControlFromPoint, &ptLocal, UIFIND_VISIBLE | UIFIND_HITTEST | UIFIND_TOP_FIRST, pt);
+        UpdateHitTestCache(pControl);
+        return pControl;
     }
     return nullptr;
 }
 
+bool ControlFinder::IsHitTestCacheValid() const
+{
+    //与Control::FindControl和Box::FindControl的判断条件保持一致
+    if (!m_pHitControl->IsVisible() || !m_pHitControl->IsMouseEnabled()) {
+        return false;
+    }
+    for (Control* pParent : m_hitParents) {
+        Box* pBox = static_cast<Box*>(pParent);
+        if (!pBox->IsVisible() || !pBox->IsMouseChildEnabled()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ControlFinder::UpdateHitTestCache(Control* pHitControl) const
+{
+    m_pHitControl = nullptr;
+    m_hitParents.clear();
+    m_rcHitTest.Clear();
+    if ((pHitControl == nullptr) || (m_pRoot == nullptr)) {
+        return;
+    }
+    UiRect rcHitTest = GetRectInWindow(pHitControl, pHitControl->GetRect());
+    Box* pHitBox = dynamic_cast<Box*>(pHitControl);
+    if ((pHitBox != nullptr) && HasOverlappedItem(pHitBox, nullptr, rcHitTest)) {
+        //命中的是容器，而鼠标移动后可能命中其子控件
+        return;
+    }
+    std::vector<Control*> hitParents;
+    Control* pChild = pHitControl;
+    Box* pParent = pChild->GetParent();
+    while (pParent != nullptr) {
+        //只缓存父容器的普通子控件（滚动条等不在子控件列表中的控件，不使用缓存）
+        const size_t nIndex = pParent->GetItemIndex(pChild);
+        if (!Box::IsValidItemIndex(nIndex) || (pParent->GetItemAt(nIndex) != pChild)) {
+            return;
+        }
+        //非浮动的控件，只在各级父容器除去内边距的区域内可被命中
+        const UiRect rcParent = pHitControl->IsFloat() ? pParent->GetRect() : pParent->GetRectWithoutPadding();
+        rcHitTest.Intersect(GetRectInWindow(pParent, rcParent));
+        if (rcHitTest.IsEmpty() || HasOverlappedItem(pParent, pChild, rcHitTest)) {
+            return;
+        }
+        hitParents.push_back(pParent);
+        pChild = pParent;
+        pParent = pChild->GetParent();
+    }
+    if (pChild != m_pRoot) {
+        return;
+    }
+    m_pHitControl = pHitControl;
+    m_hitParents.swap(hitParents);
+    m_rcHitTest = rcHitTest;
+}
+
+bool ControlFinder::HasOverlappedItem(Box* pBox, const Control* pExclude, const UiRect& rcHitTest)
+{
+    UiRect rcTemp;
+    const size_t nItemCount = pBox->GetItemCount();
+    for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+        Control* pItem = pBox->GetItemAt(nIndex);
+        if ((pItem == nullptr) || (pItem == pExclude) || !pItem->IsVisible()) {
+            continue;
+        }
+        if (UiRect::Intersect(rcTemp, rcHitTest, GetRectInWindow(pItem, pItem->GetRect()))) {
+            return true;
+        }
+    }
+    ScrollBox* pScrollBox = dynamic_cast<ScrollBox*>(pBox);
+    if (pScrollBox != nullptr) {
+        Control* pScrollBars[2] = { pScrollBox->GetVScrollBar(), pScrollBox->GetHScrollBar() };
+        for (Control* pScrollBar : pScrollBars) {
+            if ((pScrollBar != nullptr) && pScrollBar->IsVisible() &&
+                UiRect::Intersect(rcTemp, rcHitTest, GetRectInWindow(pScrollBox, pScrollBar->GetRect()))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+UiRect ControlFinder::GetRectInWindow(const Control* pControl, const UiRect& rcControl)
+{
+    UiRect rc = rcControl;
+    UiPoint scrollOffset = pControl->GetScrollOffsetInScrollBox();
+    rc.Offset(-scrollOffset.x, -scrollOffset.y);
+    return rc;
+}
+
 Control* ControlFinder::FindContextMenuControl(const UiPoint* pt) const
 {
     Control* pControl = nullptr;
@@ -66,7 +174,12 @@ Box* ControlFinder::FindDroppableBox(const UiPoint& pt, uint8_t nDropInId) const
 Control* ControlFinder::FindControl2(const DString& strName) const
 {
     Control* pFindedControl = nullptr;
-    auto it = m_mNameHash.find(strName);
+    //名称不在原子表中，说明不存在该名称的控件
+    const UiAtom nameAtom = AtomTable::FindAtom(strName);
+    if (nameAtom.IsEmpty()) {
+        return nullptr;
+    }
+    auto it = m_mNameHash.find(nameAtom);
     if (it != m_mNameHash.end()) {
         pFindedControl = it->second;
     }
@@ -103,9 +216,13 @@ void ControlFinder::RemoveControl(Control* pControl)
     if (pControl == nullptr) {
         return;
     }
-    const DString sName = pControl->GetName();
-    if (!sName.empty()) {
-        auto it = m_mNameHash.find(sName);
+    if ((pControl == m_pHitControl) ||
+        (std::find(m_hitParents.begin(), m_hitParents.end(), pControl) != m_hitParents.end())) {
+        InvalidateHitTestCache();
+    }
+    const UiAtom& nameAtom = pControl->GetNameAtom();
+    if (!nameAtom.IsEmpty()) {
+        auto it = m_mNameHash.find(nameAtom);
         if (it != m_mNameHash.end()) {
             m_mNameHash.erase(it);
         }
@@ -117,11 +234,11 @@ void ControlFinder::AddControl(Control* pControl)
     if (pControl == nullptr) {
         return;
     }
-    const DString sName = pControl->GetName();
-    if (sName.empty()) {
+    const UiAtom& nameAtom = pControl->GetNameAtom();
+    if (nameAtom.IsEmpty()) {
         return;
     }
-    auto iter = m_mNameHash.find(sName);
+    auto iter = m_mNameHash.find(nameAtom);
     if (iter != m_mNameHash.end()) {
         if (iter->second != pControl) {
             //控件名称相同的，覆盖
@@ -129,7 +246,7 @@ void ControlFinder::AddControl(Control* pControl)
         }
     }
     else {
-        m_mNameHash[sName] = pControl;
+        m_mNameHash[nameAtom] = pControl;
     }
 }
 
@@ -187,11 +304,11 @@ Control* CALLBACK ControlFinder::__FindControlFromName(Control* pThis, void* pDa
     if ((pstrName == nullptr) || (pThis == nullptr)) {
         return nullptr;
     }
-    const DString sName = pThis->GetName();
-    if (sName.empty()) {
+    const UiAtom& nameAtom = pThis->GetNameAtom();
+    if (nameAtom.IsEmpty()) {
         return nullptr;
     }
-    return (StringUtil::StringICompare(sName.c_str(), pstrName) == 0) ? pThis : nullptr;
+    return (StringUtil::StringICompare(nameAtom.c_str(), pstrName) == 0) ? pThis : nullptr;
 }
 
 Control* CALLBACK ControlFinder::__FindContextMenuControl(Control* pThis, void* /*pData*/)
@@ -2,9 +2,11 @@
 #define UI_CORE_CONTROL_FINDER_H_
 
 #include "duilib/Core/UiPoint.h"
+#include "duilib/Core/UiRect.h"
+#include "duilib/Core/UiAtom.h"
 #include <string>
 #include <vector>
-#include <map>
+#include <unordered_map>
 
 namespace ui 
 {
@@ -101,6 +103,10 @@ public:
     */
     void Clear();
 
+    /** 使命中测试的缓存失效（控件布局、滚动位置、可见性变化或者控件被回收时调用）
+    */
+    void InvalidateHitTestCache();
+
 public:
     static Control* CALLBACK __FindControlFromPoint(Control* pThis, void* pData);
     static Control* CALLBACK __FindControlFromTab(Control* pThis, void* pData);
@@ -109,14 +115,40 @@ public:
     static Control* CALLBACK __FindContextMenuControl(Control* pThis, void* pData);
     static Control* CALLBACK __FindControlFromDroppableBox(Control* pThis, void* pData);
 
+private:
+    /** 检查缓存的控件及其父控件链的状态是否仍然可被命中
+    */
+    bool IsHitTestCacheValid() const;
+
+    /** 根据查找结果更新命中测试的缓存
+    * @param [in] pHitControl 查找到的控件
+    */
+    void UpdateHitTestCache(Control* pHitControl) const;
+
+    /** 判断容器中除pExclude以外的可见子控件（含滚动条），是否与指定区域（窗口坐标）有重叠
+    */
+    static bool HasOverlappedItem(Box* pBox, const Control* pExclude, const UiRect& rcHitTest);
+
+    /** 将控件坐标中的区域转换为窗口坐标（去除各级父容器的滚动偏移）
+    */
+    static UiRect GetRectInWindow(const Control* pControl, const UiRect& rcControl);
+
 private:
     /** 根节点
     */
     Box* m_pRoot;
 
-    /** 控件的name与接口之间的映射
+    /** 控件的name（原子）与接口之间的映射
+    */
+    std::unordered_map<UiAtom, Control*> m_mNameHash;
+
+    /** 命中测试的缓存：上次根据坐标查找到的控件，以及其父控件链（从父控件到根节点）
+    *   鼠标仍在m_rcHitTest范围内时，直接返回该控件，不需要遍历控件树；
+    *   m_rcHitTest是该控件与各级父容器可见区域的交集，且不与其他可见控件重叠（有重叠时不使用缓存）
     */
-    std::map<DString, Control*> m_mNameHash;
+    mutable Control* m_pHitControl;
+    mutable std::vector<Control*> m_hitParents;
+    mutable UiRect m_rcHitTest;
 };
 
 } // namespace ui
@@ -4,12 +4,14 @@
 #include "duilib/Render/IRender.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/FileUtil.h"
 
 namespace ui 
 {
 
 FontManager::FontManager():
-    m_bDefaultFontInited(false)
+    m_bDefaultFontInited(false),
+    m_nFontGeneration(0)
 {
 }
 
@@ -44,6 +46,8 @@ bool FontManager::AddFont(const DString& fontId, const UiFont& fontInfo, bool bD
         //默认字体ID
         m_defaultFontId = fontId;
     }
+    //该字体ID此前可能被解析为默认字体
+    ++m_nFontGeneration;
     return true;
 }
 
@@ -52,8 +56,14 @@ const DString& FontManager::GetDefaultFontId() const
     return m_defaultFontId;
 }
 
+uint32_t FontManager::GetFontGeneration() const
+{
+    return m_nFontGeneration;
+}
+
 void FontManager::SetDefaultFontFamilyNames(const DString& defaultFontFamilyNames)
 {
+    ++m_nFontGeneration;
     m_defaultFontFamilyNames.clear();
     m_bDefaultFontInited = false;
     if (!defaultFontFamilyNames.empty()) {
@@ -230,6 +240,9 @@ bool FontManager::RemoveFontId(const DString& fontId)
         m_fontIdMap.erase(pos);
         bDeleted = true;
     }
+    if (bDeleted) {
+        ++m_nFontGeneration;
+    }
     return bDeleted;
 }
 
@@ -246,6 +259,7 @@ bool FontManager::RemoveIFont(const DString& fontId, uint32_t nZoomPercent)
             }
             bDeleted = true;
             m_fontMap.erase(iter);
+            ++m_nFontGeneration;
         }
     }
     return bDeleted;
@@ -262,6 +276,7 @@ void FontManager::RemoveAllFonts()
     m_fontMap.clear();
     m_defaultFontId.clear();
     m_fontIdMap.clear();
+    ++m_nFontGeneration;
 
     IFontMgr* pFontMgr = nullptr;
     IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
@@ -286,6 +301,22 @@ bool FontManager::AddFontFile(const DString& strFontFile, const DString& /*strFo
         return false;
     }
 
+    //优先使用预先读取的字体文件数据
+    std::vector<uint8_t> preloadData;
+    {
+        std::lock_guard<std::mutex> threadGuard(m_preloadMutex);
+        auto iter = m_preloadFontFiles.find(strFontFile);
+        if (iter != m_preloadFontFiles.end()) {
+            preloadData.swap(iter->second);
+            m_preloadFontFiles.erase(iter);
+        }
+    }
+    if (!preloadData.empty()) {
+        bool bRet = pFontMgr->LoadFontFileData(preloadData.data(), preloadData.size());
+        ASSERT(bRet);
+        return bRet;
+    }
+
     bool bRet = false;
     if (GlobalManager::Instance().Zip().IsUseZip()) {
         std::vector<unsigned char> file_data;
@@ -302,8 +333,37 @@ bool FontManager::AddFontFile(const DString& strFontFile, const DString& /*strFo
     return bRet;
 }
 
+bool FontManager::PreloadFontFile(const DString& strFontFile)
+{
+    if (strFontFile.empty()) {
+        return false;
+    }
+    FilePath fontFilePath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetFontFilePath(), FilePath(strFontFile));
+    std::vector<uint8_t> fileData;
+    if (!ReadFontFileData(fontFilePath, fileData) || fileData.empty()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> threadGuard(m_preloadMutex);
+    m_preloadFontFiles[strFontFile].swap(fileData);
+    return true;
+}
+
+bool FontManager::ReadFontFileData(const FilePath& fontFilePath, std::vector<uint8_t>& fileData)
+{
+    if (GlobalManager::Instance().Zip().IsUseZip()) {
+        return GlobalManager::Instance().Zip().GetZipData(fontFilePath, fileData);
+    }
+    else {
+        return FileUtil::ReadFileData(fontFilePath, fileData);
+    }
+}
+
 void FontManager::RemoveAllFontFiles()
 {
+    {
+        std::lock_guard<std::mutex> threadGuard(m_preloadMutex);
+        m_preloadFontFiles.clear();
+    }
     IFontMgr* pFontMgr = nullptr;
     IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
     if (pRenderFactory != nullptr) {
@@ -2,9 +2,11 @@
 #define UI_CORE_FONTMANAGER_H_
 
 #include "duilib/Core/UiFont.h"
+#include "duilib/Utils/FilePath.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 namespace ui 
 {
@@ -81,6 +83,11 @@ public:
     */
     void SetDefaultFontFamilyNames(const DString& defaultFontFamilyNames);
 
+    /** 获取字体的版本号：添加、删除字体或者修改默认字体时递增
+    *   调用方可以缓存GetIFont返回的字体接口，版本号变化后缓存失效（字体接口可能已经被释放）
+    */
+    uint32_t GetFontGeneration() const;
+
 public:
     /** @brief 添加一个字体文件, 添加后可以按照正常字体使用
       * @param[in] strFontFile 字体文件名, 相对路径，字体文件的保存路径是目录："<资源路径>\font\"
@@ -89,6 +96,12 @@ public:
       */
     bool AddFontFile(const DString& strFontFile, const DString& strFontDesc);
 
+    /** 预先读取字体文件的数据（可在工作线程中调用），之后调用AddFontFile时无需再读取文件
+      * @param[in] strFontFile 字体文件名, 同AddFontFile的参数
+      * @return 读取成功返回true，否则返回false
+      */
+    bool PreloadFontFile(const DString& strFontFile);
+
     /** @brief 清理所有添加的字体文件
       * @return 无返回值
       */
@@ -111,6 +124,10 @@ private:
     */
     DString GetDpiFontId(const DString& fontId, uint32_t nZoomPercent) const;
 
+    /** 读取字体文件的数据（从压缩包或者本地文件中读取）
+    */
+    static bool ReadFontFileData(const FilePath& fontFilePath, std::vector<uint8_t>& fileData);
+
 private:
     /** 自定义字体数据：Key时FontID，Value是字体描述信息
     */
@@ -131,6 +148,18 @@ private:
     /** 默认字体列表是否已经完成初始化
     */
     bool m_bDefaultFontInited;
+
+    /** 字体的版本号
+    */
+    uint32_t m_nFontGeneration;
+
+    /** 预先读取的字体文件数据：Key是字体文件名（受m_preloadMutex保护）
+    */
+    std::unordered_map<DString, std::vector<uint8_t>> m_preloadFontFiles;
+
+    /** 预先读取字体文件数据的多线程同步锁
+    */
+    std::mutex m_preloadMutex;
 };
 
 }
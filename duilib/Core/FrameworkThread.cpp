@@ -1,6 +1,8 @@
 #include "FrameworkThread.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/WindowMessage.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include <algorithm>
 
 #if defined (DUILIB_BUILD_FOR_SDL)
     #include "duilib/Core/MessageLoop_SDL.h"
@@ -17,14 +19,33 @@
     #define WM_USER_DEFINED_MSG     (kWM_USER + 568)
 #endif
 
+/** UI线程每次批量执行任务的默认时间片（毫秒）
+*/
+#define DEFAULT_TASK_TIME_SLICE_MS  8
+
+/** UI线程批量执行任务时，每执行多少个任务检测一次是否有等待处理的输入消息
+*/
+#define CHECK_INPUT_TASK_INTERVAL   32
+
 namespace ui 
 {
+/** UI线程等待执行的任务个数（性能计数器）
+*/
+static const PerformanceCounterId& GetPendingUiTaskCounter()
+{
+    static const PerformanceCounterId s_counterId(_T("FrameworkThread::PendingUiTasks"));
+    return s_counterId;
+}
+
 FrameworkThread::FrameworkThread(const DString& threadName, int32_t nThreadIdentifier):
-    m_bThreadUI(false),
-    m_bRunning(false),
+    m_nNextTaskId(1),
     m_threadName(threadName),
     m_nThreadIdentifier(nThreadIdentifier),
-    m_nNextTaskId(1)
+    m_bThreadUI(false),
+    m_bRunning(false),
+    m_bHasCancelledTasks(false),
+    m_bWakeupPosted(false),
+    m_nTaskTimeSliceMs(DEFAULT_TASK_TIME_SLICE_MS)
 {
 }
 
@@ -125,18 +146,9 @@ size_t FrameworkThread::PostTask(const StdClosure& task)
     if (task == nullptr) {
         return false;
     }
-    std::lock_guard<std::mutex> threadGuard(m_taskMutex);
+    //立即执行的任务：回调函数直接放在等待队列中，不放入任务映射表，执行时无需查找
     size_t nTaskId = m_nNextTaskId++;
-    TaskInfo& taskInfo = m_taskMap[nTaskId];
-    taskInfo.m_taskType = TaskType::kTask;
-    taskInfo.m_task = task;
-    taskInfo.m_nIntervalMs = 0;
-    taskInfo.m_nTimes = 1;
-    taskInfo.m_nTaskId = nTaskId;
-    taskInfo.m_startTime = std::chrono::steady_clock::now();
-    taskInfo.m_nTotalExecTimes = 0;
-
-    bool bAdded = NotifyExecTask(nTaskId);
+    bool bAdded = PushPenddingTask(nTaskId, task);
     ASSERT_UNUSED_VARIABLE(bAdded);
     return nTaskId;
 }
@@ -200,29 +212,78 @@ size_t FrameworkThread::PostRepeatedTask(const StdClosure& task, int32_t nInterv
 
 bool FrameworkThread::CancelTask(size_t nTaskId)
 {
-    bool bDeleted = false;
-    std::lock_guard<std::mutex> threadGuard(m_taskMutex);
-    auto iter = m_taskMap.find(nTaskId);
-    if (iter != m_taskMap.end()) {
-        m_taskMap.erase(nTaskId);
-        bDeleted = true;
+    {
+        //延迟执行或者重复执行的任务
+        std::lock_guard<std::mutex> threadGuard(m_taskMutex);
+        auto iter = m_taskMap.find(nTaskId);
+        if (iter != m_taskMap.end()) {
+            m_taskMap.erase(iter);
+            return true;
+        }
+    }
+
+    //立即执行的任务：在等待队列中，或者在正在执行的一批任务中
+    std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+    for (auto iter = m_penddingTasks.begin(); iter != m_penddingTasks.end(); ++iter) {
+        if ((iter->m_nTaskId == nTaskId) && (iter->m_task != nullptr)) {
+            m_penddingTasks.erase(iter);
+            if (IsUIThread()) {
+                GetPendingUiTaskCounter().Decrement();
+            }
+            return true;
+        }
+    }
+    for (const ExecBatch* pBatch : m_execBatches) {
+        for (size_t nIndex = pBatch->m_nNextIndex; nIndex < pBatch->m_tasks.size(); ++nIndex) {
+            const PenddingTask& penddingTask = pBatch->m_tasks[nIndex];
+            if ((penddingTask.m_nTaskId == nTaskId) && (penddingTask.m_task != nullptr)) {
+                //已经取出，尚未执行：执行前检查
+                m_cancelledTaskIds.insert(nTaskId);
+                m_bHasCancelledTasks = true;
+                return true;
+            }
+        }
     }
-    return bDeleted;
+    return false;
 }
 
 bool FrameworkThread::NotifyExecTask(size_t nTaskId)
 {
-    if (IsUIThread()) {
-        //UI线程: 异步执行
-        return m_threadMsg.PostMsg(WM_USER_DEFINED_MSG, nTaskId, 0);
-    }
-    else {
-        //后台工作线程
+    return PushPenddingTask(nTaskId, nullptr);
+}
+
+bool FrameworkThread::PushPenddingTask(size_t nTaskId, const StdClosure& task)
+{
+    bool bPostWakeup = false;
+    {
         std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
-        m_penddingTaskIds.push_back(nTaskId);
-        m_cv.notify_one();
-        return true;
-    }    
+        PenddingTask penddingTask;
+        penddingTask.m_nTaskId = nTaskId;
+        penddingTask.m_task = task;
+        penddingTask.m_postTime = std::chrono::steady_clock::now();
+        m_penddingTasks.push_back(std::move(penddingTask));
+        if (IsUIThread()) {
+            GetPendingUiTaskCounter().Increment();
+            //UI线程: 每批任务只投递一个唤醒消息，避免大量消息堵塞消息队列，影响鼠标键盘和绘制消息的处理
+            if (!m_bWakeupPosted) {
+                m_bWakeupPosted = true;
+                bPostWakeup = true;
+            }
+        }
+        else {
+            //后台工作线程
+            m_cv.notify_one();
+        }
+    }
+    if (bPostWakeup) {
+        bool bRet = m_threadMsg.PostMsg(WM_USER_DEFINED_MSG, 0, 0);
+        if (!bRet) {
+            std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+            m_bWakeupPosted = false;
+        }
+        return bRet;
+    }
+    return true;
 }
 
 void FrameworkThread::ExecTask(size_t nTaskId)
@@ -263,33 +324,211 @@ void FrameworkThread::ExecTask(size_t nTaskId)
     }
 }
 
-void FrameworkThread::OnTaskMessage(uint32_t msgId, WPARAM wParam, LPARAM /*lParam*/)
+void FrameworkThread::ExecBatchTask(ExecBatch& batch, size_t nIndex)
+{
+    batch.m_nNextIndex = nIndex + 1;
+    const PenddingTask& penddingTask = batch.m_tasks[nIndex];
+    if (IsUIThread()) {
+        GetPendingUiTaskCounter().Decrement();
+    }
+    if (m_bHasCancelledTasks) {
+        std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+        if (m_cancelledTaskIds.erase(penddingTask.m_nTaskId) > 0) {
+            m_bHasCancelledTasks = !m_cancelledTaskIds.empty();
+            return;
+        }
+    }
+    if (penddingTask.m_task != nullptr) {
+        penddingTask.m_task();
+    }
+    else {
+        ExecTask(penddingTask.m_nTaskId);
+    }
+}
+
+bool FrameworkThread::BeginExecBatch(ExecBatch& batch)
+{
+    std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+    batch.m_tasks.clear();
+    batch.m_nNextIndex = 0;
+    //取出本批任务后，后续放入的任务需要重新投递唤醒消息（UI线程）：
+    //本批任务中可能运行嵌套的消息循环（比如模态对话框），嵌套循环中放入的任务需要由新的唤醒消息触发执行
+    m_bWakeupPosted = false;
+    if (m_penddingTasks.empty()) {
+        return false;
+    }
+    batch.m_tasks.swap(m_penddingTasks);
+    if (std::find(m_execBatches.begin(), m_execBatches.end(), &batch) == m_execBatches.end()) {
+        m_execBatches.push_back(&batch);
+    }
+    return true;
+}
+
+void FrameworkThread::EndExecBatch(ExecBatch& batch, size_t nExecCount)
+{
+    std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+    if (nExecCount < batch.m_tasks.size()) {
+        //未执行的任务放回队列头部，保持执行顺序
+        m_penddingTasks.insert(m_penddingTasks.begin(),
+                               std::make_move_iterator(batch.m_tasks.begin() + nExecCount),
+                               std::make_move_iterator(batch.m_tasks.end()));
+    }
+    batch.m_tasks.clear();
+    batch.m_nNextIndex = 0;
+    auto iter = std::find(m_execBatches.begin(), m_execBatches.end(), &batch);
+    if (iter != m_execBatches.end()) {
+        m_execBatches.erase(iter);
+    }
+}
+
+void FrameworkThread::ExecPendingTasks()
+{
+    ASSERT(std::this_thread::get_id() == m_nThisThreadId);
+    const auto startTime = std::chrono::steady_clock::now();
+    const int32_t nTimeSliceMs = m_nTaskTimeSliceMs;
+    size_t nExecCount = 0;
+
+    //本批任务放在栈上：任务中可能运行嵌套的消息循环（比如模态对话框），再次进入本函数
+    ExecBatch batch;
+    while (IsRunning()) {
+        if (!BeginExecBatch(batch)) {
+            EndExecBatch(batch, 0);
+            return;
+        }
+
+        bool bYield = false;
+        size_t nIndex = 0;
+        while (nIndex < batch.m_tasks.size()) {
+            ExecBatchTask(batch, nIndex);
+            ++nIndex;
+            ++nExecCount;
+
+            //超过时间片或者有等待处理的输入消息时，让出，剩余任务在下一批执行
+            if (nTimeSliceMs > 0) {
+                auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+                if (elapsedMs.count() >= nTimeSliceMs) {
+                    bYield = true;
+                }
+            }
+            if (!bYield && ((nExecCount % CHECK_INPUT_TASK_INTERVAL) == 0)) {
+                bYield = m_threadMsg.HasPendingInputMsg();
+            }
+            if (bYield) {
+                break;
+            }
+        }
+
+        if (bYield) {
+            EndExecBatch(batch, nIndex);
+            {
+                std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+                if (m_penddingTasks.empty()) {
+                    m_bWakeupPosted = false;
+                    return;
+                }
+                m_bWakeupPosted = true;
+            }
+            //有等待处理的输入或者绘制消息时，唤醒消息需要排在它们之后处理
+            //（Windows平台投递的消息优先于输入消息和WM_PAINT消息，所以不能直接投递）
+            bool bRet = false;
+            if (m_threadMsg.HasPendingInputMsg()) {
+                bRet = m_threadMsg.PostMsgAfterInput(WM_USER_DEFINED_MSG, 0, 0);
+            }
+            else {
+                bRet = m_threadMsg.PostMsg(WM_USER_DEFINED_MSG, 0, 0);
+            }
+            if (!bRet) {
+                std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+                m_bWakeupPosted = false;
+            }
+            return;
+        }
+        EndExecBatch(batch, batch.m_tasks.size());
+    }
+    EndExecBatch(batch, batch.m_tasks.size());
+}
+
+void FrameworkThread::OnTaskMessage(uint32_t msgId, WPARAM /*wParam*/, LPARAM /*lParam*/)
 {
     ASSERT(msgId == WM_USER_DEFINED_MSG);
     if (msgId == WM_USER_DEFINED_MSG) {
-        ExecTask((size_t)wParam);
+        ExecPendingTasks();
+    }
+}
+
+void FrameworkThread::SetTaskTimeSlice(int32_t nTimeSliceMs)
+{
+    m_nTaskTimeSliceMs = nTimeSliceMs;
+}
+
+int32_t FrameworkThread::GetTaskTimeSlice() const
+{
+    return m_nTaskTimeSliceMs;
+}
+
+size_t FrameworkThread::GetPendingTaskCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+    size_t nCount = m_penddingTasks.size();
+    for (const ExecBatch* pBatch : m_execBatches) {
+        //正在执行的批次中，尚未执行的任务
+        const size_t nNextIndex = pBatch->m_nNextIndex;
+        if (nNextIndex < pBatch->m_tasks.size()) {
+            nCount += pBatch->m_tasks.size() - nNextIndex;
+        }
+    }
+    return nCount;
+}
+
+int64_t FrameworkThread::GetOldestPendingTaskAge() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_penddingTaskMutex);
+    //与GetPendingTaskCount统计的任务范围一致：等待队列及正在执行的批次中尚未执行的任务
+    bool bHasTask = false;
+    std::chrono::steady_clock::time_point oldestTime;
+    if (!m_penddingTasks.empty()) {
+        oldestTime = m_penddingTasks.front().m_postTime;
+        bHasTask = true;
     }
+    for (const ExecBatch* pBatch : m_execBatches) {
+        const size_t nNextIndex = pBatch->m_nNextIndex;
+        if (nNextIndex < pBatch->m_tasks.size()) {
+            const auto& postTime = pBatch->m_tasks[nNextIndex].m_postTime;
+            if (!bHasTask || (postTime < oldestTime)) {
+                oldestTime = postTime;
+                bHasTask = true;
+            }
+        }
+    }
+    if (!bHasTask) {
+        return 0;
+    }
+    auto ageMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - oldestTime);
+    return ageMs.count();
 }
 
 void FrameworkThread::WorkerThreadProc()
 {
     ASSERT(std::this_thread::get_id() == m_nThisThreadId);
+    ExecBatch batch;
     while (m_bRunning) {
-        std::unique_lock lk(m_penddingTaskMutex);
-        m_cv.wait(lk);
-        std::vector<size_t> penddingTaskIds;
-        if (!m_penddingTaskIds.empty()) {
-            penddingTaskIds.swap(m_penddingTaskIds);
+        {
+            std::unique_lock lk(m_penddingTaskMutex);
+            m_cv.wait(lk);
         }
-        lk.unlock();
-
-        for (size_t nTaskId : penddingTaskIds) {
+        if (!BeginExecBatch(batch)) {
+            continue;
+        }
+        size_t nIndex = 0;
+        for (; nIndex < batch.m_tasks.size(); ++nIndex) {
             if (!m_bRunning) {
                 break;
             }
-            ExecTask(nTaskId);
+            ExecBatchTask(batch, nIndex);
         }
+        EndExecBatch(batch, nIndex);
     }
+    EndExecBatch(batch, batch.m_tasks.size());
     m_bRunning = false;
 }
 
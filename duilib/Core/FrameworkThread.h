@@ -7,7 +7,11 @@
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
-#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <vector>
+#include <atomic>
 
 namespace ui 
 {
@@ -84,9 +88,28 @@ public:
 
     /** 取消一个任务
     * @param [in] nTaskId 任务ID，即上面的PostXXX函数的返回值
+    * @return 如果任务尚未开始执行，取消成功返回true；如果任务已经执行或者正在执行，返回false
     */
     bool CancelTask(size_t nTaskId);
 
+public:
+    /** 设置UI线程每次批量执行任务的时间片（单位：毫秒），超过时间片后让出，优先处理输入和绘制消息
+    * @param [in] nTimeSliceMs 时间片，小于等于0表示不限制
+    */
+    void SetTaskTimeSlice(int32_t nTimeSliceMs);
+
+    /** 获取UI线程每次批量执行任务的时间片（单位：毫秒）
+    */
+    int32_t GetTaskTimeSlice() const;
+
+    /** 获取等待执行的任务个数（队列深度）
+    */
+    size_t GetPendingTaskCount() const;
+
+    /** 获取等待时间最长的任务已经等待的时间（单位：毫秒），队列为空时返回0
+    */
+    int64_t GetOldestPendingTaskAge() const;
+
 protected:
     /** 运行前初始化，在进入消息循环前调用
     */
@@ -105,14 +128,43 @@ private:
     */
     void WorkerThreadProc();
 
-    /** 通知执行一个任务
+    /** 通知执行一个任务（延迟执行或者重复执行的任务，由定时器触发）
     */
     bool NotifyExecTask(size_t nTaskId);
 
-    /** 执行任务
+    /** 将任务放入等待队列，并唤醒线程
+    * @param [in] nTaskId 任务ID
+    * @param [in] task 立即执行的任务的回调函数；延迟执行或者重复执行的任务为空，执行时从任务映射表中获取
+    */
+    bool PushPenddingTask(size_t nTaskId, const StdClosure& task);
+
+    /** 执行任务映射表中的任务（延迟执行或者重复执行的任务）
     */
     void ExecTask(size_t nTaskId);
 
+    /** 一批任务（从等待队列中整批取出）
+    */
+    struct ExecBatch;
+
+    /** 从等待队列中取出一批任务，登记为正在执行的批次
+    * @return 等待队列为空时返回false
+    */
+    bool BeginExecBatch(ExecBatch& batch);
+
+    /** 一批任务执行结束（或者让出），未执行的任务放回等待队列头部，并取消登记
+    * @param [in] nExecCount 已经执行的任务个数
+    */
+    void EndExecBatch(ExecBatch& batch, size_t nExecCount);
+
+    /** 执行一批任务中的一个任务
+    * @param [in] nIndex 任务在批次中的下标
+    */
+    void ExecBatchTask(ExecBatch& batch, size_t nIndex);
+
+    /** UI线程：批量执行等待队列中的任务（在时间片内执行，超时后让出）
+    */
+    void ExecPendingTasks();
+
     /** 消息函数
     */
     void OnTaskMessage(uint32_t msgId, WPARAM wParam, LPARAM lParam);
@@ -142,9 +194,9 @@ private:
         int32_t m_nTotalExecTimes = 0;          //任务总计执行的次数
     };
 
-    /** 任务信息映射表
+    /** 任务信息映射表（延迟执行或者重复执行的任务，立即执行的任务直接放在等待队列中）
     */
-    typedef std::map<size_t, TaskInfo> TaskMap;
+    typedef std::unordered_map<size_t, TaskInfo> TaskMap;
     TaskMap m_taskMap;
 
     /** 任务数据多线程同步锁
@@ -153,7 +205,7 @@ private:
 
     /** 下一个任务ID
     */
-    size_t m_nNextTaskId;
+    std::atomic<size_t> m_nNextTaskId;
 
 private:
     /** 线程名称
@@ -185,13 +237,50 @@ private:
     */
     std::condition_variable m_cv;
 
-    /** 等待执行的任务ID
+    /** 等待执行的任务
+    */
+    struct PenddingTask
+    {
+        size_t m_nTaskId = 0;                                  //任务ID
+        StdClosure m_task;                                     //立即执行的任务的回调函数（其他类型的任务为空）
+        std::chrono::steady_clock::time_point m_postTime;      //任务放入等待队列的时间
+    };
+
+    /** 等待执行的任务队列（多个线程可同时放入，由本线程取出执行）
+    */
+    std::deque<PenddingTask> m_penddingTasks;
+
+    /** 一批任务（放在执行函数的栈上，只有本线程修改，修改时需持有m_penddingTaskMutex）
+    */
+    struct ExecBatch
+    {
+        std::deque<PenddingTask> m_tasks;       //本批任务
+        std::atomic<size_t> m_nNextIndex{ 0 };  //下一个要执行的任务的下标
+    };
+
+    /** 正在执行的批次（任务中运行嵌套的消息循环时，可能有多个），受m_penddingTaskMutex保护
+    */
+    std::vector<ExecBatch*> m_execBatches;
+
+    /** 已经取出但尚未执行时被取消的任务ID（受m_penddingTaskMutex保护）
+    */
+    std::unordered_set<size_t> m_cancelledTaskIds;
+
+    /** m_cancelledTaskIds是否不为空（执行任务时，只在不为空时才需要加锁检查）
+    */
+    std::atomic<bool> m_bHasCancelledTasks;
+
+    /** 等待任务容器锁
+    */
+    mutable std::mutex m_penddingTaskMutex;
+
+    /** UI线程：是否已经投递了唤醒消息（每批任务只投递一个消息）
     */
-    std::vector<size_t> m_penddingTaskIds;
+    std::atomic<bool> m_bWakeupPosted;
 
-    /** 等待任务ID容器锁
+    /** UI线程：每次批量执行任务的时间片（单位：毫秒）
     */
-    std::mutex m_penddingTaskMutex;
+    std::atomic<int32_t> m_nTaskTimeSliceMs;
 
     /** 与主线程通信的机制
     */
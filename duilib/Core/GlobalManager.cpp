@@ -1,9 +1,12 @@
 #include "GlobalManager.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/ParallelTaskRunner.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/FileUtil.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Core/Control.h"
 #include "duilib/Core/Box.h"
+#include "duilib/Core/CompiledLayout.h"
 
 //渲染引擎
 #include "duilib/RenderSkia/RenderFactory_Skia.h"
@@ -84,7 +87,9 @@ bool GlobalManager::Startup(const ResourceParam& resParam,
 
 void GlobalManager::Shutdown()
 {
+    m_windowPool.Clear();
     m_threadManager.Clear();
+    ParallelTaskRunner::Instance().Shutdown();
     m_timerManager.Clear();
     m_colorManager.Clear();    
     m_fontManager.RemoveAllFonts();
@@ -103,6 +108,8 @@ void GlobalManager::Shutdown()
     m_languagePath.Clear();
     m_fontFilePath.Clear();
     m_builderMap.clear();
+    m_startupTrace.clear();
+    CompiledLayout::ClearCache();
     m_platformData = nullptr;
 
     //执行退出时清理资源的函数
@@ -172,22 +179,10 @@ bool GlobalManager::ReloadResource(const ResourceParam& resParam, bool bInvalida
     }
     else if (resParam.GetResType() == ResourceType::kZipFile) {
         //资源文件打包为zip压缩包，然后以本地文件的形式存在
-        const ZipFileResParam& param = static_cast<const ZipFileResParam&>(resParam);
-        bool bZipOpenOk = Zip().OpenZipFile(param.zipFilePath, param.zipPassword);
-        if (!bZipOpenOk) {
-            ASSERT(!"OpenZipFile failed!");
-            return false;
-        }
     }
 #ifdef DUILIB_BUILD_FOR_WIN
     else if (resParam.GetResType() == ResourceType::kResZipFile) {
         //资源文件打包为zip压缩包，然后放在exe/dll的资源文件中
-        const ResZipFileResParam& param = static_cast<const ResZipFileResParam&>(resParam);
-        bool bZipOpenOk = Zip().OpenResZip(param.hResModule, param.resourceName, param.resourceType, param.zipPassword);
-        if (!bZipOpenOk) {
-            ASSERT(!"OpenResZip failed!");
-            return false;
-        }
     }
 #endif
     else {
@@ -195,36 +190,144 @@ bool GlobalManager::ReloadResource(const ResourceParam& resParam, bool bInvalida
         return false;
     }
 
-    //清空原有资源数据（字体、颜色、Class定义、图片资源等）
-    m_fontManager.RemoveAllFonts();
-    m_fontManager.RemoveAllFontFiles();
-    m_colorManager.RemoveAllColors();
-    RemoveAllImages();
-    RemoveAllClasss();
-
-    //保存资源路径
-    SetResourcePath(FilePathUtil::JoinFilePath(strResourcePath, resParam.themePath));
-
-    //保存字体文件所在路径
-    SetFontFilePath(FilePathUtil::JoinFilePath(strResourcePath, resParam.fontFilePath));
-
-    //解析全局资源信息(默认是"global.xml"文件)
+    //加载资源的各个阶段，按依赖关系并行执行（各阶段的耗时记录见GetStartupTrace）：
+    //  OpenZip -> PrepareResource -> ParseGlobalXml -> LoadFontFiles -> ApplyGlobalXml
+    //          -> LoadLanguage -> ApplyLanguage（同时依赖PrepareResource）
+    //  PrepareResource -> PrefetchLayout（每个预加载的布局文件一个阶段）
+    //  PrepareResource -> PrepareImages -> DecodeImages -> AddImages
+    const DString stageOpenZip = _T("OpenZip");
+    const DString stagePrepareResource = _T("PrepareResource");
+    const DString stageParseGlobalXml = _T("ParseGlobalXml");
+    const DString stageLoadFontFiles = _T("LoadFontFiles");
+    const DString stageApplyGlobalXml = _T("ApplyGlobalXml");
+    const DString stageLoadLanguage = _T("LoadLanguage");
+    const DString stageApplyLanguage = _T("ApplyLanguage");
+    const DString stagePrepareImages = _T("PrepareImages");
+    const DString stageDecodeImages = _T("DecodeImages");
+    const DString stageAddImages = _T("AddImages");
+    StartupPipeline pipeline;
+
+    //打开资源压缩包，建立文件索引（工作线程）
+    pipeline.AddStage(stageOpenZip, {}, false, [this, &resParam]() {
+            if (resParam.GetResType() == ResourceType::kZipFile) {
+                const ZipFileResParam& param = static_cast<const ZipFileResParam&>(resParam);
+                bool bZipOpenOk = m_zipManager.OpenZipFile(param.zipFilePath, param.zipPassword);
+                if (!bZipOpenOk) {
+                    ASSERT(!"OpenZipFile failed!");
+                    return false;
+                }
+            }
+#ifdef DUILIB_BUILD_FOR_WIN
+            else if (resParam.GetResType() == ResourceType::kResZipFile) {
+                const ResZipFileResParam& param = static_cast<const ResZipFileResParam&>(resParam);
+                bool bZipOpenOk = m_zipManager.OpenResZip(param.hResModule, param.resourceName, param.resourceType, param.zipPassword);
+                if (!bZipOpenOk) {
+                    ASSERT(!"OpenResZip failed!");
+                    return false;
+                }
+            }
+#endif
+            return true;
+        });
+
+    //清空原有资源数据（字体、颜色、Class定义、图片资源、布局缓存等），保存资源路径（UI线程）
+    pipeline.AddStage(stagePrepareResource, { stageOpenZip }, true, [this, &resParam, &strResourcePath]() {
+            CompiledLayout::ClearCache();
+            m_fontManager.RemoveAllFonts();
+            m_fontManager.RemoveAllFontFiles();
+            m_colorManager.RemoveAllColors();
+            RemoveAllImages();
+            RemoveAllClasss();
+
+            //保存资源路径
+            SetResourcePath(FilePathUtil::JoinFilePath(strResourcePath, resParam.themePath));
+
+            //保存字体文件所在路径
+            SetFontFilePath(FilePathUtil::JoinFilePath(strResourcePath, resParam.fontFilePath));
+            return true;
+        });
+
+    //解析全局资源信息(默认是"global.xml"文件)，并预先读取其中定义的字体文件（工作线程），然后应用到全局资源（UI线程）
+    WindowBuilder globalBuilder;
     ASSERT(!resParam.globalXmlFileName.empty());
     if (!resParam.globalXmlFileName.empty()) {
-        WindowBuilder dialog_builder;
-        Window paint_manager;
-        if (dialog_builder.ParseXmlFile(FilePath(resParam.globalXmlFileName))) {
-            dialog_builder.CreateControls(CreateControlCallback(), &paint_manager);
-        }        
+        pipeline.AddStage(stageParseGlobalXml, { stagePrepareResource }, false, [&globalBuilder, &resParam]() {
+                return globalBuilder.ParseXmlFile(FilePath(resParam.globalXmlFileName));
+            });
+        pipeline.AddStage(stageLoadFontFiles, { stageParseGlobalXml }, false, [this, &globalBuilder]() {
+                std::vector<DString> fontFiles;
+                globalBuilder.GetGlobalFontFiles(fontFiles);
+                for (const DString& fontFile : fontFiles) {
+                    //读取失败时，AddFontFile会再次读取
+                    m_fontManager.PreloadFontFile(fontFile);
+                }
+                return true;
+            });
+        pipeline.AddStage(stageApplyGlobalXml, { stageLoadFontFiles }, true, [&globalBuilder]() {
+                Window paint_manager;
+                globalBuilder.CreateControls(CreateControlCallback(), &paint_manager);
+                return true;
+            });
+    }
+
+    //加载多语言文件(可选)：读取并编译语言文件或者映射预编译文件（工作线程），然后替换语言映射表（UI线程）
+    FilePath languagePath;
+    if (!resParam.languagePath.IsEmpty()) {
+        languagePath = FilePathUtil::JoinFilePath(strResourcePath, resParam.languagePath);
+        languagePath.NormalizeDirectoryPath();
+    }
+    std::unique_ptr<CompiledStringTable> spStringTable;
+    if (!languagePath.IsEmpty() && !resParam.languageFileName.empty()) {
+        pipeline.AddStage(stageLoadLanguage, { stageOpenZip }, false, [this, &resParam, &languagePath, &spStringTable]() {
+                spStringTable = LoadLanguageTable(languagePath, resParam.languageFileName);
+                ASSERT((spStringTable != nullptr) && "ReloadLanguage");
+                return spStringTable != nullptr;
+            });
+        pipeline.AddStage(stageApplyLanguage, { stageLoadLanguage, stagePrepareResource }, true, [this, &resParam, &spStringTable]() {
+                m_langManager.SetStringTable(std::move(spStringTable));
+                m_languageFileName = resParam.languageFileName;
+                return true;
+            });
+    }
+
+    //预加载布局文件（工作线程，每个文件一个阶段，并行解析，解析结果保存在布局缓存中）
+    for (const FilePath& xmlFilePath : resParam.prefetchXmlFiles) {
+        pipeline.AddStage(_T("PrefetchLayout:") + xmlFilePath.ToString(), { stagePrepareResource }, false, [&xmlFilePath]() {
+                WindowBuilder builder;
+                return builder.ParseXmlFile(xmlFilePath);
+            });
+    }
+
+    //预加载图片：查找图片文件（UI线程），读取文件并解码（工作线程），添加到图片缓存（UI线程）
+    std::shared_ptr<ImageManager::PrefetchImageTask> spPrefetchImageTask;
+    if (!resParam.prefetchImageFiles.empty()) {
+        pipeline.AddStage(stagePrepareImages, { stagePrepareResource }, true, [this, &resParam, &spPrefetchImageTask]() {
+                spPrefetchImageTask = m_imageManager.PreparePrefetchImages(resParam.prefetchImageFiles);
+                return spPrefetchImageTask != nullptr;
+            });
+        pipeline.AddStage(stageDecodeImages, { stagePrepareImages }, false, [&spPrefetchImageTask]() {
+                ImageManager::DecodePrefetchImages(*spPrefetchImageTask);
+                return true;
+            });
+        pipeline.AddStage(stageAddImages, { stageDecodeImages }, true, [this, &spPrefetchImageTask]() {
+                m_imageManager.AddPrefetchImages(*spPrefetchImageTask);
+                return true;
+            });
     }
 
-    //加载多语言文件(可选)
-    if (!resParam.languagePath.IsEmpty() && !resParam.languageFileName.empty()) {
-        FilePath languagePath = FilePathUtil::JoinFilePath(strResourcePath, resParam.languagePath);
-        ReloadLanguage(languagePath, resParam.languageFileName, false);
+    pipeline.Run();
+    m_startupTrace = pipeline.GetTrace();
+    if (!pipeline.IsStageSucceeded(stagePrepareResource)) {
+        //打开资源压缩包失败
+        return false;
     }
-    else if (!resParam.languagePath.IsEmpty()) {
-        SetLanguagePath(FilePathUtil::JoinFilePath(strResourcePath, resParam.languagePath));
+
+    //保存语言文件路径
+    if (!languagePath.IsEmpty() &&
+        (resParam.languageFileName.empty() || pipeline.IsStageSucceeded(stageApplyLanguage))) {
+        if (languagePath != GetLanguagePath()) {
+            SetLanguagePath(languagePath);
+        }
     }
 
     //更新窗口中的所有子控件状态
@@ -236,6 +339,8 @@ bool GlobalManager::ReloadResource(const ResourceParam& resParam, bool bInvalida
                 pBox = windowFlag.m_pWindow->GetRoot();
             }
             if ((pBox != nullptr) && !windowFlag.m_weakFlag.expired()) {
+                //更新使用了多语言文本ID的控件
+                pBox->ChangeLanguage();
                 pBox->Invalidate();
             }
         }
@@ -260,21 +365,12 @@ bool GlobalManager::ReloadLanguage(const FilePath& languagePath,
     }
 
     //加载多语言文件，如果使用了资源压缩包则从内存中加载语言文件
+    //切换语言只替换语言映射表，原来的映射表（及其内存映射）随之释放
     bool bReadOk = false;
-    if ( (newLanguagePath.IsEmpty() || !newLanguagePath.IsAbsolutePath()) &&
-         m_zipManager.IsUseZip() ) {
-        std::vector<unsigned char> fileData;
-        FilePath filePath = FilePathUtil::JoinFilePath(newLanguagePath, FilePath(languageFileName));
-        if (m_zipManager.GetZipData(filePath, fileData)) {
-            bReadOk = m_langManager.LoadStringTable(fileData);
-        }
-        else {
-            ASSERT(!"GetZipData failed!");
-        }
-    }
-    else {
-        FilePath filePath = FilePathUtil::JoinFilePath(newLanguagePath, FilePath(languageFileName));
-        bReadOk = m_langManager.LoadStringTable(filePath);
+    std::unique_ptr<CompiledStringTable> spStringTable = LoadLanguageTable(newLanguagePath, languageFileName);
+    if (spStringTable != nullptr) {
+        m_langManager.SetStringTable(std::move(spStringTable));
+        bReadOk = true;
     }
 
     if (bReadOk) {
@@ -301,6 +397,8 @@ bool GlobalManager::ReloadLanguage(const FilePath& languagePath,
                 }
             }
             if ((pBox != nullptr) && !windowFlag.m_weakFlag.expired()) {
+                //更新使用了多语言文本ID的控件
+                pBox->ChangeLanguage();
                 pBox->Invalidate();
             }
         }
@@ -308,6 +406,64 @@ bool GlobalManager::ReloadLanguage(const FilePath& languagePath,
     return bReadOk;
 }
 
+std::unique_ptr<CompiledStringTable> GlobalManager::LoadLanguageTable(const FilePath& languagePath,
+                                                                     const DString& languageFileName) const
+{
+    FilePath filePath = FilePathUtil::JoinFilePath(languagePath, FilePath(languageFileName));
+    if ((languagePath.IsEmpty() || !languagePath.IsAbsolutePath()) && m_zipManager.IsUseZip()) {
+        //压缩包中的语言文件（可以只有预编译文件）：未压缩存储的文件直接使用压缩包映射到内存的数据，否则读取到内存中
+        if (!m_zipManager.IsZipResExist(filePath)) {
+            filePath = LangManager::GetCompiledFilePath(filePath);
+        }
+        const uint8_t* pData = nullptr;
+        size_t nDataSize = 0;
+        if (m_zipManager.GetZipStoredData(filePath, pData, nDataSize)) {
+            return LangManager::CreateStringTable(pData, nDataSize);
+        }
+        std::vector<uint8_t> fileData;
+        if (!m_zipManager.GetZipData(filePath, fileData)) {
+            ASSERT(!"GetZipData failed!");
+            return nullptr;
+        }
+        return LangManager::CreateStringTable(fileData);
+    }
+    else {
+        //本地语言文件：优先映射预编译文件
+        return LangManager::CreateStringTable(filePath);
+    }
+}
+
+const std::vector<StartupStageTrace>& GlobalManager::GetStartupTrace() const
+{
+    return m_startupTrace;
+}
+
+/** 语言文件列表中的预编译文件（语言文件名 + "c"，含有预编译文件的文件头标识），替换为对应的语言文件名，并去掉重复项
+*   只发布预编译文件时，列表中仍然是语言文件名，加载时会使用对应的预编译文件
+*/
+static void MapCompiledLanguageFiles(std::vector<std::pair<DString, DString>>& languageList,
+                                     const std::function<bool(const DString& fileName)>& isCompiledFile)
+{
+    std::vector<std::pair<DString, DString>> sourceLanguageList;
+    for (const auto& lang : languageList) {
+        DString fileName = lang.first;
+        if ((fileName.size() > 1) && (fileName.back() == _T('c')) && isCompiledFile(fileName)) {
+            fileName.pop_back();
+        }
+        bool bExists = false;
+        for (const auto& sourceLang : sourceLanguageList) {
+            if (sourceLang.first == fileName) {
+                bExists = true;
+                break;
+            }
+        }
+        if (!bExists) {
+            sourceLanguageList.push_back({ fileName, lang.second });
+        }
+    }
+    languageList.swap(sourceLanguageList);
+}
+
 bool GlobalManager::GetLanguageList(std::vector<std::pair<DString, DString>>& languageList,
                                     const DString& languageNameID) const
 {
@@ -332,6 +488,13 @@ bool GlobalManager::GetLanguageList(std::vector<std::pair<DString, DString>>& la
                 languageList.push_back({ FilePath(dir_entry.path().filename()).ToString(), _T("")});
             }
         }
+        //预编译文件映射为对应的语言文件名（只读取文件头）
+        MapCompiledLanguageFiles(languageList, [&languagePath](const DString& fileName) {
+                std::vector<uint8_t> fileData;
+                FilePath filePath = FilePathUtil::JoinFilePath(languagePath, FilePath(fileName));
+                return FileUtil::ReadFileHeader(filePath, 64, fileData) &&
+                       CompiledStringTable::IsCompiledData(fileData.data(), fileData.size());
+            });
         if (!languageNameID.empty()) {
             for (auto& lang : languageList) {
                 const DString& fileName = lang.first;
@@ -352,19 +515,23 @@ bool GlobalManager::GetLanguageList(std::vector<std::pair<DString, DString>>& la
         for (auto const& file : fileList) {
             languageList.push_back({ file, _T("") });
         }
+        MapCompiledLanguageFiles(languageList, [this, &languagePath](const DString& fileName) {
+                std::vector<uint8_t> fileData;
+                FilePath filePath = FilePathUtil::JoinFilePath(languagePath, FilePath(fileName));
+                return m_zipManager.GetZipData(filePath, fileData) &&
+                       CompiledStringTable::IsCompiledData(fileData.data(), fileData.size());
+            });
 
         if (!languageNameID.empty()) {
             for (auto& lang : languageList) {
                 const DString& fileName = lang.first;
                 DString& displayName = lang.second;
 
-                FilePath filePath = FilePathUtil::JoinFilePath(languagePath, FilePath(fileName));
-                std::vector<unsigned char> fileData;
-                if (m_zipManager.GetZipData(filePath, fileData)) {
+                std::unique_ptr<CompiledStringTable> spStringTable = LoadLanguageTable(languagePath, fileName);
+                if (spStringTable != nullptr) {
                     ui::LangManager langManager;
-                    if (langManager.LoadStringTable(fileData)) {
-                        displayName = langManager.GetStringViaID(languageNameID);
-                    }
+                    langManager.SetStringTable(std::move(spStringTable));
+                    displayName = langManager.GetStringViaID(languageNameID);
                 }
             }
         }
@@ -480,18 +647,34 @@ void GlobalManager::AddClass(const DString& strClassName, const DString& strCont
     AssertUIThread();
     ASSERT(!strClassName.empty() && !strControlAttrList.empty());
     if (!strClassName.empty() && !strControlAttrList.empty()) {
-        m_globalClass[strClassName] = strControlAttrList;
+        UiClassAttributes& classAttributes = m_globalClass[AtomTable::AddAtom(strClassName)];
+        classAttributes.m_attrList = strControlAttrList;
+        classAttributes.m_attrs.clear();
+        AttributeUtil::ParseAttributeList(strControlAttrList, classAttributes.m_attrs);
     }    
 }
 
 DString GlobalManager::GetClassAttributes(const DString& strClassName) const
+{
+    const UiClassAttributes* pClassAttributes = FindClassAttributes(strClassName);
+    if (pClassAttributes != nullptr) {
+        return pClassAttributes->m_attrList;
+    }
+    return DString();
+}
+
+const UiClassAttributes* GlobalManager::FindClassAttributes(const DString& strClassName) const
 {
     AssertUIThread();
-    auto it = m_globalClass.find(strClassName);
+    const UiAtom classAtom = AtomTable::FindAtom(strClassName);
+    if (classAtom.IsEmpty()) {
+        return nullptr;
+    }
+    auto it = m_globalClass.find(classAtom);
     if (it != m_globalClass.end()) {
-        return it->second;
+        return &it->second;
     }
-    return DString();
+    return nullptr;
 }
 
 void GlobalManager::RemoveAllClasss()
@@ -552,6 +735,11 @@ CursorManager& GlobalManager::Cursor()
     return m_cursorManager;
 }
 
+WindowPool& GlobalManager::Pool()
+{
+    return m_windowPool;
+}
+
 Box* GlobalManager::CreateBox(const FilePath& strXmlPath, CreateControlCallback callback)
 {
     WindowBuilder builder;
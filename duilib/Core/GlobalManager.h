@@ -12,6 +12,9 @@
 #include "duilib/Core/ThreadManager.h"
 #include "duilib/Core/ResourceParam.h"
 #include "duilib/Core/CursorManager.h"
+#include "duilib/Core/WindowPool.h"
+#include "duilib/Core/StartupPipeline.h"
+#include "duilib/Utils/AttributeUtil.h"
 
 #ifdef DUILIB_BUILD_FOR_WIN
     #include "duilib/Core/IconManager_Windows.h"
@@ -20,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <thread>
 
 namespace ui 
@@ -87,6 +91,11 @@ public:
     */
     bool ReloadResource(const ResourceParam& resParam, bool bInvalidate = false);
 
+    /** 获取最近一次加载资源（Startup或者ReloadResource）各个阶段的耗时记录
+    *   加载资源时，各个阶段（打开压缩包、解析全局XML、读取字体文件、解析语言文件、预加载布局和图片等）按依赖关系并行执行
+    */
+    const std::vector<StartupStageTrace>& GetStartupTrace() const;
+
     /** 获取平台相关数据（可选参数，如不填写则使用默认值：nullptr）
     *   Windows平台：是资源所在模块句柄（HMODULE），如果为nullptr，则使用所在exe的句柄（可选参数）
     */
@@ -162,6 +171,12 @@ public:
      */
     DString GetClassAttributes(const DString& strClassName) const;
 
+    /** 获取一个全局 class 属性（包含预先解析的属性列表）
+     * @param[in] strClassName 全局 class 名称
+     * @return 如果不存在返回nullptr
+     */
+    const UiClassAttributes* FindClassAttributes(const DString& strClassName) const;
+
     /** 从全局属性中删除所有 class 属性
      * @return 返回绘制区域对象
      */
@@ -215,6 +230,10 @@ public:
     */
     CursorManager& Cursor();
 
+    /** 窗口池（复用弹出窗口）
+    */
+    WindowPool& Pool();
+
 public:
     /** 根据资源加载方式，返回对应的资源路径
      * @param[in] path 要获取的资源路径
@@ -275,6 +294,14 @@ private:
      */
     void RemoveAllImages();
 
+    /** 加载语言文件，创建语言映射表（如果使用了资源压缩包则从压缩包中读取，可在工作线程中调用）
+    * @param [in] languagePath 语言文件所在路径（绝对路径，或者压缩包中的相对路径）
+    * @param [in] languageFileName 语言文件的文件名（不含路径）
+    * @return 失败返回nullptr
+    */
+    std::unique_ptr<CompiledStringTable> LoadLanguageTable(const FilePath& languagePath,
+                                                           const DString& languageFileName) const;
+
 private:
 
     /** 渲染引擎管理接口
@@ -312,7 +339,7 @@ private:
 
     /** 每个Class的名称(KEY)和属性列表(VALUE)（比如global.xml中定义的Class）
     */
-    std::map<DString, DString> m_globalClass;
+    std::unordered_map<UiAtom, UiClassAttributes> m_globalClass;
 
     /** 主线程ID
     */
@@ -374,9 +401,17 @@ private:
     */
     CursorManager m_cursorManager;
 
+    /** 窗口池
+    */
+    WindowPool m_windowPool;
+
     /** 退出时要执行的函数
     */
     std::vector<std::function<void()>> m_atExitFunctions;
+
+    /** 最近一次加载资源各个阶段的耗时记录
+    */
+    std::vector<StartupStageTrace> m_startupTrace;
 };
 
 } // namespace ui
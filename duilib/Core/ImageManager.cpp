@@ -1,11 +1,15 @@
 #include "ImageManager.h"
 #include "duilib/Image/Image.h"
 #include "duilib/Image/ImageDecoder.h"
+#include "duilib/Image/SvgDocument.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/DpiManager.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/ParallelTaskRunner.h"
+#include <filesystem>
+#include <algorithm>
 
 namespace ui 
 {
@@ -26,21 +30,16 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const Window* pWindow,
     const DpiManager& dpi = (pWindow != nullptr) ? pWindow->Dpi() : GlobalManager::Instance().Dpi();
     //查找对应关系：LoadKey ->(多对一) ImageKey ->(一对一) SharedImage
     DString loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
-    auto iter = m_loadKeyMap.find(loadKey);
-    if (iter != m_loadKeyMap.end()) {
-        const DString& imageKey = iter->second;
-        auto it = m_imageMap.find(imageKey);
-        if (it != m_imageMap.end()) {
-            std::shared_ptr<ImageInfo> sharedImage = it->second.lock();
-            if (sharedImage) {
-                //从缓存中，找到有效图片资源，直接返回
-                return sharedImage;
-            }
-        }
-    }    
+    std::shared_ptr<ImageInfo> sharedImage = FindImageByLoadKey(loadKey);
+    if (sharedImage) {
+        //从缓存中，找到有效图片资源，直接返回
+        return sharedImage;
+    }
 
     //重新加载资源    
     std::unique_ptr<ImageInfo> imageInfo;
+    ImageLoadParam loadParam;
+    loadParam.m_loadKey = loadKey;
     bool isIcon = false;
 #ifdef DUILIB_BUILD_FOR_WIN
     if (GlobalManager::Instance().Icon().IsIconString(loadAtrribute.GetImageFullPath())) {
@@ -50,92 +49,338 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const Window* pWindow,
     }
 #endif
 
-    bool isDpiScaledImageFile = false;
     if (!isIcon) {
-        DString imageFullPath = loadAtrribute.GetImageFullPath();
-        bool isUseZip = GlobalManager::Instance().Zip().IsUseZip();
-        DString dpiImageFullPath;
-        uint32_t nImageDpiScale = 0;
-        //仅在DPI缩放图片功能开启的情况下，查找对应DPI的图片是否存在
-        const bool bEnableImageDpiScale = IsDpiScaleAllImages();
-        if (bEnableImageDpiScale && GetDpiScaleImageFullPath(dpi.GetScale(), isUseZip, imageFullPath,
-                                     dpiImageFullPath, nImageDpiScale)) {
-            //标记DPI自适应图片属性，如果路径不同，说明已经选择了对应DPI下的文件
-            isDpiScaledImageFile = true;
-            imageFullPath = dpiImageFullPath;
-            ASSERT(!imageFullPath.empty());
-            ASSERT(nImageDpiScale > 100);
+        PrepareImageLoad(dpi, loadAtrribute, loadParam, sharedImage);
+        if (sharedImage) {
+            //与请求的DPI缩放百分比相同
+            return sharedImage;
         }
-        else {
-            nImageDpiScale = 100; //原始图片，未经DPI缩放
-            isDpiScaledImageFile = false;
+        std::shared_ptr<SvgDocument> spSvgDocument;
+        imageInfo = DecodeImage(loadParam, loadAtrribute, dpi, spSvgDocument);
+        if (spSvgDocument != nullptr) {
+            m_svgDocumentMap[loadParam.m_imageFullPath] = spSvgDocument;
         }
-        //加载图片的KEY
-        ImageLoadAttribute realLoadAttribute = loadAtrribute;
-        realLoadAttribute.SetImageFullPath(imageFullPath);
-        DString imageKey;
-        if (isDpiScaledImageFile) {
-            //有对应DPI的图片文件
-            imageKey = realLoadAttribute.GetCacheKey(nImageDpiScale);
+    }
+    return AddImage(std::move(imageInfo), loadParam, dpi.GetScale());
+}
+
+void ImageManager::GetImageAsync(const Window* pWindow,
+                                 const ImageLoadAttribute& loadAtrribute,
+                                 const ImageLoadedCallback& callback)
+{
+    const DpiManager& dpi = (pWindow != nullptr) ? pWindow->Dpi() : GlobalManager::Instance().Dpi();
+    bool bLoadAsync = GlobalManager::Instance().Thread().HasThread(kThreadWorker);
+#ifdef DUILIB_BUILD_FOR_WIN
+    if (GlobalManager::Instance().Icon().IsIconString(loadAtrribute.GetImageFullPath())) {
+        //ICON句柄只能在UI线程中加载
+        bLoadAsync = false;
+    }
+#endif
+    std::shared_ptr<ImageInfo> sharedImage;
+    ImageLoadParam loadParam;
+    if (bLoadAsync) {
+        loadParam.m_loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
+        sharedImage = FindImageByLoadKey(loadParam.m_loadKey);
+        if (sharedImage == nullptr) {
+            PrepareImageLoad(dpi, loadAtrribute, loadParam, sharedImage);
         }
-        else {
-            //无对应DPI缩放比的图片文件
-            imageKey = realLoadAttribute.GetCacheKey(0);
-        }
-
-        //根据imageKey查询缓存
-        if (!imageKey.empty()) {
-            auto it = m_imageMap.find(imageKey);
-            if (it != m_imageMap.end()) {
-                std::shared_ptr<ImageInfo> sharedImage = it->second.lock();
-                if ((sharedImage != nullptr) && (sharedImage->GetLoadDpiScale() == dpi.GetScale())) {
-                    //与请求的DPI缩放百分比相同
-                    return sharedImage;
-                }
+    }
+    if (!bLoadAsync || (sharedImage != nullptr)) {
+        //已在缓存中，或者不支持异步加载：同步加载
+        if (sharedImage == nullptr) {
+            sharedImage = GetImage(pWindow, loadAtrribute);
+        }
+        if (callback != nullptr) {
+            callback(sharedImage);
+        }
+        return;
+    }
+
+    //同一个图片的多次请求，只加载一次
+    auto iter = m_pendingLoads.find(loadParam.m_loadKey);
+    if (iter != m_pendingLoads.end()) {
+        if (callback != nullptr) {
+            iter->second.push_back(callback);
+        }
+        return;
+    }
+    std::vector<ImageLoadedCallback>& callbacks = m_pendingLoads[loadParam.m_loadKey];
+    if (callback != nullptr) {
+        callbacks.push_back(callback);
+    }
+
+    //在工作线程中读取文件和解码，完成后回到UI线程中添加到缓存
+    struct AsyncLoadData
+    {
+        std::unique_ptr<ImageInfo> m_imageInfo;
+        std::shared_ptr<SvgDocument> m_spSvgDocument;
+    };
+    std::shared_ptr<AsyncLoadData> spLoadData = std::make_shared<AsyncLoadData>();
+    const uint32_t nDpi = dpi.GetDPI();
+    const uint32_t nDpiScale = dpi.GetScale();
+    StdClosure onLoaded = m_asyncLoadFlag.ToWeakCallback([this, loadParam, nDpiScale, spLoadData]() {
+            if (spLoadData->m_spSvgDocument != nullptr) {
+                m_svgDocumentMap[loadParam.m_imageFullPath] = spLoadData->m_spSvgDocument;
+            }
+            //加载期间，该图片可能已经被同步加载
+            std::shared_ptr<ImageInfo> spImageInfo = FindImageByLoadKey(loadParam.m_loadKey);
+            if (spImageInfo == nullptr) {
+                spImageInfo = AddImage(std::move(spLoadData->m_imageInfo), loadParam, nDpiScale);
+            }
+            std::vector<ImageLoadedCallback> loadedCallbacks;
+            auto iterPending = m_pendingLoads.find(loadParam.m_loadKey);
+            if (iterPending != m_pendingLoads.end()) {
+                loadedCallbacks.swap(iterPending->second);
+                m_pendingLoads.erase(iterPending);
+            }
+            for (const ImageLoadedCallback& loadedCallback : loadedCallbacks) {
+                loadedCallback(spImageInfo);
+            }
+        });
+    ImageLoadAttribute imageLoadAtrribute(loadAtrribute);
+    GlobalManager::Instance().Thread().PostTask(kThreadWorker, [loadParam, imageLoadAtrribute, nDpi, spLoadData, onLoaded]() {
+            DpiManager workerDpi;
+            workerDpi.SetDPI(nDpi);
+            spLoadData->m_imageInfo = DecodeImage(loadParam, imageLoadAtrribute, workerDpi, spLoadData->m_spSvgDocument);
+            GlobalManager::Instance().Thread().PostTask(kThreadUI, onLoaded);
+        });
+}
+
+/** 预加载图片的任务数据
+*/
+struct ImageManager::PrefetchImageTask
+{
+    /** 一个预加载的图片
+    */
+    struct PrefetchImage
+    {
+        explicit PrefetchImage(const ImageLoadAttribute& loadAttribute):
+            m_loadAttribute(loadAttribute)
+        {
+        }
+        ImageLoadAttribute m_loadAttribute;             //图片的加载属性
+        ImageLoadParam m_loadParam;                     //图片加载参数
+        std::unique_ptr<ImageInfo> m_imageInfo;         //解码后的图片
+        std::shared_ptr<SvgDocument> m_spSvgDocument;   //新解析的SVG文档
+    };
+    std::vector<PrefetchImage> m_images;    //需要加载的图片
+    uint32_t m_nDpi = 0;                    //加载图片使用的DPI
+    uint32_t m_nDpiScale = 0;               //加载图片使用的DPI缩放百分比
+};
+
+std::shared_ptr<ImageManager::PrefetchImageTask> ImageManager::PreparePrefetchImages(const std::vector<FilePath>& imageFiles)
+{
+    const DpiManager& dpi = GlobalManager::Instance().Dpi();
+    std::shared_ptr<PrefetchImageTask> spTask = std::make_shared<PrefetchImageTask>();
+    spTask->m_nDpi = dpi.GetDPI();
+    spTask->m_nDpiScale = dpi.GetScale();
+    for (const FilePath& imageFile : imageFiles) {
+        FilePath imageFullPath = GlobalManager::Instance().GetExistsResFullPath(FilePath(), FilePath(), imageFile);
+        if (imageFullPath.IsEmpty()) {
+            continue;
+        }
+        //与XML中未设置其他属性的图片（比如："file='logo.png'"）使用相同的加载属性
+        ImageLoadAttribute loadAtrribute(DString(), DString(), false, false, 0);
+        loadAtrribute.SetImageFullPath(imageFullPath.ToString());
+        PrefetchImageTask::PrefetchImage prefetchImage(loadAtrribute);
+        prefetchImage.m_loadParam.m_loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
+        std::shared_ptr<ImageInfo> sharedImage = FindImageByLoadKey(prefetchImage.m_loadParam.m_loadKey);
+        if (sharedImage == nullptr) {
+            PrepareImageLoad(dpi, loadAtrribute, prefetchImage.m_loadParam, sharedImage);
+        }
+        if (sharedImage != nullptr) {
+            //已在缓存中
+            m_prefetchImages.push_back(sharedImage);
+            continue;
+        }
+        spTask->m_images.push_back(std::move(prefetchImage));
+    }
+    return spTask;
+}
+
+void ImageManager::DecodePrefetchImages(PrefetchImageTask& task)
+{
+    DpiManager workerDpi;
+    workerDpi.SetDPI(task.m_nDpi);
+    ParallelTaskRunner::Instance().ParallelFor(task.m_images.size(), [&task, &workerDpi](size_t nIndex) {
+            PrefetchImageTask::PrefetchImage& prefetchImage = task.m_images[nIndex];
+            prefetchImage.m_imageInfo = DecodeImage(prefetchImage.m_loadParam, prefetchImage.m_loadAttribute,
+                                                    workerDpi, prefetchImage.m_spSvgDocument);
+        });
+}
+
+void ImageManager::AddPrefetchImages(PrefetchImageTask& task)
+{
+    for (PrefetchImageTask::PrefetchImage& prefetchImage : task.m_images) {
+        if (prefetchImage.m_spSvgDocument != nullptr) {
+            m_svgDocumentMap[prefetchImage.m_loadParam.m_imageFullPath] = prefetchImage.m_spSvgDocument;
+        }
+        std::shared_ptr<ImageInfo> spImageInfo = FindImageByLoadKey(prefetchImage.m_loadParam.m_loadKey);
+        if ((spImageInfo == nullptr) && (prefetchImage.m_imageInfo != nullptr)) {
+            spImageInfo = AddImage(std::move(prefetchImage.m_imageInfo), prefetchImage.m_loadParam, task.m_nDpiScale);
+        }
+        if (spImageInfo != nullptr) {
+            m_prefetchImages.push_back(spImageInfo);
+        }
+    }
+    task.m_images.clear();
+}
+
+void ImageManager::ReleasePrefetchImages()
+{
+    m_prefetchImages.clear();
+}
+
+std::shared_ptr<ImageInfo> ImageManager::FindImageByLoadKey(const DString& loadKey) const
+{
+    auto iter = m_loadKeyMap.find(loadKey);
+    if (iter != m_loadKeyMap.end()) {
+        const DString& imageKey = iter->second;
+        auto it = m_imageMap.find(imageKey);
+        if (it != m_imageMap.end()) {
+            return it->second.lock();
+        }
+    }
+    return nullptr;
+}
+
+void ImageManager::PrepareImageLoad(const DpiManager& dpi,
+                                    const ImageLoadAttribute& loadAtrribute,
+                                    ImageLoadParam& loadParam,
+                                    std::shared_ptr<ImageInfo>& cachedImage) const
+{
+    cachedImage.reset();
+    DString imageFullPath = loadAtrribute.GetImageFullPath();
+    bool isUseZip = GlobalManager::Instance().Zip().IsUseZip();
+    DString dpiImageFullPath;
+    uint32_t nImageDpiScale = 0;
+    bool isDpiScaledImageFile = false;
+    //仅在DPI缩放图片功能开启的情况下，查找对应DPI的图片是否存在
+    const bool bEnableImageDpiScale = IsDpiScaleAllImages();
+    if (bEnableImageDpiScale && GetDpiScaleImageFullPath(dpi.GetScale(), isUseZip, imageFullPath,
+                                 dpiImageFullPath, nImageDpiScale)) {
+        //标记DPI自适应图片属性，如果路径不同，说明已经选择了对应DPI下的文件
+        isDpiScaledImageFile = true;
+        imageFullPath = dpiImageFullPath;
+        ASSERT(!imageFullPath.empty());
+        ASSERT(nImageDpiScale > 100);
+    }
+    else {
+        nImageDpiScale = 100; //原始图片，未经DPI缩放
+        isDpiScaledImageFile = false;
+    }
+    //加载图片的KEY
+    ImageLoadAttribute realLoadAttribute = loadAtrribute;
+    realLoadAttribute.SetImageFullPath(imageFullPath);
+    DString imageKey;
+    if (isDpiScaledImageFile) {
+        //有对应DPI的图片文件
+        imageKey = realLoadAttribute.GetCacheKey(nImageDpiScale);
+    }
+    else {
+        //无对应DPI缩放比的图片文件
+        imageKey = realLoadAttribute.GetCacheKey(0);
+    }
+
+    //根据imageKey查询缓存
+    if (!imageKey.empty()) {
+        auto it = m_imageMap.find(imageKey);
+        if (it != m_imageMap.end()) {
+            std::shared_ptr<ImageInfo> sharedImage = it->second.lock();
+            if ((sharedImage != nullptr) && (sharedImage->GetLoadDpiScale() == dpi.GetScale())) {
+                //与请求的DPI缩放百分比相同
+                cachedImage = sharedImage;
             }
         }
+    }
+
+    loadParam.m_imageKey = imageKey;
+    loadParam.m_imageFullPath = imageFullPath;
+    loadParam.m_bUseZip = isUseZip;
+    loadParam.m_bDpiScaledImageFile = isDpiScaledImageFile;
+    loadParam.m_bEnableImageDpiScale = bEnableImageDpiScale;
+    loadParam.m_nImageDpiScale = nImageDpiScale;
+
+    //SVG图片：已解析过的文件，不再重新读取和解析
+    loadParam.m_spSvgDocument.reset();
+    if (ImageDecoder::IsSvgImageFile(imageFullPath)) {
+        auto iterSvg = m_svgDocumentMap.find(imageFullPath);
+        if (iterSvg != m_svgDocumentMap.end()) {
+            loadParam.m_spSvgDocument = iterSvg->second.lock();
+        }
+    }
+}
+
+std::unique_ptr<ImageInfo> ImageManager::DecodeImage(const ImageLoadParam& loadParam,
+                                                     const ImageLoadAttribute& loadAtrribute,
+                                                     const DpiManager& dpi,
+                                                     std::shared_ptr<SvgDocument>& spSvgDocument)
+{
+    spSvgDocument.reset();
+    ImageDecoder imageDecoder;
+    ImageLoadAttribute imageLoadAtrribute(loadAtrribute);
+    if (loadParam.m_bDpiScaledImageFile) {
+        imageLoadAtrribute.SetNeedDpiScale(false);
+    }
 
+    std::unique_ptr<ImageInfo> imageInfo;
+    const bool isSvgImageFile = ImageDecoder::IsSvgImageFile(loadParam.m_imageFullPath);
+    std::shared_ptr<SvgDocument> spLoadSvgDocument = loadParam.m_spSvgDocument;
+    if (spLoadSvgDocument == nullptr) {
         //从内存数据加载文件
         std::vector<uint8_t> fileData;
-        if (isUseZip) {
-            GlobalManager::Instance().Zip().GetZipData(FilePath(imageFullPath), fileData);
+        if (loadParam.m_bUseZip) {
+            GlobalManager::Instance().Zip().GetZipData(FilePath(loadParam.m_imageFullPath), fileData);
         }
         else {
-            FileUtil::ReadFileData(FilePath(imageFullPath), fileData);
+            FileUtil::ReadFileData(FilePath(loadParam.m_imageFullPath), fileData);
         }
         ASSERT(!fileData.empty());
-
-        imageInfo.reset();
         if (!fileData.empty()) {
-            ImageDecoder imageDecoder;
-            ImageLoadAttribute imageLoadAtrribute(loadAtrribute);
-            if (isDpiScaledImageFile) {
-                imageLoadAtrribute.SetNeedDpiScale(false);
-            }            
-            imageInfo = imageDecoder.LoadImageData(fileData, 
-                                                   imageLoadAtrribute, 
-                                                   bEnableImageDpiScale, nImageDpiScale, dpi);
-            if (imageInfo != nullptr) {
-                imageInfo->SetImageKey(imageKey);
+            if (isSvgImageFile) {
+                spLoadSvgDocument = SvgDocument::Parse(fileData);
+                spSvgDocument = spLoadSvgDocument;
+            }
+            else {
+                imageInfo = imageDecoder.LoadImageData(fileData,
+                                                       imageLoadAtrribute,
+                                                       loadParam.m_bEnableImageDpiScale,
+                                                       loadParam.m_nImageDpiScale, dpi);
             }
         }
-    }    
+    }
+    if (spLoadSvgDocument != nullptr) {
+        imageInfo = imageDecoder.LoadSvgImageData(spLoadSvgDocument,
+                                                  imageLoadAtrribute,
+                                                  loadParam.m_bEnableImageDpiScale,
+                                                  loadParam.m_nImageDpiScale, dpi);
+    }
+    if (imageInfo != nullptr) {
+        imageInfo->SetImageKey(loadParam.m_imageKey);
+    }
+    return imageInfo;
+}
+
+std::shared_ptr<ImageInfo> ImageManager::AddImage(std::unique_ptr<ImageInfo> imageInfo,
+                                                  const ImageLoadParam& loadParam,
+                                                  uint32_t nDpiScale)
+{
     std::shared_ptr<ImageInfo> sharedImage;
     if (imageInfo != nullptr) {
         DString imageKey = imageInfo->GetImageKey();
         sharedImage.reset(imageInfo.release(), &OnImageInfoDestroy);
-        sharedImage->SetLoadKey(loadKey);
-        sharedImage->SetLoadDpiScale(dpi.GetScale());
-        if (isDpiScaledImageFile) {
+        sharedImage->SetLoadKey(loadParam.m_loadKey);
+        sharedImage->SetLoadDpiScale(nDpiScale);
+        if (loadParam.m_bDpiScaledImageFile) {
             //使用了DPI自适应的图片，做标记（必须位true时才能修改这个值）
-            sharedImage->SetBitmapSizeDpiScaled(isDpiScaledImageFile);
+            sharedImage->SetBitmapSizeDpiScaled(true);
         }
         if (imageKey.empty()) {
-            imageKey = loadKey;
+            imageKey = loadParam.m_loadKey;
         }
 
         //保存对应关系：LoadKey ->(多对一) ImageKey ->(一对一) SharedImage
-        m_loadKeyMap[loadKey] = imageKey;
+        m_loadKeyMap[loadParam.m_loadKey] = imageKey;
         m_imageMap[imageKey] = sharedImage;
 
 #ifdef _DEBUG
@@ -206,7 +451,20 @@ void ImageManager::OnImageInfoDestroy(ImageInfo* pImageInfo)
                 }
             }
         }
+        const bool bSvgImage = pImageInfo->GetSvgDocument() != nullptr;
         delete pImageInfo;
+        if (bSvgImage) {
+            //删除已经释放的SVG文档
+            auto iterSvg = imageManager.m_svgDocumentMap.begin();
+            while (iterSvg != imageManager.m_svgDocumentMap.end()) {
+                if (iterSvg->second.expired()) {
+                    iterSvg = imageManager.m_svgDocumentMap.erase(iterSvg);
+                }
+                else {
+                    ++iterSvg;
+                }
+            }
+        }
 #ifdef _DEBUG
         //DString log = _T("Removed Image: ") + imageKey + _T("\n");
         //::OutputDebugString(log.c_str());
@@ -216,7 +474,11 @@ void ImageManager::OnImageInfoDestroy(ImageInfo* pImageInfo)
 
 void ImageManager::RemoveAllImages()
 {
+    m_prefetchImages.clear();
     m_imageMap.clear();
+    m_dpiImageManifest.clear();
+    m_imageAtlas.Clear();
+    m_svgDocumentMap.clear();
 }
 
 void ImageManager::SetDpiScaleAllImages(bool bEnable)
@@ -239,6 +501,11 @@ bool ImageManager::IsAutoMatchScaleImage() const
     return m_bAutoMatchScaleImage;
 }
 
+ImageAtlas& ImageManager::GetImageAtlas()
+{
+    return m_imageAtlas;
+}
+
 bool ImageManager::GetDpiScaleImageFullPath(uint32_t dpiScale,
                                             bool bIsUseZip,
                                             const DString& imageFullPath,
@@ -313,50 +580,123 @@ bool ImageManager::FindDpiScaleImageFullPath(uint32_t dpiScale,
         //当前DPI无需缩放
         return false;
     }
-    dpiImageFullPath = GetDpiScaledPath(dpiScale, imageFullPath);
-    if (dpiImageFullPath.empty()) {
+    if (!HasDpiScaleImage(dpiScale, bIsUseZip, imageFullPath)) {
         return false;
     }
+    dpiImageFullPath = GetDpiScaledPath(dpiScale, imageFullPath);
+    return !dpiImageFullPath.empty();
+}
+
+DString ImageManager::GetDpiScaledPath(uint32_t dpiScale, const DString& imageFullPath) const
+{
+    const size_t nNamePos = imageFullPath.find_last_of(_T("\\/"));
+    const size_t iPointPos = imageFullPath.rfind(_T('.'));
+    ASSERT((iPointPos != DString::npos) && ((nNamePos == DString::npos) || (iPointPos > nNamePos)));
+    if ((iPointPos == DString::npos) || ((nNamePos != DString::npos) && (iPointPos < nNamePos))) {
+        return DString();
+    }
+    //返回指定DPI下的图片，举例DPI缩放百分比为120（即放大到120%）的图片："image.png" 对应于 "image@120.png"
+    DString strNewFilePath = imageFullPath.substr(0, iPointPos);
+    strNewFilePath += StringUtil::Printf(_T("@%d"), dpiScale);
+    strNewFilePath += imageFullPath.substr(iPointPos);
+    return strNewFilePath;
+}
 
-    bool bExists = false;
-    if (bIsUseZip) {
-        bExists = GlobalManager::Instance().Zip().IsZipResExist(FilePath(dpiImageFullPath));
+bool ImageManager::HasDpiScaleImage(uint32_t dpiScale, bool bIsUseZip, const DString& imageFullPath) const
+{
+    const size_t nNamePos = imageFullPath.find_last_of(_T("\\/"));
+    DString dirPath;
+    DString fileName;
+    if (nNamePos == DString::npos) {
+        fileName = imageFullPath;
     }
     else {
-        bExists = FilePath(dpiImageFullPath).IsExistsPath();
+        dirPath = imageFullPath.substr(0, nNamePos + 1);
+        fileName = imageFullPath.substr(nNamePos + 1);
+    }
+    if (fileName.empty()) {
+        return false;
+    }
+#ifdef DUILIB_BUILD_FOR_WIN
+    const bool bIgnoreCase = true;
+#else
+    const bool bIgnoreCase = bIsUseZip;
+#endif
+    DString dirKey = bIgnoreCase ? StringUtil::MakeLowerString(dirPath) : dirPath;
+    dirKey = (bIsUseZip ? _T("zip:") : _T("file:")) + dirKey;
+    auto iter = m_dpiImageManifest.find(dirKey);
+    if (iter == m_dpiImageManifest.end()) {
+        //首次访问该目录，枚举目录下的所有文件（每个目录只枚举一次）
+        iter = m_dpiImageManifest.emplace(dirKey, std::unordered_map<DString, std::vector<uint32_t>>()).first;
+        LoadDpiImageManifest(dirPath, bIsUseZip, iter->second);
     }
-    if (!bExists) {
-        dpiImageFullPath.clear();
+    const auto& dirManifest = iter->second;
+    auto iterFile = dirManifest.find(bIgnoreCase ? StringUtil::MakeLowerString(fileName) : fileName);
+    if (iterFile == dirManifest.end()) {
+        return false;
     }
-    return bExists;
+    const std::vector<uint32_t>& dpiScales = iterFile->second;
+    return std::find(dpiScales.begin(), dpiScales.end(), dpiScale) != dpiScales.end();
 }
 
-DString ImageManager::GetDpiScaledPath(uint32_t dpiScale, const DString& imageFullPath) const
+void ImageManager::LoadDpiImageManifest(const DString& dirPath, bool bIsUseZip,
+                                        std::unordered_map<DString, std::vector<uint32_t>>& dirManifest) const
 {
-    DString strPathDir;
-    DString strPathFileName;
-    std::list<DString> strPathList = StringUtil::Split(imageFullPath, _T("\\"));
-    for (auto it = strPathList.begin(); it != strPathList.end(); ++it) {
-        auto itTemp = it;
-        if (++itTemp == strPathList.end()) {
-            strPathFileName = *it;
-        }
-        else {
-            strPathDir += *it + _T("\\");
+    std::vector<DString> fileList;
+    if (bIsUseZip) {
+        GlobalManager::Instance().Zip().GetZipFileList(FilePath(dirPath), fileList);
+    }
+    else {
+        std::error_code errorCode;
+        std::filesystem::path fsDirPath = dirPath.empty() ? std::filesystem::path(_T(".")) : std::filesystem::path(dirPath);
+        std::filesystem::directory_iterator dirIter(fsDirPath, errorCode);
+        std::filesystem::directory_iterator dirEnd;
+        while (!errorCode && (dirIter != dirEnd)) {
+            if (dirIter->is_regular_file(errorCode)) {
+#ifdef DUILIB_UNICODE
+                fileList.push_back(dirIter->path().filename().wstring());
+#else
+                fileList.push_back(dirIter->path().filename().string());
+#endif
+            }
+            dirIter.increment(errorCode);
         }
     }
-
-    size_t iPointPos = strPathFileName.rfind('.');
-    ASSERT(iPointPos != DString::npos);
-    if (iPointPos == DString::npos) {
-        return DString();
+#ifdef DUILIB_BUILD_FOR_WIN
+    const bool bIgnoreCase = true;
+#else
+    const bool bIgnoreCase = bIsUseZip;
+#endif
+    //DPI缩放图片的文件名格式："image@120.png"，对应的原始图片为："image.png"
+    for (const DString& fileName : fileList) {
+        const size_t iPointPos = fileName.rfind(_T('.'));
+        if ((iPointPos == DString::npos) || (iPointPos == 0)) {
+            continue;
+        }
+        const size_t iAtPos = fileName.rfind(_T('@'), iPointPos - 1);
+        if ((iAtPos == DString::npos) || ((iAtPos + 1) >= iPointPos)) {
+            continue;
+        }
+        bool bDigits = true;
+        for (size_t i = iAtPos + 1; i < iPointPos; ++i) {
+            if ((fileName[i] < _T('0')) || (fileName[i] > _T('9'))) {
+                bDigits = false;
+                break;
+            }
+        }
+        if (!bDigits || ((iPointPos - iAtPos - 1) > 4)) {
+            continue;
+        }
+        const uint32_t nScale = (uint32_t)StringUtil::StringToInt32(fileName.substr(iAtPos + 1, iPointPos - iAtPos - 1));
+        if (nScale <= 100) {
+            continue;
+        }
+        DString originFileName = fileName.substr(0, iAtPos) + fileName.substr(iPointPos);
+        if (bIgnoreCase) {
+            originFileName = StringUtil::MakeLowerString(originFileName);
+        }
+        dirManifest[originFileName].push_back(nScale);
     }
-    DString strFileExtension = strPathFileName.substr(iPointPos, strPathFileName.size() - iPointPos);
-    DString strFile = strPathFileName.substr(0, iPointPos);
-    //返回指定DPI下的图片，举例DPI缩放百分比为120（即放大到120%）的图片："image.png" 对应于 "image@120.png"
-    strPathFileName = StringUtil::Printf(_T("%s%s%d%s"), strFile.c_str(), _T("@"), dpiScale, strFileExtension.c_str());
-    DString strNewFilePath = strPathDir + strPathFileName;
-    return strNewFilePath;
 }
 
 }
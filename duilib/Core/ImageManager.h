@@ -2,6 +2,9 @@
 #define UI_CORE_IMAGEMANAGER_H_
 
 #include "duilib/duilib_defs.h"
+#include "duilib/Image/ImageAtlas.h"
+#include "duilib/Core/Callback.h"
+#include "duilib/Utils/FilePath.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -11,6 +14,7 @@ namespace ui
 {
 class ImageInfo;
 class ImageLoadAttribute;
+class SvgDocument;
 class DpiManager;
 class Window;
 
@@ -18,6 +22,11 @@ class Window;
  */
 class UILIB_API ImageManager
 {
+public:
+    /** 图片异步加载完成的回调函数（在UI线程中调用），加载失败时参数为nullptr
+    */
+    typedef std::function<void(const std::shared_ptr<ImageInfo>& spImageInfo)> ImageLoadedCallback;
+
 public:
     ImageManager();
     ~ImageManager();
@@ -33,7 +42,42 @@ public:
     std::shared_ptr<ImageInfo> GetImage(const Window* pWindow,
                                         const ImageLoadAttribute& loadAtrribute);
 
-    /** 从缓存中删除所有图片
+    /** 异步加载图片 ImageInfo 对象：在工作线程中读取文件和解码，完成后在UI线程中添加到缓存，并回调通知
+     *  如果图片已在缓存中，或者未注册工作线程，或者是ICON图片，则同步加载并立即回调
+     *  同一个图片的多次请求，只加载一次，加载完成后依次回调
+     * @param [in] pWindow 图片关联的窗口（用于DPI缩放等）
+     * @param [in] loadAtrribute 图片的加载属性，包含图片路径等信息
+     * @param [in] callback 加载完成的回调函数，总会被调用（可能在本函数返回前调用）
+     */
+    void GetImageAsync(const Window* pWindow,
+                       const ImageLoadAttribute& loadAtrribute,
+                       const ImageLoadedCallback& callback);
+
+    /** 预加载图片的任务数据（见PreparePrefetchImages）
+    */
+    struct PrefetchImageTask;
+
+    /** 预加载图片，第一步：查找图片文件（需要在UI线程中调用）
+     *  用于程序启动时，与其他资源并行加载第一个窗口用到的图片（见ResourceParam::prefetchImageFiles），按全局DPI加载
+     * @param [in] imageFiles 图片文件路径列表（相对于资源路径，或者绝对路径）
+     * @return 返回预加载任务，然后依次调用DecodePrefetchImages和AddPrefetchImages
+     */
+    std::shared_ptr<PrefetchImageTask> PreparePrefetchImages(const std::vector<FilePath>& imageFiles);
+
+    /** 预加载图片，第二步：读取图片文件并解码（可在工作线程中调用，多个图片并行解码）
+     */
+    static void DecodePrefetchImages(PrefetchImageTask& task);
+
+    /** 预加载图片，第三步：将解码后的图片添加到缓存（需要在UI线程中调用）
+     *  预加载的图片一直保留在缓存中，直到调用ReleasePrefetchImages或者RemoveAllImages
+     */
+    void AddPrefetchImages(PrefetchImageTask& task);
+
+    /** 释放预加载的图片（窗口显示后，图片已由控件持有，可调用此函数释放）
+     */
+    void ReleasePrefetchImages();
+
+    /** 从缓存中删除所有图片（同时清空DPI缩放图片清单，资源根目录变化后需要调用）
      */
     void RemoveAllImages();
 
@@ -56,7 +100,57 @@ public:
     */
     bool IsAutoMatchScaleImage() const;
 
+    /** 获取图集（用于列表图标等小图片的批量绘制）
+    */
+    ImageAtlas& GetImageAtlas();
+
 private:
+    /** 图片加载参数（查找图片文件的结果）
+    */
+    struct ImageLoadParam
+    {
+        DString m_loadKey;                  //图片的加载Key
+        DString m_imageKey;                 //图片的Key
+        DString m_imageFullPath;            //图片文件的实际路径（可能是对应DPI的图片文件）
+        bool m_bUseZip = false;             //是否使用zip压缩包资源
+        bool m_bDpiScaledImageFile = false; //是否使用了对应DPI的图片文件
+        bool m_bEnableImageDpiScale = false;//是否开启DPI缩放图片功能
+        uint32_t m_nImageDpiScale = 100;    //图片文件对应的DPI缩放百分比
+        std::shared_ptr<SvgDocument> m_spSvgDocument; //已解析的SVG文档（如果有）
+    };
+
+    /** 根据加载Key查询缓存中的图片
+    */
+    std::shared_ptr<ImageInfo> FindImageByLoadKey(const DString& loadKey) const;
+
+    /** 查找图片文件，生成加载参数（需要在UI线程中调用）
+    * @param [in] dpi DPI管理器
+    * @param [in] loadAtrribute 图片的加载属性
+    * @param [out] loadParam 返回图片加载参数
+    * @param [out] cachedImage 如果缓存中已有相同DPI的图片，返回该图片
+    */
+    void PrepareImageLoad(const DpiManager& dpi,
+                          const ImageLoadAttribute& loadAtrribute,
+                          ImageLoadParam& loadParam,
+                          std::shared_ptr<ImageInfo>& cachedImage) const;
+
+    /** 读取图片文件并解码（可在工作线程中调用）
+    * @param [in] loadParam 图片加载参数
+    * @param [in] loadAtrribute 图片的加载属性
+    * @param [in] dpi DPI管理器
+    * @param [out] spSvgDocument 如果新解析了SVG文件，返回SVG文档
+    */
+    static std::unique_ptr<ImageInfo> DecodeImage(const ImageLoadParam& loadParam,
+                                                  const ImageLoadAttribute& loadAtrribute,
+                                                  const DpiManager& dpi,
+                                                  std::shared_ptr<SvgDocument>& spSvgDocument);
+
+    /** 将解码后的图片添加到缓存（需要在UI线程中调用）
+    */
+    std::shared_ptr<ImageInfo> AddImage(std::unique_ptr<ImageInfo> imageInfo,
+                                        const ImageLoadParam& loadParam,
+                                        uint32_t nDpiScale);
+
     /** 图片被销毁的回调函数，用于释放图片资源
      * @param[in] pImageInfo 图片对应的 ImageInfo 对象
      */
@@ -96,6 +190,22 @@ private:
     */
     DString GetDpiScaledPath(uint32_t dpiScale, const DString& imageFullPath) const;
 
+    /** 查询DPI缩放图片清单，判断图片在指定DPI缩放百分比下是否有对应的图片文件
+    *   首次访问某个目录时，枚举该目录下的文件（本地目录或者zip压缩包中的目录），记录所有DPI缩放图片，此后查询时无需访问文件系统
+    * @param [in] dpiScale 需要查找的DPI缩放百分比
+    * @param [in] bIsUseZip 是否使用zip压缩包资源
+    * @param [in] imageFullPath 图片资源的完整路径（原始图片，不含DPI缩放百分比）
+    */
+    bool HasDpiScaleImage(uint32_t dpiScale, bool bIsUseZip, const DString& imageFullPath) const;
+
+    /** 枚举目录下的文件，生成该目录的DPI缩放图片清单
+    * @param [in] dirPath 目录的路径
+    * @param [in] bIsUseZip 是否使用zip压缩包资源
+    * @param [out] dirManifest 返回该目录的DPI缩放图片清单
+    */
+    void LoadDpiImageManifest(const DString& dirPath, bool bIsUseZip,
+                              std::unordered_map<DString, std::vector<uint32_t>>& dirManifest) const;
+
 #ifdef DUILIB_BUILD_FOR_WIN
     /** 从HICON句柄加载一个图片
     */
@@ -121,6 +231,32 @@ private:
     /** 图片资源Key映射表（图片的加载Key与图片Key）
     */
     std::unordered_map <DString, DString> m_loadKeyMap;
+
+    /** DPI缩放图片清单：目录路径 ->（原始图片的文件名 -> 该图片已有的DPI缩放百分比列表）
+    *   注：不区分大小写时（Windows平台或者zip压缩包），目录路径和文件名均转换为小写
+    */
+    mutable std::unordered_map<DString, std::unordered_map<DString, std::vector<uint32_t>>> m_dpiImageManifest;
+
+    /** 小图片的图集
+    */
+    ImageAtlas m_imageAtlas;
+
+    /** 已解析的SVG文档（图片文件路径与SVG文档），SVG文件只解析一次，不同DPI或者不同大小的图片共用
+    *   SVG文档由使用它的图片（ImageInfo）持有，所有图片释放后，SVG文档随之释放
+    */
+    std::unordered_map<DString, std::weak_ptr<SvgDocument>> m_svgDocumentMap;
+
+    /** 正在异步加载的图片（图片的加载Key与加载完成的回调函数）
+    */
+    std::unordered_map<DString, std::vector<ImageLoadedCallback>> m_pendingLoads;
+
+    /** 异步加载完成回调的生命周期标志
+    */
+    WeakCallbackFlag m_asyncLoadFlag;
+
+    /** 预加载的图片（缓存中只保存图片的弱引用，预加载的图片需要在此持有）
+    */
+    std::vector<std::shared_ptr<ImageInfo>> m_prefetchImages;
 };
 
 }
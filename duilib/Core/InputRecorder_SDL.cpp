@@ -0,0 +1,493 @@
+#include "InputRecorder_SDL.h"
+#include "duilib/Core/MessageLoop_SDL.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Utils/FileUtil.h"
+
+#ifdef DUILIB_BUILD_FOR_SDL
+
+#include <SDL3/SDL.h>
+#include <cstring>
+
+namespace ui {
+
+namespace
+{
+/** 文件格式：文件头（标识 + 版本号 + 事件个数），然后依次是每个事件：
+*   事件时间(int64) + 事件类型(uint32) + 窗口ID(uint32) + 该类型事件的数据（只保存该类型用到的字段）
+*/
+const char kInputRecordMagic[8] = { 'D', 'U', 'I', 'I', 'N', 'P', 'U', 'T' };
+constexpr const uint32_t kInputRecordVersion = 1;
+
+/** 按原始字节写入数据（小端字节序，与记录时的平台一致）
+*/
+class InputRecordWriter
+{
+public:
+    explicit InputRecordWriter(std::vector<uint8_t>& data): m_data(data) {}
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+        m_data.insert(m_data.end(), p, p + sizeof(T));
+    }
+
+    void WriteString(const std::string& value)
+    {
+        Write((uint32_t)value.size());
+        m_data.insert(m_data.end(), value.begin(), value.end());
+    }
+
+private:
+    std::vector<uint8_t>& m_data;
+};
+
+/** 按原始字节读取数据，数据不完整时返回false
+*/
+class InputRecordReader
+{
+public:
+    explicit InputRecordReader(const std::vector<uint8_t>& data): m_data(data), m_nPos(0) {}
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        if ((m_nPos + sizeof(T)) > m_data.size()) {
+            return false;
+        }
+        memcpy(&value, m_data.data() + m_nPos, sizeof(T));
+        m_nPos += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value)
+    {
+        uint32_t nSize = 0;
+        if (!Read(nSize) || ((m_nPos + nSize) > m_data.size())) {
+            return false;
+        }
+        value.assign((const char*)m_data.data() + m_nPos, nSize);
+        m_nPos += nSize;
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& m_data;
+    size_t m_nPos;
+};
+
+/** 写入一个事件
+*/
+void WriteRecordEvent(InputRecordWriter& writer, const InputRecordEvent& event)
+{
+    writer.Write(event.m_nTimestamp);
+    writer.Write(event.m_nType);
+    writer.Write(event.m_nWindowId);
+    switch (event.m_nType) {
+    case SDL_EVENT_MOUSE_MOTION:
+        writer.Write(event.m_fX);
+        writer.Write(event.m_fY);
+        writer.Write(event.m_fDeltaX);
+        writer.Write(event.m_fDeltaY);
+        writer.Write(event.m_nState);
+        break;
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        writer.Write(event.m_fX);
+        writer.Write(event.m_fY);
+        writer.Write(event.m_nButton);
+        writer.Write(event.m_nClicks);
+        break;
+    case SDL_EVENT_MOUSE_WHEEL:
+        writer.Write(event.m_fX);
+        writer.Write(event.m_fY);
+        writer.Write(event.m_fDeltaX);
+        writer.Write(event.m_fDeltaY);
+        writer.Write(event.m_nState);
+        break;
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        writer.Write(event.m_nScancode);
+        writer.Write(event.m_nKeycode);
+        writer.Write(event.m_nKeyMod);
+        writer.Write(event.m_nRaw);
+        writer.Write((uint8_t)(event.m_bRepeat ? 1 : 0));
+        break;
+    case SDL_EVENT_TEXT_INPUT:
+        writer.WriteString(event.m_text);
+        break;
+    case SDL_EVENT_WINDOW_RESIZED:
+        writer.Write(event.m_nWidth);
+        writer.Write(event.m_nHeight);
+        break;
+    default:
+        break;
+    }
+}
+
+/** 读取一个事件
+*/
+bool ReadRecordEvent(InputRecordReader& reader, InputRecordEvent& event)
+{
+    if (!reader.Read(event.m_nTimestamp) || !reader.Read(event.m_nType) || !reader.Read(event.m_nWindowId)) {
+        return false;
+    }
+    bool bRet = true;
+    switch (event.m_nType) {
+    case SDL_EVENT_MOUSE_MOTION:
+        bRet = reader.Read(event.m_fX) && reader.Read(event.m_fY) &&
+               reader.Read(event.m_fDeltaX) && reader.Read(event.m_fDeltaY) && reader.Read(event.m_nState);
+        break;
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        bRet = reader.Read(event.m_fX) && reader.Read(event.m_fY) &&
+               reader.Read(event.m_nButton) && reader.Read(event.m_nClicks);
+        event.m_bDown = (event.m_nType == SDL_EVENT_MOUSE_BUTTON_DOWN);
+        break;
+    case SDL_EVENT_MOUSE_WHEEL:
+        bRet = reader.Read(event.m_fX) && reader.Read(event.m_fY) &&
+               reader.Read(event.m_fDeltaX) && reader.Read(event.m_fDeltaY) && reader.Read(event.m_nState);
+        break;
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        {
+            uint8_t nRepeat = 0;
+            bRet = reader.Read(event.m_nScancode) && reader.Read(event.m_nKeycode) &&
+                   reader.Read(event.m_nKeyMod) && reader.Read(event.m_nRaw) && reader.Read(nRepeat);
+            event.m_bRepeat = (nRepeat != 0);
+            event.m_bDown = (event.m_nType == SDL_EVENT_KEY_DOWN);
+        }
+        break;
+    case SDL_EVENT_TEXT_INPUT:
+        bRet = reader.ReadString(event.m_text);
+        break;
+    case SDL_EVENT_WINDOW_RESIZED:
+        bRet = reader.Read(event.m_nWidth) && reader.Read(event.m_nHeight);
+        break;
+    default:
+        //未知的事件类型，无法确定数据长度
+        bRet = false;
+        break;
+    }
+    return bRet;
+}
+
+} //namespace
+
+InputRecorder_SDL::InputRecorder_SDL():
+    m_bRecording(false),
+    m_nStartTimestamp(0)
+{
+}
+
+InputRecorder_SDL::~InputRecorder_SDL()
+{
+    StopRecording();
+}
+
+void InputRecorder_SDL::StartRecording()
+{
+    m_events.clear();
+    m_nStartTimestamp = 0;
+    m_bRecording = true;
+    MessageLoop_SDL::SetInputRecorder(this);
+}
+
+void InputRecorder_SDL::StopRecording()
+{
+    if (m_bRecording) {
+        m_bRecording = false;
+        MessageLoop_SDL::SetInputRecorder(nullptr);
+    }
+}
+
+bool InputRecorder_SDL::IsRecording() const
+{
+    return m_bRecording;
+}
+
+bool InputRecorder_SDL::IsRecordableEvent(uint32_t nEventType)
+{
+    switch (nEventType) {
+    case SDL_EVENT_MOUSE_MOTION:
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+    case SDL_EVENT_MOUSE_WHEEL:
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+    case SDL_EVENT_TEXT_INPUT:
+    case SDL_EVENT_WINDOW_RESIZED:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+void InputRecorder_SDL::RecordEvent(const SDL_Event& sdlEvent)
+{
+    if (!m_bRecording || !IsRecordableEvent(sdlEvent.type)) {
+        return;
+    }
+    if (m_events.empty()) {
+        m_nStartTimestamp = sdlEvent.common.timestamp;
+    }
+    InputRecordEvent event;
+    event.m_nType = sdlEvent.type;
+    if (sdlEvent.common.timestamp > m_nStartTimestamp) {
+        event.m_nTimestamp = (int64_t)(sdlEvent.common.timestamp - m_nStartTimestamp);
+    }
+    if (!m_events.empty() && (event.m_nTimestamp < m_events.back().m_nTimestamp)) {
+        //保证时间有序
+        event.m_nTimestamp = m_events.back().m_nTimestamp;
+    }
+    switch (sdlEvent.type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        event.m_nWindowId = sdlEvent.motion.windowID;
+        event.m_fX = sdlEvent.motion.x;
+        event.m_fY = sdlEvent.motion.y;
+        event.m_fDeltaX = sdlEvent.motion.xrel;
+        event.m_fDeltaY = sdlEvent.motion.yrel;
+        event.m_nState = sdlEvent.motion.state;
+        break;
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        event.m_nWindowId = sdlEvent.button.windowID;
+        event.m_fX = sdlEvent.button.x;
+        event.m_fY = sdlEvent.button.y;
+        event.m_nButton = sdlEvent.button.button;
+        event.m_nClicks = sdlEvent.button.clicks;
+        event.m_bDown = sdlEvent.button.down;
+        break;
+    case SDL_EVENT_MOUSE_WHEEL:
+        event.m_nWindowId = sdlEvent.wheel.windowID;
+        event.m_fX = sdlEvent.wheel.mouse_x;
+        event.m_fY = sdlEvent.wheel.mouse_y;
+        event.m_fDeltaX = sdlEvent.wheel.x;
+        event.m_fDeltaY = sdlEvent.wheel.y;
+        event.m_nState = (uint32_t)sdlEvent.wheel.direction;
+        break;
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        event.m_nWindowId = sdlEvent.key.windowID;
+        event.m_nScancode = (uint32_t)sdlEvent.key.scancode;
+        event.m_nKeycode = (uint32_t)sdlEvent.key.key;
+        event.m_nKeyMod = (uint16_t)sdlEvent.key.mod;
+        event.m_nRaw = sdlEvent.key.raw;
+        event.m_bDown = sdlEvent.key.down;
+        event.m_bRepeat = sdlEvent.key.repeat;
+        break;
+    case SDL_EVENT_TEXT_INPUT:
+        event.m_nWindowId = sdlEvent.text.windowID;
+        if (sdlEvent.text.text != nullptr) {
+            event.m_text = sdlEvent.text.text;
+        }
+        break;
+    case SDL_EVENT_WINDOW_RESIZED:
+        event.m_nWindowId = sdlEvent.window.windowID;
+        event.m_nWidth = sdlEvent.window.data1;
+        event.m_nHeight = sdlEvent.window.data2;
+        break;
+    default:
+        break;
+    }
+    m_events.push_back(std::move(event));
+}
+
+const std::vector<InputRecordEvent>& InputRecorder_SDL::GetEvents() const
+{
+    return m_events;
+}
+
+bool InputRecorder_SDL::SaveToFile(const FilePath& filePath) const
+{
+    std::vector<uint8_t> fileData;
+    fileData.reserve(16 + m_events.size() * 32);
+    InputRecordWriter writer(fileData);
+    for (char ch : kInputRecordMagic) {
+        writer.Write(ch);
+    }
+    writer.Write(kInputRecordVersion);
+    writer.Write((uint32_t)m_events.size());
+    for (const InputRecordEvent& event : m_events) {
+        WriteRecordEvent(writer, event);
+    }
+    return FileUtil::WriteFileData(filePath, fileData);
+}
+
+bool InputRecorder_SDL::LoadFromFile(const FilePath& filePath, std::vector<InputRecordEvent>& events)
+{
+    events.clear();
+    std::vector<uint8_t> fileData;
+    if (!FileUtil::ReadFileData(filePath, fileData)) {
+        return false;
+    }
+    InputRecordReader reader(fileData);
+    char magic[sizeof(kInputRecordMagic)] = { 0 };
+    for (char& ch : magic) {
+        if (!reader.Read(ch)) {
+            return false;
+        }
+    }
+    uint32_t nVersion = 0;
+    uint32_t nEventCount = 0;
+    if ((memcmp(magic, kInputRecordMagic, sizeof(magic)) != 0) ||
+        !reader.Read(nVersion) || (nVersion != kInputRecordVersion) ||
+        !reader.Read(nEventCount)) {
+        return false;
+    }
+    events.reserve(std::min(nEventCount, (uint32_t)(fileData.size() / 16)));
+    for (uint32_t nIndex = 0; nIndex < nEventCount; ++nIndex) {
+        InputRecordEvent event;
+        if (!ReadRecordEvent(reader, event)) {
+            events.clear();
+            return false;
+        }
+        events.push_back(std::move(event));
+    }
+    return true;
+}
+
+InputReplayer_SDL::InputReplayer_SDL():
+    m_nNextIndex(0)
+{
+}
+
+InputReplayer_SDL::~InputReplayer_SDL()
+{
+}
+
+bool InputReplayer_SDL::LoadFromFile(const FilePath& filePath)
+{
+    m_nNextIndex = 0;
+    return InputRecorder_SDL::LoadFromFile(filePath, m_events);
+}
+
+void InputReplayer_SDL::SetEvents(const std::vector<InputRecordEvent>& events)
+{
+    m_events = events;
+    m_nNextIndex = 0;
+}
+
+void InputReplayer_SDL::SetTargetWindow(Window* pWindow)
+{
+    //记录中第一个窗口作为主窗口
+    for (const InputRecordEvent& event : m_events) {
+        if (event.m_nWindowId != 0) {
+            MapWindow(event.m_nWindowId, pWindow);
+            break;
+        }
+    }
+}
+
+void InputReplayer_SDL::MapWindow(uint32_t nRecordWindowId, Window* pWindow)
+{
+    ASSERT((pWindow != nullptr) && pWindow->IsWindow());
+    if ((pWindow == nullptr) || !pWindow->IsWindow()) {
+        return;
+    }
+    const SDL_WindowID windowId = SDL_GetWindowID((SDL_Window*)pWindow->GetWindowHandle());
+    if (windowId != 0) {
+        m_windowIdMap[nRecordWindowId] = windowId;
+    }
+}
+
+void InputReplayer_SDL::Restart()
+{
+    m_nNextIndex = 0;
+}
+
+size_t InputReplayer_SDL::ReplayUntil(int64_t nReplayTime)
+{
+    size_t nCount = 0;
+    while ((m_nNextIndex < m_events.size()) && (m_events[m_nNextIndex].m_nTimestamp <= nReplayTime)) {
+        const InputRecordEvent& recordEvent = m_events[m_nNextIndex];
+        ++m_nNextIndex;
+        auto iter = m_windowIdMap.find(recordEvent.m_nWindowId);
+        if (iter != m_windowIdMap.end()) {
+            ReplayEvent(recordEvent, iter->second);
+            ++nCount;
+        }
+    }
+    return nCount;
+}
+
+bool InputReplayer_SDL::IsFinished() const
+{
+    return m_nNextIndex >= m_events.size();
+}
+
+int64_t InputReplayer_SDL::GetDuration() const
+{
+    return m_events.empty() ? 0 : m_events.back().m_nTimestamp;
+}
+
+size_t InputReplayer_SDL::GetEventCount() const
+{
+    return m_events.size();
+}
+
+void InputReplayer_SDL::ReplayEvent(const InputRecordEvent& recordEvent, uint32_t nWindowId)
+{
+    if (recordEvent.m_nType == SDL_EVENT_WINDOW_RESIZED) {
+        //修改窗口的实际大小，由SDL产生窗口大小变化事件
+        SDL_Window* sdlWindow = SDL_GetWindowFromID(nWindowId);
+        if (sdlWindow != nullptr) {
+            SDL_SetWindowSize(sdlWindow, recordEvent.m_nWidth, recordEvent.m_nHeight);
+        }
+        return;
+    }
+
+    SDL_Event sdlEvent;
+    memset(&sdlEvent, 0, sizeof(sdlEvent));
+    sdlEvent.type = recordEvent.m_nType;
+    switch (recordEvent.m_nType) {
+    case SDL_EVENT_MOUSE_MOTION:
+        sdlEvent.motion.windowID = nWindowId;
+        sdlEvent.motion.x = recordEvent.m_fX;
+        sdlEvent.motion.y = recordEvent.m_fY;
+        sdlEvent.motion.xrel = recordEvent.m_fDeltaX;
+        sdlEvent.motion.yrel = recordEvent.m_fDeltaY;
+        sdlEvent.motion.state = recordEvent.m_nState;
+        break;
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        sdlEvent.button.windowID = nWindowId;
+        sdlEvent.button.x = recordEvent.m_fX;
+        sdlEvent.button.y = recordEvent.m_fY;
+        sdlEvent.button.button = recordEvent.m_nButton;
+        sdlEvent.button.clicks = recordEvent.m_nClicks;
+        sdlEvent.button.down = recordEvent.m_bDown;
+        break;
+    case SDL_EVENT_MOUSE_WHEEL:
+        sdlEvent.wheel.windowID = nWindowId;
+        sdlEvent.wheel.mouse_x = recordEvent.m_fX;
+        sdlEvent.wheel.mouse_y = recordEvent.m_fY;
+        sdlEvent.wheel.x = recordEvent.m_fDeltaX;
+        sdlEvent.wheel.y = recordEvent.m_fDeltaY;
+        sdlEvent.wheel.direction = (SDL_MouseWheelDirection)recordEvent.m_nState;
+        break;
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        sdlEvent.key.windowID = nWindowId;
+        sdlEvent.key.scancode = (SDL_Scancode)recordEvent.m_nScancode;
+        sdlEvent.key.key = (SDL_Keycode)recordEvent.m_nKeycode;
+        sdlEvent.key.mod = (SDL_Keymod)recordEvent.m_nKeyMod;
+        sdlEvent.key.raw = recordEvent.m_nRaw;
+        sdlEvent.key.down = recordEvent.m_bDown;
+        sdlEvent.key.repeat = recordEvent.m_bRepeat;
+        break;
+    case SDL_EVENT_TEXT_INPUT:
+        //文本由m_events保存，在消息派发前保持有效（回放期间不修改m_events）
+        sdlEvent.text.windowID = nWindowId;
+        sdlEvent.text.text = recordEvent.m_text.c_str();
+        break;
+    default:
+        return;
+    }
+    SDL_PushEvent(&sdlEvent);
+}
+
+} // namespace ui
+
+#endif // DUILIB_BUILD_FOR_SDL
@@ -0,0 +1,184 @@
+#ifndef UI_CORE_INPUT_RECORDER_SDL_H_
+#define UI_CORE_INPUT_RECORDER_SDL_H_
+
+#include "duilib/Utils/FilePath.h"
+
+#ifdef DUILIB_BUILD_FOR_SDL
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+union SDL_Event;
+
+namespace ui {
+
+class Window;
+
+/** 记录的一个输入事件（鼠标、滚轮、键盘、文本输入、窗口大小变化）
+*/
+struct InputRecordEvent
+{
+    int64_t m_nTimestamp = 0;       //事件时间（纳秒，相对于记录的第一个事件）
+    uint32_t m_nType = 0;           //事件类型（SDL_EventType）
+    uint32_t m_nWindowId = 0;       //记录时事件所属窗口的ID
+    float m_fX = 0;                 //鼠标位置X坐标
+    float m_fY = 0;                 //鼠标位置Y坐标
+    float m_fDeltaX = 0;            //鼠标移动事件：相对移动距离；滚轮事件：横向滚动量
+    float m_fDeltaY = 0;            //鼠标移动事件：相对移动距离；滚轮事件：纵向滚动量
+    uint32_t m_nState = 0;          //鼠标移动事件：按键状态；滚轮事件：滚动方向
+    uint32_t m_nScancode = 0;       //键盘事件：扫描码
+    uint32_t m_nKeycode = 0;        //键盘事件：键值
+    uint16_t m_nKeyMod = 0;         //键盘事件：组合键状态
+    uint16_t m_nRaw = 0;            //键盘事件：平台相关的原始键值
+    uint8_t m_nButton = 0;          //鼠标按键事件：按键
+    uint8_t m_nClicks = 0;          //鼠标按键事件：连击次数
+    bool m_bDown = false;           //鼠标按键和键盘事件：是否为按下
+    bool m_bRepeat = false;         //键盘事件：是否为重复按键
+    int32_t m_nWidth = 0;           //窗口大小变化事件：新的宽度
+    int32_t m_nHeight = 0;          //窗口大小变化事件：新的高度
+    std::string m_text;             //文本输入事件：输入的文本（UTF8编码）
+};
+
+/** 输入事件的记录器：记录消息循环派发的输入事件，保存为紧凑的二进制文件，用于性能测试时重现用户的操作过程
+*   只能在UI线程中使用
+*/
+class UILIB_API InputRecorder_SDL
+{
+public:
+    InputRecorder_SDL();
+    ~InputRecorder_SDL();
+    InputRecorder_SDL(const InputRecorder_SDL&) = delete;
+    InputRecorder_SDL& operator = (const InputRecorder_SDL&) = delete;
+
+public:
+    /** 开始记录（清除已有的记录），消息循环派发的输入事件都会被记录
+    */
+    void StartRecording();
+
+    /** 停止记录
+    */
+    void StopRecording();
+
+    /** 是否正在记录
+    */
+    bool IsRecording() const;
+
+    /** 记录一个事件（由消息循环调用，非输入事件会被忽略）
+    */
+    void RecordEvent(const SDL_Event& sdlEvent);
+
+    /** 获取记录的事件
+    */
+    const std::vector<InputRecordEvent>& GetEvents() const;
+
+    /** 保存到文件
+    * @param [in] filePath 文件路径
+    */
+    bool SaveToFile(const FilePath& filePath) const;
+
+    /** 从文件中读取事件
+    * @param [in] filePath 文件路径
+    * @param [out] events 返回读取的事件
+    */
+    static bool LoadFromFile(const FilePath& filePath, std::vector<InputRecordEvent>& events);
+
+    /** 是否为需要记录的事件类型
+    */
+    static bool IsRecordableEvent(uint32_t nEventType);
+
+private:
+    /** 是否正在记录
+    */
+    bool m_bRecording;
+
+    /** 第一个事件的时间（SDL的事件时间，纳秒）
+    */
+    uint64_t m_nStartTimestamp;
+
+    /** 记录的事件
+    */
+    std::vector<InputRecordEvent> m_events;
+};
+
+/** 输入事件的回放器：按记录的时间顺序，将事件放入消息队列，由消息循环派发到目标窗口
+*   1. 回放的时间由调用方驱动（调用ReplayUntil），可按原始速度（使用实际经过的时间）或者加速回放（每帧前进固定的时间）
+*   2. 记录中的窗口ID需要映射到回放时的窗口，没有映射的窗口的事件不回放
+*   3. 窗口大小变化事件，通过修改目标窗口的大小来回放
+*   4. 只能在UI线程中使用
+*/
+class UILIB_API InputReplayer_SDL
+{
+public:
+    InputReplayer_SDL();
+    ~InputReplayer_SDL();
+    InputReplayer_SDL(const InputReplayer_SDL&) = delete;
+    InputReplayer_SDL& operator = (const InputReplayer_SDL&) = delete;
+
+public:
+    /** 从文件中读取需要回放的事件
+    * @param [in] filePath 文件路径
+    */
+    bool LoadFromFile(const FilePath& filePath);
+
+    /** 设置需要回放的事件
+    */
+    void SetEvents(const std::vector<InputRecordEvent>& events);
+
+    /** 设置回放的目标窗口：记录中第一个窗口的事件回放到该窗口
+    * @param [in] pWindow 目标窗口
+    */
+    void SetTargetWindow(Window* pWindow);
+
+    /** 将记录中指定窗口的事件回放到目标窗口
+    * @param [in] nRecordWindowId 记录时的窗口ID
+    * @param [in] pWindow 目标窗口
+    */
+    void MapWindow(uint32_t nRecordWindowId, Window* pWindow);
+
+    /** 回到起点，重新开始回放
+    */
+    void Restart();
+
+    /** 回放指定时间之前（含）的所有事件
+    * @param [in] nReplayTime 回放时间（纳秒，相对于记录的第一个事件）
+    * @return 返回本次回放的事件个数
+    */
+    size_t ReplayUntil(int64_t nReplayTime);
+
+    /** 是否已经回放完所有事件
+    */
+    bool IsFinished() const;
+
+    /** 获取记录的总时长（纳秒）
+    */
+    int64_t GetDuration() const;
+
+    /** 获取事件总数
+    */
+    size_t GetEventCount() const;
+
+private:
+    /** 回放一个事件
+    */
+    void ReplayEvent(const InputRecordEvent& recordEvent, uint32_t nWindowId);
+
+private:
+    /** 需要回放的事件
+    */
+    std::vector<InputRecordEvent> m_events;
+
+    /** 下一个需要回放的事件
+    */
+    size_t m_nNextIndex;
+
+    /** 窗口ID的映射表：记录时的窗口ID -> 回放时的窗口ID
+    */
+    std::unordered_map<uint32_t, uint32_t> m_windowIdMap;
+};
+
+} // namespace ui
+
+#endif // DUILIB_BUILD_FOR_SDL
+
+#endif // UI_CORE_INPUT_RECORDER_SDL_H_
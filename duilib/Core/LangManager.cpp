@@ -1,6 +1,5 @@
 #include "LangManager.h"
-#include "duilib/Utils/StringUtil.h"
-#include "duilib/Utils/StringConvert.h"
+#include "duilib/Core/CompiledLayout.h"
 #include "duilib/Utils/FileUtil.h"
 
 namespace ui 
@@ -11,119 +10,124 @@ LangManager::LangManager()
 
 LangManager::~LangManager()
 {
-    m_stringTable.clear();
+    m_spStringTable.reset();
 };
 
 bool LangManager::LoadStringTable(const FilePath& strFilePath)
 {
-    m_stringTable.clear();
+    m_spStringTable.reset();
+    m_spStringTable = CreateStringTable(strFilePath);
+    return m_spStringTable != nullptr;
+}
+
+bool LangManager::LoadStringTable(const std::vector<uint8_t>& fileData)
+{
+    std::unique_ptr<CompiledStringTable> spStringTable = CreateStringTable(fileData);
+    if (spStringTable == nullptr) {
+        return false;
+    }
+    m_spStringTable = std::move(spStringTable);
+    return true;
+}
+
+std::unique_ptr<CompiledStringTable> LangManager::CreateStringTable(const FilePath& strFilePath)
+{
+    //语言文件可以不存在（只发布预编译文件）
     std::vector<uint8_t> fileData;
     FileUtil::ReadFileData(strFilePath, fileData);
+
+    //1. 优先映射预编译的字符串表文件，与语言文件不一致时忽略
+    std::unique_ptr<CompiledStringTable> spStringTable = std::make_unique<CompiledStringTable>();
+    const FilePath compiledFilePath = GetCompiledFilePath(strFilePath);
+    if (compiledFilePath.IsExistsFile()) {
+        const uint64_t nSourceHash = CompiledLayout::HashSourceData(fileData.data(), fileData.size());
+        if (spStringTable->LoadFromFile(compiledFilePath, nSourceHash, fileData.size())) {
+            return spStringTable;
+        }
+    }
+
+    //2. 解析语言文件
     ASSERT(!fileData.empty());
     if (fileData.empty()) {
-        return false;
+        return nullptr;
     }
-    return LoadStringTable(fileData);
+    return CreateStringTable(fileData);
 }
 
-bool LangManager::LoadStringTable(const std::vector<uint8_t>& fileData)
+std::unique_ptr<CompiledStringTable> LangManager::CreateStringTable(const std::vector<uint8_t>& fileData)
 {
-    std::vector<DString> string_list;
-    if (fileData.empty()) {
-        return false;
+    return CreateStringTable(fileData.data(), fileData.size());
+}
+
+std::unique_ptr<CompiledStringTable> LangManager::CreateStringTable(const uint8_t* pData, size_t nDataSize)
+{
+    if ((pData == nullptr) || (nDataSize == 0)) {
+        return nullptr;
     }
-    size_t bomSize = 0;
-    if ((fileData.size() >= 3)   &&
-        (fileData.at(0) == 0xEF) &&
-        (fileData.at(1) == 0xBB) &&
-        (fileData.at(2) == 0xBF) ) {
-        //跳过UTF8的BOM头
-        bomSize = 3;
+    std::unique_ptr<CompiledStringTable> spStringTable = std::make_unique<CompiledStringTable>();
+    bool bRet = false;
+    if (CompiledStringTable::IsCompiledData(pData, nDataSize)) {
+        bRet = spStringTable->LoadFromData(pData, nDataSize, 0, 0);
     }
-    std::string fragment((const char*)fileData.data() + bomSize, fileData.size() - bomSize);
-    StringUtil::ReplaceAll("\r\n", "\n", fragment);
-    StringUtil::ReplaceAll("\r", "\n", fragment);
-    fragment.append("\n");
-    std::string src;
-    DString string_resourse;
-    for (const auto& it : fragment)    {
-        if (it == '\0' || it == '\n') {
-            if (!src.empty()) {
-                string_resourse.clear();
-                string_resourse = StringConvert::UTF8ToT(src);
-                string_resourse = StringUtil::Trim(string_resourse);
-                if (!string_resourse.empty()) {
-                    string_list.push_back(string_resourse);
-                }
-                src.clear();
-            }
-            continue;
-        }
-        src.push_back(it);
+    else {
+        bRet = spStringTable->CompileText(pData, nDataSize);
     }
-    AnalyzeStringTable(string_list);
-    return true;
+    if (!bRet) {
+        return nullptr;
+    }
+    return spStringTable;
+}
+
+void LangManager::SetStringTable(std::unique_ptr<CompiledStringTable> spStringTable)
+{
+    m_spStringTable = std::move(spStringTable);
 }
 
 void LangManager::ClearStringTable()
 {
-    m_stringTable.clear();
+    m_spStringTable.reset();
 }
 
-bool LangManager::AnalyzeStringTable(const std::vector<DString>& list)
+FilePath LangManager::GetCompiledFilePath(const FilePath& filePath)
 {
-    int    nCount = (int)list.size();
-    if (nCount <= 0) {
+    return FilePath(filePath.NativePath() + _T("c"));
+}
+
+bool LangManager::CompileStringTableFile(const FilePath& filePath, const FilePath& outFilePath)
+{
+    std::vector<uint8_t> fileData;
+    if (!FileUtil::ReadFileData(filePath, fileData) || fileData.empty()) {
         return false;
     }
-    DString id;
-    DString strResource;
-    for (int i = 0; i < nCount; ++i) {
-        const DString& strSrc = list[i];
-        if (strSrc.empty() || strSrc.at(0) == _T(';')) {
-            //注释以";"开头
-            continue;
-        }
-        size_t pos = strSrc.find(_T('='));
-        if (pos == DString::npos) {
-            //无分隔符，忽略
-            continue;
-        }
-
-        id = strSrc.substr(0, pos);
-        if (!id.empty()) {
-            id = StringUtil::Trim(id);
-        }
-        if ((pos + 1) < strSrc.size()) {
-            strResource = strSrc.substr(pos + 1);
-            strResource = StringUtil::Trim(strResource);
-            //将\n和\r替换为真实的换行符、回车符
-            StringUtil::ReplaceAll(_T("\\r"), _T("\r"), strResource);
-            StringUtil::ReplaceAll(_T("\\n"), _T("\n"), strResource);
-        }
-        else {
-            strResource.clear();
-        }
-        if (!id.empty()) {
-            m_stringTable[id] = strResource;
-        }
+    CompiledStringTable stringTable;
+    if (!stringTable.CompileText(fileData.data(), fileData.size())) {
+        return false;
     }
-    return true;
+    std::vector<uint8_t> compiledData;
+    if (!stringTable.SaveToData(compiledData)) {
+        return false;
+    }
+    FilePath compiledFilePath = outFilePath;
+    if (compiledFilePath.IsEmpty()) {
+        compiledFilePath = GetCompiledFilePath(filePath);
+    }
+    return FileUtil::WriteFileData(compiledFilePath, compiledData);
 }
 
 DString LangManager::GetStringViaID(const DString& id)
 {
-    DString text;
+    return DString(GetStringViewViaID(id));
+}
+
+DStringView LangManager::GetStringViewViaID(DStringView id) const
+{
+    DStringView text;
     if (id.empty()) {
         return text;
     }
-    auto it = m_stringTable.find(id);
-    if (it == m_stringTable.end()) {
+    if ((m_spStringTable == nullptr) || !m_spStringTable->Find(id, text)) {
         ASSERT(!"MultiLang::GetStringViaID failed!");
-        return text;
-    }
-    else {
-        text = it->second;
+        return DStringView();
     }
     return text;
 }
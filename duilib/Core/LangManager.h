@@ -1,15 +1,18 @@
 #ifndef UI_CORE_MULTILANG_H_
 #define UI_CORE_MULTILANG_H_
 
-#include "duilib/Utils/FilePath.h"
+#include "duilib/Core/CompiledStringTable.h"
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <memory>
 
 namespace ui 
 {
 
 /** 多语言的支持
+*   语言文件加载后编译为紧凑的字符串表（CompiledStringTable），查询时不分配内存；
+*   如果语言文件同目录下存在预编译的字符串表文件（比如"zh_CN.txt"对应"zh_CN.txtc"，由CompileStringTableFile生成），
+*   并且与语言文件内容一致，则直接将预编译文件映射到内存使用，不再解析语言文件；不一致时自动使用语言文件
 */
 class UILIB_API LangManager
 {
@@ -26,14 +29,49 @@ public:
     bool LoadStringTable(const FilePath& strFilePath);
 
     /** 从内存中加载所有语言映射表
-     * @param[in] fileData 要加载的语言映射表的数据
+     * @param[in] fileData 要加载的语言映射表的数据（语言文件的内容，或者预编译的字符串表数据）
      */
     bool LoadStringTable(const std::vector<uint8_t>& fileData);
 
+    /** 从本地文件创建语言映射表，不修改当前的语言映射表（可在工作线程中调用）
+     * @param[in] strFilePath 语言文件的完整路径
+     * @return 失败返回nullptr
+     */
+    static std::unique_ptr<CompiledStringTable> CreateStringTable(const FilePath& strFilePath);
+
+    /** 从内存中创建语言映射表，不修改当前的语言映射表（可在工作线程中调用）
+     * @param[in] fileData 语言文件的内容，或者预编译的字符串表数据
+     * @return 失败返回nullptr
+     */
+    static std::unique_ptr<CompiledStringTable> CreateStringTable(const std::vector<uint8_t>& fileData);
+
+    /** 从内存中创建语言映射表，不修改当前的语言映射表（可在工作线程中调用）
+     * @param[in] pData 语言文件的内容，或者预编译的字符串表数据（数据被复制，返回后可释放）
+     * @param[in] nDataSize 数据的长度
+     * @return 失败返回nullptr
+     */
+    static std::unique_ptr<CompiledStringTable> CreateStringTable(const uint8_t* pData, size_t nDataSize);
+
+    /** 替换当前的语言映射表（与CreateStringTable配合使用），原来的映射表被释放
+     * @param[in] spStringTable 新的语言映射表
+     */
+    void SetStringTable(std::unique_ptr<CompiledStringTable> spStringTable);
+
     /** 清理多语言资源
     */
     void ClearStringTable();
 
+    /** 离线编译语言文件，生成预编译的字符串表文件（可在发布资源前，对所有语言文件执行一次）
+    * @param [in] filePath 语言文件的完整路径
+    * @param [in] outFilePath 预编译文件的完整路径，如果为空，则保存在语言文件同目录（语言文件路径 + "c"）
+    * @return 编译成功返回true，否则返回false
+    */
+    static bool CompileStringTableFile(const FilePath& filePath, const FilePath& outFilePath = FilePath());
+
+    /** 获取语言文件对应的预编译文件路径（语言文件路径 + "c"）
+    */
+    static FilePath GetCompiledFilePath(const FilePath& filePath);
+
 public:
     /** 根据ID获取指定语言的字符串
      * @param[in] id 指定字符串 ID
@@ -41,16 +79,16 @@ public:
      */
     DString GetStringViaID(const DString& id);
 
-private:
-    /** 分析语言映射表内容
-     * @param[in] list 读取出来的映射表内容列表
+    /** 根据ID获取指定语言的字符串（不分配内存）
+     * @param[in] id 指定字符串 ID
+     * @return 返回 ID 对应的语言字符串，在语言映射表替换或者清理前有效，不能长期保存
      */
-    bool AnalyzeStringTable(const std::vector<DString>& list);
+    DStringView GetStringViewViaID(DStringView id) const;
 
 private:
-    /** 字符串的ID和取值映射表
+    /** 当前的语言映射表
     */
-    std::unordered_map<DString, DString> m_stringTable;
+    std::unique_ptr<CompiledStringTable> m_spStringTable;
 };
 
 }
@@ -4,11 +4,13 @@
 #if defined(DUILIB_BUILD_FOR_SDL)
 
 #include "NativeWindow_SDL.h"
+#include "InputRecorder_SDL.h"
 #include <SDL3/SDL.h>
 
 namespace ui
 {
 std::unordered_map<uint32_t, SDLUserMessageCallback> MessageLoop_SDL::s_userMsgCallbacks;
+InputRecorder_SDL* MessageLoop_SDL::s_pInputRecorder = nullptr;
 
 MessageLoop_SDL::MessageLoop_SDL()
 {
@@ -67,6 +69,8 @@ int32_t MessageLoop_SDL::Run()
                 break;
             default:
                 {
+                    //记录输入事件（性能测试）
+                    RecordInputEvent(sdlEvent);
                     //将事件派发到窗口
                     NativeWindow_SDL* pWindow = nullptr;
                     SDL_WindowID windowID = NativeWindow_SDL::GetWindowIdFromEvent(sdlEvent);
@@ -74,7 +78,9 @@ int32_t MessageLoop_SDL::Run()
                         pWindow = NativeWindow_SDL::GetWindowFromID(windowID);
                     }
                     if (pWindow != nullptr) {
-                        pWindow->OnSDLWindowEvent(sdlEvent);
+                        if (!IsCoalescedMouseMotion(sdlEvent, *pWindow)) {
+                            pWindow->OnSDLWindowEvent(sdlEvent);
+                        }
                     }
                     else {
                         //其他消息，除了注册的自定义消息，不处理
@@ -122,6 +128,8 @@ void MessageLoop_SDL::RunDoModal(NativeWindow_SDL& nativeWindow, bool bCloseByEs
                 break;
             default:
                 {
+                    //记录输入事件（性能测试）
+                    RecordInputEvent(sdlEvent);
                     //将事件派发到窗口
                     NativeWindow_SDL* pWindow = nullptr;
                     const SDL_WindowID windowID = NativeWindow_SDL::GetWindowIdFromEvent(sdlEvent);
@@ -129,7 +137,9 @@ void MessageLoop_SDL::RunDoModal(NativeWindow_SDL& nativeWindow, bool bCloseByEs
                         pWindow = NativeWindow_SDL::GetWindowFromID(windowID);
                     }
                     if (pWindow != nullptr) {
-                        pWindow->OnSDLWindowEvent(sdlEvent);
+                        if (!IsCoalescedMouseMotion(sdlEvent, *pWindow)) {
+                            pWindow->OnSDLWindowEvent(sdlEvent);
+                        }
                     }
                     else {
                         //其他消息，除了注册的自定义消息，不处理
@@ -188,6 +198,8 @@ void MessageLoop_SDL::RunUserLoop(bool& bTerminate)
                 break;
             default:
                 {
+                    //记录输入事件（性能测试）
+                    RecordInputEvent(sdlEvent);
                     //将事件派发到窗口
                     NativeWindow_SDL* pWindow = nullptr;
                     const SDL_WindowID windowID = NativeWindow_SDL::GetWindowIdFromEvent(sdlEvent);
@@ -195,7 +207,9 @@ void MessageLoop_SDL::RunUserLoop(bool& bTerminate)
                         pWindow = NativeWindow_SDL::GetWindowFromID(windowID);
                     }
                     if (pWindow != nullptr) {
-                        pWindow->OnSDLWindowEvent(sdlEvent);
+                        if (!IsCoalescedMouseMotion(sdlEvent, *pWindow)) {
+                            pWindow->OnSDLWindowEvent(sdlEvent);
+                        }
                     }
                     else {
                         //其他消息，除了注册的自定义消息，不处理
@@ -216,6 +230,40 @@ void MessageLoop_SDL::RunUserLoop(bool& bTerminate)
     }
 }
 
+bool MessageLoop_SDL::RunPendingEvents()
+{
+    bool bKeepGoing = true;
+    SDL_Event sdlEvent;
+    memset(&sdlEvent, 0, sizeof(sdlEvent));
+    while (SDL_PollEvent(&sdlEvent)) {
+        if (sdlEvent.type == SDL_EVENT_QUIT) {
+            bKeepGoing = false;
+            continue;
+        }
+        //记录输入事件（性能测试）
+        RecordInputEvent(sdlEvent);
+        //将事件派发到窗口
+        NativeWindow_SDL* pWindow = nullptr;
+        const SDL_WindowID windowID = NativeWindow_SDL::GetWindowIdFromEvent(sdlEvent);
+        if (windowID != 0) {
+            pWindow = NativeWindow_SDL::GetWindowFromID(windowID);
+        }
+        if (pWindow != nullptr) {
+            if (!IsCoalescedMouseMotion(sdlEvent, *pWindow)) {
+                pWindow->OnSDLWindowEvent(sdlEvent);
+            }
+        }
+        else {
+            //其他消息，除了注册的自定义消息，不处理
+            if ((sdlEvent.type > SDL_EVENT_USER) && (sdlEvent.type < SDL_EVENT_LAST)) {
+                //用户自定义消息
+                OnUserEvent(sdlEvent);
+            }
+        }
+    }
+    return bKeepGoing;
+}
+
 void MessageLoop_SDL::RemoveDuplicateMsg(uint32_t msgId)
 {
     SDL_FlushEvent(msgId);
@@ -242,6 +290,20 @@ bool MessageLoop_SDL::PostUserEvent(uint32_t msgId, WPARAM wParam, LPARAM lParam
     return nRet;
 }
 
+bool MessageLoop_SDL::HasPendingInputEvent()
+{
+    //键盘、文本输入、鼠标等输入事件
+    if (SDL_HasEvents(SDL_EVENT_KEY_DOWN, SDL_EVENT_MOUSE_REMOVED)) {
+        return true;
+    }
+    //窗口事件（包括SDL_EVENT_WINDOW_EXPOSED等）
+    if (SDL_HasEvents(SDL_EVENT_WINDOW_FIRST, SDL_EVENT_WINDOW_LAST)) {
+        return true;
+    }
+    //窗口绘制消息: duilib\Core\NativeWindow_SDL.cpp WM_USER_PAINT_MSG
+    return SDL_HasEvent(SDL_EVENT_USER + 3);
+}
+
 void MessageLoop_SDL::PostNoneEvent()
 {
     SDL_Event sdlEvent;
@@ -279,6 +341,38 @@ void MessageLoop_SDL::RemoveUserMessageCallback(uint32_t msgId)
     }
 }
 
+void MessageLoop_SDL::SetInputRecorder(InputRecorder_SDL* pInputRecorder)
+{
+    s_pInputRecorder = pInputRecorder;
+}
+
+void MessageLoop_SDL::RecordInputEvent(const SDL_Event& sdlEvent)
+{
+    if (s_pInputRecorder != nullptr) {
+        s_pInputRecorder->RecordEvent(sdlEvent);
+    }
+}
+
+bool MessageLoop_SDL::IsCoalescedMouseMotion(const SDL_Event& sdlEvent, const NativeWindow_SDL& nativeWindow)
+{
+    if ((sdlEvent.type != SDL_EVENT_MOUSE_MOTION) || !nativeWindow.IsMouseMoveCoalescing()) {
+        return false;
+    }
+    if ((sdlEvent.motion.state != 0) && nativeWindow.IsKeepDragMouseMoves()) {
+        //拖动时保留每一个鼠标移动消息
+        return false;
+    }
+    //只有紧随其后的消息也是本窗口的鼠标移动消息时，才跳过当前消息，不改变与其他消息之间的先后顺序
+    SDL_Event nextEvent;
+    if (SDL_PeepEvents(&nextEvent, 1, SDL_PEEKEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST) != 1) {
+        return false;
+    }
+    return (nextEvent.type == SDL_EVENT_MOUSE_MOTION) &&
+           (nextEvent.motion.windowID == sdlEvent.motion.windowID) &&
+           (nextEvent.motion.which == sdlEvent.motion.which) &&
+           (nextEvent.motion.state == sdlEvent.motion.state);
+}
+
 void MessageLoop_SDL::OnUserEvent(const SDL_Event& sdlEvent)
 {
     if ((sdlEvent.type <= SDL_EVENT_USER) || (sdlEvent.type >= SDL_EVENT_LAST)) {
@@ -12,6 +12,7 @@ union SDL_Event;
 namespace ui {
 
 class NativeWindow_SDL;
+class InputRecorder_SDL;
 
 /** 自定义消息回调函数原型：void FunctionName(uint32_t msgID, WPARAM wParam, LPARAM lParam);
 */
@@ -44,6 +45,11 @@ public:
     */
     void RunUserLoop(bool& bTerminate);
 
+    /** 处理消息队列中所有等待处理的消息后立即返回（不等待新消息），用于无界面模式下由调用方驱动每一帧
+    * @return 如果收到了退出消息（SDL_EVENT_QUIT），返回false，否则返回true
+    */
+    static bool RunPendingEvents();
+
 public:
     /** 从消息队列里面移除多余的消息
     * @param [in] msgId 消息ID
@@ -68,6 +74,10 @@ public:
     */
     static void RemoveUserMessageCallback(uint32_t msgId);
 
+    /** 消息队列中是否有等待处理的输入事件（鼠标、键盘）或者窗口绘制事件
+    */
+    static bool HasPendingInputEvent();
+
     /** 向队列中放入一个空消息, 返回到等待队列的处理函数
     */
     static void PostNoneEvent();
@@ -76,10 +86,24 @@ public:
     * @param [in] videoDriverName 显示驱动的名称, 有效值是：
       Windows平台："windows"
       Linux平台："X11" 或者 "wayland" 或者 "wayland,X11" 或者 "X11,wayland"
+      无界面模式（各平台通用）："offscreen"（窗口不可见，绘制到内存中的窗口表面，用于性能测试等场景）
     */
     static bool CheckInitSDL(const DString& videoDriverName = _T(""));
 
+    /** 设置输入事件记录器（用于性能测试时记录用户的操作过程），消息循环派发的事件会先交给记录器记录
+    * @param [in] pInputRecorder 输入事件记录器，为nullptr表示取消记录
+    */
+    static void SetInputRecorder(InputRecorder_SDL* pInputRecorder);
+
 private:
+    /** 记录输入事件
+    */
+    static void RecordInputEvent(const SDL_Event& sdlEvent);
+
+    /** 判断鼠标移动消息是否可以被合并（跳过当前消息，只处理消息队列中紧随其后的鼠标移动消息）
+    */
+    static bool IsCoalescedMouseMotion(const SDL_Event& sdlEvent, const NativeWindow_SDL& nativeWindow);
+
     /** 处理用户自定义消息
     */
     static void OnUserEvent(const SDL_Event& sdlEvent);
@@ -88,6 +112,10 @@ private:
     /** 自定义消息映射
     */
     static std::unordered_map<uint32_t, SDLUserMessageCallback> s_userMsgCallbacks;
+
+    /** 输入事件记录器
+    */
+    static InputRecorder_SDL* s_pInputRecorder;
 };
 
 } // namespace ui
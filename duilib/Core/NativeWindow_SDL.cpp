@@ -506,7 +506,9 @@ NativeWindow_SDL::NativeWindow_SDL(INativeWindow* pOwner):
     m_bFakeModal(false),
     m_bDoModal(false),
     m_bFullScreen(false),
-    m_ptLastMousePos(-1, -1)
+    m_ptLastMousePos(-1, -1),
+    m_bMouseMoveCoalescing(true),
+    m_bKeepDragMouseMoves(false)
 {
     ASSERT(m_pOwner != nullptr);    
 }
@@ -1277,6 +1279,22 @@ DString NativeWindow_SDL::GetVideoDriverName() const
     return driverName;
 }
 
+void NativeWindow_SDL::SetMouseMoveCoalescing(bool bCoalesce, bool bKeepDragMoves)
+{
+    m_bMouseMoveCoalescing = bCoalesce;
+    m_bKeepDragMouseMoves = bKeepDragMoves;
+}
+
+bool NativeWindow_SDL::IsMouseMoveCoalescing() const
+{
+    return m_bMouseMoveCoalescing;
+}
+
+bool NativeWindow_SDL::IsKeepDragMouseMoves() const
+{
+    return m_bKeepDragMouseMoves;
+}
+
 DString NativeWindow_SDL::GetWindowRenderName() const
 {
     DString renderName;
@@ -2069,7 +2087,8 @@ void NativeWindow_SDL::Invalidate(const UiRect& rcItem)
 
 void NativeWindow_SDL::PaintWindow(bool bPaintAll)
 {
-    PerformanceStat statPerformance(_T("PaintWindow, NativeWindow_SDL::PaintWindow(Total)"));
+    static const PerformanceStatId s_statId(_T("PaintWindow, NativeWindow_SDL::PaintWindow(Total)"));
+    PerformanceStat statPerformance(s_statId);
     if (bPaintAll) {
         //绘制全部
         m_rcUpdateRect.Clear();
@@ -84,6 +84,20 @@ public:
     */
     DString GetWindowRenderName() const;
 
+    /** 设置是否合并鼠标移动消息
+    * @param [in] bCoalesce 是否合并：消息队列中本窗口连续的多个鼠标移动消息，只处理最后一个
+    * @param [in] bKeepDragMoves 按下鼠标拖动时，是否保留每一个鼠标移动消息（比如需要完整拖动轨迹的绘图功能）
+    */
+    void SetMouseMoveCoalescing(bool bCoalesce, bool bKeepDragMoves);
+
+    /** 是否合并鼠标移动消息
+    */
+    bool IsMouseMoveCoalescing() const;
+
+    /** 按下鼠标拖动时，是否保留每一个鼠标移动消息
+    */
+    bool IsKeepDragMouseMoves() const;
+
     /** 是否含有有效的窗口句柄
     */
     bool IsWindow() const;
@@ -663,6 +677,14 @@ private:
     /** 窗口更新的区域（需要绘制）
     */
     UiRect m_rcUpdateRect;
+
+    /** 是否合并鼠标移动消息
+    */
+    bool m_bMouseMoveCoalescing;
+
+    /** 按下鼠标拖动时，是否保留每一个鼠标移动消息
+    */
+    bool m_bKeepDragMouseMoves;
 };
 
 /** 定义别名
@@ -15,12 +15,13 @@ PlaceHolder::PlaceHolder(Window* pWindow) :
     m_pParent(nullptr),
     m_horAlignType(kHorAlignLeft),
     m_verAlignType(kVerAlignTop),
+    m_cacheMode(ControlCacheMode::kCacheModeAuto),
+    m_bEnableControlPadding(true),
     m_bFloat(false),
-    m_bVisible(true),
     m_bIsArranged(true),
     m_bUseCache(false),
     m_bCacheDirty(true),
-    m_bEnableControlPadding(true),
+    m_bVisible(true),
     m_bInited(false)
 {
     //控件的高度和宽度值，默认设置为拉伸
@@ -51,17 +52,22 @@ std::string PlaceHolder::GetUTF8Name() const
 
 DString PlaceHolder::GetName() const
 { 
-    return m_sName.c_str();
+    return m_sName.GetString();
+}
+
+const UiAtom& PlaceHolder::GetNameAtom() const
+{
+    return m_sName;
 }
 
 bool PlaceHolder::IsNameEquals(const DString& name) const
 {
-    return StringUtil::StringCompare(m_sName.c_str(), name.c_str()) == 0;
+    return m_sName.GetString() == name;
 }
 
 void PlaceHolder::SetName(const DString& strName)
 {
-    m_sName = strName;
+    m_sName = AtomTable::AddAtom(strName);
 }
 
 void PlaceHolder::SetUTF8Name(const std::string& strName)
@@ -483,6 +489,14 @@ void PlaceHolder::SetUseCache(bool cache)
     m_bUseCache = cache;
 }
 
+void PlaceHolder::SetCacheMode(ControlCacheMode cacheMode)
+{
+    if (m_cacheMode != cacheMode) {
+        m_cacheMode = cacheMode;
+        SetCacheDirty(true);
+    }
+}
+
 void PlaceHolder::SetCacheDirty(bool dirty)
 {
     m_bCacheDirty = dirty;
@@ -45,6 +45,10 @@ public:
      */
     void SetUTF8Name(const std::string& strName);
 
+    /** 获取控件名称对应的原子（控件名称存储在全局原子表中，可用于快速比较）
+     */
+    const UiAtom& GetNameAtom() const;
+
     /** 判断控件名称是否相等
     */
     bool IsNameEquals(const DString& name) const;
@@ -316,7 +320,15 @@ public:
 
     /** 判断是否使用缓存
      */
-    bool IsUseCache() { return m_bUseCache; }
+    bool IsUseCache() const { return m_bUseCache; }
+
+    /** 设置绘制缓存的类型
+     */
+    void SetCacheMode(ControlCacheMode cacheMode);
+
+    /** 获取绘制缓存的类型
+     */
+    ControlCacheMode GetCacheMode() const { return m_cacheMode; }
 
     /** 设置缓存脏标志位
      */
@@ -349,8 +361,8 @@ protected:
     virtual void OnInit();
 
 private:
-    //控件名称，用于查找控件等操作
-    UiString m_sName;
+    //控件名称，用于查找控件等操作（存储在全局原子表中，相同的名称只存储一份）
+    UiAtom m_sName;
 
     //关联的窗口对象
     Window* m_pWindow;
@@ -385,31 +397,34 @@ private:
     //内边距四边的大小（上，下，左，右边距），内边距是控件矩形以内的空间，是包含在控件矩形以内的
     UiPadding16 m_rcPadding;
 
+    //绘制缓存的类型
+    ControlCacheMode m_cacheMode;
+
     //是否允许控件本身设置内边距
     //(原来的逻辑：Control自身无内边距，Box的Layout有内边距，所以Box自身的背景图片等是不应用内边距的，只有子控件应用内边距)
     //此开关默认为true，提供关闭选项是为了兼容原来的逻辑，比如阴影的实现，就不能开启内边距，否则阴影绘制异常
-    bool m_bEnableControlPadding;
+    bool m_bEnableControlPadding : 1;
 
     //控件是否为浮动属性
-    bool m_bFloat;
+    bool m_bFloat : 1;
 
     //是否需要布局重排
-    bool m_bIsArranged;
+    bool m_bIsArranged : 1;
 
     //是否使用绘制缓存
     // 如果为true，每个控件自己保存一份绘制缓存，会占用较多内存，理论上会提升绘制性能，但实际未测试出效果）
     // 如果为false，表示无绘制缓存，内存占用比较少。
     // TODO: 这个模式下内存占有率很高，对绘制性能提升不明显，未来可能会删除掉这个逻辑，以简化代码。
-    bool m_bUseCache;
+    bool m_bUseCache : 1;
 
     //缓存是否存在脏标志值
-    bool m_bCacheDirty;
+    bool m_bCacheDirty : 1;
 
     //是否可见
-    bool m_bVisible;
+    bool m_bVisible : 1;
 
     //是否已经完成初始化
-    bool m_bInited;
+    bool m_bInited : 1;
 };
 
 } // namespace ui
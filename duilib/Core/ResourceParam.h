@@ -2,6 +2,7 @@
 #define UI_CORE_RESOURCE_PARAM_H_
 
 #include "duilib/Utils/FilePath.h"
+#include <vector>
 
 namespace ui 
 {
@@ -77,6 +78,17 @@ public:
     /** 全局资源描述XML文件的文件名，默认为："global.xml"
     */
     DString globalXmlFileName = _T("global.xml");
+
+    /** 预加载的布局XML文件列表（可选参数，相对于主题路径），比如第一个窗口的布局文件
+    *   路径应与窗口的GetSkinFolder()和GetSkinFile()拼接后的路径一致，比如：_T("basic\\basic.xml")
+    *   加载资源时，在工作线程中与其他资源并行解析，创建窗口时直接使用解析结果
+    */
+    std::vector<FilePath> prefetchXmlFiles;
+
+    /** 预加载的图片文件列表（可选参数，相对于主题路径），比如第一个窗口用到的图片：_T("basic\\logo.png")
+    *   加载资源时，在工作线程中与其他资源并行解码，加载后一直保留在缓存中（见ImageManager::ReleasePrefetchImages）
+    */
+    std::vector<FilePath> prefetchImageFiles;
 };
 
 /** 加载全局资源所需的参数（本地文件形式，对应资源类型：kLocalFiles）
@@ -73,7 +73,7 @@ public:
      * @brief 判断是否有效
      * @return true 为有效，否则为 false
      */
-    bool IsValid() { return GetScrollRange() != 0; }
+    bool IsValid() const { return GetScrollRange() != 0; }
 
     /**
      * @brief 获取滚动条位置
@@ -0,0 +1,192 @@
+#include "StartupPipeline.h"
+#include "duilib/Utils/ParallelTaskRunner.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include <thread>
+
+namespace ui
+{
+
+StartupPipeline::StartupPipeline():
+    m_nDoneCount(0),
+    m_nRunningWorkers(0)
+{
+}
+
+StartupPipeline::~StartupPipeline()
+{
+}
+
+int32_t StartupPipeline::FindStage(const DString& name) const
+{
+    for (size_t nIndex = 0; nIndex < m_trace.size(); ++nIndex) {
+        if (m_trace[nIndex].m_name == name) {
+            return (int32_t)nIndex;
+        }
+    }
+    return -1;
+}
+
+bool StartupPipeline::AddStage(const DString& name,
+                               const std::vector<DString>& dependencies,
+                               bool bUiThread,
+                               const StageFunction& stageFunction)
+{
+    ASSERT(!name.empty() && (FindStage(name) < 0));
+    if (name.empty() || (FindStage(name) >= 0)) {
+        return false;
+    }
+    StartupStage stage;
+    for (const DString& dependency : dependencies) {
+        int32_t nDependency = FindStage(dependency);
+        ASSERT(nDependency >= 0);
+        if (nDependency < 0) {
+            return false;
+        }
+        stage.m_dependencies.push_back((size_t)nDependency);
+    }
+    stage.m_bUiThread = bUiThread;
+    stage.m_stageFunction = stageFunction;
+    m_stages.push_back(std::move(stage));
+
+    StartupStageTrace trace;
+    trace.m_name = name;
+    trace.m_bUiThread = bUiThread;
+    m_trace.push_back(trace);
+    return true;
+}
+
+bool StartupPipeline::Run()
+{
+    const int64_t nRunStartTime = PerformanceUtil::GetTimestamp();
+
+    //同时执行的工作线程阶段数（单核机器上，所有阶段都在UI线程中执行）
+    const size_t nMaxWorkers = ParallelTaskRunner::Instance().GetConcurrency() - 1;
+
+    //阶段的数量很少，每个工作线程阶段使用一个独立的线程执行（阶段内部仍可使用ParallelTaskRunner）
+    std::vector<std::thread> workerThreads;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_nDoneCount = 0;
+    m_nRunningWorkers = 0;
+    while (true) {
+        //启动所有可以执行的工作线程阶段，并找到第一个可以执行的UI线程阶段
+        size_t nUnfinished = 0;
+        int32_t nReadyUiStage = -1;
+        for (size_t nIndex = 0; nIndex < m_stages.size(); ++nIndex) {
+            StartupStage& stage = m_stages[nIndex];
+            if (stage.m_state == StageState::kRunning) {
+                ++nUnfinished;
+                continue;
+            }
+            if (stage.m_state != StageState::kPending) {
+                continue;
+            }
+            bool bReady = true;
+            bool bSkip = false;
+            for (size_t nDependency : stage.m_dependencies) {
+                const StageState state = m_stages[nDependency].m_state;
+                if ((state == StageState::kFailed) || (state == StageState::kSkipped)) {
+                    bSkip = true;
+                    break;
+                }
+                if (state != StageState::kSucceeded) {
+                    bReady = false;
+                }
+            }
+            if (bSkip) {
+                //依赖的阶段先于本阶段添加，所以一次遍历即可将跳过状态传递下去
+                stage.m_state = StageState::kSkipped;
+                m_trace[nIndex].m_bSkipped = true;
+                ++m_nDoneCount;
+                continue;
+            }
+            ++nUnfinished;
+            if (!bReady) {
+                continue;
+            }
+            if (stage.m_bUiThread || (nMaxWorkers == 0)) {
+                if (nReadyUiStage < 0) {
+                    nReadyUiStage = (int32_t)nIndex;
+                }
+            }
+            else if (m_nRunningWorkers < nMaxWorkers) {
+                stage.m_state = StageState::kRunning;
+                ++m_nRunningWorkers;
+                workerThreads.emplace_back([this, nIndex, nRunStartTime]() {
+                        RunStage(nIndex, nRunStartTime, true);
+                    });
+            }
+        }
+        if (nUnfinished == 0) {
+            break;
+        }
+        if (nReadyUiStage >= 0) {
+            //在UI线程中执行，执行期间工作线程阶段继续运行
+            m_stages[nReadyUiStage].m_state = StageState::kRunning;
+            lock.unlock();
+            RunStage((size_t)nReadyUiStage, nRunStartTime, false);
+            lock.lock();
+            continue;
+        }
+        //没有可以在UI线程中执行的阶段，等待工作线程阶段完成
+        const size_t nDoneCount = m_nDoneCount;
+        m_stageDoneCv.wait(lock, [this, nDoneCount]() {
+                return m_nDoneCount != nDoneCount;
+            });
+    }
+    lock.unlock();
+
+    for (std::thread& workerThread : workerThreads) {
+        if (workerThread.joinable()) {
+            workerThread.join();
+        }
+    }
+
+    bool bAllSucceeded = true;
+    for (const StartupStageTrace& trace : m_trace) {
+        if (!trace.m_bSucceeded) {
+            bAllSucceeded = false;
+            break;
+        }
+    }
+    return bAllSucceeded;
+}
+
+void StartupPipeline::RunStage(size_t nIndex, int64_t nRunStartTime, bool bWorkerThread)
+{
+    const int64_t nStartTime = PerformanceUtil::GetTimestamp();
+    bool bSucceeded = true;
+    const StageFunction& stageFunction = m_stages[nIndex].m_stageFunction;
+    if (stageFunction != nullptr) {
+        bSucceeded = stageFunction();
+    }
+    const int64_t nEndTime = PerformanceUtil::GetTimestamp();
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stages[nIndex].m_state = bSucceeded ? StageState::kSucceeded : StageState::kFailed;
+        StartupStageTrace& trace = m_trace[nIndex];
+        trace.m_bSucceeded = bSucceeded;
+        trace.m_nStartTime = nStartTime - nRunStartTime;
+        trace.m_nEndTime = nEndTime - nRunStartTime;
+        ++m_nDoneCount;
+        if (bWorkerThread) {
+            --m_nRunningWorkers;
+        }
+    }
+    m_stageDoneCv.notify_all();
+}
+
+bool StartupPipeline::IsStageSucceeded(const DString& name) const
+{
+    int32_t nIndex = FindStage(name);
+    if (nIndex < 0) {
+        return false;
+    }
+    return m_trace[nIndex].m_bSucceeded;
+}
+
+const std::vector<StartupStageTrace>& StartupPipeline::GetTrace() const
+{
+    return m_trace;
+}
+
+} // namespace ui
@@ -0,0 +1,130 @@
+#ifndef UI_CORE_STARTUP_PIPELINE_H_
+#define UI_CORE_STARTUP_PIPELINE_H_
+
+#include "duilib/duilib_defs.h"
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+namespace ui
+{
+/** 启动阶段的耗时记录
+*/
+struct StartupStageTrace
+{
+    DString m_name;             //阶段名称
+    bool m_bUiThread = false;   //是否在UI线程（调用Run的线程）中执行
+    bool m_bSucceeded = false;  //是否执行成功
+    bool m_bSkipped = false;    //是否因依赖的阶段失败而未执行
+    int64_t m_nStartTime = 0;   //开始执行的时间（微秒，相对于Run的开始时间）
+    int64_t m_nEndTime = 0;     //执行结束的时间（微秒，相对于Run的开始时间）
+};
+
+/** 启动流水线：由多个相互依赖的阶段组成，依赖的阶段全部成功后执行该阶段
+*   1. 工作线程阶段：在独立的线程中执行，相互独立的阶段并行执行（不能访问只允许在UI线程中访问的数据）
+*   2. UI线程阶段：在调用Run的线程中依次执行，与正在执行的工作线程阶段并行
+*   3. 如果某个阶段失败（返回false），所有直接或间接依赖它的阶段都不再执行
+*   4. 每个阶段的执行时间记录在耗时记录中，可通过GetTrace获取
+*/
+class UILIB_API StartupPipeline
+{
+public:
+    /** 阶段的执行函数，返回false表示失败
+    */
+    typedef std::function<bool()> StageFunction;
+
+    StartupPipeline();
+    ~StartupPipeline();
+    StartupPipeline(const StartupPipeline&) = delete;
+    StartupPipeline& operator = (const StartupPipeline&) = delete;
+
+public:
+    /** 添加一个阶段
+    * @param [in] name 阶段名称，不能重复
+    * @param [in] dependencies 依赖的阶段名称列表，这些阶段必须已经添加（因此不会出现循环依赖）
+    * @param [in] bUiThread true表示在UI线程（调用Run的线程）中执行，false表示在工作线程中执行
+    * @param [in] stageFunction 阶段的执行函数
+    * @return 成功返回true，如果名称重复或者依赖的阶段不存在，返回false
+    */
+    bool AddStage(const DString& name,
+                  const std::vector<DString>& dependencies,
+                  bool bUiThread,
+                  const StageFunction& stageFunction);
+
+    /** 执行所有阶段，所有阶段执行完成（或者被跳过）后返回
+    * @return 所有阶段都执行成功返回true，否则返回false
+    */
+    bool Run();
+
+    /** 判断某个阶段是否执行成功（需在Run之后调用）
+    * @param [in] name 阶段名称
+    */
+    bool IsStageSucceeded(const DString& name) const;
+
+    /** 获取各个阶段的耗时记录（按添加顺序，需在Run之后调用）
+    */
+    const std::vector<StartupStageTrace>& GetTrace() const;
+
+private:
+    /** 阶段的执行状态
+    */
+    enum class StageState
+    {
+        kPending,   //等待执行
+        kRunning,   //正在执行
+        kSucceeded, //执行成功
+        kFailed,    //执行失败
+        kSkipped    //依赖的阶段失败，未执行
+    };
+
+    /** 阶段的数据
+    */
+    struct StartupStage
+    {
+        std::vector<size_t> m_dependencies; //依赖的阶段（下标）
+        bool m_bUiThread = false;           //是否在UI线程中执行
+        StageFunction m_stageFunction;      //执行函数
+        StageState m_state = StageState::kPending; //执行状态（受m_mutex保护）
+    };
+
+    /** 查找阶段的下标，未找到返回-1
+    */
+    int32_t FindStage(const DString& name) const;
+
+    /** 执行一个阶段，并记录耗时（在UI线程或者工作线程中调用）
+    * @param [in] nIndex 阶段的下标
+    * @param [in] nRunStartTime Run的开始时间
+    * @param [in] bWorkerThread 是否在工作线程中执行
+    */
+    void RunStage(size_t nIndex, int64_t nRunStartTime, bool bWorkerThread);
+
+private:
+    /** 所有的阶段（按添加顺序）
+    */
+    std::vector<StartupStage> m_stages;
+
+    /** 各个阶段的耗时记录（与m_stages一一对应）
+    */
+    std::vector<StartupStageTrace> m_trace;
+
+    /** 保护执行状态
+    */
+    std::mutex m_mutex;
+
+    /** 通知UI线程有阶段执行完成
+    */
+    std::condition_variable m_stageDoneCv;
+
+    /** 已经执行完成的阶段数（受m_mutex保护）
+    */
+    size_t m_nDoneCount;
+
+    /** 正在执行的工作线程阶段数（受m_mutex保护）
+    */
+    size_t m_nRunningWorkers;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_STARTUP_PIPELINE_H_
@@ -43,6 +43,24 @@ DString StateColorMap::GetStateColor(ControlStateType stateType) const
     return DString();
 }
 
+UiColor StateColorMap::GetStateUiColor(ControlStateType stateType) const
+{
+    UiColor color;
+    auto iter = m_stateColorMap.find(stateType);
+    if ((iter != m_stateColorMap.end()) && !iter->second.empty()) {
+        if (m_pControl != nullptr) {
+            color = m_pControl->GetUiColor(iter->second);
+        }
+        else if (iter->second.IsDirectColor()) {
+            color = iter->second.GetDirectColor();
+        }
+        else {
+            color = GlobalManager::Instance().Color().GetColor(iter->second.c_str());
+        }
+    }
+    return color;
+}
+
 void StateColorMap::SetStateColor(ControlStateType stateType, const DString& color)
 {
     if (!color.empty()) {
@@ -64,16 +82,15 @@ void StateColorMap::PaintStateColor(IRender* pRender, const UiRect& rcPaint, Con
         return;
     }
     if (m_pControl != nullptr) {
-        bool bFadeHot = m_pControl->GetAnimationManager().GetAnimationPlayer(AnimationType::kAnimationHot) != nullptr;
+        bool bFadeHot = m_pControl->GetAnimationPlayer(AnimationType::kAnimationHot) != nullptr;
         int32_t nHotAlpha = m_pControl->GetHotAlpha();
         if (bFadeHot) {
             if ((stateType == kControlStateNormal || stateType == kControlStateHot) && HasStateColor(kControlStateHot)) {
-                DString strColor = GetStateColor(kControlStateNormal);
-                if (!strColor.empty()) {
-                    pRender->FillRect(rcPaint, m_pControl->GetUiColor(strColor));
+                if (HasStateColor(kControlStateNormal)) {
+                    pRender->FillRect(rcPaint, GetStateUiColor(kControlStateNormal));
                 }
                 if (nHotAlpha > 0) {
-                    pRender->FillRect(rcPaint, m_pControl->GetUiColor(GetStateColor(kControlStateHot)), static_cast<uint8_t>(nHotAlpha));
+                    pRender->FillRect(rcPaint, GetStateUiColor(kControlStateHot), static_cast<uint8_t>(nHotAlpha));
                 }
                 return;
             }
@@ -89,11 +106,8 @@ void StateColorMap::PaintStateColor(IRender* pRender, const UiRect& rcPaint, Con
     if (stateType == kControlStateDisabled && !HasStateColor(kControlStateDisabled)) {
         stateType = kControlStateNormal;
     }
-    DString strColor = GetStateColor(stateType);
-    if (!strColor.empty()) {
-        UiColor color = m_pControl ? m_pControl->GetUiColor(strColor) :
-                                     GlobalManager::Instance().Color().GetColor(strColor);
-        pRender->FillRect(rcPaint, color);
+    if (HasStateColor(stateType)) {
+        pRender->FillRect(rcPaint, GetStateUiColor(stateType));
     }
 }
 } // namespace ui
@@ -3,6 +3,7 @@
 
 #include "duilib/Render/IRender.h"
 #include "duilib/Core/UiTypes.h"
+#include "duilib/Core/UiColorToken.h"
 #include <map>
 
 namespace ui 
@@ -28,6 +29,10 @@ public:
     */
     void SetStateColor(ControlStateType stateType, const DString& color);
 
+    /** 获取指定状态的颜色值（使用预解析的颜色值，不做字符串查找），如果不包含此颜色，则返回空
+    */
+    UiColor GetStateUiColor(ControlStateType stateType) const;
+
     /** 是否包含Hot状态的颜色
     */
     bool HasHotColor() const;
@@ -51,7 +56,7 @@ private:
 
     /** 状态与颜色值的映射表
     */
-    std::map<ControlStateType, UiString> m_stateColorMap;
+    std::map<ControlStateType, UiColorToken> m_stateColorMap;
 };
 
 } // namespace ui
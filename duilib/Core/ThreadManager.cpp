@@ -73,6 +73,12 @@ bool ThreadManager::GetThreadInfo(int32_t nThreadIdentifier, ThreadInfo& threadI
     return !threadInfo.m_threadFlag.expired() && (threadInfo.m_pThread != nullptr);
 }
 
+bool ThreadManager::HasThread(int32_t nThreadIdentifier) const
+{
+    ThreadInfo threadInfo;
+    return GetThreadInfo(nThreadIdentifier, threadInfo);
+}
+
 bool ThreadManager::PostTask(int32_t nThreadIdentifier, const StdClosure& task)
 {
     ASSERT(task != nullptr);
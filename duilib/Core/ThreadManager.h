@@ -33,6 +33,11 @@ public:
     */
     int32_t GetCurrentThreadIdentifier() const;
 
+    /** 判断指定的线程是否已经注册（并且线程仍然有效）
+    * @param [in] nThreadIdentifier 线程标识ID
+    */
+    bool HasThread(int32_t nThreadIdentifier) const;
+
     /** 向线程发送一个任务，立即执行
     * @param [in] nThreadIdentifier 线程标识ID
     * @param [in] task 任务回调函数
@@ -39,11 +39,24 @@ public:
     */
     bool PostMsg(uint32_t msgId, WPARAM wParam, LPARAM lParam);
 
+    /** 发送一个消息，该消息排在当前等待处理的输入消息和绘制消息之后处理（用于让出时间片）
+    *   Windows平台：投递的消息优先于输入消息和WM_PAINT消息，所以使用定时器（WM_TIMER的优先级最低）实现
+    *   SDL：事件队列按先后顺序处理，与PostMsg相同
+    * @param [in] msgId 消息ID
+    * @param [in] wParam 消息的第1个参数
+    * @param [in] lParam 消息的第2个参数
+    */
+    bool PostMsgAfterInput(uint32_t msgId, WPARAM wParam, LPARAM lParam);
+
     /** 从消息队列里面移除多余的消息
     * @param [in] msgId 消息ID
     */
     void RemoveDuplicateMsg(uint32_t msgId);
 
+    /** 当前线程的消息队列中，是否有等待处理的输入消息（鼠标、键盘）或者绘制消息
+    */
+    bool HasPendingInputMsg() const;
+
     /** 清理资源
     */
     void Clear();
@@ -50,6 +50,12 @@ bool ThreadMessage::PostMsg(uint32_t msgId, WPARAM wParam, LPARAM lParam)
     return bRet;
 }
 
+bool ThreadMessage::PostMsgAfterInput(uint32_t msgId, WPARAM wParam, LPARAM lParam)
+{
+    //SDL的事件队列按先后顺序处理，新放入的事件排在已有的输入事件之后
+    return PostMsg(msgId, wParam, lParam);
+}
+
 void ThreadMessage::RemoveDuplicateMsg(uint32_t msgId)
 {
     //移除队列中多余的消息，避免队列中有大量无用的重复消息，导致无法处理鼠标键盘消息
@@ -59,6 +65,11 @@ void ThreadMessage::RemoveDuplicateMsg(uint32_t msgId)
     }
 }
 
+bool ThreadMessage::HasPendingInputMsg() const
+{
+    return MessageLoop_SDL::HasPendingInputEvent();
+}
+
 void ThreadMessage::SetMessageCallback(uint32_t msgId, const ThreadMessageCallback& callback)
 {
     if (m_impl->m_msgId != 0) {
@@ -27,10 +27,25 @@ public:
     /** 是否已经终止
     */
     bool m_bTerm = false;
+
+    /** PostMsgAfterInput使用的定时器ID，及定时器触发时的消息参数
+    */
+    static constexpr UINT_PTR kAfterInputTimerId = 1;
+    WPARAM m_afterInputWParam = 0;
+    LPARAM m_afterInputLParam = 0;
 };
 
 LRESULT ThreadMessage::TImpl::WndProcThunk(HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam)
 {
+    if ((message == WM_TIMER) && (wparam == kAfterInputTimerId)) {
+        //PostMsgAfterInput：定时器只触发一次
+        ::KillTimer(hwnd, kAfterInputTimerId);
+        ThreadMessage* pThis = reinterpret_cast<ThreadMessage*>(::GetWindowLongPtr(hwnd, GWLP_USERDATA));
+        if ((pThis != nullptr) && (pThis->m_impl->m_msgId != 0)) {
+            pThis->OnUserMessage(pThis->m_impl->m_msgId, pThis->m_impl->m_afterInputWParam, pThis->m_impl->m_afterInputLParam);
+        }
+        return 0;
+    }
     if (message > WM_USER) {
         ThreadMessage* pThis = reinterpret_cast<ThreadMessage*>(::GetWindowLongPtr(hwnd, GWLP_USERDATA));
         if (pThis != nullptr) {
@@ -90,6 +105,25 @@ bool ThreadMessage::PostMsg(uint32_t msgId, WPARAM wParam, LPARAM lParam)
     return bRet;
 }
 
+bool ThreadMessage::PostMsgAfterInput(uint32_t msgId, WPARAM wParam, LPARAM lParam)
+{
+    if (m_impl->m_bTerm) {
+        //已经终止
+        return false;
+    }
+    bool bRet = false;
+    ASSERT(msgId == m_impl->m_msgId);
+    ASSERT(m_impl->m_hMessageWnd != nullptr);
+    if ((m_impl->m_hMessageWnd != nullptr) && (msgId == m_impl->m_msgId)) {
+        //GetMessage按照：投递的消息、输入消息、WM_PAINT、WM_TIMER的顺序返回消息，
+        //定时器消息在输入和绘制消息都处理完成后才会返回（间隔为系统允许的最小值）
+        m_impl->m_afterInputWParam = wParam;
+        m_impl->m_afterInputLParam = lParam;
+        bRet = ::SetTimer(m_impl->m_hMessageWnd, TImpl::kAfterInputTimerId, USER_TIMER_MINIMUM, nullptr) != 0;
+    }
+    return bRet;
+}
+
 void ThreadMessage::RemoveDuplicateMsg(uint32_t msgId)
 {
     //移除队列中多余的消息，避免队列中有大量无用的重复消息，导致无法处理鼠标键盘消息
@@ -110,6 +144,13 @@ void ThreadMessage::RemoveDuplicateMsg(uint32_t msgId)
     }
 }
 
+bool ThreadMessage::HasPendingInputMsg() const
+{
+    //高位字表示当前消息队列中存在的消息类型
+    DWORD dwStatus = ::GetQueueStatus(QS_INPUT | QS_PAINT);
+    return HIWORD(dwStatus) != 0;
+}
+
 void ThreadMessage::SetMessageCallback(uint32_t msgId, const ThreadMessageCallback& callback)
 {
     m_impl->m_msgId = msgId;
@@ -0,0 +1,147 @@
+#include "UiAtom.h"
+#include <unordered_map>
+#include <string_view>
+#include <mutex>
+#include <shared_mutex>
+
+namespace ui 
+{
+/** 原子表的实现
+*/
+class AtomTableImpl
+{
+public:
+    typedef std::basic_string_view<DString::value_type> DStringView;
+
+    UiAtom AddAtom(const DString& str)
+    {
+        if (str.empty()) {
+            return UiAtom();
+        }
+        //大部分情况下原子已经存在，先用共享锁查找
+        UiAtom atom = FindAtom(str);
+        if (!atom.IsEmpty()) {
+            return atom;
+        }
+        std::unique_lock<std::shared_mutex> threadGuard(m_mutex);
+        auto iter = m_atomMap.find(DStringView(str));
+        if (iter != m_atomMap.end()) {
+            iter->second->m_nRefCount.fetch_add(1, std::memory_order_relaxed);
+            return UiAtom(iter->second);
+        }
+        UiAtom::AtomEntry* pEntry = new UiAtom::AtomEntry;
+        pEntry->m_str = str;
+        pEntry->m_nId = ++m_nLastId;
+        pEntry->m_nRefCount.store(1, std::memory_order_relaxed);
+        m_atomMap[DStringView(pEntry->m_str)] = pEntry;
+        m_nMemorySize += (pEntry->m_str.size() + 1) * sizeof(DString::value_type);
+        return UiAtom(pEntry);
+    }
+
+    UiAtom FindAtom(const DString& str) const
+    {
+        if (str.empty()) {
+            return UiAtom();
+        }
+        //查找只需共享锁（多个线程可同时查找）；释放最后一个引用时持有独占锁，所以在共享锁内增加引用计数是安全的
+        std::shared_lock<std::shared_mutex> threadGuard(m_mutex);
+        auto iter = m_atomMap.find(DStringView(str));
+        if (iter != m_atomMap.end()) {
+            iter->second->m_nRefCount.fetch_add(1, std::memory_order_relaxed);
+            return UiAtom(iter->second);
+        }
+        return UiAtom();
+    }
+
+    void ReleaseEntry(const UiAtom::AtomEntry* pEntry)
+    {
+        //不是最后一个引用时，不需要加锁
+        uint32_t nRefCount = pEntry->m_nRefCount.load(std::memory_order_relaxed);
+        while (nRefCount > 1) {
+            if (pEntry->m_nRefCount.compare_exchange_weak(nRefCount, nRefCount - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+        //可能是最后一个引用：在独占锁内减少引用计数，与AddAtom/FindAtom互斥（二者在锁内增加引用计数）
+        std::unique_lock<std::shared_mutex> threadGuard(m_mutex);
+        if (pEntry->m_nRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_atomMap.erase(DStringView(pEntry->m_str));
+            m_nMemorySize -= (pEntry->m_str.size() + 1) * sizeof(DString::value_type);
+            delete pEntry;
+        }
+    }
+
+    size_t GetAtomCount() const
+    {
+        std::shared_lock<std::shared_mutex> threadGuard(m_mutex);
+        return m_atomMap.size();
+    }
+
+    size_t GetAtomMemorySize() const
+    {
+        std::shared_lock<std::shared_mutex> threadGuard(m_mutex);
+        return m_nMemorySize + m_atomMap.size() * sizeof(UiAtom::AtomEntry);
+    }
+
+private:
+    /** 字符串到原子条目的映射（KEY引用原子条目中的字符串，原子条目在引用计数为0时释放）
+    */
+    std::unordered_map<DStringView, UiAtom::AtomEntry*> m_atomMap;
+
+    /** 字符串占用的内存大小
+    */
+    size_t m_nMemorySize = 0;
+
+    /** 最后分配的原子ID
+    */
+    uint32_t m_nLastId = 0;
+
+    /** 多线程同步锁（读多写少：查找用共享锁，添加和删除用独占锁）
+    */
+    mutable std::shared_mutex m_mutex;
+};
+
+/** 全局原子表对象（不析构，保证进程退出过程中释放原子时原子表仍然有效）
+*/
+static AtomTableImpl& GetAtomTableImpl()
+{
+    static AtomTableImpl* s_pAtomTable = new AtomTableImpl;
+    return *s_pAtomTable;
+}
+
+void UiAtom::Release()
+{
+    GetAtomTableImpl().ReleaseEntry(m_pEntry);
+    m_pEntry = nullptr;
+}
+
+const DString& UiAtom::GetString() const
+{
+    if (m_pEntry != nullptr) {
+        return m_pEntry->m_str;
+    }
+    static const DString s_emptyString;
+    return s_emptyString;
+}
+
+UiAtom AtomTable::AddAtom(const DString& str)
+{
+    return GetAtomTableImpl().AddAtom(str);
+}
+
+UiAtom AtomTable::FindAtom(const DString& str)
+{
+    return GetAtomTableImpl().FindAtom(str);
+}
+
+size_t AtomTable::GetAtomCount()
+{
+    return GetAtomTableImpl().GetAtomCount();
+}
+
+size_t AtomTable::GetAtomMemorySize()
+{
+    return GetAtomTableImpl().GetAtomMemorySize();
+}
+
+} // namespace ui
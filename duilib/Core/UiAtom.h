@@ -0,0 +1,144 @@
+#ifndef UI_CORE_UIATOM_H_
+#define UI_CORE_UIATOM_H_
+
+#include "duilib/duilib_defs.h"
+#include <string>
+#include <functional>
+#include <atomic>
+
+namespace ui 
+{
+class AtomTableImpl;
+
+/** 驻留字符串（原子）：相同内容的字符串在全局原子表中只保存一份，比较和哈希时只需比较指针
+*   适用于控件名称、Class名称、属性名称等重复率高的短字符串
+*   原子使用引用计数，最后一个引用释放时从原子表中移除，运行时生成的名称（比如列表项的名称）不会使原子表持续增长
+*/
+class UILIB_API UiAtom
+{
+public:
+    /** 原子表中的条目
+    */
+    struct AtomEntry
+    {
+        DString m_str;          //字符串内容
+        uint32_t m_nId = 0;     //原子ID（从1开始递增，不重复使用，0表示空）
+        mutable std::atomic<uint32_t> m_nRefCount = 0; //引用计数（由原子表管理）
+    };
+
+public:
+    UiAtom(): m_pEntry(nullptr) {}
+    UiAtom(const UiAtom& r): m_pEntry(r.m_pEntry)
+    {
+        if (m_pEntry != nullptr) {
+            m_pEntry->m_nRefCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    UiAtom(UiAtom&& r) noexcept: m_pEntry(r.m_pEntry)
+    {
+        r.m_pEntry = nullptr;
+    }
+    UiAtom& operator = (const UiAtom& r)
+    {
+        if (m_pEntry != r.m_pEntry) {
+            UiAtom temp(r);
+            std::swap(m_pEntry, temp.m_pEntry);
+        }
+        return *this;
+    }
+    UiAtom& operator = (UiAtom&& r) noexcept
+    {
+        if (this != &r) {
+            std::swap(m_pEntry, r.m_pEntry);
+        }
+        return *this;
+    }
+    ~UiAtom()
+    {
+        if (m_pEntry != nullptr) {
+            Release();
+        }
+    }
+
+    /** 是否为空
+    */
+    bool IsEmpty() const { return m_pEntry == nullptr; }
+
+    /** 获取原子ID（稳定的32位整型值，0表示空）
+    */
+    uint32_t GetId() const { return (m_pEntry != nullptr) ? m_pEntry->m_nId : 0; }
+
+    /** 获取原子对应的字符串（返回的引用在该原子对象的生命周期内有效）
+    */
+    const DString& GetString() const;
+
+    /** 获取原子对应的字符串
+    */
+    const DString::value_type* c_str() const { return GetString().c_str(); }
+
+    /** 获取原子条目的指针（用于计算哈希值）
+    */
+    const AtomEntry* GetEntry() const { return m_pEntry; }
+
+    friend bool operator==(const UiAtom& a, const UiAtom& b) { return a.m_pEntry == b.m_pEntry; }
+    friend bool operator!=(const UiAtom& a, const UiAtom& b) { return a.m_pEntry != b.m_pEntry; }
+
+private:
+    friend class AtomTableImpl;
+
+    /** 由原子表创建（接管一个已经增加的引用计数）
+    */
+    explicit UiAtom(const AtomEntry* pEntry): m_pEntry(pEntry) {}
+
+    /** 释放引用，最后一个引用释放时从原子表中移除
+    */
+    void Release();
+
+private:
+    /** 原子表中的条目（由原子表管理，引用计数为0时释放）
+    */
+    const AtomEntry* m_pEntry;
+};
+
+/** 全局原子表（线程安全）
+*/
+class UILIB_API AtomTable
+{
+public:
+    /** 添加一个字符串到原子表，如果已经存在，返回已有的原子
+    * @param [in] str 字符串，如果为空串，返回空原子
+    */
+    static UiAtom AddAtom(const DString& str);
+
+    /** 在原子表中查找一个字符串（不添加）
+    * @param [in] str 字符串
+    * @return 如果不存在，返回空原子
+    */
+    static UiAtom FindAtom(const DString& str);
+
+    /** 获取原子表中的原子个数
+    */
+    static size_t GetAtomCount();
+
+    /** 获取原子表中字符串占用的内存大小（字节，估算值，用于统计）
+    */
+    static size_t GetAtomMemorySize();
+};
+
+} // namespace ui
+
+namespace std
+{
+    /** UiAtom的哈希函数，可作为std::unordered_map的KEY
+    */
+    template<>
+    struct hash<ui::UiAtom>
+    {
+        size_t operator()(const ui::UiAtom& atom) const noexcept
+        {
+            return std::hash<const void*>()(atom.GetEntry());
+        }
+    };
+}
+
+#endif // UI_CORE_UIATOM_H_
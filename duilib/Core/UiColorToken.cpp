@@ -0,0 +1,111 @@
+#include "UiColorToken.h"
+#include "duilib/Core/ColorManager.h"
+
+namespace ui 
+{
+UiColorToken::UiColorToken()
+{
+    ResetCache();
+}
+
+UiColorToken::UiColorToken(const DString& colorName):
+    m_colorName(colorName)
+{
+    ParseColorName();
+}
+
+UiColorToken::UiColorToken(const UiColorToken& r):
+    m_colorName(r.m_colorName),
+    m_color(r.m_color),
+    m_pPalette(r.m_pPalette),
+    m_nSlot(r.m_nSlot),
+    m_nPaletteVersion(r.m_nPaletteVersion),
+    m_nWindowVersion(r.m_nWindowVersion),
+    m_nGlobalVersion(r.m_nGlobalVersion),
+    m_pContext(r.m_pContext)
+{
+}
+
+UiColorToken& UiColorToken::operator = (const UiColorToken& r)
+{
+    if (&r != this) {
+        m_colorName = r.m_colorName;
+        m_color = r.m_color;
+        m_pPalette = r.m_pPalette;
+        m_nSlot = r.m_nSlot;
+        m_nPaletteVersion = r.m_nPaletteVersion;
+        m_nWindowVersion = r.m_nWindowVersion;
+        m_nGlobalVersion = r.m_nGlobalVersion;
+        m_pContext = r.m_pContext;
+    }
+    return *this;
+}
+
+UiColorToken& UiColorToken::operator = (const DString& colorName)
+{
+    m_colorName = colorName;
+    ParseColorName();
+    return *this;
+}
+
+void UiColorToken::clear()
+{
+    m_colorName.clear();
+    m_color = UiColor();
+    ResetCache();
+}
+
+void UiColorToken::ResetCache() const
+{
+    m_pPalette = nullptr;
+    m_nSlot = 0;
+    m_nPaletteVersion = 0;
+    m_nWindowVersion = 0;
+    m_nGlobalVersion = 0;
+    m_pContext = nullptr;
+}
+
+bool UiColorToken::GetCachedColor(const void* pContext, uint32_t nWindowVersion, uint32_t nGlobalVersion, UiColor& color) const
+{
+    //先校验窗口和全局颜色表的版本号：版本号一致时，记录的颜色表仍然有效（窗口颜色表的版本号全局唯一）
+    if ((m_pPalette == nullptr) || (m_pContext != pContext) ||
+        (m_nWindowVersion != nWindowVersion) || (m_nGlobalVersion != nGlobalVersion)) {
+        return false;
+    }
+    if (m_pPalette->GetVersion() != m_nPaletteVersion) {
+        return false;
+    }
+    color = m_pPalette->GetColorAt(m_nSlot);
+    return true;
+}
+
+void UiColorToken::SetCachedSlot(const void* pContext, uint32_t nWindowVersion, uint32_t nGlobalVersion,
+                                 const ColorMap* pPalette, uint32_t nSlot) const
+{
+    ASSERT(!IsDirectColor() && (pPalette != nullptr));
+    if (!IsDirectColor() && (pPalette != nullptr)) {
+        m_pPalette = pPalette;
+        m_nSlot = nSlot;
+        m_nPaletteVersion = pPalette->GetVersion();
+        m_nWindowVersion = nWindowVersion;
+        m_nGlobalVersion = nGlobalVersion;
+        m_pContext = pContext;
+    }
+}
+
+void UiColorToken::ParseColorName()
+{
+    m_color = UiColor();
+    ResetCache();
+    const DString::value_type* colorName = m_colorName.c_str();
+    if ((colorName != nullptr) && (colorName[0] == _T('#'))) {
+        //以'#'字符开头，直接指定颜色值，举例：#FFFFFFFF
+        UiColor color = ColorManager::ConvertToUiColor(colorName);
+        if (color.GetARGB() != 0) {
+            m_color = color;
+            m_nSlot = kDirectColor;
+        }
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,119 @@
+#ifndef UI_CORE_UICOLOR_TOKEN_H_
+#define UI_CORE_UICOLOR_TOKEN_H_
+
+#include "duilib/Core/UiColor.h"
+#include "duilib/Core/UiString.h"
+
+namespace ui 
+{
+class ColorMap;
+
+/** 预解析的颜色值（用于替代颜色名称字符串，避免每次绘制时按名称查找颜色值）
+*   (1) 以'#'开头的颜色值（如 #FFFFFFFF）：设置时直接解析为ARGB值，绘制时无需再解析
+*   (2) 颜色名称（如 white）：首次使用时解析为所在颜色表的槽位，绘制时按槽位读取颜色值；
+*       仅当相关颜色表的结构发生变化（颜色表版本号变化）或者所属窗口变化时重新解析
+*/
+class UILIB_API UiColorToken
+{
+public:
+    UiColorToken();
+    UiColorToken(const DString& colorName);
+    UiColorToken(const UiColorToken& r);
+    UiColorToken& operator = (const UiColorToken& r);
+    UiColorToken& operator = (const DString& colorName);
+
+public:
+    /** 是否为空
+    */
+    bool empty() const { return m_colorName.empty(); }
+
+    /** 获取颜色名称或者颜色值字符串
+    */
+    const DString::value_type* c_str() const { return m_colorName.c_str(); }
+
+    /** 清空
+    */
+    void clear();
+
+    /** 是否为直接指定的颜色值（以'#'开头的颜色值）
+    */
+    bool IsDirectColor() const { return m_pPalette == nullptr && m_nSlot == kDirectColor; }
+
+    /** 获取直接指定的颜色值（仅当IsDirectColor()为true时有效）
+    */
+    UiColor GetDirectColor() const { return m_color; }
+
+    /** 获取缓存的颜色值（按解析时记录的颜色表槽位读取）
+    * @param [in] pContext 解析颜色时的上下文（所属窗口）
+    * @param [in] nWindowVersion 当前窗口颜色表的版本号（无窗口时为0）
+    * @param [in] nGlobalVersion 当前全局颜色表的版本号
+    * @param [out] color 返回缓存的颜色值
+    * @return 如果缓存有效返回true，否则返回false
+    */
+    bool GetCachedColor(const void* pContext, uint32_t nWindowVersion, uint32_t nGlobalVersion, UiColor& color) const;
+
+    /** 设置缓存的颜色表槽位
+    * @param [in] pContext 解析颜色时的上下文（所属窗口）
+    * @param [in] nWindowVersion 当前窗口颜色表的版本号（无窗口时为0）
+    * @param [in] nGlobalVersion 当前全局颜色表的版本号
+    * @param [in] pPalette 颜色所在的颜色表
+    * @param [in] nSlot 颜色在颜色表中的槽位序号
+    */
+    void SetCachedSlot(const void* pContext, uint32_t nWindowVersion, uint32_t nGlobalVersion,
+                       const ColorMap* pPalette, uint32_t nSlot) const;
+
+    friend bool operator==(const UiColorToken& a, const DString& b) { return a.m_colorName == b; }
+    friend bool operator==(const DString& a, const UiColorToken& b) { return b.m_colorName == a; }
+    friend bool operator!=(const UiColorToken& a, const DString& b) { return !(a.m_colorName == b); }
+    friend bool operator!=(const DString& a, const UiColorToken& b) { return !(b.m_colorName == a); }
+
+private:
+    /** 解析颜色值字符串
+    */
+    void ParseColorName();
+
+    /** 清除已解析的颜色表槽位
+    */
+    void ResetCache() const;
+
+private:
+    /** 槽位序号的特殊值：表示直接指定的颜色值
+    */
+    static constexpr uint32_t kDirectColor = UINT32_MAX;
+
+    /** 颜色名称或者颜色值字符串
+    */
+    UiString m_colorName;
+
+    /** 直接指定的颜色值（仅当IsDirectColor()为true时有效）
+    */
+    UiColor m_color;
+
+    /** 颜色所在的颜色表（为nullptr表示未解析或者为直接指定的颜色值）
+    */
+    mutable const ColorMap* m_pPalette;
+
+    /** 颜色在颜色表中的槽位序号（kDirectColor表示直接指定的颜色值）
+    */
+    mutable uint32_t m_nSlot;
+
+    /** 解析时颜色所在颜色表的版本号
+    */
+    mutable uint32_t m_nPaletteVersion;
+
+    /** 解析时窗口颜色表的版本号
+    */
+    mutable uint32_t m_nWindowVersion;
+
+    /** 解析时全局颜色表的版本号
+    */
+    mutable uint32_t m_nGlobalVersion;
+
+    /** 解析颜色值时的上下文（所属窗口）
+    */
+    mutable const void* m_pContext;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_UICOLOR_TOKEN_H_
@@ -14,6 +14,7 @@
 #include "duilib/Core/UiFixedInt.h"
 #include "duilib/Core/UiEstInt.h"
 #include "duilib/Core/UiString.h"
+#include "duilib/Core/UiAtom.h"
 #include <cmath>
 
 namespace ui
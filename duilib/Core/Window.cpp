@@ -9,6 +9,7 @@
 #include "duilib/Render/IRender.h"
 #include "duilib/Render/AutoClip.h"
 #include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/ParallelTaskRunner.h"
 #include "duilib/Utils/FilePathUtil.h"
 
 namespace ui
@@ -24,7 +25,10 @@ Window::Window() :
     m_bIsArranged(false),
     m_bPostQuitMsgWhenClosed(false),
     m_renderBackendType(RenderBackendType::kRaster_BackendType),
-    m_bWindowAttributesApplied(false)
+    m_bWindowAttributesApplied(false),
+    m_bEnableParallelPaint(false),
+    m_bPaintRecordable(false),
+    m_bPaintRecordableValid(false)
 {
     m_toolTip = std::make_unique<ToolTip>();
 }
@@ -378,6 +382,7 @@ bool Window::AttachBox(Box* pRoot)
     // Set the dialog root element
     m_pRoot = pRoot;
     m_controlFinder.SetRoot(pRoot);
+    InvalidatePaintRecordable();
     // Go ahead...
     m_bIsArranged = true;
     m_bFirstLayout = true;
@@ -442,28 +447,45 @@ void Window::AddClass(const DString& strClassName, const DString& strControlAttr
 {
     ASSERT(!strClassName.empty());
     ASSERT(!strControlAttrList.empty());
+    const UiAtom classAtom = AtomTable::AddAtom(strClassName);
 #ifdef _DEBUG
     //检查：避免误修改
-    auto iter = m_defaultAttrHash.find(strClassName);
+    auto iter = m_defaultAttrHash.find(classAtom);
     if (iter != m_defaultAttrHash.end()) {
-        ASSERT(iter->second == strControlAttrList);
+        ASSERT(iter->second.m_attrList == strControlAttrList);
     }
 #endif
-    m_defaultAttrHash[strClassName] = strControlAttrList;
+    UiClassAttributes& classAttributes = m_defaultAttrHash[classAtom];
+    classAttributes.m_attrList = strControlAttrList;
+    classAttributes.m_attrs.clear();
+    AttributeUtil::ParseAttributeList(strControlAttrList, classAttributes.m_attrs);
 }
 
 DString Window::GetClassAttributes(const DString& strClassName) const
 {
-    auto it = m_defaultAttrHash.find(strClassName);
-    if (it != m_defaultAttrHash.end()) {
-        return it->second;
+    const UiClassAttributes* pClassAttributes = FindClassAttributes(strClassName);
+    if (pClassAttributes != nullptr) {
+        return pClassAttributes->m_attrList;
     }
     return _T("");
 }
 
+const UiClassAttributes* Window::FindClassAttributes(const DString& strClassName) const
+{
+    const UiAtom classAtom = AtomTable::FindAtom(strClassName);
+    if (classAtom.IsEmpty()) {
+        return nullptr;
+    }
+    auto it = m_defaultAttrHash.find(classAtom);
+    if (it != m_defaultAttrHash.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
 bool Window::RemoveClass(const DString& strClassName)
 {
-    auto it = m_defaultAttrHash.find(strClassName);
+    auto it = m_defaultAttrHash.find(AtomTable::FindAtom(strClassName));
     if (it != m_defaultAttrHash.end()) {
         m_defaultAttrHash.erase(it);
         return true;
@@ -491,6 +513,11 @@ UiColor Window::GetTextColor(const DString& strName) const
     return m_colorMap.GetColor(strName);
 }
 
+const ColorMap& Window::GetColorMap() const
+{
+    return m_colorMap;
+}
+
 bool Window::AddOptionGroup(const DString& strGroupName, Control* pControl)
 {
     ASSERT(!strGroupName.empty());
@@ -985,6 +1012,8 @@ bool Window::ResizeRenderToClientSize() const
 
 bool Window::OnPreparePaint()
 {
+    static const PerformanceStatId s_statId(_T("PaintWindow, Window::OnPreparePaint"));
+    PerformanceStat statPerformance(s_statId);
     GlobalManager::Instance().AssertUIThread();
     if (!IsWindow()) {
         return false;
@@ -1004,7 +1033,8 @@ bool Window::OnPreparePaint()
 
 LRESULT Window::OnPaintMsg(const UiRect& rcPaint, const NativeMsg& /*nativeMsg*/, bool& bHandled)
 {
-    PerformanceStat statPerformance(_T("PaintWindow, Window::OnPaintMsg"));
+    static const PerformanceStatId s_statId(_T("PaintWindow, Window::OnPaintMsg"));
+    PerformanceStat statPerformance(s_statId);
     bHandled = false;
     if (Paint(rcPaint)) {
         bHandled = true;
@@ -1026,20 +1056,14 @@ bool Window::Paint(const UiRect& rcPaint)
         pRender->ClearAlpha(rcPaint);
     }
 
-    // 绘制    
-    if (m_pRoot->IsVisible()) {
-        AutoClip rectClip(pRender, rcPaint, true);
-        UiPoint ptOldWindOrg = pRender->OffsetWindowOrg(m_renderOffset);
-        m_pRoot->Paint(pRender, rcPaint);
-        m_pRoot->PaintChild(pRender, rcPaint);
-        pRender->SetWindowOrg(ptOldWindOrg);
+    // 绘制：如果有滚动复制，只需要重绘剩余的部分
+    std::vector<UiRect> paintRects;
+    if (!ApplyScrollBlit(pRender, rcPaint, paintRects)) {
+        paintRects.assign(1, rcPaint);
     }
-    else {
-        UiColor bkColor = UiColor(UiColors::LightGray);
-        if (!m_pRoot->GetBkColor().empty()) {
-            bkColor = m_pRoot->GetUiColor(m_pRoot->GetBkColor());
-        }
-        pRender->FillRect(rcPaint, bkColor);
+    m_invalidatedRects.clear();
+    for (const UiRect& rcRootPaint : paintRects) {
+        PaintRoot(pRender, rcRootPaint);
     }
 
     //开始绘制前，进行alpha通道修复
@@ -1077,6 +1101,201 @@ bool Window::Paint(const UiRect& rcPaint)
     return true;
 }
 
+void Window::PaintRoot(IRender* pRender, const UiRect& rcPaint)
+{
+    if (m_pRoot->IsVisible() && ParallelPaint(pRender, rcPaint)) {
+        //已经完成并行绘制
+    }
+    else if (m_pRoot->IsVisible()) {
+        AutoClip rectClip(pRender, rcPaint, true);
+        UiPoint ptOldWindOrg = pRender->OffsetWindowOrg(m_renderOffset);
+        m_pRoot->Paint(pRender, rcPaint);
+        m_pRoot->PaintChild(pRender, rcPaint);
+        pRender->SetWindowOrg(ptOldWindOrg);
+    }
+    else {
+        UiColor bkColor = UiColor(UiColors::LightGray);
+        if (!m_pRoot->GetBkColor().empty()) {
+            bkColor = m_pRoot->GetUiColor(m_pRoot->GetBkColor());
+        }
+        pRender->FillRect(rcPaint, bkColor);
+    }
+}
+
+void Window::OnInvalidate(const UiRect& rcItem)
+{
+    if (rcItem.IsEmpty()) {
+        return;
+    }
+    for (const UiRect& rc : m_invalidatedRects) {
+        if (rc.ContainsRect(rcItem)) {
+            return;
+        }
+    }
+    //区域个数较多时合并，避免绘制时拆分出过多的小区域
+    const size_t kMaxInvalidatedRects = 8;
+    if (m_invalidatedRects.size() >= kMaxInvalidatedRects) {
+        UiRect rcUnion = rcItem;
+        for (const UiRect& rc : m_invalidatedRects) {
+            rcUnion.Union(rc);
+        }
+        m_invalidatedRects.assign(1, rcUnion);
+    }
+    else {
+        m_invalidatedRects.push_back(rcItem);
+    }
+}
+
+bool Window::InvalidateScroll(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if ((m_render == nullptr) || IsLayeredWindow() ||
+        (m_render->GetRenderBackendType() != RenderBackendType::kRaster_BackendType) ||
+        (m_renderOffset.x != 0) || (m_renderOffset.y != 0) || ((dx == 0) && (dy == 0))) {
+        return false;
+    }
+    UiRect rcClient;
+    GetClientRect(rcClient);
+    UiRect rcScrollClient = rcScroll;
+    if (!rcScrollClient.Intersect(rcClient)) {
+        return false;
+    }
+    if (m_scrollBlit.m_bValid) {
+        //与尚未绘制的滚动合并：只支持同一个区域、同一个方向的滚动（否则无法确定期间失效的区域被移动到了哪里）
+        const bool bSameDirection = ((int64_t)dx * m_scrollBlit.m_dx >= 0) && ((int64_t)dy * m_scrollBlit.m_dy >= 0);
+        if ((m_scrollBlit.m_rcScroll != rcScrollClient) || !bSameDirection) {
+            OnInvalidate(m_scrollBlit.m_rcScroll);
+            m_scrollBlit = ScrollBlitData();
+            return false;
+        }
+        dx += m_scrollBlit.m_dx;
+        dy += m_scrollBlit.m_dy;
+    }
+    if ((std::abs(dx) >= rcScrollClient.Width()) || (std::abs(dy) >= rcScrollClient.Height())) {
+        //所有内容都移出了滚动区域，没有可以复制的内容
+        if (m_scrollBlit.m_bValid) {
+            OnInvalidate(m_scrollBlit.m_rcScroll);
+            m_scrollBlit = ScrollBlitData();
+        }
+        return false;
+    }
+    m_scrollBlit.m_bValid = true;
+    m_scrollBlit.m_rcScroll = rcScrollClient;
+    m_scrollBlit.m_dx = dx;
+    m_scrollBlit.m_dy = dy;
+    m_scrollBlit.m_renderSize = UiSize(m_render->GetWidth(), m_render->GetHeight());
+    //整个区域都需要刷新到屏幕上，但不计入需要重绘的区域
+    InvalidateNative(rcScrollClient);
+    return true;
+}
+
+bool Window::ApplyScrollBlit(IRender* pRender, const UiRect& rcPaint, std::vector<UiRect>& paintRects)
+{
+    if (!m_scrollBlit.m_bValid) {
+        return false;
+    }
+    const ScrollBlitData scrollBlit = m_scrollBlit;
+    m_scrollBlit = ScrollBlitData();
+
+    const UiRect& rcScroll = scrollBlit.m_rcScroll;
+    //复制后内容仍然有效的区域
+    UiRect rcValid = rcScroll;
+    rcValid.Offset(scrollBlit.m_dx, scrollBlit.m_dy);
+    rcValid.Intersect(rcScroll);
+    bool bValidInvalidated = false;
+    for (const UiRect& rc : m_invalidatedRects) {
+        if (rc.ContainsRect(rcValid)) {
+            bValidInvalidated = true;
+            break;
+        }
+    }
+    if ((pRender->GetWidth() != scrollBlit.m_renderSize.cx) || (pRender->GetHeight() != scrollBlit.m_renderSize.cy) ||
+        IsLayeredWindow() || !rcPaint.ContainsRect(rcScroll) || bValidInvalidated ||
+        !pRender->ScrollPixels(rcScroll, scrollBlit.m_dx, scrollBlit.m_dy)) {
+        //滚动区域需要完整重绘
+        UiRect rcFullPaint = rcPaint;
+        rcFullPaint.Union(rcScroll);
+        paintRects.assign(1, rcFullPaint);
+        return true;
+    }
+
+    static const PerformanceStatId s_statId(_T("PaintWindow, Window::ApplyScrollBlit"));
+    PerformanceStat statPerformance(s_statId);
+    auto AddPaintRect = [&paintRects](const UiRect& rc) {
+            if (!rc.IsEmpty()) {
+                paintRects.push_back(rc);
+            }
+        };
+    //有效区域以外的部分（包括新露出的部分）
+    AddPaintRect(UiRect(rcPaint.left, rcPaint.top, rcPaint.right, rcValid.top));
+    AddPaintRect(UiRect(rcPaint.left, rcValid.bottom, rcPaint.right, rcPaint.bottom));
+    AddPaintRect(UiRect(rcPaint.left, rcValid.top, rcValid.left, rcValid.bottom));
+    AddPaintRect(UiRect(rcValid.right, rcValid.top, rcPaint.right, rcValid.bottom));
+
+    //有效区域内，因为其他原因需要重绘的部分：滚动前设置的区域，其内容已经随着滚动移动了位置，所以两个位置都需要重绘
+    for (const UiRect& rcInvalidated : m_invalidatedRects) {
+        UiRect rcMoved = rcInvalidated;
+        rcMoved.Offset(scrollBlit.m_dx, scrollBlit.m_dy);
+        rcMoved.Union(rcInvalidated);
+        if (rcMoved.Intersect(rcValid)) {
+            paintRects.push_back(rcMoved);
+        }
+    }
+    return true;
+}
+
+bool Window::ParallelPaint(IRender* pRender, const UiRect& rcPaint)
+{
+    //重绘区域较小时，录制和线程调度的开销超过并行带来的收益
+    constexpr const int64_t nMinParallelArea = 512 * 512;
+    if (!m_bEnableParallelPaint ||
+        (pRender->GetRenderBackendType() != RenderBackendType::kRaster_BackendType) ||
+        ((int64_t)rcPaint.Width() * rcPaint.Height() < nMinParallelArea) ||
+        (ParallelTaskRunner::Instance().GetConcurrency() < 2)) {
+        return false;
+    }
+    if (!m_bPaintRecordableValid) {
+        //控件树没有变化时，不需要每次绘制都遍历检查
+        m_bPaintRecordable = IsPaintRecordable(m_pRoot);
+        m_bPaintRecordableValid = true;
+    }
+    if (!m_bPaintRecordable) {
+        return false;
+    }
+    static const PerformanceStatId s_statId(_T("PaintWindow, Window::ParallelPaint"));
+    PerformanceStat statPerformance(s_statId);
+    Box* pRoot = m_pRoot;
+    const UiPoint renderOffset = m_renderOffset;
+    return pRender->PaintRecorded(rcPaint, [pRoot, renderOffset, &rcPaint](IRender* pRecordRender) {
+            AutoClip rectClip(pRecordRender, rcPaint, true);
+            UiPoint ptOldWindOrg = pRecordRender->OffsetWindowOrg(renderOffset);
+            pRoot->Paint(pRecordRender, rcPaint);
+            pRoot->PaintChild(pRecordRender, rcPaint);
+            pRecordRender->SetWindowOrg(ptOldWindOrg);
+        });
+}
+
+bool Window::IsPaintRecordable(Control* pControl)
+{
+    //滚动容器的子控件位置未包含滚动偏移，所以这里不按绘制区域过滤，检查所有可见控件
+    if ((pControl == nullptr) || !pControl->IsVisible()) {
+        return true;
+    }
+    if (!pControl->IsPaintRecordable()) {
+        return false;
+    }
+    Box* pBox = dynamic_cast<Box*>(pControl);
+    if (pBox != nullptr) {
+        const size_t nItemCount = pBox->GetItemCount();
+        for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+            if (!IsPaintRecordable(pBox->GetItemAt(nIndex))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 LRESULT Window::OnSetFocusMsg(WindowBase* /*pLostFocusWindow*/, const NativeMsg& /*nativeMsg*/, bool& bHandled)
 {
     bHandled = false;
@@ -1909,6 +2128,16 @@ std::shared_ptr<IRenderDpi> Window::GetRenderDpi()
     return spRenderDpi;
 }
 
+void Window::SetEnableParallelPaint(bool bEnable)
+{
+    m_bEnableParallelPaint = bEnable;
+}
+
+bool Window::IsEnableParallelPaint() const
+{
+    return m_bEnableParallelPaint;
+}
+
 void Window::SetWindowAttributesApplied(bool bApplied)
 {
     m_bWindowAttributesApplied = bApplied;
@@ -2045,6 +2274,16 @@ Control* Window::FindControl(const UiPoint& pt) const
     return pControl;
 }
 
+void Window::InvalidateHitTestCache()
+{
+    m_controlFinder.InvalidateHitTestCache();
+}
+
+void Window::InvalidatePaintRecordable()
+{
+    m_bPaintRecordableValid = false;
+}
+
 Control* Window::FindContextMenuControl(const UiPoint* pt) const
 {
     Control* pControl = m_controlFinder.FindContextMenuControl(pt);
@@ -7,6 +7,8 @@
 #include "duilib/Render/IRender.h"
 #include "duilib/Utils/Delegate.h"
 #include "duilib/Utils/FilePath.h"
+#include "duilib/Utils/AttributeUtil.h"
+#include <unordered_map>
 
 namespace ui
 {
@@ -100,6 +102,25 @@ public:
     */
     RenderBackendType GetRenderBackendType() const;
 
+    /** 设置是否启用并行绘制：重绘区域较大时，先录制控件的绘制操作，再切分为多个条带由多个线程并行回放
+    *   仅对CPU绘制方式有效；如果有控件不支持录制（参见Control::IsPaintRecordable），自动按常规方式绘制
+    * @param [in] bEnable true表示启用，false表示不启用（默认不启用）
+    */
+    void SetEnableParallelPaint(bool bEnable);
+
+    /** 判断是否启用了并行绘制
+    */
+    bool IsEnableParallelPaint() const;
+
+    /** 滚动区域需要重绘：区域内已经绘制的内容在下次绘制时按滚动距离直接复制，只重绘新露出的部分
+    *   仅对CPU绘制的非分层窗口有效；下次绘制前有多个不同的区域滚动时，自动改为重绘整个区域
+    * @param [in] rcScroll 滚动区域，为客户区坐标
+    * @param [in] dx 内容在横向上的移动距离（向右为正）
+    * @param [in] dy 内容在纵向上的移动距离（向下为正）
+    * @return 成功返回true；如果不满足条件返回false，此时调用方需要调用Invalidate重绘整个区域
+    */
+    bool InvalidateScroll(const UiRect& rcScroll, int32_t dx, int32_t dy);
+
     /** 设置窗口图标（支持*.ico格式）
     *  @param [in] iconFilePath ico文件的路径（在资源根目录内的相对路径）
     */
@@ -206,6 +227,14 @@ public:
     */
     Control* FindControl(const UiPoint& pt) const;
 
+    /** 使根据坐标查找控件的缓存失效（控件的位置、可见性或者滚动位置变化时调用）
+    */
+    void InvalidateHitTestCache();
+
+    /** 使"控件树是否支持录制"的缓存失效（控件的可见性、录制属性变化，或者添加、删除子控件时调用）
+    */
+    void InvalidatePaintRecordable();
+
     /**
     *  根据坐标查找可以响应WM_CONTEXTMENU的控件
     * @param [in] pt 指定坐标
@@ -285,6 +314,12 @@ public:
     */
     DString GetClassAttributes(const DString& strClassName) const;
 
+    /** 获取指定通用样式（包含预先解析的属性列表）
+    * @param [in] strClassName 通用样式名称
+    * @return 如果不存在返回nullptr
+    */
+    const UiClassAttributes* FindClassAttributes(const DString& strClassName) const;
+
     /** 删除一个通用样式
     * @param [in] strClassName 要删除的通用样式名称
     */
@@ -312,6 +347,10 @@ public:
     */
     UiColor GetTextColor(const DString& strName) const;
 
+    /** 获取窗口的颜色表
+    */
+    const ColorMap& GetColorMap() const;
+
     /** 添加一个选项组
     * @param [in] strGroupName 组名称
     * @param [in] pControl 控件指针
@@ -413,6 +452,11 @@ protected:
     */
     virtual bool OnPreparePaint() override;
 
+    /** 窗口的某个区域需要重绘（调用Invalidate时触发）
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    virtual void OnInvalidate(const UiRect& rcItem) override;
+
     /** 窗口的层窗口属性发生变化
     */
     virtual void OnLayeredWindowChanged() override;
@@ -791,6 +835,31 @@ private:
     */
     bool Paint(const UiRect& rcPaint);
 
+    /** 并行绘制控件树（参见SetEnableParallelPaint）
+    * @param [in] pRender 渲染接口
+    * @param [in] rcPaint 本次绘制更新的矩形区域
+    * @return 如果执行了绘制返回true；如果不满足并行绘制的条件返回false，需要按常规方式绘制
+    */
+    bool ParallelPaint(IRender* pRender, const UiRect& rcPaint);
+
+    /** 绘制控件树的指定区域
+    * @param [in] pRender 渲染接口
+    * @param [in] rcPaint 绘制区域
+    */
+    void PaintRoot(IRender* pRender, const UiRect& rcPaint);
+
+    /** 执行滚动复制（参见InvalidateScroll），并计算仍然需要重绘的区域
+    * @param [in] pRender 渲染接口
+    * @param [in] rcPaint 本次绘制更新的矩形区域
+    * @param [out] paintRects 返回需要重绘的区域
+    * @return 如果有待执行的滚动复制返回true（复制失败时paintRects为包含滚动区域的整个区域）；否则返回false，需要重绘整个区域
+    */
+    bool ApplyScrollBlit(IRender* pRender, const UiRect& rcPaint, std::vector<UiRect>& paintRects);
+
+    /** 检查控件及其可见的子控件是否都支持录制
+    */
+    static bool IsPaintRecordable(Control* pControl);
+
     /** 调整Render的尺寸，与当前客户区的大小一致
     */
     bool ResizeRenderToClientSize() const;
@@ -873,9 +942,9 @@ private:
     std::unique_ptr<WindowBuilder> m_windowBuilder;
 
 private:
-    /** 窗口配置中class名称与属性映射关系
+    /** 窗口配置中class名称（原子）与属性映射关系
     */
-    std::map<DString, DString> m_defaultAttrHash;
+    std::unordered_map<UiAtom, UiClassAttributes> m_defaultAttrHash;
 
     /** 窗口颜色字符串与颜色值（ARGB）的映射关系
     */
@@ -904,6 +973,31 @@ private:
     /** 窗口的属性是否已经设置完成
     */
     bool m_bWindowAttributesApplied;
+
+    /** 是否启用并行绘制
+    */
+    bool m_bEnableParallelPaint;
+
+    /** 控件树是否支持录制（缓存IsPaintRecordable(m_pRoot)的结果，m_bPaintRecordableValid为false时需要重新检查）
+    */
+    bool m_bPaintRecordable;
+    bool m_bPaintRecordableValid;
+
+    /** 待执行的滚动复制（参见InvalidateScroll）
+    */
+    struct ScrollBlitData
+    {
+        bool m_bValid = false;  //是否有待执行的滚动复制
+        UiRect m_rcScroll;      //滚动区域
+        int32_t m_dx = 0;       //横向移动距离
+        int32_t m_dy = 0;       //纵向移动距离
+        UiSize m_renderSize;    //记录时Render的大小
+    };
+    ScrollBlitData m_scrollBlit;
+
+    /** 自上次绘制以来，通过Invalidate设置需要重绘的区域（超过一定个数时合并为一个区域）
+    */
+    std::vector<UiRect> m_invalidatedRects;
 };
 
 } // namespace ui
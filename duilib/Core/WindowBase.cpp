@@ -578,6 +578,13 @@ void WindowBase::ClearWindowRgn(bool bRedraw)
 }
 
 void WindowBase::Invalidate(const UiRect& rcItem)
+{
+    GlobalManager::Instance().AssertUIThread();
+    OnInvalidate(rcItem);
+    m_pNativeWindow->Invalidate(rcItem);
+}
+
+void WindowBase::InvalidateNative(const UiRect& rcItem)
 {
     GlobalManager::Instance().AssertUIThread();
     m_pNativeWindow->Invalidate(rcItem);
@@ -788,6 +795,16 @@ DString WindowBase::GetWindowRenderName() const
 {
     return m_pNativeWindow->GetWindowRenderName();
 }
+
+void WindowBase::SetMouseMoveCoalescing(bool bCoalesce, bool bKeepDragMoves)
+{
+    m_pNativeWindow->SetMouseMoveCoalescing(bCoalesce, bKeepDragMoves);
+}
+
+bool WindowBase::IsMouseMoveCoalescing() const
+{
+    return m_pNativeWindow->IsMouseMoveCoalescing();
+}
 #endif
 
 void WindowBase::OnWindowSize(WindowSizeType sizeType)
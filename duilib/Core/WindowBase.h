@@ -562,6 +562,17 @@ public:
     /** 获取当前Render绘制引擎的名称
     */
     DString GetWindowRenderName() const;
+
+    /** 设置是否合并鼠标移动消息（默认合并）：高回报率的鼠标产生的移动消息远多于绘制的帧数，
+    *   合并后消息队列中本窗口连续的多个鼠标移动消息，只处理最后一个
+    * @param [in] bCoalesce 是否合并
+    * @param [in] bKeepDragMoves 按下鼠标拖动时，是否保留每一个鼠标移动消息（比如需要完整拖动轨迹的绘图功能）
+    */
+    void SetMouseMoveCoalescing(bool bCoalesce, bool bKeepDragMoves = false);
+
+    /** 是否合并鼠标移动消息
+    */
+    bool IsMouseMoveCoalescing() const;
 #endif
 
 protected:
@@ -599,6 +610,11 @@ protected:
     */
     virtual bool OnPreparePaint() = 0;
 
+    /** 窗口的某个区域需要重绘（调用Invalidate时触发）
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    virtual void OnInvalidate(const UiRect& rcItem) = 0;
+
     /** 窗口的层窗口属性发生变化
     */
     virtual void OnLayeredWindowChanged() = 0;
@@ -903,6 +919,11 @@ protected:
     */
     WindowBase* WindowBaseFromPoint(const UiPoint& pt);
 
+    /** 发出重绘消息，但不触发OnInvalidate
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    void InvalidateNative(const UiRect& rcItem);
+
     /** 处理DPI变化的系统通知消息
     * @param [in] nNewDPI 新的DPI值
     * @param [in] rcNewWindow 新的窗口位置（建议值）
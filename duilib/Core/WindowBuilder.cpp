@@ -6,6 +6,7 @@
 #include "duilib/Core/ControlDragable.h"
 #include "duilib/Core/ScrollBar.h"
 #include "duilib/Core/WindowCreateAttributes.h"
+#include "duilib/Core/CompiledLayout.h"
 
 #include "duilib/Control/TreeView.h"
 #include "duilib/Control/Combo.h"
@@ -46,15 +47,17 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/AttributeUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/PerformanceUtil.h"
 
 #include "duilib/third_party/xml/pugixml.hpp"
+#include <unordered_map>
 
 namespace ui 
 {
 
 WindowBuilder::WindowBuilder()
 {
-    m_xml = std::make_unique<pugi::xml_document>();
 }
 
 WindowBuilder::~WindowBuilder()
@@ -62,10 +65,15 @@ WindowBuilder::~WindowBuilder()
 }
 
 
-Control* WindowBuilder::CreateControlByClass(const DString& strControlClass, Window* pWindow)
+/** 创建内置控件的函数
+*/
+typedef std::function<Control* (Window* pWindow)> CreateControlFunction;
+
+/** 内置控件的创建函数表（表中的下标即为控件的类型索引）
+*/
+static const std::vector<std::pair<DString, CreateControlFunction>>& GetCreateControlTable()
 {
-    typedef std::function<Control* (Window* pWindow)> CreateControlFunction;
-    static std::map<DString, CreateControlFunction> createControlMap =
+    static const std::vector<std::pair<DString, CreateControlFunction>> createControlTable =
     {
         {DUI_CTR_BOX,  [](Window* pWindow) { return new Box(pWindow); }},
         {DUI_CTR_HBOX, [](Window* pWindow) { return new HBox(pWindow); }},
@@ -139,12 +147,38 @@ Control* WindowBuilder::CreateControlByClass(const DString& strControlClass, Win
         {DUI_CTR_HBOX_DRAGABLE, [](Window* pWindow) { return new HBoxDragable(pWindow); }},
         {DUI_CTR_VBOX_DRAGABLE, [](Window* pWindow) { return new VBoxDragable(pWindow); }},
     };
-    Control* pControl = nullptr;
-    auto iter = createControlMap.find(strControlClass);
-    if (iter != createControlMap.end()) {
-        pControl = iter->second(pWindow);
+    return createControlTable;
+}
+
+int32_t WindowBuilder::GetControlClassIndex(const DString& strControlClass)
+{
+    static const std::unordered_map<DString, int32_t> classIndexMap = []() {
+            std::unordered_map<DString, int32_t> indexMap;
+            const auto& createControlTable = GetCreateControlTable();
+            for (size_t nIndex = 0; nIndex < createControlTable.size(); ++nIndex) {
+                indexMap[createControlTable[nIndex].first] = (int32_t)nIndex;
+            }
+            return indexMap;
+        }();
+    auto iter = classIndexMap.find(strControlClass);
+    if (iter != classIndexMap.end()) {
+        return iter->second;
+    }
+    return -1;
+}
+
+Control* WindowBuilder::CreateControlByClassIndex(int32_t nClassIndex, Window* pWindow)
+{
+    const auto& createControlTable = GetCreateControlTable();
+    if ((nClassIndex >= 0) && ((size_t)nClassIndex < createControlTable.size())) {
+        return createControlTable[nClassIndex].second(pWindow);
     }
-    return pControl;
+    return nullptr;
+}
+
+Control* WindowBuilder::CreateControlByClass(const DString& strControlClass, Window* pWindow)
+{
+    return CreateControlByClassIndex(GetControlClassIndex(strControlClass), pWindow);
 }
 
 bool WindowBuilder::IsXmlFileExists(const FilePath& xmlFilePath) const
@@ -175,7 +209,7 @@ bool WindowBuilder::ParseXmlData(const DString& xmlFileData)
     if (xmlFileData.empty()) {
         return false;
     }
-    bool isLoaded = false;
+    std::shared_ptr<CompiledLayout> spLayout;
     //字符串以<开头认为是XML字符串，否则认为是XML文件
     //如果使用了 zip 压缩包，则从内存中读取
     if (xmlFileData.front() == _T('<')) {
@@ -184,75 +218,252 @@ bool WindowBuilder::ParseXmlData(const DString& xmlFileData)
 #else
         pugi::xml_encoding encoding = pugi::xml_encoding::encoding_utf8;
 #endif
-        pugi::xml_parse_result result = m_xml->load_buffer(xmlFileData.c_str(),
-                                                           xmlFileData.size() * sizeof(DString::value_type),
-                                                           pugi::parse_default, encoding);
-        isLoaded = result.status == pugi::status_ok;
+        const uint8_t* pData = (const uint8_t*)xmlFileData.c_str();
+        const size_t nDataSize = xmlFileData.size() * sizeof(DString::value_type);
+        pugi::xml_document xmlDoc;
+        pugi::xml_parse_result result = xmlDoc.load_buffer(pData, nDataSize, pugi::parse_default, encoding);
+        if (result.status == pugi::status_ok) {
+            spLayout = std::make_shared<CompiledLayout>();
+            if (!spLayout->CompileXml(xmlDoc, CompiledLayout::HashSourceData(pData, nDataSize), nDataSize, 0)) {
+                spLayout.reset();
+            }
+        }
     }
-    if (!isLoaded) {
+    if (spLayout == nullptr) {
         ASSERT(!_T("WindowBuilder::Create load xmlFileData failed!"));
         return false;
     }
     m_xmlFilePath.Clear();
+    spLayout->ResolveClassIndex(&WindowBuilder::GetControlClassIndex);
+    spLayout->ResolveIncludePath([this](const DString& includeSource) {
+            return GetIncludeFilePath(includeSource);
+        });
+    m_layout = spLayout;
     return true;
 }
 
-bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath)
+bool WindowBuilder::ReadXmlFileData(const FilePath& xmlFilePath, std::vector<uint8_t>& fileData,
+                                    const uint8_t*& pData, size_t& nDataSize, FilePath& xmlFileFullPath)
 {
-    ASSERT(!xmlFilePath.IsEmpty() && _T("xmlFilePath 参数为空！"));
+    fileData.clear();
+    pData = nullptr;
+    nDataSize = 0;
     if (xmlFilePath.IsEmpty()) {
         return false;
     }
-    bool isLoaded = false;
+    bool bRet = false;
     if (GlobalManager::Instance().Zip().IsUseZip()) {
-        FilePath sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
-        std::vector<unsigned char> file_data;
-        if (GlobalManager::Instance().Zip().GetZipData(sFile, file_data)) {
-            pugi::xml_parse_result result = m_xml->load_buffer(file_data.data(), file_data.size());
-            if (result.status != pugi::status_ok) {
-                ASSERT(!_T("WindowBuilder::Create load xml from zip data failed!"));
-                return false;
-            }
-            isLoaded = true;
+        xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
+        //未压缩存储的文件（比如打包时不压缩的预编译布局文件），直接使用压缩包映射到内存的数据
+        if (GlobalManager::Instance().Zip().GetZipStoredData(xmlFileFullPath, pData, nDataSize)) {
+            return true;
         }
+        bRet = GlobalManager::Instance().Zip().GetZipData(xmlFileFullPath, fileData);
     }
     else {
-        FilePath xmlFileFullPath;
         if (xmlFilePath.IsRelativePath()) {
             xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
         }
         else {
             xmlFileFullPath = xmlFilePath;
         }
-        pugi::xml_parse_result result = m_xml->load_file(xmlFileFullPath.NativePathA().c_str());
-        if (result.status != pugi::status_ok) {
-            ASSERT(!_T("WindowBuilder::Create load xml file failed!"));
+        if (!xmlFileFullPath.IsExistsFile()) {
             return false;
         }
-        isLoaded = true;
+        bRet = FileUtil::ReadFileData(xmlFileFullPath, fileData);
+    }
+    if (bRet) {
+        pData = fileData.data();
+        nDataSize = fileData.size();
+    }
+    return bRet;
+}
+
+FilePath WindowBuilder::GetCompiledLayoutFilePath(const FilePath& xmlFilePath)
+{
+    return FilePath(xmlFilePath.NativePath() + _T("c"));
+}
+
+bool WindowBuilder::GetXmlFileStamp(const FilePath& xmlFilePath, FilePath& xmlFileFullPath,
+                                    uint64_t& nFileSize, int64_t& nFileTime)
+{
+    nFileSize = 0;
+    nFileTime = 0;
+    if (xmlFilePath.IsEmpty()) {
+        return false;
+    }
+    if (GlobalManager::Instance().Zip().IsUseZip()) {
+        //压缩包中的文件在资源重新加载前不会变化（重新加载资源时会清空缓存），不需要文件的大小和修改时间
+        xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
+        return GlobalManager::Instance().Zip().IsZipResExist(xmlFileFullPath);
+    }
+    if (xmlFilePath.IsRelativePath()) {
+        xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
     }
-    if (!isLoaded) {
+    else {
+        xmlFileFullPath = xmlFilePath;
+    }
+    return xmlFileFullPath.GetFileInfo(nFileSize, nFileTime);
+}
+
+FilePath WindowBuilder::GetIncludeFilePath(const DString& includeSource) const
+{
+    DString sourceValue = includeSource;
+    FilePath sourceXmlFilePath(sourceValue);
+    if (!sourceValue.empty()) {
+        StringUtil::ReplaceAll(_T("/"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
+        StringUtil::ReplaceAll(_T("\\"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
+        if (!m_xmlFilePath.IsEmpty()) {
+            //优先尝试在原XML文件相同目录加载
+            DString xmlFilePath = m_xmlFilePath.NativePath();
+            size_t pos = xmlFilePath.find_last_of(_T("\\/"));
+            if (pos != DString::npos) {
+                FilePath srcFilePath(xmlFilePath.substr(0, pos));
+                srcFilePath.JoinFilePath(FilePath(sourceValue));
+                if (IsXmlFileExists(srcFilePath)) {
+                    sourceXmlFilePath = srcFilePath;
+                }
+            }
+        }
+    }
+    return sourceXmlFilePath;
+}
+
+bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath)
+{
+    ASSERT(!xmlFilePath.IsEmpty() && _T("xmlFilePath 参数为空！"));
+    if (xmlFilePath.IsEmpty()) {
+        return false;
+    }
+    //按XML文件的大小和修改时间判断缓存及预编译的布局文件是否有效，不需要读取XML文件的内容
+    FilePath xmlFileFullPath;
+    uint64_t nFileSize = 0;
+    int64_t nFileTime = 0;
+    if (!GetXmlFileStamp(xmlFilePath, xmlFileFullPath, nFileSize, nFileTime)) {
         ASSERT(!_T("WindowBuilder::Create load xmlFilePath failed!"));
         return false;
     }
+    const DString cacheKey = xmlFileFullPath.ToString();
+
+    //1. 优先使用缓存中的布局数据（同一个XML文件只解析一次）
+    std::shared_ptr<const CompiledLayout> spCachedLayout = CompiledLayout::FindCache(cacheKey, nFileSize, nFileTime);
+    if (spCachedLayout != nullptr) {
+        m_layout = spCachedLayout;
+        m_xmlFilePath = xmlFilePath;
+        return true;
+    }
+
+    //2. 其次使用预编译的二进制布局文件（XML文件路径 + "c"，比如"main.xml"对应"main.xmlc"）
+    //   XML文件的大小和修改时间与编译时一致时直接使用；不一致时（比如文件被复制过），再按内容的哈希值校验
+    const bool bUseZip = GlobalManager::Instance().Zip().IsUseZip();
+    std::shared_ptr<CompiledLayout> spLayout;
+    std::vector<uint8_t> fileData;
+    const uint8_t* pFileData = nullptr;
+    size_t nFileDataSize = 0;
+    FilePath fileFullPath;
+    std::vector<uint8_t> compiledData;
+    const uint8_t* pCompiledData = nullptr;
+    size_t nCompiledDataSize = 0;
+    FilePath compiledFullPath;
+    if (ReadXmlFileData(GetCompiledLayoutFilePath(xmlFilePath), compiledData, pCompiledData, nCompiledDataSize, compiledFullPath) &&
+        (nCompiledDataSize > 0)) {
+        static const PerformanceStatId s_statId(_T("WindowBuilder::ParseXmlFile(compiled)"));
+        PerformanceStat statPerformance(s_statId);
+        spLayout = std::make_shared<CompiledLayout>();
+        if (!spLayout->LoadFromData(pCompiledData, nCompiledDataSize)) {
+            spLayout.reset();
+        }
+        else if (bUseZip || (spLayout->GetSourceSize() != nFileSize) || (spLayout->GetSourceTime() != nFileTime)) {
+            if (ReadXmlFileData(xmlFilePath, fileData, pFileData, nFileDataSize, fileFullPath) &&
+                (spLayout->GetSourceSize() == nFileDataSize) &&
+                (spLayout->GetSourceHash() == CompiledLayout::HashSourceData(pFileData, nFileDataSize))) {
+                spLayout->SetSourceTime(nFileTime);
+            }
+            else {
+                spLayout.reset();
+            }
+        }
+    }
+
+    //3. 解析XML文件，编译为布局数据
+    if (spLayout == nullptr) {
+        static const PerformanceStatId s_statId(_T("WindowBuilder::ParseXmlFile(xml)"));
+        PerformanceStat statPerformance(s_statId);
+        if ((nFileDataSize == 0) &&
+            (!ReadXmlFileData(xmlFilePath, fileData, pFileData, nFileDataSize, fileFullPath) || (nFileDataSize == 0))) {
+            ASSERT(!_T("WindowBuilder::Create load xmlFilePath failed!"));
+            return false;
+        }
+        pugi::xml_document xmlDoc;
+        pugi::xml_parse_result result = xmlDoc.load_buffer(pFileData, nFileDataSize);
+        if (result.status != pugi::status_ok) {
+            ASSERT(!_T("WindowBuilder::Create load xml file failed!"));
+            return false;
+        }
+        spLayout = std::make_shared<CompiledLayout>();
+        if (!spLayout->CompileXml(xmlDoc, CompiledLayout::HashSourceData(pFileData, nFileDataSize),
+                                  nFileDataSize, nFileTime)) {
+            ASSERT(!_T("WindowBuilder::Create compile xml file failed!"));
+            return false;
+        }
+    }
     m_xmlFilePath = xmlFilePath;
+    spLayout->ResolveClassIndex(&WindowBuilder::GetControlClassIndex);
+    spLayout->ResolveIncludePath([this](const DString& includeSource) {
+            return GetIncludeFilePath(includeSource);
+        });
+    CompiledLayout::AddCache(cacheKey, nFileSize, nFileTime, spLayout);
+    m_layout = spLayout;
     return true;
 }
 
+bool WindowBuilder::CompileXmlFile(const FilePath& xmlFilePath, const FilePath& outFilePath)
+{
+    std::vector<uint8_t> fileData;
+    if (!FileUtil::ReadFileData(xmlFilePath, fileData) || fileData.empty()) {
+        return false;
+    }
+    uint64_t nFileSize = 0;
+    int64_t nFileTime = 0;
+    if (!xmlFilePath.GetFileInfo(nFileSize, nFileTime)) {
+        return false;
+    }
+    pugi::xml_document xmlDoc;
+    pugi::xml_parse_result result = xmlDoc.load_buffer(fileData.data(), fileData.size());
+    if (result.status != pugi::status_ok) {
+        return false;
+    }
+    CompiledLayout layout;
+    if (!layout.CompileXml(xmlDoc, CompiledLayout::HashSourceData(fileData.data(), fileData.size()),
+                           fileData.size(), nFileTime)) {
+        return false;
+    }
+    std::vector<uint8_t> compiledData;
+    if (!layout.SaveToData(compiledData)) {
+        return false;
+    }
+    FilePath compiledFilePath = outFilePath;
+    if (compiledFilePath.IsEmpty()) {
+        compiledFilePath = GetCompiledLayoutFilePath(xmlFilePath);
+    }
+    return FileUtil::WriteFileData(compiledFilePath, compiledData);
+}
+
 Control* WindowBuilder::CreateControls(CreateControlCallback pCallback, Window* pWindow, Box* pParent, Box* pUserDefinedBox)
 {
+    static const PerformanceStatId s_statId(_T("WindowBuilder::CreateControls"));
+    PerformanceStat statPerformance(s_statId);
     m_createControlCallback = pCallback;
-    pugi::xml_node root = m_xml->root().first_child();
-    ASSERT(!root.empty());
-    if (root.empty()) {
+    const CompiledLayoutNode* pRoot = (m_layout != nullptr) ? m_layout->GetRootNode() : nullptr;
+    ASSERT(pRoot != nullptr);
+    if (pRoot == nullptr) {
         return nullptr;
     }
+    const CompiledLayout& layout = *m_layout;
+    const CompiledLayoutNode& root = *pRoot;
 
     if( pWindow != nullptr) {
-        DString strClass;
-        DString strName;
-        DString strValue;
-        strClass = root.name();
+        const DString& strClass = layout.GetNodeName(root);
         if( strClass == _T("Window") ) {
             if (!pWindow->IsWindowAttributesApplied()) {
                 //窗口的属性，只设置一次，避免XML中的包含的XML文件（Include标签）再次设置窗口属性，导致混乱
@@ -266,14 +477,10 @@ Control* WindowBuilder::CreateControls(CreateControlCallback pCallback, Window*
         }
     }
 
-    for (pugi::xml_node node : root.children()) {
-        DString strClass = node.name();
-        if ( (strClass == _T("Image"))          ||
-             (strClass == _T("FontResource"))   ||
-             (strClass == _T("Font"))           ||
-             (strClass == _T("Class"))          ||
-             (strClass == _T("TextColor")) ) {
-            //忽略这几个属性
+    for (uint32_t nChild = 0; nChild < root.m_nChildCount; ++nChild) {
+        const CompiledLayoutNode& node = layout.GetChildNode(root, nChild);
+        if (node.m_nodeType == CompiledLayoutNodeType::kResource) {
+            //忽略资源定义节点
 
         }
         else {
@@ -282,14 +489,11 @@ Control* WindowBuilder::CreateControls(CreateControlCallback pCallback, Window*
             }
             else {
                 ParseXmlNodeChildren(node, pUserDefinedBox, pWindow);
-                int i = 0;
-                for (pugi::xml_attribute attr : node.attributes()) {
-                    if (StringUtil::StringCompare(attr.name(), _T("class")) == 0) {
-                        //class必须是第一个属性
-                        ASSERT(i == 0);
-                    }
-                    ++i;
-                    pUserDefinedBox->SetAttribute(attr.name(), attr.value());
+                for (uint32_t i = 0; i < node.m_nAttrCount; ++i) {
+                    const DString& strName = layout.GetAttrName(node, i);
+                    //class必须是第一个属性
+                    ASSERT(i == 0 || strName != _T("class"));
+                    pUserDefinedBox->SetAttribute(strName, layout.GetAttrValue(node, i));
                 }
                 return pUserDefinedBox;
             }
@@ -298,14 +502,42 @@ Control* WindowBuilder::CreateControls(CreateControlCallback pCallback, Window*
     return nullptr;
 }
 
+/** 获取尺寸类型的属性值：优先使用编译时预先解析的值，否则解析属性字符串
+*/
+static void GetLayoutSizeValue(const CompiledLayout& layout, const CompiledLayoutNode& node, uint32_t nAttr, UiSize& size)
+{
+    const CompiledLayoutValue& value = layout.GetAttrTypedValue(node, nAttr);
+    if (value.m_type == CompiledLayoutValueType::kSize) {
+        size = UiSize(value.m_values[0], value.m_values[1]);
+    }
+    else {
+        AttributeUtil::ParseSizeValue(layout.GetAttrValue(node, nAttr).c_str(), size);
+    }
+}
+
+/** 获取矩形类型的属性值：优先使用编译时预先解析的值，否则解析属性字符串
+*/
+static void GetLayoutRectValue(const CompiledLayout& layout, const CompiledLayoutNode& node, uint32_t nAttr, UiRect& rect)
+{
+    const CompiledLayoutValue& value = layout.GetAttrTypedValue(node, nAttr);
+    if (value.m_type == CompiledLayoutValueType::kRect) {
+        rect = UiRect(value.m_values[0], value.m_values[1], value.m_values[2], value.m_values[3]);
+    }
+    else {
+        AttributeUtil::ParseRectValue(layout.GetAttrValue(node, nAttr).c_str(), rect);
+    }
+}
+
 bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAttributes)
 {
-    pugi::xml_node root = m_xml->root().first_child();
-    ASSERT(!root.empty());
-    if (root.empty()) {
+    const CompiledLayoutNode* pRoot = (m_layout != nullptr) ? m_layout->GetRootNode() : nullptr;
+    ASSERT(pRoot != nullptr);
+    if (pRoot == nullptr) {
         return false;
     }
-    DString strClass = root.name();
+    const CompiledLayout& layout = *m_layout;
+    const CompiledLayoutNode& root = *pRoot;
+    const DString& strClass = layout.GetNodeName(root);
     ASSERT(strClass == _T("Window"));
     if (strClass != _T("Window")) {
         return false;
@@ -317,11 +549,9 @@ bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAt
     bool bScaledCY = false;
 
     RenderBackendType backendType = RenderBackendType::kRaster_BackendType;
-    DString strName;
-    DString strValue;
-    for (pugi::xml_attribute attr : root.attributes()) {
-        strName = attr.name();
-        strValue = attr.value();
+    for (uint32_t nAttr = 0; nAttr < root.m_nAttrCount; ++nAttr) {
+        const DString& strName = layout.GetAttrName(root, nAttr);
+        const DString& strValue = layout.GetAttrValue(root, nAttr);
         if (strName == _T("render_backend_type")) {            
             if (StringUtil::IsEqualNoCase(strValue, _T("GL")) || StringUtil::IsEqualNoCase(strValue, _T("GPU"))) {
                 backendType = RenderBackendType::kNativeGL_BackendType;
@@ -335,11 +565,11 @@ bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAt
             createAttributes.m_bUseSystemCaptionDefined = true;
         }
         else if (strName == _T("sizebox")) {
-            AttributeUtil::ParseRectValue(strValue.c_str(), createAttributes.m_rcSizeBox);
+            GetLayoutRectValue(layout, root, nAttr, createAttributes.m_rcSizeBox);
             createAttributes.m_bSizeBoxDefined = true;
         }
         if (strName == _T("caption")) {
-            AttributeUtil::ParseRectValue(strValue.c_str(), createAttributes.m_rcCaption);
+            GetLayoutRectValue(layout, root, nAttr, createAttributes.m_rcCaption);
             createAttributes.m_bCaptionDefined = true;
         }
         else if ((strName == _T("shadow_attached")) || (strName == _T("shadowattached"))) {
@@ -373,10 +603,10 @@ bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAt
             createAttributes.m_bInitSizeDefined = true;
         }
         else if (strName == _T("mininfo")) {
-            AttributeUtil::ParseSizeValue(strValue.c_str(), szMinSize);
+            GetLayoutSizeValue(layout, root, nAttr, szMinSize);
         }
         else if (strName == _T("maxinfo")) {
-            AttributeUtil::ParseSizeValue(strValue.c_str(), szMaxSize);
+            GetLayoutSizeValue(layout, root, nAttr, szMaxSize);
         }
         else if (strName == _T("sdl_render_name")) {
             //期望的SDL Render的名称
@@ -430,21 +660,19 @@ bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAt
     return true;
 }
 
-void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node& root) const
+void WindowBuilder::ParseWindowAttributes(Window* pWindow, const CompiledLayoutNode& root) const
 {
     ASSERT((pWindow != nullptr) && pWindow->IsWindow());
     if ((pWindow == nullptr) || !pWindow->IsWindow()) {
         return;
     }
-
-    DString strName;
-    DString strValue;
+    const CompiledLayout& layout = *m_layout;
 
     bool bInitRenderBackendType = false;
     //首先设置"render_backend_type"属性
-    for (pugi::xml_attribute attr : root.attributes()) {
-        strName = attr.name();
-        strValue = attr.value();
+    for (uint32_t nAttr = 0; nAttr < root.m_nAttrCount; ++nAttr) {
+        const DString& strName = layout.GetAttrName(root, nAttr);
+        const DString& strValue = layout.GetAttrValue(root, nAttr);
         if (strName == _T("render_backend_type")) {
             RenderBackendType backendType = RenderBackendType::kRaster_BackendType;
             if (StringUtil::IsEqualNoCase(strValue, _T("GL")) || StringUtil::IsEqualNoCase(strValue, _T("GPU"))) {
@@ -467,17 +695,17 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
     }
      
     //首先处理mininfo/maxinfo/use_system_caption，因为其他属性有用到这些个属性的
-    for (pugi::xml_attribute attr : root.attributes()) {
-        strName = attr.name();
-        strValue = attr.value();
+    for (uint32_t nAttr = 0; nAttr < root.m_nAttrCount; ++nAttr) {
+        const DString& strName = layout.GetAttrName(root, nAttr);
+        const DString& strValue = layout.GetAttrValue(root, nAttr);
         if (strName == _T("mininfo")) {
             UiSize size;
-            AttributeUtil::ParseSizeValue(strValue.c_str(), size);
+            GetLayoutSizeValue(layout, root, nAttr, size);
             pWindow->SetWindowMinimumSize(size, true);
         }
         else if (strName == _T("maxinfo")) {
             UiSize size;
-            AttributeUtil::ParseSizeValue(strValue.c_str(), size);
+            GetLayoutSizeValue(layout, root, nAttr, size);
             pWindow->SetWindowMaximumSize(size, true);
         }
         else if (strName == _T("use_system_caption")) {
@@ -486,17 +714,17 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
     }
 
     //注：如果use_system_caption为true，则层窗口关闭（因为这两个属性互斥的）
-    for (pugi::xml_attribute attr : root.attributes()) {
-        strName = attr.name();
-        strValue = attr.value();
+    for (uint32_t nAttr = 0; nAttr < root.m_nAttrCount; ++nAttr) {
+        const DString& strName = layout.GetAttrName(root, nAttr);
+        const DString& strValue = layout.GetAttrValue(root, nAttr);
         if (strName == _T("sizebox")) {
             UiRect rcSizeBox;
-            AttributeUtil::ParseRectValue(strValue.c_str(), rcSizeBox);
+            GetLayoutRectValue(layout, root, nAttr, rcSizeBox);
             pWindow->SetSizeBox(rcSizeBox, true);
         }
         else if (strName == _T("caption")) {
             UiRect rcCaption;
-            AttributeUtil::ParseRectValue(strValue.c_str(), rcCaption);
+            GetLayoutRectValue(layout, root, nAttr, rcCaption);
             pWindow->SetCaptionRect(rcCaption, true);
         }
         else if (strName == _T("snap_layout_menu")) {
@@ -507,7 +735,7 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
         }
         else if (strName == _T("sys_menu_rect")) {
             UiRect rcSysMenuRect;
-            AttributeUtil::ParseRectValue(strValue.c_str(), rcSysMenuRect);
+            GetLayoutRectValue(layout, root, nAttr, rcSysMenuRect);
             pWindow->SetSysMenuRect(rcSysMenuRect, true);
         }
         else if (strName == _T("icon")) {
@@ -524,18 +752,22 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
         }
         else if (strName == _T("round_corner") || strName == _T("roundcorner")) {
             UiSize size;
-            AttributeUtil::ParseSizeValue(strValue.c_str(), size);
+            GetLayoutSizeValue(layout, root, nAttr, size);
             pWindow->SetRoundCorner(size.cx, size.cy, true);
         }
         else if (strName == _T("alpha_fix_corner") || strName == _T("alphafixcorner")) {
             UiRect rc;
-            AttributeUtil::ParseRectValue(strValue.c_str(), rc);
+            GetLayoutRectValue(layout, root, nAttr, rc);
             pWindow->SetAlphaFixCorner(rc, true);
         }
         else if ((strName == _T("shadow_attached")) || (strName == _T("shadowattached"))) {
             //设置是否支持窗口阴影（阴影实现有两种：分层窗口和普通窗口）
             pWindow->SetShadowAttached(strValue == _T("true"));
         }
+        else if (strName == _T("parallel_paint")) {
+            //设置是否启用并行绘制（重绘区域较大时，多线程并行光栅化）
+            pWindow->SetEnableParallelPaint(strValue == _T("true"));
+        }
         else if ((strName == _T("shadow_image")) || (strName == _T("shadowimage"))) {
             //设置阴影图片
             pWindow->SetShadowImage(strValue);
@@ -564,9 +796,9 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
 
     //最后设置窗口的初始化大小，因为初始化大小与是否阴影等相关
     bool bLayeredWindowOpacityDefined = false;
-    for (pugi::xml_attribute attr : root.attributes()) {
-        strName = attr.name();
-        strValue = attr.value();
+    for (uint32_t nAttr = 0; nAttr < root.m_nAttrCount; ++nAttr) {
+        const DString& strName = layout.GetAttrName(root, nAttr);
+        const DString& strValue = layout.GetAttrValue(root, nAttr);
         if (strName == _T("size")) {
             UiSize windowSize;
             AttributeUtil::ParseWindowSize(pWindow, strValue.c_str(), windowSize);
@@ -613,26 +845,27 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
 #endif
 }
 
-void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const pugi::xml_node& root) const
+void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const CompiledLayoutNode& root) const
 {
     ASSERT((pWindow != nullptr) && pWindow->IsWindow());
     if ((pWindow == nullptr) || !pWindow->IsWindow()) {
         return;
     }
-
-    DString strName;
-    DString strValue;
-    DString strClass;
+    const CompiledLayout& layout = *m_layout;
 
     //解析该窗口下的共享资源
-    for (pugi::xml_node node : root.children()) {
-        strClass = node.name();
+    for (uint32_t nChild = 0; nChild < root.m_nChildCount; ++nChild) {
+        const CompiledLayoutNode& node = layout.GetChildNode(root, nChild);
+        if (node.m_nodeType != CompiledLayoutNodeType::kResource) {
+            continue;
+        }
+        const DString& strClass = layout.GetNodeName(node);
         if (strClass == _T("Class")) {
             DString strClassName;
             DString strAttribute;
-            for (pugi::xml_attribute attr : node.attributes()) {
-                strName = attr.name();
-                strValue = attr.value();
+            for (uint32_t nAttr = 0; nAttr < node.m_nAttrCount; ++nAttr) {
+                const DString& strName = layout.GetAttrName(node, nAttr);
+                const DString& strValue = layout.GetAttrValue(node, nAttr);
                 if (strName == _T("name")) {
                     strClassName = strValue;
                 }
@@ -650,18 +883,26 @@ void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const pugi::xml_
         else if (strClass == _T("TextColor")) {
             DString strColorName;
             DString strColor;
-            for (pugi::xml_attribute attr : node.attributes()) {
-                strName = attr.name();
-                strValue = attr.value();
+            const CompiledLayoutValue* pColorValue = nullptr;
+            for (uint32_t nAttr = 0; nAttr < node.m_nAttrCount; ++nAttr) {
+                const DString& strName = layout.GetAttrName(node, nAttr);
+                const DString& strValue = layout.GetAttrValue(node, nAttr);
                 if (strName == _T("name")) {
                     strColorName = strValue;
                 }
                 else if (strName == _T("value")) {
                     strColor = strValue;
+                    pColorValue = &layout.GetAttrTypedValue(node, nAttr);
                 }
             }
             if (!strColorName.empty()) {
-                pWindow->AddTextColor(strColorName, strColor);
+                if ((pColorValue != nullptr) && (pColorValue->m_type == CompiledLayoutValueType::kColor)) {
+                    //颜色值在编译时已经解析
+                    pWindow->AddTextColor(strColorName, UiColor((UiColor::ARGB)pColorValue->m_values[0]));
+                }
+                else {
+                    pWindow->AddTextColor(strColorName, strColor);
+                }
             }
         }
         else if (strClass == _T("Font")) {
@@ -671,18 +912,45 @@ void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const pugi::xml_
     }
 }
 
-void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root) const
+bool WindowBuilder::GetGlobalFontFiles(std::vector<DString>& fontFiles) const
 {
-    DString strClass;
-    DString strName;
-    DString strValue;
-    for (pugi::xml_node node : root.children()) {
-        strClass = node.name();
+    fontFiles.clear();
+    const CompiledLayoutNode* pRoot = (m_layout != nullptr) ? m_layout->GetRootNode() : nullptr;
+    if (pRoot == nullptr) {
+        return false;
+    }
+    const CompiledLayout& layout = *m_layout;
+    const CompiledLayoutNode& root = *pRoot;
+    if (layout.GetNodeName(root) != _T("Global")) {
+        return false;
+    }
+    for (uint32_t nChild = 0; nChild < root.m_nChildCount; ++nChild) {
+        const CompiledLayoutNode& node = layout.GetChildNode(root, nChild);
+        if ((node.m_nodeType == CompiledLayoutNodeType::kResource) &&
+            (layout.GetNodeName(node) == _T("FontFile"))) {
+            const DString& strFontFile = layout.FindAttrValue(node, _T("file"));
+            if (!strFontFile.empty()) {
+                fontFiles.push_back(strFontFile);
+            }
+        }
+    }
+    return true;
+}
+
+void WindowBuilder::ParseGlobalAttributes(const CompiledLayoutNode& root) const
+{
+    const CompiledLayout& layout = *m_layout;
+    for (uint32_t nChild = 0; nChild < root.m_nChildCount; ++nChild) {
+        const CompiledLayoutNode& node = layout.GetChildNode(root, nChild);
+        if (node.m_nodeType != CompiledLayoutNodeType::kResource) {
+            continue;
+        }
+        const DString& strClass = layout.GetNodeName(node);
         if (strClass == _T("DefaultFontFamilyNames")) {
             DString defaultFontFamilyNames;
-            for (pugi::xml_attribute attr : node.attributes()) {
-                strName = attr.name();
-                strValue = attr.value();
+            for (uint32_t nAttr = 0; nAttr < node.m_nAttrCount; ++nAttr) {
+                const DString& strName = layout.GetAttrName(node, nAttr);
+                const DString& strValue = layout.GetAttrValue(node, nAttr);
                 if (strName == _T("value")) {
                     defaultFontFamilyNames = strValue;
                     break;
@@ -696,9 +964,9 @@ void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root) const
             //字体文件
             DString strFontFile;
             DString strFontDesc;
-            for (pugi::xml_attribute attr : node.attributes()) {
-                strName = attr.name();
-                strValue = attr.value();
+            for (uint32_t nAttr = 0; nAttr < node.m_nAttrCount; ++nAttr) {
+                const DString& strName = layout.GetAttrName(node, nAttr);
+                const DString& strValue = layout.GetAttrValue(node, nAttr);
                 if (strName == _T("file")) {
                     strFontFile = strValue;
                 }
@@ -716,9 +984,9 @@ void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root) const
         else if (strClass == _T("Class")) {
             DString strClassName;
             DString strAttribute;
-            for (pugi::xml_attribute attr : node.attributes()) {
-                strName = attr.name();
-                strValue = attr.value();
+            for (uint32_t nAttr = 0; nAttr < node.m_nAttrCount; ++nAttr) {
+                const DString& strName = layout.GetAttrName(node, nAttr);
+                const DString& strValue = layout.GetAttrValue(node, nAttr);
                 if (strName == _T("name")) {
                     strClassName = strValue;
                 }
@@ -733,11 +1001,24 @@ void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root) const
             }
         }
         else if (strClass == _T("TextColor")) {
-            DString colorName = node.attribute(_T("name")).as_string();
-            DString colorValue = node.attribute(_T("value")).as_string();
+            const DString& colorName = layout.FindAttrValue(node, _T("name"));
+            const DString& colorValue = layout.FindAttrValue(node, _T("value"));
             if (!colorName.empty() && !colorValue.empty()) {
                 ColorManager& colorManager = GlobalManager::Instance().Color();
-                colorManager.AddColor(colorName, colorValue);
+                const CompiledLayoutValue* pColorValue = nullptr;
+                for (uint32_t nAttr = 0; nAttr < node.m_nAttrCount; ++nAttr) {
+                    if (layout.GetAttrName(node, nAttr) == _T("value")) {
+                        pColorValue = &layout.GetAttrTypedValue(node, nAttr);
+                        break;
+                    }
+                }
+                if ((pColorValue != nullptr) && (pColorValue->m_type == CompiledLayoutValueType::kColor)) {
+                    //颜色值在编译时已经解析
+                    colorManager.AddColor(colorName, UiColor((UiColor::ARGB)pColorValue->m_values[0]));
+                }
+                else {
+                    colorManager.AddColor(colorName, colorValue);
+                }
                 if (colorName == _T("default_font_color")) {
                     colorManager.SetDefaultTextColor(colorName);
                 }
@@ -749,10 +1030,9 @@ void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root) const
     }
 }
 
-void WindowBuilder::ParseFontXmlNode(const pugi::xml_node& xmlNode) const
+void WindowBuilder::ParseFontXmlNode(const CompiledLayoutNode& xmlNode) const
 {
-    DString strName;
-    DString strValue;
+    const CompiledLayout& layout = *m_layout;
 
     DString strFontId;
     DString strFontName;
@@ -762,9 +1042,9 @@ void WindowBuilder::ParseFontXmlNode(const pugi::xml_node& xmlNode) const
     bool strikeout = false;
     bool italic = false;
     bool isDefault = false;
-    for (pugi::xml_attribute attr : xmlNode.attributes()) {
-        strName = attr.name();
-        strValue = attr.value();
+    for (uint32_t nAttr = 0; nAttr < xmlNode.m_nAttrCount; ++nAttr) {
+        const DString& strName = layout.GetAttrName(xmlNode, nAttr);
+        const DString& strValue = layout.GetAttrValue(xmlNode, nAttr);
         if (strName == _T("id"))
         {
             strFontId = strValue;
@@ -803,81 +1083,49 @@ void WindowBuilder::ParseFontXmlNode(const pugi::xml_node& xmlNode) const
     }
 }
 
-Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Control* pParent, Window* pWindow)
+Control* WindowBuilder::ParseXmlNodeChildren(const CompiledLayoutNode& xmlNode, Control* pParent, Window* pWindow)
 {
-    if (xmlNode.empty()) {
+    if (xmlNode.m_nChildCount == 0) {
         return nullptr;
     }
+    const CompiledLayout& layout = *m_layout;
     Control* pReturn = nullptr;
-    for (pugi::xml_node node : xmlNode.children()) {
-        DString strClass = node.name();
-        if( (strClass == _T("DefaultFontFamilyNames")) ||
-            (strClass == _T("Font")) ||
-            (strClass == _T("FontFile"))  ||
-            (strClass == _T("Class")) || 
-            (strClass == _T("TextColor")) ) {
-                continue;
+    for (uint32_t nChild = 0; nChild < xmlNode.m_nChildCount; ++nChild) {
+        const CompiledLayoutNode& node = layout.GetChildNode(xmlNode, nChild);
+        if (node.m_nodeType == CompiledLayoutNodeType::kResource) {
+            continue;
         }
 
+        const DString& strClass = layout.GetNodeName(node);
         Control* pControl = nullptr;
-        if (strClass == _T("Include")) {
-            if (node.attributes().empty()) {
+        if (node.m_nodeType == CompiledLayoutNodeType::kInclude) {
+            if (node.m_nAttrCount == 0) {
                 continue;
             }
-            pugi::xml_attribute countAttr = node.attribute(_T("count"));
-            int nCount = countAttr.as_int();
-            if (nCount <= 0) {
-                //默认值设置为1，count这个属性参数为可选
-                nCount = 1;
-            }
-            pugi::xml_attribute sourceAttr = node.attribute(_T("src"));
-            DString sourceValue = sourceAttr.as_string();
-            if (sourceValue.empty()) {
-                sourceAttr = node.attribute(_T("source"));
-                sourceValue = sourceAttr.as_string();                
-            }
-            FilePath sourceXmlFilePath(sourceValue);
-            if (!sourceValue.empty()) {
-                StringUtil::ReplaceAll(_T("/"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
-                StringUtil::ReplaceAll(_T("\\"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
-                if (!m_xmlFilePath.IsEmpty()) {
-                    //优先尝试在原XML文件相同目录加载
-                    DString xmlFilePath = m_xmlFilePath.NativePath();
-                    size_t pos = xmlFilePath.find_last_of(_T("\\/"));
-                    if (pos != DString::npos) {
-                        FilePath srcFilePath(xmlFilePath.substr(0, pos));
-                        srcFilePath.JoinFilePath(FilePath(sourceValue));
-                        if (IsXmlFileExists(srcFilePath)) {
-                            sourceXmlFilePath = srcFilePath;
-                        }
-                    }
-                }
-            }
+            //包含次数和被包含的XML文件路径在加载布局数据时已经解析
+            const int32_t nCount = layout.GetIncludeCount(node);
+            const FilePath& sourceXmlFilePath = layout.GetIncludePath(node);
             ASSERT(!sourceXmlFilePath.IsEmpty());
             if (sourceXmlFilePath.IsEmpty()) {
                 continue;
             }
-            for ( int i = 0; i < nCount; i++ ) {
-                WindowBuilder builder;
-                if (builder.ParseXmlFile(sourceXmlFilePath)) {
+            //被包含的XML文件只解析一次（布局数据有缓存），多次创建时直接使用
+            WindowBuilder builder;
+            if (builder.ParseXmlFile(sourceXmlFilePath)) {
+                for (int i = 0; i < nCount; i++) {
                     pControl = builder.CreateControls(m_createControlCallback, pWindow, ToBox(pParent));
                 }
-                else {
-                    pControl = nullptr;
-                }                
             }
             continue;
         }
+        else if ((node.m_nodeType == CompiledLayoutNodeType::kEvent) ||
+                 (node.m_nodeType == CompiledLayoutNodeType::kBubbledEvent)) {
+            bool bBubbled = (node.m_nodeType == CompiledLayoutNodeType::kBubbledEvent);
+            AttachXmlEvent(bBubbled, node, pParent);
+            continue;
+        }
         else {
-            pControl = CreateControlByClass(strClass, pWindow);
-            if (pControl == nullptr) {
-                if ((strClass == _T("Event")) || 
-                    (strClass == _T("BubbledEvent"))) {
-                    bool bBubbled = (strClass == _T("BubbledEvent"));
-                    AttachXmlEvent(bBubbled, node, pParent);
-                    continue;
-                }
-            }
+            pControl = CreateControlByClassIndex(node.m_nClassIndex, pWindow);
 
             // User-supplied control factory
             if( pControl == nullptr) {
@@ -890,13 +1138,12 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
         }
 
         if(pControl == nullptr) {
-            DString nodeName = strClass;
             ASSERT(!"Found unknown node name, can't create control!");
             continue;
         }
 
         // TreeView相关必须先添加后解析
-        if (strClass == DUI_CTR_TREENODE) {
+        if (node.m_nodeType == CompiledLayoutNodeType::kTreeNode) {
             bool bAdded = false;
             TreeNode* pNode = dynamic_cast<TreeNode*>(pControl);
             ASSERT(pNode != nullptr);
@@ -928,18 +1175,30 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
         pControl->SetWindow(pWindow);
         
         // Process attributes
-        if(!node.attributes().empty()) {
-            //读取节点的属性，设置控件的属性
-            int i = 0;
-            for (pugi::xml_attribute attr : node.attributes()) {
-                ASSERT(i == 0 || StringUtil::StringCompare(attr.name(), _T("class")) != 0);    //class必须是第一个属性
-                ++i;
-                pControl->SetAttribute(attr.name(), attr.value());
+        //读取节点的属性，设置控件的属性
+        uint32_t nAttr = 0;
+        if (node.m_nClassCount > 0) {
+            //class属性在编译时已经拆分为Class名称列表
+            for (uint32_t nClass = 0; nClass < node.m_nClassCount; ++nClass) {
+                pControl->ApplyClass(layout.GetNodeClassName(node, nClass));
+            }
+            nAttr = 1;
+        }
+        for (; nAttr < node.m_nAttrCount; ++nAttr) {
+            const DString& strName = layout.GetAttrName(node, nAttr);
+            ASSERT(nAttr == 0 || strName != _T("class"));    //class必须是第一个属性
+            const CompiledLayoutValue& typedValue = layout.GetAttrTypedValue(node, nAttr);
+            if (typedValue.m_type != CompiledLayoutValueType::kString) {
+                //数值、矩形等属性值在编译时已经解析
+                pControl->SetParsedAttribute(strName, layout.GetAttrValue(node, nAttr), typedValue);
+            }
+            else {
+                pControl->SetAttribute(strName, layout.GetAttrValue(node, nAttr));
             }
         }
 
-        if (strClass == DUI_CTR_RICHTEXT) {
-            ParseRichTextXmlNode(node, pControl);
+        if (node.m_nodeType == CompiledLayoutNodeType::kRichText) {
+            ParseRichTextXmlText(layout.GetString(node.m_nRichText), pControl);
 #ifdef _DEBUG
             //测试效果：反向生成带格式的文本，用于测试验证解析的正确性
             RichText* pRichText = dynamic_cast<RichText*>(pControl);
@@ -952,7 +1211,7 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
         }
         else {
             // Add children
-            if (!node.children().empty()) {
+            if (node.m_nChildCount > 0) {
                 //递归该节点的所有子节点，继续添加
                 ParseXmlNodeChildren(node, pControl, pWindow);
             }
@@ -960,7 +1219,7 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
 
         // Attach to parent
         // 因为某些属性和父窗口相关，比如selected，必须先Add到父窗口
-        if (pParent != nullptr && strClass != DUI_CTR_TREENODE) {
+        if (pParent != nullptr && node.m_nodeType != CompiledLayoutNodeType::kTreeNode) {
             Box* pContainer = dynamic_cast<Box*>(pParent);
             ASSERT(pContainer != nullptr);
             if (pContainer == nullptr) {
@@ -1097,25 +1356,22 @@ bool WindowBuilder::ParseRichTextXmlNode(const pugi::xml_node& xmlNode, Control*
     return true;
 }
 
-void WindowBuilder::AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Control* pParent)
+void WindowBuilder::AttachXmlEvent(bool bBubbled, const CompiledLayoutNode& node, Control* pParent)
 {
     ASSERT(pParent != nullptr);
     if (pParent == nullptr) {
         return;
     }
+    const CompiledLayout& layout = *m_layout;
     DString strType;
     DString strReceiver;
     DString strApplyAttribute;
-    DString strName;
-    DString strValue;
-    int i = 0;
-    for (pugi::xml_attribute attr : node.attributes()) {
-        strName = attr.name();
-        strValue = attr.value();
-        ASSERT(i != 0 || strName == _T("type"));
-        ASSERT(i != 1 || strName == _T("receiver"));
-        ASSERT(i != 2 || strName == _T("applyattribute"));
-        ++i;
+    for (uint32_t nAttr = 0; nAttr < node.m_nAttrCount; ++nAttr) {
+        const DString& strName = layout.GetAttrName(node, nAttr);
+        const DString& strValue = layout.GetAttrValue(node, nAttr);
+        ASSERT(nAttr != 0 || strName == _T("type"));
+        ASSERT(nAttr != 1 || strName == _T("receiver"));
+        ASSERT(nAttr != 2 || strName == _T("applyattribute"));
         if( strName == _T("type") ) {
             strType = strValue;
         }
@@ -7,6 +7,7 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace pugi
 {
@@ -23,12 +24,19 @@ class Window;
 class Control;
 class RichTextSlice;
 class WindowCreateAttributes;
+class CompiledLayout;
+struct CompiledLayoutNode;
 
 /** 创建控件的回调函数
 */
 typedef std::function<Control* (const DString&)> CreateControlCallback;
 
 /** 根据XML文件，解析并创建控件和布局
+*   XML文件解析后编译为紧凑的布局数据（CompiledLayout）并缓存，同一个XML文件只解析一次；
+*   缓存按XML文件的大小和修改时间校验，命中缓存时不读取XML文件；
+*   如果XML文件同目录下存在预编译的布局文件（比如"main.xml"对应"main.xmlc"，由CompileXmlFile生成），
+*   并且与XML文件一致（大小和修改时间一致，或者内容的哈希值一致），则直接加载预编译的布局文件，不再解析XML；
+*   不一致时自动使用XML文件
 */
 class UILIB_API WindowBuilder
 {
@@ -52,6 +60,13 @@ public:
     */
     bool ParseXmlFile(const FilePath& xmlFilePath);
 
+    /** 离线编译XML文件，生成预编译的布局文件（可在发布资源前，对所有布局XML文件执行一次）
+    * @param [in] xmlFilePath XML文件的完整路径
+    * @param [in] outFilePath 预编译布局文件的完整路径，如果为空，则保存在XML文件同目录（XML文件路径 + "c"）
+    * @return 编译成功返回true，否则返回false
+    */
+    static bool CompileXmlFile(const FilePath& xmlFilePath, const FilePath& outFilePath = FilePath());
+
     /** 使用缓存中已经解析过的XML文件或者数据创建窗口布局等（即CreateFromXmlData和CreateFromXmlFile解析后的结果）
     * @param [in] pCallback 根据Class名称创建控件（或容器）的函数，适用于自定义控件
     * @param [in] pWindow 关联的窗口
@@ -73,6 +88,12 @@ public:
     */
     bool ParseWindowCreateAttributes(WindowCreateAttributes& createAttributes);
 
+    /** 获取全局资源（根XML节点名称："Global"）中定义的字体文件列表，需先调用ParseXmlFile或者ParseXmlData
+    *   该函数不访问控件和窗口，可在工作线程中调用（用于预先读取字体文件）
+    * @param [out] fontFiles 返回字体文件名列表（FontFile节点的file属性）
+    */
+    bool GetGlobalFontFiles(std::vector<DString>& fontFiles) const;
+
 public:
     /** 解析带格式的文本内容，并设置到RichText Control对象
     * @param [in] xmlText 带格式的文本内容
@@ -90,34 +111,42 @@ public:
 private:
     /** 解析窗口的属性(根XML节点名称："Window")
     */
-    void ParseWindowAttributes(Window* pWindow, const pugi::xml_node& root) const;
+    void ParseWindowAttributes(Window* pWindow, const CompiledLayoutNode& root) const;
 
     /** 解析窗口下的共享资源属性(根XML节点名称："Window")，这些属性只有本窗口能使用
     */
-    void ParseWindowShareAttributes(Window* pWindow, const pugi::xml_node& root) const;
+    void ParseWindowShareAttributes(Window* pWindow, const CompiledLayoutNode& root) const;
 
     /** 解析全局资源的属性(根XML节点名称："Global")，这些属性，所有窗口都可以使用
     */
-    void ParseGlobalAttributes(const pugi::xml_node& root) const;
+    void ParseGlobalAttributes(const CompiledLayoutNode& root) const;
 
     /** 解析XML节点的子节点
     * @param [in] xmlNode xml节点
     * @param [in] pParent 父控件，可能是普通控件（参数只传入，未用到），也可能是容器（用时转换为容器）
     * @return 返回第一个创建的节点，可能是普通控件，也可能是容器
     */
-    Control* ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Control* pParent = nullptr, Window* pWindow = nullptr);
+    Control* ParseXmlNodeChildren(const CompiledLayoutNode& xmlNode, Control* pParent = nullptr, Window* pWindow = nullptr);
 
     /** 根据控件的Class名称，创建控件（或容器）
     */
     Control* CreateControlByClass(const DString& strControlClass, Window* pWindow);
 
+    /** 根据控件的Class名称，获取内置控件的类型索引，如果不是内置控件返回-1
+    */
+    static int32_t GetControlClassIndex(const DString& strControlClass);
+
+    /** 根据内置控件的类型索引，创建控件（或容器）
+    */
+    static Control* CreateControlByClassIndex(int32_t nClassIndex, Window* pWindow);
+
     /** 创建XML事件（XML节点为<Event>或者<BubbledEvent>）
     *   举例子：
     *   <Option text="单项选择" margin="8,0,0,0" borderround="2,2" valign="center">
     *       <Event type="buttonup" receiver="tree" applyattribute="multi_select={false}" />
     *   </Option>
     */
-    void AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Control* pParent);
+    void AttachXmlEvent(bool bBubbled, const CompiledLayoutNode& node, Control* pParent);
 
     /** 判断XML文件是否存在
     */
@@ -125,13 +154,41 @@ private:
 
     /** 解析字体节点
     */
-    void ParseFontXmlNode(const pugi::xml_node& xmlNode) const;
+    void ParseFontXmlNode(const CompiledLayoutNode& xmlNode) const;
+
+    /** 读取XML文件（或预编译布局文件）的数据：压缩包中未压缩存储的文件，直接引用压缩包中的数据，不复制
+    * @param [in] xmlFilePath 文件路径
+    * @param [out] fileData 需要复制文件数据时，存放文件数据
+    * @param [out] pData 返回文件数据的起始地址（指向fileData，或者压缩包中的数据）
+    * @param [out] nDataSize 返回文件数据的长度
+    * @param [out] xmlFileFullPath 返回文件的完整路径
+    */
+    static bool ReadXmlFileData(const FilePath& xmlFilePath, std::vector<uint8_t>& fileData,
+                                const uint8_t*& pData, size_t& nDataSize, FilePath& xmlFileFullPath);
+
+    /** 获取XML文件对应的预编译布局文件路径
+    */
+    static FilePath GetCompiledLayoutFilePath(const FilePath& xmlFilePath);
+
+    /** 获取XML文件的完整路径、大小和最后修改时间（不读取文件内容，用于判断缓存的布局数据是否有效）
+    * @param [in] xmlFilePath 文件路径
+    * @param [out] xmlFileFullPath 返回文件的完整路径
+    * @param [out] nFileSize 返回文件的大小（使用压缩包时为0）
+    * @param [out] nFileTime 返回文件的最后修改时间（使用压缩包时为0）
+    */
+    static bool GetXmlFileStamp(const FilePath& xmlFilePath, FilePath& xmlFileFullPath,
+                                uint64_t& nFileSize, int64_t& nFileTime);
+
+    /** 获取<Include>节点中被包含XML文件的路径（优先使用与当前XML文件相同目录下的文件）
+    * @param [in] includeSource <Include>节点的"src"属性值
+    */
+    FilePath GetIncludeFilePath(const DString& includeSource) const;
 
 private:
     
-    /** 当前解析的XML文档对象
+    /** 当前解析的布局数据（XML文件编译后的数据，多个WindowBuilder对象可共享）
     */
-    std::unique_ptr<pugi::xml_document> m_xml;
+    std::shared_ptr<const CompiledLayout> m_layout;
 
     /** 创建Control的回调接口
     */
@@ -0,0 +1,177 @@
+#include "WindowPool.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Core/GlobalManager.h"
+
+namespace ui
+{
+
+WindowPool::WindowPool():
+    m_nMaxWindowCount(8),
+    m_nMaxMemorySize(32 * 1024 * 1024),
+    m_nHitCount(0),
+    m_nMissCount(0)
+{
+}
+
+WindowPool::~WindowPool()
+{
+}
+
+size_t WindowPool::EstimateMemorySize(Window* pWindow)
+{
+    UiRect rcWindow;
+    pWindow->GetWindowRect(rcWindow);
+    return (size_t)rcWindow.Width() * (size_t)rcWindow.Height() * sizeof(uint32_t);
+}
+
+bool WindowPool::AddWindow(const DString& poolKey, Window* pWindow)
+{
+    GlobalManager::Instance().AssertUIThread();
+    ASSERT(pWindow != nullptr);
+    if ((pWindow == nullptr) || !pWindow->IsWindow() || pWindow->IsClosingWnd() || (m_nMaxWindowCount == 0)) {
+        return false;
+    }
+    ASSERT(!pWindow->IsWindowVisible());
+    for (const PoolItem& item : m_items) {
+        if (item.m_pWindow == pWindow) {
+            //已经在池中
+            return true;
+        }
+    }
+    PoolItem item;
+    item.m_poolKey = poolKey;
+    item.m_pWindow = pWindow;
+    item.m_windowFlag = pWindow->GetWeakFlag();
+    item.m_pParentWindow = pWindow->GetParentWindow();
+    if (item.m_pParentWindow != nullptr) {
+        item.m_parentFlag = pWindow->GetParentWindow()->GetWeakFlag();
+    }
+    item.m_nMemorySize = EstimateMemorySize(pWindow);
+    if (item.m_nMemorySize > m_nMaxMemorySize) {
+        return false;
+    }
+    m_items.push_back(item);
+    CheckLimits();
+    return true;
+}
+
+Window* WindowPool::TakeWindow(const DString& poolKey, const Window* pParentWindow)
+{
+    GlobalManager::Instance().AssertUIThread();
+    Window* pWindow = nullptr;
+    //从最近放入的窗口开始查找
+    for (auto iter = m_items.rbegin(); iter != m_items.rend(); ++iter) {
+        const PoolItem& item = *iter;
+        if ((item.m_poolKey != poolKey) || (item.m_pParentWindow != pParentWindow) || item.m_windowFlag.expired()) {
+            continue;
+        }
+        if ((pParentWindow != nullptr) && item.m_parentFlag.expired()) {
+            continue;
+        }
+        if (item.m_pWindow->IsWindow() && !item.m_pWindow->IsClosingWnd()) {
+            pWindow = item.m_pWindow;
+            m_items.erase(std::next(iter).base());
+            break;
+        }
+    }
+    if (pWindow != nullptr) {
+        ++m_nHitCount;
+    }
+    else {
+        ++m_nMissCount;
+    }
+    return pWindow;
+}
+
+bool WindowPool::RemoveWindow(const Window* pWindow)
+{
+    for (auto iter = m_items.begin(); iter != m_items.end(); ++iter) {
+        if (iter->m_pWindow == pWindow) {
+            m_items.erase(iter);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WindowPool::Clear()
+{
+    std::list<PoolItem> items;
+    items.swap(m_items);
+    for (const PoolItem& item : items) {
+        if (!item.m_windowFlag.expired() && item.m_pWindow->IsWindow()) {
+            item.m_pWindow->Close();
+        }
+    }
+}
+
+void WindowPool::CheckLimits()
+{
+    //先移除已经失效的窗口
+    for (auto iter = m_items.begin(); iter != m_items.end();) {
+        if (iter->m_windowFlag.expired()) {
+            iter = m_items.erase(iter);
+        }
+        else if ((iter->m_pParentWindow != nullptr) && iter->m_parentFlag.expired()) {
+            Window* pWindow = iter->m_pWindow;
+            iter = m_items.erase(iter);
+            pWindow->CloseWnd();
+        }
+        else {
+            ++iter;
+        }
+    }
+    while (!m_items.empty() && ((m_items.size() > m_nMaxWindowCount) || (GetMemorySize() > m_nMaxMemorySize))) {
+        Window* pWindow = m_items.front().m_pWindow;
+        m_items.pop_front();
+        pWindow->CloseWnd();
+    }
+}
+
+void WindowPool::SetMaxWindowCount(size_t nMaxWindowCount)
+{
+    m_nMaxWindowCount = nMaxWindowCount;
+    CheckLimits();
+}
+
+size_t WindowPool::GetMaxWindowCount() const
+{
+    return m_nMaxWindowCount;
+}
+
+void WindowPool::SetMaxMemorySize(size_t nMaxMemorySize)
+{
+    m_nMaxMemorySize = nMaxMemorySize;
+    CheckLimits();
+}
+
+size_t WindowPool::GetMaxMemorySize() const
+{
+    return m_nMaxMemorySize;
+}
+
+size_t WindowPool::GetWindowCount() const
+{
+    return m_items.size();
+}
+
+size_t WindowPool::GetMemorySize() const
+{
+    size_t nMemorySize = 0;
+    for (const PoolItem& item : m_items) {
+        nMemorySize += item.m_nMemorySize;
+    }
+    return nMemorySize;
+}
+
+uint64_t WindowPool::GetHitCount() const
+{
+    return m_nHitCount;
+}
+
+uint64_t WindowPool::GetMissCount() const
+{
+    return m_nMissCount;
+}
+
+} // namespace ui
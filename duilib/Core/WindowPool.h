@@ -0,0 +1,127 @@
+#ifndef UI_CORE_WINDOW_POOL_H_
+#define UI_CORE_WINDOW_POOL_H_
+
+#include "duilib/Core/Callback.h"
+#include <list>
+
+namespace ui
+{
+class Window;
+
+/** 窗口池：缓存已经创建好、当前处于隐藏状态的弹出窗口（比如菜单），再次弹出相同的窗口时直接复用，
+*   不再重复创建窗口、解析XML和创建控件
+*   1. 池中的窗口由窗口池管理生命周期，超出个数或者内存限制时，最久未使用的窗口会被关闭
+*   2. 池中窗口的父窗口销毁后，该窗口不再被复用
+*   3. 只能在UI线程中使用
+*/
+class UILIB_API WindowPool
+{
+public:
+    WindowPool();
+    ~WindowPool();
+    WindowPool(const WindowPool&) = delete;
+    WindowPool& operator = (const WindowPool&) = delete;
+
+public:
+    /** 将一个已经隐藏的窗口放入窗口池
+    * @param [in] poolKey 窗口的标识（比如菜单的XML文件名），相同标识的窗口可以相互替代
+    * @param [in] pWindow 窗口接口
+    * @return 成功返回true；如果超出限制返回false，此时窗口仍由调用方管理
+    */
+    bool AddWindow(const DString& poolKey, Window* pWindow);
+
+    /** 从窗口池中取出一个窗口（取出后由调用方管理）
+    * @param [in] poolKey 窗口的标识
+    * @param [in] pParentWindow 父窗口，只有父窗口相同的窗口才能复用
+    * @return 成功返回窗口接口，池中没有可用的窗口时返回nullptr
+    */
+    Window* TakeWindow(const DString& poolKey, const Window* pParentWindow);
+
+    /** 从窗口池中移除一个窗口，但不关闭窗口（窗口销毁时调用）
+    * @param [in] pWindow 窗口接口
+    */
+    bool RemoveWindow(const Window* pWindow);
+
+    /** 关闭窗口池中的所有窗口
+    */
+    void Clear();
+
+    /** 设置最多缓存的窗口个数（默认为8个）
+    */
+    void SetMaxWindowCount(size_t nMaxWindowCount);
+
+    /** 获取最多缓存的窗口个数
+    */
+    size_t GetMaxWindowCount() const;
+
+    /** 设置缓存窗口的内存上限（估算值，默认为32MB）
+    * @param [in] nMaxMemorySize 内存上限，单位为字节
+    */
+    void SetMaxMemorySize(size_t nMaxMemorySize);
+
+    /** 获取缓存窗口的内存上限
+    */
+    size_t GetMaxMemorySize() const;
+
+    /** 获取当前缓存的窗口个数
+    */
+    size_t GetWindowCount() const;
+
+    /** 获取当前缓存窗口占用的内存（估算值，单位为字节）
+    */
+    size_t GetMemorySize() const;
+
+    /** 获取TakeWindow复用成功的次数
+    */
+    uint64_t GetHitCount() const;
+
+    /** 获取TakeWindow没有可用窗口的次数
+    */
+    uint64_t GetMissCount() const;
+
+private:
+    /** 估算窗口占用的内存：以窗口的绘制缓存为主
+    */
+    static size_t EstimateMemorySize(Window* pWindow);
+
+    /** 关闭超出限制的窗口（最久未使用的窗口优先）
+    */
+    void CheckLimits();
+
+private:
+    /** 池中的窗口
+    */
+    struct PoolItem
+    {
+        DString m_poolKey;                      //窗口的标识
+        Window* m_pWindow = nullptr;            //窗口接口
+        std::weak_ptr<WeakFlag> m_windowFlag;   //窗口的有效期标志
+        const Window* m_pParentWindow = nullptr;//父窗口
+        std::weak_ptr<WeakFlag> m_parentFlag;   //父窗口的有效期标志
+        size_t m_nMemorySize = 0;               //占用的内存（估算值）
+    };
+
+    /** 池中的窗口，按放入的先后排序（最近放入的在最后）
+    */
+    std::list<PoolItem> m_items;
+
+    /** 最多缓存的窗口个数
+    */
+    size_t m_nMaxWindowCount;
+
+    /** 缓存窗口的内存上限
+    */
+    size_t m_nMaxMemorySize;
+
+    /** 复用成功的次数
+    */
+    uint64_t m_nHitCount;
+
+    /** 没有可用窗口的次数
+    */
+    uint64_t m_nMissCount;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_WINDOW_POOL_H_
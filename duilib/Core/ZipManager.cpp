@@ -4,6 +4,7 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/FileMapping.h"
 
 #include "duilib/third_party/zlib/zlib.h"
 #include "duilib/third_party/zlib/contrib/minizip/unzip.h"
@@ -14,8 +15,29 @@ namespace ui
 */
 #define MAX_PATH_LEN (size_t)(1024)
 
+/** Zip格式的签名和结构长度
+*/
+#define ZIP_CENTRAL_DIR_SIGNATURE   0x02014b50
+#define ZIP_LOCAL_HEADER_SIGNATURE  0x04034b50
+#define ZIP_CENTRAL_DIR_SIZE        46
+#define ZIP_LOCAL_HEADER_SIZE       30
+
+/** 从内存中读取小端格式的整数
+*/
+static inline uint16_t ReadZipUInt16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t ReadZipUInt32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
 ZipManager::ZipManager():
-    m_hzip(nullptr)
+    m_hzip(nullptr),
+    m_pZipData(nullptr),
+    m_nZipDataSize(0)
 {
 }
 
@@ -47,10 +69,15 @@ bool ZipManager::OpenResZip(HMODULE hModule, LPCTSTR resourceName, LPCTSTR resou
     }
     CloseResZip();
     m_password = password;
+    m_pZipData = pData;
+    m_nZipDataSize = nDataSize;
     m_pZipStreamIO = std::make_unique<ZipStreamIO>(pData, nDataSize);
     zlib_filefunc_def pzlib_filefunc_def;
     m_pZipStreamIO->FillFopenFileFunc(&pzlib_filefunc_def);
     m_hzip = ::unzOpen2(nullptr, &pzlib_filefunc_def);
+    if (m_hzip != nullptr) {
+        BuildZipIndex();
+    }
     return m_hzip != nullptr;
 }
 #endif
@@ -63,46 +90,251 @@ bool ZipManager::OpenZipFile(const FilePath& path, const DString& password)
         return false;
     }
     m_password = password;
-    m_hzip = ::unzOpen(nativePath.c_str());
+
+    //优先使用内存映射方式打开（ZipStreamIO的数据长度为32位整型）
+    m_pFileMapping = std::make_unique<FileMapping>();
+    if (m_pFileMapping->Open(path) && (m_pFileMapping->GetSize() < (size_t)INT32_MAX)) {
+        m_pZipData = m_pFileMapping->GetData();
+        m_nZipDataSize = m_pFileMapping->GetSize();
+        m_pZipStreamIO = std::make_unique<ZipStreamIO>((uint8_t*)m_pZipData, (uint32_t)m_nZipDataSize);
+        zlib_filefunc_def pzlib_filefunc_def;
+        m_pZipStreamIO->FillFopenFileFunc(&pzlib_filefunc_def);
+        m_hzip = ::unzOpen2(nullptr, &pzlib_filefunc_def);
+    }
+    if (m_hzip == nullptr) {
+        //内存映射失败时，使用文件方式打开
+        m_pZipStreamIO.reset();
+        m_pFileMapping.reset();
+        m_pZipData = nullptr;
+        m_nZipDataSize = 0;
+        m_hzip = ::unzOpen(nativePath.c_str());
+    }
+    if (m_hzip != nullptr) {
+        BuildZipIndex();
+    }
     return m_hzip != nullptr;
 }
 
+bool ZipManager::BuildZipIndex()
+{
+    m_zipEntries.clear();
+    m_zipEntryIndex.clear();
+    if (m_hzip == nullptr) {
+        return false;
+    }
+    //遍历一次压缩包的目录，建立索引（::unzLocateFile函数是采用遍历所有文件的方式实现的，性能比较差）
+    std::vector<char> szFileName;
+    szFileName.resize(MAX_PATH_LEN, 0);
+    int nRet = ::unzGoToFirstFile(m_hzip);
+    while (nRet == UNZ_OK) {
+        unz_file_info64 file_info;
+        memset(&file_info, 0, sizeof(file_info));
+        memset(szFileName.data(), 0, szFileName.size());
+        nRet = ::unzGetCurrentFileInfo64(m_hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
+        if (nRet != UNZ_OK) {
+            break;
+        }
+        unz64_file_pos filePos;
+        memset(&filePos, 0, sizeof(filePos));
+        nRet = ::unzGetFilePos64(m_hzip, &filePos);
+        if (nRet != UNZ_OK) {
+            break;
+        }
+
+        ZipEntry zipEntry;
+        //文件名的编码是否为UTF8格式
+        bool bUtf8 = file_info.flag & (1 << 11);
+        zipEntry.m_fileName = GetZipFilePath(szFileName.data(), bUtf8);
+
+        // zip has an 'attribute' 32bit value. Its lower half is windows stuff
+        // its upper half is standard unix stat.st_mode. We'll start trying
+        // to read it in unix mode
+
+        //文件名是否是目录
+        zipEntry.m_bDir = (file_info.external_fa & 0x40000000) != 0;
+        // but in normal hostmodes these are overridden by the lower half...
+        int host = file_info.version >> 8;
+        if (host == 0 || host == 7 || host == 11 || host == 14) {
+            //0 - FAT filesystem (MS-DOS, OS/2, NT/Win32)
+            //7 - Macintosh
+            //11 - NTFS filesystem (NT)
+            //14 - VFAT
+            zipEntry.m_bDir = (file_info.external_fa & 0x00000010) != 0;
+        }
+        zipEntry.m_bEncrypted = (file_info.flag & 1) != 0;
+        zipEntry.m_nMethod = (uint16_t)file_info.compression_method;
+        zipEntry.m_nCompressedSize = file_info.compressed_size;
+        zipEntry.m_nUncompressedSize = file_info.uncompressed_size;
+        zipEntry.m_nPosInZipDirectory = filePos.pos_in_zip_directory;
+        zipEntry.m_nNumOfFile = filePos.num_of_file;
+        if (!zipEntry.m_bEncrypted && ((zipEntry.m_nMethod == 0) || (zipEntry.m_nMethod == Z_DEFLATED))) {
+            zipEntry.m_nDataOffset = GetEntryDataOffset(filePos.pos_in_zip_directory);
+            if ((zipEntry.m_nDataOffset >= 0) &&
+                ((uint64_t)zipEntry.m_nDataOffset + zipEntry.m_nCompressedSize > (uint64_t)m_nZipDataSize)) {
+                zipEntry.m_nDataOffset = -1;
+            }
+        }
+
+#ifdef DUILIB_BUILD_FOR_WIN
+        DStringW innerFilePath = StringConvert::MBCSToUnicode(szFileName.data(), bUtf8 ? CP_UTF8 : CP_ACP);
+#else
+        DStringW innerFilePath = StringConvert::UTF8ToWString(szFileName.data());
+#endif
+        //压缩包内的文件名，都不区分大小写，转换为小写再比较
+        innerFilePath = StringUtil::MakeLowerString(innerFilePath);
+        NormalizeZipFilePath(innerFilePath);
+        if (m_zipEntryIndex.find(innerFilePath) == m_zipEntryIndex.end()) {
+            m_zipEntryIndex[innerFilePath] = m_zipEntries.size();
+        }
+        m_zipEntries.push_back(std::move(zipEntry));
+
+        //下一个文件
+        nRet = ::unzGoToNextFile(m_hzip);
+    }
+    return !m_zipEntries.empty();
+}
+
+int64_t ZipManager::GetEntryDataOffset(uint64_t nPosInZipDirectory) const
+{
+    //仅当压缩包在内存中时（内存映射或者资源数据），才可以直接读取
+    if ((m_pZipData == nullptr) || (m_nZipDataSize == 0)) {
+        return -1;
+    }
+    //目录项：读取本地文件头的偏移
+    if ((nPosInZipDirectory + ZIP_CENTRAL_DIR_SIZE) > m_nZipDataSize) {
+        return -1;
+    }
+    const uint8_t* pCentralDir = m_pZipData + nPosInZipDirectory;
+    if (ReadZipUInt32(pCentralDir) != ZIP_CENTRAL_DIR_SIGNATURE) {
+        return -1;
+    }
+    const uint32_t nLocalHeaderOffset = ReadZipUInt32(pCentralDir + 42);
+    if (nLocalHeaderOffset == 0xFFFFFFFF) {
+        //ZIP64格式，偏移值在扩展字段中，不支持直接读取
+        return -1;
+    }
+    //本地文件头：文件数据紧跟在文件名和扩展字段之后
+    if (((uint64_t)nLocalHeaderOffset + ZIP_LOCAL_HEADER_SIZE) > m_nZipDataSize) {
+        return -1;
+    }
+    const uint8_t* pLocalHeader = m_pZipData + nLocalHeaderOffset;
+    if (ReadZipUInt32(pLocalHeader) != ZIP_LOCAL_HEADER_SIGNATURE) {
+        return -1;
+    }
+    const uint16_t nFileNameLen = ReadZipUInt16(pLocalHeader + 26);
+    const uint16_t nExtraFieldLen = ReadZipUInt16(pLocalHeader + 28);
+    const uint64_t nDataOffset = (uint64_t)nLocalHeaderOffset + ZIP_LOCAL_HEADER_SIZE + nFileNameLen + nExtraFieldLen;
+    if (nDataOffset > m_nZipDataSize) {
+        return -1;
+    }
+    return (int64_t)nDataOffset;
+}
+
+const ZipManager::ZipEntry* ZipManager::FindZipEntry(const FilePath& path) const
+{
+    if ((m_hzip == nullptr) || path.IsEmpty()) {
+        return nullptr;
+    }
+    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
+    DStringW innerFilePath = normalizePath.ToStringW();
+    innerFilePath = StringUtil::MakeLowerString(innerFilePath);
+    NormalizeZipFilePath(innerFilePath);
+    auto iter = m_zipEntryIndex.find(innerFilePath);
+    if (iter != m_zipEntryIndex.end()) {
+        ASSERT(iter->second < m_zipEntries.size());
+        if (iter->second < m_zipEntries.size()) {
+            return &m_zipEntries[iter->second];
+        }
+    }
+    return nullptr;
+}
+
 bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const
 {
     fileData.clear();
-    GlobalManager::Instance().AssertUIThread();
     ASSERT(m_hzip != nullptr);
     if (m_hzip == nullptr) {
         return false;
     }
-    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
-    std::string filePathA;
-    if (!LocateFile(normalizePath, filePathA)) {
+    const ZipEntry* pZipEntry = FindZipEntry(path);
+    if ((pZipEntry == nullptr) || pZipEntry->m_bDir) {
         return false;
     }
-
-    size_t fileNameLen = std::max(filePathA.size() + 1, MAX_PATH_LEN);
-    std::vector<char> szFileName;
-    szFileName.resize(fileNameLen, 0);
-    unz_file_info file_info = {0, };
-    int nRet = ::unzGetCurrentFileInfo(m_hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
-    if (nRet != UNZ_OK) {
+    if (pZipEntry->m_nUncompressedSize == 0) {
         return false;
     }
-    
-    if (file_info.uncompressed_size == 0) {
+    if (pZipEntry->m_nDataOffset < 0) {
+        //无法直接读取（加密文件等），通过unzip接口读取
+        return ReadZipEntry(*pZipEntry, fileData);
+    }
+
+    //直接从内存中读取，无需加锁，支持多线程并行解压
+    const uint8_t* pSrcData = m_pZipData + pZipEntry->m_nDataOffset;
+    if (pZipEntry->m_nMethod == 0) {
+        //未压缩
+        if (pZipEntry->m_nCompressedSize != pZipEntry->m_nUncompressedSize) {
+            return false;
+        }
+        fileData.assign(pSrcData, pSrcData + pZipEntry->m_nUncompressedSize);
+        return true;
+    }
+
+    ASSERT(pZipEntry->m_nMethod == Z_DEFLATED);
+    if ((pZipEntry->m_nCompressedSize > UINT32_MAX) || (pZipEntry->m_nUncompressedSize > UINT32_MAX)) {
+        return ReadZipEntry(*pZipEntry, fileData);
+    }
+    fileData.resize((size_t)pZipEntry->m_nUncompressedSize);
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    //原始Deflate数据流（无zlib头）
+    int nRet = ::inflateInit2(&stream, -MAX_WBITS);
+    if (nRet != Z_OK) {
+        fileData.clear();
         return false;
     }
+    stream.next_in = (Bytef*)pSrcData;
+    stream.avail_in = (uInt)pZipEntry->m_nCompressedSize;
+    stream.next_out = (Bytef*)fileData.data();
+    stream.avail_out = (uInt)fileData.size();
+    nRet = ::inflate(&stream, Z_FINISH);
+    const bool bOk = (nRet == Z_STREAM_END) && (stream.total_out == fileData.size());
+    ::inflateEnd(&stream);
+    ASSERT(bOk);
+    if (!bOk) {
+        fileData.clear();
+    }
+    return bOk;
+}
 
-    //文件是否加密
-    bool bFileEncrypted = file_info.flag & 1;
+bool ZipManager::GetZipStoredData(const FilePath& path, const uint8_t*& pData, size_t& nDataSize) const
+{
+    pData = nullptr;
+    nDataSize = 0;
+    const ZipEntry* pZipEntry = FindZipEntry(path);
+    if ((pZipEntry == nullptr) || pZipEntry->m_bDir || (pZipEntry->m_nDataOffset < 0)) {
+        return false;
+    }
+    if ((pZipEntry->m_nMethod != 0) || (pZipEntry->m_nUncompressedSize == 0) ||
+        (pZipEntry->m_nCompressedSize != pZipEntry->m_nUncompressedSize)) {
+        return false;
+    }
+    pData = m_pZipData + pZipEntry->m_nDataOffset;
+    nDataSize = (size_t)pZipEntry->m_nUncompressedSize;
+    return true;
+}
 
-    nRet = ::unzStringFileNameCompare(szFileName.data(), filePathA.c_str(), 0);
-    ASSERT(nRet == 0);
-    if (nRet != 0) {
+bool ZipManager::ReadZipEntry(const ZipEntry& zipEntry, std::vector<unsigned char>& fileData) const
+{
+    fileData.clear();
+    std::lock_guard<std::mutex> threadGuard(m_zipMutex);
+    unz64_file_pos filePos;
+    filePos.pos_in_zip_directory = zipEntry.m_nPosInZipDirectory;
+    filePos.num_of_file = zipEntry.m_nNumOfFile;
+    int nRet = ::unzGoToFilePos64(m_hzip, &filePos);
+    if (nRet != UNZ_OK) {
         return false;
     }
-    if (!m_password.empty() && bFileEncrypted) {
+    if (!m_password.empty() && zipEntry.m_bEncrypted) {
         //密码是本地编码的（ANSI）
         std::string password;
 #ifdef DUILIB_BUILD_FOR_WIN
@@ -123,11 +355,11 @@ bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fi
         return false;
     }
 
-    fileData.resize(file_info.uncompressed_size);
+    fileData.resize((size_t)zipEntry.m_nUncompressedSize);
     nRet = ::unzReadCurrentFile(m_hzip, &fileData[0], (uLong)fileData.size());
     ::unzCloseCurrentFile(m_hzip);
-    ASSERT(nRet == fileData.size());
-    if (nRet != fileData.size()) {
+    ASSERT(nRet == (int)fileData.size());
+    if (nRet != (int)fileData.size()) {
         fileData.clear();
         return false;
     }
@@ -136,99 +368,27 @@ bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fi
 
 bool ZipManager::IsZipResExist(const FilePath& path) const
 {
-    GlobalManager::Instance().AssertUIThread();
-    if ((m_hzip == nullptr) || path.IsEmpty()) {
-        return false;
-    }
-    if (m_zipPathCache.empty()) {
-        //首次查询时，建立缓存，避免每次都需要遍历整个压缩包的文件（::unzLocateFile函数是采用遍历所有文件的方式实现的，性能比较差）
-        int nRet = ::unzGoToFirstFile(m_hzip);
-        while (nRet == UNZ_OK) {
-            size_t fileNameLen = MAX_PATH_LEN;
-            std::vector<char> szFileName;
-            szFileName.resize(fileNameLen, 0);
-            unz_file_info file_info = { 0, };
-            nRet = ::unzGetCurrentFileInfo(m_hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
-            if (nRet == UNZ_OK) {
-                //文件名的编码是否为UTF8格式
-                bool bUtf8 = file_info.flag & (1 << 11);
-                DString fileName = GetZipFilePath(szFileName.data(), bUtf8);
-
-#ifdef DUILIB_BUILD_FOR_WIN
-                DStringW innerFilePath = StringConvert::MBCSToUnicode(szFileName.data(), bUtf8 ? CP_UTF8 : CP_ACP);
-#else
-                DStringW innerFilePath = StringConvert::UTF8ToWString(szFileName.data());
-#endif
-                //压缩包内的文件名，都不区分大小写，转换为小写再比较
-                innerFilePath = StringUtil::MakeLowerString(innerFilePath);
-                //加入缓存
-                m_zipPathCache.insert(innerFilePath);
-
-                //下一个文件
-                nRet = ::unzGoToNextFile(m_hzip);
-            }
-        }
-    }
-
-    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
-    DStringW innerFilePath = normalizePath.ToStringW();
-    innerFilePath = StringUtil::MakeLowerString(innerFilePath);
-    NormalizeZipFilePath(innerFilePath);
-    auto it = m_zipPathCache.find(innerFilePath);
-    if (it != m_zipPathCache.end()) {
-        return true;
-    }
-    return false;
-}
-
-bool ZipManager::LocateFile(const FilePath& normalizePath, std::string& filePathA) const
-{
-    //压缩包内文件路径的编码是每个文件都不同的，定位的时候无法确定文件名编码，只能依次尝试
-    filePathA = normalizePath.NativePathA();//优先尝试MBCS编码
-    ASSERT(!filePathA.empty());
-    if (filePathA.empty()) {
-        return false;
-    }
-    NormalizeZipFilePath(filePathA);
-    const int iCaseSensitivity = 2; //不区分大小写
-    int nRet = ::unzLocateFile(m_hzip, filePathA.c_str(), iCaseSensitivity);
-    if (nRet == UNZ_OK) {
-        return true;
-    }
-
-    std::string oldFilePathA = filePathA;
-    filePathA = normalizePath.ToStringA();//再尝试UTF8编码
-    ASSERT(!filePathA.empty());
-    if (filePathA.empty()) {
-        return false;
-    }
-    NormalizeZipFilePath(filePathA);
-    if (oldFilePathA == filePathA) {
-        //路径无变化，不再重复查询
-        return false;
-    }
-    nRet = ::unzLocateFile(m_hzip, filePathA.c_str(), iCaseSensitivity);
-    if (nRet == UNZ_OK) {
-        return true;
-    }
-    filePathA.clear();
-    return false;
+    return FindZipEntry(path) != nullptr;
 }
 
 void ZipManager::CloseResZip()
 {
+    std::lock_guard<std::mutex> threadGuard(m_zipMutex);
     if (m_hzip != nullptr) {
         ::unzClose(m_hzip);
         m_hzip = nullptr;
     }
-    m_zipPathCache.clear();
+    m_zipEntries.clear();
+    m_zipEntryIndex.clear();
     m_pZipStreamIO.reset();
+    m_pFileMapping.reset();
+    m_pZipData = nullptr;
+    m_nZipDataSize = 0;
 }
 
 bool ZipManager::GetZipFileList(const FilePath& dirPath, std::vector<DString>& fileList) const
 {
     fileList.clear();
-    GlobalManager::Instance().AssertUIThread();
     DString filePath = dirPath.NativePath();
     if (!filePath.empty() &&
         (filePath[filePath.size() - 1] != _T('\\')) &&
@@ -239,54 +399,21 @@ bool ZipManager::GetZipFileList(const FilePath& dirPath, std::vector<DString>& f
     if (innerPath.empty() || (m_hzip == nullptr)) {
         return false;
     }
-    //路径分隔符统一替换成 '/'
+    //路径分隔符统一替换成 '/'，与文件查找一致，不区分大小写
     NormalizeZipFilePath(innerPath);
-    int nRet = ::unzGoToFirstFile(m_hzip);
-    if (nRet != UNZ_OK) {
-        return false;
-    }
-    DString fileName;
-    while (nRet == UNZ_OK) {
-        size_t fileNameLen = MAX_PATH_LEN;
-        std::vector<char> szFileName;
-        szFileName.resize(fileNameLen, 0);
-        unz_file_info file_info = { 0, };
-        nRet = ::unzGetCurrentFileInfo(m_hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
-        if (nRet != UNZ_OK) {
-            return false;
-        }
-
-        //文件名的编码是否为UTF8格式
-        bool bUtf8 = file_info.flag & (1 << 11);
-        fileName = GetZipFilePath(szFileName.data(), bUtf8);
-
-        // zip has an 'attribute' 32bit value. Its lower half is windows stuff
-        // its upper half is standard unix stat.st_mode. We'll start trying
-        // to read it in unix mode
-
-        //文件名是否是目录
-        bool bDir = (file_info.external_fa & 0x40000000) != 0;
-        // but in normal hostmodes these are overridden by the lower half...
-        int host = file_info.version >> 8;
-        if (host == 0 || host == 7 || host == 11 || host == 14) {
-            //0 - FAT filesystem (MS-DOS, OS/2, NT/Win32)
-            //7 - Macintosh
-            //11 - NTFS filesystem (NT)
-            //14 - VFAT
-            bDir = (file_info.external_fa & 0x00000010) != 0;
+    innerPath = StringUtil::MakeLowerString(innerPath);
+    for (const ZipEntry& zipEntry : m_zipEntries) {
+        if (zipEntry.m_bDir) {
+            continue;
         }
-        if (!bDir) {
-            size_t nPos = fileName.find(innerPath);
-            if ((nPos == 0) && (fileName.size() > innerPath.size())) {
-                fileName = fileName.substr(innerPath.size());
-                if (fileName.find(_T('/')) == DString::npos) {
-                    fileList.push_back(fileName);
-                }
+        const DString& fileName = zipEntry.m_fileName;
+        if ((fileName.size() > innerPath.size()) &&
+            (StringUtil::MakeLowerString(fileName.substr(0, innerPath.size())) == innerPath)) {
+            DString subFileName = fileName.substr(innerPath.size());
+            if (subFileName.find(_T('/')) == DString::npos) {
+                fileList.push_back(subFileName);
             }
         }
-
-        //跳到下一个文件
-        nRet = ::unzGoToNextFile(m_hzip);
     }
     return true;
 }
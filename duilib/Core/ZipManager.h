@@ -4,18 +4,22 @@
 #include "duilib/Utils/FilePath.h"
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include <unordered_map>
 #include <memory>
+#include <mutex>
 
 namespace ui 
 {
 class ZipStreamIO;
+class FileMapping;
 
 /**ZIP压缩包管理器
  * 说明：
  * （1）Zip压缩包支持的压缩算法是：Deflate算法，其他算法均不支持(也不支持Deflate64算法)
  * （2）使用7-Zip做压缩包的时候，如果自定义参数：cu=on，可以制作出文件名编码为UTF-8的压缩包；若不设置，默认文件名编码是本机编码
  * （3）如果设置了密码，需要使用传统的密码加密算法，否则无法解压。（使用"ZIP legacy encryption"模式 或者 "ZipCrypto"算法的密码）
+ * （4）打开压缩包时，压缩包文件被映射到内存，并一次性建立文件索引，查找文件无需遍历压缩包目录；
+ *      未加密的文件直接从映射内存中解压，多个线程可以并行读取（打开和关闭压缩包时，不能有其他线程正在读取）
  */
 class UILIB_API ZipManager
 {
@@ -53,6 +57,14 @@ public:
      */
     bool GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const;
 
+    /** 获取压缩包中未压缩存储（Stored）文件的数据，不复制数据（零拷贝），可在多线程中调用
+     * @param [in] path 要获取的文件的路径(压缩包内路径)
+     * @param [out] pData 返回文件数据的起始地址，关闭压缩包前有效
+     * @param [out] nDataSize 返回文件数据的长度
+     * @return 如果文件不存在，或者文件是压缩存储或加密的，返回false，此时应使用GetZipData获取文件数据
+     */
+    bool GetZipStoredData(const FilePath& path, const uint8_t*& pData, size_t& nDataSize) const;
+
     /** 判断资源是否存在zip当中
      * @param[in] path 要判断的资源路径(压缩包内路径)
      */
@@ -74,12 +86,40 @@ private:
     void NormalizeZipFilePath(std::string& innerFilePath) const;
     void NormalizeZipFilePath(std::wstring& innerFilePath) const;
 
-    /** 在压缩包中定位文件
-    * @param [in] normalizePath 文件路径
-    * @param [out] filePathA 返回压缩包内的文件路径（MBCS或者UTF8编码）
-    * @return 定位成功返回true，否则返回false
+    /** 压缩包内的文件信息
+    */
+    struct ZipEntry
+    {
+        DString m_fileName;                 //文件路径（压缩包内路径，保留原始大小写）
+        bool m_bDir = false;                //是否为目录
+        bool m_bEncrypted = false;          //是否加密
+        uint16_t m_nMethod = 0;             //压缩算法（0：Stored，8：Deflate）
+        uint64_t m_nCompressedSize = 0;     //压缩后的数据长度
+        uint64_t m_nUncompressedSize = 0;   //压缩前的数据长度
+        uint64_t m_nPosInZipDirectory = 0;  //在压缩包目录中的位置（unz64_file_pos）
+        uint64_t m_nNumOfFile = 0;          //在压缩包目录中的序号（unz64_file_pos）
+        int64_t m_nDataOffset = -1;         //文件数据在映射内存中的偏移，-1表示未知（只能通过unzip接口读取）
+    };
+
+    /** 打开压缩包后，建立文件索引
+    */
+    bool BuildZipIndex();
+
+    /** 计算文件数据在映射内存中的偏移
+    * @param [in] nPosInZipDirectory 文件在压缩包目录中的位置
+    * @return 返回数据偏移，失败返回-1
+    */
+    int64_t GetEntryDataOffset(uint64_t nPosInZipDirectory) const;
+
+    /** 在索引中查找文件
+    * @param [in] path 文件路径(压缩包内路径)
+    * @return 找到返回文件信息，否则返回nullptr
+    */
+    const ZipEntry* FindZipEntry(const FilePath& path) const;
+
+    /** 通过unzip接口读取文件（用于加密文件等情况，加锁执行）
     */
-    bool LocateFile(const FilePath& normalizePath, std::string& filePathA) const;
+    bool ReadZipEntry(const ZipEntry& zipEntry, std::vector<unsigned char>& fileData) const;
 
     /** 获取压缩包内的路径(转换字符串编码)
     * @param [in] szInZipFilePath 要获取的文件路径(压缩包内路径)
@@ -101,9 +141,29 @@ private:
     */
     std::unique_ptr<ZipStreamIO> m_pZipStreamIO;
 
-    /** 路径缓存
+    /** 压缩包文件的内存映射
+    */
+    std::unique_ptr<FileMapping> m_pFileMapping;
+
+    /** 压缩包数据的起始地址（内存映射或者资源数据）
+    */
+    const uint8_t* m_pZipData;
+
+    /** 压缩包数据的长度
+    */
+    size_t m_nZipDataSize;
+
+    /** 压缩包内的文件列表（按压缩包目录中的顺序）
+    */
+    std::vector<ZipEntry> m_zipEntries;
+
+    /** 文件索引：KEY是小写的文件路径(路径分隔符为'/')，VALUE是m_zipEntries中的下标
+    */
+    std::unordered_map<DStringW, size_t> m_zipEntryIndex;
+
+    /** unzip接口的多线程同步锁（m_hzip句柄内部有状态，不能多线程同时使用）
     */
-    mutable std::unordered_set<DStringW> m_zipPathCache;
+    mutable std::mutex m_zipMutex;
 };
 
 }
@@ -1,12 +1,15 @@
 #include "Image.h"
 #include "duilib/Image/ImageGif.h"
+#include "duilib/Core/Control.h"
+#include "duilib/Core/GlobalManager.h"
 
 namespace ui 
 {
 Image::Image() :
     m_pControl(nullptr),
     m_pImageGif(nullptr),
-    m_nCurrentFrame(0)
+    m_nCurrentFrame(0),
+    m_bImageCacheLoading(false)
 {
 }
 
@@ -102,6 +105,35 @@ void Image::ClearImageCache()
 {
     m_nCurrentFrame = 0;
     m_imageCache.reset();
+    m_asyncLoadFlag.Cancel();
+    m_bImageCacheLoading = false;
+}
+
+void Image::ReloadImageCacheAsync(const Window* pWindow, const ImageLoadAttribute& loadAttribute)
+{
+    if (m_bImageCacheLoading) {
+        return;
+    }
+    m_bImageCacheLoading = true;
+    auto callback = m_asyncLoadFlag.ToWeakCallback([this](const std::shared_ptr<ImageInfo>& spImageInfo) {
+            m_bImageCacheLoading = false;
+            if (spImageInfo == nullptr) {
+                return;
+            }
+            m_imageCache = spImageInfo;
+            if (m_nCurrentFrame >= spImageInfo->GetFrameCount()) {
+                m_nCurrentFrame = 0;
+            }
+            if (m_pControl != nullptr) {
+                m_pControl->Invalidate();
+            }
+        });
+    GlobalManager::Instance().Image().GetImageAsync(pWindow, loadAttribute, callback);
+}
+
+bool Image::IsImageCacheLoading() const
+{
+    return m_bImageCacheLoading;
 }
 
 void Image::SetCurrentFrame(uint32_t nCurrentFrame)
@@ -147,6 +179,22 @@ IBitmap* Image::GetCurrentBitmap() const
     }    
 }
 
+IBitmap* Image::GetSvgSizedBitmap(const UiSize& szBitmap)
+{
+    if (!m_imageCache) {
+        return nullptr;
+    }
+    StdClosure callback;
+    if (m_pControl != nullptr) {
+        callback = m_svgBitmapFlag.ToWeakCallback([this]() {
+                if (m_pControl != nullptr) {
+                    m_pControl->Invalidate();
+                }
+            });
+    }
+    return m_imageCache->GetSvgSizedBitmap(szBitmap, callback);
+}
+
 void Image::SetControl(Control* pControl)
 {
     if (m_pControl != pControl) {
@@ -13,6 +13,7 @@ namespace ui
 class Control;
 class ImageGif;
 class DpiManager;
+class Window;
 
 /** 图片相关封装，支持的文件格式：SVG/PNG/GIF/JPG/BMP/APNG/WEBP/ICO
 */
@@ -105,6 +106,17 @@ public:
     */
     void ClearImageCache();
 
+    /** 异步重新加载图片信息（比如DPI变化后，加载新DPI下的图片），加载期间仍然使用原来的图片信息
+    *   加载完成后替换图片信息，并重绘关联的控件
+    * @param [in] pWindow 图片关联的窗口
+    * @param [in] loadAttribute 图片的加载属性
+    */
+    void ReloadImageCacheAsync(const Window* pWindow, const ImageLoadAttribute& loadAttribute);
+
+    /** 是否正在异步重新加载图片信息
+    */
+    bool IsImageCacheLoading() const;
+
     /** 设置当前图片帧（仅当多帧图片时）
     */
     void SetCurrentFrame(uint32_t nCurrentFrame);
@@ -125,6 +137,13 @@ public:
     */
     IBitmap* GetCurrentBitmap() const;
 
+    /** 获取SVG图片按指定大小光栅化生成的位图（仅当SVG图片时）
+    *   如果该大小的位图尚未生成，则在工作线程中光栅化，完成后重绘关联的控件
+    * @param [in] szBitmap 位图的大小
+    * @return 如果该大小的位图已经生成，返回位图接口，否则返回nullptr
+    */
+    IBitmap* GetSvgSizedBitmap(const UiSize& szBitmap);
+
     /** @} */
 
 public:
@@ -184,6 +203,18 @@ private:
     /** 图片信息
     */
     std::shared_ptr<ImageInfo> m_imageCache;
+
+    /** SVG图片光栅化完成后重绘控件的生命周期标志
+    */
+    WeakCallbackFlag m_svgBitmapFlag;
+
+    /** 异步重新加载图片信息完成回调的生命周期标志
+    */
+    WeakCallbackFlag m_asyncLoadFlag;
+
+    /** 是否正在异步重新加载图片信息
+    */
+    bool m_bImageCacheLoading;
 };
 
 } // namespace ui
@@ -0,0 +1,248 @@
+#include "ImageAtlas.h"
+#include "duilib/Core/GlobalManager.h"
+
+namespace ui 
+{
+
+/** 图集中相邻图片之间的间隔（像素）
+*/
+static constexpr const int32_t ATLAS_IMAGE_SPACING = 1;
+
+ImageAtlas::ImageAtlas():
+    m_nMaxImageSize(64),
+    m_nPageSize(512),
+    m_nMaxPageCount(4)
+{
+}
+
+ImageAtlas::~ImageAtlas()
+{
+}
+
+void ImageAtlas::SetMaxImageSize(int32_t nMaxImageSize)
+{
+    m_nMaxImageSize = std::max(nMaxImageSize, 0);
+}
+
+int32_t ImageAtlas::GetMaxImageSize() const
+{
+    return m_nMaxImageSize;
+}
+
+void ImageAtlas::SetPageSize(int32_t nPageSize)
+{
+    ASSERT(nPageSize > 0);
+    if (nPageSize > 0) {
+        m_nPageSize = nPageSize;
+    }
+}
+
+int32_t ImageAtlas::GetPageSize() const
+{
+    return m_nPageSize;
+}
+
+void ImageAtlas::SetMaxPageCount(size_t nMaxPageCount)
+{
+    m_nMaxPageCount = nMaxPageCount;
+}
+
+size_t ImageAtlas::GetMaxPageCount() const
+{
+    return m_nMaxPageCount;
+}
+
+bool ImageAtlas::IsAtlasImageSize(const IBitmap* pBitmap) const
+{
+    if (pBitmap == nullptr) {
+        return false;
+    }
+    const int32_t nWidth = (int32_t)pBitmap->GetWidth();
+    const int32_t nHeight = (int32_t)pBitmap->GetHeight();
+    return (nWidth > 0) && (nHeight > 0) &&
+           (nWidth <= m_nMaxImageSize) && (nHeight <= m_nMaxImageSize) &&
+           (nWidth <= m_nPageSize) && (nHeight <= m_nPageSize);
+}
+
+bool ImageAtlas::GetAtlasImage(IBitmap* pBitmap, uint32_t nDpiScale,
+                               std::shared_ptr<IBitmap>& spAtlasBitmap, UiRect& rcAtlasRect)
+{
+    if (!IsAtlasImageSize(pBitmap) || (m_nMaxPageCount == 0)) {
+        return false;
+    }
+    auto iter = m_entries.find(pBitmap);
+    if (iter != m_entries.end()) {
+        if (!iter->second.m_bitmapFlag.expired()) {
+            spAtlasBitmap = iter->second.m_spBitmap;
+            rcAtlasRect = iter->second.m_rcAtlasRect;
+            return true;
+        }
+        //原图片已经销毁，该地址被新的图片复用
+        m_entries.erase(iter);
+    }
+
+    const int32_t nWidth = (int32_t)pBitmap->GetWidth();
+    const int32_t nHeight = (int32_t)pBitmap->GetHeight();
+    std::vector<AtlasPage>& pages = m_pages[nDpiScale];
+    AtlasPage* pPage = nullptr;
+    UiRect rcRect;
+    for (AtlasPage& page : pages) {
+        if (AllocRect(page, nWidth, nHeight, rcRect)) {
+            pPage = &page;
+            break;
+        }
+    }
+    if (pPage == nullptr) {
+        if ((pages.size() >= m_nMaxPageCount) && !ResetExpiredGroup(nDpiScale)) {
+            //图集已满，按原方式绘制
+            return false;
+        }
+        AtlasPage page;
+        if (!CreatePage(page) || !AllocRect(page, nWidth, nHeight, rcRect)) {
+            return false;
+        }
+        pages.push_back(page);
+        pPage = &pages.back();
+    }
+    if (!CopyToPage(pBitmap, pPage->m_spBitmap.get(), rcRect)) {
+        return false;
+    }
+
+    AtlasEntry& entry = m_entries[pBitmap];
+    entry.m_bitmapFlag = pBitmap->GetWeakFlag();
+    entry.m_nDpiScale = nDpiScale;
+    entry.m_spBitmap = pPage->m_spBitmap;
+    entry.m_rcAtlasRect = rcRect;
+
+    spAtlasBitmap = entry.m_spBitmap;
+    rcAtlasRect = rcRect;
+    return true;
+}
+
+bool ImageAtlas::AllocRect(AtlasPage& page, int32_t nWidth, int32_t nHeight, UiRect& rcAtlasRect) const
+{
+    if (page.m_spBitmap == nullptr) {
+        return false;
+    }
+    const int32_t nPageWidth = (int32_t)page.m_spBitmap->GetWidth();
+    const int32_t nPageHeight = (int32_t)page.m_spBitmap->GetHeight();
+    if ((page.m_nShelfLeft + nWidth) > nPageWidth) {
+        //当前行已满，换到下一行
+        page.m_nShelfTop += page.m_nShelfHeight;
+        page.m_nShelfLeft = 0;
+        page.m_nShelfHeight = 0;
+    }
+    if (((page.m_nShelfLeft + nWidth) > nPageWidth) || ((page.m_nShelfTop + nHeight) > nPageHeight)) {
+        return false;
+    }
+    rcAtlasRect = UiRect(page.m_nShelfLeft, page.m_nShelfTop,
+                         page.m_nShelfLeft + nWidth, page.m_nShelfTop + nHeight);
+    page.m_nShelfLeft += nWidth + ATLAS_IMAGE_SPACING;
+    page.m_nShelfHeight = std::max(page.m_nShelfHeight, nHeight + ATLAS_IMAGE_SPACING);
+    return true;
+}
+
+bool ImageAtlas::CreatePage(AtlasPage& page) const
+{
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactory != nullptr);
+    if (pRenderFactory == nullptr) {
+        return false;
+    }
+    std::shared_ptr<IBitmap> spBitmap(pRenderFactory->CreateBitmap());
+    if ((spBitmap == nullptr) || !spBitmap->Init(m_nPageSize, m_nPageSize, true, nullptr)) {
+        return false;
+    }
+    void* pPixelBits = spBitmap->LockPixelBits();
+    if (pPixelBits == nullptr) {
+        return false;
+    }
+    ::memset(pPixelBits, 0, (size_t)m_nPageSize * m_nPageSize * sizeof(uint32_t));
+    spBitmap->UnLockPixelBits();
+
+    page.m_spBitmap = spBitmap;
+    page.m_nShelfLeft = 0;
+    page.m_nShelfTop = 0;
+    page.m_nShelfHeight = 0;
+    return true;
+}
+
+bool ImageAtlas::CopyToPage(IBitmap* pBitmap, IBitmap* pPageBitmap, const UiRect& rcAtlasRect) const
+{
+    ASSERT((pBitmap != nullptr) && (pPageBitmap != nullptr));
+    if ((pBitmap == nullptr) || (pPageBitmap == nullptr)) {
+        return false;
+    }
+    const int32_t nWidth = (int32_t)pBitmap->GetWidth();
+    const int32_t nHeight = (int32_t)pBitmap->GetHeight();
+    const int32_t nPageWidth = (int32_t)pPageBitmap->GetWidth();
+    ASSERT((rcAtlasRect.Width() == nWidth) && (rcAtlasRect.Height() == nHeight));
+    if ((rcAtlasRect.Width() != nWidth) || (rcAtlasRect.Height() != nHeight)) {
+        return false;
+    }
+    const uint32_t* pSrcBits = (const uint32_t*)pBitmap->LockPixelBits();
+    if (pSrcBits == nullptr) {
+        return false;
+    }
+    uint32_t* pDestBits = (uint32_t*)pPageBitmap->LockPixelBits();
+    if (pDestBits == nullptr) {
+        pBitmap->UnLockPixelBits();
+        return false;
+    }
+    //按行复制图片数据
+    for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
+        const uint32_t* pSrcRow = pSrcBits + (size_t)nRow * nWidth;
+        uint32_t* pDestRow = pDestBits + (size_t)(rcAtlasRect.top + nRow) * nPageWidth + rcAtlasRect.left;
+        ::memcpy(pDestRow, pSrcRow, (size_t)nWidth * sizeof(uint32_t));
+    }
+    pPageBitmap->UnLockPixelBits();
+    pBitmap->UnLockPixelBits();
+    return true;
+}
+
+bool ImageAtlas::ResetExpiredGroup(uint32_t nDpiScale)
+{
+    bool bHasExpired = false;
+    for (const auto& iter : m_entries) {
+        if ((iter.second.m_nDpiScale == nDpiScale) && iter.second.m_bitmapFlag.expired()) {
+            bHasExpired = true;
+            break;
+        }
+    }
+    if (!bHasExpired) {
+        return false;
+    }
+    //删除该组的所有图片，图片在下次绘制时重新添加（正在使用的图集位图由引用方持有，不受影响）
+    for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+        if (iter->second.m_nDpiScale == nDpiScale) {
+            iter = m_entries.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+    m_pages[nDpiScale].clear();
+    return true;
+}
+
+void ImageAtlas::Clear()
+{
+    m_entries.clear();
+    m_pages.clear();
+}
+
+size_t ImageAtlas::GetPageCount() const
+{
+    size_t nCount = 0;
+    for (const auto& iter : m_pages) {
+        nCount += iter.second.size();
+    }
+    return nCount;
+}
+
+size_t ImageAtlas::GetImageCount() const
+{
+    return m_entries.size();
+}
+
+} // namespace ui
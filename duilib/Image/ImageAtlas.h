@@ -0,0 +1,142 @@
+#ifndef UI_IMAGE_IMAGE_ATLAS_H_
+#define UI_IMAGE_IMAGE_ATLAS_H_
+
+#include "duilib/Render/IRender.h"
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+
+namespace ui 
+{
+
+/** 图集：将小图片（比如列表的图标、状态图片）合并到少量的大位图中，
+*   绘制时可通过IRender::DrawAtlasImage批量绘制，减少绘制调用的次数
+*   1. 图集按DPI缩放比分组，同一组的图片放在相同的图集位图中
+*   2. 图片在首次绘制时添加到图集，按行（货架方式）分配位置；图片被销毁后，其位置不再复用，
+*      当某组的图集已满时，如果有已经销毁的图片，则重新生成该组的图集，否则不再添加（按原方式绘制）
+*   3. 只能在UI线程中使用
+*/
+class UILIB_API ImageAtlas
+{
+public:
+    ImageAtlas();
+    ~ImageAtlas();
+    ImageAtlas(const ImageAtlas&) = delete;
+    ImageAtlas& operator = (const ImageAtlas&) = delete;
+
+public:
+    /** 设置可放入图集的图片的最大宽度和高度（默认为64）
+    */
+    void SetMaxImageSize(int32_t nMaxImageSize);
+
+    /** 获取可放入图集的图片的最大宽度和高度
+    */
+    int32_t GetMaxImageSize() const;
+
+    /** 设置图集位图的宽度和高度（默认为512），只影响新生成的图集位图
+    */
+    void SetPageSize(int32_t nPageSize);
+
+    /** 获取图集位图的宽度和高度
+    */
+    int32_t GetPageSize() const;
+
+    /** 设置每个DPI缩放比下，图集位图的最大个数（默认为4）
+    */
+    void SetMaxPageCount(size_t nMaxPageCount);
+
+    /** 获取每个DPI缩放比下，图集位图的最大个数
+    */
+    size_t GetMaxPageCount() const;
+
+    /** 判断图片的大小是否可以放入图集
+    */
+    bool IsAtlasImageSize(const IBitmap* pBitmap) const;
+
+    /** 获取图片在图集中的位置，如果图片不在图集中，则添加到图集
+    * @param [in] pBitmap 图片
+    * @param [in] nDpiScale 图片的DPI缩放比
+    * @param [out] spAtlasBitmap 返回图片所在的图集位图
+    * @param [out] rcAtlasRect 返回图片在图集位图中的区域
+    * @return 成功返回true；如果图片不能放入图集（图片过大或者图集已满），返回false
+    */
+    bool GetAtlasImage(IBitmap* pBitmap, uint32_t nDpiScale,
+                       std::shared_ptr<IBitmap>& spAtlasBitmap, UiRect& rcAtlasRect);
+
+    /** 清空图集
+    */
+    void Clear();
+
+    /** 获取图集位图的总个数
+    */
+    size_t GetPageCount() const;
+
+    /** 获取图集中图片的个数
+    */
+    size_t GetImageCount() const;
+
+private:
+    /** 一个图集位图
+    */
+    struct AtlasPage
+    {
+        std::shared_ptr<IBitmap> m_spBitmap;    //图集位图
+        int32_t m_nShelfLeft = 0;               //当前行的下一个可用位置X坐标
+        int32_t m_nShelfTop = 0;                //当前行的Y坐标
+        int32_t m_nShelfHeight = 0;             //当前行的高度
+    };
+
+    /** 图片在图集中的位置
+    */
+    struct AtlasEntry
+    {
+        std::weak_ptr<WeakFlag> m_bitmapFlag;   //图片的生命周期标志
+        uint32_t m_nDpiScale = 0;               //图片的DPI缩放比
+        std::shared_ptr<IBitmap> m_spBitmap;    //图片所在的图集位图
+        UiRect m_rcAtlasRect;                   //图片在图集位图中的区域
+    };
+
+private:
+    /** 在图集位图中分配指定大小的区域
+    */
+    bool AllocRect(AtlasPage& page, int32_t nWidth, int32_t nHeight, UiRect& rcAtlasRect) const;
+
+    /** 创建一个新的图集位图
+    */
+    bool CreatePage(AtlasPage& page) const;
+
+    /** 将图片数据复制到图集位图的指定区域
+    */
+    bool CopyToPage(IBitmap* pBitmap, IBitmap* pPageBitmap, const UiRect& rcAtlasRect) const;
+
+    /** 删除指定DPI缩放比的所有图集位图和图片（图集已满，且有已经销毁的图片时，重新生成）
+    * @return 如果有已经销毁的图片，删除并返回true，否则返回false
+    */
+    bool ResetExpiredGroup(uint32_t nDpiScale);
+
+private:
+    /** 可放入图集的图片的最大宽度和高度
+    */
+    int32_t m_nMaxImageSize;
+
+    /** 图集位图的宽度和高度
+    */
+    int32_t m_nPageSize;
+
+    /** 每个DPI缩放比下，图集位图的最大个数
+    */
+    size_t m_nMaxPageCount;
+
+    /** 图集位图：DPI缩放比 -> 图集位图列表
+    */
+    std::map<uint32_t, std::vector<AtlasPage>> m_pages;
+
+    /** 图集中的图片：图片接口 -> 图片在图集中的位置
+    */
+    std::unordered_map<const IBitmap*, AtlasEntry> m_entries;
+};
+
+} // namespace ui
+
+#endif // UI_IMAGE_IMAGE_ATLAS_H_
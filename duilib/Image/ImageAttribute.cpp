@@ -51,6 +51,7 @@ ImageAttribute& ImageAttribute::operator=(const ImageAttribute& r)
     nTiledMargin = r.nTiledMargin;
     nPlayCount = r.nPlayCount;
     iconSize = r.iconSize;
+    bSvgVectorMode = r.bSvgVectorMode;
     bPaintEnabled = r.bPaintEnabled;
 
     if (r.rcDest != nullptr) {
@@ -132,6 +133,7 @@ void ImageAttribute::Init()
     nTiledMargin = 0;
     nPlayCount = -1;
     iconSize = 0;
+    bSvgVectorMode = false;
     bPaintEnabled = true;
 
     if (rcDest != nullptr) {
@@ -299,6 +301,10 @@ void ImageAttribute::ModifyAttribute(const DString& strImageString, const DpiMan
                 imageAttribute.nPlayCount = -1;
             }
         }
+        else if (name == _T("svg_mode")) {
+            //如果是SVG图片，可以指定绘制方式："vector"表示矢量绘制，"raster"表示光栅化后绘制位图（缺省值）
+            imageAttribute.bSvgVectorMode = (value == _T("vector"));
+        }
         else {
             ASSERT(!"ImageAttribute::ModifyAttribute: fount unknown attribute!");
         }
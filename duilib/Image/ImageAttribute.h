@@ -136,6 +136,9 @@ public:
     //目前ICO文件在加载时，只会选择一个大小的ICO图片进行加载，加载后为单张图片
     uint32_t iconSize;
 
+    //如果是SVG文件，指定绘制方式：true表示矢量绘制（按目标区域直接绘制路径），false表示光栅化后绘制位图（缺省值）
+    bool bSvgVectorMode;
+
     //可绘制标志：true表示允许绘制，false表示禁止绘制
     bool bPaintEnabled;
 
@@ -1,5 +1,6 @@
 #include "ImageDecoder.h"
 #include "duilib/Image/Image.h"
+#include "duilib/Image/SvgDocument.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/DpiManager.h"
 #include "duilib/Utils/StringUtil.h"
@@ -24,15 +25,6 @@
 #include "duilib/third_party/stb_image/stb_image_resize2.h"
 #pragma warning (pop)
 
-#pragma warning (push)
-#pragma warning (disable: 4456 4244 4702)
-#define NANOSVG_IMPLEMENTATION
-#define NANOSVG_ALL_COLOR_KEYWORDS
-#include "duilib/third_party/svg/nanosvg.h"
-#define NANOSVGRAST_IMPLEMENTATION
-#include "duilib/third_party/svg/nanosvgrast.h"
-#pragma warning (pop)
-
 #pragma warning (push)
 #pragma warning (disable: 4996)
 #include "duilib/third_party/cximage/ximage.h"
@@ -252,112 +244,6 @@ namespace APNGImageLoader
     }
 }//APNGImageLoader
 
-/** 加载SVG图片
-*/
-namespace SVGImageLoader
-{
-    class SvgDeleter
-    {
-    public:
-        inline void operator()(NSVGimage* x) const { nsvgDelete(x); }
-    };
-
-    class RasterizerDeleter
-    {
-    public:
-        inline void operator()(NSVGrasterizer* x) const { nsvgDeleteRasterizer(x); }
-    };
-
-    /** 从内存数据加载svg图片
-    * @param [in] fileData 图片文件的数据，部分格式加载过程中内部有增加尾0的写操作
-    * @param [in] imageLoadAttribute 图片加载属性, 包括图片路径等
-    * @param [in] bEnableDpiScale 是否允许按照DPI对图片大小进行缩放（此为功能开关）
-    * @param [in] nImageDpiScale 图片数据对应的DPI缩放百分比（比如：i.jpg为100，i@150.jpg为150）
-    * @param [in] dpi DPI缩放管理接口
-    */
-    bool LoadImageFromMemory(std::vector<uint8_t>& fileData, 
-                             const ImageLoadAttribute& imageLoadAttribute, 
-                             bool bEnableDpiScale,
-                             uint32_t nImageDpiScale,
-                             const DpiManager& dpi,                             
-                             ImageDecoder::ImageData& imageData,
-                             bool& bDpiScaled)
-    {
-        ASSERT(!fileData.empty());
-        if (fileData.empty()) {
-            return false;
-        }
-        bDpiScaled = false;
-        bool hasAppended = false;
-        if (fileData.back() != '\0') {
-            //确保是含尾0的字符串，避免越界访问内存
-            fileData.push_back('\0');
-            hasAppended = true;
-        }
-        char* pData = (char*)fileData.data();
-        NSVGimage* svgData = nsvgParse(pData, "px", 96.0f);//传入"px"时，第三个参数dpi是不起作用的。
-        if (hasAppended) {
-            fileData.pop_back();
-        }
-
-        std::unique_ptr<NSVGimage, SvgDeleter> svg((NSVGimage*)svgData);
-        int width = (int)svg->width;
-        int height = (int)svg->height;
-        if (width <= 0 || height <= 0) {
-            return false;
-        }
-
-        //计算缩放后的大小
-        uint32_t nImageWidth = (uint32_t)width;
-        uint32_t nImageHeight = (uint32_t)height;
-        ImageLoader::CalcImageLoadSize(imageLoadAttribute,
-                                       bEnableDpiScale, nImageDpiScale, dpi, bDpiScaled,
-                                       nImageWidth, nImageHeight);
-
-        //svg的缩放，只能按比例，锁定纵横比的方式缩放
-        float scaleX = 1.0f * nImageWidth / width;
-        float scaleY = 1.0f * nImageHeight / height;
-        float scale = (scaleX > scaleY) ? scaleX : scaleY; //取最大的缩放比
-        width = static_cast<int>(width * scale);
-        height = static_cast<int>(height * scale);
-        std::unique_ptr<NSVGrasterizer, RasterizerDeleter> rast(nsvgCreateRasterizer());        
-        if ((width <= 0) || (height <= 0) || !rast) {
-            return false;
-        }
-
-        constexpr const int dataSize = 4;
-        std::vector<uint8_t>& bitmapData = imageData.m_bitmapData;
-        bitmapData.resize((size_t)height * width * dataSize);
-        uint8_t* pBmpBits = bitmapData.data();
-        if (pBmpBits == nullptr) {
-            return false;
-        }
-        nsvgRasterize(rast.get(), svg.get(), 0, 0, scale, pBmpBits, width, height, width * dataSize);
-
-#ifdef DUILIB_BUILD_FOR_WIN
-        //数据格式：Window平台BGRA，其他平台RGBA
-        // nanosvg内部已经做过alpha预乘，这里只做R和B的交换
-        for (int y = 0; y < height; ++y) {
-            unsigned char* row = &pBmpBits[y * width * dataSize];
-            for (int x = 0; x < width; ++x) {
-                //SVG    数据的各个颜色值：row[0]:R, row[1]: G, row[2]: B, row[3]: A
-                //输出    数据的各个颜色值：row[0]:B, row[1]: G, row[2]: R, row[3]: A
-                unsigned char r = row[0];
-                row[0] = row[2];
-                row[2] = r;
-                row += 4;
-            }
-        }
-#endif
-
-        imageData.m_frameInterval = 0;
-        imageData.bFlipHeight = true;
-        imageData.m_imageWidth = width;
-        imageData.m_imageHeight = height;
-        return true;
-    }
-} //SVGImageLoader
-
 /** 使用cximage加载图片（只支持GIF和ICO）两种格式
 @param [in] isIconFile 如果为true表示是ICO文件，否则为GIF文件
 @param [in] iconSize 需要加载ICO图标的大小，因ICO文件中包含了各种大小的图标，加载的时候，只加载其中一个图标
@@ -633,6 +519,11 @@ ImageDecoder::ImageFormat ImageDecoder::GetImageFormat(const DString& path)
     return imageFormat;
 }
 
+bool ImageDecoder::IsSvgImageFile(const DString& path)
+{
+    return GetImageFormat(path) == ImageFormat::kSVG;
+}
+
 std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fileData,                                                       
                                                        const ImageLoadAttribute& imageLoadAttribute,
                                                        bool bEnableDpiScale,
@@ -649,24 +540,31 @@ std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fil
         return nullptr;
     }
 
+    if (GetImageFormat(imageLoadAttribute.GetImageFullPath()) == ImageFormat::kSVG) {
+        //SVG是矢量图，解析后按需要的大小光栅化，确保图片的质量是最高的
+        std::shared_ptr<SvgDocument> spSvgDocument = SvgDocument::Parse(fileData);
+        if (spSvgDocument == nullptr) {
+            return nullptr;
+        }
+        return LoadSvgImageData(spSvgDocument, imageLoadAttribute, bEnableDpiScale, nImageDpiScale, dpi);
+    }
+
     std::vector<ImageData> imageData;
     bool bDpiScaled = false; //是否根据DPI做过按比例缩放操作
     int32_t playCount = -1;
 
-    PerformanceUtil::Instance().BeginStat(_T("DecodeImageData"));
-    bool isLoaded = DecodeImageData(fileData, imageLoadAttribute, 
-                                    bEnableDpiScale, nImageDpiScale, dpi, 
-                                    imageData, playCount, bDpiScaled);
-    PerformanceUtil::Instance().EndStat(_T("DecodeImageData"));
+    bool isLoaded = false;
+    {
+        static const PerformanceStatId s_statId(_T("DecodeImageData"));
+        PerformanceStat statPerformance(s_statId);
+        isLoaded = DecodeImageData(fileData, imageLoadAttribute, imageData, playCount);
+    }
     if (!isLoaded || imageData.empty()) {
         return nullptr;
     }
 
-    ImageFormat imageFormat = GetImageFormat(imageLoadAttribute.GetImageFullPath());
-    if (imageFormat != ImageFormat::kSVG) {
-        //加载图片的时候，应该未做过DPI自适应
-        ASSERT(!bDpiScaled);
-        //计算缩放后的大小
+    {
+        //计算缩放后的大小（解码时不做DPI自适应，由此处统一计算）
         const ImageData& image = imageData[0];
         uint32_t nImageWidth = image.m_imageWidth;
         uint32_t nImageHeight = image.m_imageHeight;
@@ -676,11 +574,11 @@ std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fil
         if ((nImageWidth != image.m_imageWidth) ||
             (nImageHeight != image.m_imageHeight)) {
             //加载图像后，根据配置属性，进行大小调整(用算法对原图缩放，图片质量显示效果会好些)
-            PerformanceUtil::Instance().BeginStat(_T("ResizeImageData"));
+            static const PerformanceStatId s_statId(_T("ResizeImageData"));
+            PerformanceStat statPerformance(s_statId);
             if (!ResizeImageData(imageData, nImageWidth, nImageHeight)) {
                 bDpiScaled = false;
             }
-            PerformanceUtil::Instance().EndStat(_T("ResizeImageData"));
         }
     }
 
@@ -721,6 +619,72 @@ std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fil
     return imageInfo;
 }
 
+std::unique_ptr<ImageInfo> ImageDecoder::LoadSvgImageData(const std::shared_ptr<SvgDocument>& spSvgDocument,
+                                                          const ImageLoadAttribute& imageLoadAttribute,
+                                                          bool bEnableDpiScale,
+                                                          uint32_t nImageDpiScale,
+                                                          const DpiManager& dpi)
+{
+    ASSERT(spSvgDocument != nullptr);
+    if (spSvgDocument == nullptr) {
+        return nullptr;
+    }
+    IRenderFactory* pRenderFactroy = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactroy != nullptr);
+    if (pRenderFactroy == nullptr) {
+        return nullptr;
+    }
+    int width = (int)spSvgDocument->GetWidth();
+    int height = (int)spSvgDocument->GetHeight();
+    if (width <= 0 || height <= 0) {
+        return nullptr;
+    }
+
+    //计算缩放后的大小
+    bool bDpiScaled = false;
+    uint32_t nImageWidth = (uint32_t)width;
+    uint32_t nImageHeight = (uint32_t)height;
+    ImageLoader::CalcImageLoadSize(imageLoadAttribute,
+                                   bEnableDpiScale, nImageDpiScale, dpi, bDpiScaled,
+                                   nImageWidth, nImageHeight);
+
+    //svg的缩放，只能按比例，锁定纵横比的方式缩放
+    float scaleX = 1.0f * nImageWidth / width;
+    float scaleY = 1.0f * nImageHeight / height;
+    float scale = (scaleX > scaleY) ? scaleX : scaleY; //取最大的缩放比
+    width = static_cast<int>(width * scale);
+    height = static_cast<int>(height * scale);
+    if ((width <= 0) || (height <= 0)) {
+        return nullptr;
+    }
+
+    std::vector<uint8_t> bitmapData;
+    {
+        static const PerformanceStatId s_statId(_T("DecodeImageData"));
+        PerformanceStat statPerformance(s_statId);
+        if (!spSvgDocument->Rasterize(scale, (uint32_t)width, (uint32_t)height, bitmapData)) {
+            return nullptr;
+        }
+    }
+
+    IBitmap* pBitmap = pRenderFactroy->CreateBitmap();
+    ASSERT(pBitmap != nullptr);
+    if (pBitmap == nullptr) {
+        return nullptr;
+    }
+    pBitmap->Init((uint32_t)width, (uint32_t)height, true, bitmapData.data());
+    std::vector<IBitmap*> frameBitmaps;
+    frameBitmaps.push_back(pBitmap);
+
+    std::unique_ptr<ImageInfo> imageInfo(new ImageInfo);
+    imageInfo->SetFrameBitmap(frameBitmaps);
+    imageInfo->SetImageSize(width, height);
+    imageInfo->SetPlayCount(-1);
+    imageInfo->SetBitmapSizeDpiScaled(bDpiScaled);
+    imageInfo->SetSvgDocument(spSvgDocument);
+    return imageInfo;
+}
+
 bool ImageDecoder::ResizeImageData(std::vector<ImageData>& imageData,
                                    uint32_t nNewWidth,
                                    uint32_t nNewHeight)
@@ -776,12 +740,8 @@ bool ImageDecoder::ResizeImageData(std::vector<ImageData>& imageData,
 
 bool ImageDecoder::DecodeImageData(std::vector<uint8_t>& fileData,
                                    const ImageLoadAttribute& imageLoadAttribute,
-                                   bool bEnableDpiScale,
-                                   uint32_t nImageDpiScale,
-                                   const DpiManager& dpi,
                                    std::vector<ImageData>& imageData,
-                                   int32_t& playCount,
-                                   bool& bDpiScaled)
+                                   int32_t& playCount)
 {
     ASSERT(!fileData.empty());
     if (fileData.empty()) {
@@ -790,7 +750,6 @@ bool ImageDecoder::DecodeImageData(std::vector<uint8_t>& fileData,
 
     imageData.clear();
     playCount = -1;
-    bDpiScaled = false;
 
     bool isLoaded = false;
     ImageFormat imageFormat = GetImageFormat(imageLoadAttribute.GetImageFullPath());
@@ -798,13 +757,6 @@ bool ImageDecoder::DecodeImageData(std::vector<uint8_t>& fileData,
     case ImageFormat::kPNG:
         isLoaded = APNGImageLoader::LoadImageFromMemory(fileData, imageData, playCount);
         break;
-    case ImageFormat::kSVG:
-        //SVG是矢量图，所以需要在加载过程中处理图片缩放，确保图片的质量是最高的
-        imageData.resize(1);
-        isLoaded = SVGImageLoader::LoadImageFromMemory(fileData, imageLoadAttribute, 
-                                                       bEnableDpiScale, nImageDpiScale, dpi, 
-                                                       imageData[0], bDpiScaled);
-        break;
     case ImageFormat::kJPEG:
     case ImageFormat::kBMP:
         imageData.resize(1);
@@ -10,6 +10,7 @@ namespace ui
 {
 class ImageInfo;
 class ImageLoadAttribute;
+class SvgDocument;
 class DpiManager;
 
 /** 图片格式解码类
@@ -30,6 +31,23 @@ public:
                                              uint32_t nImageDpiScale,
                                              const DpiManager& dpi);
 
+    /** 从已解析的SVG文档加载图片（SVG文档只解析一次，不同DPI或者不同大小的图片由同一个SVG文档光栅化生成）
+    * @param [in] spSvgDocument 已解析的SVG文档
+    * @param [in] imageLoadAttribute 图片加载属性, 包括图片路径等
+    * @param [in] bEnableDpiScale 是否允许按照DPI对图片大小进行缩放（此为功能开关）
+    * @param [in] nImageDpiScale 图片数据对应的DPI缩放百分比（比如：i.svg为100，i@150.svg为150）
+    * @param [in] dpi DPI缩放管理接口
+    */
+    std::unique_ptr<ImageInfo> LoadSvgImageData(const std::shared_ptr<SvgDocument>& spSvgDocument,
+                                                const ImageLoadAttribute& imageLoadAttribute,
+                                                bool bEnableDpiScale,
+                                                uint32_t nImageDpiScale,
+                                                const DpiManager& dpi);
+
+    /** 根据图片文件的扩展名判断是否为SVG图片
+    */
+    static bool IsSvgImageFile(const DString& path);
+
 public:
     /** 加载后的图片数据
     */
@@ -61,21 +79,13 @@ private:
     /** 对图片数据进行解码，生成位图数据
     * @param [in] fileData 原始图片数据
     * @param [in] imageLoadAttribute 图片的加载属性信息
-    * @param [in] bEnableDpiScale 是否允许按照DPI对图片大小进行缩放（此为功能开关）
-    * @param [in] nImageDpiScale 图片数据对应的DPI缩放百分比（比如：i.jpg为100，i@150.jpg为150）
-    * @param [in] dpi DPI缩放管理接口
-    * @param [out] imageData 加载成功的图片数据，每个图片帧一个元素
+    * @param [out] imageData 加载成功的图片数据，每个图片帧一个元素（解码时不做DPI自适应，图片为原始大小）
     * @param [out] playCount 动画播放的循环次数(-1表示无效值；大于等于0时表示值有效，如果等于0，表示动画是循环播放的, APNG格式支持设置循环播放次数)
-    * @param [out] bDpiScaled 图片加载的时候，图片大小是否进行了DPI自适应操作
     */
     bool DecodeImageData(std::vector<uint8_t>& fileData, 
                          const ImageLoadAttribute& imageLoadAttribute,
-                         bool bEnableDpiScale,
-                         uint32_t nImageDpiScale,
-                         const DpiManager& dpi,
                          std::vector<ImageData>& imageData,
-                         int32_t& playCount,
-                         bool& bDpiScaled);
+                         int32_t& playCount);
 
     /** 对图片数据进行大小缩放
     * @param [in] imageData 需要缩放的图片数据
@@ -1,8 +1,36 @@
 #include "ImageInfo.h"
+#include "duilib/Image/SvgDocument.h"
+#include "duilib/Core/GlobalManager.h"
+#include <algorithm>
 
 namespace ui 
 {
 
+/** SVG图片的数据
+*/
+struct ImageInfo::SvgImageData
+{
+    /** SVG文档
+    */
+    std::shared_ptr<SvgDocument> m_spSvgDocument;
+
+    /** 按绘制的目标大小光栅化生成的位图（最近使用的排在最后）
+    */
+    std::vector<std::pair<UiSize, std::unique_ptr<IBitmap>>> m_sizedBitmaps;
+
+    /** 正在工作线程中光栅化的位图大小，及完成后的回调函数
+    */
+    std::vector<std::pair<UiSize, std::vector<StdClosure>>> m_pendingRequests;
+
+    /** 光栅化任务完成时回调的生命周期标志
+    */
+    WeakCallbackFlag m_taskFlag;
+};
+
+/** 每个SVG图片最多缓存的按目标大小光栅化的位图个数
+*/
+static constexpr size_t kMaxSvgSizedBitmaps = 4;
+
 ImageInfo::ImageInfo():
     m_bDpiScaled(false),
     m_nWidth(0),
@@ -147,4 +175,128 @@ DString ImageInfo::GetImageKey() const
     return m_imageKey.c_str();
 }
 
+void ImageInfo::SetSvgDocument(const std::shared_ptr<SvgDocument>& spSvgDocument)
+{
+    if (spSvgDocument == nullptr) {
+        m_pSvgData.reset();
+        return;
+    }
+    if (m_pSvgData == nullptr) {
+        m_pSvgData = std::make_unique<SvgImageData>();
+    }
+    m_pSvgData->m_spSvgDocument = spSvgDocument;
+}
+
+std::shared_ptr<SvgDocument> ImageInfo::GetSvgDocument() const
+{
+    if (m_pSvgData == nullptr) {
+        return nullptr;
+    }
+    return m_pSvgData->m_spSvgDocument;
+}
+
+IBitmap* ImageInfo::GetSvgSizedBitmap(const UiSize& szBitmap, const StdClosure& callback)
+{
+    if ((m_pSvgData == nullptr) || (m_pSvgData->m_spSvgDocument == nullptr) ||
+        (szBitmap.cx <= 0) || (szBitmap.cy <= 0)) {
+        return nullptr;
+    }
+    auto& sizedBitmaps = m_pSvgData->m_sizedBitmaps;
+    for (size_t nIndex = 0; nIndex < sizedBitmaps.size(); ++nIndex) {
+        if (sizedBitmaps[nIndex].first == szBitmap) {
+            //标记为最近使用
+            if ((nIndex + 1) < sizedBitmaps.size()) {
+                std::rotate(sizedBitmaps.begin() + nIndex, sizedBitmaps.begin() + nIndex + 1, sizedBitmaps.end());
+            }
+            return sizedBitmaps.back().second.get();
+        }
+    }
+
+    //已有相同大小的光栅化任务，只添加回调函数
+    for (auto& request : m_pSvgData->m_pendingRequests) {
+        if (request.first == szBitmap) {
+            if (callback != nullptr) {
+                request.second.push_back(callback);
+            }
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<SvgDocument> spSvgDocument = m_pSvgData->m_spSvgDocument;
+    ThreadManager& threadManager = GlobalManager::Instance().Thread();
+    if (!threadManager.HasThread(kThreadWorker)) {
+        //未注册工作线程，同步光栅化
+        std::vector<uint8_t> bitmapData;
+        if (!spSvgDocument->RasterizeToSize((uint32_t)szBitmap.cx, (uint32_t)szBitmap.cy, bitmapData)) {
+            return nullptr;
+        }
+        return AddSvgSizedBitmap(szBitmap, bitmapData);
+    }
+
+    m_pSvgData->m_pendingRequests.push_back({ szBitmap, {} });
+    if (callback != nullptr) {
+        m_pSvgData->m_pendingRequests.back().second.push_back(callback);
+    }
+    //SVG文档是只读的，可在工作线程中光栅化；完成后回到UI线程中创建位图
+    std::shared_ptr<std::vector<uint8_t>> spBitmapData = std::make_shared<std::vector<uint8_t>>();
+    StdClosure onRasterized = m_pSvgData->m_taskFlag.ToWeakCallback([this, szBitmap, spBitmapData]() {
+            OnSvgRasterized(szBitmap, *spBitmapData);
+        });
+    threadManager.PostTask(kThreadWorker, [spSvgDocument, szBitmap, spBitmapData, onRasterized]() {
+            if (!spSvgDocument->RasterizeToSize((uint32_t)szBitmap.cx, (uint32_t)szBitmap.cy, *spBitmapData)) {
+                spBitmapData->clear();
+            }
+            GlobalManager::Instance().Thread().PostTask(kThreadUI, onRasterized);
+        });
+    return nullptr;
+}
+
+void ImageInfo::OnSvgRasterized(const UiSize& szBitmap, const std::vector<uint8_t>& bitmapData)
+{
+    if (m_pSvgData == nullptr) {
+        return;
+    }
+    std::vector<StdClosure> callbacks;
+    auto& pendingRequests = m_pSvgData->m_pendingRequests;
+    for (auto iter = pendingRequests.begin(); iter != pendingRequests.end(); ++iter) {
+        if (iter->first == szBitmap) {
+            callbacks.swap(iter->second);
+            pendingRequests.erase(iter);
+            break;
+        }
+    }
+    if (bitmapData.empty() || (AddSvgSizedBitmap(szBitmap, bitmapData) == nullptr)) {
+        return;
+    }
+    for (const StdClosure& callback : callbacks) {
+        callback();
+    }
+}
+
+IBitmap* ImageInfo::AddSvgSizedBitmap(const UiSize& szBitmap, const std::vector<uint8_t>& bitmapData)
+{
+    ASSERT(bitmapData.size() == ((size_t)szBitmap.cx * szBitmap.cy * 4));
+    if (bitmapData.size() != ((size_t)szBitmap.cx * szBitmap.cy * 4)) {
+        return nullptr;
+    }
+    IRenderFactory* pRenderFactroy = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactroy != nullptr);
+    if (pRenderFactroy == nullptr) {
+        return nullptr;
+    }
+    std::unique_ptr<IBitmap> pBitmap(pRenderFactroy->CreateBitmap());
+    ASSERT(pBitmap != nullptr);
+    if (pBitmap == nullptr) {
+        return nullptr;
+    }
+    pBitmap->Init((uint32_t)szBitmap.cx, (uint32_t)szBitmap.cy, true, bitmapData.data());
+    auto& sizedBitmaps = m_pSvgData->m_sizedBitmaps;
+    if (sizedBitmaps.size() >= kMaxSvgSizedBitmaps) {
+        //淘汰最久未使用的位图
+        sizedBitmaps.erase(sizedBitmaps.begin());
+    }
+    sizedBitmaps.push_back({ szBitmap, std::move(pBitmap) });
+    return sizedBitmaps.back().second.get();
+}
+
 }
@@ -3,11 +3,13 @@
 
 #include "duilib/Render/IRender.h"
 #include "duilib/Core/UiTypes.h"
+#include <memory>
 
 namespace ui 
 {
     class IRender;
     class Control;
+    class SvgDocument;
 
 /** 图片信息
 */
@@ -103,6 +105,31 @@ public:
     */
     DString GetImageKey() const;
 
+    /** 设置SVG文档（SVG图片加载时设置，用于矢量绘制，或者按绘制的目标大小重新光栅化）
+    */
+    void SetSvgDocument(const std::shared_ptr<SvgDocument>& spSvgDocument);
+
+    /** 获取SVG文档（非SVG图片返回nullptr）
+    */
+    std::shared_ptr<SvgDocument> GetSvgDocument() const;
+
+    /** 获取SVG图片按指定大小光栅化生成的位图
+    * @param [in] szBitmap 位图的大小
+    * @param [in] callback 如果该大小的位图尚未生成，则在工作线程中光栅化，完成后在UI线程中回调（用于重绘控件）
+    * @return 如果该大小的位图已经生成，返回位图接口，否则返回nullptr
+    *         如果未注册工作线程，在当前线程中同步光栅化，返回生成的位图，不回调
+    */
+    IBitmap* GetSvgSizedBitmap(const UiSize& szBitmap, const StdClosure& callback);
+
+private:
+    /** SVG图片在工作线程中光栅化完成（在UI线程中调用）
+    */
+    void OnSvgRasterized(const UiSize& szBitmap, const std::vector<uint8_t>& bitmapData);
+
+    /** 添加一个按指定大小光栅化生成的SVG位图
+    */
+    IBitmap* AddSvgSizedBitmap(const UiSize& szBitmap, const std::vector<uint8_t>& bitmapData);
+
 private:
     //该图片的大小是否已经做过适应DPI处理（这个属性值影响：图片的"source"和"corner"属性的DPI缩放操作）
     bool m_bDpiScaled;
@@ -136,6 +163,11 @@ private:
     /** 实际图片的KEY, 用于图片的生命周期管理（多个DPI的图片，实际可能指向同一个文件）
     */
     UiString m_imageKey;
+
+    /** SVG图片的数据（仅SVG图片有）
+    */
+    struct SvgImageData;
+    std::unique_ptr<SvgImageData> m_pSvgData;
 };
 
 } // namespace ui
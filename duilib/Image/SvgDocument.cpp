@@ -0,0 +1,226 @@
+#include "SvgDocument.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4456 4244 4702)
+#define NANOSVG_IMPLEMENTATION
+#define NANOSVG_ALL_COLOR_KEYWORDS
+#include "duilib/third_party/svg/nanosvg.h"
+#define NANOSVGRAST_IMPLEMENTATION
+#include "duilib/third_party/svg/nanosvgrast.h"
+#pragma warning (pop)
+
+namespace ui
+{
+namespace
+{
+    class RasterizerDeleter
+    {
+    public:
+        inline void operator()(NSVGrasterizer* x) const { nsvgDeleteRasterizer(x); }
+    };
+
+    /** 转换SVG的颜色值（格式为ABGR），并应用图形的透明度
+    */
+    UiColor GetSvgColor(uint32_t svgColor, float fOpacity)
+    {
+        uint32_t alpha = (svgColor >> 24) & 0xFF;
+        alpha = static_cast<uint32_t>(alpha * fOpacity + 0.5f);
+        if (alpha > 0xFF) {
+            alpha = 0xFF;
+        }
+        return UiColor(static_cast<uint8_t>(alpha),
+                       static_cast<uint8_t>(svgColor & 0xFF),
+                       static_cast<uint8_t>((svgColor >> 8) & 0xFF),
+                       static_cast<uint8_t>((svgColor >> 16) & 0xFF));
+    }
+}
+
+SvgDocument::SvgDocument():
+    m_pSvgImage(nullptr),
+    m_bVectorSupported(false)
+{
+}
+
+SvgDocument::~SvgDocument()
+{
+    if (m_pSvgImage != nullptr) {
+        nsvgDelete(m_pSvgImage);
+        m_pSvgImage = nullptr;
+    }
+}
+
+std::shared_ptr<SvgDocument> SvgDocument::Parse(std::vector<uint8_t>& fileData)
+{
+    ASSERT(!fileData.empty());
+    if (fileData.empty()) {
+        return nullptr;
+    }
+    bool hasAppended = false;
+    if (fileData.back() != '\0') {
+        //确保是含尾0的字符串，避免越界访问内存
+        fileData.push_back('\0');
+        hasAppended = true;
+    }
+    char* pData = (char*)fileData.data();
+    NSVGimage* svgData = nsvgParse(pData, "px", 96.0f);//传入"px"时，第三个参数dpi是不起作用的。
+    if (hasAppended) {
+        fileData.pop_back();
+    }
+    if (svgData == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<SvgDocument> spSvgDocument(new SvgDocument);
+    spSvgDocument->m_pSvgImage = svgData;
+    if (((int)svgData->width <= 0) || ((int)svgData->height <= 0)) {
+        return nullptr;
+    }
+    spSvgDocument->InitVectorShapes();
+    return spSvgDocument;
+}
+
+float SvgDocument::GetWidth() const
+{
+    return (m_pSvgImage != nullptr) ? m_pSvgImage->width : 0;
+}
+
+float SvgDocument::GetHeight() const
+{
+    return (m_pSvgImage != nullptr) ? m_pSvgImage->height : 0;
+}
+
+bool SvgDocument::Rasterize(float fScale, uint32_t nWidth, uint32_t nHeight, std::vector<uint8_t>& bitmapData) const
+{
+    ASSERT(m_pSvgImage != nullptr);
+    if ((m_pSvgImage == nullptr) || (fScale <= 0) || (nWidth == 0) || (nHeight == 0)) {
+        return false;
+    }
+    //光栅化器有内部状态，每次调用单独创建，以支持多线程同时调用
+    std::unique_ptr<NSVGrasterizer, RasterizerDeleter> rast(nsvgCreateRasterizer());
+    if (!rast) {
+        return false;
+    }
+
+    constexpr const uint32_t dataSize = 4;
+    bitmapData.resize((size_t)nHeight * nWidth * dataSize);
+    uint8_t* pBmpBits = bitmapData.data();
+    if (pBmpBits == nullptr) {
+        return false;
+    }
+    nsvgRasterize(rast.get(), m_pSvgImage, 0, 0, fScale, pBmpBits, (int)nWidth, (int)nHeight, (int)(nWidth * dataSize));
+
+#ifdef DUILIB_BUILD_FOR_WIN
+    //数据格式：Window平台BGRA，其他平台RGBA
+    // nanosvg内部已经做过alpha预乘，这里只做R和B的交换
+    for (uint32_t y = 0; y < nHeight; ++y) {
+        unsigned char* row = &pBmpBits[y * nWidth * dataSize];
+        for (uint32_t x = 0; x < nWidth; ++x) {
+            //SVG    数据的各个颜色值：row[0]:R, row[1]: G, row[2]: B, row[3]: A
+            //输出    数据的各个颜色值：row[0]:B, row[1]: G, row[2]: R, row[3]: A
+            unsigned char r = row[0];
+            row[0] = row[2];
+            row[2] = r;
+            row += 4;
+        }
+    }
+#endif
+    return true;
+}
+
+bool SvgDocument::RasterizeToSize(uint32_t nWidth, uint32_t nHeight, std::vector<uint8_t>& bitmapData) const
+{
+    const float fWidth = GetWidth();
+    const float fHeight = GetHeight();
+    if ((fWidth <= 0) || (fHeight <= 0)) {
+        return false;
+    }
+    //svg的缩放，只能按比例，锁定纵横比的方式缩放
+    float scaleX = nWidth / fWidth;
+    float scaleY = nHeight / fHeight;
+    float scale = (scaleX > scaleY) ? scaleX : scaleY; //取最大的缩放比
+    return Rasterize(scale, nWidth, nHeight, bitmapData);
+}
+
+bool SvgDocument::IsVectorSupported() const
+{
+    return m_bVectorSupported;
+}
+
+const std::vector<VectorShape>& SvgDocument::GetVectorShapes() const
+{
+    return m_vectorShapes;
+}
+
+void SvgDocument::InitVectorShapes()
+{
+    m_vectorShapes.clear();
+    m_bVectorSupported = false;
+    if (m_pSvgImage == nullptr) {
+        return;
+    }
+    for (NSVGshape* shape = m_pSvgImage->shapes; shape != nullptr; shape = shape->next) {
+        if (!(shape->flags & NSVG_FLAGS_VISIBLE)) {
+            continue;
+        }
+        if ((shape->fill.type == NSVG_PAINT_LINEAR_GRADIENT) ||
+            (shape->fill.type == NSVG_PAINT_RADIAL_GRADIENT) ||
+            (shape->stroke.type == NSVG_PAINT_LINEAR_GRADIENT) ||
+            (shape->stroke.type == NSVG_PAINT_RADIAL_GRADIENT)) {
+            //渐变色不支持矢量绘制
+            m_vectorShapes.clear();
+            return;
+        }
+        VectorShape vectorShape;
+        for (NSVGpath* path = shape->paths; path != nullptr; path = path->next) {
+            if ((path->pts == nullptr) || (path->npts <= 0)) {
+                continue;
+            }
+            for (int i = 0; i < path->npts; ++i) {
+                vectorShape.m_points.push_back(UiPointF(path->pts[i * 2], path->pts[i * 2 + 1]));
+            }
+            vectorShape.m_pathPoints.push_back((uint32_t)path->npts);
+            vectorShape.m_pathClosed.push_back(path->closed != 0);
+        }
+        if (vectorShape.m_points.empty()) {
+            continue;
+        }
+        if (shape->fill.type == NSVG_PAINT_COLOR) {
+            vectorShape.m_bFill = true;
+            vectorShape.m_fillColor = GetSvgColor(shape->fill.color, shape->opacity);
+            vectorShape.m_bEvenOddFill = (shape->fillRule == NSVG_FILLRULE_EVENODD);
+        }
+        if ((shape->stroke.type == NSVG_PAINT_COLOR) && (shape->strokeWidth > 0)) {
+            vectorShape.m_bStroke = true;
+            vectorShape.m_strokeColor = GetSvgColor(shape->stroke.color, shape->opacity);
+            vectorShape.m_fStrokeWidth = shape->strokeWidth;
+            vectorShape.m_fMiterLimit = shape->miterLimit;
+            if (shape->strokeLineCap == NSVG_CAP_ROUND) {
+                vectorShape.m_strokeCap = IPen::kRound_Cap;
+            }
+            else if (shape->strokeLineCap == NSVG_CAP_SQUARE) {
+                vectorShape.m_strokeCap = IPen::kSquare_Cap;
+            }
+            if (shape->strokeLineJoin == NSVG_JOIN_ROUND) {
+                vectorShape.m_strokeJoin = IPen::kRound_Join;
+            }
+            else if (shape->strokeLineJoin == NSVG_JOIN_BEVEL) {
+                vectorShape.m_strokeJoin = IPen::kBevel_Join;
+            }
+            for (int i = 0; i < shape->strokeDashCount; ++i) {
+                vectorShape.m_dashIntervals.push_back(shape->strokeDashArray[i]);
+            }
+            if (vectorShape.m_dashIntervals.size() % 2) {
+                //奇数个间隔时，按SVG规范重复一次
+                std::vector<float> dashIntervals = vectorShape.m_dashIntervals;
+                vectorShape.m_dashIntervals.insert(vectorShape.m_dashIntervals.end(),
+                                                   dashIntervals.begin(), dashIntervals.end());
+            }
+            vectorShape.m_fDashOffset = shape->strokeDashOffset;
+        }
+        if (vectorShape.m_bFill || vectorShape.m_bStroke) {
+            m_vectorShapes.push_back(std::move(vectorShape));
+        }
+    }
+    m_bVectorSupported = true;
+}
+
+} // namespace ui
@@ -0,0 +1,85 @@
+#ifndef UI_IMAGE_SVG_DOCUMENT_H_
+#define UI_IMAGE_SVG_DOCUMENT_H_
+
+#include "duilib/Render/IRender.h"
+#include <memory>
+#include <vector>
+
+struct NSVGimage;
+
+namespace ui
+{
+/** SVG文档：SVG文件解析后的图形数据，解析一次后可重复使用（按不同大小光栅化，或者直接矢量绘制）
+*   解析后的数据是只读的，光栅化函数可以在多个线程中同时调用
+*/
+class UILIB_API SvgDocument
+{
+public:
+    ~SvgDocument();
+    SvgDocument(const SvgDocument&) = delete;
+    SvgDocument& operator = (const SvgDocument&) = delete;
+
+private:
+    SvgDocument();
+
+public:
+    /** 解析SVG文件数据
+    * @param [in] fileData SVG文件的数据，解析过程中内部有增加尾0的写操作
+    * @return 成功返回SVG文档，失败返回nullptr
+    */
+    static std::shared_ptr<SvgDocument> Parse(std::vector<uint8_t>& fileData);
+
+    /** 获取SVG图片的原始宽度
+    */
+    float GetWidth() const;
+
+    /** 获取SVG图片的原始高度
+    */
+    float GetHeight() const;
+
+    /** 光栅化为位图数据（可在任意线程中调用）
+    * @param [in] fScale 缩放比例
+    * @param [in] nWidth 位图的宽度
+    * @param [in] nHeight 位图的高度
+    * @param [out] bitmapData 位图数据（每个像素4个字节，已做alpha预乘，Windows平台为BGRA格式，其他平台为RGBA格式）
+    */
+    bool Rasterize(float fScale, uint32_t nWidth, uint32_t nHeight, std::vector<uint8_t>& bitmapData) const;
+
+    /** 光栅化为指定大小的位图数据（可在任意线程中调用）
+    *   按锁定纵横比的方式缩放，取横向和纵向中较大的缩放比，超出位图大小的部分被裁剪
+    * @param [in] nWidth 位图的宽度
+    * @param [in] nHeight 位图的高度
+    * @param [out] bitmapData 位图数据，格式同Rasterize函数
+    */
+    bool RasterizeToSize(uint32_t nWidth, uint32_t nHeight, std::vector<uint8_t>& bitmapData) const;
+
+    /** 是否支持矢量绘制（含渐变色填充的图形不支持矢量绘制，只能光栅化后绘制）
+    */
+    bool IsVectorSupported() const;
+
+    /** 获取矢量绘制的图形（坐标为SVG图片的原始坐标）
+    */
+    const std::vector<VectorShape>& GetVectorShapes() const;
+
+private:
+    /** 将解析后的图形转换为矢量绘制的图形
+    */
+    void InitVectorShapes();
+
+private:
+    /** SVG解析后的数据
+    */
+    NSVGimage* m_pSvgImage;
+
+    /** 矢量绘制的图形
+    */
+    std::vector<VectorShape> m_vectorShapes;
+
+    /** 是否支持矢量绘制
+    */
+    bool m_bVectorSupported;
+};
+
+} // namespace ui
+
+#endif // UI_IMAGE_SVG_DOCUMENT_H_
@@ -0,0 +1,27 @@
+#include "AutoAtlasBatch.h"
+#include "duilib/Render/IRender.h"
+
+namespace ui 
+{
+
+AutoAtlasBatch::AutoAtlasBatch(IRender* pRender, bool bBatch)
+{
+    m_pRender = nullptr;
+    if (bBatch) {
+        ASSERT(pRender != nullptr);
+        m_pRender = pRender;
+        if (m_pRender != nullptr) {
+            m_pRender->BeginAtlasBatch();
+        }
+    }
+}
+
+AutoAtlasBatch::~AutoAtlasBatch()
+{
+    if (m_pRender != nullptr) {
+        m_pRender->EndAtlasBatch();
+        m_pRender = nullptr;
+    }
+}
+
+} // namespace ui
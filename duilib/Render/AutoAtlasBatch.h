@@ -0,0 +1,27 @@
+#ifndef UI_RENDER_AUTO_ATLAS_BATCH_H_
+#define UI_RENDER_AUTO_ATLAS_BATCH_H_
+
+#include "duilib/duilib_defs.h"
+
+namespace ui 
+{
+
+class IRender;
+
+/** 批量绘制图集图片的辅助类：构造时开始批量绘制，析构时结束批量绘制（绘制缓存的图片）
+*/
+class UILIB_API AutoAtlasBatch
+{
+public:
+    AutoAtlasBatch(IRender* pRender, bool bBatch = true);
+    ~AutoAtlasBatch();
+    AutoAtlasBatch(const AutoAtlasBatch&) = delete;
+    AutoAtlasBatch& operator = (const AutoAtlasBatch&) = delete;
+
+private:
+    IRender* m_pRender;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_AUTO_ATLAS_BATCH_H_
@@ -145,6 +145,24 @@ public:
     virtual IBitmap* Clone() = 0;
 };
 
+/** 显示列表接口：录制下来的绘制命令，可以在任意位置回放（参见IRender::RecordPicture）
+*/
+class UILIB_API IPicture : public virtual SupportWeakCallback
+{
+public:
+    /** 获取录制区域的宽度
+    */
+    virtual int32_t GetWidth() const = 0;
+
+    /** 获取录制区域的高度
+    */
+    virtual int32_t GetHeight() const = 0;
+
+    /** 获取显示列表占用的内存大小（估算值，字节）
+    */
+    virtual size_t GetMemorySize() const = 0;
+};
+
 /** 画笔接口
 */
 class UILIB_API IPen : public virtual SupportWeakCallback
@@ -686,6 +704,48 @@ enum class RenderBackendType
     kNativeGL_BackendType = 1
 };
 
+/** 矢量图形（比如SVG图片解析后的图形），坐标为浮点数，绘制时按目标区域缩放（参见IRender::DrawVectorShapes）
+*/
+struct VectorShape
+{
+    /** 路径的点：由若干子路径组成，每个子路径由起点和若干三次贝塞尔曲线段（每段3个点：2个控制点和终点）组成
+    */
+    std::vector<UiPointF> m_points;
+
+    /** 每个子路径的点数
+    */
+    std::vector<uint32_t> m_pathPoints;
+
+    /** 每个子路径是否闭合
+    */
+    std::vector<bool> m_pathClosed;
+
+    /** 是否填充，填充的颜色，填充规则（true表示EvenOdd，false表示NonZero）
+    */
+    bool m_bFill = false;
+    UiColor m_fillColor;
+    bool m_bEvenOddFill = false;
+
+    /** 是否描边，描边的颜色、宽度、笔帽、拐角类型和尖角限制
+    */
+    bool m_bStroke = false;
+    UiColor m_strokeColor;
+    float m_fStrokeWidth = 1.0f;
+    IPen::LineCap m_strokeCap = IPen::kButt_Cap;
+    IPen::LineJoin m_strokeJoin = IPen::kMiter_Join;
+    float m_fMiterLimit = 4.0f;
+
+    /** 描边的虚线间隔和起始偏移（间隔为空表示实线）
+    */
+    std::vector<float> m_dashIntervals;
+    float m_fDashOffset = 0;
+};
+
+/** 并行绘制时录制绘制命令的回调函数，参数为录制用的Render（在该Render上执行的绘制操作被录制下来，稍后并行回放）
+*/
+class IRender;
+typedef std::function<void(IRender* pRecordRender)> RenderRecordCallback;
+
 /** 渲染接口
 */
 class IRenderFactory;
@@ -845,6 +905,53 @@ public:
                                const UiRect& rcDest, const UiRect& rcSource,
                                uint8_t uFade = 255, IMatrix* pMatrix = nullptr) = 0;
 
+    /** 开始批量绘制图集中的图片（可嵌套调用，与EndAtlasBatch配对使用）
+    *   在批量绘制期间，DrawAtlasImage绘制的图片先缓存起来，在EndAtlasBatch时合并为一次绘制；
+    *   如果期间有其他绘制操作与缓存的图片区域重叠，会先绘制缓存的图片，以保证绘制顺序正确
+    */
+    virtual void BeginAtlasBatch() = 0;
+
+    /** 结束批量绘制图集中的图片，绘制缓存的所有图片
+    */
+    virtual void EndAtlasBatch() = 0;
+
+    /** 当前是否处于批量绘制图集图片的状态
+    */
+    virtual bool IsAtlasBatchActive() const = 0;
+
+    /** 设置缩放绘制位图时，是否使用高质量的采样方式（三次插值），默认使用最近邻采样
+    *   影响DrawImage和DrawImageRect函数
+    */
+    virtual void SetImageHighQualitySampling(bool bHighQuality) = 0;
+
+    /** 缩放绘制位图时，是否使用高质量的采样方式
+    */
+    virtual bool IsImageHighQualitySampling() const = 0;
+
+    /** 绘制图集中的图片（不缩放，目标区域与源区域的大小需相同）
+    *   如果处于批量绘制状态，则缓存起来合并绘制，否则立即绘制
+    * @param [in] rcPaint 当前全部可绘制区域（用于避免非可绘制区域的绘制，以提高绘制性能）
+    * @param [in] spAtlasBitmap 图集的位图
+    * @param [in] rcDest 绘制的目标区域
+    * @param [in] rcSource 图片在图集位图中的区域
+    * @param [in] uFade 透明度（0 - 255）
+    */
+    virtual void DrawAtlasImage(const UiRect& rcPaint, const std::shared_ptr<IBitmap>& spAtlasBitmap,
+                                const UiRect& rcDest, const UiRect& rcSource, uint8_t uFade = 255) = 0;
+
+    /** 绘制矢量图形（按缩放比例直接绘制路径，绘制结果与分辨率无关）
+    *   图形中的坐标(x, y)，绘制到(rcDest.left + x * fScaleX, rcDest.top + y * fScaleY)，描边宽度同步缩放
+    * @param [in] rcPaint 当前全部可绘制区域（用于避免非可绘制区域的绘制，以提高绘制性能）
+    * @param [in] shapes 需要绘制的矢量图形
+    * @param [in] rcDest 绘制的目标区域
+    * @param [in] fScaleX 横向缩放比例
+    * @param [in] fScaleY 纵向缩放比例
+    * @param [in] uFade 透明度（0 - 255）
+    */
+    virtual void DrawVectorShapes(const UiRect& rcPaint, const std::vector<VectorShape>& shapes,
+                                  const UiRect& rcDest, float fScaleX, float fScaleY,
+                                  uint8_t uFade = 255) = 0;
+
     /** 绘制直线
     * @param [in] pt1 起始点坐标
     * @param [in] pt2 终止点坐标
@@ -1208,6 +1315,14 @@ public:
     */
     virtual bool WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc, const UiRect& rcPaint) = 0;
 
+    /** 在矩形范围内移动位图数据（用于滚动时复用已经绘制的内容），移出矩形的部分被丢弃，新露出的部分内容不变
+    * @param [in] rcScroll 矩形范围（位图坐标，不受SetWindowOrg影响）
+    * @param [in] dx 横向移动距离（向右为正）
+    * @param [in] dy 纵向移动距离（向下为正）
+    * @return 成功返回true；如果不支持（比如非CPU绘制），返回false
+    */
+    virtual bool ScrollPixels(const UiRect& rcScroll, int32_t dx, int32_t dy) = 0;
+
     /** 获取当前的裁剪区域
     * @param [out] clipRects 返回裁剪区域的矩形数据，矩形区域坐标为客户区坐标
                              如果是 RenderClipType::kRect类型，容器中只有一个元素，
@@ -1233,6 +1348,28 @@ public:
     */
     virtual bool PaintAndSwapBuffers(IRenderPaint* pRenderPaint) = 0;
 
+    /** 并行绘制：先将绘制命令录制为显示列表，然后将绘制区域切分为多个分块，在多个线程中并行回放到本Render中，全部完成后返回
+    * @param [in] rcPaint 绘制区域
+    * @param [in] recordCallback 录制回调函数，在录制用的Render上执行实际的绘制
+    * @return 成功返回true；如果不支持（比如非CPU绘制），或者录制过程中执行了无法录制的操作（比如读写像素数据），返回false，
+    *         此时本Render的内容未被修改，调用方需要按常规方式重新绘制
+    */
+    virtual bool PaintRecorded(const UiRect& rcPaint, const RenderRecordCallback& recordCallback) = 0;
+
+    /** 录制显示列表：录制区域为(0, 0, nWidth, nHeight)，DPI与本Render相同
+    * @param [in] nWidth 录制区域的宽度
+    * @param [in] nHeight 录制区域的高度
+    * @param [in] recordCallback 录制回调函数，在录制用的Render上执行实际的绘制
+    * @return 返回显示列表接口，由调用方管理资源；如果录制过程中执行了无法录制的操作（比如读写像素数据），返回nullptr
+    */
+    virtual IPicture* RecordPicture(int32_t nWidth, int32_t nHeight, const RenderRecordCallback& recordCallback) = 0;
+
+    /** 回放显示列表
+    * @param [in] rcDest 目标矩形区域，显示列表的原点对齐到该区域的左上角，超出该区域的部分被裁剪
+    * @param [in] pPicture 显示列表接口
+    * @param [in] uFade 透明度（0 - 255）
+    */
+    virtual void DrawPicture(const UiRect& rcDest, const IPicture* pPicture, uint8_t uFade = 255) = 0;
 };
 
 /** 渲染接口管理，用于创建Font、Pen、Brush、Path、Matrix、Bitmap、Render等渲染实现对象
@@ -4,19 +4,22 @@
 #pragma warning (disable: 4244 4201)
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
 
 #pragma warning (pop)
 
 namespace ui
 {
 
-Bitmap_Skia::Bitmap_Skia()
+Bitmap_Skia::Bitmap_Skia():
+    m_pSkImage(nullptr)
 {
     m_pSkBitmap = std::make_unique<SkBitmap>();
 }
 
 Bitmap_Skia::~Bitmap_Skia()
 {
+    ReleaseSkImage();
     m_pSkBitmap.reset();
 }
 
@@ -41,6 +44,7 @@ bool Bitmap_Skia::Init(uint32_t nWidth, uint32_t nHeight, bool flipHeight,
         }
     }
 
+    ReleaseSkImage();
     m_pSkBitmap->reset();
     m_pSkBitmap->setInfo(SkImageInfo::Make(nWidth, nHeight, kN32_SkColorType, static_cast<SkAlphaType>(alphaType)));
     m_pSkBitmap->allocPixels();
@@ -93,6 +97,8 @@ UiSize Bitmap_Skia::GetSize() const
 
 void* Bitmap_Skia::LockPixelBits()
 {
+    //调用方可能会修改位图数据，缓存的SkImage需要重新生成
+    ReleaseSkImage();
     void* pPixelBits = nullptr;
     SkPixmap pixmap;
     if (m_pSkBitmap->peekPixels(&pixmap)) {
@@ -165,4 +171,21 @@ const SkBitmap& Bitmap_Skia::GetSkBitmap() const
     return *m_pSkBitmap.get();
 }
 
+SkImage* Bitmap_Skia::GetSkImage() const
+{
+    if (m_pSkImage == nullptr) {
+        sk_sp<SkImage> skImage = m_pSkBitmap->asImage();//复制一份位图数据
+        m_pSkImage = skImage.release();
+    }
+    return m_pSkImage;
+}
+
+void Bitmap_Skia::ReleaseSkImage()
+{
+    if (m_pSkImage != nullptr) {
+        m_pSkImage->unref();
+        m_pSkImage = nullptr;
+    }
+}
+
 } // namespace ui
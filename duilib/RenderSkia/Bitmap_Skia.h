@@ -5,6 +5,7 @@
 
 //Skia相关类的前置声明
 class SkBitmap;
+class SkImage;
 
 namespace ui
 {
@@ -59,6 +60,10 @@ public:
     */
     const SkBitmap& GetSkBitmap() const;
 
+    /** 获取位图对应的SkImage（缓存起来重复使用，避免每次绘制时复制位图数据；修改位图数据后自动重新生成）
+    */
+    SkImage* GetSkImage() const;
+
 private:
     /** 更新图片的透明通道标志
     */
@@ -68,10 +73,18 @@ private:
     */
     void FlipPixelBits(const uint8_t* pPixelBits, uint32_t nWidth, uint32_t nHeight, std::vector<uint8_t>& flipBits);
 
+    /** 释放缓存的SkImage
+    */
+    void ReleaseSkImage();
+
 private:
     /** Skia 位图
     */
     std::unique_ptr<SkBitmap> m_pSkBitmap;
+
+    /** 缓存的SkImage（由GetSkImage生成，持有一个引用计数）
+    */
+    mutable SkImage* m_pSkImage;
 };
 
 } // namespace ui
@@ -327,7 +327,8 @@ void FontMgr_Skia::ClearFontCache()
 
 SkFont* FontMgr_Skia::CreateSkFont(const UiFont& fontInfo)
 {
-    PerformanceStat statPerformance(_T("FontMgr_Skia::CreateSkFont"));
+    static const PerformanceStatId s_statId(_T("FontMgr_Skia::CreateSkFont"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT(!fontInfo.m_fontName.empty());
     if (fontInfo.m_fontName.empty()) {
         return nullptr;
@@ -0,0 +1,46 @@
+#include "Picture_Skia.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100)
+
+#include "include/core/SkPicture.h"
+
+#pragma warning (pop)
+
+namespace ui {
+
+Picture_Skia::Picture_Skia(const sk_sp<SkPicture>& spPicture, int32_t nWidth, int32_t nHeight):
+    m_spPicture(spPicture),
+    m_nWidth(nWidth),
+    m_nHeight(nHeight)
+{
+}
+
+Picture_Skia::~Picture_Skia()
+{
+}
+
+int32_t Picture_Skia::GetWidth() const
+{
+    return m_nWidth;
+}
+
+int32_t Picture_Skia::GetHeight() const
+{
+    return m_nHeight;
+}
+
+size_t Picture_Skia::GetMemorySize() const
+{
+    if (m_spPicture == nullptr) {
+        return 0;
+    }
+    return m_spPicture->approximateBytesUsed();
+}
+
+const sk_sp<SkPicture>& Picture_Skia::GetSkPicture() const
+{
+    return m_spPicture;
+}
+
+} // namespace ui
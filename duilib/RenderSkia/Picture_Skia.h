@@ -0,0 +1,62 @@
+#ifndef UI_RENDER_SKIA_PICTURE_H_
+#define UI_RENDER_SKIA_PICTURE_H_
+
+#include "duilib/Render/IRender.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100)
+
+#include "include/core/SkRefCnt.h"
+
+#pragma warning (pop)
+
+//Skia相关类的前置声明
+class SkPicture;
+
+namespace ui
+{
+/** 显示列表的实现：Skia绘制引擎
+*/
+class UILIB_API Picture_Skia: public IPicture
+{
+public:
+    /** 构造函数
+    * @param [in] spPicture 录制好的显示列表
+    * @param [in] nWidth 录制区域的宽度
+    * @param [in] nHeight 录制区域的高度
+    */
+    Picture_Skia(const sk_sp<SkPicture>& spPicture, int32_t nWidth, int32_t nHeight);
+    virtual ~Picture_Skia() override;
+
+public:
+    /** 获取录制区域的宽度
+    */
+    virtual int32_t GetWidth() const override;
+
+    /** 获取录制区域的高度
+    */
+    virtual int32_t GetHeight() const override;
+
+    /** 获取显示列表占用的内存大小（估算值，字节）
+    */
+    virtual size_t GetMemorySize() const override;
+
+public:
+    /** 获取Skia显示列表
+    */
+    const sk_sp<SkPicture>& GetSkPicture() const;
+
+private:
+    /** Skia显示列表
+    */
+    sk_sp<SkPicture> m_spPicture;
+
+    /** 录制区域的大小
+    */
+    int32_t m_nWidth;
+    int32_t m_nHeight;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_PICTURE_H_
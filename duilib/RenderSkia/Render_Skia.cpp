@@ -5,10 +5,13 @@
 #include "duilib/RenderSkia/Matrix_Skia.h"
 #include "duilib/RenderSkia/Font_Skia.h"
 #include "duilib/RenderSkia/SkTextBox.h"
+#include "duilib/RenderSkia/Render_Skia_Picture.h"
+#include "duilib/RenderSkia/Picture_Skia.h"
 #include "duilib/Render/BitmapAlpha.h"
 
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/ParallelTaskRunner.h"
 #include "duilib/Core/SharePtr.h"
 
 #pragma warning (push)
@@ -20,6 +23,8 @@
 #include "include/core/SkImage.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRegion.h"
@@ -43,7 +48,8 @@ static inline void DrawFunction(SkCanvas* pSkCanvas,
                                 const SkPoint& skPointOrg,
                                 const sk_sp<SkImage>& skImage,
                                 const UiRect& rcSrc,
-                                const SkPaint& skPaint)
+                                const SkPaint& skPaint,
+                                bool bHighQuality)
 {
     if (pSkCanvas == nullptr) {
         return;
@@ -55,11 +61,26 @@ static inline void DrawFunction(SkCanvas* pSkCanvas,
     SkIRect rcSkSrcI = { rcSrc.left, rcSrc.top, rcSrc.right, rcSrc.bottom };
     SkRect rcSkSrc = SkRect::Make(rcSkSrcI);
 
-    pSkCanvas->drawImageRect(skImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kStrict_SrcRectConstraint);
+    //高质量采样：缩放绘制时使用三次插值（Mitchell）
+    const bool bScaled = (rcSkSrc.width() != rcSkDest.width()) || (rcSkSrc.height() != rcSkDest.height());
+    const SkSamplingOptions skSampling = (bHighQuality && bScaled) ?
+                                         SkSamplingOptions(SkCubicResampler::Mitchell()) :
+                                         SkSamplingOptions();
+    pSkCanvas->drawImageRect(skImage, rcSkSrc, rcSkDest, skSampling, &skPaint, SkCanvas::kStrict_SrcRectConstraint);
+}
+
+/** 获取直线的绘制区域（包含线宽）
+*/
+static inline UiRect GetLineBounds(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t nWidth)
+{
+    return UiRect(std::min(x1, x2) - nWidth, std::min(y1, y2) - nWidth,
+                  std::max(x1, x2) + nWidth, std::max(y1, y2) + nWidth);
 }
 
 Render_Skia::Render_Skia():
-    m_saveCount(0)
+    m_saveCount(0),
+    m_nAtlasBatchDepth(0),
+    m_bImageHighQualitySampling(false)
 {
     m_pSkPointOrg = new SkPoint;
     m_pSkPointOrg->iset(0, 0);
@@ -110,6 +131,9 @@ void* Render_Skia::GetPixelBits() const
 
 void Render_Skia::Clear(const UiColor& uiColor)
 {
+    //清除全部数据，缓存的图集图片不再需要绘制
+    m_atlasSprites.clear();
+    m_rcAtlasBounds.Clear();
     void* pPixelBits = GetPixelBits();
     if (pPixelBits != nullptr) {
         uint32_t nARGB = uiColor.GetARGB();
@@ -134,6 +158,7 @@ void Render_Skia::Clear(const UiColor& uiColor)
 
 void Render_Skia::ClearRect(const UiRect& rcDirty, const UiColor& uiColor)
 {
+    FlushAtlasBatch();
     void* pPixelBits = GetPixelBits();
     if (pPixelBits != nullptr) {
         uint32_t nARGB = uiColor.GetARGB();
@@ -153,6 +178,7 @@ void Render_Skia::ClearRect(const UiRect& rcDirty, const UiColor& uiColor)
 
 IBitmap* Render_Skia::MakeImageSnapshot()
 {
+    FlushAtlasBatch();
     int32_t nWidth = GetWidth();
     int32_t nHeight = GetHeight();
     if ((nWidth <= 0) || (nHeight <= 0)) {
@@ -172,6 +198,7 @@ IBitmap* Render_Skia::MakeImageSnapshot()
 
 void Render_Skia::ClearAlpha(const UiRect& rcDirty, uint8_t alpha)
 {
+    FlushAtlasBatch();
     void* pPixelBits = GetPixelBits();
     if (pPixelBits != nullptr) {
         BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
@@ -181,6 +208,7 @@ void Render_Skia::ClearAlpha(const UiRect& rcDirty, uint8_t alpha)
 
 void Render_Skia::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding, uint8_t alpha)
 {
+    FlushAtlasBatch();
     void* pPixelBits = GetPixelBits();
     if (pPixelBits != nullptr) {
         BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
@@ -190,6 +218,7 @@ void Render_Skia::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowP
 
 void Render_Skia::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding)
 {
+    FlushAtlasBatch();
     void* pPixelBits = GetPixelBits();
     if (pPixelBits != nullptr) {
         BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
@@ -310,6 +339,7 @@ void Render_Skia::SetRopMode(SkPaint& skPaint, RopMode rop) const
 
 bool Render_Skia::BitBlt(int32_t x, int32_t y, int32_t cx, int32_t cy, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, RopMode rop)
 {
+    FlushAtlasBatch();
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     ASSERT(pSrcRender != nullptr);
     if (pSrcRender == nullptr) {
@@ -354,6 +384,7 @@ bool Render_Skia::BitBlt(int32_t x, int32_t y, int32_t cx, int32_t cy, IRender*
 
 bool Render_Skia::StretchBlt(int32_t xDest, int32_t yDest, int32_t widthDest, int32_t heightDest, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, int32_t widthSrc, int32_t heightSrc, RopMode rop)
 {
+    FlushAtlasBatch();
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     ASSERT(pSrcRender != nullptr);
     if (pSrcRender == nullptr) {
@@ -398,6 +429,7 @@ bool Render_Skia::StretchBlt(int32_t xDest, int32_t yDest, int32_t widthDest, in
 
 bool Render_Skia::AlphaBlend(int32_t xDest, int32_t yDest, int32_t widthDest, int32_t heightDest, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, int32_t widthSrc, int32_t heightSrc, uint8_t alpha)
 {
+    FlushAtlasBatch();
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     ASSERT(pSrcRender != nullptr);
     if (pSrcRender == nullptr) {
@@ -448,12 +480,14 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
                             uint8_t uFade, bool xtiled, bool ytiled,
                             bool fullxtiled, bool fullytiled, int32_t nTiledMargin)
 {
+    CheckAtlasBatch(rcDest);
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     UiRect rcTestTemp;
     if (!UiRect::Intersect(rcTestTemp, rcDest, rcPaint)) {
         return;
     }
-    PerformanceStat statPerformance(_T("Render_Skia::DrawImage"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::DrawImage"));
+    PerformanceStat statPerformance(s_statId);
 
     ASSERT(pBitmap != nullptr);
     if (pBitmap == nullptr) {
@@ -496,7 +530,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
     rcDrawSource.bottom = rcSource.bottom - rcSourceCorners.bottom;
     if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
         if (!xtiled && !ytiled) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
         else if (xtiled && ytiled) {
             const int32_t imageDrawWidth = rcSource.right - rcSource.left - rcSourceCorners.left - rcSourceCorners.right;
@@ -540,7 +574,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
                     rcDestTemp.right = lDestRight;
                     rcDestTemp.top = lDestTop;
                     rcDestTemp.bottom = lDestBottom;
-                    DrawFunction(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+                    DrawFunction(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
                 }
             }
         }
@@ -574,7 +608,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
                 rcDestTemp.left = lDestLeft;
                 rcDestTemp.right = lDestRight;
 
-                DrawFunction(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+                DrawFunction(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
             }
         }
         else { // ytiled
@@ -607,7 +641,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
                 rcDestTemp.top = lDestTop;
                 rcDestTemp.bottom = lDestBottom;
 
-                DrawFunction(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+                DrawFunction(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
             }
         }
     }
@@ -624,7 +658,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.left + rcSourceCorners.left;
         rcDrawSource.bottom = rcSource.top + rcSourceCorners.top;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
     // top
@@ -639,7 +673,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right - rcSourceCorners.right;
         rcDrawSource.bottom = rcSource.top + rcSourceCorners.top;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
     // right-top
@@ -654,7 +688,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right;
         rcDrawSource.bottom = rcSource.top + rcSourceCorners.top;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
     // left
@@ -669,7 +703,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.left + rcSourceCorners.left;
         rcDrawSource.bottom = rcSource.bottom - rcSourceCorners.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
     // right
@@ -684,7 +718,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right;
         rcDrawSource.bottom = rcSource.bottom - rcSourceCorners.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
     // left-bottom
@@ -699,7 +733,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.left + rcSourceCorners.left;
         rcDrawSource.bottom = rcSource.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
     // bottom
@@ -714,7 +748,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right - rcSourceCorners.right;
         rcDrawSource.bottom = rcSource.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
     // right-bottom
@@ -729,7 +763,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right;
         rcDrawSource.bottom = rcSource.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, m_bImageHighQualitySampling);
         }
     }
 }
@@ -752,6 +786,12 @@ void Render_Skia::DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
                                 const UiRect& rcDest, const UiRect& rcSource,
                                 uint8_t uFade, IMatrix* pMatrix)
 {
+    if (pMatrix == nullptr) {
+        CheckAtlasBatch(rcDest);
+    }
+    else {
+        FlushAtlasBatch();
+    }
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     if (pMatrix == nullptr) {
         //仅在没有Matrix的情况下判断裁剪区域，
@@ -798,14 +838,180 @@ void Render_Skia::DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
             isMatrixSet = true;
         }
     }
-    DrawFunction(skCanvas, rcDest, *m_pSkPointOrg, skImage, rcSource, skPaint);
+    DrawFunction(skCanvas, rcDest, *m_pSkPointOrg, skImage, rcSource, skPaint, m_bImageHighQualitySampling);
     if (isMatrixSet) {
         skCanvas->resetMatrix();
     }
 }
 
+void Render_Skia::BeginAtlasBatch()
+{
+    ++m_nAtlasBatchDepth;
+}
+
+void Render_Skia::EndAtlasBatch()
+{
+    ASSERT(m_nAtlasBatchDepth > 0);
+    if (m_nAtlasBatchDepth > 0) {
+        --m_nAtlasBatchDepth;
+    }
+    FlushAtlasBatch();
+}
+
+bool Render_Skia::IsAtlasBatchActive() const
+{
+    return m_nAtlasBatchDepth > 0;
+}
+
+void Render_Skia::SetImageHighQualitySampling(bool bHighQuality)
+{
+    m_bImageHighQualitySampling = bHighQuality;
+}
+
+bool Render_Skia::IsImageHighQualitySampling() const
+{
+    return m_bImageHighQualitySampling;
+}
+
+void Render_Skia::DrawAtlasImage(const UiRect& rcPaint, const std::shared_ptr<IBitmap>& spAtlasBitmap,
+                                 const UiRect& rcDest, const UiRect& rcSource, uint8_t uFade)
+{
+    ASSERT(spAtlasBitmap != nullptr);
+    if (spAtlasBitmap == nullptr) {
+        return;
+    }
+    UiRect rcTestTemp;
+    if (!UiRect::Intersect(rcTestTemp, rcDest, rcPaint)) {
+        return;
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return;
+    }
+
+    //只有位图画布、矩形裁剪区域、无变换矩阵、不缩放的情况下，才能缓存起来合并绘制
+    bool bBatch = (m_nAtlasBatchDepth > 0) &&
+                  (rcDest.Width() == rcSource.Width()) &&
+                  (rcDest.Height() == rcSource.Height()) &&
+                  skCanvas->isClipRect() &&
+                  skCanvas->getTotalMatrix().isIdentity();
+    if (bBatch) {
+        SkPixmap pixmap;
+        bBatch = skCanvas->peekPixels(&pixmap) && (pixmap.writable_addr() != nullptr);
+    }
+    if (!bBatch) {
+        DrawImage(rcPaint, spAtlasBitmap.get(), rcDest, rcSource, uFade);
+        return;
+    }
+
+    //转换为位图坐标，并按当前的裁剪区域裁剪（绘制缓存的图片时，裁剪区域可能已经变化）
+    UiRect rcDeviceDest = rcDest;
+    rcDeviceDest.Offset(SkScalarTruncToInt(m_pSkPointOrg->fX), SkScalarTruncToInt(m_pSkPointOrg->fY));
+    const SkIRect rcSkClip = skCanvas->getDeviceClipBounds();
+    const UiRect rcClip(rcSkClip.fLeft, rcSkClip.fTop, rcSkClip.fRight, rcSkClip.fBottom);
+    UiRect rcDrawDest;
+    if (!UiRect::Intersect(rcDrawDest, rcDeviceDest, rcClip)) {
+        return;
+    }
+    UiRect rcDrawSource = rcSource;
+    rcDrawSource.left += rcDrawDest.left - rcDeviceDest.left;
+    rcDrawSource.top += rcDrawDest.top - rcDeviceDest.top;
+    rcDrawSource.right -= rcDeviceDest.right - rcDrawDest.right;
+    rcDrawSource.bottom -= rcDeviceDest.bottom - rcDrawDest.bottom;
+
+    AtlasSprite sprite;
+    sprite.m_spAtlasBitmap = spAtlasBitmap;
+    sprite.m_rcDest = rcDrawDest;
+    sprite.m_rcSource = rcDrawSource;
+    sprite.m_uFade = uFade;
+    m_atlasSprites.push_back(sprite);
+    m_rcAtlasBounds.Union(rcDrawDest);
+}
+
+void Render_Skia::CheckAtlasBatch(const UiRect& rcDraw)
+{
+    if (m_atlasSprites.empty()) {
+        return;
+    }
+    //抗锯齿绘制时，可能会超出绘制区域一个像素
+    UiRect rcDeviceDraw = rcDraw;
+    rcDeviceDraw.Offset(SkScalarTruncToInt(m_pSkPointOrg->fX), SkScalarTruncToInt(m_pSkPointOrg->fY));
+    rcDeviceDraw.Inflate(1, 1);
+    UiRect rcTemp;
+    if (UiRect::Intersect(rcTemp, rcDeviceDraw, m_rcAtlasBounds)) {
+        FlushAtlasBatch();
+    }
+}
+
+void Render_Skia::FlushAtlasBatch()
+{
+    if (m_atlasSprites.empty()) {
+        return;
+    }
+    std::vector<AtlasSprite> atlasSprites;
+    atlasSprites.swap(m_atlasSprites);
+    m_rcAtlasBounds.Clear();
+
+    SkCanvas* skCanvas = GetSkCanvas();
+    SkPixmap pixmap;
+    if ((skCanvas == nullptr) || !skCanvas->peekPixels(&pixmap) || (pixmap.writable_addr() == nullptr)) {
+        return;
+    }
+    static const PerformanceStatId s_statId(_T("Render_Skia::FlushAtlasBatch"));
+    PerformanceStat statPerformance(s_statId);
+
+    //缓存时已经按裁剪区域裁剪过，这里使用不带裁剪区域的画布绘制
+    std::unique_ptr<SkCanvas> spAtlasCanvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+    if (spAtlasCanvas == nullptr) {
+        return;
+    }
+    SkPaint skPaint = *m_pSkPaint;
+    skPaint.setBlendMode(SkBlendMode::kSrcOver);
+
+    std::vector<SkRSXform> xforms;
+    std::vector<SkRect> texRects;
+    std::vector<SkColor> colors;
+    xforms.reserve(atlasSprites.size());
+    texRects.reserve(atlasSprites.size());
+    colors.reserve(atlasSprites.size());
+
+    //相同图集位图的连续图片，合并为一次绘制
+    size_t nStart = 0;
+    while (nStart < atlasSprites.size()) {
+        IBitmap* pAtlasBitmap = atlasSprites[nStart].m_spAtlasBitmap.get();
+        size_t nEnd = nStart;
+        bool bHasFade = false;
+        xforms.clear();
+        texRects.clear();
+        colors.clear();
+        while ((nEnd < atlasSprites.size()) && (atlasSprites[nEnd].m_spAtlasBitmap.get() == pAtlasBitmap)) {
+            const AtlasSprite& sprite = atlasSprites[nEnd];
+            xforms.push_back(SkRSXform::Make(1, 0, SkIntToScalar(sprite.m_rcDest.left), SkIntToScalar(sprite.m_rcDest.top)));
+            texRects.push_back(SkRect::MakeLTRB(SkIntToScalar(sprite.m_rcSource.left), SkIntToScalar(sprite.m_rcSource.top),
+                                                SkIntToScalar(sprite.m_rcSource.right), SkIntToScalar(sprite.m_rcSource.bottom)));
+            colors.push_back(SkColorSetARGB(sprite.m_uFade, 0xFF, 0xFF, 0xFF));
+            if (sprite.m_uFade != 0xFF) {
+                bHasFade = true;
+            }
+            ++nEnd;
+        }
+        Bitmap_Skia* skiaBitmap = dynamic_cast<Bitmap_Skia*>(pAtlasBitmap);
+        ASSERT(skiaBitmap != nullptr);
+        SkImage* pSkImage = (skiaBitmap != nullptr) ? skiaBitmap->GetSkImage() : nullptr;
+        if (pSkImage != nullptr) {
+            //有透明度时，通过颜色与图片相乘（kModulate）实现
+            spAtlasCanvas->drawAtlas(pSkImage, xforms.data(), texRects.data(),
+                                     bHasFade ? colors.data() : nullptr, (int)xforms.size(),
+                                     SkBlendMode::kModulate, SkSamplingOptions(), nullptr, &skPaint);
+        }
+        nStart = nEnd;
+    }
+}
+
 void Render_Skia::FillRect(const UiRect& rc, UiColor dwColor, uint8_t uFade)
 {
+    CheckAtlasBatch(rc);
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(dwColor.GetA(), dwColor.GetR(), dwColor.GetG(), dwColor.GetB());
@@ -863,6 +1069,7 @@ void Render_Skia::InitGradientColor(SkPaint& skPaint, const UiRect& rc, UiColor
 
 void Render_Skia::FillRect(const UiRect& rc, UiColor dwColor, UiColor dwColor2, int8_t nColor2Direction, uint8_t uFade)
 {
+    CheckAtlasBatch(rc);
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     if (dwColor2.IsEmpty()) {
         return FillRect(rc, dwColor, uFade);
@@ -886,8 +1093,108 @@ void Render_Skia::FillRect(const UiRect& rc, UiColor dwColor, UiColor dwColor2,
     }
 }
 
+void Render_Skia::DrawVectorShapes(const UiRect& rcPaint, const std::vector<VectorShape>& shapes,
+                                   const UiRect& rcDest, float fScaleX, float fScaleY,
+                                   uint8_t uFade)
+{
+    CheckAtlasBatch(rcDest);
+    UiRect rcTestTemp;
+    if (!UiRect::Intersect(rcTestTemp, rcDest, rcPaint)) {
+        return;
+    }
+    if (shapes.empty() || (fScaleX <= 0) || (fScaleY <= 0)) {
+        return;
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return;
+    }
+
+    //图形坐标变换到目标区域，超出目标区域的部分不绘制（与光栅化为位图后的绘制效果一致）
+    SkIRect rcSkDestI = { rcDest.left, rcDest.top, rcDest.right, rcDest.bottom };
+    SkRect rcSkDest = SkRect::Make(rcSkDestI);
+    rcSkDest.offset(*m_pSkPointOrg);
+    SkAutoCanvasRestore autoRestore(skCanvas, true);
+    skCanvas->clipRect(rcSkDest, true);
+    skCanvas->translate(rcSkDest.fLeft, rcSkDest.fTop);
+    skCanvas->scale(fScaleX, fScaleY);
+
+    SkPaint skPaint = *m_pSkPaint;
+    skPaint.setAntiAlias(true);
+    for (const VectorShape& shape : shapes) {
+        SkPath skPath;
+        size_t nPointIndex = 0;
+        for (size_t nPath = 0; nPath < shape.m_pathPoints.size(); ++nPath) {
+            const size_t nPointCount = shape.m_pathPoints[nPath];
+            if ((nPointCount == 0) || ((nPointIndex + nPointCount) > shape.m_points.size())) {
+                break;
+            }
+            const UiPointF* pts = shape.m_points.data() + nPointIndex;
+            skPath.moveTo(pts[0].x, pts[0].y);
+            for (size_t i = 1; (i + 2) < nPointCount; i += 3) {
+                skPath.cubicTo(pts[i].x, pts[i].y, pts[i + 1].x, pts[i + 1].y, pts[i + 2].x, pts[i + 2].y);
+            }
+            if ((nPath < shape.m_pathClosed.size()) && shape.m_pathClosed[nPath]) {
+                skPath.close();
+            }
+            nPointIndex += nPointCount;
+        }
+        if (skPath.isEmpty()) {
+            continue;
+        }
+        if (shape.m_bFill) {
+            skPath.setFillType(shape.m_bEvenOddFill ? SkPathFillType::kEvenOdd : SkPathFillType::kWinding);
+            skPaint.setStyle(SkPaint::kFill_Style);
+            skPaint.setPathEffect(nullptr);
+            skPaint.setColor(shape.m_fillColor.GetARGB());
+            skPaint.setAlpha(static_cast<U8CPU>(shape.m_fillColor.GetA() * uFade / 255));
+            skCanvas->drawPath(skPath, skPaint);
+        }
+        if (shape.m_bStroke && (shape.m_fStrokeWidth > 0)) {
+            skPaint.setStyle(SkPaint::kStroke_Style);
+            skPaint.setColor(shape.m_strokeColor.GetARGB());
+            skPaint.setAlpha(static_cast<U8CPU>(shape.m_strokeColor.GetA() * uFade / 255));
+            skPaint.setStrokeWidth(shape.m_fStrokeWidth);
+            skPaint.setStrokeMiter(shape.m_fMiterLimit);
+            switch (shape.m_strokeCap) {
+            case IPen::kRound_Cap:
+                skPaint.setStrokeCap(SkPaint::kRound_Cap);
+                break;
+            case IPen::kSquare_Cap:
+                skPaint.setStrokeCap(SkPaint::kSquare_Cap);
+                break;
+            default:
+                skPaint.setStrokeCap(SkPaint::kButt_Cap);
+                break;
+            }
+            switch (shape.m_strokeJoin) {
+            case IPen::kRound_Join:
+                skPaint.setStrokeJoin(SkPaint::kRound_Join);
+                break;
+            case IPen::kBevel_Join:
+                skPaint.setStrokeJoin(SkPaint::kBevel_Join);
+                break;
+            default:
+                skPaint.setStrokeJoin(SkPaint::kMiter_Join);
+                break;
+            }
+            if (shape.m_dashIntervals.size() >= 2) {
+                skPaint.setPathEffect(SkDashPathEffect::Make(shape.m_dashIntervals.data(),
+                                                             (int)shape.m_dashIntervals.size(),
+                                                             shape.m_fDashOffset));
+            }
+            else {
+                skPaint.setPathEffect(nullptr);
+            }
+            skCanvas->drawPath(skPath, skPaint);
+        }
+    }
+}
+
 void Render_Skia::DrawLine(const UiPoint& pt1, const UiPoint& pt2, UiColor penColor, int32_t nWidth)
 {
+    CheckAtlasBatch(GetLineBounds(pt1.x, pt1.y, pt2.x, pt2.y, nWidth));
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(penColor.GetA(), penColor.GetR(), penColor.GetG(), penColor.GetB());
@@ -911,6 +1218,7 @@ void Render_Skia::DrawLine(const UiPoint& pt1, const UiPoint& pt2, UiColor penCo
 
 void Render_Skia::DrawLine(const UiPointF& pt1, const UiPointF& pt2, UiColor penColor, float fWidth)
 {
+    CheckAtlasBatch(GetLineBounds((int32_t)pt1.x, (int32_t)pt1.y, (int32_t)pt2.x, (int32_t)pt2.y, (int32_t)fWidth + 1));
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(penColor.GetA(), penColor.GetR(), penColor.GetG(), penColor.GetB());
@@ -932,6 +1240,9 @@ void Render_Skia::DrawLine(const UiPointF& pt1, const UiPointF& pt2, UiColor pen
 
 void Render_Skia::DrawLine(const UiPoint& pt1, const UiPoint& pt2, IPen* pen)
 {
+    if (pen != nullptr) {
+        CheckAtlasBatch(GetLineBounds(pt1.x, pt1.y, pt2.x, pt2.y, pen->GetWidth()));
+    }
     ASSERT(pen != nullptr);
     if (pen == nullptr) {
         return;
@@ -957,6 +1268,7 @@ void Render_Skia::DrawLine(const UiPoint& pt1, const UiPoint& pt2, IPen* pen)
 
 void Render_Skia::DrawRect(const UiRect& rc, UiColor penColor, int32_t nWidth, bool bLineInRect)
 {
+    CheckAtlasBatch(UiRect(rc.left - nWidth, rc.top - nWidth, rc.right + nWidth, rc.bottom + nWidth));
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(penColor.GetA(), penColor.GetR(), penColor.GetG(), penColor.GetB());
@@ -984,6 +1296,7 @@ void Render_Skia::DrawRect(const UiRect& rc, UiColor penColor, int32_t nWidth, b
 
 void Render_Skia::DrawRoundRect(const UiRect& rc, const UiSize& roundSize, UiColor penColor, int32_t nWidth)
 {
+    CheckAtlasBatch(UiRect(rc.left - nWidth, rc.top - nWidth, rc.right + nWidth, rc.bottom + nWidth));
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(penColor.GetA(), penColor.GetR(), penColor.GetG(), penColor.GetB());
@@ -1003,6 +1316,7 @@ void Render_Skia::DrawRoundRect(const UiRect& rc, const UiSize& roundSize, UiCol
 
 void Render_Skia::FillRoundRect(const UiRect& rc, const UiSize& roundSize, UiColor dwColor, uint8_t uFade)
 {
+    CheckAtlasBatch(rc);
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(dwColor.GetA(), dwColor.GetR(), dwColor.GetG(), dwColor.GetB());
@@ -1024,6 +1338,7 @@ void Render_Skia::FillRoundRect(const UiRect& rc, const UiSize& roundSize, UiCol
 
 void Render_Skia::FillRoundRect(const UiRect& rc, const UiSize& roundSize, UiColor dwColor, UiColor dwColor2, int8_t nColor2Direction, uint8_t uFade)
 {
+    CheckAtlasBatch(rc);
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     if (dwColor2.IsEmpty()) {
         return FillRoundRect(rc, roundSize, dwColor, uFade);
@@ -1050,6 +1365,7 @@ void Render_Skia::FillRoundRect(const UiRect& rc, const UiSize& roundSize, UiCol
 
 void Render_Skia::DrawCircle(const UiPoint& centerPt, int32_t radius, UiColor penColor, int nWidth)
 {
+    CheckAtlasBatch(UiRect(centerPt.x - radius - nWidth, centerPt.y - radius - nWidth, centerPt.x + radius + nWidth, centerPt.y + radius + nWidth));
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(penColor.GetA(), penColor.GetR(), penColor.GetG(), penColor.GetB());
@@ -1068,6 +1384,7 @@ void Render_Skia::DrawCircle(const UiPoint& centerPt, int32_t radius, UiColor pe
 
 void Render_Skia::FillCircle(const UiPoint& centerPt, int32_t radius, UiColor dwColor, uint8_t uFade)
 {
+    CheckAtlasBatch(UiRect(centerPt.x - radius, centerPt.y - radius, centerPt.x + radius, centerPt.y + radius));
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     SkPaint skPaint = *m_pSkPaint;
     skPaint.setARGB(dwColor.GetA(), dwColor.GetR(), dwColor.GetG(), dwColor.GetB());
@@ -1091,6 +1408,7 @@ void Render_Skia::DrawArc(const UiRect& rc, float startAngle, float sweepAngle,
                           UiColor* gradientColor,
                           const UiRect* gradientRect)
 {
+    FlushAtlasBatch();
     ASSERT(pen != nullptr);
     if (pen == nullptr) {
         return;
@@ -1128,6 +1446,7 @@ void Render_Skia::DrawArc(const UiRect& rc, float startAngle, float sweepAngle,
 
 void Render_Skia::DrawPath(const IPath* path, const IPen* pen)
 {
+    FlushAtlasBatch();
     ASSERT(path != nullptr);
     ASSERT(pen != nullptr);
     if ((path == nullptr) || (pen == nullptr)) {
@@ -1262,6 +1581,7 @@ void Render_Skia::SetPaintByPen(SkPaint& skPaint, const IPen* pen)
 
 void Render_Skia::FillPath(const IPath* path, const IBrush* brush)
 {
+    FlushAtlasBatch();
     ASSERT(path != nullptr);
     ASSERT(brush != nullptr);
     if ((path == nullptr) || (brush == nullptr)) {
@@ -1289,6 +1609,7 @@ void Render_Skia::FillPath(const IPath* path, const IBrush* brush)
 
 void Render_Skia::FillPath(const IPath* path, const UiRect& rc, UiColor dwColor, UiColor dwColor2, int8_t nColor2Direction)
 {
+    FlushAtlasBatch();
     ASSERT(path != nullptr);
     if (path == nullptr){
         return;
@@ -1321,7 +1642,14 @@ void Render_Skia::DrawString(const UiRect& textRect,
                              uint32_t uFormat, 
                              uint8_t uFade /*= 255*/)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::DrawString"));
+    if (uFormat & DrawStringFormat::TEXT_NOCLIP) {
+        FlushAtlasBatch();
+    }
+    else {
+        CheckAtlasBatch(textRect);
+    }
+    static const PerformanceStatId s_statId(_T("Render_Skia::DrawString"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     ASSERT(!strText.empty());
     if (strText.empty()) {
@@ -1432,7 +1760,8 @@ UiRect Render_Skia::MeasureString(const DString& strText,
                                   uint32_t uFormat, 
                                   int width /*= DUI_NOSET_VALUE*/)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::MeasureString"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::MeasureString"));
+    PerformanceStat statPerformance(s_statId);
     if ((GetWidth() <= 0) || (GetHeight() <= 0)) {
         //这种情况是窗口大小为0的情况，返回空，不加断言
         return UiRect();
@@ -1544,7 +1873,8 @@ void Render_Skia::MeasureRichText(const UiRect& textRect,
                                   const std::vector<RichTextData>& richTextData,
                                   std::vector<std::vector<UiRect>>* pRichTextRects)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::MeasureRichText"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::MeasureRichText"));
+    PerformanceStat statPerformance(s_statId);
     InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, nullptr, nullptr, pRichTextRects);
 }
 
@@ -1555,7 +1885,8 @@ void Render_Skia::MeasureRichText2(const UiRect& textRect,
                                    RichTextLineInfoParam* pLineInfoParam,
                                    std::vector<std::vector<UiRect>>* pRichTextRects)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::MeasureRichText2"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::MeasureRichText2"));
+    PerformanceStat statPerformance(s_statId);
     InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, pLineInfoParam, nullptr, pRichTextRects);
 }
 
@@ -1567,7 +1898,8 @@ void Render_Skia::MeasureRichText3(const UiRect& textRect,
                                    std::shared_ptr<DrawRichTextCache>& spDrawRichTextCache,
                                    std::vector<std::vector<UiRect>>* pRichTextRects)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::MeasureRichText3"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::MeasureRichText3"));
+    PerformanceStat statPerformance(s_statId);
     InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, pLineInfoParam, &spDrawRichTextCache, pRichTextRects);
 }
 
@@ -1578,7 +1910,9 @@ void Render_Skia::DrawRichText(const UiRect& textRect,
                                uint8_t uFade,
                                std::vector<std::vector<UiRect>>* pRichTextRects)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::DrawRichText"));
+    FlushAtlasBatch();
+    static const PerformanceStatId s_statId(_T("Render_Skia::DrawRichText"));
+    PerformanceStat statPerformance(s_statId);
     InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, uFade, false, nullptr, nullptr, pRichTextRects);
 }
 
@@ -1640,7 +1974,8 @@ bool Render_Skia::CreateDrawRichTextCache(const UiRect& textRect,
                                           const std::vector<RichTextData>& richTextData,
                                           std::shared_ptr<DrawRichTextCache>& spDrawRichTextCache)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::CreateDrawRichTextCache"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::CreateDrawRichTextCache"));
+    PerformanceStat statPerformance(s_statId);
     spDrawRichTextCache.reset();
     InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, nullptr, &spDrawRichTextCache, nullptr);
     return spDrawRichTextCache != nullptr;
@@ -1710,7 +2045,8 @@ bool Render_Skia::UpdateDrawRichTextCache(std::shared_ptr<DrawRichTextCache>& sp
                                           size_t nDeletedRows,
                                           const std::vector<int32_t>& rowRectTopList)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::UpdateDrawRichTextCache"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::UpdateDrawRichTextCache"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT(spOldDrawRichTextCache != nullptr);
     if (spOldDrawRichTextCache == nullptr) {
         return false;
@@ -1975,7 +2311,9 @@ void Render_Skia::DrawRichTextCacheData(const std::shared_ptr<DrawRichTextCache>
                                         uint8_t uFade,
                                         std::vector<std::vector<UiRect>>* pRichTextRects)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::DrawRichTextCacheData"));
+    FlushAtlasBatch();
+    static const PerformanceStatId s_statId(_T("Render_Skia::DrawRichTextCacheData"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT(spDrawRichTextCache != nullptr);
     if (spDrawRichTextCache == nullptr) {
         return;
@@ -2071,7 +2409,8 @@ void Render_Skia::InternalDrawRichText(const UiRect& rcTextRect,
                                        std::shared_ptr<DrawRichTextCache>* pDrawRichTextCache,
                                        std::vector<std::vector<UiRect>>* pRichTextRects)
 {
-    PerformanceStat statPerformance(_T("Render_Skia::InternalDrawRichText"));
+    static const PerformanceStatId s_statId(_T("Render_Skia::InternalDrawRichText"));
+    PerformanceStat statPerformance(s_statId);
     //内部使用string_view实现，避免字符串复制影响性能
     if (rcTextRect.IsEmpty()) {
         return;
@@ -2775,6 +3114,7 @@ void Render_Skia::DrawBoxShadow(const UiRect& rc,
                                 int32_t nSpreadRadius,
                                 UiColor dwColor)
 {
+    FlushAtlasBatch();
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
     ASSERT(dwColor.GetARGB() != 0);
     if (nBlurRadius < 0) {
@@ -2842,6 +3182,7 @@ void Render_Skia::DrawBoxShadow(const UiRect& rc,
 
 bool Render_Skia::ReadPixels(const UiRect& rc, void* dstPixels, size_t dstPixelsLen)
 {
+    FlushAtlasBatch();
     ASSERT(dstPixels != nullptr);
     if (dstPixels == nullptr) {
         return false;
@@ -2871,6 +3212,7 @@ bool Render_Skia::ReadPixels(const UiRect& rc, void* dstPixels, size_t dstPixels
 
 bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc)
 {
+    FlushAtlasBatch();
     ASSERT(srcPixels != nullptr);
     if (srcPixels == nullptr) {
         return false;
@@ -2901,6 +3243,7 @@ bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect
 
 bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc, const UiRect& rcPaint)
 {
+    FlushAtlasBatch();
     if (rc == rcPaint) {
         return WritePixels(srcPixels, srcPixelsLen, rc);
     }
@@ -2951,6 +3294,51 @@ bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect
     return bRet;    
 }
 
+bool Render_Skia::ScrollPixels(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    FlushAtlasBatch();
+    SkSurface* skSurface = GetSkSurface();
+    if (skSurface != nullptr) {
+        //如果存在该Surface的快照，需要先复制一份数据，避免修改快照的内容
+        skSurface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    SkPixmap pixmap;
+    if ((skCanvas == nullptr) || !skCanvas->peekPixels(&pixmap) || (pixmap.writable_addr() == nullptr)) {
+        return false;
+    }
+    UiRect rcBounds = rcScroll;
+    if (!rcBounds.Intersect(UiRect(0, 0, pixmap.width(), pixmap.height()))) {
+        return true;
+    }
+    //目标区域：移动后仍在矩形范围内的部分
+    UiRect rcDest = rcBounds;
+    rcDest.Offset(dx, dy);
+    if (!rcDest.Intersect(rcBounds)) {
+        return true;
+    }
+    const size_t nRowBytes = pixmap.rowBytes();
+    const size_t nCopyBytes = (size_t)rcDest.Width() * sizeof(uint32_t);
+    uint8_t* pPixelBits = (uint8_t*)pixmap.writable_addr();
+    auto CopyRow = [&](int32_t nDestRow) {
+            uint8_t* pDest = pPixelBits + nDestRow * nRowBytes + rcDest.left * sizeof(uint32_t);
+            const uint8_t* pSrc = pPixelBits + (nDestRow - dy) * nRowBytes + (rcDest.left - dx) * sizeof(uint32_t);
+            ::memmove(pDest, pSrc, nCopyBytes);
+        };
+    //源区域与目标区域重叠，向下移动时从下往上复制，避免覆盖尚未复制的数据
+    if (dy > 0) {
+        for (int32_t nRow = rcDest.bottom - 1; nRow >= rcDest.top; --nRow) {
+            CopyRow(nRow);
+        }
+    }
+    else {
+        for (int32_t nRow = rcDest.top; nRow < rcDest.bottom; ++nRow) {
+            CopyRow(nRow);
+        }
+    }
+    return true;
+}
+
 RenderClipType Render_Skia::GetClipInfo(std::vector<UiRect>& clipRects)
 {
     RenderClipType clipType = RenderClipType::kEmpty;
@@ -3015,6 +3403,111 @@ void Render_Skia::SetRenderDpi(const IRenderDpiPtr& spRenderDpi)
     m_spRenderDpi = spRenderDpi;
 }
 
+bool Render_Skia::PaintRecorded(const UiRect& rcPaint, const RenderRecordCallback& recordCallback)
+{
+    FlushAtlasBatch();
+    if (recordCallback == nullptr) {
+        return false;
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    SkPixmap pixmap;
+    if ((skCanvas == nullptr) || !skCanvas->peekPixels(&pixmap) || (pixmap.writable_addr() == nullptr)) {
+        //只支持CPU绘制的位图画布
+        return false;
+    }
+    SkIRect rcSkPaint = SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom);
+    if (!rcSkPaint.intersect(SkIRect::MakeWH(pixmap.width(), pixmap.height()))) {
+        return true;
+    }
+
+    static const PerformanceStatId s_statId(_T("PaintWindow, Render_Skia::PaintRecorded"));
+    PerformanceStat statPerformance(s_statId);
+
+    //第一步：录制绘制操作，坐标系与本Render一致
+    Render_Skia_Picture pictureRender(pixmap.width(), pixmap.height());
+    pictureRender.SetRenderDpi(GetRenderDpi());
+    pictureRender.SetWindowOrg(GetWindowOrg());
+    recordCallback(&pictureRender);
+    if (pictureRender.IsRecordFailed()) {
+        return false;
+    }
+    sk_sp<SkPicture> spPicture = pictureRender.FinishRecording();
+    if (spPicture == nullptr) {
+        return false;
+    }
+
+    //第二步：将绘制区域切分为水平条带，每个条带使用独立的画布（共享同一块像素数据）并行回放
+    ParallelTaskRunner& taskRunner = ParallelTaskRunner::Instance();
+    constexpr const int32_t nMinBandHeight = 64;
+    const int32_t nMaxBandCount = (int32_t)taskRunner.GetConcurrency() * 2;
+    int32_t nBandCount = std::min(nMaxBandCount, rcSkPaint.height() / nMinBandHeight);
+    nBandCount = std::max(nBandCount, 1);
+    const int32_t nBandHeight = (rcSkPaint.height() + nBandCount - 1) / nBandCount;
+    taskRunner.ParallelFor((size_t)nBandCount, [&](size_t nIndex) {
+            SkIRect rcBand = rcSkPaint;
+            rcBand.fTop = rcSkPaint.fTop + (int32_t)nIndex * nBandHeight;
+            rcBand.fBottom = std::min(rcBand.fTop + nBandHeight, rcSkPaint.fBottom);
+            if (rcBand.isEmpty()) {
+                return;
+            }
+            std::unique_ptr<SkCanvas> spBandCanvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+            if (spBandCanvas != nullptr) {
+                spBandCanvas->clipIRect(rcBand);
+                spBandCanvas->drawPicture(spPicture);
+            }
+        });
+    return true;
+}
+
+IPicture* Render_Skia::RecordPicture(int32_t nWidth, int32_t nHeight, const RenderRecordCallback& recordCallback)
+{
+    ASSERT((nWidth > 0) && (nHeight > 0));
+    if ((nWidth <= 0) || (nHeight <= 0) || (recordCallback == nullptr)) {
+        return nullptr;
+    }
+    Render_Skia_Picture pictureRender(nWidth, nHeight);
+    pictureRender.SetRenderDpi(GetRenderDpi());
+    recordCallback(&pictureRender);
+    if (pictureRender.IsRecordFailed()) {
+        return nullptr;
+    }
+    sk_sp<SkPicture> spPicture = pictureRender.FinishRecording();
+    if (spPicture == nullptr) {
+        return nullptr;
+    }
+    return new Picture_Skia(spPicture, nWidth, nHeight);
+}
+
+void Render_Skia::DrawPicture(const UiRect& rcDest, const IPicture* pPicture, uint8_t uFade)
+{
+    CheckAtlasBatch(rcDest);
+    const Picture_Skia* pSkiaPicture = dynamic_cast<const Picture_Skia*>(pPicture);
+    ASSERT(pSkiaPicture != nullptr);
+    if ((pSkiaPicture == nullptr) || (pSkiaPicture->GetSkPicture() == nullptr) || (uFade == 0)) {
+        return;
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return;
+    }
+    SkIRect rcSkDestI = { rcDest.left, rcDest.top, rcDest.right, rcDest.bottom };
+    SkRect rcSkDest = SkRect::Make(rcSkDestI);
+    rcSkDest.offset(*m_pSkPointOrg);
+
+    SkAutoCanvasRestore autoRestore(skCanvas, true);
+    skCanvas->clipRect(rcSkDest);
+    SkMatrix skMatrix = SkMatrix::Translate(rcSkDest.fLeft, rcSkDest.fTop);
+    if (uFade == 255) {
+        skCanvas->drawPicture(pSkiaPicture->GetSkPicture(), &skMatrix, nullptr);
+    }
+    else {
+        SkPaint skPaint;
+        skPaint.setAlpha(uFade);
+        skCanvas->drawPicture(pSkiaPicture->GetSkPicture(), &skMatrix, &skPaint);
+    }
+}
+
 SkTextEncoding Render_Skia::GetTextEncoding() const
 {
     constexpr const size_t nValueLen = sizeof(DString::value_type);
@@ -65,6 +65,20 @@ public:
                                const UiRect& rcDest, const UiRect& rcSource,
                                uint8_t uFade = 255, IMatrix* pMatrix = nullptr) override;
 
+    /** 批量绘制图集中的图片（仅支持可直接访问像素数据的位图画布，其他画布逐个绘制）
+    */
+    virtual void BeginAtlasBatch() override;
+    virtual void EndAtlasBatch() override;
+    virtual bool IsAtlasBatchActive() const override;
+    virtual void SetImageHighQualitySampling(bool bHighQuality) override;
+    virtual bool IsImageHighQualitySampling() const override;
+    virtual void DrawAtlasImage(const UiRect& rcPaint, const std::shared_ptr<IBitmap>& spAtlasBitmap,
+                                const UiRect& rcDest, const UiRect& rcSource, uint8_t uFade = 255) override;
+
+    virtual void DrawVectorShapes(const UiRect& rcPaint, const std::vector<VectorShape>& shapes,
+                                  const UiRect& rcDest, float fScaleX, float fScaleY,
+                                  uint8_t uFade = 255) override;
+
     virtual void DrawLine(const UiPoint& pt1, const UiPoint& pt2, UiColor penColor, int32_t nWidth) override;
     virtual void DrawLine(const UiPointF& pt1, const UiPointF& pt2, UiColor penColor, float fWidth) override;
     virtual void DrawLine(const UiPoint& pt1, const UiPoint& pt2, IPen* pen) override;
@@ -158,11 +172,18 @@ public:
     virtual bool ReadPixels(const UiRect& rc, void* dstPixels, size_t dstPixelsLen) override;
     virtual bool WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc) override;
     virtual bool WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc, const UiRect& rcPaint) override;
+    virtual bool ScrollPixels(const UiRect& rcScroll, int32_t dx, int32_t dy) override;
     virtual RenderClipType GetClipInfo(std::vector<UiRect>& clipRects) override;
     virtual bool IsClipEmpty() const override;
     virtual bool IsEmpty() const override;
     virtual void SetRenderDpi(const IRenderDpiPtr& spRenderDpi) override;
 
+    /** 录制绘制操作，然后按水平条带并行回放到画布（仅支持可直接访问像素数据的位图画布）
+    */
+    virtual bool PaintRecorded(const UiRect& rcPaint, const RenderRecordCallback& recordCallback) override;
+    virtual IPicture* RecordPicture(int32_t nWidth, int32_t nHeight, const RenderRecordCallback& recordCallback) override;
+    virtual void DrawPicture(const UiRect& rcDest, const IPicture* pPicture, uint8_t uFade = 255) override;
+
 public:
     /** 获取SkSurface接口
     */
@@ -238,6 +259,15 @@ private:
     */
     int32_t GetScaleInt(int32_t iValue) const;
 
+    /** 绘制缓存的图集图片（批量绘制）
+    */
+    void FlushAtlasBatch();
+
+    /** 如果绘制区域与缓存的图集图片区域有重叠，先绘制缓存的图集图片，以保证绘制顺序
+    * @param [in] rcDraw 即将绘制的区域（受SetWindowOrg影响的坐标）
+    */
+    void CheckAtlasBatch(const UiRect& rcDraw);
+
     /** 绘制一个字符，记录字符属性
     * @param [in] pLineInfoParam 字符属性记录表
     * @param [in] ch 当前绘制的字符, 仅当回车和换行符等特殊字符时有效
@@ -269,6 +299,32 @@ private:
     /** DPI转换辅助接口
     */
     IRenderDpiPtr m_spRenderDpi;
+
+    /** 缓存的一个图集图片（位图坐标，已按裁剪区域裁剪）
+    */
+    struct AtlasSprite
+    {
+        std::shared_ptr<IBitmap> m_spAtlasBitmap;
+        UiRect m_rcDest;
+        UiRect m_rcSource;
+        uint8_t m_uFade = 255;
+    };
+
+    /** 缓存的图集图片（按绘制顺序）
+    */
+    std::vector<AtlasSprite> m_atlasSprites;
+
+    /** 缓存的图集图片的总区域（位图坐标）
+    */
+    UiRect m_rcAtlasBounds;
+
+    /** 批量绘制图集图片的嵌套层数
+    */
+    int32_t m_nAtlasBatchDepth;
+
+    /** 缩放绘制位图时，是否使用高质量的采样方式
+    */
+    bool m_bImageHighQualitySampling;
 };
 
 } // namespace ui
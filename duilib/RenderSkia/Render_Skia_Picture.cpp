@@ -0,0 +1,166 @@
+#include "Render_Skia_Picture.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100)
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+
+#pragma warning (pop)
+
+namespace ui {
+
+Render_Skia_Picture::Render_Skia_Picture(int32_t nWidth, int32_t nHeight):
+    m_pRecordCanvas(nullptr),
+    m_nWidth(nWidth),
+    m_nHeight(nHeight),
+    m_bRecordFailed(false)
+{
+    m_pRecorder = std::make_unique<SkPictureRecorder>();
+    m_pRecordCanvas = m_pRecorder->beginRecording(SkRect::MakeIWH(nWidth, nHeight));
+    ASSERT(m_pRecordCanvas != nullptr);
+    if (m_pRecordCanvas == nullptr) {
+        m_bRecordFailed = true;
+    }
+}
+
+Render_Skia_Picture::~Render_Skia_Picture()
+{
+}
+
+sk_sp<SkPicture> Render_Skia_Picture::FinishRecording()
+{
+    if (m_pRecordCanvas == nullptr) {
+        return nullptr;
+    }
+    m_pRecordCanvas = nullptr;
+    sk_sp<SkPicture> spPicture = m_pRecorder->finishRecordingAsPicture();
+    if (m_bRecordFailed) {
+        spPicture.reset();
+    }
+    return spPicture;
+}
+
+bool Render_Skia_Picture::IsRecordFailed() const
+{
+    return m_bRecordFailed;
+}
+
+RenderBackendType Render_Skia_Picture::GetRenderBackendType() const
+{
+    return RenderBackendType::kRaster_BackendType;
+}
+
+bool Render_Skia_Picture::Resize(int32_t width, int32_t height)
+{
+    //画布大小在录制开始时确定，不支持修改
+    return (width == m_nWidth) && (height == m_nHeight);
+}
+
+int32_t Render_Skia_Picture::GetWidth() const
+{
+    return m_nWidth;
+}
+
+int32_t Render_Skia_Picture::GetHeight() const
+{
+    return m_nHeight;
+}
+
+std::unique_ptr<IRender> Render_Skia_Picture::Clone()
+{
+    m_bRecordFailed = true;
+    return nullptr;
+}
+
+bool Render_Skia_Picture::PaintAndSwapBuffers(IRenderPaint* /*pRenderPaint*/)
+{
+    m_bRecordFailed = true;
+    return false;
+}
+
+bool Render_Skia_Picture::PaintRecorded(const UiRect& /*rcPaint*/, const RenderRecordCallback& /*recordCallback*/)
+{
+    //不支持嵌套
+    return false;
+}
+
+SkSurface* Render_Skia_Picture::GetSkSurface() const
+{
+    return nullptr;
+}
+
+SkCanvas* Render_Skia_Picture::GetSkCanvas() const
+{
+    return m_pRecordCanvas;
+}
+
+void Render_Skia_Picture::Clear(const UiColor& /*uiColor*/)
+{
+    m_bRecordFailed = true;
+}
+
+void Render_Skia_Picture::ClearRect(const UiRect& /*rcDirty*/, const UiColor& /*uiColor*/)
+{
+    m_bRecordFailed = true;
+}
+
+IBitmap* Render_Skia_Picture::MakeImageSnapshot()
+{
+    m_bRecordFailed = true;
+    return nullptr;
+}
+
+void Render_Skia_Picture::ClearAlpha(const UiRect& /*rcDirty*/, uint8_t /*alpha*/)
+{
+    m_bRecordFailed = true;
+}
+
+void Render_Skia_Picture::RestoreAlpha(const UiRect& /*rcDirty*/, const UiPadding& /*rcShadowPadding*/, uint8_t /*alpha*/)
+{
+    m_bRecordFailed = true;
+}
+
+void Render_Skia_Picture::RestoreAlpha(const UiRect& /*rcDirty*/, const UiPadding& /*rcShadowPadding*/)
+{
+    m_bRecordFailed = true;
+}
+
+bool Render_Skia_Picture::ReadPixels(const UiRect& /*rc*/, void* /*dstPixels*/, size_t /*dstPixelsLen*/)
+{
+    m_bRecordFailed = true;
+    return false;
+}
+
+bool Render_Skia_Picture::WritePixels(void* /*srcPixels*/, size_t /*srcPixelsLen*/, const UiRect& /*rc*/)
+{
+    m_bRecordFailed = true;
+    return false;
+}
+
+bool Render_Skia_Picture::WritePixels(void* /*srcPixels*/, size_t /*srcPixelsLen*/, const UiRect& /*rc*/, const UiRect& /*rcPaint*/)
+{
+    m_bRecordFailed = true;
+    return false;
+}
+
+bool Render_Skia_Picture::ScrollPixels(const UiRect& /*rcScroll*/, int32_t /*dx*/, int32_t /*dy*/)
+{
+    m_bRecordFailed = true;
+    return false;
+}
+
+#ifdef DUILIB_BUILD_FOR_WIN
+HDC Render_Skia_Picture::GetRenderDC(HWND /*hWnd*/)
+{
+    m_bRecordFailed = true;
+    return nullptr;
+}
+
+void Render_Skia_Picture::ReleaseRenderDC(HDC /*hdc*/)
+{
+}
+#endif
+
+} // namespace ui
@@ -0,0 +1,94 @@
+#ifndef UI_RENDER_SKIA_RENDER_PICTURE_H_
+#define UI_RENDER_SKIA_RENDER_PICTURE_H_
+
+#include "duilib/RenderSkia/Render_Skia.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100)
+
+#include "include/core/SkRefCnt.h"
+
+#pragma warning (pop)
+
+//Skia相关类的前置声明
+class SkPicture;
+class SkPictureRecorder;
+
+namespace ui
+{
+/** 录制用的Render：绘制操作不产生像素，而是被录制为显示列表（SkPicture），用于并行回放（参见IRender::PaintRecorded）
+*   1. 画布大小固定，坐标与被回放的目标Render一致
+*   2. 需要访问像素数据的操作（读写像素、Alpha处理、获取DC等）无法录制，调用后标记为录制失败，由调用方按常规方式重新绘制
+*/
+class Render_Skia_Picture: public Render_Skia
+{
+public:
+    /** 构造函数，开始录制
+    * @param [in] nWidth 画布宽度（与目标Render相同）
+    * @param [in] nHeight 画布高度（与目标Render相同）
+    */
+    Render_Skia_Picture(int32_t nWidth, int32_t nHeight);
+    Render_Skia_Picture(const Render_Skia_Picture& r) = delete;
+    Render_Skia_Picture& operator = (const Render_Skia_Picture& r) = delete;
+    virtual ~Render_Skia_Picture() override;
+
+public:
+    /** 结束录制，返回录制的显示列表（录制失败时返回nullptr）
+    */
+    sk_sp<SkPicture> FinishRecording();
+
+    /** 录制过程中是否执行了无法录制的操作
+    */
+    bool IsRecordFailed() const;
+
+public:
+    virtual RenderBackendType GetRenderBackendType() const override;
+    virtual bool Resize(int32_t width, int32_t height) override;
+    virtual int32_t GetWidth() const override;
+    virtual int32_t GetHeight() const override;
+    virtual std::unique_ptr<IRender> Clone() override;
+    virtual bool PaintAndSwapBuffers(IRenderPaint* pRenderPaint) override;
+    virtual bool PaintRecorded(const UiRect& rcPaint, const RenderRecordCallback& recordCallback) override;
+    virtual SkSurface* GetSkSurface() const override;
+    virtual SkCanvas* GetSkCanvas() const override;
+
+    /** 以下操作需要访问像素数据，无法录制
+    */
+    virtual void Clear(const UiColor& uiColor) override;
+    virtual void ClearRect(const UiRect& rcDirty, const UiColor& uiColor) override;
+    virtual IBitmap* MakeImageSnapshot() override;
+    virtual void ClearAlpha(const UiRect& rcDirty, uint8_t alpha = 0) override;
+    virtual void RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding, uint8_t alpha) override;
+    virtual void RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding = UiPadding()) override;
+    virtual bool ReadPixels(const UiRect& rc, void* dstPixels, size_t dstPixelsLen) override;
+    virtual bool WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc) override;
+    virtual bool WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc, const UiRect& rcPaint) override;
+    virtual bool ScrollPixels(const UiRect& rcScroll, int32_t dx, int32_t dy) override;
+
+#ifdef DUILIB_BUILD_FOR_WIN
+    virtual HDC GetRenderDC(HWND hWnd) override;
+    virtual void ReleaseRenderDC(HDC hdc) override;
+#endif
+
+private:
+    /** 录制器
+    */
+    std::unique_ptr<SkPictureRecorder> m_pRecorder;
+
+    /** 录制用的画布（由m_pRecorder管理）
+    */
+    SkCanvas* m_pRecordCanvas;
+
+    /** 画布大小
+    */
+    int32_t m_nWidth;
+    int32_t m_nHeight;
+
+    /** 是否录制失败
+    */
+    bool m_bRecordFailed;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_RENDER_PICTURE_H_
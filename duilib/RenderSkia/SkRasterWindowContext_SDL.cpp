@@ -157,7 +157,8 @@ bool SkRasterWindowContext_SDL::PaintAndSwapBuffers(IRender* pRender, IRenderPai
 
 bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha)
 {
-    PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffers"));
+    static const PerformanceStatId s_statId(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffers"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT(!rcPaint.IsEmpty());
     if (rcPaint.IsEmpty()) {
         return false;
@@ -289,7 +290,8 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint
     }
 
     //统计性能
-    PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffersFast"));
+    static const PerformanceStatId s_statId(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffersFast"));
+    PerformanceStat statPerformance(s_statId);
 
     bool bDrawOk = false;
     if ((rcPaint.Width() != width()) || (rcPaint.Height() != height())) {
@@ -167,7 +167,8 @@ bool SkRasterWindowContext_Windows::PaintAndSwapBuffers(IRender* pRender, IRende
 
 bool SkRasterWindowContext_Windows::SwapPaintBuffers(HDC hPaintDC, const UiRect& rcPaint, IRender* pRender, uint8_t nLayeredWindowAlpha) const
 {
-    PerformanceStat statPerformance(_T("SkRasterWindowContext_Windows::SwapPaintBuffers"));
+    static const PerformanceStatId s_statId(_T("SkRasterWindowContext_Windows::SwapPaintBuffers"));
+    PerformanceStat statPerformance(s_statId);
     ASSERT(hPaintDC != nullptr);
     if (hPaintDC == nullptr) {
         return false;
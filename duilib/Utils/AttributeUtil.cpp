@@ -227,6 +227,17 @@ void AttributeUtil::ParseAttributeList(const DString& strList,
     }
 }
 
+void AttributeUtil::ParseAttributeList(const DString& strList,
+                                       std::vector<std::pair<DString, DString>>& attributeList)
+{
+    if (strList.find(_T('\"')) != DString::npos) {
+        ParseAttributeList(strList, _T('\"'), attributeList);
+    }
+    else if (strList.find(_T('\'')) != DString::npos) {
+        ParseAttributeList(strList, _T('\''), attributeList);
+    }
+}
+
 std::tuple<int32_t, float> AttributeUtil::ParseString(const wchar_t* strValue, wchar_t** pEndPtr)
 {
     wchar_t* pstr = nullptr;
@@ -9,6 +9,15 @@
 namespace ui
 {
 class Window;
+
+/** Class（通用样式）的属性：属性字符串及预先解析的属性列表（应用Class时不再重复解析属性字符串）
+*/
+struct UiClassAttributes
+{
+    DString m_attrList;                                 //属性字符串，格式如：font="system_bold_14" bkcolor="red"
+    std::vector<std::pair<DString, DString>> m_attrs;   //解析后的属性列表
+};
+
 class UILIB_API AttributeUtil
 {
 public:
@@ -46,6 +55,11 @@ public:
                                    DString::value_type seperateChar,
                                    std::vector<std::pair<DString, DString>>& attributeList);
 
+    /** 解析属性列表，根据属性字符串的内容自动选择分隔符（优先使用双引号，其次使用单引号）
+    */
+    static void ParseAttributeList(const DString& strList,
+                                   std::vector<std::pair<DString, DString>>& attributeList);
+
     /** 解析一个字符串（格式为："500,"或者"50%,"，逗号可有可无，也可以是其他字符），得到整型值或者浮点数
     * @param [in] strValue 待解析的字符串地址
     * @param [out] pEndPtr 解析完成后，字符串结束地址，用于继续解析后面的内容
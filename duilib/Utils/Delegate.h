@@ -6,32 +6,34 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <bitset>
 
 namespace ui 
 {
 
 typedef std::function<bool(const ui::EventArgs&)> EventCallback;
 
-class CEventSource : public std::vector<EventCallback>
+class CEventSource
 {
 public:
     CEventSource& operator += (const EventCallback& callback)
     {
         ASSERT(callback != nullptr);
         if (callback != nullptr) {
-            push_back(callback);
+            m_callbacks.push_back(std::make_unique<EventCallback>(callback));
         }        
         return *this;
     }
 
     bool operator() (const ui::EventArgs& param) const
     {
-        //支持在回调函数中，操作此容器
-        for (size_t index = 0; index < this->size(); ++index) {
+        //支持在回调函数中，向此容器添加回调函数：容器中保存的是指针，扩容时回调函数对象的地址不变，所以无需复制后再调用
+        for (size_t index = 0; index < m_callbacks.size(); ++index) {
             if (param.IsSenderExpired()) {
                 return false;
             }
-            EventCallback callback = this->at(index);
+            const EventCallback& callback = *m_callbacks[index];
             if ((callback == nullptr) || !callback(param)) {
                 return false;
             }
@@ -39,10 +41,194 @@ public:
         return true;
     }
 
+    bool empty() const { return m_callbacks.empty(); }
+    size_t size() const { return m_callbacks.size(); }
+
+    /** 只保留前nCount个回调函数（后添加的回调函数被移除）
+    */
+    void truncate(size_t nCount)
+    {
+        if (nCount < m_callbacks.size()) {
+            m_callbacks.resize(nCount);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<EventCallback>> m_callbacks;
 };
 
 typedef std::map<EventType, CEventSource> EventMap;
 
+/** 事件类型的位掩码，每个事件类型占一位
+*/
+typedef std::bitset<EventType::kEventLast + 1> EventTypeMask;
+
+/** 控件的事件回调函数表（替代EventMap）
+*   1. 一个控件监听的事件类型一般只有几个，使用扁平数组顺序查找，比std::map查找更快，占用的内存也更少
+*   2. 维护已监听事件类型的位掩码，没有监听者的事件无需查找，可直接跳过
+*   3. 支持在回调函数中添加或者移除本表中的回调函数
+*/
+class EventHandlerTable
+{
+public:
+    /** 每个事件类型的回调函数个数，用于记录和恢复回调函数表的状态
+    */
+    typedef std::vector<std::pair<EventType, size_t>> CallbackCounts;
+
+    /** 添加事件回调函数
+    * @param [in] eventType 事件类型
+    * @param [in] callback 事件回调函数
+    */
+    void AddCallback(EventType eventType, const EventCallback& callback)
+    {
+        ASSERT(IsValidEventType(eventType));
+        if (!IsValidEventType(eventType) || (callback == nullptr)) {
+            return;
+        }
+        for (EventEntry& entry : m_entries) {
+            if (entry.m_eventType == eventType) {
+                *entry.m_spSource += callback;
+                return;
+            }
+        }
+        EventEntry entry;
+        entry.m_eventType = eventType;
+        entry.m_spSource = std::make_shared<CEventSource>();
+        *entry.m_spSource += callback;
+        m_entries.push_back(std::move(entry));
+        m_eventMask.set((size_t)eventType);
+    }
+
+    /** 移除该事件类型的所有回调函数
+    * @param [in] eventType 事件类型
+    * @return 如果有回调函数被移除返回true，否则返回false
+    */
+    bool RemoveCallbacks(EventType eventType)
+    {
+        if (!HasEventType(eventType)) {
+            return false;
+        }
+        for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+            if (iter->m_eventType == eventType) {
+                m_entries.erase(iter);
+                break;
+            }
+        }
+        m_eventMask.reset((size_t)eventType);
+        return true;
+    }
+
+    /** 移除所有回调函数
+    */
+    void Clear()
+    {
+        m_entries.clear();
+        m_eventMask.reset();
+    }
+
+    /** 获取每个事件类型的回调函数个数
+    * @param [out] callbackCounts 返回每个事件类型的回调函数个数
+    */
+    void GetCallbackCounts(CallbackCounts& callbackCounts) const
+    {
+        callbackCounts.clear();
+        callbackCounts.reserve(m_entries.size());
+        for (const EventEntry& entry : m_entries) {
+            callbackCounts.push_back({ entry.m_eventType, entry.m_spSource->size() });
+        }
+    }
+
+    /** 恢复到GetCallbackCounts时的状态：移除此后添加的回调函数（不会恢复此后移除的回调函数）
+    * @param [in] callbackCounts 由GetCallbackCounts返回的每个事件类型的回调函数个数
+    */
+    void RestoreCallbackCounts(const CallbackCounts& callbackCounts)
+    {
+        for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+            size_t nCount = 0;
+            for (const auto& callbackCount : callbackCounts) {
+                if (callbackCount.first == iter->m_eventType) {
+                    nCount = callbackCount.second;
+                    break;
+                }
+            }
+            if (nCount == 0) {
+                m_eventMask.reset((size_t)iter->m_eventType);
+                iter = m_entries.erase(iter);
+            }
+            else {
+                iter->m_spSource->truncate(nCount);
+                ++iter;
+            }
+        }
+    }
+
+    /** 是否没有任何回调函数
+    */
+    bool IsEmpty() const
+    {
+        return m_entries.empty();
+    }
+
+    /** 是否有该事件类型的回调函数（不含kEventAll）
+    */
+    bool HasEventType(EventType eventType) const
+    {
+        return IsValidEventType(eventType) && m_eventMask.test((size_t)eventType);
+    }
+
+    /** 是否有监听该事件的回调函数（含kEventAll）
+    */
+    bool IsListening(EventType eventType) const
+    {
+        return m_eventMask.test((size_t)EventType::kEventAll) || HasEventType(eventType);
+    }
+
+    /** 调用该事件类型的回调函数
+    * @param [in] eventType 事件类型（kEventAll表示调用监听所有事件的回调函数）
+    * @param [in] param 事件参数
+    * @return 如果所有回调函数返回true，或者没有该事件类型的回调函数，返回true；否则返回false
+    */
+    bool FireEvent(EventType eventType, const ui::EventArgs& param) const
+    {
+        if (!HasEventType(eventType)) {
+            return true;
+        }
+        for (const EventEntry& entry : m_entries) {
+            if (entry.m_eventType == eventType) {
+                //回调函数中可能移除本事件类型，保持引用计数，确保调用过程中对象有效
+                std::shared_ptr<CEventSource> spSource = entry.m_spSource;
+                return (*spSource)(param);
+            }
+        }
+        return true;
+    }
+
+private:
+    /** 事件类型是否有效
+    */
+    static bool IsValidEventType(EventType eventType)
+    {
+        return ((size_t)eventType <= (size_t)EventType::kEventLast);
+    }
+
+private:
+    /** 一个事件类型的回调函数
+    */
+    struct EventEntry
+    {
+        EventType m_eventType = EventType::kEventNone;
+        std::shared_ptr<CEventSource> m_spSource;
+    };
+
+    /** 回调函数表，按添加的先后顺序排列
+    */
+    std::vector<EventEntry> m_entries;
+
+    /** 已监听的事件类型掩码
+    */
+    EventTypeMask m_eventMask;
+};
+
 }
 
 #endif // UI_UTILS_DELEGATE_H_
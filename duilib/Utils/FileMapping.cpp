@@ -0,0 +1,118 @@
+#include "FileMapping.h"
+
+#ifndef DUILIB_BUILD_FOR_WIN
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace ui
+{
+
+FileMapping::FileMapping():
+    m_pData(nullptr),
+    m_nSize(0)
+#ifdef DUILIB_BUILD_FOR_WIN
+    ,m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(nullptr)
+#endif
+{
+}
+
+FileMapping::~FileMapping()
+{
+    Close();
+}
+
+bool FileMapping::Open(const FilePath& filePath)
+{
+    Close();
+    if (filePath.IsEmpty()) {
+        return false;
+    }
+#ifdef DUILIB_BUILD_FOR_WIN
+    //Windows平台
+    m_hFile = ::CreateFileW(filePath.ToStringW().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize = { 0, };
+    if (!::GetFileSizeEx(m_hFile, &fileSize) || (fileSize.QuadPart <= 0)) {
+        Close();
+        return false;
+    }
+    m_hMapping = ::CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping == nullptr) {
+        Close();
+        return false;
+    }
+    m_pData = (uint8_t*)::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_pData == nullptr) {
+        Close();
+        return false;
+    }
+    m_nSize = (size_t)fileSize.QuadPart;
+#else
+    //Linux平台
+    int fd = ::open(filePath.NativePathA().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if ((::fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)) {
+        ::close(fd);
+        return false;
+    }
+    void* pData = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //映射完成后，文件描述符可以关闭，不影响映射
+    ::close(fd);
+    if (pData == MAP_FAILED) {
+        return false;
+    }
+    m_pData = (uint8_t*)pData;
+    m_nSize = (size_t)fileStat.st_size;
+#endif
+    return true;
+}
+
+void FileMapping::Close()
+{
+#ifdef DUILIB_BUILD_FOR_WIN
+    if (m_pData != nullptr) {
+        ::UnmapViewOfFile(m_pData);
+    }
+    if (m_hMapping != nullptr) {
+        ::CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_pData != nullptr) {
+        ::munmap(m_pData, m_nSize);
+    }
+#endif
+    m_pData = nullptr;
+    m_nSize = 0;
+}
+
+bool FileMapping::IsOpened() const
+{
+    return m_pData != nullptr;
+}
+
+const uint8_t* FileMapping::GetData() const
+{
+    return m_pData;
+}
+
+size_t FileMapping::GetSize() const
+{
+    return m_nSize;
+}
+
+}
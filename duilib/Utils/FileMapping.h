@@ -0,0 +1,64 @@
+#ifndef UI_UTILS_FILE_MAPPING_H_
+#define UI_UTILS_FILE_MAPPING_H_
+
+#include "duilib/Utils/FilePath.h"
+
+namespace ui
+{
+
+/** 只读的内存映射文件（文件内容映射到进程地址空间，按需由系统分页加载，多线程可同时读取）
+*/
+class UILIB_API FileMapping
+{
+public:
+    FileMapping();
+    ~FileMapping();
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator = (const FileMapping&) = delete;
+
+public:
+    /** 以只读方式映射文件
+    * @param [in] filePath 本地文件路径(绝对路径)
+    * @return 成功返回true，否则返回false（空文件无法映射，返回false）
+    */
+    bool Open(const FilePath& filePath);
+
+    /** 关闭映射（关闭后，之前获取的数据指针均失效）
+    */
+    void Close();
+
+    /** 是否已经映射成功
+    */
+    bool IsOpened() const;
+
+    /** 获取映射的数据起始地址
+    */
+    const uint8_t* GetData() const;
+
+    /** 获取映射的数据长度
+    */
+    size_t GetSize() const;
+
+private:
+    /** 映射的数据起始地址
+    */
+    uint8_t* m_pData;
+
+    /** 映射的数据长度
+    */
+    size_t m_nSize;
+
+#ifdef DUILIB_BUILD_FOR_WIN
+    /** 文件句柄
+    */
+    HANDLE m_hFile;
+
+    /** 文件映射句柄
+    */
+    HANDLE m_hMapping;
+#endif
+};
+
+}
+
+#endif // UI_UTILS_FILE_MAPPING_H_
@@ -80,6 +80,24 @@ bool FilePath::IsExistsFile() const noexcept
     return std::filesystem::is_regular_file(fileStatus);
 }
 
+bool FilePath::GetFileInfo(uint64_t& nFileSize, int64_t& nLastWriteTime) const noexcept
+{
+    nFileSize = 0;
+    nLastWriteTime = 0;
+    std::error_code errorCode;
+    const uintmax_t fileSize = std::filesystem::file_size(m_filePath, errorCode);
+    if (errorCode.value() != 0) {
+        return false;
+    }
+    const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(m_filePath, errorCode);
+    if (errorCode.value() != 0) {
+        return false;
+    }
+    nFileSize = (uint64_t)fileSize;
+    nLastWriteTime = (int64_t)lastWriteTime.time_since_epoch().count();
+    return true;
+}
+
 bool FilePath::IsExistsDirectory() const noexcept
 {
     std::error_code errorCode;
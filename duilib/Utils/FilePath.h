@@ -66,6 +66,13 @@ public:
     */
     bool IsExistsDirectory() const noexcept;
 
+    /** 获取本地文件系统中文件的大小和最后修改时间（不读取文件内容）
+    * @param [out] nFileSize 返回文件的大小
+    * @param [out] nLastWriteTime 返回文件的最后修改时间（与平台相关的时间刻度，只用于比较是否发生变化）
+    * @return 文件存在返回true，否则返回false
+    */
+    bool GetFileInfo(uint64_t& nFileSize, int64_t& nLastWriteTime) const noexcept;
+
     /** 获取路径分隔符
     */
     DString::value_type GetPathSeparator() const;
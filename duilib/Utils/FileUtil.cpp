@@ -39,6 +39,32 @@ bool FileUtil::ReadFileData(const FilePath& filePath, std::vector<uint8_t>& file
     return isReadOk;
 }
 
+bool FileUtil::ReadFileHeader(const FilePath& filePath, size_t nMaxSize, std::vector<uint8_t>& fileData)
+{
+    fileData.clear();
+    FILE* f = nullptr;
+#ifdef DUILIB_BUILD_FOR_WIN
+    //Windows平台
+    #ifdef DUILIB_UNICODE
+        ::_wfopen_s(&f, filePath.NativePath().c_str(), _T("rb"));
+    #else
+        ::fopen_s(&f, filePath.NativePath().c_str(), _T("rb"));
+    #endif
+#else
+    //Linux平台
+    f = fopen(filePath.NativePath().c_str(), _T("rb"));
+#endif
+
+    if (f == nullptr) {
+        return false;
+    }
+    fileData.resize(nMaxSize);
+    size_t readLen = ::fread(fileData.data(), 1, fileData.size(), f);
+    fileData.resize(readLen);
+    ::fclose(f);
+    return true;
+}
+
 bool FileUtil::WriteFileData(const FilePath& filePath, const std::vector<uint8_t>& fileData)
 {
     bool isWriteOk = false;
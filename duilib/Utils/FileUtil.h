@@ -16,6 +16,13 @@ public:
     */
     static bool ReadFileData(const FilePath& filePath, std::vector<uint8_t>& fileData);
 
+    /** 读取文件开头的内容（比如用于检查文件头标识）
+    * @param [in] filePath 本地文件路径(绝对路径)
+    * @param [in] nMaxSize 最多读取的字节数
+    * @param [out] fileData 文件数据，按二进制数据读取（文件长度小于nMaxSize时，返回整个文件的数据）
+    */
+    static bool ReadFileHeader(const FilePath& filePath, size_t nMaxSize, std::vector<uint8_t>& fileData);
+
     /** 写入文件内容
     * @param [in] filePath 本地文件路径(绝对路径)
     * @param [in] fileData 文件数据
@@ -0,0 +1,144 @@
+#include "ParallelTaskRunner.h"
+
+namespace ui
+{
+
+ParallelTaskRunner::ParallelTaskRunner():
+    m_pJob(nullptr),
+    m_nJobId(0),
+    m_bStop(false)
+{
+}
+
+ParallelTaskRunner::~ParallelTaskRunner()
+{
+    Shutdown();
+}
+
+ParallelTaskRunner& ParallelTaskRunner::Instance()
+{
+    static ParallelTaskRunner self;
+    return self;
+}
+
+size_t ParallelTaskRunner::GetConcurrency() const
+{
+    size_t nThreads = (size_t)std::thread::hardware_concurrency();
+    if (nThreads < 1) {
+        nThreads = 1;
+    }
+    if (nThreads > (kMaxWorkerCount + 1)) {
+        nThreads = kMaxWorkerCount + 1;
+    }
+    return nThreads;
+}
+
+void ParallelTaskRunner::CheckStartWorkers()
+{
+    if (!m_workers.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_bStop = false;
+    }
+    const size_t nWorkerCount = GetConcurrency() - 1;
+    for (size_t nIndex = 0; nIndex < nWorkerCount; ++nIndex) {
+        m_workers.emplace_back(&ParallelTaskRunner::WorkerThreadProc, this);
+    }
+}
+
+void ParallelTaskRunner::ParallelFor(size_t nCount, const std::function<void(size_t nIndex)>& taskFunc)
+{
+    if ((nCount == 0) || (taskFunc == nullptr)) {
+        return;
+    }
+    std::lock_guard<std::mutex> runGuard(m_runMutex);
+    CheckStartWorkers();
+    if ((nCount == 1) || m_workers.empty()) {
+        //无需并行
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+            taskFunc(nIndex);
+        }
+        return;
+    }
+
+    ParallelJob job;
+    job.m_pTaskFunc = &taskFunc;
+    job.m_nCount = nCount;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_pJob = &job;
+        ++m_nJobId;
+    }
+    m_jobCv.notify_all();
+
+    //调用线程也参与执行
+    RunJob(job);
+
+    //等待领取了任务的工作线程全部完成（job对象在栈上，返回前不能再被工作线程访问）
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_pJob = nullptr;
+    m_doneCv.wait(lock, [&job]() { return job.m_nActiveWorkers == 0; });
+}
+
+void ParallelTaskRunner::RunJob(ParallelJob& job)
+{
+    while (true) {
+        const size_t nIndex = job.m_nNextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (nIndex >= job.m_nCount) {
+            break;
+        }
+        (*job.m_pTaskFunc)(nIndex);
+    }
+}
+
+void ParallelTaskRunner::WorkerThreadProc()
+{
+    uint64_t nLastJobId = 0;
+    while (true) {
+        ParallelJob* pJob = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobCv.wait(lock, [this, nLastJobId]() {
+                return m_bStop || ((m_pJob != nullptr) && (m_nJobId != nLastJobId));
+                });
+            if (m_bStop) {
+                break;
+            }
+            nLastJobId = m_nJobId;
+            pJob = m_pJob;
+            ++pJob->m_nActiveWorkers;
+        }
+
+        RunJob(*pJob);
+
+        bool bNotify = false;
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            --pJob->m_nActiveWorkers;
+            bNotify = (pJob->m_nActiveWorkers == 0);
+        }
+        if (bNotify) {
+            m_doneCv.notify_all();
+        }
+    }
+}
+
+void ParallelTaskRunner::Shutdown()
+{
+    std::lock_guard<std::mutex> runGuard(m_runMutex);
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_bStop = true;
+    }
+    m_jobCv.notify_all();
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+} // namespace ui
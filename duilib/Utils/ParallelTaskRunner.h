@@ -0,0 +1,110 @@
+#ifndef UI_UTILS_PARALLEL_TASK_RUNNER_H_
+#define UI_UTILS_PARALLEL_TASK_RUNNER_H_
+
+#include "duilib/duilib_defs.h"
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <atomic>
+
+namespace ui
+{
+
+/** 并行任务执行器：固定数量的常驻工作线程，用于将一批相互独立的计算任务分发到多个CPU核上同步执行（fork-join模式）
+*   1. 工作线程在首次使用时创建，GlobalManager::Shutdown时退出
+*   2. 调用线程也参与执行任务，所有任务完成后ParallelFor才返回
+*   3. 任务函数中不能访问只允许在UI线程中访问的数据（控件树等）
+*/
+class UILIB_API ParallelTaskRunner
+{
+public:
+    ParallelTaskRunner();
+    ~ParallelTaskRunner();
+    ParallelTaskRunner(const ParallelTaskRunner&) = delete;
+    ParallelTaskRunner& operator = (const ParallelTaskRunner&) = delete;
+
+    /** 单例对象
+    */
+    static ParallelTaskRunner& Instance();
+
+    /** 工作线程的最大个数
+    */
+    static constexpr size_t kMaxWorkerCount = 7;
+
+public:
+    /** 并行执行任务：对于[0, nCount)中的每个下标调用一次taskFunc，所有任务完成后返回
+    * @param [in] nCount 任务个数
+    * @param [in] taskFunc 任务函数，参数为任务下标，可能在多个线程中同时调用
+    */
+    void ParallelFor(size_t nCount, const std::function<void(size_t nIndex)>& taskFunc);
+
+    /** 获取可以并行执行任务的线程数（工作线程数 + 调用线程），单核机器返回1
+    */
+    size_t GetConcurrency() const;
+
+    /** 退出所有工作线程（再次调用ParallelFor时会重新创建）
+    */
+    void Shutdown();
+
+private:
+    /** 一次ParallelFor调用的数据
+    */
+    struct ParallelJob
+    {
+        const std::function<void(size_t)>* m_pTaskFunc = nullptr;   //任务函数
+        size_t m_nCount = 0;                                        //任务个数
+        std::atomic<size_t> m_nNextIndex = 0;                       //下一个待执行的任务下标
+        size_t m_nActiveWorkers = 0;                                //正在执行该批任务的工作线程数（受m_mutex保护）
+    };
+
+    /** 执行任务，直到该批任务全部被领取
+    */
+    static void RunJob(ParallelJob& job);
+
+    /** 工作线程的线程函数
+    */
+    void WorkerThreadProc();
+
+    /** 创建工作线程（如果尚未创建）
+    */
+    void CheckStartWorkers();
+
+private:
+    /** 工作线程
+    */
+    std::vector<std::thread> m_workers;
+
+    /** 保证同一时刻只有一个ParallelFor在执行
+    */
+    std::mutex m_runMutex;
+
+    /** 保护任务数据
+    */
+    std::mutex m_mutex;
+
+    /** 通知工作线程有新任务
+    */
+    std::condition_variable m_jobCv;
+
+    /** 通知调用线程工作线程已经完成
+    */
+    std::condition_variable m_doneCv;
+
+    /** 当前的任务（受m_mutex保护）
+    */
+    ParallelJob* m_pJob;
+
+    /** 任务序号，每次ParallelFor递增（受m_mutex保护）
+    */
+    uint64_t m_nJobId;
+
+    /** 是否退出工作线程（受m_mutex保护）
+    */
+    bool m_bStop;
+};
+
+} // namespace ui
+
+#endif // UI_UTILS_PARALLEL_TASK_RUNNER_H_
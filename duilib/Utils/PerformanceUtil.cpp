@@ -1,28 +1,257 @@
 #include "PerformanceUtil.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/FileUtil.h"
 #include "duilib/Utils/LogUtil.h"
+#include <chrono>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
 
-namespace ui 
+namespace ui
 {
+/** 耗时分布直方图的桶个数：0~3微秒每微秒一个桶，此后每个2的幂次区间分为4个桶（相对误差不超过25%）
+*/
+static constexpr uint32_t kHistogramBucketCount = 4 + 30 * 4;
 
-PerformanceUtil::PerformanceUtil()
+/** 计算耗时（微秒）对应的直方图桶下标
+*/
+static uint32_t GetHistogramBucket(uint64_t nDuration)
 {
+    if (nDuration < 4) {
+        return (uint32_t)nDuration;
+    }
+    if (nDuration > 0xFFFFFFFFULL) {
+        nDuration = 0xFFFFFFFFULL;
+    }
+    uint32_t nOctave = 2;
+    while ((nDuration >> (nOctave + 1)) != 0) {
+        ++nOctave;
+    }
+    const uint32_t nSubBucket = (uint32_t)(nDuration >> (nOctave - 2)) & 3;
+    const uint32_t nBucket = 4 + (nOctave - 2) * 4 + nSubBucket;
+    return (nBucket < kHistogramBucketCount) ? nBucket : (kHistogramBucketCount - 1);
 }
 
-PerformanceUtil::~PerformanceUtil()
+/** 获取直方图桶的上限值（微秒，不含）
+*/
+static int64_t GetHistogramBucketUpperBound(uint32_t nBucket)
 {
-    for (const auto& iter : m_stat) {
-        if (iter.second.totalCount == 0) {
-            continue;
+    if (nBucket < 4) {
+        return (int64_t)nBucket + 1;
+    }
+    const uint32_t nOctave = (nBucket - 4) / 4 + 2;
+    const uint32_t nSubBucket = (nBucket - 4) % 4;
+    return (int64_t)(4 + nSubBucket + 1) << (nOctave - 2);
+}
+
+/** 每个线程中，单个统计项的数据
+*/
+struct PerformanceStatSlot
+{
+    std::atomic<uint64_t> m_nCount{ 0 };
+    std::atomic<int64_t> m_nTotalTime{ 0 };
+    std::atomic<int64_t> m_nMaxTime{ 0 };
+    std::atomic<uint32_t> m_histogram[kHistogramBucketCount] = {};
+};
+
+/** 跟踪事件的ID中，表示计数器事件的标志（低位为计数器ID，m_nDuration为计数器变化后的值）
+*/
+static constexpr uint32_t kCounterEventFlag = 0x80000000;
+
+/** 跟踪事件
+*/
+struct PerformanceTraceEvent
+{
+    std::atomic<uint32_t> m_nStatId{ 0 };
+    std::atomic<int64_t> m_nStartTime{ 0 };
+    std::atomic<int64_t> m_nDuration{ 0 };
+};
+
+/** 每个线程的数据缓冲区（只有所属线程写入，读取时汇总，缓冲区在进程生命周期内不释放，线程退出后可被新线程复用）
+*/
+struct PerformanceThreadBuffer
+{
+    /** 缓冲区序号（导出跟踪事件时作为线程ID）
+    */
+    uint32_t m_nBufferIndex = 0;
+
+    /** 是否有线程正在使用
+    */
+    std::atomic<bool> m_bInUse{ false };
+
+    /** 统计项数据，按统计项ID索引（首次使用时分配）
+    */
+    std::atomic<PerformanceStatSlot*> m_slots[PerformanceUtil::kMaxStatCount] = {};
+
+    /** 跟踪事件的环形缓冲区（开启事件跟踪后分配）
+    */
+    std::atomic<PerformanceTraceEvent*> m_traceEvents{ nullptr };
+
+    /** 已写入的跟踪事件总数
+    */
+    std::atomic<uint64_t> m_nTraceEventCount{ 0 };
+
+    /** BeginStat/EndStat兼容接口的计时栈（只有所属线程访问）
+    */
+    std::vector<std::pair<uint32_t, int64_t>> m_beginStack;
+};
+
+/** 性能统计的注册表（进程生命周期内不释放，避免线程退出时访问已销毁的对象）
+*/
+class PerformanceRegistry
+{
+public:
+    static PerformanceRegistry& Instance()
+    {
+        static PerformanceRegistry* pRegistry = new PerformanceRegistry;
+        return *pRegistry;
+    }
+
+    uint32_t RegisterStat(const DString& name)
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        auto iter = m_statIdMap.find(name);
+        if (iter != m_statIdMap.end()) {
+            return iter->second;
         }
-        DString log = StringUtil::Printf(_T("%s(%d): %d ms, average: %d ms, max: %d ms"), 
-                                        iter.first.c_str(),
-                                        (int32_t)iter.second.totalCount, 
-                                        (int32_t)(iter.second.totalTimes.count() / 1000),
-                                        (int32_t)(iter.second.totalTimes.count() / 1000 / iter.second.totalCount),
-                                        (int32_t)(iter.second.maxTime.count() / 1000));
-        LogUtil::OutputLine(log);
+        ASSERT(m_statNames.size() < PerformanceUtil::kMaxStatCount);
+        if (m_statNames.size() >= PerformanceUtil::kMaxStatCount) {
+            return PerformanceUtil::kInvalidStatId;
+        }
+        const uint32_t nStatId = (uint32_t)m_statNames.size();
+        m_statNames.push_back(name);
+        m_statIdMap[name] = nStatId;
+        return nStatId;
+    }
+
+    DString GetStatName(uint32_t nStatId)
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        return (nStatId < m_statNames.size()) ? m_statNames[nStatId] : DString();
+    }
+
+    uint32_t GetStatCount()
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        return (uint32_t)m_statNames.size();
+    }
+
+    uint32_t RegisterCounter(const DString& name)
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        auto iter = m_counterIdMap.find(name);
+        if (iter != m_counterIdMap.end()) {
+            return iter->second;
+        }
+        ASSERT(m_counterNames.size() < PerformanceUtil::kMaxCounterCount);
+        if (m_counterNames.size() >= PerformanceUtil::kMaxCounterCount) {
+            return PerformanceUtil::kInvalidStatId;
+        }
+        const uint32_t nCounterId = (uint32_t)m_counterNames.size();
+        m_counterNames.push_back(name);
+        m_counterIdMap[name] = nCounterId;
+        return nCounterId;
+    }
+
+    DString GetCounterName(uint32_t nCounterId)
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        return (nCounterId < m_counterNames.size()) ? m_counterNames[nCounterId] : DString();
+    }
+
+    uint32_t GetCounterCount()
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        return (uint32_t)m_counterNames.size();
+    }
+
+    /** 计数器的值，按计数器ID索引（所有线程共用，原子累加）
+    */
+    std::atomic<int64_t> m_counterValues[PerformanceUtil::kMaxCounterCount] = {};
+
+    PerformanceThreadBuffer* AcquireThreadBuffer()
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        for (PerformanceThreadBuffer* pBuffer : m_threadBuffers) {
+            bool bInUse = false;
+            if (pBuffer->m_bInUse.compare_exchange_strong(bInUse, true)) {
+                return pBuffer;
+            }
+        }
+        PerformanceThreadBuffer* pBuffer = new PerformanceThreadBuffer;
+        pBuffer->m_nBufferIndex = (uint32_t)m_threadBuffers.size() + 1;
+        pBuffer->m_bInUse = true;
+        m_threadBuffers.push_back(pBuffer);
+        return pBuffer;
     }
+
+    std::vector<PerformanceThreadBuffer*> GetThreadBuffers()
+    {
+        std::lock_guard<std::mutex> threadGuard(m_mutex);
+        return m_threadBuffers;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::deque<DString> m_statNames;
+    std::unordered_map<DString, uint32_t> m_statIdMap;
+    std::deque<DString> m_counterNames;
+    std::unordered_map<DString, uint32_t> m_counterIdMap;
+    std::vector<PerformanceThreadBuffer*> m_threadBuffers;
+};
+
+/** 线程退出时，释放线程缓冲区的使用权（缓冲区数据保留）
+*/
+class PerformanceThreadBufferHolder
+{
+public:
+    ~PerformanceThreadBufferHolder()
+    {
+        if (m_pBuffer != nullptr) {
+            m_pBuffer->m_beginStack.clear();
+            m_pBuffer->m_bInUse = false;
+            m_pBuffer = nullptr;
+        }
+    }
+
+    PerformanceThreadBuffer* GetBuffer()
+    {
+        if (m_pBuffer == nullptr) {
+            m_pBuffer = PerformanceRegistry::Instance().AcquireThreadBuffer();
+        }
+        return m_pBuffer;
+    }
+
+private:
+    PerformanceThreadBuffer* m_pBuffer = nullptr;
+};
+
+static PerformanceThreadBuffer* GetThreadBuffer()
+{
+    thread_local PerformanceThreadBufferHolder bufferHolder;
+    return bufferHolder.GetBuffer();
+}
+
+#ifdef _DEBUG
+std::atomic<bool> PerformanceUtil::s_bEnabled{ true };
+#else
+std::atomic<bool> PerformanceUtil::s_bEnabled{ false };
+#endif
+std::atomic<bool> PerformanceUtil::s_bTraceEnabled{ false };
+
+PerformanceUtil::PerformanceUtil()
+{
+    //初始化计时起点
+    GetTimestamp();
+}
+
+PerformanceUtil::~PerformanceUtil()
+{
+    OutputStatLog();
 }
 
 PerformanceUtil& PerformanceUtil::Instance()
@@ -31,29 +260,364 @@ PerformanceUtil& PerformanceUtil::Instance()
     return self;
 }
 
-void PerformanceUtil::BeginStat(const DString& name)
+void PerformanceUtil::SetEnabled(bool bEnabled)
+{
+    s_bEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+void PerformanceUtil::SetTraceEnabled(bool bEnabled)
+{
+    s_bTraceEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+int64_t PerformanceUtil::GetTimestamp()
+{
+    static const std::chrono::steady_clock::time_point s_startTime = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_startTime).count();
+}
+
+uint32_t PerformanceUtil::RegisterStat(const DString& name)
 {
     ASSERT(!name.empty());
-    TStat& stat = m_stat[name];
-    stat.startTime = std::chrono::steady_clock::now();
-    ASSERT(stat.nStartRefCount >= 0);
-    stat.nStartRefCount++;
+    if (name.empty()) {
+        return kInvalidStatId;
+    }
+    return PerformanceRegistry::Instance().RegisterStat(name);
 }
 
-void PerformanceUtil::EndStat(const DString& name)
+DString PerformanceUtil::GetStatName(uint32_t nStatId) const
+{
+    return PerformanceRegistry::Instance().GetStatName(nStatId);
+}
+
+/** 记录一个跟踪事件到当前线程的环形缓冲区
+*/
+static void AddTraceEvent(PerformanceThreadBuffer* pBuffer, uint32_t nStatId, int64_t nStartTime, int64_t nDuration)
+{
+    PerformanceTraceEvent* pEvents = pBuffer->m_traceEvents.load(std::memory_order_acquire);
+    if (pEvents == nullptr) {
+        pEvents = new PerformanceTraceEvent[PerformanceUtil::kMaxTraceEventCount];
+        pBuffer->m_traceEvents.store(pEvents, std::memory_order_release);
+    }
+    const uint64_t nEventCount = pBuffer->m_nTraceEventCount.load(std::memory_order_relaxed);
+    PerformanceTraceEvent& traceEvent = pEvents[nEventCount % PerformanceUtil::kMaxTraceEventCount];
+    traceEvent.m_nStatId.store(nStatId, std::memory_order_relaxed);
+    traceEvent.m_nStartTime.store(nStartTime, std::memory_order_relaxed);
+    traceEvent.m_nDuration.store(nDuration, std::memory_order_relaxed);
+    pBuffer->m_nTraceEventCount.store(nEventCount + 1, std::memory_order_release);
+}
+
+uint32_t PerformanceUtil::RegisterCounter(const DString& name)
 {
     ASSERT(!name.empty());
-    TStat& stat = m_stat[name];
-    ASSERT(stat.nStartRefCount > 0);
-    if (stat.nStartRefCount <= 0) {
+    if (name.empty()) {
+        return kInvalidStatId;
+    }
+    return PerformanceRegistry::Instance().RegisterCounter(name);
+}
+
+DString PerformanceUtil::GetCounterName(uint32_t nCounterId) const
+{
+    return PerformanceRegistry::Instance().GetCounterName(nCounterId);
+}
+
+void PerformanceUtil::AddCounter(uint32_t nCounterId, int64_t nValue)
+{
+    if (nCounterId >= kMaxCounterCount) {
+        return;
+    }
+    std::atomic<int64_t>& counterValue = PerformanceRegistry::Instance().m_counterValues[nCounterId];
+    const int64_t nNewValue = counterValue.fetch_add(nValue, std::memory_order_relaxed) + nValue;
+    if (IsTraceEnabled()) {
+        AddTraceEvent(GetThreadBuffer(), nCounterId | kCounterEventFlag, GetTimestamp(), nNewValue);
+    }
+}
+
+int64_t PerformanceUtil::GetCounterValue(uint32_t nCounterId) const
+{
+    if (nCounterId >= kMaxCounterCount) {
+        return 0;
+    }
+    return PerformanceRegistry::Instance().m_counterValues[nCounterId].load(std::memory_order_relaxed);
+}
+
+void PerformanceUtil::AddSample(uint32_t nStatId, int64_t nStartTime, int64_t nDuration)
+{
+    if (nStatId >= kMaxStatCount) {
+        return;
+    }
+    if (nDuration < 0) {
+        nDuration = 0;
+    }
+    PerformanceThreadBuffer* pBuffer = GetThreadBuffer();
+    PerformanceStatSlot* pSlot = pBuffer->m_slots[nStatId].load(std::memory_order_acquire);
+    if (pSlot == nullptr) {
+        pSlot = new PerformanceStatSlot;
+        pBuffer->m_slots[nStatId].store(pSlot, std::memory_order_release);
+    }
+    pSlot->m_nCount.fetch_add(1, std::memory_order_relaxed);
+    pSlot->m_nTotalTime.fetch_add(nDuration, std::memory_order_relaxed);
+    int64_t nMaxTime = pSlot->m_nMaxTime.load(std::memory_order_relaxed);
+    while ((nDuration > nMaxTime) &&
+           !pSlot->m_nMaxTime.compare_exchange_weak(nMaxTime, nDuration, std::memory_order_relaxed)) {
+    }
+    pSlot->m_histogram[GetHistogramBucket((uint64_t)nDuration)].fetch_add(1, std::memory_order_relaxed);
+
+    if (IsTraceEnabled()) {
+        AddTraceEvent(pBuffer, nStatId, nStartTime, nDuration);
+    }
+}
+
+void PerformanceUtil::BeginStat(const DString& name)
+{
+    if (!IsEnabled()) {
         return;
     }
-    stat.endTime = std::chrono::steady_clock::now();
-    stat.totalCount += 1;
-    auto thisTime = std::chrono::duration_cast<std::chrono::microseconds>(stat.endTime - stat.startTime);
-    stat.totalTimes += thisTime;
-    stat.nStartRefCount--;
-    stat.maxTime = (std::max)(stat.maxTime, thisTime);
+    const uint32_t nStatId = RegisterStat(name);
+    if (nStatId == kInvalidStatId) {
+        return;
+    }
+    GetThreadBuffer()->m_beginStack.push_back({ nStatId, GetTimestamp() });
+}
+
+void PerformanceUtil::EndStat(const DString& name)
+{
+    PerformanceThreadBuffer* pBuffer = GetThreadBuffer();
+    if (pBuffer->m_beginStack.empty()) {
+        //开始计时时统计功能未开启
+        return;
+    }
+    const uint32_t nStatId = RegisterStat(name);
+    auto& beginStack = pBuffer->m_beginStack;
+    for (size_t nIndex = beginStack.size(); nIndex > 0; --nIndex) {
+        if (beginStack[nIndex - 1].first == nStatId) {
+            const int64_t nStartTime = beginStack[nIndex - 1].second;
+            beginStack.erase(beginStack.begin() + (nIndex - 1));
+            AddSample(nStatId, nStartTime, GetTimestamp() - nStartTime);
+            break;
+        }
+    }
+}
+
+void PerformanceUtil::GetSnapshot(std::vector<StatSnapshot>& snapshot, bool bReset)
+{
+    snapshot.clear();
+    const uint32_t nStatCount = PerformanceRegistry::Instance().GetStatCount();
+    const std::vector<PerformanceThreadBuffer*> threadBuffers = PerformanceRegistry::Instance().GetThreadBuffers();
+    std::vector<uint64_t> histogram(kHistogramBucketCount);
+    for (uint32_t nStatId = 0; nStatId < nStatCount; ++nStatId) {
+        StatSnapshot statSnapshot;
+        std::fill(histogram.begin(), histogram.end(), 0);
+        for (PerformanceThreadBuffer* pBuffer : threadBuffers) {
+            PerformanceStatSlot* pSlot = pBuffer->m_slots[nStatId].load(std::memory_order_acquire);
+            if (pSlot == nullptr) {
+                continue;
+            }
+            if (bReset) {
+                statSnapshot.m_nCount += pSlot->m_nCount.exchange(0, std::memory_order_relaxed);
+                statSnapshot.m_nTotalTime += pSlot->m_nTotalTime.exchange(0, std::memory_order_relaxed);
+                statSnapshot.m_nMaxTime = (std::max)(statSnapshot.m_nMaxTime, pSlot->m_nMaxTime.exchange(0, std::memory_order_relaxed));
+                for (uint32_t nBucket = 0; nBucket < kHistogramBucketCount; ++nBucket) {
+                    histogram[nBucket] += pSlot->m_histogram[nBucket].exchange(0, std::memory_order_relaxed);
+                }
+            }
+            else {
+                statSnapshot.m_nCount += pSlot->m_nCount.load(std::memory_order_relaxed);
+                statSnapshot.m_nTotalTime += pSlot->m_nTotalTime.load(std::memory_order_relaxed);
+                statSnapshot.m_nMaxTime = (std::max)(statSnapshot.m_nMaxTime, pSlot->m_nMaxTime.load(std::memory_order_relaxed));
+                for (uint32_t nBucket = 0; nBucket < kHistogramBucketCount; ++nBucket) {
+                    histogram[nBucket] += pSlot->m_histogram[nBucket].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        if (statSnapshot.m_nCount == 0) {
+            continue;
+        }
+        //按直方图估算分位数（取所在桶的上限，并且不超过最大值）
+        uint64_t nHistogramCount = 0;
+        for (uint64_t nBucketCount : histogram) {
+            nHistogramCount += nBucketCount;
+        }
+        const uint64_t nP50Rank = (nHistogramCount * 50 + 99) / 100;
+        const uint64_t nP99Rank = (nHistogramCount * 99 + 99) / 100;
+        uint64_t nRank = 0;
+        bool bP50Found = false;
+        for (uint32_t nBucket = 0; nBucket < kHistogramBucketCount; ++nBucket) {
+            if (histogram[nBucket] == 0) {
+                continue;
+            }
+            nRank += histogram[nBucket];
+            const int64_t nUpperBound = (std::min)(GetHistogramBucketUpperBound(nBucket), statSnapshot.m_nMaxTime);
+            if (!bP50Found && (nRank >= nP50Rank)) {
+                statSnapshot.m_nP50Time = nUpperBound;
+                bP50Found = true;
+            }
+            if (nRank >= nP99Rank) {
+                statSnapshot.m_nP99Time = nUpperBound;
+                break;
+            }
+        }
+        statSnapshot.m_nStatId = nStatId;
+        statSnapshot.m_name = GetStatName(nStatId);
+        snapshot.push_back(std::move(statSnapshot));
+    }
+}
+
+void PerformanceUtil::GetSnapshot(std::vector<StatSnapshot>& snapshot, std::vector<CounterSnapshot>& counters, bool bReset)
+{
+    GetSnapshot(snapshot, bReset);
+    counters.clear();
+    const uint32_t nCounterCount = PerformanceRegistry::Instance().GetCounterCount();
+    for (uint32_t nCounterId = 0; nCounterId < nCounterCount; ++nCounterId) {
+        CounterSnapshot counterSnapshot;
+        counterSnapshot.m_nCounterId = nCounterId;
+        counterSnapshot.m_name = GetCounterName(nCounterId);
+        counterSnapshot.m_nValue = GetCounterValue(nCounterId);
+        counters.push_back(std::move(counterSnapshot));
+    }
+}
+
+void PerformanceUtil::Reset()
+{
+    std::vector<StatSnapshot> snapshot;
+    GetSnapshot(snapshot, true);
+    const std::vector<PerformanceThreadBuffer*> threadBuffers = PerformanceRegistry::Instance().GetThreadBuffers();
+    for (PerformanceThreadBuffer* pBuffer : threadBuffers) {
+        pBuffer->m_nTraceEventCount.store(0, std::memory_order_release);
+    }
+}
+
+/** 将字符串转换为JSON字符串（UTF8编码，含引号）
+*/
+static std::string ToJsonString(const DString& str)
+{
+    const std::string utf8 = StringConvert::TToUTF8(str);
+    std::string json;
+    json.reserve(utf8.size() + 2);
+    json += '"';
+    for (char ch : utf8) {
+        if ((ch == '"') || (ch == '\\')) {
+            json += '\\';
+            json += ch;
+        }
+        else if ((uint8_t)ch < 0x20) {
+            char buf[8] = { 0 };
+            snprintf(buf, sizeof(buf), "\\u%04x", (uint32_t)(uint8_t)ch);
+            json += buf;
+        }
+        else {
+            json += ch;
+        }
+    }
+    json += '"';
+    return json;
+}
+
+std::string PerformanceUtil::GetChromeTraceJson()
+{
+    const uint32_t nStatCount = PerformanceRegistry::Instance().GetStatCount();
+    std::vector<std::string> statNames(nStatCount);
+    for (uint32_t nStatId = 0; nStatId < nStatCount; ++nStatId) {
+        statNames[nStatId] = ToJsonString(GetStatName(nStatId));
+    }
+    const uint32_t nCounterCount = PerformanceRegistry::Instance().GetCounterCount();
+    std::vector<std::string> counterNames(nCounterCount);
+    for (uint32_t nCounterId = 0; nCounterId < nCounterCount; ++nCounterId) {
+        counterNames[nCounterId] = ToJsonString(GetCounterName(nCounterId));
+    }
+
+    std::string json = "{\"traceEvents\":[";
+    bool bFirstEvent = true;
+    const std::vector<PerformanceThreadBuffer*> threadBuffers = PerformanceRegistry::Instance().GetThreadBuffers();
+    for (PerformanceThreadBuffer* pBuffer : threadBuffers) {
+        const PerformanceTraceEvent* pEvents = pBuffer->m_traceEvents.load(std::memory_order_acquire);
+        if (pEvents == nullptr) {
+            continue;
+        }
+        const uint64_t nEventCount = pBuffer->m_nTraceEventCount.load(std::memory_order_acquire);
+        const uint64_t nFirstEvent = (nEventCount > kMaxTraceEventCount) ? (nEventCount - kMaxTraceEventCount) : 0;
+        for (uint64_t nEvent = nFirstEvent; nEvent < nEventCount; ++nEvent) {
+            const PerformanceTraceEvent& traceEvent = pEvents[nEvent % kMaxTraceEventCount];
+            const uint32_t nStatId = traceEvent.m_nStatId.load(std::memory_order_relaxed);
+            char buf[128] = { 0 };
+            if (nStatId & kCounterEventFlag) {
+                //计数器事件：记录变化后的值
+                const uint32_t nCounterId = nStatId & ~kCounterEventFlag;
+                if (nCounterId >= nCounterCount) {
+                    continue;
+                }
+                snprintf(buf, sizeof(buf), ",\"ph\":\"C\",\"pid\":1,\"ts\":%lld,\"args\":{\"value\":%lld}}",
+                         (long long)traceEvent.m_nStartTime.load(std::memory_order_relaxed),
+                         (long long)traceEvent.m_nDuration.load(std::memory_order_relaxed));
+                if (!bFirstEvent) {
+                    json += ",";
+                }
+                bFirstEvent = false;
+                json += "\n{\"name\":";
+                json += counterNames[nCounterId];
+                json += buf;
+                continue;
+            }
+            if (nStatId >= nStatCount) {
+                continue;
+            }
+            snprintf(buf, sizeof(buf), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lld,\"dur\":%lld}",
+                     pBuffer->m_nBufferIndex,
+                     (long long)traceEvent.m_nStartTime.load(std::memory_order_relaxed),
+                     (long long)traceEvent.m_nDuration.load(std::memory_order_relaxed));
+            if (!bFirstEvent) {
+                json += ",";
+            }
+            bFirstEvent = false;
+            json += "\n{\"name\":";
+            json += statNames[nStatId];
+            json += buf;
+        }
+    }
+    //导出时各个计数器的当前值（未开启事件跟踪时，也可以看到计数器的值）
+    const int64_t nNow = GetTimestamp();
+    for (uint32_t nCounterId = 0; nCounterId < nCounterCount; ++nCounterId) {
+        char buf[128] = { 0 };
+        snprintf(buf, sizeof(buf), ",\"ph\":\"C\",\"pid\":1,\"ts\":%lld,\"args\":{\"value\":%lld}}",
+                 (long long)nNow, (long long)GetCounterValue(nCounterId));
+        if (!bFirstEvent) {
+            json += ",";
+        }
+        bFirstEvent = false;
+        json += "\n{\"name\":";
+        json += counterNames[nCounterId];
+        json += buf;
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return json;
+}
+
+bool PerformanceUtil::ExportChromeTrace(const FilePath& filePath)
+{
+    return FileUtil::WriteFileData(filePath, GetChromeTraceJson());
+}
+
+void PerformanceUtil::OutputStatLog()
+{
+    std::vector<StatSnapshot> snapshot;
+    GetSnapshot(snapshot, false);
+    for (const StatSnapshot& stat : snapshot) {
+        DString log = StringUtil::Printf(_T("%s(%d): %d ms, average: %d us, p50: %d us, p99: %d us, max: %d us"),
+                                         stat.m_name.c_str(),
+                                         (int32_t)stat.m_nCount,
+                                         (int32_t)(stat.m_nTotalTime / 1000),
+                                         (int32_t)(stat.m_nTotalTime / (int64_t)stat.m_nCount),
+                                         (int32_t)stat.m_nP50Time,
+                                         (int32_t)stat.m_nP99Time,
+                                         (int32_t)stat.m_nMaxTime);
+        LogUtil::OutputLine(log);
+    }
+    const uint32_t nCounterCount = PerformanceRegistry::Instance().GetCounterCount();
+    for (uint32_t nCounterId = 0; nCounterId < nCounterCount; ++nCounterId) {
+        DString log = StringUtil::Printf(_T("%s: %lld"), GetCounterName(nCounterId).c_str(),
+                                         (long long)GetCounterValue(nCounterId));
+        LogUtil::OutputLine(log);
+    }
 }
 
 }
@@ -2,78 +2,274 @@
 #define UI_UTILS_PERFORMANCE_UTIL_H_
 
 #include "duilib/duilib_defs.h"
+#include "duilib/Utils/FilePath.h"
 #include <string>
-#include <map>
-#include <chrono>
-#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <cstdint>
 
-namespace ui 
+namespace ui
 {
-
-/** 代码执行性能分析工具
+/** 代码执行性能分析工具（线程安全）
+*   1. 统计项在首次使用时注册，得到整型ID，此后按ID记录数据，无需字符串查找
+*   2. 每个线程独立记录数据（每线程缓冲区，记录时无锁），读取时汇总所有线程的数据
+*   3. 每个统计项记录次数、总耗时、最大耗时，以及耗时分布直方图（用于计算p50/p99）
+*   4. 支持运行时开关，关闭时PerformanceStat只有一次原子变量读取的开销
+*   5. 开启事件跟踪后，可导出Chrome Trace格式（chrome://tracing 或 Perfetto）的JSON文件
+*   6. 计数器：首次使用时注册，得到整型ID，按ID累加数值（原子操作），可用于统计次数或者当前数量（如队列深度）
 */
 class UILIB_API PerformanceUtil
 {
 public:
     PerformanceUtil();
     ~PerformanceUtil();
+    PerformanceUtil(const PerformanceUtil&) = delete;
+    PerformanceUtil& operator = (const PerformanceUtil&) = delete;
 
     /** 单例对象
     */
     static PerformanceUtil& Instance();
 
-    /** 代码开始执行，开始计时
+    /** 无效的统计项ID
+    */
+    static constexpr uint32_t kInvalidStatId = (uint32_t)-1;
+
+    /** 统计项的最大个数
+    */
+    static constexpr uint32_t kMaxStatCount = 512;
+
+    /** 计数器的最大个数
+    */
+    static constexpr uint32_t kMaxCounterCount = 256;
+
+public:
+    /** 设置是否开启性能统计（默认：Debug版本开启，Release版本关闭）
+    */
+    static void SetEnabled(bool bEnabled);
+
+    /** 判断是否开启了性能统计
+    */
+    static bool IsEnabled() { return s_bEnabled.load(std::memory_order_relaxed); }
+
+    /** 设置是否开启事件跟踪（记录每次执行的开始时间和耗时，用于导出Chrome Trace格式的数据），默认关闭
+    *   每个线程保留最近的kMaxTraceEventCount个事件
+    */
+    static void SetTraceEnabled(bool bEnabled);
+
+    /** 判断是否开启了事件跟踪
+    */
+    static bool IsTraceEnabled() { return s_bTraceEnabled.load(std::memory_order_relaxed); }
+
+    /** 每个线程保留的跟踪事件个数
+    */
+    static constexpr uint32_t kMaxTraceEventCount = 16384;
+
+    /** 注册统计项，返回统计项ID（同名的统计项返回相同的ID）
+    * @param [in] name 统计项的名称
+    * @return 返回统计项ID，如果统计项个数超过上限，返回kInvalidStatId
+    */
+    uint32_t RegisterStat(const DString& name);
+
+    /** 获取当前时间戳（微秒，从进程启动开始计时）
+    */
+    static int64_t GetTimestamp();
+
+    /** 记录一次执行数据
+    * @param [in] nStatId 统计项ID
+    * @param [in] nStartTime 开始时间戳（微秒，由GetTimestamp返回）
+    * @param [in] nDuration 执行耗时（微秒）
+    */
+    void AddSample(uint32_t nStatId, int64_t nStartTime, int64_t nDuration);
+
+    /** 注册计数器，返回计数器ID（同名的计数器返回相同的ID）
+    * @param [in] name 计数器的名称
+    * @return 返回计数器ID，如果计数器个数超过上限，返回kInvalidStatId
+    */
+    uint32_t RegisterCounter(const DString& name);
+
+    /** 累加计数器的值（不受SetEnabled开关控制，始终计数，以保证当前数量类的计数器准确）
+    *   开启事件跟踪时，同时记录计数器的变化，导出为Chrome Trace的计数器事件
+    * @param [in] nCounterId 计数器ID
+    * @param [in] nValue 累加的值，可以为负数
+    */
+    void AddCounter(uint32_t nCounterId, int64_t nValue);
+
+    /** 获取计数器的当前值
+    * @param [in] nCounterId 计数器ID
+    */
+    int64_t GetCounterValue(uint32_t nCounterId) const;
+
+    /** 代码开始执行，开始计时（兼容旧接口，按名称查找统计项，有额外开销，建议使用PerformanceStat）
     * @param [in] name 统计项的名称
     */
     void BeginStat(const DString& name);
 
-    /** 代码结束执行，统计执行性能
+    /** 代码结束执行，统计执行性能（兼容旧接口，必须与BeginStat在同一个线程中调用）
     * @param [in] name 统计项的名称
     */
     void EndStat(const DString& name);
-    
-private:
-    /** 记录每项统计的结果
+
+public:
+    /** 统计项的快照数据（时间单位：微秒）
     */
-    struct TStat
+    struct StatSnapshot
     {
-        //是否有开始数据
-        int32_t nStartRefCount = 0;
+        uint32_t m_nStatId = 0;     //统计项ID
+        DString m_name;             //统计项的名称
+        uint64_t m_nCount = 0;      //执行次数
+        int64_t m_nTotalTime = 0;   //总耗时
+        int64_t m_nMaxTime = 0;     //单次最大耗时
+        int64_t m_nP50Time = 0;     //耗时的中位数（p50，按直方图估算）
+        int64_t m_nP99Time = 0;     //耗时的99分位数（p99，按直方图估算）
+    };
 
-        //开始时间
-        std::chrono::steady_clock::time_point startTime;
+    /** 计数器的快照数据
+    */
+    struct CounterSnapshot
+    {
+        uint32_t m_nCounterId = 0;  //计数器ID
+        DString m_name;             //计数器的名称
+        int64_t m_nValue = 0;       //当前值
+    };
 
-        //结束时间
-        std::chrono::steady_clock::time_point endTime;
+    /** 获取所有统计项的快照（汇总所有线程的数据），可定时调用，用于在程序内部展示性能数据
+    * @param [out] snapshot 返回有数据的统计项
+    * @param [in] bReset 获取后是否清零统计数据（用于按时间段统计）
+    */
+    void GetSnapshot(std::vector<StatSnapshot>& snapshot, bool bReset = false);
 
-        //代码执行总时间：微秒(千分之一毫秒)
-        std::chrono::microseconds totalTimes = std::chrono::microseconds::zero();
+    /** 获取所有统计项和计数器的快照
+    * @param [out] snapshot 返回有数据的统计项
+    * @param [out] counters 返回所有已注册的计数器
+    * @param [in] bReset 获取后是否清零统计项的数据（计数器记录的可能是当前数量，不清零）
+    */
+    void GetSnapshot(std::vector<StatSnapshot>& snapshot, std::vector<CounterSnapshot>& counters, bool bReset = false);
 
-        //统计总次数
-        uint32_t totalCount = 0;
+    /** 清零所有统计数据和跟踪事件（计数器不清零）
+    */
+    void Reset();
 
-        /** 单次最大：：微秒(千分之一毫秒)
-        */
-        std::chrono::microseconds maxTime = std::chrono::microseconds::zero();
-    };
+    /** 导出跟踪事件，格式为Chrome Trace Event JSON（UTF8编码）
+    */
+    std::string GetChromeTraceJson();
+
+    /** 导出跟踪事件到文件，格式为Chrome Trace Event JSON（UTF8编码）
+    */
+    bool ExportChromeTrace(const FilePath& filePath);
 
-    std::map<DString, TStat> m_stat;
+    /** 将所有统计项的汇总数据输出到日志
+    */
+    void OutputStatLog();
+
+private:
+    /** 获取统计项的名称
+    */
+    DString GetStatName(uint32_t nStatId) const;
+
+    /** 获取计数器的名称
+    */
+    DString GetCounterName(uint32_t nCounterId) const;
+
+private:
+    /** 是否开启性能统计
+    */
+    static std::atomic<bool> s_bEnabled;
+
+    /** 是否开启事件跟踪
+    */
+    static std::atomic<bool> s_bTraceEnabled;
+};
+
+/** 统计项ID（一般定义为函数内的静态变量，只注册一次）
+*   举例：
+*       static const PerformanceStatId s_statId(_T("Render_Skia::DrawImage"));
+*       PerformanceStat statPerformance(s_statId);
+*/
+class PerformanceStatId
+{
+public:
+    explicit PerformanceStatId(const DString& statName):
+        m_nStatId(PerformanceUtil::Instance().RegisterStat(statName))
+    {
+    }
+    uint32_t GetId() const { return m_nStatId; }
+private:
+    uint32_t m_nStatId;
+};
+
+/** 计数器ID（一般定义为函数内或者文件内的静态变量，只注册一次）
+*   举例：
+*       static const PerformanceCounterId s_counterId(_T("FrameworkThread::PendingUiTasks"));
+*       s_counterId.Add(1);
+*/
+class PerformanceCounterId
+{
+public:
+    explicit PerformanceCounterId(const DString& counterName):
+        m_nCounterId(PerformanceUtil::Instance().RegisterCounter(counterName))
+    {
+    }
+    uint32_t GetId() const { return m_nCounterId; }
+
+    /** 累加计数器的值（原子操作）
+    */
+    void Add(int64_t nValue) const
+    {
+        PerformanceUtil::Instance().AddCounter(m_nCounterId, nValue);
+    }
+
+    /** 计数器加1
+    */
+    void Increment() const { Add(1); }
+
+    /** 计数器减1
+    */
+    void Decrement() const { Add(-1); }
+
+private:
+    uint32_t m_nCounterId;
 };
 
+/** 在作用域内统计代码执行性能
+*/
 class PerformanceStat
 {
 public:
+    explicit PerformanceStat(const PerformanceStatId& statId):
+        m_nStatId(PerformanceUtil::kInvalidStatId),
+        m_nStartTime(0)
+    {
+        if (PerformanceUtil::IsEnabled()) {
+            m_nStatId = statId.GetId();
+            m_nStartTime = PerformanceUtil::GetTimestamp();
+        }
+    }
+
+    /** 按名称统计（每次需要查找统计项，有额外开销，热点代码中应使用PerformanceStatId）
+    */
     explicit PerformanceStat(const DString& statName):
-        m_statName(statName)
+        m_nStatId(PerformanceUtil::kInvalidStatId),
+        m_nStartTime(0)
     {
-        PerformanceUtil::Instance().BeginStat(m_statName);
+        if (PerformanceUtil::IsEnabled()) {
+            m_nStatId = PerformanceUtil::Instance().RegisterStat(statName);
+            m_nStartTime = PerformanceUtil::GetTimestamp();
+        }
     }
+
     ~PerformanceStat()
     {
-        PerformanceUtil::Instance().EndStat(m_statName);
+        if (m_nStatId != PerformanceUtil::kInvalidStatId) {
+            PerformanceUtil::Instance().AddSample(m_nStatId, m_nStartTime, PerformanceUtil::GetTimestamp() - m_nStartTime);
+        }
     }
+
+    PerformanceStat(const PerformanceStat&) = delete;
+    PerformanceStat& operator = (const PerformanceStat&) = delete;
+
 private:
-    DString m_statName;
+    uint32_t m_nStatId;
+    int64_t m_nStartTime;
 };
 
 }
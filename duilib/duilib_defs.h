@@ -247,6 +247,14 @@ namespace ui
         kCursorNo           // 不可用, XML文件中的名字："no"
     };
 
+    //控件绘制缓存的类型（启用绘制缓存时有效）
+    enum class ControlCacheMode : uint8_t
+    {
+        kCacheModeAuto,     // 自动选择：有背景图片或者状态图片时使用位图缓存，否则使用显示列表缓存, XML文件中的名字："auto"
+        kCacheModeBitmap,   // 位图缓存：保存绘制结果的像素数据，适合图片较多的控件, XML文件中的名字："bitmap"
+        kCacheModePicture   // 显示列表缓存：保存绘制命令，占用内存少，适合以文字、填充、边框为主的控件, XML文件中的名字："picture"
+    };
+
     //窗口退出参数
     enum WindowCloseParam
     {
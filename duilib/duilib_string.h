@@ -7,6 +7,7 @@
 
 //字符串类
 #include <string>
+#include <string_view>
 #include <cstring>
 
 /** Unicode版本的字符串宏定义
@@ -90,4 +91,12 @@ typedef std::string  DStringA;
     typedef std::string   DString;
 #endif
 
+/** String 视图类型（与DString的字符类型相同，不复制字符串数据）
+*/
+#ifdef DUILIB_UNICODE
+    typedef std::wstring_view  DStringView;
+#else
+    typedef std::string_view   DStringView;
+#endif
+
 #endif //DUILIB_STRING_H_
@@ -0,0 +1,30 @@
+#ifndef EXAMPLES_BENCH_FORM_H_
+#define EXAMPLES_BENCH_FORM_H_
+
+// duilib
+#include "duilib/duilib.h"
+
+/** 性能测试使用的窗口：加载指定的布局文件，不包含任何业务逻辑
+*/
+class BenchForm : public ui::WindowImplBase
+{
+public:
+    BenchForm(const DString& skinFolder, const DString& skinFile);
+    virtual ~BenchForm() override;
+
+    /** 窗口皮肤资源路径和XML描述文件，由构造函数传入
+    */
+    virtual DString GetSkinFolder() override;
+    virtual DString GetSkinFile() override;
+
+private:
+    /** 皮肤资源路径
+    */
+    DString m_skinFolder;
+
+    /** 布局文件名
+    */
+    DString m_skinFile;
+};
+
+#endif //EXAMPLES_BENCH_FORM_H_
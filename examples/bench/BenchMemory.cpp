@@ -0,0 +1,186 @@
+#include "BenchMemory.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+namespace
+{
+/** 堆内存统计：当前已分配的字节数和内存块数
+*/
+std::atomic<int64_t> g_nHeapBytes(0);
+std::atomic<int64_t> g_nHeapAllocs(0);
+
+/** 累计分配的字节数和内存块数（释放时不减少）
+*/
+std::atomic<int64_t> g_nTotalBytes(0);
+std::atomic<int64_t> g_nTotalAllocs(0);
+
+/** 每个内存块前面保存分配的字节数（保持malloc的对齐方式）
+*/
+constexpr size_t kHeapHeaderSize = alignof(std::max_align_t);
+
+/** 批量创建控件，统计新增的堆内存
+*/
+template<typename T>
+BenchMemoryResult MeasureControls(const std::string& name, size_t nCount,
+                                  const std::function<void(T* pControl)>& initControl)
+{
+    std::vector<T*> controls;
+    controls.reserve(nCount);
+
+    int64_t nStartBytes = 0;
+    int64_t nStartAllocs = 0;
+    BenchMemory::GetHeapStat(nStartBytes, nStartAllocs);
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+        T* pControl = new T(nullptr);
+        if (initControl != nullptr) {
+            initControl(pControl);
+        }
+        controls.push_back(pControl);
+    }
+    int64_t nEndBytes = 0;
+    int64_t nEndAllocs = 0;
+    BenchMemory::GetHeapStat(nEndBytes, nEndAllocs);
+
+    for (T* pControl : controls) {
+        delete pControl;
+    }
+
+    BenchMemoryResult result;
+    result.m_name = name;
+    result.m_nCount = nCount;
+    result.m_nSizeOf = sizeof(T);
+    result.m_nHeapBytes = nEndBytes - nStartBytes;
+    result.m_nHeapAllocs = nEndAllocs - nStartAllocs;
+    return result;
+}
+}
+
+void* operator new(std::size_t nSize)
+{
+    void* p = std::malloc(nSize + kHeapHeaderSize);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(p) = nSize;
+    g_nHeapBytes += (int64_t)nSize;
+    ++g_nHeapAllocs;
+    g_nTotalBytes += (int64_t)nSize;
+    ++g_nTotalAllocs;
+    return static_cast<char*>(p) + kHeapHeaderSize;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p == nullptr) {
+        return;
+    }
+    char* pBase = static_cast<char*>(p) - kHeapHeaderSize;
+    g_nHeapBytes -= (int64_t)*reinterpret_cast<size_t*>(pBase);
+    --g_nHeapAllocs;
+    std::free(pBase);
+}
+
+void operator delete(void* p, std::size_t /*nSize*/) noexcept
+{
+    operator delete(p);
+}
+
+BenchRetainedResult BenchMemory::RunRuntimeNames(size_t nCount)
+{
+    BenchRetainedResult result;
+    result.m_name = "memory.runtime_names";
+    result.m_nCount = nCount;
+    result.m_nAtomsBefore = ui::AtomTable::GetAtomCount();
+
+    int64_t nStartBytes = 0;
+    int64_t nStartAllocs = 0;
+    GetHeapStat(nStartBytes, nStartAllocs);
+    int64_t nStartTotalBytes = 0;
+    int64_t nStartTotalAllocs = 0;
+    GetTotalAllocStat(nStartTotalBytes, nStartTotalAllocs);
+    std::vector<ui::Control*> controls;
+    controls.reserve(nCount);
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+        ui::Control* pControl = new ui::Control(nullptr);
+        pControl->SetName(ui::StringUtil::Printf(_T("runtime_item_%d"), (int32_t)nIndex));
+        controls.push_back(pControl);
+    }
+    int64_t nLiveBytes = 0;
+    int64_t nLiveAllocs = 0;
+    GetHeapStat(nLiveBytes, nLiveAllocs);
+    int64_t nTotalBytes = 0;
+    int64_t nTotalAllocs = 0;
+    GetTotalAllocStat(nTotalBytes, nTotalAllocs);
+    for (ui::Control* pControl : controls) {
+        delete pControl;
+    }
+    //释放控件指针数组，使其不计入保留的内存
+    std::vector<ui::Control*>().swap(controls);
+    int64_t nEndBytes = 0;
+    int64_t nEndAllocs = 0;
+    GetHeapStat(nEndBytes, nEndAllocs);
+
+    result.m_nLiveBytes = nLiveBytes - nStartBytes;
+    result.m_nLiveAllocs = nLiveAllocs - nStartAllocs;
+    result.m_nRetainedBytes = nEndBytes - nStartBytes;
+    result.m_nRetainedAllocs = nEndAllocs - nStartAllocs;
+    result.m_nTotalBytes = nTotalBytes - nStartTotalBytes;
+    result.m_nTotalAllocs = nTotalAllocs - nStartTotalAllocs;
+    result.m_nAtomsAfter = ui::AtomTable::GetAtomCount();
+    return result;
+}
+
+void BenchMemory::GetHeapStat(int64_t& nBytes, int64_t& nAllocs)
+{
+    nBytes = g_nHeapBytes;
+    nAllocs = g_nHeapAllocs;
+}
+
+void BenchMemory::GetTotalAllocStat(int64_t& nBytes, int64_t& nAllocs)
+{
+    nBytes = g_nTotalBytes;
+    nAllocs = g_nTotalAllocs;
+}
+
+std::vector<BenchMemoryResult> BenchMemory::Run(size_t nCount, const std::function<bool(const std::string&)>& filter)
+{
+    std::vector<BenchMemoryResult> results;
+    auto addResult = [&results, &filter](const std::string& name, const std::function<BenchMemoryResult()>& measure) {
+            if ((filter == nullptr) || filter(name)) {
+                results.push_back(measure());
+            }
+        };
+
+    //未设置属性的控件
+    addResult("memory.control", [nCount]() {
+            return MeasureControls<ui::Control>("memory.control", nCount, nullptr);
+        });
+    addResult("memory.box", [nCount]() {
+            return MeasureControls<ui::Box>("memory.box", nCount, nullptr);
+        });
+    addResult("memory.label", [nCount]() {
+            return MeasureControls<ui::Label>("memory.label", nCount, nullptr);
+        });
+    addResult("memory.button", [nCount]() {
+            return MeasureControls<ui::Button>("memory.button", nCount, nullptr);
+        });
+
+    //设置了常用属性的控件：文本和点击事件
+    addResult("memory.label.configured", [nCount]() {
+            return MeasureControls<ui::Label>("memory.label.configured", nCount, [](ui::Label* pLabel) {
+                    pLabel->SetText(_T("Label"));
+                });
+        });
+    addResult("memory.button.configured", [nCount]() {
+            return MeasureControls<ui::Button>("memory.button.configured", nCount, [](ui::Button* pButton) {
+                    pButton->SetText(_T("Button"));
+                    pButton->AttachClick([](const ui::EventArgs&) {
+                            return true;
+                        });
+                });
+        });
+    return results;
+}
@@ -0,0 +1,68 @@
+#ifndef EXAMPLES_BENCH_MEMORY_H_
+#define EXAMPLES_BENCH_MEMORY_H_
+
+// duilib
+#include "duilib/duilib.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/** 控件内存占用的测试结果
+*/
+struct BenchMemoryResult
+{
+    std::string m_name;         //测试名称，格式为："memory.控件类型"或者"memory.控件类型.configured"（设置了常用属性）
+    size_t m_nCount = 0;        //创建的控件数量
+    size_t m_nSizeOf = 0;       //控件对象的大小（sizeof）
+    int64_t m_nHeapBytes = 0;   //创建控件后，新增的堆内存字节数（包含控件对象本身，不含分配器的额外开销）
+    int64_t m_nHeapAllocs = 0;  //创建控件后，新增的堆内存块数
+};
+
+/** 重复创建和销毁对象的内存测试结果：检查对象销毁后，堆内存和原子表是否持续增长
+*/
+struct BenchRetainedResult
+{
+    std::string m_name;             //测试名称，格式为："<样例名称>.build_xml"等（窗口），或者"memory.runtime_names"（控件）
+    size_t m_nCount = 0;            //创建的对象数量
+    int64_t m_nLiveBytes = 0;       //对象存在期间新增的堆内存字节数（所有对象的合计值）
+    int64_t m_nLiveAllocs = 0;      //对象存在期间新增的堆内存块数（所有对象的合计值）
+    int64_t m_nRetainedBytes = 0;   //全部对象销毁后，仍然新增的堆内存字节数（包含各种缓存）
+    int64_t m_nRetainedAllocs = 0;  //全部对象销毁后，仍然新增的堆内存块数
+    int64_t m_nTotalBytes = 0;      //创建对象过程中累计分配的堆内存字节数（含已释放的临时内存，所有对象的合计值）
+    int64_t m_nTotalAllocs = 0;     //创建对象过程中累计分配的堆内存块数（含已释放的临时内存，所有对象的合计值）
+    size_t m_nAtomsBefore = 0;      //测试前原子表中的原子个数
+    size_t m_nAtomsAfter = 0;       //全部对象销毁后原子表中的原子个数
+};
+
+/** 控件内存占用测试：批量创建控件，统计每个控件占用的堆内存
+*   通过替换全局的 operator new/operator delete 统计堆内存（仅统计本程序的C++内存分配）
+*/
+class BenchMemory
+{
+public:
+    /** 运行所有匹配的内存测试
+    * @param [in] nCount 每项测试创建的控件数量
+    * @param [in] filter 判断测试是否需要运行的函数，参数为测试名称
+    */
+    static std::vector<BenchMemoryResult> Run(size_t nCount, const std::function<bool(const std::string&)>& filter);
+
+    /** 运行时生成名称的测试：创建控件并设置各不相同的名称（比如列表项的名称），全部销毁后检查原子表是否增长
+    * @param [in] nCount 创建的控件数量
+    */
+    static BenchRetainedResult RunRuntimeNames(size_t nCount);
+
+    /** 获取当前的堆内存统计数据
+    * @param [out] nBytes 当前已分配的堆内存字节数
+    * @param [out] nAllocs 当前已分配的堆内存块数
+    */
+    static void GetHeapStat(int64_t& nBytes, int64_t& nAllocs);
+
+    /** 获取累计的堆内存分配数据（只增不减，两次调用的差值即为期间的分配次数和字节数）
+    * @param [out] nBytes 累计分配的堆内存字节数
+    * @param [out] nAllocs 累计分配的堆内存块数
+    */
+    static void GetTotalAllocStat(int64_t& nBytes, int64_t& nAllocs);
+};
+
+#endif //EXAMPLES_BENCH_MEMORY_H_
@@ -0,0 +1,993 @@
+#include "BenchRunner.h"
+#include "BenchForm.h"
+#include "duilib/Core/MessageLoop_SDL.h"
+#include "duilib/Core/InputRecorder_SDL.h"
+#include "duilib/Core/CompiledLayout.h"
+#include "duilib/Core/WindowBuilder.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Control/ColorConvert.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+namespace
+{
+/** 事件分发测试用的控件树：一条深层的容器链，事件从最内层控件发出，逐级冒泡到根容器
+*/
+class BenchEventTree
+{
+public:
+    explicit BenchEventTree(size_t nDepth):
+        m_pRoot(nullptr),
+        m_pLeaf(nullptr),
+        m_nEventCount(0)
+    {
+        m_pRoot = new ui::Box(nullptr);
+        ui::Box* pParent = m_pRoot;
+        for (size_t nIndex = 0; nIndex < nDepth; ++nIndex) {
+            ui::Box* pBox = new ui::Box(nullptr);
+            pParent->AddItem(pBox);
+            pParent = pBox;
+        }
+        m_pLeaf = new ui::Control(nullptr);
+        pParent->AddItem(m_pLeaf);
+
+        //只有根容器监听一个冒泡事件，其余控件均无监听者
+        m_pRoot->AttachBubbledEvent(ui::kEventValueChange, [this](const ui::EventArgs&) {
+                ++m_nEventCount;
+                return true;
+            });
+    }
+
+    ~BenchEventTree()
+    {
+        delete m_pRoot;
+    }
+
+    BenchEventTree(const BenchEventTree&) = delete;
+    BenchEventTree& operator = (const BenchEventTree&) = delete;
+
+    /** 发送事件：一个无监听者的事件，一个根容器有监听者的事件
+    */
+    void DispatchEvents(size_t nCount)
+    {
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+            m_pLeaf->SendEvent(ui::kEventTextChange);
+            m_pLeaf->SendEvent(ui::kEventValueChange);
+        }
+    }
+
+private:
+    ui::Box* m_pRoot;
+    ui::Control* m_pLeaf;
+    size_t m_nEventCount;
+};
+
+/** 虚表的数据提供者：固定数量的数据项，使用 virtual_list_box/item.xml 创建子项
+*/
+class BenchListProvider : public ui::VirtualListBoxElement
+{
+public:
+    explicit BenchListProvider(size_t nElementCount):
+        m_selected(nElementCount, false)
+    {
+    }
+
+    virtual ui::Control* CreateElement(ui::VirtualListBox* pVirtualListBox) override
+    {
+        ASSERT(pVirtualListBox != nullptr);
+        if (pVirtualListBox == nullptr) {
+            return nullptr;
+        }
+        ui::ListBoxItem* pItem = new ui::ListBoxItem(pVirtualListBox->GetWindow());
+        ui::GlobalManager::Instance().FillBoxWithCache(pItem, ui::FilePath(_T("virtual_list_box/item.xml")));
+        return pItem;
+    }
+
+    virtual bool FillElement(ui::Control* pControl, size_t nElementIndex) override
+    {
+        ui::ListBoxItem* pItem = dynamic_cast<ui::ListBoxItem*>(pControl);
+        if ((pItem == nullptr) || (nElementIndex >= m_selected.size())) {
+            return false;
+        }
+        ui::Control* pImage = pItem->FindSubControl(_T("control_img"));
+        if (pImage != nullptr) {
+            pImage->SetBkImage(_T("icon.png"));
+        }
+        ui::Label* pTitle = dynamic_cast<ui::Label*>(pItem->FindSubControl(_T("label_title")));
+        if (pTitle != nullptr) {
+            pTitle->SetText(ui::StringUtil::Printf(_T("任务 [%d]"), (int32_t)nElementIndex));
+        }
+        return true;
+    }
+
+    virtual size_t GetElementCount() const override
+    {
+        return m_selected.size();
+    }
+
+    virtual void SetElementSelected(size_t nElementIndex, bool bSelected) override
+    {
+        if (nElementIndex < m_selected.size()) {
+            m_selected[nElementIndex] = bSelected;
+        }
+    }
+
+    virtual bool IsElementSelected(size_t nElementIndex) const override
+    {
+        return (nElementIndex < m_selected.size()) ? m_selected[nElementIndex] : false;
+    }
+
+    virtual void GetSelectedElements(std::vector<size_t>& selectedIndexs) const override
+    {
+        selectedIndexs.clear();
+        for (size_t nIndex = 0; nIndex < m_selected.size(); ++nIndex) {
+            if (m_selected[nIndex]) {
+                selectedIndexs.push_back(nIndex);
+            }
+        }
+    }
+
+    virtual bool IsMultiSelect() const override
+    {
+        return false;
+    }
+
+    virtual void SetMultiSelect(bool /*bMultiSelect*/) override
+    {
+    }
+
+private:
+    /** 每个数据项的选择状态
+    */
+    std::vector<bool> m_selected;
+};
+
+/** 将耗时数据的统计值输出为JSON对象
+*/
+void AppendTimeStatJson(std::string& json, const char* name, std::vector<int64_t> values)
+{
+    int64_t nTotal = 0;
+    for (int64_t nValue : values) {
+        nTotal += nValue;
+    }
+    std::sort(values.begin(), values.end());
+    int64_t nMean = 0;
+    int64_t nP50 = 0;
+    int64_t nP99 = 0;
+    int64_t nMax = 0;
+    if (!values.empty()) {
+        nMean = nTotal / (int64_t)values.size();
+        nP50 = values[(values.size() - 1) * 50 / 100];
+        nP99 = values[(values.size() - 1) * 99 / 100];
+        nMax = values.back();
+    }
+    char buf[256] = { 0 };
+    snprintf(buf, sizeof(buf), "\"%s\":{\"mean\":%lld,\"p50\":%lld,\"p99\":%lld,\"max\":%lld}",
+             name, (long long)nMean, (long long)nP50, (long long)nP99, (long long)nMax);
+    json += buf;
+}
+
+/** 转义JSON字符串中的特殊字符（名称中可能含有文件路径）
+*/
+std::string EscapeJsonString(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char ch : value) {
+        switch (ch) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if ((unsigned char)ch < 0x20) {
+                char buf[8] = { 0 };
+                snprintf(buf, sizeof(buf), "\\u%04x", (unsigned int)(unsigned char)ch);
+                escaped += buf;
+            }
+            else {
+                escaped += ch;
+            }
+            break;
+        }
+    }
+    return escaped;
+}
+
+} //namespace
+
+BenchRunner::BenchRunner(const BenchOptions& options):
+    m_options(options),
+    m_nLayoutStatId(ui::PerformanceUtil::kInvalidStatId),
+    m_nPaintStatId(ui::PerformanceUtil::kInvalidStatId),
+    m_nPresentStatId(ui::PerformanceUtil::kInvalidStatId)
+{
+    if (m_options.m_nFrames < 1) {
+        m_options.m_nFrames = 1;
+    }
+}
+
+BenchRunner::~BenchRunner()
+{
+}
+
+std::vector<BenchSample> BenchRunner::GetSamples()
+{
+    std::vector<BenchSample> samples;
+
+    //ListCtrl：Report模式，9列，2000行
+    BenchSample listCtrl;
+    listCtrl.m_name = "list_ctrl";
+    listCtrl.m_skinFolder = _T("list_ctrl");
+    listCtrl.m_skinFile = _T("list_ctrl.xml");
+    listCtrl.m_targetName = _T("list_ctrl");
+    listCtrl.m_fillData = [](ui::Window* /*pWindow*/, ui::Control* pTarget) {
+            ui::ListCtrl* pListCtrl = dynamic_cast<ui::ListCtrl*>(pTarget);
+            if (pListCtrl == nullptr) {
+                return;
+            }
+            const size_t columnCount = 9;
+            const size_t rowCount = 2000;
+            for (size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+                ui::ListCtrlColumn columnInfo;
+                columnInfo.nColumnWidth = 200;
+                columnInfo.text = ui::StringUtil::Printf(_T("第 %d 列"), (int32_t)columnIndex);
+                pListCtrl->InsertColumn(-1, columnInfo);
+            }
+            pListCtrl->SetDataItemCount(rowCount);
+            for (size_t itemIndex = 0; itemIndex < rowCount; ++itemIndex) {
+                for (size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+                    ui::ListCtrlSubItemData subItemData;
+                    subItemData.text = ui::StringUtil::Printf(_T("第 %04d 行/第 %02d 列"), (int32_t)itemIndex, (int32_t)columnIndex);
+                    pListCtrl->SetSubItemData(itemIndex, columnIndex, subItemData);
+                }
+            }
+        };
+    samples.push_back(listCtrl);
+
+    //VirtualListBox：10万个数据项
+    BenchSample virtualListBox;
+    virtualListBox.m_name = "virtual_list_box";
+    virtualListBox.m_skinFolder = _T("virtual_list_box");
+    virtualListBox.m_skinFile = _T("main.xml");
+    virtualListBox.m_targetName = _T("list");
+    std::shared_ptr<BenchListProvider> spProvider = std::make_shared<BenchListProvider>(100000);
+    virtualListBox.m_fillData = [spProvider](ui::Window* /*pWindow*/, ui::Control* pTarget) {
+            ui::VirtualListBox* pListBox = dynamic_cast<ui::VirtualListBox*>(pTarget);
+            if (pListBox != nullptr) {
+                pListBox->SetDataProvider(spProvider.get());
+            }
+        };
+    samples.push_back(virtualListBox);
+
+    //RichEdit：2000行文本
+    BenchSample richEdit;
+    richEdit.m_name = "rich_edit";
+    richEdit.m_skinFolder = _T("rich_edit");
+    richEdit.m_skinFile = _T("rich_edit.xml");
+    richEdit.m_targetName = _T("rich_edit");
+    richEdit.m_fillData = [](ui::Window* /*pWindow*/, ui::Control* pTarget) {
+            ui::RichEdit* pRichEdit = dynamic_cast<ui::RichEdit*>(pTarget);
+            if (pRichEdit == nullptr) {
+                return;
+            }
+            DString text;
+            for (int32_t nLine = 0; nLine < 2000; ++nLine) {
+                text += ui::StringUtil::Printf(_T("第 %04d 行：RichEdit performance test, 性能测试文本 0123456789 abcdefghijklmnopqrstuvwxyz\n"), nLine);
+            }
+            pRichEdit->SetText(text);
+        };
+    samples.push_back(richEdit);
+
+    //TreeView：100个一级节点，每个节点20个子节点
+    BenchSample treeView;
+    treeView.m_name = "tree_view";
+    treeView.m_skinFolder = _T("tree_view");
+    treeView.m_skinFile = _T("tree_view.xml");
+    treeView.m_targetName = _T("tree");
+    treeView.m_fillData = [](ui::Window* pWindow, ui::Control* pTarget) {
+            ui::TreeView* pTreeView = dynamic_cast<ui::TreeView*>(pTarget);
+            if ((pTreeView == nullptr) || (pTreeView->GetRootNode() == nullptr)) {
+                return;
+            }
+            for (int32_t nIndex = 0; nIndex < 100; ++nIndex) {
+                ui::TreeNode* pNode = new ui::TreeNode(pWindow);
+                pNode->SetClass(_T("tree_node"));
+                pNode->SetText(ui::StringUtil::Printf(_T("节点 %d"), nIndex));
+                pTreeView->GetRootNode()->AddChildNode(pNode);
+                for (int32_t nChild = 0; nChild < 20; ++nChild) {
+                    ui::TreeNode* pChildNode = new ui::TreeNode(pWindow);
+                    pChildNode->SetClass(_T("tree_node"));
+                    pChildNode->SetText(ui::StringUtil::Printf(_T("节点 %d-%d"), nIndex, nChild));
+                    pNode->AddChildNode(pChildNode);
+                }
+            }
+        };
+    samples.push_back(treeView);
+    return samples;
+}
+
+std::vector<BenchKernel> BenchRunner::GetKernels()
+{
+    std::vector<BenchKernel> kernels;
+
+    //取色板（ColorControl）：512*512的HSV色相/饱和度平面
+    const int32_t nWidth = 512;
+    const int32_t nHeight = 512;
+    std::shared_ptr<std::vector<uint32_t>> spPixels = std::make_shared<std::vector<uint32_t>>((size_t)nWidth * nHeight);
+
+    //逐行调用HSV_HUE（原有的生成方式）
+    BenchKernel hsvPlaneRows;
+    hsvPlaneRows.m_name = "kernel.hsv_plane_rows";
+    hsvPlaneRows.m_func = [spPixels, nWidth, nHeight]() {
+            uint32_t* pData = spPixels->data();
+            for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
+                ui::ColorConvert::HSV_HUE(pData + (size_t)nRow * nWidth, nWidth, 1.0 - (double)nRow / (nHeight - 1), 1.0);
+            }
+        };
+    kernels.push_back(hsvPlaneRows);
+
+    //生成第一行后，其余各行调用HSV_HUE_SAT
+    BenchKernel hsvPlaneSat;
+    hsvPlaneSat.m_name = "kernel.hsv_plane_sat";
+    hsvPlaneSat.m_func = [spPixels, nWidth, nHeight]() {
+            uint32_t* pData = spPixels->data();
+            ui::ColorConvert::HSV_HUE(pData, nWidth, 1.0, 1.0);
+            for (int32_t nRow = 1; nRow < nHeight; ++nRow) {
+                ui::ColorConvert::HSV_HUE_SAT(pData + (size_t)nRow * nWidth, pData, nWidth, 1.0 - (double)nRow / (nHeight - 1));
+            }
+        };
+    kernels.push_back(hsvPlaneSat);
+
+    //颜色滑块（ColorSlider）：HSL色相行、ARGB渐变行
+    BenchKernel hslHueRow;
+    hslHueRow.m_name = "kernel.hsl_hue_row";
+    hslHueRow.m_func = [spPixels, nWidth]() {
+            ui::ColorConvert::HSL_HUE(spPixels->data(), nWidth, 1.0, 0.5);
+        };
+    kernels.push_back(hslHueRow);
+
+    BenchKernel argbRow;
+    argbRow.m_name = "kernel.argb_row";
+    argbRow.m_func = [spPixels, nWidth]() {
+            ui::ColorConvert::GetARGB(spPixels->data(), nWidth, 0x00FF8040, 0xFFFF8040);
+        };
+    kernels.push_back(argbRow);
+
+    //事件分发：64层的控件树，每帧从最内层控件发送事件并冒泡到根容器（控件树在首次调用时创建）
+    std::shared_ptr<std::unique_ptr<BenchEventTree>> spEventTree = std::make_shared<std::unique_ptr<BenchEventTree>>();
+    BenchKernel eventDispatch;
+    eventDispatch.m_name = "kernel.event_dispatch";
+    eventDispatch.m_func = [spEventTree]() {
+            if (*spEventTree == nullptr) {
+                *spEventTree = std::make_unique<BenchEventTree>(64);
+            }
+            (*spEventTree)->DispatchEvents(1000);
+        };
+    kernels.push_back(eventDispatch);
+
+    //按名称查找控件时的原子查找（ControlFinder::FindControl2）：1000个已存在的名称，每帧查找一遍
+    std::shared_ptr<std::vector<DString>> spAtomNames = std::make_shared<std::vector<DString>>();
+    std::shared_ptr<std::vector<ui::UiAtom>> spAtoms = std::make_shared<std::vector<ui::UiAtom>>();
+    for (int32_t nIndex = 0; nIndex < 1000; ++nIndex) {
+        spAtomNames->push_back(ui::StringUtil::Printf(_T("bench_atom_%d"), nIndex));
+        spAtoms->push_back(ui::AtomTable::AddAtom(spAtomNames->back()));
+    }
+    BenchKernel atomFind;
+    atomFind.m_name = "kernel.atom_find";
+    atomFind.m_func = [spAtomNames, spAtoms]() {
+            for (const DString& name : *spAtomNames) {
+                ui::AtomTable::FindAtom(name);
+            }
+        };
+    kernels.push_back(atomFind);
+
+    //多个线程同时查找原子（多个窗口在各自线程中按名称查找控件）：4个线程，每个线程查找20遍
+    BenchKernel atomFindThreads;
+    atomFindThreads.m_name = "kernel.atom_find_threads";
+    atomFindThreads.m_func = [spAtomNames, spAtoms]() {
+            std::vector<std::thread> threads;
+            for (int32_t nThread = 0; nThread < 4; ++nThread) {
+                threads.emplace_back([spAtomNames]() {
+                        for (int32_t nRepeat = 0; nRepeat < 20; ++nRepeat) {
+                            for (const DString& name : *spAtomNames) {
+                                ui::AtomTable::FindAtom(name);
+                            }
+                        }
+                    });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        };
+    kernels.push_back(atomFindThreads);
+    return kernels;
+}
+
+const char* BenchRunner::GetActionName(BenchAction action)
+{
+    switch (action) {
+    case BenchAction::kScroll:
+        return "scroll";
+    case BenchAction::kHover:
+        return "hover";
+    case BenchAction::kResize:
+        return "resize";
+    case BenchAction::kDpi:
+        return "dpi";
+    default:
+        break;
+    }
+    return "unknown";
+}
+
+const char* BenchRunner::GetBuildModeName(BenchBuildMode mode)
+{
+    switch (mode) {
+    case BenchBuildMode::kXml:
+        return "build_xml";
+    case BenchBuildMode::kCompiled:
+        return "build_compiled";
+    case BenchBuildMode::kCached:
+        return "build_cached";
+    default:
+        break;
+    }
+    return "unknown";
+}
+
+bool BenchRunner::IsScenarioEnabled(const std::string& name) const
+{
+    return m_options.m_filter.empty() || (name.find(m_options.m_filter) != std::string::npos);
+}
+
+bool BenchRunner::RunAll()
+{
+    ui::PerformanceUtil& perf = ui::PerformanceUtil::Instance();
+    ui::PerformanceUtil::SetEnabled(true);
+    m_nLayoutStatId = perf.RegisterStat(_T("PaintWindow, Window::OnPreparePaint"));
+    m_nPaintStatId = perf.RegisterStat(_T("PaintWindow, Window::OnPaintMsg"));
+    m_nPresentStatId = perf.RegisterStat(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffers"));
+
+    std::vector<BenchSample> samples = GetSamples();
+    if (!m_options.m_recordFile.empty() || !m_options.m_replayFile.empty()) {
+        //记录模式和回放模式：使用第一个匹配的样例
+        for (const BenchSample& sample : samples) {
+            if (IsScenarioEnabled(sample.m_name)) {
+                return m_options.m_recordFile.empty() ? RunReplay(sample) : RunRecord(sample);
+            }
+        }
+        return false;
+    }
+
+    bool bRet = true;
+    for (const BenchSample& sample : samples) {
+        if (!RunSample(sample)) {
+            bRet = false;
+        }
+        if (!RunBuild(sample)) {
+            bRet = false;
+        }
+    }
+    std::vector<BenchKernel> kernels = GetKernels();
+    for (const BenchKernel& kernel : kernels) {
+        if (IsScenarioEnabled(kernel.m_name)) {
+            RunKernel(kernel);
+        }
+    }
+    if (m_options.m_nMemoryControls > 0) {
+        m_memoryResults = BenchMemory::Run((size_t)m_options.m_nMemoryControls, [this](const std::string& name) {
+                return IsScenarioEnabled(name);
+            });
+        if (IsScenarioEnabled("memory.runtime_names")) {
+            m_retainedResults.push_back(BenchMemory::RunRuntimeNames((size_t)m_options.m_nMemoryControls));
+        }
+    }
+    return bRet;
+}
+
+bool BenchRunner::RunSample(const BenchSample& sample)
+{
+    const BenchAction actions[] = { BenchAction::kScroll, BenchAction::kHover, BenchAction::kResize, BenchAction::kDpi };
+    bool bEnabled = false;
+    for (BenchAction action : actions) {
+        if (IsScenarioEnabled(sample.m_name + "." + GetActionName(action))) {
+            bEnabled = true;
+            break;
+        }
+    }
+    if (!bEnabled) {
+        return true;
+    }
+
+    ui::Control* pTarget = nullptr;
+    BenchForm* pWindow = CreateSampleWindow(sample, pTarget);
+    if (pWindow == nullptr) {
+        return false;
+    }
+    bool bRet = true;
+    for (BenchAction action : actions) {
+        if (!bRet) {
+            break;
+        }
+        const std::string name = sample.m_name + "." + GetActionName(action);
+        if (IsScenarioEnabled(name)) {
+            bRet = RunScenario(name, action, pWindow, pTarget);
+        }
+    }
+    pWindow->Close();
+    RunFrame();
+    return bRet;
+}
+
+bool BenchRunner::RunBuild(const BenchSample& sample)
+{
+    const BenchBuildMode modes[] = { BenchBuildMode::kXml, BenchBuildMode::kCompiled, BenchBuildMode::kCached };
+    bool bRet = true;
+    for (BenchBuildMode mode : modes) {
+        if (!bRet) {
+            break;
+        }
+        BenchResult result;
+        result.m_name = sample.m_name + "." + GetBuildModeName(mode);
+        if (!IsScenarioEnabled(result.m_name)) {
+            continue;
+        }
+        if ((mode == BenchBuildMode::kCompiled) && ui::GlobalManager::Instance().Zip().IsUseZip()) {
+            //压缩包中不能写入预编译的布局文件
+            continue;
+        }
+        BenchRetainedResult retained;
+        retained.m_name = result.m_name;
+        bRet = RunBuildMode(sample, mode, result, retained);
+        m_results.push_back(std::move(result));
+        m_retainedResults.push_back(std::move(retained));
+    }
+    return bRet;
+}
+
+bool BenchRunner::RunBuildMode(const BenchSample& sample, BenchBuildMode mode, BenchResult& result, BenchRetainedResult& retained)
+{
+    //预编译模式：在样例的XML文件同目录下生成预编译的布局文件，测试完成后删除（只预编译窗口本身的XML文件）
+    ui::FilePath xmlFilePath = ui::FilePathUtil::JoinFilePath(ui::GlobalManager::Instance().GetResourcePath(),
+                                                              ui::FilePath(sample.m_skinFolder));
+    xmlFilePath.JoinFilePath(ui::FilePath(sample.m_skinFile));
+    const ui::FilePath compiledFilePath(xmlFilePath.NativePath() + _T("c"));
+    if ((mode == BenchBuildMode::kCompiled) && !ui::WindowBuilder::CompileXmlFile(xmlFilePath, compiledFilePath)) {
+        return false;
+    }
+    if (mode == BenchBuildMode::kCached) {
+        //先创建一次窗口，使布局数据进入缓存
+        ui::Control* pTarget = nullptr;
+        BenchForm* pWindow = CreateSampleWindow(sample, pTarget);
+        if (pWindow == nullptr) {
+            return false;
+        }
+        pWindow->Close();
+        RunFrame();
+    }
+
+    //窗口创建的耗时较长，重复次数不超过20次
+    const int32_t nRepeatCount = std::min(m_options.m_nFrames, 20);
+    result.m_frames.reserve(nRepeatCount);
+    retained.m_nAtomsBefore = ui::AtomTable::GetAtomCount();
+    int64_t nStartBytes = 0;
+    int64_t nStartAllocs = 0;
+    BenchMemory::GetHeapStat(nStartBytes, nStartAllocs);
+    bool bRet = true;
+    for (int32_t nIndex = 0; bRet && (nIndex < nRepeatCount); ++nIndex) {
+        if (mode != BenchBuildMode::kCached) {
+            ui::CompiledLayout::ClearCache();
+        }
+        int64_t nBytes = 0;
+        int64_t nAllocs = 0;
+        BenchMemory::GetHeapStat(nBytes, nAllocs);
+        int64_t nTotalBytes = 0;
+        int64_t nTotalAllocs = 0;
+        BenchMemory::GetTotalAllocStat(nTotalBytes, nTotalAllocs);
+        const int64_t nStartTime = ui::PerformanceUtil::GetTimestamp();
+        BenchForm* pWindow = new BenchForm(sample.m_skinFolder, sample.m_skinFile);
+        bRet = pWindow->CreateWnd(nullptr, ui::WindowCreateParam(_T("duilib_bench"), false));
+        BenchFrameTime frameTime;
+        frameTime.m_nFrameTime = ui::PerformanceUtil::GetTimestamp() - nStartTime;
+        if (bRet) {
+            int64_t nLiveBytes = 0;
+            int64_t nLiveAllocs = 0;
+            BenchMemory::GetHeapStat(nLiveBytes, nLiveAllocs);
+            int64_t nEndTotalBytes = 0;
+            int64_t nEndTotalAllocs = 0;
+            BenchMemory::GetTotalAllocStat(nEndTotalBytes, nEndTotalAllocs);
+            retained.m_nLiveBytes += nLiveBytes - nBytes;
+            retained.m_nLiveAllocs += nLiveAllocs - nAllocs;
+            retained.m_nTotalBytes += nEndTotalBytes - nTotalBytes;
+            retained.m_nTotalAllocs += nEndTotalAllocs - nTotalAllocs;
+            ++retained.m_nCount;
+            result.m_frames.push_back(frameTime);
+            pWindow->Close();
+            bRet = RunFrame();
+        }
+    }
+    int64_t nEndBytes = 0;
+    int64_t nEndAllocs = 0;
+    BenchMemory::GetHeapStat(nEndBytes, nEndAllocs);
+    retained.m_nRetainedBytes = nEndBytes - nStartBytes;
+    retained.m_nRetainedAllocs = nEndAllocs - nStartAllocs;
+    retained.m_nAtomsAfter = ui::AtomTable::GetAtomCount();
+    if (mode == BenchBuildMode::kCompiled) {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::path(compiledFilePath.NativePath()), ec);
+        ui::CompiledLayout::ClearCache();
+    }
+    return bRet;
+}
+
+BenchForm* BenchRunner::CreateSampleWindow(const BenchSample& sample, ui::Control*& pTarget)
+{
+    pTarget = nullptr;
+    BenchForm* pWindow = new BenchForm(sample.m_skinFolder, sample.m_skinFile);
+    if (!pWindow->CreateWnd(nullptr, ui::WindowCreateParam(_T("duilib_bench"), false))) {
+        return nullptr;
+    }
+    pWindow->Resize(m_options.m_nWidth, m_options.m_nHeight, false, false);
+    pWindow->ShowWindow(ui::kSW_SHOW_NORMAL);
+
+    pTarget = pWindow->FindControl(sample.m_targetName);
+    ASSERT(pTarget != nullptr);
+    if (pTarget != nullptr) {
+        if (sample.m_fillData != nullptr) {
+            sample.m_fillData(pWindow, pTarget);
+        }
+        //首次布局和绘制不计入测试结果
+        pWindow->InvalidateAll();
+        if (RunFrame()) {
+            return pWindow;
+        }
+    }
+    pWindow->Close();
+    RunFrame();
+    return nullptr;
+}
+
+bool BenchRunner::RunRecord(const BenchSample& sample)
+{
+    ui::Control* pTarget = nullptr;
+    BenchForm* pWindow = CreateSampleWindow(sample, pTarget);
+    if (pWindow == nullptr) {
+        return false;
+    }
+    //记录用户的操作，直到窗口关闭
+    std::weak_ptr<ui::WeakFlag> windowFlag = pWindow->GetWeakFlag();
+    ui::InputRecorder_SDL recorder;
+    recorder.StartRecording();
+    while (!windowFlag.expired() && pWindow->IsWindow()) {
+        if (!RunFrame()) {
+            break;
+        }
+        SDL_Delay(1);
+    }
+    recorder.StopRecording();
+    if (!windowFlag.expired()) {
+        pWindow->Close();
+        RunFrame();
+    }
+    return recorder.SaveToFile(ui::FilePath(m_options.m_recordFile));
+}
+
+bool BenchRunner::RunReplay(const BenchSample& sample)
+{
+    ui::InputReplayer_SDL replayer;
+    if (!replayer.LoadFromFile(ui::FilePath(m_options.m_replayFile))) {
+        return false;
+    }
+    ui::Control* pTarget = nullptr;
+    BenchForm* pWindow = CreateSampleWindow(sample, pTarget);
+    if (pWindow == nullptr) {
+        return false;
+    }
+    std::weak_ptr<ui::WeakFlag> windowFlag = pWindow->GetWeakFlag();
+    replayer.SetTargetWindow(pWindow);
+
+    ui::PerformanceUtil& perf = ui::PerformanceUtil::Instance();
+    BenchResult result;
+    result.m_name = sample.m_name + ".replay";
+    bool bRet = true;
+    const int64_t nFrameDuration = 1000000000 / 60; //固定步长模式下，每帧前进的记录时间（纳秒）
+    const int64_t nReplayStartTime = ui::PerformanceUtil::GetTimestamp();
+    for (int64_t nFrame = 1; bRet && !replayer.IsFinished(); ++nFrame) {
+        int64_t nReplayTime = 0;
+        if (m_options.m_fReplaySpeed > 0) {
+            //按实际经过的时间回放（GetTimestamp的单位是微秒）
+            nReplayTime = (int64_t)((ui::PerformanceUtil::GetTimestamp() - nReplayStartTime) * 1000 * m_options.m_fReplaySpeed);
+        }
+        else {
+            nReplayTime = nFrame * nFrameDuration;
+        }
+        perf.Reset();
+        const int64_t nStartTime = ui::PerformanceUtil::GetTimestamp();
+        replayer.ReplayUntil(nReplayTime);
+        bRet = RunFrame();
+        BenchFrameTime frameTime;
+        frameTime.m_nFrameTime = ui::PerformanceUtil::GetTimestamp() - nStartTime;
+        ReadFrameTime(frameTime);
+        result.m_frames.push_back(frameTime);
+        if (windowFlag.expired() || !pWindow->IsWindow()) {
+            //回放的操作关闭了窗口
+            break;
+        }
+    }
+    m_results.push_back(std::move(result));
+    if (!windowFlag.expired()) {
+        pWindow->Close();
+        RunFrame();
+    }
+    return bRet;
+}
+
+void BenchRunner::RunKernel(const BenchKernel& kernel)
+{
+    BenchResult result;
+    result.m_name = kernel.m_name;
+    result.m_frames.reserve(m_options.m_nFrames);
+    for (int32_t nFrame = 0; nFrame < m_options.m_nFrames; ++nFrame) {
+        const int64_t nStartTime = ui::PerformanceUtil::GetTimestamp();
+        kernel.m_func();
+        BenchFrameTime frameTime;
+        frameTime.m_nFrameTime = ui::PerformanceUtil::GetTimestamp() - nStartTime;
+        result.m_frames.push_back(frameTime);
+    }
+    m_results.push_back(std::move(result));
+}
+
+bool BenchRunner::RunScenario(const std::string& name, BenchAction action, ui::Window* pWindow, ui::Control* pTarget)
+{
+    ui::PerformanceUtil& perf = ui::PerformanceUtil::Instance();
+    const uint32_t nOldDpi = pWindow->Dpi().GetDPI();
+
+    BenchResult result;
+    result.m_name = name;
+    result.m_frames.reserve(m_options.m_nFrames);
+    bool bRet = true;
+    for (int32_t nFrame = 0; nFrame < m_options.m_nFrames; ++nFrame) {
+        perf.Reset();
+        const int64_t nStartTime = ui::PerformanceUtil::GetTimestamp();
+        ApplyAction(action, nFrame, pWindow, pTarget);
+        bRet = RunFrame();
+        BenchFrameTime frameTime;
+        frameTime.m_nFrameTime = ui::PerformanceUtil::GetTimestamp() - nStartTime;
+        ReadFrameTime(frameTime);
+        result.m_frames.push_back(frameTime);
+        if (!bRet) {
+            break;
+        }
+    }
+
+    //恢复窗口的初始状态，避免影响后续场景
+    if (action == BenchAction::kResize) {
+        pWindow->Resize(m_options.m_nWidth, m_options.m_nHeight, false, false);
+    }
+    else if (action == BenchAction::kDpi) {
+        pWindow->ChangeDpi(nOldDpi);
+    }
+    ui::ScrollBox* pScrollBox = FindScrollBox(pWindow, pTarget);
+    if (pScrollBox != nullptr) {
+        pScrollBox->SetScrollPosY(0);
+    }
+    if (bRet) {
+        bRet = RunFrame();
+    }
+    m_results.push_back(std::move(result));
+    return bRet;
+}
+
+void BenchRunner::ApplyAction(BenchAction action, int32_t nFrame, ui::Window* pWindow, ui::Control* pTarget)
+{
+    switch (action) {
+    case BenchAction::kScroll:
+        {
+            //每帧向下滚动40像素，到达底部后回到顶部
+            ui::ScrollBox* pScrollBox = FindScrollBox(pWindow, pTarget);
+            if (pScrollBox != nullptr) {
+                const int64_t nRange = pScrollBox->GetScrollRange().cy;
+                const int64_t nPos = ((int64_t)nFrame * 40) % (nRange + 1);
+                pScrollBox->SetScrollPosY(nPos);
+            }
+        }
+        break;
+    case BenchAction::kHover:
+        {
+            //每帧将鼠标沿被测控件的中线向下移动8像素
+            const ui::UiRect rcTarget = pTarget->GetPos();
+            if (rcTarget.Height() > 0) {
+                SDL_Event sdlEvent;
+                memset(&sdlEvent, 0, sizeof(sdlEvent));
+                sdlEvent.type = SDL_EVENT_MOUSE_MOTION;
+                sdlEvent.motion.windowID = SDL_GetWindowID((SDL_Window*)pWindow->GetWindowHandle());
+                sdlEvent.motion.x = (float)rcTarget.CenterX();
+                sdlEvent.motion.y = (float)(rcTarget.top + (nFrame * 8) % rcTarget.Height());
+                SDL_PushEvent(&sdlEvent);
+            }
+        }
+        break;
+    case BenchAction::kResize:
+        {
+            //窗口宽度和高度在[-200, 0]的范围内周期性变化
+            const int32_t nDelta = (nFrame % 20) * 10;
+            pWindow->Resize(m_options.m_nWidth - nDelta, m_options.m_nHeight - nDelta, false, false);
+        }
+        break;
+    case BenchAction::kDpi:
+        //在100%和150%之间切换
+        pWindow->ChangeDpi((nFrame % 2 == 0) ? 144 : 96);
+        break;
+    default:
+        break;
+    }
+}
+
+bool BenchRunner::RunFrame()
+{
+    return ui::MessageLoop_SDL::RunPendingEvents();
+}
+
+void BenchRunner::ReadFrameTime(BenchFrameTime& frameTime) const
+{
+    std::vector<ui::PerformanceUtil::StatSnapshot> snapshot;
+    ui::PerformanceUtil::Instance().GetSnapshot(snapshot);
+    for (const ui::PerformanceUtil::StatSnapshot& stat : snapshot) {
+        if (stat.m_nStatId == m_nLayoutStatId) {
+            frameTime.m_nLayoutTime = stat.m_nTotalTime;
+        }
+        else if (stat.m_nStatId == m_nPaintStatId) {
+            frameTime.m_nPaintTime = stat.m_nTotalTime;
+        }
+        else if (stat.m_nStatId == m_nPresentStatId) {
+            frameTime.m_nPresentTime = stat.m_nTotalTime;
+        }
+    }
+}
+
+ui::ScrollBox* BenchRunner::FindScrollBox(ui::Window* pWindow, ui::Control* pTarget)
+{
+    //被测控件本身可滚动（VirtualListBox、RichEdit、TreeView），或者其内部包含可滚动的容器（ListCtrl）
+    ui::ScrollBox* pScrollBox = dynamic_cast<ui::ScrollBox*>(pTarget);
+    if ((pScrollBox != nullptr) && (pScrollBox->GetScrollRange().cy > 0)) {
+        return pScrollBox;
+    }
+    const ui::UiRect rcTarget = pTarget->GetPos();
+    ui::Control* pControl = pWindow->FindControl(ui::UiPoint(rcTarget.CenterX(), rcTarget.CenterY()));
+    while (pControl != nullptr) {
+        pScrollBox = dynamic_cast<ui::ScrollBox*>(pControl);
+        if ((pScrollBox != nullptr) && (pScrollBox->GetScrollRange().cy > 0)) {
+            return pScrollBox;
+        }
+        if (pControl == pTarget) {
+            break;
+        }
+        pControl = pControl->GetParent();
+    }
+    return nullptr;
+}
+
+std::string BenchRunner::GetMemorySummary() const
+{
+    std::string summary;
+    char buf[256] = { 0 };
+    for (const BenchMemoryResult& result : m_memoryResults) {
+        const double nCount = (result.m_nCount > 0) ? (double)result.m_nCount : 1.0;
+        snprintf(buf, sizeof(buf), "%-26s count=%zu sizeof=%zu heap_bytes/control=%.1f heap_allocs/control=%.2f\n",
+                 result.m_name.c_str(), result.m_nCount, result.m_nSizeOf,
+                 result.m_nHeapBytes / nCount, result.m_nHeapAllocs / nCount);
+        summary += buf;
+    }
+    return summary;
+}
+
+std::string BenchRunner::GetReportJson() const
+{
+    std::string json;
+    char buf[512] = { 0 };
+    snprintf(buf, sizeof(buf), "{\"frames\":%d,\"width\":%d,\"height\":%d,\"scenarios\":[",
+             m_options.m_nFrames, m_options.m_nWidth, m_options.m_nHeight);
+    json += buf;
+    for (size_t nIndex = 0; nIndex < m_results.size(); ++nIndex) {
+        const BenchResult& result = m_results[nIndex];
+        std::vector<int64_t> layoutTimes;
+        std::vector<int64_t> paintTimes;
+        std::vector<int64_t> presentTimes;
+        std::vector<int64_t> frameTimes;
+        for (const BenchFrameTime& frameTime : result.m_frames) {
+            layoutTimes.push_back(frameTime.m_nLayoutTime);
+            paintTimes.push_back(frameTime.m_nPaintTime);
+            presentTimes.push_back(frameTime.m_nPresentTime);
+            frameTimes.push_back(frameTime.m_nFrameTime);
+        }
+        if (nIndex != 0) {
+            json += ",";
+        }
+        json += "\n{\"name\":\"" + EscapeJsonString(result.m_name) + "\",";
+        json += "\"frame_count\":" + std::to_string(result.m_frames.size()) + ",";
+        AppendTimeStatJson(json, "layout_us", layoutTimes);
+        json += ",";
+        AppendTimeStatJson(json, "paint_us", paintTimes);
+        json += ",";
+        AppendTimeStatJson(json, "present_us", presentTimes);
+        json += ",";
+        AppendTimeStatJson(json, "frame_us", frameTimes);
+
+        //每帧的数据：[布局, 绘制, 提交, 整帧]
+        json += ",\"samples\":[";
+        for (size_t nFrame = 0; nFrame < result.m_frames.size(); ++nFrame) {
+            const BenchFrameTime& frameTime = result.m_frames[nFrame];
+            snprintf(buf, sizeof(buf), "%s[%lld,%lld,%lld,%lld]", (nFrame != 0) ? "," : "",
+                     (long long)frameTime.m_nLayoutTime, (long long)frameTime.m_nPaintTime,
+                     (long long)frameTime.m_nPresentTime, (long long)frameTime.m_nFrameTime);
+            json += buf;
+        }
+        json += "]}";
+    }
+    json += "\n]";
+
+    //控件内存占用：每个控件占用的堆内存字节数（包含控件对象本身）
+    json += ",\"memory\":[";
+    for (size_t nIndex = 0; nIndex < m_memoryResults.size(); ++nIndex) {
+        const BenchMemoryResult& result = m_memoryResults[nIndex];
+        const double nCount = (result.m_nCount > 0) ? (double)result.m_nCount : 1.0;
+        json += (nIndex != 0) ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+        json += EscapeJsonString(result.m_name);
+        snprintf(buf, sizeof(buf), "\",\"count\":%zu,\"sizeof\":%zu,"
+                 "\"bytes_per_control\":%.1f,\"allocs_per_control\":%.2f}",
+                 result.m_nCount, result.m_nSizeOf,
+                 result.m_nHeapBytes / nCount, result.m_nHeapAllocs / nCount);
+        json += buf;
+    }
+    json += "\n]";
+
+    //重复创建和销毁对象的内存：每个对象存在期间占用的堆内存，全部销毁后保留的堆内存和原子表的变化
+    json += ",\"retained\":[";
+    for (size_t nIndex = 0; nIndex < m_retainedResults.size(); ++nIndex) {
+        const BenchRetainedResult& result = m_retainedResults[nIndex];
+        const double nCount = (result.m_nCount > 0) ? (double)result.m_nCount : 1.0;
+        json += (nIndex != 0) ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+        json += EscapeJsonString(result.m_name);
+        snprintf(buf, sizeof(buf), "\",\"count\":%zu,\"live_bytes_per_object\":%.1f,\"live_allocs_per_object\":%.2f,"
+                 "\"total_bytes_per_object\":%.1f,\"total_allocs_per_object\":%.2f,"
+                 "\"retained_bytes\":%lld,\"retained_allocs\":%lld,\"atoms_before\":%zu,\"atoms_after\":%zu}",
+                 result.m_nCount, result.m_nLiveBytes / nCount, result.m_nLiveAllocs / nCount,
+                 result.m_nTotalBytes / nCount, result.m_nTotalAllocs / nCount,
+                 (long long)result.m_nRetainedBytes, (long long)result.m_nRetainedAllocs,
+                 result.m_nAtomsBefore, result.m_nAtomsAfter);
+        json += buf;
+    }
+    json += "\n]";
+
+    //资源加载各个阶段的耗时（微秒，相对于开始加载的时间）
+    json += ",\"startup\":[";
+    const std::vector<ui::StartupStageTrace>& startupTrace = ui::GlobalManager::Instance().GetStartupTrace();
+    for (size_t nIndex = 0; nIndex < startupTrace.size(); ++nIndex) {
+        const ui::StartupStageTrace& trace = startupTrace[nIndex];
+        //阶段名称可能含有文件路径，不放在buf中
+        json += (nIndex != 0) ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+        json += EscapeJsonString(ui::StringConvert::TToUTF8(trace.m_name));
+        snprintf(buf, sizeof(buf), "\",\"ui_thread\":%s,\"succeeded\":%s,\"start_us\":%lld,\"end_us\":%lld}",
+                 trace.m_bUiThread ? "true" : "false", trace.m_bSucceeded ? "true" : "false",
+                 (long long)trace.m_nStartTime, (long long)trace.m_nEndTime);
+        json += buf;
+    }
+    json += "\n]}\n";
+    return json;
+}
@@ -0,0 +1,210 @@
+#ifndef EXAMPLES_BENCH_RUNNER_H_
+#define EXAMPLES_BENCH_RUNNER_H_
+
+// duilib
+#include "duilib/duilib.h"
+#include "BenchMemory.h"
+
+class BenchForm;
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/** 性能测试的运行参数
+*/
+struct BenchOptions
+{
+    std::string m_filter;       //只运行名称中包含该字符串的场景（为空表示运行全部场景）
+    int32_t m_nFrames = 200;    //每个场景运行的帧数
+    int32_t m_nWidth = 1280;    //窗口的宽度
+    int32_t m_nHeight = 800;    //窗口的高度
+    std::string m_recordFile;   //记录模式：在可见窗口中记录用户的输入事件，保存到该文件（只使用第一个匹配的样例）
+    std::string m_replayFile;   //回放模式：回放该文件中记录的输入事件，记录每帧的耗时（只使用第一个匹配的样例）
+    double m_fReplaySpeed = 0;  //回放速度：0表示每帧固定前进1/60秒的记录时间（结果可重复），大于0表示按实际经过时间的倍数回放
+    int32_t m_nMemoryControls = 100000; //内存测试中，每项测试创建的控件数量
+};
+
+/** 单帧的耗时数据（单位：微秒）
+*/
+struct BenchFrameTime
+{
+    int64_t m_nLayoutTime = 0;  //布局耗时（Window::OnPreparePaint）
+    int64_t m_nPaintTime = 0;   //绘制耗时（Window::OnPaintMsg）
+    int64_t m_nPresentTime = 0; //提交到窗口的耗时（SkRasterWindowContext_SDL::SwapPaintBuffers）
+    int64_t m_nFrameTime = 0;   //整帧耗时（执行场景动作 + 处理消息队列）
+};
+
+/** 一个场景的测试结果
+*/
+struct BenchResult
+{
+    std::string m_name;                     //场景名称，格式为："样例名称.动作名称"
+    std::vector<BenchFrameTime> m_frames;   //每帧的耗时数据
+};
+
+/** 测试样例：加载布局并填充数据
+*/
+struct BenchSample
+{
+    std::string m_name;         //样例名称
+    DString m_skinFolder;       //皮肤资源路径
+    DString m_skinFile;         //布局文件名
+    DString m_targetName;       //被测控件的名称（滚动、鼠标悬停等动作作用于该控件）
+
+    /** 填充数据的函数，参数为窗口和被测控件
+    */
+    std::function<void(ui::Window* pWindow, ui::Control* pTarget)> m_fillData;
+};
+
+/** 微基准测试：不创建窗口，直接测试底层计算函数的耗时（结果只记录整帧耗时）
+*/
+struct BenchKernel
+{
+    std::string m_name;             //测试名称，格式为："kernel.函数名称"
+    std::function<void()> m_func;   //被测函数，每帧调用一次
+};
+
+/** 场景动作
+*/
+enum class BenchAction
+{
+    kScroll,    //每帧纵向滚动固定的像素数
+    kHover,     //每帧将鼠标移动到被测控件的下一个位置
+    kResize,    //每帧改变窗口的大小
+    kDpi        //每帧切换窗口的DPI
+};
+
+/** 窗口创建（解析布局、创建控件）的测试方式
+*/
+enum class BenchBuildMode
+{
+    kXml,       //每次创建前清空布局缓存，解析XML文件
+    kCompiled,  //每次创建前清空布局缓存，加载预编译的布局文件（.xmlc）
+    kCached     //使用缓存中的布局数据
+};
+
+/** 无界面性能测试：在不可见的窗口中加载布局，按脚本执行场景动作，记录每帧的布局、绘制和提交耗时
+*   需要使用SDL的"offscreen"显示驱动（在创建窗口前调用 MessageLoop_SDL::CheckInitSDL）
+*/
+class BenchRunner
+{
+public:
+    explicit BenchRunner(const BenchOptions& options);
+    ~BenchRunner();
+    BenchRunner(const BenchRunner&) = delete;
+    BenchRunner& operator = (const BenchRunner&) = delete;
+
+public:
+    /** 运行所有匹配的场景（需要在UI线程中调用）
+    *   如果设置了记录文件或者回放文件，则运行记录模式或者回放模式
+    * @return 全部场景运行成功返回true，否则返回false
+    */
+    bool RunAll();
+
+    /** 获取测试结果（JSON格式，UTF8编码）
+    */
+    std::string GetReportJson() const;
+
+    /** 获取控件内存占用的汇总（文本格式，每项测试一行：控件大小、每个控件的堆内存字节数和内存块数）
+    */
+    std::string GetMemorySummary() const;
+
+private:
+    /** 运行一个样例的所有动作
+    */
+    bool RunSample(const BenchSample& sample);
+
+    /** 窗口创建测试：按各种方式重复创建和关闭样例窗口，记录每次创建窗口的耗时（结果只记录整帧耗时）
+    */
+    bool RunBuild(const BenchSample& sample);
+
+    /** 按指定的方式重复创建和关闭样例窗口，记录每次创建窗口的耗时，以及窗口占用和关闭后保留的堆内存
+    */
+    bool RunBuildMode(const BenchSample& sample, BenchBuildMode mode, BenchResult& result, BenchRetainedResult& retained);
+
+    /** 记录模式：创建样例窗口，记录用户的输入事件，直到窗口关闭后保存到文件
+    */
+    bool RunRecord(const BenchSample& sample);
+
+    /** 回放模式：创建样例窗口，按记录的时间回放输入事件，记录每帧的耗时
+    */
+    bool RunReplay(const BenchSample& sample);
+
+    /** 创建样例窗口并填充数据，完成首次布局和绘制
+    * @param [in] sample 测试样例
+    * @param [out] pTarget 返回被测控件
+    * @return 成功返回窗口，失败返回nullptr
+    */
+    BenchForm* CreateSampleWindow(const BenchSample& sample, ui::Control*& pTarget);
+
+    /** 运行一个微基准测试
+    */
+    void RunKernel(const BenchKernel& kernel);
+
+    /** 运行一个场景
+    */
+    bool RunScenario(const std::string& name, BenchAction action, ui::Window* pWindow, ui::Control* pTarget);
+
+    /** 执行一帧的场景动作
+    */
+    void ApplyAction(BenchAction action, int32_t nFrame, ui::Window* pWindow, ui::Control* pTarget);
+
+    /** 处理消息队列中的所有消息（包括绘制消息），完成一帧
+    * @return 收到退出消息时返回false
+    */
+    bool RunFrame();
+
+    /** 从性能统计数据中读取本帧的耗时
+    */
+    void ReadFrameTime(BenchFrameTime& frameTime) const;
+
+    /** 判断场景是否需要运行
+    */
+    bool IsScenarioEnabled(const std::string& name) const;
+
+    /** 获取所有的测试样例
+    */
+    static std::vector<BenchSample> GetSamples();
+
+    /** 获取所有的微基准测试
+    */
+    static std::vector<BenchKernel> GetKernels();
+
+    /** 获取动作的名称
+    */
+    static const char* GetActionName(BenchAction action);
+
+    /** 获取窗口创建测试方式的名称
+    */
+    static const char* GetBuildModeName(BenchBuildMode mode);
+
+    /** 查找被测控件中的可纵向滚动的容器
+    */
+    static ui::ScrollBox* FindScrollBox(ui::Window* pWindow, ui::Control* pTarget);
+
+private:
+    /** 运行参数
+    */
+    BenchOptions m_options;
+
+    /** 测试结果
+    */
+    std::vector<BenchResult> m_results;
+
+    /** 控件内存占用的测试结果
+    */
+    std::vector<BenchMemoryResult> m_memoryResults;
+
+    /** 重复创建和销毁对象的内存测试结果
+    */
+    std::vector<BenchRetainedResult> m_retainedResults;
+
+    /** 统计项ID：布局、绘制、提交
+    */
+    uint32_t m_nLayoutStatId;
+    uint32_t m_nPaintStatId;
+    uint32_t m_nPresentStatId;
+};
+
+#endif //EXAMPLES_BENCH_RUNNER_H_
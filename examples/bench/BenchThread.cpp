@@ -0,0 +1,48 @@
+#include "BenchThread.h"
+
+BenchThread::BenchThread(const BenchOptions& options) :
+    FrameworkThread(_T("BenchThread"), ui::kThreadUI),
+    m_options(options),
+    m_bSucceeded(false)
+{
+}
+
+BenchThread::~BenchThread()
+{
+}
+
+const std::string& BenchThread::GetReportJson() const
+{
+    return m_reportJson;
+}
+
+const std::string& BenchThread::GetMemorySummary() const
+{
+    return m_memorySummary;
+}
+
+bool BenchThread::IsSucceeded() const
+{
+    return m_bSucceeded;
+}
+
+void BenchThread::OnInit()
+{
+    //初始化全局资源, 使用本地文件夹作为资源
+    ui::FilePath resourcePath = ui::FilePathUtil::GetCurrentModuleDirectory();
+    resourcePath += _T("resources\\");
+    ui::GlobalManager::Instance().Startup(ui::LocalFilesResParam(resourcePath));
+}
+
+void BenchThread::OnRunMessageLoop()
+{
+    BenchRunner runner(m_options);
+    m_bSucceeded = runner.RunAll();
+    m_reportJson = runner.GetReportJson();
+    m_memorySummary = runner.GetMemorySummary();
+}
+
+void BenchThread::OnCleanup()
+{
+    ui::GlobalManager::Instance().Shutdown();
+}
@@ -0,0 +1,60 @@
+#ifndef EXAMPLES_BENCH_THREAD_H_
+#define EXAMPLES_BENCH_THREAD_H_
+
+// duilib
+#include "duilib/duilib.h"
+
+#include "BenchRunner.h"
+
+/** 性能测试的主线程（UI线程）：不进入常规的消息循环，由BenchRunner逐帧驱动
+*/
+class BenchThread : public ui::FrameworkThread
+{
+public:
+    explicit BenchThread(const BenchOptions& options);
+    virtual ~BenchThread() override;
+
+    /** 获取测试结果（JSON格式，UTF8编码）
+    */
+    const std::string& GetReportJson() const;
+
+    /** 获取控件内存占用的汇总（文本格式）
+    */
+    const std::string& GetMemorySummary() const;
+
+    /** 是否所有场景都运行成功
+    */
+    bool IsSucceeded() const;
+
+private:
+    /** 运行前初始化，在进入消息循环前调用
+    */
+    virtual void OnInit() override;
+
+    /** 运行所有测试场景，代替消息循环
+    */
+    virtual void OnRunMessageLoop() override;
+
+    /** 退出时清理，在退出消息循环后调用
+    */
+    virtual void OnCleanup() override;
+
+private:
+    /** 运行参数
+    */
+    BenchOptions m_options;
+
+    /** 测试结果
+    */
+    std::string m_reportJson;
+
+    /** 控件内存占用的汇总
+    */
+    std::string m_memorySummary;
+
+    /** 是否所有场景都运行成功
+    */
+    bool m_bSucceeded;
+};
+
+#endif //EXAMPLES_BENCH_THREAD_H_
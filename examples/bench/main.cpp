@@ -0,0 +1,108 @@
+// duilib_bench: 无界面的帧耗时性能测试程序
+// 用法：duilib_bench [--filter=<场景名称子串>] [--frames=<帧数>] [--width=<窗口宽度>] [--height=<窗口高度>] [--output=<结果文件>]
+//                    [--record=<记录文件>] [--replay=<记录文件>] [--replay-speed=<回放速度>] [--memory-controls=<控件数量>]
+// 测试结果为JSON格式，未指定--output时输出到标准输出
+// 窗口创建测试（<样例名称>.build_xml/build_compiled/build_cached）：重复创建样例窗口，frame_us为每次创建窗口的耗时，
+//   分别为解析XML文件、加载预编译的布局文件（.xmlc，测试时临时生成）、使用缓存的布局数据；
+//   结果中的"retained"为每个窗口占用的堆内存、全部窗口关闭后保留的堆内存及原子表的变化
+// 运行时名称测试（memory.runtime_names）：创建--memory-controls个名称各不相同的控件，销毁后原子表应恢复原来的大小
+// 内存测试（memory.*）：每项批量创建--memory-controls个控件（默认100000，为0时不运行），输出每个控件的sizeof和占用的堆内存
+// 记录模式（--record）：在可见窗口中打开--filter匹配的第一个样例，记录用户的输入事件，关闭窗口后保存
+// 回放模式（--replay）：在无界面模式下回放记录的输入事件，结果名称为"<样例名称>.replay"；
+//   --replay-speed为0（默认）时每帧固定前进1/60秒的记录时间，结果可重复；大于0时按实际经过时间的倍数回放
+
+#include "BenchThread.h"
+#include "duilib/Core/MessageLoop_SDL.h"
+
+#include <cstdio>
+#include <cstring>
+
+/** 解析形如"--name=value"的命令行参数，匹配时返回true
+*/
+static bool ParseOption(const char* arg, const char* name, std::string& value)
+{
+    const size_t nNameLen = strlen(name);
+    if ((strncmp(arg, name, nNameLen) == 0) && (arg[nNameLen] == '=')) {
+        value = arg + nNameLen + 1;
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    std::string outputFile;
+    for (int i = 1; i < argc; ++i) {
+        std::string value;
+        if (ParseOption(argv[i], "--filter", value)) {
+            options.m_filter = value;
+        }
+        else if (ParseOption(argv[i], "--frames", value)) {
+            options.m_nFrames = atoi(value.c_str());
+        }
+        else if (ParseOption(argv[i], "--width", value)) {
+            options.m_nWidth = atoi(value.c_str());
+        }
+        else if (ParseOption(argv[i], "--height", value)) {
+            options.m_nHeight = atoi(value.c_str());
+        }
+        else if (ParseOption(argv[i], "--output", value)) {
+            outputFile = value;
+        }
+        else if (ParseOption(argv[i], "--record", value)) {
+            options.m_recordFile = value;
+        }
+        else if (ParseOption(argv[i], "--replay", value)) {
+            options.m_replayFile = value;
+        }
+        else if (ParseOption(argv[i], "--replay-speed", value)) {
+            options.m_fReplaySpeed = atof(value.c_str());
+        }
+        else if (ParseOption(argv[i], "--memory-controls", value)) {
+            options.m_nMemoryControls = atoi(value.c_str());
+        }
+        else {
+            fprintf(stderr, "usage: %s [--filter=NAME] [--frames=N] [--width=W] [--height=H] [--output=FILE]"
+                            " [--record=FILE] [--replay=FILE] [--replay-speed=X] [--memory-controls=N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+#if defined(DUILIB_BUILD_FOR_SDL)
+    //使用SDL的offscreen显示驱动：窗口不可见，绘制到内存中的窗口表面
+    //记录模式需要用户操作窗口，使用默认的显示驱动
+    const bool bRecordMode = !options.m_recordFile.empty();
+    if (!ui::MessageLoop_SDL::CheckInitSDL(bRecordMode ? _T("") : _T("offscreen"))) {
+        fprintf(stderr, "failed to initialize the SDL video driver\n");
+        return 1;
+    }
+
+    BenchThread thread(options);
+    thread.RunOnCurrentThreadWithLoop();
+
+    //控件内存占用的汇总输出到标准错误，不影响标准输出中的JSON结果
+    const std::string& memorySummary = thread.GetMemorySummary();
+    if (!memorySummary.empty()) {
+        fwrite(memorySummary.data(), 1, memorySummary.size(), stderr);
+    }
+
+    const std::string& reportJson = thread.GetReportJson();
+    if (outputFile.empty()) {
+        fwrite(reportJson.data(), 1, reportJson.size(), stdout);
+    }
+    else {
+        FILE* pFile = fopen(outputFile.c_str(), "wb");
+        if (pFile == nullptr) {
+            fprintf(stderr, "failed to open output file: %s\n", outputFile.c_str());
+            return 1;
+        }
+        fwrite(reportJson.data(), 1, reportJson.size(), pFile);
+        fclose(pFile);
+    }
+    return thread.IsSucceeded() ? 0 : 1;
+#else
+    fprintf(stderr, "duilib_bench requires an SDL build of duilib (DUILIB_BUILD_FOR_SDL)\n");
+    return 1;
+#endif
+}
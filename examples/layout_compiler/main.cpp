@@ -0,0 +1,60 @@
+// duilib_layout_compiler: 布局XML文件的预编译工具
+// 用法：duilib_layout_compiler <XML文件或者目录> [<XML文件或者目录> ...]
+// 每个XML文件编译后，在同目录下生成预编译的布局文件（比如"main.xml"生成"main.xmlc"），由WindowBuilder::ParseXmlFile自动加载；
+// 参数为目录时，编译该目录（包括子目录）下所有的".xml"文件
+// 预编译的布局文件与平台和字符集相关（DUILIB_UNICODE），需要使用与程序相同配置编译的本工具生成
+
+#include "duilib/Core/WindowBuilder.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+/** 编译一个XML文件，成功返回true
+*/
+static bool CompileLayoutFile(const std::filesystem::path& xmlFile)
+{
+    const ui::FilePath xmlFilePath(xmlFile.native());
+    const bool bSucceeded = ui::WindowBuilder::CompileXmlFile(xmlFilePath);
+    fprintf(bSucceeded ? stdout : stderr, "%s: %s\n", bSucceeded ? "compiled" : "failed", xmlFile.string().c_str());
+    return bSucceeded;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <xml file or directory> [...]\n", argv[0]);
+        return 2;
+    }
+    int32_t nCompiled = 0;
+    int32_t nFailed = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::filesystem::path inputPath(argv[i]);
+        std::error_code ec;
+        if (std::filesystem::is_directory(inputPath, ec)) {
+            for (std::filesystem::recursive_directory_iterator it(inputPath, ec), itEnd; !ec && (it != itEnd); it.increment(ec)) {
+                if (!it->is_regular_file(ec) || (it->path().extension() != ".xml")) {
+                    continue;
+                }
+                if (CompileLayoutFile(it->path())) {
+                    ++nCompiled;
+                }
+                else {
+                    ++nFailed;
+                }
+            }
+        }
+        else if (CompileLayoutFile(inputPath)) {
+            ++nCompiled;
+        }
+        else {
+            ++nFailed;
+        }
+        if (ec) {
+            fprintf(stderr, "failed: %s (%s)\n", argv[i], ec.message().c_str());
+            ++nFailed;
+        }
+    }
+    fprintf(stdout, "%d compiled, %d failed\n", nCompiled, nFailed);
+    return (nFailed == 0) ? 0 : 1;
+}
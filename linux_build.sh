@@ -105,6 +105,18 @@ cd "$SRC_ROOT_DIR/build_temp/VirtualListBox"
 make clean; make
 cd "$SRC_ROOT_DIR/"
 
+#编译性能测试程序（无界面运行：bin/duilib_bench --output=bench.json）
+cmake -S "$SRC_ROOT_DIR/examples/bench/" -B "$SRC_ROOT_DIR/build_temp/bench" -DCMAKE_BUILD_TYPE=Debug
+cd "$SRC_ROOT_DIR/build_temp/bench"
+make clean; make
+cd "$SRC_ROOT_DIR/"
+
+#编译布局预编译工具（bin/duilib_layout_compiler <XML文件或者目录>，生成同名的".xmlc"文件）
+cmake -S "$SRC_ROOT_DIR/examples/layout_compiler/" -B "$SRC_ROOT_DIR/build_temp/layout_compiler" -DCMAKE_BUILD_TYPE=Debug
+cd "$SRC_ROOT_DIR/build_temp/layout_compiler"
+make clean; make
+cd "$SRC_ROOT_DIR/"
+
 #清理临时目录
 #rm -rf "$SRC_ROOT_DIR/build_temp/"
 